@@ -11,8 +11,7 @@ layout(location = 3) in float lifetime;
 layout(location = 4) in float size;
 layout(location = 5) in float angle;
 
-uniform mat4 view;
-uniform mat4 proj;
+#include "scene_uniform_blocks.inc"
 uniform vec3 rotation_axis;
 
 out float frag_lifetime;
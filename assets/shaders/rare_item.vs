@@ -9,8 +9,7 @@ layout(location = 1) in vec2 uv;
 layout(location = 2) in vec2 normal;
 
 uniform mat4 world;
-uniform mat4 view;
-uniform mat4 proj;
+#include "scene_uniform_blocks.inc"
 
 uniform bool texture_sheet;
 uniform float min_u;
@@ -28,6 +28,7 @@ struct QueryResultData
     std::string mPersistentProgressRawString;
     std::string mStoryProgressRawString;
     std::string mLastBattleRawString;
+    std::string mLastBattleReplayBytes;
 };
 void QueryPlayerProgress(std::function<void(QueryResultData)> onQueryCompleteCallback);
 void SavePlayerProgress();
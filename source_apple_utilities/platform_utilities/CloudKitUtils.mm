@@ -53,6 +53,7 @@ void QueryPlayerProgress(std::function<void(QueryResultData)> onQueryCompleteCal
                 NSData* persistentData = currentProgressRecord[@"persistent"];
                 NSData* storyData = currentProgressRecord[@"story"];
                 NSData* lastBattleData = currentProgressRecord[@"last_battle"];
+                NSData* lastBattleReplayData = currentProgressRecord[@"last_battle_replay"];
                 
                 NSString* persistentDataString = [[NSString alloc] initWithData:persistentData encoding:NSUTF8StringEncoding];
                 NSString* storyDataString = [[NSString alloc] initWithData:storyData encoding:NSUTF8StringEncoding];
@@ -61,6 +62,10 @@ void QueryPlayerProgress(std::function<void(QueryResultData)> onQueryCompleteCal
                 resultData.mPersistentProgressRawString = std::string([persistentDataString UTF8String]);
                 resultData.mStoryProgressRawString = std::string([storyDataString UTF8String]);
                 resultData.mLastBattleRawString = std::string([lastBattleDataString UTF8String]);
+                if (lastBattleReplayData)
+                {
+                    resultData.mLastBattleReplayBytes = std::string(static_cast<const char*>(lastBattleReplayData.bytes), lastBattleReplayData.length);
+                }
                 resultData.mSuccessfullyQueriedAtLeastOneFileField = true;
                 
                 onQueryCompleteCallback(resultData);
@@ -105,13 +110,27 @@ void SavePlayerProgress()
         return std::string();
     };
     
+    // The battle replay is binary, so it bypasses the string conversion of the data files
+    auto lastBattleReplayBytes = []()
+    {
+        std::ifstream replayFile(apple_utils::GetPersistentDataDirectoryPath() + "last_battle_replay.bin", std::ios::binary);
+        if (replayFile.is_open())
+        {
+            return std::string((std::istreambuf_iterator<char>(replayFile)), std::istreambuf_iterator<char>());
+        }
+        
+        return std::string();
+    }();
+    
     NSData* persistentData = [[NSString stringWithUTF8String:persistentDataFileReaderLambda("persistent").c_str()] dataUsingEncoding:NSUTF8StringEncoding];
     NSData* storyData = [[NSString stringWithUTF8String:persistentDataFileReaderLambda("story").c_str()] dataUsingEncoding:NSUTF8StringEncoding];
     NSData* lastBattleData = [[NSString stringWithUTF8String:persistentDataFileReaderLambda("last_battle").c_str()] dataUsingEncoding:NSUTF8StringEncoding];
+    NSData* lastBattleReplayData = [NSData dataWithBytes:lastBattleReplayBytes.data() length:lastBattleReplayBytes.size()];
     
     currentProgressRecord[@"persistent"] = persistentData;
     currentProgressRecord[@"story"] = storyData;
     currentProgressRecord[@"last_battle"] = lastBattleData;
+    currentProgressRecord[@"last_battle_replay"] = lastBattleReplayData;
     
     // Batch cloud writes
     if (saveInProgress)
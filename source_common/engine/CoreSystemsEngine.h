@@ -18,6 +18,7 @@
 ///------------------------------------------------------------------------------------------------
 
 namespace input { class IInputStateManager; }
+namespace jobs { class JobSystem; }
 namespace rendering { class AnimationManager; }
 namespace rendering { class IRenderer; }
 namespace rendering { class FontRepository; }
@@ -31,10 +32,24 @@ using SDL_GLContext = void*;
 
 ///------------------------------------------------------------------------------------------------
 
+enum class HeadlessMode
+{
+    NONE,
+    OFFSCREEN_GL,    // Real frames on a hidden offscreen (EGL) context, e.g. Mesa's llvmpipe on GPU-less machines
+    COMMAND_RECORDER // Scenes are only recorded (draw calls, state changes, uploads) by rendering::CommandRecordingRenderer
+};
+
+///------------------------------------------------------------------------------------------------
+
 class CoreSystemsEngine final
 {
 public:
     static CoreSystemsEngine& GetInstance();
+    
+    // Needs to be called before the first GetInstance() call. A non zero maxFrameCount
+    // ends the game loop after that many frames.
+    static void SetHeadlessMode(const HeadlessMode headlessMode, const int maxFrameCount);
+    
     ~CoreSystemsEngine();
     
     CoreSystemsEngine(const CoreSystemsEngine&) = delete;
@@ -53,6 +68,7 @@ public:
     scene::SceneManager& GetSceneManager();
     resources::ResourceLoadingService& GetResourceLoadingService();
     sound::SoundManager& GetSoundManager();
+    jobs::JobSystem& GetJobSystem();
     
     float GetDefaultAspectRatio() const;
     SDL_Window& GetContextWindow() const;
@@ -9,6 +9,9 @@
 #include <engine/scene/SceneObject.h>
 #include <engine/scene/Scene.h>
 #include <engine/utils/Logging.h>
+#include <engine/utils/Profiling.h>
+#include <algorithm>
+#include <cassert>
 
 ///------------------------------------------------------------------------------------------------
 
@@ -17,33 +20,60 @@ namespace rendering
 
 ///------------------------------------------------------------------------------------------------
 
-void AnimationManager::StartAnimation(std::unique_ptr<IAnimation> animation, std::function<void()> onCompleteCallback, const strutils::StringId animationName /* = strutils::StringId() */)
+AnimationHandle AnimationManager::StartAnimation(std::unique_ptr<IAnimation> animation, std::function<void()> onCompleteCallback, const strutils::StringId animationName /* = strutils::StringId() */)
 {
+    uint32_t slotIndex = 0;
+    if (mFreeSlotIndices.empty())
+    {
+        slotIndex = static_cast<uint32_t>(mSlots.size());
+        mSlots.emplace_back();
+    }
+    else
+    {
+        slotIndex = mFreeSlotIndices.back();
+        mFreeSlotIndices.pop_back();
+    }
+    
+    auto& slot = mSlots[slotIndex];
+    slot.mSceneObject = animation->VGetSceneObject().get();
+    slot.mAnimation = std::move(animation);
+    slot.mCompletionCallback = std::move(onCompleteCallback);
+    slot.mAnimationName = animationName;
+    slot.mAlive = true;
+    slot.mPending = mAnimationContainerLocked;
+    
+    if (!animationName.isEmpty())
+    {
+        mSlotIndicesByName[animationName].push_back(slotIndex);
+    }
+    
+    // Animations started mid-update only start updating from the next update onwards
     if (mAnimationContainerLocked)
     {
-        mAnimationsToAdd.emplace_back(AnimationEntry{ std::move(animation), onCompleteCallback, animationName });
+        mSlotIndicesToAdd.push_back(slotIndex);
     }
     else
     {
-        mAnimations.emplace_back(AnimationEntry{ std::move(animation), onCompleteCallback, animationName });
+        ActivateSlot(slotIndex);
     }
+    
+    return AnimationHandle{ slotIndex, slot.mGeneration };
 }
 
 ///------------------------------------------------------------------------------------------------
 
 void AnimationManager::StopAnimation(const strutils::StringId& animationName)
 {
-    if (mAnimationContainerLocked)
-    {
-        mAnimationNamesToRemove.emplace_back(animationName);
-    }
-    else
+    StopFirstAnimationWithName(animationName);
+}
+
+///------------------------------------------------------------------------------------------------
+
+void AnimationManager::StopAnimation(const AnimationHandle& animationHandle)
+{
+    if (FindSlot(animationHandle))
     {
-        auto findIter = std::find_if(mAnimations.cbegin(), mAnimations.cend(), [&](const AnimationEntry& entry) { return entry.mAnimationName == animationName; });
-        if (findIter != mAnimations.cend())
-        {
-            mAnimations.erase(findIter);
-        }
+        KillSlot(animationHandle.mSlotIndex);
     }
 }
 
@@ -51,24 +81,16 @@ void AnimationManager::StopAnimation(const strutils::StringId& animationName)
 
 void AnimationManager::StopAllAnimationsPlayingForSceneObject(const strutils::StringId& sceneObjectName)
 {
-    for(auto iter = mAnimations.begin(); iter != mAnimations.end();)
+    for (const auto* slotIndices: { &mActiveSlotIndices, &mSlotIndicesToAdd })
     {
-        if (iter->mAnimation->VGetSceneObject() && iter->mAnimation->VGetSceneObject()->mName == sceneObjectName)
+        for (const auto slotIndex: *slotIndices)
         {
-            if (mAnimationContainerLocked)
+            const auto& slot = mSlots[slotIndex];
+            if (slot.mAlive && slot.mSceneObject && slot.mSceneObject->mName == sceneObjectName)
             {
-                auto tempAnimationName = strutils::StringId("TEMP");
-                iter->mAnimationName = tempAnimationName;
-                mAnimationNamesToRemove.emplace_back(tempAnimationName);
-            }
-            else
-            {
-                iter = mAnimations.erase(iter);
-                continue;
+                KillSlot(slotIndex);
             }
         }
-        
-        iter++;
     }
 }
 
@@ -76,21 +98,20 @@ void AnimationManager::StopAllAnimationsPlayingForSceneObject(const strutils::St
 
 void AnimationManager::StopAllAnimations()
 {
-    if (mAnimationContainerLocked)
+    for (const auto* slotIndices: { &mActiveSlotIndices, &mSlotIndicesToAdd })
     {
-        for (auto& animation: mAnimationsToAdd)
+        for (const auto slotIndex: *slotIndices)
         {
-            mAnimationNamesToRemove.push_back(animation.mAnimationName);
-        }
-        for (auto& animation: mAnimations)
-        {
-            mAnimationNamesToRemove.push_back(animation.mAnimationName);
+            if (mSlots[slotIndex].mAlive)
+            {
+                KillSlot(slotIndex);
+            }
         }
     }
-    else
+    
+    if (!mAnimationContainerLocked)
     {
-        mAnimationsToAdd.clear();
-        mAnimations.clear();
+        ReleaseDeadSlots(mActiveSlotIndices);
     }
 }
 
@@ -98,53 +119,68 @@ void AnimationManager::StopAllAnimations()
 
 void AnimationManager::Update(const float dtMillis)
 {
+    PROFILE_SCOPE("AnimationManager::Update");
+    
     mAnimationContainerLocked = true;
-    for(auto iter = mAnimations.begin(); iter != mAnimations.end();)
+    
+    // Batched tweens are all advanced up front, the loop below only
+    // collects their results (and fires their completion callbacks).
+    mTweenBatch.Update(dtMillis);
+    
+    // Slots are only ever appended to during the update (by completion callbacks starting
+    // new animations), so they're accessed by index rather than by reference.
+    for (const auto slotIndex: mActiveSlotIndices)
     {
-        if (std::find(mAnimationNamesToRemove.cbegin(), mAnimationNamesToRemove.cend(), iter->mAnimationName) != mAnimationNamesToRemove.cend())
+        if (!mSlots[slotIndex].mAlive)
         {
-            ++iter;
             continue;
         }
         
-        auto updateTimeMillis = dtMillis * (iter->mAnimation->VGetSceneObject() && iter->mAnimation->VGetSceneObject()->mScene ? iter->mAnimation->VGetSceneObject()->mScene->GetUpdateTimeSpeedFactor() : 1.0f);
-        
-        if (iter->mAnimation->VUpdate(updateTimeMillis) == AnimationUpdateResult::FINISHED)
+        auto animationUpdateResult = AnimationUpdateResult::ONGOING;
+        if (mSlots[slotIndex].mBatched)
         {
-            iter->mCompletionCallback();
-            iter = mAnimations.erase(iter);
+            animationUpdateResult = mTweenBatch.GetUpdateResult(slotIndex);
         }
         else
         {
-            ++iter;
+            const auto* sceneObject = mSlots[slotIndex].mSceneObject;
+            auto updateTimeMillis = dtMillis * (sceneObject && sceneObject->mScene ? sceneObject->mScene->GetUpdateTimeSpeedFactor() : 1.0f);
+            animationUpdateResult = mSlots[slotIndex].mAnimation->VUpdate(updateTimeMillis);
         }
-    }
-    mAnimationContainerLocked = false;
-    
-    for (const auto& animationName: mAnimationNamesToRemove)
-    {
-        auto findIter = std::find_if(mAnimations.cbegin(), mAnimations.cend(), [&](const AnimationEntry& entry) { return entry.mAnimationName == animationName; });
-        if (findIter != mAnimations.cend())
+        
+        if (animationUpdateResult == AnimationUpdateResult::FINISHED)
         {
-            mAnimations.erase(findIter);
+            auto completionCallback = std::move(mSlots[slotIndex].mCompletionCallback);
+            KillSlot(slotIndex);
+            completionCallback();
         }
     }
     
-    for (auto& animationEntry: mAnimationsToAdd)
+    mAnimationContainerLocked = false;
+    
+    ReleaseDeadSlots(mActiveSlotIndices);
+    ReleaseDeadSlots(mSlotIndicesToAdd);
+    
+    for (const auto slotIndex: mSlotIndicesToAdd)
     {
-        mAnimations.emplace_back(std::move(animationEntry));
+        mSlots[slotIndex].mPending = false;
+        ActivateSlot(slotIndex);
     }
-    
-    mAnimationsToAdd.clear();
-    mAnimationNamesToRemove.clear();
+    mSlotIndicesToAdd.clear();
 }
 
 ///------------------------------------------------------------------------------------------------
 
 bool AnimationManager::IsAnimationPlaying(const strutils::StringId& animationName) const
 {
-    auto findIter = std::find_if(mAnimations.cbegin(), mAnimations.cend(), [&](const AnimationEntry& entry) { return entry.mAnimationName == animationName; });
-    return findIter != mAnimations.cend();
+    return GetAnimationCountPlayingWithName(animationName) > 0;
+}
+
+///------------------------------------------------------------------------------------------------
+
+bool AnimationManager::IsAnimationPlaying(const AnimationHandle& animationHandle) const
+{
+    return FindSlot(animationHandle) != nullptr;
 }
 
 ///------------------------------------------------------------------------------------------------
@@ -152,9 +188,10 @@ bool AnimationManager::IsAnimationPlaying(const strutils::StringId& animationNam
 int AnimationManager::GetAnimationCountPlayingForSceneObject(const strutils::StringId& sceneObjectName)
 {
     auto count = 0;
-    for(auto iter = mAnimations.begin(); iter != mAnimations.end(); iter++)
+    for (const auto slotIndex: mActiveSlotIndices)
     {
-        if (iter->mAnimation->VGetSceneObject() && iter->mAnimation->VGetSceneObject()->mName == sceneObjectName)
+        const auto& slot = mSlots[slotIndex];
+        if (slot.mAlive && slot.mSceneObject && slot.mSceneObject->mName == sceneObjectName)
         {
             count++;
         }
@@ -167,16 +204,140 @@ int AnimationManager::GetAnimationCountPlayingForSceneObject(const strutils::Str
 
 int AnimationManager::GetAnimationsPlayingCount() const
 {
-    return static_cast<int>(mAnimations.size());
+    return static_cast<int>(mActiveSlotIndices.size()) - mDeadActiveSlotCount;
 }
 
 ///------------------------------------------------------------------------------------------------
 
 int AnimationManager::GetAnimationCountPlayingWithName(const strutils::StringId& animationName) const
 {
-    return
-          static_cast<int>(std::count_if(mAnimations.begin(), mAnimations.end(), [=](const AnimationEntry& animationEntry){ return animationEntry.mAnimationName == animationName; }))
-    + static_cast<int>(std::count_if(mAnimationsToAdd.begin(), mAnimationsToAdd.end(), [=](const AnimationEntry& animationEntry){ return animationEntry.mAnimationName == animationName; })) - static_cast<int>(std::count(mAnimationNamesToRemove.begin(), mAnimationNamesToRemove.end(), animationName));
+    if (animationName.isEmpty())
+    {
+        auto count = 0;
+        for (const auto* slotIndices: { &mActiveSlotIndices, &mSlotIndicesToAdd })
+        {
+            count += static_cast<int>(std::count_if(slotIndices->begin(), slotIndices->end(), [&](const uint32_t slotIndex){ return mSlots[slotIndex].mAlive && mSlots[slotIndex].mAnimationName.isEmpty(); }));
+        }
+        return count;
+    }
+    
+    auto findIter = mSlotIndicesByName.find(animationName);
+    return findIter != mSlotIndicesByName.end() ? static_cast<int>(findIter->second.size()) : 0;
+}
+
+///------------------------------------------------------------------------------------------------
+
+const AnimationManager::AnimationSlot* AnimationManager::FindSlot(const AnimationHandle& animationHandle) const
+{
+    if (animationHandle.mSlotIndex >= mSlots.size())
+    {
+        return nullptr;
+    }
+    
+    const auto& slot = mSlots[animationHandle.mSlotIndex];
+    return slot.mAlive && slot.mGeneration == animationHandle.mGeneration ? &slot : nullptr;
+}
+
+///------------------------------------------------------------------------------------------------
+
+void AnimationManager::ActivateSlot(const uint32_t slotIndex)
+{
+    // The slot index doubles as the slot's timeline index in the tween batch
+    auto& slot = mSlots[slotIndex];
+    slot.mBatched = slot.mAnimation->VTryAddToTweenBatch(mTweenBatch, slotIndex);
+    mActiveSlotIndices.push_back(slotIndex);
+}
+
+///------------------------------------------------------------------------------------------------
+
+void AnimationManager::KillSlot(const uint32_t slotIndex)
+{
+    auto& slot = mSlots[slotIndex];
+    assert(slot.mAlive);
+    
+    if (!slot.mAnimationName.isEmpty())
+    {
+        auto findIter = mSlotIndicesByName.find(slot.mAnimationName);
+        auto& slotIndicesWithName = findIter->second;
+        slotIndicesWithName.erase(std::find(slotIndicesWithName.begin(), slotIndicesWithName.end(), slotIndex));
+        if (slotIndicesWithName.empty())
+        {
+            mSlotIndicesByName.erase(findIter);
+        }
+    }
+    
+    if (!slot.mPending)
+    {
+        mDeadActiveSlotCount++;
+    }
+    
+    if (slot.mBatched)
+    {
+        mTweenBatch.RemoveTimeline(slotIndex);
+        slot.mBatched = false;
+    }
+    
+    // The slot itself is only recycled once it's no longer referenced by the
+    // active/pending lists, but its generation is bumped right away so that
+    // any outstanding handles to it become invalid.
+    slot.mAlive = false;
+    slot.mGeneration++;
+    slot.mSceneObject = nullptr;
+    slot.mAnimationName = strutils::StringId();
+    slot.mAnimation.reset();
+    slot.mCompletionCallback = nullptr;
+}
+
+///------------------------------------------------------------------------------------------------
+
+void AnimationManager::ReleaseDeadSlots(std::vector<uint32_t>& slotIndices)
+{
+    // Stable compaction so that the remaining animations keep updating (and completing) in start order
+    slotIndices.erase(std::remove_if(slotIndices.begin(), slotIndices.end(), [&](const uint32_t slotIndex)
+    {
+        auto& slot = mSlots[slotIndex];
+        if (slot.mAlive)
+        {
+            return false;
+        }
+        
+        if (!slot.mPending)
+        {
+            mDeadActiveSlotCount--;
+        }
+        
+        slot.mPending = false;
+        mFreeSlotIndices.push_back(slotIndex);
+        return true;
+    }), slotIndices.end());
+}
+
+///------------------------------------------------------------------------------------------------
+
+void AnimationManager::StopFirstAnimationWithName(const strutils::StringId& animationName)
+{
+    if (!animationName.isEmpty())
+    {
+        auto findIter = mSlotIndicesByName.find(animationName);
+        if (findIter != mSlotIndicesByName.end())
+        {
+            KillSlot(findIter->second.front());
+        }
+        return;
+    }
+    
+    // Unnamed animations aren't indexed
+    for (const auto* slotIndices: { &mActiveSlotIndices, &mSlotIndicesToAdd })
+    {
+        for (const auto slotIndex: *slotIndices)
+        {
+            if (mSlots[slotIndex].mAlive && mSlots[slotIndex].mAnimationName.isEmpty())
+            {
+                KillSlot(slotIndex);
+                return;
+            }
+        }
+    }
 }
 
 ///------------------------------------------------------------------------------------------------
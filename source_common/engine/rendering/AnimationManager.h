@@ -12,6 +12,7 @@
 
 #include <engine/CoreSystemsEngine.h>
 #include <engine/rendering/Animations.h>
+#include <engine/rendering/TweenBatch.h>
 #include <engine/utils/StringUtils.h>
 #include <functional>
 #include <memory>
@@ -20,40 +21,71 @@
 
 ///------------------------------------------------------------------------------------------------
 
+namespace scene { struct SceneObject; }
+
+///------------------------------------------------------------------------------------------------
+
 namespace rendering
 {
 
 ///------------------------------------------------------------------------------------------------
 
+// Generational handle to a started animation. Handles of finished or stopped
+// animations are never reused for newer ones, so they can be safely kept around.
+struct AnimationHandle
+{
+    uint32_t mSlotIndex = 0;
+    uint32_t mGeneration = 0;
+};
+
+///------------------------------------------------------------------------------------------------
+
 class AnimationManager final
 {
     friend struct CoreSystemsEngine::SystemsImpl;
 public:
-    void StartAnimation(std::unique_ptr<IAnimation> animation, std::function<void()> onCompleteCallback, const strutils::StringId animationName = strutils::StringId());
+    AnimationManager() = default;
+    
+    AnimationHandle StartAnimation(std::unique_ptr<IAnimation> animation, std::function<void()> onCompleteCallback, const strutils::StringId animationName = strutils::StringId());
     void StopAnimation(const strutils::StringId& animationName);
+    void StopAnimation(const AnimationHandle& animationHandle);
     void StopAllAnimationsPlayingForSceneObject(const strutils::StringId& sceneObjectName);
     void StopAllAnimations();
     void Update(const float dtMillis);
     
     bool IsAnimationPlaying(const strutils::StringId& animationName) const;
+    bool IsAnimationPlaying(const AnimationHandle& animationHandle) const;
     int GetAnimationCountPlayingForSceneObject(const strutils::StringId& sceneObjectName);
     int GetAnimationsPlayingCount() const;
     int GetAnimationCountPlayingWithName(const strutils::StringId& animationName) const;
     
 private:
-    AnimationManager() = default;
-    
-private:
-    struct AnimationEntry
+    struct AnimationSlot
     {
         std::unique_ptr<IAnimation> mAnimation;
         std::function<void()> mCompletionCallback;
         strutils::StringId mAnimationName;
+        scene::SceneObject* mSceneObject = nullptr;
+        uint32_t mGeneration = 0;
+        bool mAlive = false;
+        bool mPending = false;
+        bool mBatched = false;
     };
     
-    std::vector<AnimationEntry> mAnimations;
-    std::vector<AnimationEntry> mAnimationsToAdd;
-    std::vector<strutils::StringId> mAnimationNamesToRemove;
+    const AnimationSlot* FindSlot(const AnimationHandle& animationHandle) const;
+    void ActivateSlot(const uint32_t slotIndex);
+    void KillSlot(const uint32_t slotIndex);
+    void ReleaseDeadSlots(std::vector<uint32_t>& slotIndices);
+    void StopFirstAnimationWithName(const strutils::StringId& animationName);
+    
+private:
+    std::vector<AnimationSlot> mSlots;
+    std::vector<uint32_t> mFreeSlotIndices;
+    std::vector<uint32_t> mActiveSlotIndices;
+    std::vector<uint32_t> mSlotIndicesToAdd;
+    std::unordered_map<strutils::StringId, std::vector<uint32_t>, strutils::StringIdHasher> mSlotIndicesByName;
+    TweenBatch mTweenBatch;
+    int mDeadActiveSlotCount = 0;
     bool mAnimationContainerLocked = false;
 };
 
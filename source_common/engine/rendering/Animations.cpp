@@ -6,8 +6,11 @@
 ///------------------------------------------------------------------------------------------------
 
 #include <engine/rendering/Animations.h>
+#include <engine/rendering/TweenBatch.h>
 #include <engine/scene/SceneObject.h>
 #include <engine/utils/Logging.h>
+#include <array>
+#include <mutex>
 
 ///------------------------------------------------------------------------------------------------
 
@@ -20,6 +23,104 @@ namespace rendering
 
 ///------------------------------------------------------------------------------------------------
 
+static constexpr std::size_t ANIMATION_POOL_SIZE_GRANULARITY = 16;
+static constexpr std::size_t ANIMATION_POOL_MAX_POOLED_SIZE = 512;
+static constexpr std::size_t ANIMATION_POOL_ANIMATIONS_PER_CHUNK = 64;
+
+static const uint8_t COMPONENT_IGNORE_FLAGS[3] = { animation_flags::IGNORE_X_COMPONENT, animation_flags::IGNORE_Y_COMPONENT, animation_flags::IGNORE_Z_COMPONENT };
+
+///------------------------------------------------------------------------------------------------
+
+class AnimationPool final
+{
+public:
+    static AnimationPool& GetInstance()
+    {
+        // Intentionally leaked, as animations can outlive any other static
+        static auto* instance = new AnimationPool();
+        return *instance;
+    }
+    
+    void* Allocate(const std::size_t size)
+    {
+        if (size > ANIMATION_POOL_MAX_POOLED_SIZE)
+        {
+            return ::operator new(size);
+        }
+        
+        std::lock_guard<std::mutex> lock(mMutex);
+        
+        auto& freeList = mFreeLists[GetSizeClassIndex(size)];
+        if (!freeList)
+        {
+            AllocateChunk(GetSizeClassIndex(size));
+        }
+        
+        auto* block = freeList;
+        freeList = block->mNext;
+        return block;
+    }
+    
+    void Deallocate(void* animation, const std::size_t size)
+    {
+        if (size > ANIMATION_POOL_MAX_POOLED_SIZE)
+        {
+            ::operator delete(animation);
+            return;
+        }
+        
+        std::lock_guard<std::mutex> lock(mMutex);
+        
+        auto& freeList = mFreeLists[GetSizeClassIndex(size)];
+        auto* block = static_cast<FreeBlock*>(animation);
+        block->mNext = freeList;
+        freeList = block;
+    }
+    
+private:
+    struct FreeBlock
+    {
+        FreeBlock* mNext;
+    };
+    
+    static std::size_t GetSizeClassIndex(const std::size_t size)
+    {
+        return (size - 1)/ANIMATION_POOL_SIZE_GRANULARITY;
+    }
+    
+    void AllocateChunk(const std::size_t sizeClassIndex)
+    {
+        const auto blockSize = (sizeClassIndex + 1) * ANIMATION_POOL_SIZE_GRANULARITY;
+        mChunks.emplace_back(std::make_unique<unsigned char[]>(blockSize * ANIMATION_POOL_ANIMATIONS_PER_CHUNK));
+        
+        for (auto i = 0U; i < ANIMATION_POOL_ANIMATIONS_PER_CHUNK; ++i)
+        {
+            auto* block = reinterpret_cast<FreeBlock*>(mChunks.back().get() + i * blockSize);
+            block->mNext = mFreeLists[sizeClassIndex];
+            mFreeLists[sizeClassIndex] = block;
+        }
+    }
+    
+private:
+    std::mutex mMutex;
+    std::array<FreeBlock*, ANIMATION_POOL_MAX_POOLED_SIZE/ANIMATION_POOL_SIZE_GRANULARITY> mFreeLists = {};
+    std::vector<std::unique_ptr<unsigned char[]>> mChunks;
+};
+
+///------------------------------------------------------------------------------------------------
+
+void* BaseAnimation::operator new(std::size_t size)
+{
+    return AnimationPool::GetInstance().Allocate(size);
+}
+
+void BaseAnimation::operator delete(void* animation, std::size_t size)
+{
+    AnimationPool::GetInstance().Deallocate(animation, size);
+}
+
+///------------------------------------------------------------------------------------------------
+
 BaseAnimation::BaseAnimation(const uint8_t animationFlags, const float secsDuration, const float secsDelay /* = 0.0f */)
     : mAnimationFlags(animationFlags)
     , mSecsDuration(secsDuration)
@@ -52,6 +153,11 @@ AnimationUpdateResult BaseAnimation::VUpdate(const float dtMillis)
     return (mAnimationT < 1.0f || mSecsDuration < 0.0f) ? AnimationUpdateResult::ONGOING : AnimationUpdateResult::FINISHED;
 }
 
+bool BaseAnimation::VTryAddToTweenBatch(TweenBatch&, const uint32_t)
+{
+    return false;
+}
+
 ///------------------------------------------------------------------------------------------------
 
 TimeDelayAnimation::TimeDelayAnimation(const float secsDuration)
@@ -110,6 +216,35 @@ std::shared_ptr<scene::SceneObject> TweenPositionScaleAnimation::VGetSceneObject
     return mSceneObjectTarget;
 }
 
+bool TweenPositionScaleAnimation::VTryAddToTweenBatch(TweenBatch& tweenBatch, const uint32_t timelineIndex)
+{
+    const auto tweeningFunctionType = math::GetTweeningFunctionType(mTweeningFunc);
+    if (tweeningFunctionType == math::TweeningFunctionType::CUSTOM)
+    {
+        return false;
+    }
+    
+    tweenBatch.AddTimeline(timelineIndex, mSceneObjectTarget.get(), mSecsDuration, mSecsDelay, tweeningFunctionType, mTweeningMode);
+    
+    for (auto i = 0; i < 3; ++i)
+    {
+        if (!IS_FLAG_SET(COMPONENT_IGNORE_FLAGS[i]))
+        {
+            tweenBatch.AddLane(timelineIndex, &mSceneObjectTarget->mPosition[i], mInitPosition[i], mTargetPosition[i]);
+        }
+    }
+    
+    if (!IS_FLAG_SET(animation_flags::IGNORE_SCALE))
+    {
+        for (auto i = 0; i < 3; ++i)
+        {
+            tweenBatch.AddLane(timelineIndex, &mSceneObjectTarget->mScale[i], mInitScale[i], mTargetScale[i]);
+        }
+    }
+    
+    return true;
+}
+
 ///------------------------------------------------------------------------------------------------
 
 TweenPositionScaleGroupAnimation::TweenPositionScaleGroupAnimation(std::vector<std::shared_ptr<scene::SceneObject>> sceneObjectTargets, const glm::vec3& targetPosition, const glm::vec3& targetScale, const float secsDuration, const uint8_t animationFlags /* = animation_flags::NONE */, const float secsDelay /* = 0.0f */, const std::function<float(const float)> tweeningFunc /* = math::LinearFunction */, const math::TweeningMode tweeningMode /* = math::TweeningMode::EASE_IN */)
@@ -199,6 +334,26 @@ std::shared_ptr<scene::SceneObject> TweenRotationAnimation::VGetSceneObject()
     return mSceneObjectTarget;
 }
 
+bool TweenRotationAnimation::VTryAddToTweenBatch(TweenBatch& tweenBatch, const uint32_t timelineIndex)
+{
+    // Component ignoring rotation tweens stay on VUpdate, as it sources the
+    // ignored components from the position rather than the rotation.
+    const auto tweeningFunctionType = math::GetTweeningFunctionType(mTweeningFunc);
+    if (tweeningFunctionType == math::TweeningFunctionType::CUSTOM || IS_FLAG_SET((animation_flags::IGNORE_X_COMPONENT | animation_flags::IGNORE_Y_COMPONENT | animation_flags::IGNORE_Z_COMPONENT)))
+    {
+        return false;
+    }
+    
+    tweenBatch.AddTimeline(timelineIndex, mSceneObjectTarget.get(), mSecsDuration, mSecsDelay, tweeningFunctionType, mTweeningMode);
+    
+    for (auto i = 0; i < 3; ++i)
+    {
+        tweenBatch.AddLane(timelineIndex, &mSceneObjectTarget->mRotation[i], mInitRotation[i], mTargetRotation[i]);
+    }
+    
+    return true;
+}
+
 ///------------------------------------------------------------------------------------------------
 
 TweenAlphaAnimation::TweenAlphaAnimation(std::shared_ptr<scene::SceneObject> sceneObjectTarget, const float targetAlpha, const float secsDuration, const uint8_t animationFlags /* = animation_flags::NONE */, const float secsDelay /* = 0.0f */, const std::function<float(const float)> tweeningFunc /* = math::LinearFunction */, const math::TweeningMode tweeningMode /* = math::TweeningMode::EASE_IN */)
@@ -227,6 +382,20 @@ std::shared_ptr<scene::SceneObject> TweenAlphaAnimation::VGetSceneObject()
     return mSceneObjectTarget;
 }
 
+bool TweenAlphaAnimation::VTryAddToTweenBatch(TweenBatch& tweenBatch, const uint32_t timelineIndex)
+{
+    const auto tweeningFunctionType = math::GetTweeningFunctionType(mTweeningFunc);
+    if (tweeningFunctionType == math::TweeningFunctionType::CUSTOM)
+    {
+        return false;
+    }
+    
+    // Uniform values are never erased, so the address of the alpha uniform is stable for the tween's lifetime
+    tweenBatch.AddTimeline(timelineIndex, mSceneObjectTarget.get(), mSecsDuration, mSecsDelay, tweeningFunctionType, mTweeningMode);
+    tweenBatch.AddLane(timelineIndex, &mSceneObjectTarget->mShaderFloatUniformValues[game_constants::CUSTOM_ALPHA_UNIFORM_NAME], mInitAlpha, mTargetAlpha);
+    return true;
+}
+
 ///------------------------------------------------------------------------------------------------
 
 TweenValueAnimation::TweenValueAnimation(float& value, const float targetValue, const float secsDuration, const uint8_t animationFlags /* = animation_flags::NONE */, const float secsDelay /* = 0.0f */, const std::function<float(const float)> tweeningFunc /* = math::LinearFunction */, const math::TweeningMode tweeningMode /* = math::TweeningMode::EASE_IN */)
@@ -255,6 +424,19 @@ std::shared_ptr<scene::SceneObject> TweenValueAnimation::VGetSceneObject()
     return nullptr;
 }
 
+bool TweenValueAnimation::VTryAddToTweenBatch(TweenBatch& tweenBatch, const uint32_t timelineIndex)
+{
+    const auto tweeningFunctionType = math::GetTweeningFunctionType(mTweeningFunc);
+    if (tweeningFunctionType == math::TweeningFunctionType::CUSTOM)
+    {
+        return false;
+    }
+    
+    tweenBatch.AddTimeline(timelineIndex, nullptr, mSecsDuration, mSecsDelay, tweeningFunctionType, mTweeningMode);
+    tweenBatch.AddLane(timelineIndex, &mValue, mInitValue, mTargetValue);
+    return true;
+}
+
 ///------------------------------------------------------------------------------------------------
 
 PulseAnimation::PulseAnimation(std::shared_ptr<scene::SceneObject> sceneObjectTarget, const float scaleFactor, const float secsPulseDuration, const uint8_t animationFlags /* = animation_flags::NONE */, const float secsDelay /* = 0.0f */, const std::function<float(const float)> tweeningFunc /* = math::LinearFunction */, const math::TweeningMode tweeningMode /* = math::TweeningMode::EASE_IN */)
@@ -39,6 +39,10 @@ namespace rendering
 
 ///------------------------------------------------------------------------------------------------
 
+class TweenBatch;
+
+///------------------------------------------------------------------------------------------------
+
 enum class AnimationUpdateResult
 {
     ONGOING,
@@ -53,6 +57,10 @@ public:
     virtual ~IAnimation() = default;
     virtual AnimationUpdateResult VUpdate(const float dtMillis) = 0;
     virtual std::shared_ptr<scene::SceneObject> VGetSceneObject() = 0;
+    
+    // Returns true if the animation has handed its tween over to the given batch,
+    // in which case the batch advances it and VUpdate is no longer called.
+    virtual bool VTryAddToTweenBatch(TweenBatch& tweenBatch, const uint32_t timelineIndex) = 0;
 };
 
 ///------------------------------------------------------------------------------------------------
@@ -63,6 +71,12 @@ public:
     BaseAnimation(const uint8_t animationFlags, const float secsDuration, const float secsDelay = 0.0f);
     virtual ~BaseAnimation() = default;
     virtual AnimationUpdateResult VUpdate(const float dtMillis);
+    bool VTryAddToTweenBatch(TweenBatch& tweenBatch, const uint32_t timelineIndex) override;
+    
+    // All animations are allocated from pooled, per-size free lists so that
+    // starting one (even via std::make_unique) doesn't go to the heap.
+    static void* operator new(std::size_t size);
+    static void operator delete(void* animation, std::size_t size);
     
 protected:
     const uint8_t mAnimationFlags;
@@ -90,6 +104,7 @@ public:
     TweenPositionScaleAnimation(std::shared_ptr<scene::SceneObject> sceneObjectTarget, const glm::vec3& targetPosition, const glm::vec3& targetScale, const float secsDuration, const uint8_t animationFlags = animation_flags::NONE, const float secsDelay = 0.0f, const std::function<float(const float)> tweeningFunc = math::LinearFunction, const math::TweeningMode tweeningMode = math::TweeningMode::EASE_IN);
     AnimationUpdateResult VUpdate(const float dtMillis) override;
     std::shared_ptr<scene::SceneObject> VGetSceneObject() override;
+    bool VTryAddToTweenBatch(TweenBatch& tweenBatch, const uint32_t timelineIndex) override;
     
 private:
     std::shared_ptr<scene::SceneObject> mSceneObjectTarget;
@@ -128,6 +143,7 @@ public:
     TweenRotationAnimation(std::shared_ptr<scene::SceneObject> sceneObjectTarget, const glm::vec3& targetRotation, const float secsDuration, const uint8_t animationFlags = animation_flags::NONE, const float secsDelay = 0.0f, const std::function<float(const float)> tweeningFunc = math::LinearFunction, const math::TweeningMode tweeningMode = math::TweeningMode::EASE_IN);
     AnimationUpdateResult VUpdate(const float dtMillis) override;
     std::shared_ptr<scene::SceneObject> VGetSceneObject() override;
+    bool VTryAddToTweenBatch(TweenBatch& tweenBatch, const uint32_t timelineIndex) override;
     
 private:
     std::shared_ptr<scene::SceneObject> mSceneObjectTarget;
@@ -146,6 +162,7 @@ public:
     TweenAlphaAnimation(std::shared_ptr<scene::SceneObject> sceneObjectTarget, const float targetAlpha, const float secsDuration, const uint8_t animationFlags = animation_flags::NONE, const float secsDelay = 0.0f, const std::function<float(const float)> tweeningFunc = math::LinearFunction, const math::TweeningMode tweeningMode = math::TweeningMode::EASE_IN);
     AnimationUpdateResult VUpdate(const float dtMillis) override;
     std::shared_ptr<scene::SceneObject> VGetSceneObject() override;
+    bool VTryAddToTweenBatch(TweenBatch& tweenBatch, const uint32_t timelineIndex) override;
     
 private:
     std::shared_ptr<scene::SceneObject> mSceneObjectTarget;
@@ -163,6 +180,7 @@ public:
     TweenValueAnimation(float& value, const float targetValue, const float secsDuration, const uint8_t animationFlags = animation_flags::NONE, const float secsDelay = 0.0f, const std::function<float(const float)> tweeningFunc = math::LinearFunction, const math::TweeningMode tweeningMode = math::TweeningMode::EASE_IN);
     AnimationUpdateResult VUpdate(const float dtMillis) override;
     std::shared_ptr<scene::SceneObject> VGetSceneObject() override;
+    bool VTryAddToTweenBatch(TweenBatch& tweenBatch, const uint32_t timelineIndex) override;
     
 private:
     float& mValue;
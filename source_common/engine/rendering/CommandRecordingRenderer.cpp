@@ -0,0 +1,213 @@
+///------------------------------------------------------------------------------------------------
+///  CommandRecordingRenderer.cpp
+///  Predators
+///
+///  Created by Alex Koukoulas on 25/04/2024
+///------------------------------------------------------------------------------------------------
+
+#include <engine/rendering/Camera.h>
+#include <engine/rendering/CommandRecordingRenderer.h>
+#include <engine/scene/Scene.h>
+#include <engine/scene/SceneObjectUtils.h>
+
+///------------------------------------------------------------------------------------------------
+
+namespace rendering
+{
+
+///------------------------------------------------------------------------------------------------
+
+// Bytes of the fixed uniforms RendererPlatformImpl uploads for each draw of the respective scene object type
+static constexpr std::size_t DEFAULT_SCENE_OBJECT_UNIFORM_BYTES = 3 * sizeof(float) + 2 * sizeof(glm::mat4);          // custom_alpha, affected_by_light, texture_sheet, world, rot
+static constexpr std::size_t TEXT_GLYPH_UNIFORM_BYTES = 6 * sizeof(float) + sizeof(glm::mat4);                        // custom_alpha, texture_sheet, min/max uvs, world
+static constexpr std::size_t PARTICLE_EMITTER_UNIFORM_BYTES = sizeof(float);                                          // custom_alpha
+static constexpr std::size_t PER_SCENE_UNIFORM_BLOCK_BYTES = 2 * sizeof(glm::mat4);                                   // view, proj
+
+///------------------------------------------------------------------------------------------------
+
+static std::size_t CalculateCustomUniformBytes(const scene::SceneObject& sceneObject)
+{
+    return sceneObject.mShaderVec3UniformValues.size() * sizeof(glm::vec3) +
+           sceneObject.mShaderFloatUniformValues.size() * sizeof(float) +
+           sceneObject.mShaderIntUniformValues.size() * sizeof(int) +
+           sceneObject.mShaderBoolUniformValues.size() * sizeof(int);
+}
+
+///------------------------------------------------------------------------------------------------
+
+void CommandRecordingRenderer::VBeginRenderPass()
+{
+    mSceneObjectsWithDeferredRendering.clear();
+    mSceneStats.clear();
+    mBoundState = BoundState();
+}
+
+///------------------------------------------------------------------------------------------------
+
+void CommandRecordingRenderer::VRenderScene(scene::Scene& scene)
+{
+    auto& sceneStats = mSceneStats[scene.GetName()];
+    
+    const auto frustum = scene.GetCamera().CalculateFrustum();
+    RecordCameraUpload(scene.GetCamera(), sceneStats);
+    
+    for (const auto& sceneObject: scene.GetSceneObjects())
+    {
+        if (sceneObject->mInvisible) continue;
+        if (scene_object_utils::IsSceneObjectOutsideOfFrustum(*sceneObject, frustum))
+        {
+            sceneStats.mSceneObjectsCulled++;
+            continue;
+        }
+        
+        sceneStats.mSceneObjectsDrawn++;
+        if (sceneObject->mDeferredRendering)
+        {
+            mSceneObjectsWithDeferredRendering.push_back({ scene.GetName(), &scene.GetCamera(), sceneObject });
+            continue;
+        }
+        RecordSceneObject(*sceneObject, sceneStats);
+    }
+}
+
+///------------------------------------------------------------------------------------------------
+
+void CommandRecordingRenderer::VRenderSceneObjectsToTexture(const std::vector<std::shared_ptr<scene::SceneObject>>& sceneObjects, const rendering::Camera& camera)
+{
+    auto& renderToTextureStats = mSceneStats[RENDER_TO_TEXTURE_STATS_NAME];
+    
+    // The real renderer offsets the camera for the texture's viewport, so its matrices always change
+    mBoundState.mView = glm::mat4(0.0f);
+    RecordCameraUpload(camera, renderToTextureStats);
+    
+    for (const auto& sceneObject: sceneObjects)
+    {
+        renderToTextureStats.mSceneObjectsDrawn++;
+        RecordSceneObject(*sceneObject, renderToTextureStats);
+    }
+}
+
+///------------------------------------------------------------------------------------------------
+
+void CommandRecordingRenderer::VEndRenderPass()
+{
+    for (const auto& sceneObjectEntry: mSceneObjectsWithDeferredRendering)
+    {
+        auto& sceneStats = mSceneStats[sceneObjectEntry.mSceneName];
+        RecordCameraUpload(*sceneObjectEntry.mCamera, sceneStats);
+        RecordSceneObject(*sceneObjectEntry.mSceneObject, sceneStats);
+    }
+}
+
+///------------------------------------------------------------------------------------------------
+
+RenderCommandStats CommandRecordingRenderer::GetFrameStats() const
+{
+    RenderCommandStats frameStats;
+    for (const auto& sceneStatsEntry: mSceneStats)
+    {
+        frameStats.mDrawCalls += sceneStatsEntry.second.mDrawCalls;
+        frameStats.mStateChanges += sceneStatsEntry.second.mStateChanges;
+        frameStats.mUploadedBytes += sceneStatsEntry.second.mUploadedBytes;
+        frameStats.mSceneObjectsDrawn += sceneStatsEntry.second.mSceneObjectsDrawn;
+        frameStats.mSceneObjectsCulled += sceneStatsEntry.second.mSceneObjectsCulled;
+    }
+    return frameStats;
+}
+
+///------------------------------------------------------------------------------------------------
+
+const RenderCommandStats* CommandRecordingRenderer::GetSceneStats(const strutils::StringId& sceneName) const
+{
+    auto sceneStatsIter = mSceneStats.find(sceneName);
+    return sceneStatsIter != mSceneStats.end() ? &sceneStatsIter->second : nullptr;
+}
+
+///------------------------------------------------------------------------------------------------
+
+void CommandRecordingRenderer::RecordCameraUpload(const rendering::Camera& camera, RenderCommandStats& stats)
+{
+    if (mBoundState.mView == camera.GetViewMatrix() && mBoundState.mProj == camera.GetProjMatrix())
+    {
+        return;
+    }
+    
+    mBoundState.mView = camera.GetViewMatrix();
+    mBoundState.mProj = camera.GetProjMatrix();
+    stats.mUploadedBytes += PER_SCENE_UNIFORM_BLOCK_BYTES;
+}
+
+///------------------------------------------------------------------------------------------------
+
+void CommandRecordingRenderer::RecordSceneObject(const scene::SceneObject& sceneObject, RenderCommandStats& stats)
+{
+    RecordBind(mBoundState.mShaderResourceId, sceneObject.mShaderResourceId, stats);
+    for (int i = 0; i < scene::EFFECT_TEXTURES_COUNT; ++i)
+    {
+        if (sceneObject.mEffectTextureResourceIds[i] != 0)
+        {
+            RecordBind(mBoundState.mTextureResourceIds[1 + i], sceneObject.mEffectTextureResourceIds[i], stats);
+        }
+    }
+    
+    const auto customUniformBytes = CalculateCustomUniformBytes(sceneObject);
+    
+    if (const auto* textData = std::get_if<scene::TextSceneObjectData>(&sceneObject.mSceneObjectTypeData))
+    {
+        RecordBind(mBoundState.mMeshResourceId, sceneObject.mMeshResourceId, stats);
+        
+        // Glyphs sample their font's texture, which is only resolvable through the font repository
+        if (mBoundState.mFontName != textData->mFontName)
+        {
+            mBoundState.mTextureResourceIds[0] = UNBOUND_RESOURCE_ID;
+            mBoundState.mFontName = textData->mFontName;
+            stats.mStateChanges++;
+        }
+        
+        // One draw per glyph
+        const auto glyphCount = static_cast<int>(textData->mText.size());
+        stats.mDrawCalls += glyphCount;
+        stats.mUploadedBytes += glyphCount * (TEXT_GLYPH_UNIFORM_BYTES + customUniformBytes);
+    }
+    else if (const auto* particleEmitterData = std::get_if<scene::ParticleEmitterObjectData>(&sceneObject.mSceneObjectTypeData))
+    {
+        // Emitters bind their own vertex array object, so the next mesh bind is always a change
+        mBoundState.mMeshResourceId = UNBOUND_RESOURCE_ID;
+        stats.mStateChanges++;
+        
+        RecordBind(mBoundState.mTextureResourceIds[0], sceneObject.mTextureResourceId, stats);
+        mBoundState.mFontName = strutils::StringId();
+        
+        // Per instance particle attribute buffers are re-uploaded every draw
+        const auto particleCount = particleEmitterData->mParticlePositions.size();
+        stats.mDrawCalls++;
+        stats.mUploadedBytes += PARTICLE_EMITTER_UNIFORM_BYTES + customUniformBytes;
+        stats.mUploadedBytes += particleCount * (sizeof(glm::vec3) + 3 * sizeof(float));
+    }
+    else
+    {
+        RecordBind(mBoundState.mMeshResourceId, sceneObject.mMeshResourceId, stats);
+        RecordBind(mBoundState.mTextureResourceIds[0], sceneObject.mTextureResourceId, stats);
+        mBoundState.mFontName = strutils::StringId();
+        
+        stats.mDrawCalls++;
+        stats.mUploadedBytes += DEFAULT_SCENE_OBJECT_UNIFORM_BYTES + customUniformBytes;
+    }
+}
+
+///------------------------------------------------------------------------------------------------
+
+void CommandRecordingRenderer::RecordBind(resources::ResourceId& boundResourceId, const resources::ResourceId resourceId, RenderCommandStats& stats)
+{
+    if (boundResourceId != resourceId)
+    {
+        boundResourceId = resourceId;
+        stats.mStateChanges++;
+    }
+}
+
+///------------------------------------------------------------------------------------------------
+
+}
+
+///------------------------------------------------------------------------------------------------
@@ -0,0 +1,100 @@
+///------------------------------------------------------------------------------------------------
+///  CommandRecordingRenderer.h
+///  Predators
+///
+///  Created by Alex Koukoulas on 25/04/2024
+///------------------------------------------------------------------------------------------------
+
+#ifndef CommandRecordingRenderer_h
+#define CommandRecordingRenderer_h
+
+///------------------------------------------------------------------------------------------------
+
+#include <engine/rendering/IRenderer.h>
+#include <engine/scene/SceneObject.h>
+#include <engine/utils/MathUtils.h>
+#include <engine/utils/StringUtils.h>
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <unordered_map>
+
+///------------------------------------------------------------------------------------------------
+
+namespace rendering
+{
+
+///------------------------------------------------------------------------------------------------
+
+struct RenderCommandStats
+{
+    int mDrawCalls = 0;
+    int mStateChanges = 0;
+    std::size_t mUploadedBytes = 0;
+    int mSceneObjectsDrawn = 0;
+    int mSceneObjectsCulled = 0;
+};
+
+///------------------------------------------------------------------------------------------------
+
+inline const strutils::StringId RENDER_TO_TEXTURE_STATS_NAME = strutils::StringId("render_to_texture");
+
+///------------------------------------------------------------------------------------------------
+/// Null renderer that issues no GL calls. It walks scenes exactly like RendererPlatformImpl does
+/// (visibility, frustum culling, deferred scene objects) and instead records the draw calls,
+/// state changes (shader, mesh & texture binds that differ from the currently bound ones) and
+/// uniform/buffer bytes the real renderer would need, per scene and for the whole frame.
+class CommandRecordingRenderer final: public IRenderer
+{
+public:
+    void VBeginRenderPass() override;
+    void VRenderScene(scene::Scene& scene) override;
+    void VRenderSceneObjectsToTexture(const std::vector<std::shared_ptr<scene::SceneObject>>& sceneObjects, const rendering::Camera& camera) override;
+    void VEndRenderPass() override;
+    
+    // Sum of all scenes' stats since the last VBeginRenderPass.
+    [[nodiscard]] RenderCommandStats GetFrameStats() const;
+    
+    // Stats of the given scene (or RENDER_TO_TEXTURE_STATS_NAME) since the last VBeginRenderPass,
+    // or nullptr if it has not been rendered in the current frame.
+    [[nodiscard]] const RenderCommandStats* GetSceneStats(const strutils::StringId& sceneName) const;
+    
+private:
+    static constexpr resources::ResourceId UNBOUND_RESOURCE_ID = std::numeric_limits<resources::ResourceId>::max();
+    
+    struct BoundState
+    {
+        BoundState() { std::fill(std::begin(mTextureResourceIds), std::end(mTextureResourceIds), UNBOUND_RESOURCE_ID); }
+        
+        resources::ResourceId mShaderResourceId = UNBOUND_RESOURCE_ID;
+        resources::ResourceId mMeshResourceId = UNBOUND_RESOURCE_ID;
+        resources::ResourceId mTextureResourceIds[1 + scene::EFFECT_TEXTURES_COUNT];
+        strutils::StringId mFontName;
+        glm::mat4 mView = glm::mat4(0.0f);
+        glm::mat4 mProj = glm::mat4(0.0f);
+    };
+    
+    struct DeferredSceneObjectEntry
+    {
+        strutils::StringId mSceneName;
+        const rendering::Camera* mCamera;
+        std::shared_ptr<scene::SceneObject> mSceneObject;
+    };
+    
+    void RecordCameraUpload(const rendering::Camera& camera, RenderCommandStats& stats);
+    void RecordSceneObject(const scene::SceneObject& sceneObject, RenderCommandStats& stats);
+    void RecordBind(resources::ResourceId& boundResourceId, const resources::ResourceId resourceId, RenderCommandStats& stats);
+    
+private:
+    std::vector<DeferredSceneObjectEntry> mSceneObjectsWithDeferredRendering;
+    std::unordered_map<strutils::StringId, RenderCommandStats, strutils::StringIdHasher> mSceneStats;
+    BoundState mBoundState;
+};
+
+///------------------------------------------------------------------------------------------------
+
+}
+
+///------------------------------------------------------------------------------------------------
+
+#endif /* CommandRecordingRenderer_h */
@@ -0,0 +1,180 @@
+///------------------------------------------------------------------------------------------------
+///  GpuProfiler.cpp
+///  Predators
+///
+///  Created by Alex Koukoulas on 24/04/2024
+///------------------------------------------------------------------------------------------------
+
+#include <engine/rendering/GpuProfiler.h>
+#include <engine/rendering/OpenGL.h>
+#include <algorithm>
+#include <cstring>
+
+///------------------------------------------------------------------------------------------------
+
+namespace rendering
+{
+
+///------------------------------------------------------------------------------------------------
+
+static constexpr float STAGE_TIMING_AVERAGE_WEIGHT = 0.1f;
+static constexpr int STALE_STAGE_TIMING_FRAME_COUNT = 60;
+
+///------------------------------------------------------------------------------------------------
+
+void GpuProfiler::SetEnabled(const bool enabled)
+{
+    mEnabled = enabled;
+    if (!mEnabled)
+    {
+        mStageTimings.clear();
+    }
+}
+
+///------------------------------------------------------------------------------------------------
+
+bool GpuProfiler::IsEnabled() const { return mEnabled; }
+
+///------------------------------------------------------------------------------------------------
+
+void GpuProfiler::BeginFrame()
+{
+    // A stage left open would otherwise leak into the next frame's ring slot
+    if (mActiveStageIndex != -1)
+    {
+        mIgnoredNestedStageDepth = 0;
+        EndStage();
+    }
+    
+    mCurrentFrameIndex = (mCurrentFrameIndex + 1) % FRAME_QUERY_RING_SIZE;
+    ResolveFrameQueries(mFrameQueryRing[mCurrentFrameIndex]);
+    
+    for (auto iter = mStageTimings.begin(); iter != mStageTimings.end();)
+    {
+        if (++iter->mFramesSinceLastResolved > STALE_STAGE_TIMING_FRAME_COUNT)
+        {
+            iter = mStageTimings.erase(iter);
+        }
+        else
+        {
+            ++iter;
+        }
+    }
+}
+
+///------------------------------------------------------------------------------------------------
+
+void GpuProfiler::BeginStage(const char* stageName)
+{
+#if defined(GL_TIME_ELAPSED)
+    if (mActiveStageIndex != -1)
+    {
+        mIgnoredNestedStageDepth++;
+        return;
+    }
+    
+    auto& frameQueries = mFrameQueryRing[mCurrentFrameIndex];
+    if (!mEnabled || frameQueries.mStageCount == MAX_STAGES_PER_FRAME)
+    {
+        return;
+    }
+    
+    auto& stageQuery = frameQueries.mStageQueries[frameQueries.mStageCount];
+    if (stageQuery.mQueryId == 0)
+    {
+        GL_CALL(glGenQueries(1, &stageQuery.mQueryId));
+    }
+    
+    stageQuery.mStageName = stageName;
+    stageQuery.mSubmitNanos = profiling::GetNowNanos();
+    GL_CALL(glBeginQuery(GL_TIME_ELAPSED, stageQuery.mQueryId));
+    mActiveStageIndex = frameQueries.mStageCount++;
+#else
+    (void)stageName;
+#endif
+}
+
+///------------------------------------------------------------------------------------------------
+
+void GpuProfiler::EndStage()
+{
+#if defined(GL_TIME_ELAPSED)
+    if (mIgnoredNestedStageDepth > 0)
+    {
+        mIgnoredNestedStageDepth--;
+        return;
+    }
+    
+    if (mActiveStageIndex == -1)
+    {
+        return;
+    }
+    
+    GL_CALL(glEndQuery(GL_TIME_ELAPSED));
+    mActiveStageIndex = -1;
+#endif
+}
+
+///------------------------------------------------------------------------------------------------
+
+const std::vector<GpuStageTiming>& GpuProfiler::GetStageTimings() const { return mStageTimings; }
+
+///------------------------------------------------------------------------------------------------
+
+void GpuProfiler::ResolveFrameQueries(FrameQueries& frameQueries)
+{
+#if defined(GL_TIME_ELAPSED)
+    for (int i = 0; i < frameQueries.mStageCount; ++i)
+    {
+        const auto& stageQuery = frameQueries.mStageQueries[i];
+        
+        GLint resultAvailable = 0;
+        GL_CALL(glGetQueryObjectiv(stageQuery.mQueryId, GL_QUERY_RESULT_AVAILABLE, &resultAvailable));
+        if (!resultAvailable)
+        {
+            continue;
+        }
+        
+        GLuint64 elapsedNanos = 0;
+        GL_CALL(glGetQueryObjectui64v(stageQuery.mQueryId, GL_QUERY_RESULT, &elapsedNanos));
+        
+        if (mEnabled)
+        {
+            UpdateStageTiming(stageQuery.mStageName, elapsedNanos/1000000.0f);
+        }
+        
+        // GPU zones are placed at their CPU submission time, as the two clocks are not correlated
+        if (profiling::IsEnabled())
+        {
+            if (mProfilingTrackId == -1)
+            {
+                mProfilingTrackId = profiling::CreateTrack("GPU");
+            }
+            profiling::RecordZone(mProfilingTrackId, stageQuery.mStageName, stageQuery.mSubmitNanos, static_cast<std::int64_t>(elapsedNanos));
+        }
+    }
+#endif
+    frameQueries.mStageCount = 0;
+}
+
+///------------------------------------------------------------------------------------------------
+
+void GpuProfiler::UpdateStageTiming(const char* stageName, const float millis)
+{
+    auto stageTimingIter = std::find_if(mStageTimings.begin(), mStageTimings.end(), [&](const GpuStageTiming& stageTiming){ return std::strcmp(stageTiming.mStageName, stageName) == 0; });
+    if (stageTimingIter == mStageTimings.end())
+    {
+        mStageTimings.push_back({ stageName, millis, millis, 0 });
+        return;
+    }
+    
+    stageTimingIter->mLastMillis = millis;
+    stageTimingIter->mAverageMillis += (millis - stageTimingIter->mAverageMillis) * STAGE_TIMING_AVERAGE_WEIGHT;
+    stageTimingIter->mFramesSinceLastResolved = 0;
+}
+
+///------------------------------------------------------------------------------------------------
+
+}
+
+///------------------------------------------------------------------------------------------------
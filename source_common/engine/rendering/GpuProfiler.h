@@ -0,0 +1,95 @@
+///------------------------------------------------------------------------------------------------
+///  GpuProfiler.h
+///  Predators
+///
+///  Created by Alex Koukoulas on 24/04/2024
+///------------------------------------------------------------------------------------------------
+
+#ifndef GpuProfiler_h
+#define GpuProfiler_h
+
+///------------------------------------------------------------------------------------------------
+
+#include <engine/utils/Profiling.h>
+#include <array>
+#include <cstdint>
+#include <vector>
+
+///------------------------------------------------------------------------------------------------
+
+namespace rendering
+{
+
+///------------------------------------------------------------------------------------------------
+
+using GLuint = unsigned int;
+
+///------------------------------------------------------------------------------------------------
+
+struct GpuStageTiming
+{
+    const char* mStageName = nullptr;
+    float mLastMillis = 0.0f;
+    float mAverageMillis = 0.0f;
+    int mFramesSinceLastResolved = 0;
+};
+
+///------------------------------------------------------------------------------------------------
+/// Times render stages on the GPU with GL_TIME_ELAPSED queries. Each frame's queries live in a
+/// ring slot that is only read back once the ring wraps around to it again, so results are
+/// never waited on (results still not available by then are dropped instead).
+/// Timer queries cannot nest, so stages begun while another one is active are ignored.
+/// On targets without timer queries (GLES3) all calls are no-ops.
+class GpuProfiler final
+{
+public:
+    static constexpr int FRAME_QUERY_RING_SIZE = 4;
+    static constexpr int MAX_STAGES_PER_FRAME = 64;
+    
+public:
+    void SetEnabled(const bool enabled);
+    [[nodiscard]] bool IsEnabled() const;
+    
+    // Reads back the results of the ring slot about to be reused and moves on to it.
+    void BeginFrame();
+    
+    // @param[in] stageName must outlive the profiler (string literals, interned StringId strings etc.)
+    void BeginStage(const char* stageName);
+    void EndStage();
+    
+    [[nodiscard]] const std::vector<GpuStageTiming>& GetStageTimings() const;
+    
+private:
+    struct StageQuery
+    {
+        GLuint mQueryId = 0;
+        const char* mStageName = nullptr;
+        std::int64_t mSubmitNanos = 0;
+    };
+    
+    struct FrameQueries
+    {
+        std::array<StageQuery, MAX_STAGES_PER_FRAME> mStageQueries;
+        int mStageCount = 0;
+    };
+    
+    void ResolveFrameQueries(FrameQueries& frameQueries);
+    void UpdateStageTiming(const char* stageName, const float millis);
+    
+private:
+    std::array<FrameQueries, FRAME_QUERY_RING_SIZE> mFrameQueryRing;
+    std::vector<GpuStageTiming> mStageTimings;
+    int mCurrentFrameIndex = 0;
+    int mActiveStageIndex = -1;
+    int mIgnoredNestedStageDepth = 0;
+    profiling::TrackId mProfilingTrackId = -1;
+    bool mEnabled = false;
+};
+
+///------------------------------------------------------------------------------------------------
+
+}
+
+///------------------------------------------------------------------------------------------------
+
+#endif /* GpuProfiler_h */
@@ -10,9 +10,13 @@
 #include <engine/resloading/DataFileResource.h>
 #include <engine/scene/Scene.h>
 #include <engine/scene/SceneObject.h>
+#include <engine/utils/AllocationTracking.h>
 #include <engine/utils/BaseDataFileDeserializer.h>
+#include <engine/utils/JobSystem.h>
 #include <engine/utils/OSMessageBox.h>
+#include <engine/utils/Profiling.h>
 #include <nlohmann/json.hpp>
+#include <algorithm>
 #include <numeric>
 
 ///------------------------------------------------------------------------------------------------
@@ -52,76 +56,46 @@ namespace rendering
 
 void ParticleManager::UpdateSceneParticles(const float dtMillis, scene::Scene& scene)
 {
-    mParticleEmittersToDelete.clear();
-    for (auto& sceneObject: scene.GetSceneObjects())
+    PROFILE_SCOPE("ParticleManager::UpdateSceneParticles");
+    
+    SceneParticleUpdate sceneParticleUpdate;
+    SimulateSceneParticles(dtMillis, scene, sceneParticleUpdate);
+    RemoveFinishedParticleEmitters(scene, sceneParticleUpdate);
+}
+            
+///------------------------------------------------------------------------------------------------
+
+void ParticleManager::UpdateScenesParticles(const float dtMillis, const std::vector<std::shared_ptr<scene::Scene>>& scenes, jobs::JobSystem& jobSystem)
+{
+    PROFILE_SCOPE("ParticleManager::UpdateScenesParticles");
+    
+    std::vector<SceneParticleUpdate> sceneParticleUpdates(scenes.size());
+    jobSystem.ParallelFor(static_cast<int>(scenes.size()), [&](const int sceneIndex)
     {
-        if (std::holds_alternative<scene::ParticleEmitterObjectData>(sceneObject->mSceneObjectTypeData))
+        auto& scene = *scenes[sceneIndex];
+        if (scene.IsLoaded() && !HasCustomUpdateParticleEmitters(scene))
         {
-            auto& particleEmitterData = std::get<scene::ParticleEmitterObjectData>(sceneObject->mSceneObjectTypeData);
-            
-            if (IS_FLAG_SET(particle_flags::CUSTOM_UPDATE))
-            {
-                particleEmitterData.mCustomUpdateFunction(dtMillis, particleEmitterData);
-                continue;
-            }
-            
-            particleEmitterData.mParticleGenerationCurrentDelaySecs -= dtMillis/1000.0f;
-            if (particleEmitterData.mParticleGenerationCurrentDelaySecs <= 0.0f)
-            {
-                particleEmitterData.mParticleGenerationCurrentDelaySecs = 0.0f;
-            }
-            
-            size_t deadParticles = 0;
-            for (size_t i = 0; i < particleEmitterData.mParticleCount; ++i)
-            {
-                // subtract from the particles lifetime
-                particleEmitterData.mParticleLifetimeSecs[i] -= dtMillis/1000.0f;
-                
-                // if the lifetime is below add to the count of finished particles
-                if (particleEmitterData.mParticleLifetimeSecs[i] <= 0.0f )
-                {
-                    if (IS_FLAG_SET(particle_flags::CONTINUOUS_PARTICLE_GENERATION) && particleEmitterData.mParticleGenerationCurrentDelaySecs <= 0.0f)
-                    {
-                        SpawnParticleAtIndex(i, sceneObject->mPosition, particleEmitterData);
-                        particleEmitterData.mParticleGenerationCurrentDelaySecs = particleEmitterData.mParticleGenerationMaxDelaySecs;
-                    }
-                    else
-                    {
-                        particleEmitterData.mParticleLifetimeSecs[i] = 0.0f;
-                        deadParticles++;
-                    }
-                }
-                
-                // move the particle up depending on the delta time
-                if (IS_FLAG_SET(particle_flags::ENLARGE_OVER_TIME))
-                {
-                    particleEmitterData.mParticleSizes[i] += particleEmitterData.mParticleEnlargementSpeed * dtMillis;
-                }
-                
-                // rotate the particle depending on the delta time
-                if (IS_FLAG_SET(particle_flags::ROTATE_OVER_TIME))
-                {
-                    particleEmitterData.mParticleAngles[i] += particleEmitterData.mParticleRotationSpeed * dtMillis;
-                }
-                
-                particleEmitterData.mParticleVelocities[i] += particleEmitterData.mParticleGravityVelocity * dtMillis;
-                particleEmitterData.mParticlePositions[i] += particleEmitterData.mParticleVelocities[i] * dtMillis;
-            }
-            
-            if (deadParticles == particleEmitterData.mParticleCount && !IS_FLAG_SET(particle_flags::CONTINUOUS_PARTICLE_GENERATION))
-            {
-                mParticleEmittersToDelete.push_back(sceneObject);
-            }
-            else
-            {
-                SortParticles(particleEmitterData);
-            }
+            SimulateSceneParticles(dtMillis * scene.GetUpdateTimeSpeedFactor(), scene, sceneParticleUpdates[sceneIndex]);
+            sceneParticleUpdates[sceneIndex].mSimulated = true;
         }
-    }
+    });
     
-    for (const auto& particleEmitter: mParticleEmittersToDelete)
+    for (size_t i = 0; i < scenes.size(); ++i)
     {
-        scene.RemoveSceneObject(particleEmitter->mName);
+        auto& scene = *scenes[i];
+        if (!scene.IsLoaded())
+        {
+            continue;
+        }
+        
+        if (sceneParticleUpdates[i].mSimulated)
+        {
+            RemoveFinishedParticleEmitters(scene, sceneParticleUpdates[i]);
+        }
+        else
+        {
+            UpdateSceneParticles(dtMillis * scene.GetUpdateTimeSpeedFactor(), scene);
+        }
     }
 }
 
@@ -183,7 +157,7 @@ std::shared_ptr<scene::SceneObject> ParticleManager::CreateParticleEmitterAtPosi
         
         if (IS_FLAG_SET(particle_flags::PREFILLED))
         {
-            SpawnParticleAtIndex(i, pos, particleEmitterData);
+            SpawnParticleAtIndex(i, pos, particleEmitterData, scene.GetParticleRandomEngine());
         }
     }
     
@@ -351,6 +325,8 @@ void ParticleManager::ReloadParticlesFromDisk()
 
 void ParticleManager::SortParticles(scene::ParticleEmitterObjectData& particleEmitterData) const
 {
+    memory::AllocationScope allocationScope("SortParticles");
+    
     // Create permutation index vector for final positions
     const auto particleCount = particleEmitterData.mParticleCount;
     
@@ -397,20 +373,114 @@ void ParticleManager::ChangeParticleTexture(const strutils::StringId& particleEm
 
 ///------------------------------------------------------------------------------------------------
 
-void ParticleManager::SpawnParticleAtIndex(const size_t index, const glm::vec3& sceneObjectPosition, scene::ParticleEmitterObjectData& particleEmitterData)
+bool ParticleManager::HasCustomUpdateParticleEmitters(const scene::Scene& scene) const
+{
+    return std::find_if(scene.GetSceneObjects().begin(), scene.GetSceneObjects().end(), [](const std::shared_ptr<scene::SceneObject>& sceneObject)
+    {
+        const auto* particleEmitterData = std::get_if<scene::ParticleEmitterObjectData>(&sceneObject->mSceneObjectTypeData);
+        return particleEmitterData && (particleEmitterData->mParticleFlags & particle_flags::CUSTOM_UPDATE) != 0;
+    }) != scene.GetSceneObjects().end();
+}
+
+///------------------------------------------------------------------------------------------------
+
+void ParticleManager::SimulateSceneParticles(const float dtMillis, scene::Scene& scene, SceneParticleUpdate& sceneParticleUpdate)
+{
+    PROFILE_SCOPE("ParticleManager::SimulateSceneParticles");
+    
+    for (auto& sceneObject: scene.GetSceneObjects())
+    {
+        if (std::holds_alternative<scene::ParticleEmitterObjectData>(sceneObject->mSceneObjectTypeData))
+        {
+            auto& particleEmitterData = std::get<scene::ParticleEmitterObjectData>(sceneObject->mSceneObjectTypeData);
+            
+            if (IS_FLAG_SET(particle_flags::CUSTOM_UPDATE))
+            {
+                particleEmitterData.mCustomUpdateFunction(dtMillis, particleEmitterData);
+                continue;
+            }
+            
+            particleEmitterData.mParticleGenerationCurrentDelaySecs -= dtMillis/1000.0f;
+            if (particleEmitterData.mParticleGenerationCurrentDelaySecs <= 0.0f)
+            {
+                particleEmitterData.mParticleGenerationCurrentDelaySecs = 0.0f;
+            }
+            
+            size_t deadParticles = 0;
+            for (size_t i = 0; i < particleEmitterData.mParticleCount; ++i)
+            {
+                // subtract from the particles lifetime
+                particleEmitterData.mParticleLifetimeSecs[i] -= dtMillis/1000.0f;
+                
+                // if the lifetime is below add to the count of finished particles
+                if (particleEmitterData.mParticleLifetimeSecs[i] <= 0.0f )
+                {
+                    if (IS_FLAG_SET(particle_flags::CONTINUOUS_PARTICLE_GENERATION) && particleEmitterData.mParticleGenerationCurrentDelaySecs <= 0.0f)
+                    {
+                        SpawnParticleAtIndex(i, sceneObject->mPosition, particleEmitterData, scene.GetParticleRandomEngine());
+                        particleEmitterData.mParticleGenerationCurrentDelaySecs = particleEmitterData.mParticleGenerationMaxDelaySecs;
+                    }
+                    else
+                    {
+                        particleEmitterData.mParticleLifetimeSecs[i] = 0.0f;
+                        deadParticles++;
+                    }
+                }
+                
+                // move the particle up depending on the delta time
+                if (IS_FLAG_SET(particle_flags::ENLARGE_OVER_TIME))
+                {
+                    particleEmitterData.mParticleSizes[i] += particleEmitterData.mParticleEnlargementSpeed * dtMillis;
+                }
+                
+                // rotate the particle depending on the delta time
+                if (IS_FLAG_SET(particle_flags::ROTATE_OVER_TIME))
+                {
+                    particleEmitterData.mParticleAngles[i] += particleEmitterData.mParticleRotationSpeed * dtMillis;
+                }
+                
+                particleEmitterData.mParticleVelocities[i] += particleEmitterData.mParticleGravityVelocity * dtMillis;
+                particleEmitterData.mParticlePositions[i] += particleEmitterData.mParticleVelocities[i] * dtMillis;
+            }
+            
+            if (deadParticles == particleEmitterData.mParticleCount && !IS_FLAG_SET(particle_flags::CONTINUOUS_PARTICLE_GENERATION))
+            {
+                sceneParticleUpdate.mParticleEmittersToDelete.push_back(sceneObject);
+            }
+            else
+            {
+                SortParticles(particleEmitterData);
+            }
+        }
+    }
+}
+
+///------------------------------------------------------------------------------------------------
+
+void ParticleManager::RemoveFinishedParticleEmitters(scene::Scene& scene, const SceneParticleUpdate& sceneParticleUpdate)
+{
+    for (const auto& particleEmitter: sceneParticleUpdate.mParticleEmittersToDelete)
+    {
+        scene.RemoveSceneObject(particleEmitter->mName);
+    }
+}
+
+///------------------------------------------------------------------------------------------------
+
+void ParticleManager::SpawnParticleAtIndex(const size_t index, const glm::vec3& sceneObjectPosition, scene::ParticleEmitterObjectData& particleEmitterData, std::mt19937& randomEngine)
 {
-    const auto lifeTime = math::RandomFloat(particleEmitterData.mParticleLifetimeRangeSecs.x, particleEmitterData.mParticleLifetimeRangeSecs.y);
-    const auto xOffset = math::RandomFloat(particleEmitterData.mParticlePositionXOffsetRange.x, particleEmitterData.mParticlePositionXOffsetRange.y);
-    const auto yOffset = math::RandomFloat(particleEmitterData.mParticlePositionYOffsetRange.x, particleEmitterData.mParticlePositionYOffsetRange.y);
-    const auto velXOffset = math::RandomFloat(particleEmitterData.mParticleVelocityXOffsetRange.x, particleEmitterData.mParticleVelocityXOffsetRange.y);
-    const auto velYOffset = math::RandomFloat(particleEmitterData.mParticleVelocityYOffsetRange.x, particleEmitterData.mParticleVelocityYOffsetRange.y);
-    const auto zOffset = math::RandomFloat(sceneObjectPosition.z - sceneObjectPosition.z * 0.0001f, sceneObjectPosition.z + sceneObjectPosition.z * 0.0001f);
-    const auto size = math::RandomFloat(particleEmitterData.mParticleSizeRange.x, particleEmitterData.mParticleSizeRange.y);
+    const auto lifeTime = math::RandomFloat(randomEngine, particleEmitterData.mParticleLifetimeRangeSecs.x, particleEmitterData.mParticleLifetimeRangeSecs.y);
+    const auto xOffset = math::RandomFloat(randomEngine, particleEmitterData.mParticlePositionXOffsetRange.x, particleEmitterData.mParticlePositionXOffsetRange.y);
+    const auto yOffset = math::RandomFloat(randomEngine, particleEmitterData.mParticlePositionYOffsetRange.x, particleEmitterData.mParticlePositionYOffsetRange.y);
+    const auto velXOffset = math::RandomFloat(randomEngine, particleEmitterData.mParticleVelocityXOffsetRange.x, particleEmitterData.mParticleVelocityXOffsetRange.y);
+    const auto velYOffset = math::RandomFloat(randomEngine, particleEmitterData.mParticleVelocityYOffsetRange.x, particleEmitterData.mParticleVelocityYOffsetRange.y);
+    const auto zOffset = math::RandomFloat(randomEngine, sceneObjectPosition.z - sceneObjectPosition.z * 0.0001f, sceneObjectPosition.z + sceneObjectPosition.z * 0.0001f);
+    const auto size = math::RandomFloat(randomEngine, particleEmitterData.mParticleSizeRange.x, particleEmitterData.mParticleSizeRange.y);
     auto angle = 0.0f;
     
     if (IS_FLAG_SET(particle_flags::INITIALLY_ROTATED))
     {
-        angle = math::RandomFloat(particleEmitterData.mParticleInitialAngleRange.x, particleEmitterData.mParticleInitialAngleRange.y);
+        angle = math::RandomFloat(randomEngine, particleEmitterData.mParticleInitialAngleRange.x, particleEmitterData.mParticleInitialAngleRange.y);
     }
     
     particleEmitterData.mParticleLifetimeSecs[index] = lifeTime;
@@ -432,7 +502,8 @@ void ParticleManager::SpawnParticleAtIndex(const size_t index, scene::SceneObjec
 {
     if (std::holds_alternative<scene::ParticleEmitterObjectData>(particleEmitterSceneObject.mSceneObjectTypeData))
     {
-        SpawnParticleAtIndex(index, particleEmitterSceneObject.mPosition, std::get<scene::ParticleEmitterObjectData>(particleEmitterSceneObject.mSceneObjectTypeData));
+        // Only reached from custom updates, which always run on the calling thread
+        SpawnParticleAtIndex(index, particleEmitterSceneObject.mPosition, std::get<scene::ParticleEmitterObjectData>(particleEmitterSceneObject.mSceneObjectTypeData), math::GetRandomEngine());
     }
 }
 
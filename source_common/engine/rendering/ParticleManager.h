@@ -14,6 +14,7 @@
 #include <engine/resloading/ResourceLoadingService.h>
 #include <engine/utils/StringUtils.h>
 #include <memory>
+#include <random>
 #include <unordered_map>
 #include <vector>
 
@@ -22,6 +23,7 @@
 namespace scene { class Scene; }
 namespace scene { struct SceneObject; }
 namespace scene { struct ParticleEmitterObjectData; }
+namespace jobs { class JobSystem; }
 
 ///------------------------------------------------------------------------------------------------
 
@@ -54,6 +56,13 @@ class ParticleManager final
 public:
     void UpdateSceneParticles(const float dtMilis, scene::Scene& scene);
 
+    // Updates the particles of all loaded scenes (scaled by each scene's update time speed factor). Scenes with
+    // only built in emitters are simulated in parallel on the job system. Custom update emitters reach into
+    // other systems, so scenes that have any are updated on the calling thread instead, after the join and in
+    // scene order, exactly like UpdateSceneParticles. Particles are spawned with each scene's own random engine,
+    // so their sequences don't depend on which thread updates the scene.
+    void UpdateScenesParticles(const float dtMilis, const std::vector<std::shared_ptr<scene::Scene>>& scenes, jobs::JobSystem& jobSystem);
+    
     std::shared_ptr<scene::SceneObject> CreateParticleEmitterAtPosition(const strutils::StringId particleEmitterDefinitionName, const glm::vec3& pos, scene::Scene& scene, const strutils::StringId particleEmitterSceneObjectName = strutils::StringId(), std::function<void(float, scene::ParticleEmitterObjectData&)> customUpdateFunction = nullptr);
     int SpawnParticleAtFirstAvailableSlot(scene::SceneObject& particleEmitterSceneObject);
     
@@ -66,11 +75,21 @@ public:
     
 private:
     ParticleManager() = default;
-    void SpawnParticleAtIndex(const size_t index, const glm::vec3& sceneObjectPosition, scene::ParticleEmitterObjectData& particleEmitterObjectData);
+    void SpawnParticleAtIndex(const size_t index, const glm::vec3& sceneObjectPosition, scene::ParticleEmitterObjectData& particleEmitterObjectData, std::mt19937& randomEngine);
     void SpawnParticleAtIndex(const size_t index, scene::SceneObject& particleEmitterSceneObject);
 
+    struct SceneParticleUpdate
+    {
+        std::vector<std::shared_ptr<scene::SceneObject>> mParticleEmittersToDelete;
+        bool mSimulated = false;
+    };
+    
+    // Without custom update emitters only the scene's own emitters are touched, so different scenes can then be simulated concurrently
+    [[nodiscard]] bool HasCustomUpdateParticleEmitters(const scene::Scene& scene) const;
+    void SimulateSceneParticles(const float dtMillis, scene::Scene& scene, SceneParticleUpdate& sceneParticleUpdate);
+    void RemoveFinishedParticleEmitters(scene::Scene& scene, const SceneParticleUpdate& sceneParticleUpdate);
+    
 private:
-    std::vector<std::shared_ptr<scene::SceneObject>> mParticleEmittersToDelete;
     std::unordered_map<strutils::StringId, scene::ParticleEmitterObjectData, strutils::StringIdHasher> mParticleNamesToData;
     resources::ResourceReloadMode mResourceReloadMode;
 };
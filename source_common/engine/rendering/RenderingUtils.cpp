@@ -90,7 +90,7 @@ void CollateSceneObjectsIntoOne(const std::string& dynamicTextureResourceName, c
             
             stbi_write_png(exportFilePath.c_str(), width, height, 4, pixels, width * 4);
             
-            logging::Log(logging::LogType::INFO, "Wrote texture to file %s", exportFilePath.c_str());
+            LOG_CATEGORY(logging::LogCategory::RENDERING, logging::LogType::INFO, "Wrote texture to file %s", exportFilePath.c_str());
             
             free(pixels);
         }
@@ -0,0 +1,65 @@
+///------------------------------------------------------------------------------------------------
+///  ShaderUniformBlocks.cpp
+///  Predators
+///
+///  Created by Alex Koukoulas on 22/04/2024
+///------------------------------------------------------------------------------------------------
+
+#include <engine/rendering/Camera.h>
+#include <engine/rendering/OpenGL.h>
+#include <engine/rendering/ShaderUniformBlocks.h>
+
+///------------------------------------------------------------------------------------------------
+
+namespace rendering
+{
+
+///------------------------------------------------------------------------------------------------
+
+void ShaderUniformBlocks::BindProgramUniformBlocks(const GLuint programId)
+{
+    const auto perSceneBlockIndex = GL_NO_CHECK_CALL(glGetUniformBlockIndex(programId, PER_SCENE_UNIFORM_BLOCK_NAME));
+    if (perSceneBlockIndex != GL_INVALID_INDEX)
+    {
+        GL_CALL(glUniformBlockBinding(programId, perSceneBlockIndex, PER_SCENE_UNIFORM_BLOCK_BINDING));
+    }
+}
+
+///------------------------------------------------------------------------------------------------
+
+void ShaderUniformBlocks::UpdatePerSceneData(const Camera& camera)
+{
+    if (mPerSceneBufferId == 0)
+    {
+        GL_CALL(glGenBuffers(1, &mPerSceneBufferId));
+        GL_CALL(glBindBuffer(GL_UNIFORM_BUFFER, mPerSceneBufferId));
+        GL_CALL(glBufferData(GL_UNIFORM_BUFFER, sizeof(PerSceneUniformBlockData), nullptr, GL_DYNAMIC_DRAW));
+        GL_CALL(glBindBufferBase(GL_UNIFORM_BUFFER, PER_SCENE_UNIFORM_BLOCK_BINDING, mPerSceneBufferId));
+    }
+    // Scenes sharing a camera setup (or deferred scene objects of the same scene) skip the upload
+    else if (mPerSceneData.mView == camera.GetViewMatrix() && mPerSceneData.mProj == camera.GetProjMatrix())
+    {
+        return;
+    }
+    
+    mPerSceneData.mView = camera.GetViewMatrix();
+    mPerSceneData.mProj = camera.GetProjMatrix();
+    
+    GL_CALL(glBindBuffer(GL_UNIFORM_BUFFER, mPerSceneBufferId));
+    GL_CALL(glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(PerSceneUniformBlockData), &mPerSceneData));
+    mUploadCount++;
+}
+
+///------------------------------------------------------------------------------------------------
+
+std::size_t ShaderUniformBlocks::GetUploadCount() const { return mUploadCount; }
+
+///------------------------------------------------------------------------------------------------
+
+void ShaderUniformBlocks::ResetUploadCount() { mUploadCount = 0; }
+
+///------------------------------------------------------------------------------------------------
+
+}
+
+///------------------------------------------------------------------------------------------------
@@ -0,0 +1,73 @@
+///------------------------------------------------------------------------------------------------
+///  ShaderUniformBlocks.h
+///  Predators
+///
+///  Created by Alex Koukoulas on 22/04/2024
+///------------------------------------------------------------------------------------------------
+
+#ifndef ShaderUniformBlocks_h
+#define ShaderUniformBlocks_h
+
+///------------------------------------------------------------------------------------------------
+
+#include <engine/utils/MathUtils.h>
+#include <cstddef>
+
+///------------------------------------------------------------------------------------------------
+
+namespace rendering
+{
+
+///------------------------------------------------------------------------------------------------
+
+using GLuint = unsigned int;
+
+///------------------------------------------------------------------------------------------------
+
+class Camera;
+
+///------------------------------------------------------------------------------------------------
+/// std140 mirror of the PerSceneData block declared in assets/shaders/scene_uniform_blocks.inc
+struct PerSceneUniformBlockData
+{
+    glm::mat4 mView;
+    glm::mat4 mProj;
+};
+
+static_assert(sizeof(PerSceneUniformBlockData) == 2 * 16 * sizeof(float), "PerSceneUniformBlockData does not match its std140 layout");
+
+///------------------------------------------------------------------------------------------------
+
+inline const char* PER_SCENE_UNIFORM_BLOCK_NAME = "PerSceneData";
+inline constexpr GLuint PER_SCENE_UNIFORM_BLOCK_BINDING = 0;
+
+///------------------------------------------------------------------------------------------------
+/// Owns the uniform buffers backing the uniform blocks shared by all shaders. The buffers stay
+/// bound to their fixed binding points, so data uploaded here is visible to every program
+/// without any per draw calls.
+class ShaderUniformBlocks final
+{
+public:
+    // Points the given program's uniform blocks (if it declares any) to their binding points.
+    static void BindProgramUniformBlocks(const GLuint programId);
+    
+public:
+    // Uploads the given camera's matrices, unless they are already the ones uploaded.
+    void UpdatePerSceneData(const Camera& camera);
+    
+    [[nodiscard]] std::size_t GetUploadCount() const;
+    void ResetUploadCount();
+    
+private:
+    GLuint mPerSceneBufferId = 0;
+    PerSceneUniformBlockData mPerSceneData;
+    std::size_t mUploadCount = 0;
+};
+
+///------------------------------------------------------------------------------------------------
+
+}
+
+///------------------------------------------------------------------------------------------------
+
+#endif /* ShaderUniformBlocks_h */
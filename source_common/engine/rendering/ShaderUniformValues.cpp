@@ -0,0 +1,75 @@
+///------------------------------------------------------------------------------------------------
+///  ShaderUniformValues.cpp
+///  Predators
+///
+///  Created by Alex Koukoulas on 21/04/2024
+///------------------------------------------------------------------------------------------------
+
+#include <engine/rendering/ShaderUniformValues.h>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+///------------------------------------------------------------------------------------------------
+
+namespace rendering
+{
+
+///------------------------------------------------------------------------------------------------
+
+class ShaderUniformIndexRegistry final
+{
+public:
+    static ShaderUniformIndexRegistry& GetInstance()
+    {
+        // Intentionally leaked, as uniform indices are also resolved from static initializers
+        static auto* instance = new ShaderUniformIndexRegistry();
+        return *instance;
+    }
+    
+    ShaderUniformIndex GetUniformIndex(const strutils::StringId& uniformName)
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        
+        auto insertionResult = mUniformNamesToIndices.emplace(uniformName, static_cast<ShaderUniformIndex>(mUniformNamesInIndexOrder.size()));
+        if (insertionResult.second)
+        {
+            mUniformNamesInIndexOrder.push_back(uniformName);
+        }
+        return insertionResult.first->second;
+    }
+    
+    strutils::StringId GetUniformName(const ShaderUniformIndex uniformIndex)
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        return mUniformNamesInIndexOrder.at(uniformIndex);
+    }
+    
+private:
+    ShaderUniformIndexRegistry() = default;
+    
+private:
+    std::mutex mMutex;
+    std::unordered_map<strutils::StringId, ShaderUniformIndex, strutils::StringIdHasher> mUniformNamesToIndices;
+    std::vector<strutils::StringId> mUniformNamesInIndexOrder;
+};
+
+///------------------------------------------------------------------------------------------------
+
+ShaderUniformIndex GetShaderUniformIndex(const strutils::StringId& uniformName)
+{
+    return ShaderUniformIndexRegistry::GetInstance().GetUniformIndex(uniformName);
+}
+
+///------------------------------------------------------------------------------------------------
+
+strutils::StringId GetShaderUniformName(const ShaderUniformIndex uniformIndex)
+{
+    return ShaderUniformIndexRegistry::GetInstance().GetUniformName(uniformIndex);
+}
+
+///------------------------------------------------------------------------------------------------
+
+}
+
+///------------------------------------------------------------------------------------------------
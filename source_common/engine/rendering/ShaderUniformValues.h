@@ -0,0 +1,199 @@
+///------------------------------------------------------------------------------------------------
+///  ShaderUniformValues.h
+///  Predators
+///
+///  Created by Alex Koukoulas on 21/04/2024
+///------------------------------------------------------------------------------------------------
+
+#ifndef ShaderUniformValues_h
+#define ShaderUniformValues_h
+
+///------------------------------------------------------------------------------------------------
+
+#include <engine/utils/StringUtils.h>
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+
+///------------------------------------------------------------------------------------------------
+
+namespace rendering
+{
+
+///------------------------------------------------------------------------------------------------
+/// Process-wide dense numbering of uniform names. Shaders key their uniform location tables
+/// by it, so that uploading a uniform is a plain array lookup.
+using ShaderUniformIndex = std::uint32_t;
+
+[[nodiscard]] ShaderUniformIndex GetShaderUniformIndex(const strutils::StringId& uniformName);
+[[nodiscard]] strutils::StringId GetShaderUniformName(const ShaderUniformIndex uniformIndex);
+
+///------------------------------------------------------------------------------------------------
+/// Compact per scene object storage of uniform values of a single type. It mirrors the subset
+/// of the std::unordered_map interface that game code uses (operator[], at, count & iteration),
+/// but keeps its entries inline in insertion order and resolves each uniform name's dense index
+/// once, when the entry is first added. Entries are looked up linearly (scene objects carry a
+/// handful of uniforms each) and are never moved once added, so references to values (e.g. the
+/// ones handed out to tween animations) stay valid for the lifetime of the container.
+template<typename ValueType>
+class ShaderUniformValues final
+{
+public:
+    struct Entry
+    {
+        strutils::StringId mName;
+        ValueType mValue;
+        ShaderUniformIndex mUniformIndex;
+    };
+    
+private:
+    static constexpr std::size_t CHUNK_CAPACITY = 8;
+    
+    struct Chunk
+    {
+        std::array<Entry, CHUNK_CAPACITY> mEntries;
+        std::unique_ptr<Chunk> mNextChunk;
+    };
+    
+    template<typename ChunkType, typename EntryType>
+    class Iterator
+    {
+    public:
+        Iterator(ChunkType* chunk, const std::size_t entryIndex)
+            : mChunk(chunk)
+            , mChunkEntryIndex(0)
+            , mEntryIndex(entryIndex)
+        {
+        }
+        
+        EntryType& operator * () const { return mChunk->mEntries[mChunkEntryIndex]; }
+        EntryType* operator -> () const { return &mChunk->mEntries[mChunkEntryIndex]; }
+        bool operator == (const Iterator& rhs) const { return mEntryIndex == rhs.mEntryIndex; }
+        bool operator != (const Iterator& rhs) const { return mEntryIndex != rhs.mEntryIndex; }
+        
+        Iterator& operator ++ ()
+        {
+            mEntryIndex++;
+            if (++mChunkEntryIndex == CHUNK_CAPACITY)
+            {
+                mChunk = mChunk->mNextChunk.get();
+                mChunkEntryIndex = 0;
+            }
+            return *this;
+        }
+        
+    private:
+        ChunkType* mChunk;
+        std::size_t mChunkEntryIndex;
+        std::size_t mEntryIndex;
+    };
+    
+public:
+    using iterator = Iterator<Chunk, Entry>;
+    using const_iterator = Iterator<const Chunk, const Entry>;
+    
+public:
+    ShaderUniformValues() = default;
+    ShaderUniformValues(const ShaderUniformValues& other) { CopyEntries(other); }
+    ShaderUniformValues& operator = (const ShaderUniformValues& other)
+    {
+        if (this != &other)
+        {
+            mFirstChunk.mNextChunk.reset();
+            mSize = 0;
+            CopyEntries(other);
+        }
+        return *this;
+    }
+    
+    ValueType& operator [] (const strutils::StringId& uniformName)
+    {
+        if (auto* entry = FindEntry(uniformName))
+        {
+            return entry->mValue;
+        }
+        
+        auto& newEntry = AppendEntry();
+        newEntry.mName = uniformName;
+        newEntry.mValue = ValueType();
+        newEntry.mUniformIndex = GetShaderUniformIndex(uniformName);
+        return newEntry.mValue;
+    }
+    
+    ValueType& at(const strutils::StringId& uniformName)
+    {
+        return const_cast<ValueType&>(static_cast<const ShaderUniformValues&>(*this).at(uniformName));
+    }
+    
+    const ValueType& at(const strutils::StringId& uniformName) const
+    {
+        if (const auto* entry = FindEntry(uniformName))
+        {
+            return entry->mValue;
+        }
+        throw std::out_of_range("Uniform " + uniformName.GetString() + " not found");
+    }
+    
+    std::size_t count(const strutils::StringId& uniformName) const { return FindEntry(uniformName) ? 1 : 0; }
+    std::size_t size() const { return mSize; }
+    bool empty() const { return mSize == 0; }
+    
+    iterator begin() { return iterator(&mFirstChunk, 0); }
+    iterator end() { return iterator(nullptr, mSize); }
+    const_iterator begin() const { return const_iterator(&mFirstChunk, 0); }
+    const_iterator end() const { return const_iterator(nullptr, mSize); }
+    
+private:
+    const Entry* FindEntry(const strutils::StringId& uniformName) const
+    {
+        const auto uniformNameId = uniformName.GetStringId();
+        for (const auto& entry: *this)
+        {
+            if (entry.mName.GetStringId() == uniformNameId)
+            {
+                return &entry;
+            }
+        }
+        return nullptr;
+    }
+    
+    Entry* FindEntry(const strutils::StringId& uniformName)
+    {
+        return const_cast<Entry*>(static_cast<const ShaderUniformValues&>(*this).FindEntry(uniformName));
+    }
+    
+    Entry& AppendEntry()
+    {
+        auto* chunk = &mFirstChunk;
+        for (auto chunkIndex = mSize/CHUNK_CAPACITY; chunkIndex > 0; --chunkIndex)
+        {
+            if (!chunk->mNextChunk)
+            {
+                chunk->mNextChunk = std::make_unique<Chunk>();
+            }
+            chunk = chunk->mNextChunk.get();
+        }
+        return chunk->mEntries[mSize++ % CHUNK_CAPACITY];
+    }
+    
+    void CopyEntries(const ShaderUniformValues& other)
+    {
+        for (const auto& otherEntry: other)
+        {
+            AppendEntry() = otherEntry;
+        }
+    }
+    
+private:
+    Chunk mFirstChunk;
+    std::size_t mSize = 0;
+};
+
+///------------------------------------------------------------------------------------------------
+
+}
+
+///------------------------------------------------------------------------------------------------
+
+#endif /* ShaderUniformValues_h */
@@ -0,0 +1,183 @@
+///------------------------------------------------------------------------------------------------
+///  TweenBatch.cpp
+///  Predators
+///
+///  Created by Alex Koukoulas on 19/04/2024
+///------------------------------------------------------------------------------------------------
+
+#include <engine/rendering/TweenBatch.h>
+#include <engine/scene/Scene.h>
+#include <engine/scene/SceneObject.h>
+#include <algorithm>
+#include <cassert>
+
+///------------------------------------------------------------------------------------------------
+
+namespace rendering
+{
+
+///------------------------------------------------------------------------------------------------
+
+void TweenBatch::AddTimeline(const uint32_t timelineIndex, const scene::SceneObject* sceneObject, const float secsDuration, const float secsDelay, const math::TweeningFunctionType tweeningFunctionType, const math::TweeningMode tweeningMode)
+{
+    assert(tweeningFunctionType != math::TweeningFunctionType::CUSTOM);
+    
+    // Lanes of a removed timeline that is being reused would otherwise come back to life
+    if (mDeadTimelineCount > 0)
+    {
+        Compact();
+    }
+    
+    if (timelineIndex >= mTimelineAlive.size())
+    {
+        const auto timelineCount = timelineIndex + 1;
+        mTimelineSceneObjects.resize(timelineCount);
+        mTimelineSecsDurations.resize(timelineCount);
+        mTimelineSecsDelays.resize(timelineCount);
+        mTimelineSecsAccumulators.resize(timelineCount);
+        mTimelineAnimationTs.resize(timelineCount);
+        mTimelineTweenedTs.resize(timelineCount);
+        mTimelineTweeningFunctionTypes.resize(timelineCount);
+        mTimelineTweeningModes.resize(timelineCount);
+        mTimelineAlive.resize(timelineCount);
+        mTimelineFinished.resize(timelineCount);
+    }
+    
+    assert(!mTimelineAlive[timelineIndex]);
+    
+    mTimelineSceneObjects[timelineIndex] = sceneObject;
+    mTimelineSecsDurations[timelineIndex] = secsDuration;
+    mTimelineSecsDelays[timelineIndex] = secsDelay;
+    mTimelineSecsAccumulators[timelineIndex] = 0.0f;
+    mTimelineAnimationTs[timelineIndex] = 0.0f;
+    mTimelineTweenedTs[timelineIndex] = 0.0f;
+    mTimelineTweeningFunctionTypes[timelineIndex] = tweeningFunctionType;
+    mTimelineTweeningModes[timelineIndex] = tweeningMode;
+    mTimelineAlive[timelineIndex] = 1;
+    mTimelineFinished[timelineIndex] = 0;
+    mActiveTimelineIndices.push_back(timelineIndex);
+}
+
+///------------------------------------------------------------------------------------------------
+
+void TweenBatch::AddLane(const uint32_t timelineIndex, float* target, const float initValue, const float finalValue)
+{
+    assert(timelineIndex < mTimelineAlive.size() && mTimelineAlive[timelineIndex]);
+    
+    mLaneTargets.push_back(target);
+    mLaneInitValues.push_back(initValue);
+    mLaneFinalValues.push_back(finalValue);
+    mLaneTimelineIndices.push_back(timelineIndex);
+}
+
+///------------------------------------------------------------------------------------------------
+
+void TweenBatch::RemoveTimeline(const uint32_t timelineIndex)
+{
+    assert(timelineIndex < mTimelineAlive.size() && mTimelineAlive[timelineIndex]);
+    
+    // Only flagged here, as this can be called mid-update from completion callbacks.
+    // The timeline and its lanes are compacted away at the start of the next update.
+    mTimelineAlive[timelineIndex] = 0;
+    mDeadTimelineCount++;
+}
+
+///------------------------------------------------------------------------------------------------
+
+void TweenBatch::Update(const float dtMillis)
+{
+    if (mDeadTimelineCount > 0)
+    {
+        Compact();
+    }
+    
+    // Mirrors BaseAnimation::VUpdate and math::TweenValue exactly, so that batched
+    // tweens produce the same values as their virtual counterparts.
+    for (const auto timelineIndex: mActiveTimelineIndices)
+    {
+        const auto* sceneObject = mTimelineSceneObjects[timelineIndex];
+        const auto updateTimeMillis = dtMillis * (sceneObject && sceneObject->mScene ? sceneObject->mScene->GetUpdateTimeSpeedFactor() : 1.0f);
+        
+        const auto secsDuration = mTimelineSecsDurations[timelineIndex];
+        auto& secsDelay = mTimelineSecsDelays[timelineIndex];
+        auto& secsAccumulator = mTimelineSecsAccumulators[timelineIndex];
+        auto& animationT = mTimelineAnimationTs[timelineIndex];
+        
+        if (secsDelay > 0.0f)
+        {
+            secsDelay -= updateTimeMillis/1000.0f;
+        }
+        else if (secsDuration > 0.0f)
+        {
+            secsAccumulator += updateTimeMillis/1000.0f;
+            if (secsAccumulator > secsDuration)
+            {
+                secsAccumulator = secsDuration;
+                animationT = 1.0f;
+            }
+            else
+            {
+                animationT = secsAccumulator/secsDuration;
+            }
+        }
+        
+        mTimelineTweenedTs[timelineIndex] = math::TweenValue(animationT, mTimelineTweeningFunctionTypes[timelineIndex], mTimelineTweeningModes[timelineIndex]);
+        mTimelineFinished[timelineIndex] = (animationT < 1.0f || secsDuration < 0.0f) ? 0 : 1;
+    }
+    
+    const auto laneCount = mLaneTargets.size();
+    for (size_t i = 0; i < laneCount; ++i)
+    {
+        const auto t = mTimelineTweenedTs[mLaneTimelineIndices[i]];
+        *mLaneTargets[i] = math::Lerp(mLaneInitValues[i], mLaneFinalValues[i], t);
+    }
+}
+
+///------------------------------------------------------------------------------------------------
+
+AnimationUpdateResult TweenBatch::GetUpdateResult(const uint32_t timelineIndex) const
+{
+    assert(timelineIndex < mTimelineAlive.size() && mTimelineAlive[timelineIndex]);
+    return mTimelineFinished[timelineIndex] ? AnimationUpdateResult::FINISHED : AnimationUpdateResult::ONGOING;
+}
+
+///------------------------------------------------------------------------------------------------
+
+int TweenBatch::GetTimelineCount() const
+{
+    return static_cast<int>(mActiveTimelineIndices.size()) - mDeadTimelineCount;
+}
+
+///------------------------------------------------------------------------------------------------
+
+void TweenBatch::Compact()
+{
+    mActiveTimelineIndices.erase(std::remove_if(mActiveTimelineIndices.begin(), mActiveTimelineIndices.end(), [&](const uint32_t timelineIndex){ return !mTimelineAlive[timelineIndex]; }), mActiveTimelineIndices.end());
+    
+    // Stable, so that lanes targeting the same value keep being applied in start order
+    size_t aliveLaneCount = 0;
+    for (size_t i = 0; i < mLaneTargets.size(); ++i)
+    {
+        if (mTimelineAlive[mLaneTimelineIndices[i]])
+        {
+            mLaneTargets[aliveLaneCount] = mLaneTargets[i];
+            mLaneInitValues[aliveLaneCount] = mLaneInitValues[i];
+            mLaneFinalValues[aliveLaneCount] = mLaneFinalValues[i];
+            mLaneTimelineIndices[aliveLaneCount] = mLaneTimelineIndices[i];
+            aliveLaneCount++;
+        }
+    }
+    
+    mLaneTargets.resize(aliveLaneCount);
+    mLaneInitValues.resize(aliveLaneCount);
+    mLaneFinalValues.resize(aliveLaneCount);
+    mLaneTimelineIndices.resize(aliveLaneCount);
+    
+    mDeadTimelineCount = 0;
+}
+
+///------------------------------------------------------------------------------------------------
+
+}
+
+///------------------------------------------------------------------------------------------------
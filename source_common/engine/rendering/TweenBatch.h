@@ -0,0 +1,76 @@
+///------------------------------------------------------------------------------------------------
+///  TweenBatch.h
+///  Predators
+///
+///  Created by Alex Koukoulas on 19/04/2024
+///------------------------------------------------------------------------------------------------
+
+#ifndef TweenBatch_h
+#define TweenBatch_h
+
+///------------------------------------------------------------------------------------------------
+
+#include <engine/rendering/Animations.h>
+#include <engine/utils/MathUtils.h>
+#include <cstdint>
+#include <vector>
+
+///------------------------------------------------------------------------------------------------
+
+namespace scene { struct SceneObject; }
+
+///------------------------------------------------------------------------------------------------
+
+namespace rendering
+{
+
+///------------------------------------------------------------------------------------------------
+/// Structure-of-arrays evaluator for the plain tween animations (position/scale, rotation, alpha
+/// and value tweens). Each batched animation owns a timeline (delay, progress, duration, easing)
+/// and one or more float lanes (target, init value, final value) that are lerped by the eased
+/// progress of their timeline. Timelines are addressed by an externally provided index (the
+/// AnimationManager's slot index), and the animation objects themselves are only used as the
+/// front-end that describes the tween via BaseAnimation::VTryAddToTweenBatch.
+class TweenBatch final
+{
+public:
+    void AddTimeline(const uint32_t timelineIndex, const scene::SceneObject* sceneObject, const float secsDuration, const float secsDelay, const math::TweeningFunctionType tweeningFunctionType, const math::TweeningMode tweeningMode);
+    void AddLane(const uint32_t timelineIndex, float* target, const float initValue, const float finalValue);
+    void RemoveTimeline(const uint32_t timelineIndex);
+    void Update(const float dtMillis);
+    
+    AnimationUpdateResult GetUpdateResult(const uint32_t timelineIndex) const;
+    int GetTimelineCount() const;
+    
+private:
+    void Compact();
+    
+private:
+    // Timelines, indexed by timeline index
+    std::vector<const scene::SceneObject*> mTimelineSceneObjects;
+    std::vector<float> mTimelineSecsDurations;
+    std::vector<float> mTimelineSecsDelays;
+    std::vector<float> mTimelineSecsAccumulators;
+    std::vector<float> mTimelineAnimationTs;
+    std::vector<float> mTimelineTweenedTs;
+    std::vector<math::TweeningFunctionType> mTimelineTweeningFunctionTypes;
+    std::vector<math::TweeningMode> mTimelineTweeningModes;
+    std::vector<uint8_t> mTimelineAlive;
+    std::vector<uint8_t> mTimelineFinished;
+    std::vector<uint32_t> mActiveTimelineIndices;
+    int mDeadTimelineCount = 0;
+    
+    // Lanes, densely packed
+    std::vector<float*> mLaneTargets;
+    std::vector<float> mLaneInitValues;
+    std::vector<float> mLaneFinalValues;
+    std::vector<uint32_t> mLaneTimelineIndices;
+};
+
+///------------------------------------------------------------------------------------------------
+
+}
+
+///------------------------------------------------------------------------------------------------
+
+#endif /* TweenBatch_h */
@@ -7,6 +7,7 @@
 
 #include <engine/resloading/DataFileLoader.h>
 #include <engine/resloading/DataFileResource.h>
+#include <engine/utils/Benchmark.h>
 #include <engine/utils/OSMessageBox.h>
 #include <engine/utils/StringUtils.h>
 #include <fstream>
@@ -50,6 +51,7 @@ std::shared_ptr<IResource> DataFileLoader::VCreateAndLoadResource(const std::str
     str.assign((std::istreambuf_iterator<char>(file)),
                std::istreambuf_iterator<char>());
     
+    benchmark::RecordLoadedBytes(static_cast<std::int64_t>(str.size()));
     return std::shared_ptr<IResource>(new DataFileResource(str));
 }
 
@@ -8,6 +8,7 @@
 #include <algorithm>
 #include <engine/resloading/ImageSurfaceLoader.h>
 #include <engine/resloading/ImageSurfaceResource.h>
+#include <engine/utils/Benchmark.h>
 #include <engine/utils/FileUtils.h>
 #include <engine/utils/Logging.h>
 #include <engine/utils/OSMessageBox.h>
@@ -44,7 +45,7 @@ void ImageSurfaceLoader::VInitialize()
     {
     }
     
-    logging::Log(logging::LogType::INFO, "Successfully initialized SDL_image version %d.%d.%d", imgCompiledVersion.major, imgCompiledVersion.minor, imgCompiledVersion.patch);
+    LOG(logging::LogType::INFO, "Successfully initialized SDL_image version %d.%d.%d", imgCompiledVersion.major, imgCompiledVersion.minor, imgCompiledVersion.patch);
 }
 
 ///------------------------------------------------------------------------------------------------
@@ -66,6 +67,9 @@ std::shared_ptr<IResource> ImageSurfaceLoader::VCreateAndLoadResource(const std:
         return nullptr;
     }
     
+    file.seekg(0, std::ios::end);
+    benchmark::RecordLoadedBytes(static_cast<std::int64_t>(file.tellg()));
+    
     auto* sdlSurface = IMG_Load(resourcePath.c_str());
     
     if (!sdlSurface)
@@ -15,6 +15,7 @@
 #include <engine/rendering/OpenGL.h>
 #include <engine/resloading/OBJMeshLoader.h>
 #include <engine/resloading/MeshResource.h>
+#include <engine/utils/Benchmark.h>
 #include <engine/utils/FileUtils.h>
 #include <engine/utils/MathUtils.h>
 #include <engine/utils/OSMessageBox.h>
@@ -154,6 +155,8 @@ std::shared_ptr<IResource> OBJMeshLoader::VCreateAndLoadResource(const std::stri
         finalIndices.push_back(static_cast<unsigned short>(i));
     }
     
+    // The whole file has been scanned by now, so this is its size
+    benchmark::RecordLoadedBytes(std::ftell(file));
     std::fclose(file);
     
     GLuint vertexArrayObject;
@@ -14,9 +14,12 @@
 #include <engine/resloading/ShaderLoader.h>
 #include <engine/resloading/TextureLoader.h>
 #include <engine/resloading/TextureResource.h>
+#include <engine/utils/Benchmark.h>
 #include <engine/utils/FileUtils.h>
+#include <engine/utils/JobSystem.h>
 #include <engine/utils/Logging.h>
 #include <engine/utils/OSMessageBox.h>
+#include <engine/utils/Profiling.h>
 #include <engine/utils/StringUtils.h>
 #include <engine/utils/ThreadSafeQueue.h>
 #include <engine/utils/TypeTraits.h>
@@ -98,34 +101,35 @@ public:
 class ResourceLoadingService::AsyncLoaderWorker
 {
 public:
-    void StartWorker()
+    explicit AsyncLoaderWorker(jobs::JobSystem& jobSystem)
+        : mJobSystem(jobSystem)
     {
-        mThread = std::thread([&]
+    }
+    
+    // Each loading job runs on its own on the job system's workers, so that several pending images are decoded in parallel
+    void EnqueueJob(const LoadingJob& job)
+    {
+        mJobSystem.Submit([this, job]
         {
-            while(true)
-            {
-                using namespace std::chrono_literals;
-                auto job = mJobs.dequeue();
-                auto resource = job.mLoader->VCreateAndLoadResource(job.mResourcePath);
-                
-                if (ARTIFICIAL_ASYNC_LOADING_DELAY)
-                {
-                    std::this_thread::sleep_for(100ms);
-                }
+            using namespace std::chrono_literals;
+            
+            PROFILE_SCOPE("ResourceLoadingService::LoadingJob");
+            auto resource = job.mLoader->VCreateAndLoadResource(job.mResourcePath);
                 
-                mResults.enqueue({resource, job.mLoader, job.mResourcePath, job.mTargetResourceId});
+            if (ARTIFICIAL_ASYNC_LOADING_DELAY)
+            {
+                std::this_thread::sleep_for(100ms);
             }
+                
+            mResults.enqueue({resource, job.mLoader, job.mResourcePath, job.mTargetResourceId});
         });
-        mThread.detach();
     }
     
 public:
-    ThreadSafeQueue<LoadingJob> mJobs;
     ThreadSafeQueue<JobResult> mResults;
     
 private:
-    std::thread mThread;
-    
+    jobs::JobSystem& mJobSystem;
 };
 
 ///------------------------------------------------------------------------------------------------
@@ -143,7 +147,7 @@ ResourceLoadingService::~ResourceLoadingService()
 
 ///------------------------------------------------------------------------------------------------
 
-void ResourceLoadingService::Initialize()
+void ResourceLoadingService::Initialize(jobs::JobSystem& jobSystem)
 {
     using namespace strutils;
     
@@ -186,14 +190,15 @@ void ResourceLoadingService::Initialize()
     }
     
     mInitialized = true;
-    mAsyncLoaderWorker = std::make_unique<AsyncLoaderWorker>();
-    mAsyncLoaderWorker->StartWorker();
+    mAsyncLoaderWorker = std::make_unique<AsyncLoaderWorker>(jobSystem);
 }
 
 ///------------------------------------------------------------------------------------------------
 
 void ResourceLoadingService::Update()
 {
+    PROFILE_SCOPE("ResourceLoadingService::Update");
+    
     while (mAsyncLoaderWorker->mResults.size())
     {
         auto finishedJob = mAsyncLoaderWorker->mResults.dequeue();
@@ -308,7 +313,7 @@ void ResourceLoadingService::UnloadResource(const std::string& resourcePath)
 
 void ResourceLoadingService::UnloadResource(const ResourceId resourceId)
 {
-    logging::Log(logging::LogType::INFO, "Unloading asset: %s", std::to_string(resourceId).c_str());
+    LOG_CATEGORY(logging::LogCategory::RESOURCES, logging::LogType::INFO, "Unloading asset: %s", std::to_string(resourceId).c_str());
     mResourceMap.erase(resourceId);
 }
 
@@ -386,6 +391,8 @@ void ResourceLoadingService::AddArtificialLoadingJobCount(const int artificialLo
 
 void ResourceLoadingService::LoadResourceInternal(const std::string& resourcePath, const ResourceId resourceId)
 {
+    PROFILE_SCOPE("ResourceLoadingService::LoadResourceInternal");
+    
     // Get resource extension
     const auto resourceFileExtension = fileutils::GetFileExtension(resourcePath);
     
@@ -398,12 +405,14 @@ void ResourceLoadingService::LoadResourceInternal(const std::string& resourcePat
         
         if (mAsyncLoading && selectedLoader->VCanLoadAsync() && !mOutandingAsyncResourceIdsCurrentlyLoading.count(resourceId))
         {
-            mAsyncLoaderWorker->mJobs.enqueue(LoadingJob(selectedLoader, RES_ROOT + resourcePath, resourceId));
+            mAsyncLoaderWorker->EnqueueJob(LoadingJob(selectedLoader, RES_ROOT + resourcePath, resourceId));
             mOutstandingLoadingJobCount++;
             mOutandingAsyncResourceIdsCurrentlyLoading.insert(resourceId);
+            benchmark::RecordResourceLoad(true);
         }
         else if (!mOutandingAsyncResourceIdsCurrentlyLoading.count(resourceId))
         {
+            benchmark::RecordResourceLoad(false);
             auto loadedResource = selectedLoader->VCreateAndLoadResource(RES_ROOT + resourcePath);
             mResourceMap[resourceId] = std::move(loadedResource);
             
@@ -415,7 +424,7 @@ void ResourceLoadingService::LoadResourceInternal(const std::string& resourcePat
                 mResourceMap[resourceId] = std::move(loadedResource);
             }
             
-            logging::Log(logging::LogType::INFO, "Finished loading asset: %s in %s", resourcePath.c_str(), std::to_string(resourceId).c_str());
+            LOG_CATEGORY(logging::LogCategory::RESOURCES, logging::LogType::INFO, "Finished loading asset: %s in %s", resourcePath.c_str(), std::to_string(resourceId).c_str());
             mResourceIdToPaths[resourceId] = resourcePath;
         }
     }
@@ -72,7 +72,8 @@ public:
     
     /// Initializes loaders for different types of assets.
     /// Called internally by the engine.
-    void Initialize();
+    /// @param[in] jobSystem the job system async loading jobs run on.
+    void Initialize(jobs::JobSystem& jobSystem);
     
     /// Polls finished loading jobs in async mode
     void Update();
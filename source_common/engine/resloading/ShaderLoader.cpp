@@ -6,9 +6,11 @@
 ///------------------------------------------------------------------------------------------------
 
 #include <engine/rendering/OpenGL.h>
+#include <engine/rendering/ShaderUniformBlocks.h>
 #include <engine/resloading/ShaderResource.h>
 #include <engine/resloading/ShaderLoader.h>
 #include <engine/resloading/ResourceLoadingService.h>
+#include <engine/utils/Benchmark.h>
 #include <engine/utils/Logging.h>
 #include <engine/utils/OSMessageBox.h>
 #include <engine/utils/StringUtils.h>
@@ -86,7 +88,7 @@ std::shared_ptr<IResource> ShaderLoader::VCreateAndLoadResource(const std::strin
         {
             ospopups::ShowMessageBox(ospopups::MessageBoxType::ERROR, "Error Compiling Vertex Shader: " +  std::string(resourcePath.c_str()), vertexShaderInfoLog.c_str());
         }
-        logging::Log((containsError ? logging::LogType::ERROR : logging::LogType::WARNING), "%s Compiling Vertex Shader: %s\n%s", (containsError ? "Error" : "Warning"), resourcePath.c_str(), vertexShaderInfoLog.c_str());
+        LOG_CATEGORY(logging::LogCategory::RESOURCES, (containsError ? logging::LogType::ERROR : logging::LogType::WARNING), "%s Compiling Vertex Shader: %s\n%s", (containsError ? "Error" : "Warning"), resourcePath.c_str(), vertexShaderInfoLog.c_str());
     }
     
     // Generate fragment shader id
@@ -121,7 +123,7 @@ std::shared_ptr<IResource> ShaderLoader::VCreateAndLoadResource(const std::strin
         {
             ospopups::ShowMessageBox(ospopups::MessageBoxType::ERROR, "Error Compiling Fragment Shader: " +  std::string(resourcePath.c_str()), fragmentShaderInfoLog.c_str());
         }
-        logging::Log((containsError ? logging::LogType::ERROR : logging::LogType::WARNING), "%s Compiling Fragment Shader: %s\n%s", (containsError ? "Error" : "Warning"), resourcePath.c_str(), fragmentShaderInfoLog.c_str());
+        LOG_CATEGORY(logging::LogCategory::RESOURCES, (containsError ? logging::LogType::ERROR : logging::LogType::WARNING), "%s Compiling Fragment Shader: %s\n%s", (containsError ? "Error" : "Warning"), resourcePath.c_str(), fragmentShaderInfoLog.c_str());
     }
     
     // Link shader program
@@ -129,6 +131,10 @@ std::shared_ptr<IResource> ShaderLoader::VCreateAndLoadResource(const std::strin
     GL_CALL(glAttachShader(programId, vertexShaderId));
     GL_CALL(glAttachShader(programId, fragmentShaderId));
     GL_CALL(glLinkProgram(programId));
+    benchmark::RecordShaderCompilation();
+    
+    // Shared uniform blocks are bound once here, so that draws never need to upload their contents
+    rendering::ShaderUniformBlocks::BindProgramUniformBlocks(programId);
     
     // Destroy intermediate compiled shaders
     GL_CALL(glDetachShader(programId, vertexShaderId));
@@ -165,6 +171,7 @@ std::string ShaderLoader::ReadFileContents(const std::string& filePath) const
     contents.assign((std::istreambuf_iterator<char>(file)),
                     std::istreambuf_iterator<char>());
     
+    benchmark::RecordLoadedBytes(static_cast<std::int64_t>(contents.size()));
     return contents;
 }
 
@@ -285,7 +292,7 @@ void ExtractUniformFromLine(const std::string& line, const std::string& shaderNa
             
             if (uniformLocation == -1)
             {
-                logging::Log(logging::LogType::WARNING, "At %s, Unused uniform at location -1: %s", shaderName.c_str(), indexedUniformName.c_str());
+                LOG_CATEGORY(logging::LogCategory::RESOURCES, logging::LogType::WARNING, "At %s, Unused uniform at location -1: %s", shaderName.c_str(), indexedUniformName.c_str());
             }
         }
         
@@ -304,7 +311,7 @@ void ExtractUniformFromLine(const std::string& line, const std::string& shaderNa
         
         if (uniformLocation == -1)
         {
-            logging::Log(logging::LogType::WARNING, "At %s, Unused uniform at location -1: %s", shaderName.c_str(), uniformName.c_str());
+            LOG_CATEGORY(logging::LogCategory::RESOURCES, logging::LogType::WARNING, "At %s, Unused uniform at location -1: %s", shaderName.c_str(), uniformName.c_str());
         }
     }
 }
@@ -313,21 +320,21 @@ void ExtractUniformFromLine(const std::string& line, const std::string& shaderNa
 
 void ShaderLoader::DumpFinalShaderContents(const std::string& vertexShaderContents, const std::string& fragmentShaderContents, const std::string& resourcePath) const
 {
-    logging::Log(logging::LogType::INFO, "Postprocessed contents of %s", (resourcePath + VERTEX_SHADER_FILE_EXTENSION).c_str());
+    LOG_CATEGORY(logging::LogCategory::RESOURCES, logging::LogType::INFO, "Postprocessed contents of %s", (resourcePath + VERTEX_SHADER_FILE_EXTENSION).c_str());
     {
         const auto vertexShaderContentsSplitByNewline = strutils::StringSplit(vertexShaderContents, '\n');
         for (size_t i = 0; i < vertexShaderContentsSplitByNewline.size(); ++i)
         {
-            logging::Log(logging::LogType::INFO, "%d) %s", i + 1, vertexShaderContentsSplitByNewline[i].c_str());
+            LOG_CATEGORY(logging::LogCategory::RESOURCES, logging::LogType::INFO, "%d) %s", i + 1, vertexShaderContentsSplitByNewline[i].c_str());
         }
     }
     
-    logging::Log(logging::LogType::INFO, "Postprocessed contents of %s", (resourcePath + FRAGMENT_SHADER_FILE_EXTENSION).c_str());
+    LOG_CATEGORY(logging::LogCategory::RESOURCES, logging::LogType::INFO, "Postprocessed contents of %s", (resourcePath + FRAGMENT_SHADER_FILE_EXTENSION).c_str());
     {
         const auto fragmentShaderContentsSplitByNewline = strutils::StringSplit(fragmentShaderContents, '\n');
         for (size_t i = 0; i < fragmentShaderContentsSplitByNewline.size(); ++i)
         {
-            logging::Log(logging::LogType::INFO, "%d) %s", i + 1, fragmentShaderContentsSplitByNewline[i].c_str());
+            LOG_CATEGORY(logging::LogCategory::RESOURCES, logging::LogType::INFO, "%d) %s", i + 1, fragmentShaderContentsSplitByNewline[i].c_str());
         }
     }
 }
@@ -16,6 +16,14 @@ namespace resources
 
 ///------------------------------------------------------------------------------------------------
 
+static constexpr int UNRESOLVED_UNIFORM_LOCATION = -2;
+static constexpr int MISSING_UNIFORM_LOCATION = -1;
+
+// Number of glUniform* calls issued by all shaders since the last reset, for the debug overlay
+static std::size_t sUniformUploadCounter = 0;
+
+///------------------------------------------------------------------------------------------------
+
 ShaderResource::ShaderResource
 (
     const std::unordered_map<strutils::StringId, GLuint, strutils::StringIdHasher>& uniformNamesToLocations,
@@ -59,6 +67,7 @@ bool ShaderResource::SetMatrix4fv
     if (mShaderUniformNamesToLocations.count(uniformName) > 0)
     {
         GL_CALL(glUniformMatrix4fv(mShaderUniformNamesToLocations.at(uniformName), count, transpose, (GLfloat*)&matrix));
+        sUniformUploadCounter++;
         return true;
     }    
     return false;
@@ -70,7 +79,7 @@ bool ShaderResource::SetMatrix4Array(const strutils::StringId& uniformName, cons
 {
     if (mUniformArrayElementCounts.count(uniformName) && static_cast<int>(values.size()) > mUniformArrayElementCounts.at(uniformName))
     {
-        logging::Log(logging::LogType::WARNING, "Uniform array size exceeded");
+        LOG(logging::LogType::WARNING, "Uniform array size exceeded");
     }
     
     for (auto i = 0U; i < values.size(); ++i)
@@ -91,7 +100,7 @@ bool ShaderResource::SetFloatVec4Array(const strutils::StringId& uniformName, co
 {
     if (mUniformArrayElementCounts.count(uniformName) && static_cast<int>(values.size()) > mUniformArrayElementCounts.at(uniformName))
     {
-        logging::Log(logging::LogType::WARNING, "Uniform array size exceeded");
+        LOG(logging::LogType::WARNING, "Uniform array size exceeded");
     }
     
     for (auto i = 0U; i < values.size(); ++i)
@@ -112,7 +121,7 @@ bool ShaderResource::SetFloatVec3Array(const strutils::StringId& uniformName, co
 {
     if (mUniformArrayElementCounts.count(uniformName) && static_cast<int>(values.size()) > mUniformArrayElementCounts.at(uniformName))
     {
-        logging::Log(logging::LogType::WARNING, "Uniform array size exceeded");
+        LOG(logging::LogType::WARNING, "Uniform array size exceeded");
     }
     
     for (auto i = 0U; i < values.size(); ++i)
@@ -134,6 +143,7 @@ bool ShaderResource::SetFloatVec4(const strutils::StringId& uniformName, const g
     if (mShaderUniformNamesToLocations.count(uniformName) > 0)
     {
         GL_CALL(glUniform4f(mShaderUniformNamesToLocations.at(uniformName), vec.x, vec.y, vec.z, vec.w));
+        sUniformUploadCounter++;
         return true;
     }
     return false;
@@ -146,6 +156,7 @@ bool ShaderResource::SetFloatVec3(const strutils::StringId& uniformName, const g
     if (mShaderUniformNamesToLocations.count(uniformName) > 0)
     {
         GL_CALL(glUniform3f(mShaderUniformNamesToLocations.at(uniformName), vec.x, vec.y, vec.z));
+        sUniformUploadCounter++;
         return true;
     }
     return false;
@@ -158,6 +169,7 @@ bool ShaderResource::SetFloat(const strutils::StringId& uniformName, const float
     if (mShaderUniformNamesToLocations.count(uniformName) > 0)
     {
         GL_CALL(glUniform1f(mShaderUniformNamesToLocations.at(uniformName), value));
+        sUniformUploadCounter++;
         return true;
     }
     return false;
@@ -169,7 +181,7 @@ bool ShaderResource::SetFloatArray(const strutils::StringId& uniformName, const
 {
     if (mUniformArrayElementCounts.count(uniformName) && static_cast<int>(values.size()) > mUniformArrayElementCounts.at(uniformName))
     {
-        logging::Log(logging::LogType::WARNING, "Uniform array size exceeded");
+        LOG(logging::LogType::WARNING, "Uniform array size exceeded");
     }
     
     for (auto i = 0U; i < values.size(); ++i)
@@ -191,6 +203,7 @@ bool ShaderResource::SetInt(const strutils::StringId& uniformName, const int val
     if (mShaderUniformNamesToLocations.count(uniformName) > 0)
     {
         GL_CALL(glUniform1i(mShaderUniformNamesToLocations.at(uniformName), value));
+        sUniformUploadCounter++;
         return true;
     }
     return false;
@@ -203,6 +216,49 @@ bool ShaderResource::SetBool(const strutils::StringId& uniformName, const bool v
     if (mShaderUniformNamesToLocations.count(uniformName) > 0)
     {
         GL_CALL(glUniform1i(mShaderUniformNamesToLocations.at(uniformName), value ? 1 : 0));
+        sUniformUploadCounter++;
+        return true;
+    }
+    return false;
+}
+
+///------------------------------------------------------------------------------------------------
+
+bool ShaderResource::SetMatrix4fv(const rendering::ShaderUniformIndex uniformIndex, const glm::mat4& matrix) const
+{
+    const auto uniformLocation = GetUniformLocation(uniformIndex);
+    if (uniformLocation != MISSING_UNIFORM_LOCATION)
+    {
+        GL_CALL(glUniformMatrix4fv(uniformLocation, 1, false, (GLfloat*)&matrix));
+        sUniformUploadCounter++;
+        return true;
+    }
+    return false;
+}
+
+///------------------------------------------------------------------------------------------------
+
+bool ShaderResource::SetFloatVec3(const rendering::ShaderUniformIndex uniformIndex, const glm::vec3& vec) const
+{
+    const auto uniformLocation = GetUniformLocation(uniformIndex);
+    if (uniformLocation != MISSING_UNIFORM_LOCATION)
+    {
+        GL_CALL(glUniform3f(uniformLocation, vec.x, vec.y, vec.z));
+        sUniformUploadCounter++;
+        return true;
+    }
+    return false;
+}
+
+///------------------------------------------------------------------------------------------------
+
+bool ShaderResource::SetFloat(const rendering::ShaderUniformIndex uniformIndex, const float value) const
+{
+    const auto uniformLocation = GetUniformLocation(uniformIndex);
+    if (uniformLocation != MISSING_UNIFORM_LOCATION)
+    {
+        GL_CALL(glUniform1f(uniformLocation, value));
+        sUniformUploadCounter++;
         return true;
     }
     return false;
@@ -210,6 +266,89 @@ bool ShaderResource::SetBool(const strutils::StringId& uniformName, const bool v
 
 ///------------------------------------------------------------------------------------------------
 
+bool ShaderResource::SetInt(const rendering::ShaderUniformIndex uniformIndex, const int value) const
+{
+    const auto uniformLocation = GetUniformLocation(uniformIndex);
+    if (uniformLocation != MISSING_UNIFORM_LOCATION)
+    {
+        GL_CALL(glUniform1i(uniformLocation, value));
+        sUniformUploadCounter++;
+        return true;
+    }
+    return false;
+}
+
+///------------------------------------------------------------------------------------------------
+
+bool ShaderResource::SetBool(const rendering::ShaderUniformIndex uniformIndex, const bool value) const
+{
+    const auto uniformLocation = GetUniformLocation(uniformIndex);
+    if (uniformLocation != MISSING_UNIFORM_LOCATION)
+    {
+        GL_CALL(glUniform1i(uniformLocation, value ? 1 : 0));
+        sUniformUploadCounter++;
+        return true;
+    }
+    return false;
+}
+
+///------------------------------------------------------------------------------------------------
+
+void ShaderResource::SetUniformValues(const rendering::ShaderUniformValues<glm::vec3>& uniformValues) const
+{
+    for (const auto& entry: uniformValues) SetFloatVec3(entry.mUniformIndex, entry.mValue);
+}
+
+///------------------------------------------------------------------------------------------------
+
+void ShaderResource::SetUniformValues(const rendering::ShaderUniformValues<float>& uniformValues) const
+{
+    for (const auto& entry: uniformValues) SetFloat(entry.mUniformIndex, entry.mValue);
+}
+
+///------------------------------------------------------------------------------------------------
+
+void ShaderResource::SetUniformValues(const rendering::ShaderUniformValues<int>& uniformValues) const
+{
+    for (const auto& entry: uniformValues) SetInt(entry.mUniformIndex, entry.mValue);
+}
+
+///------------------------------------------------------------------------------------------------
+
+void ShaderResource::SetUniformValues(const rendering::ShaderUniformValues<bool>& uniformValues) const
+{
+    for (const auto& entry: uniformValues) SetBool(entry.mUniformIndex, entry.mValue);
+}
+
+///------------------------------------------------------------------------------------------------
+
+void ShaderResource::SetUniformSamplerTextureUnits() const
+{
+    if (mUniformSamplerIndicesInOrder.size() != mUniformSamplerNamesInOrder.size())
+    {
+        mUniformSamplerIndicesInOrder.clear();
+        for (const auto& uniformSamplerName: mUniformSamplerNamesInOrder)
+        {
+            mUniformSamplerIndicesInOrder.push_back(rendering::GetShaderUniformIndex(uniformSamplerName));
+        }
+    }
+    
+    for (size_t i = 0; i < mUniformSamplerIndicesInOrder.size(); ++i)
+    {
+        SetInt(mUniformSamplerIndicesInOrder[i], static_cast<int>(i));
+    }
+}
+
+///------------------------------------------------------------------------------------------------
+
+std::size_t ShaderResource::GetUniformUploadCount() { return sUniformUploadCounter; }
+
+///------------------------------------------------------------------------------------------------
+
+void ShaderResource::ResetUniformUploadCount() { sUniformUploadCounter = 0; }
+
+///------------------------------------------------------------------------------------------------
+
 GLuint ShaderResource::GetProgramId() const
 {
     return mProgramId;
@@ -236,6 +375,29 @@ void ShaderResource::CopyConstruction(const ShaderResource& rhs)
     mProgramId = rhs.GetProgramId();
     mShaderUniformNamesToLocations = rhs.GetUniformNamesToLocations();
     mUniformSamplerNamesInOrder = rhs.GetUniformSamplerNames();
+    
+    // Locations are per program, so they need resolving again against the new one
+    mUniformLocationsByIndex.clear();
+    mUniformSamplerIndicesInOrder.clear();
+}
+
+///------------------------------------------------------------------------------------------------
+
+int ShaderResource::GetUniformLocation(const rendering::ShaderUniformIndex uniformIndex) const
+{
+    if (uniformIndex >= mUniformLocationsByIndex.size())
+    {
+        mUniformLocationsByIndex.resize(uniformIndex + 1, UNRESOLVED_UNIFORM_LOCATION);
+    }
+    
+    auto& uniformLocation = mUniformLocationsByIndex[uniformIndex];
+    if (uniformLocation == UNRESOLVED_UNIFORM_LOCATION)
+    {
+        auto findIter = mShaderUniformNamesToLocations.find(rendering::GetShaderUniformName(uniformIndex));
+        uniformLocation = findIter != mShaderUniformNamesToLocations.end() ? static_cast<int>(findIter->second) : MISSING_UNIFORM_LOCATION;
+    }
+    
+    return uniformLocation;
 }
 
 ///------------------------------------------------------------------------------------------------
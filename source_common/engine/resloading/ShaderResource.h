@@ -10,6 +10,7 @@
 
 ///------------------------------------------------------------------------------------------------
 
+#include <engine/rendering/ShaderUniformValues.h>
 #include <engine/resloading/IResource.h>
 #include <engine/utils/MathUtils.h>
 #include <engine/utils/StringUtils.h>
@@ -54,6 +55,22 @@ public:
     bool SetInt(const strutils::StringId& uniformName, const int value) const;
     bool SetBool(const strutils::StringId& uniformName, const bool value) const;
 
+    // Dense uniform index variants (\see rendering::GetShaderUniformIndex) of the above,
+    // used on the per draw paths so that no uniform name is ever looked up there.
+    bool SetMatrix4fv(const rendering::ShaderUniformIndex uniformIndex, const glm::mat4& matrix) const;
+    bool SetFloatVec3(const rendering::ShaderUniformIndex uniformIndex, const glm::vec3& vec) const;
+    bool SetFloat(const rendering::ShaderUniformIndex uniformIndex, const float value) const;
+    bool SetInt(const rendering::ShaderUniformIndex uniformIndex, const int value) const;
+    bool SetBool(const rendering::ShaderUniformIndex uniformIndex, const bool value) const;
+    void SetUniformValues(const rendering::ShaderUniformValues<glm::vec3>& uniformValues) const;
+    void SetUniformValues(const rendering::ShaderUniformValues<float>& uniformValues) const;
+    void SetUniformValues(const rendering::ShaderUniformValues<int>& uniformValues) const;
+    void SetUniformValues(const rendering::ShaderUniformValues<bool>& uniformValues) const;
+    void SetUniformSamplerTextureUnits() const;
+
+    static std::size_t GetUniformUploadCount();
+    static void ResetUniformUploadCount();
+
     GLuint GetProgramId() const;    
 
     const std::unordered_map<strutils::StringId, GLuint, strutils::StringIdHasher>& GetUniformNamesToLocations() const;
@@ -61,11 +78,18 @@ public:
     
     void CopyConstruction(const ShaderResource&);
     
+private:
+    int GetUniformLocation(const rendering::ShaderUniformIndex uniformIndex) const;
+    
 private:
     std::unordered_map<strutils::StringId, GLuint, strutils::StringIdHasher> mShaderUniformNamesToLocations;
     std::vector<strutils::StringId> mUniformSamplerNamesInOrder;
     std::unordered_map<strutils::StringId, int, strutils::StringIdHasher> mUniformArrayElementCounts;
     GLuint mProgramId;    
+    
+    // Lazily filled in, as uniform indices are only assigned as uniform names get used
+    mutable std::vector<int> mUniformLocationsByIndex;
+    mutable std::vector<rendering::ShaderUniformIndex> mUniformSamplerIndicesInOrder;
 };
 
 ///------------------------------------------------------------------------------------------------
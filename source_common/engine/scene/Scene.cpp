@@ -8,6 +8,9 @@
 #include <engine/scene/Scene.h>
 #include <engine/resloading/MeshResource.h>
 #include <engine/resloading/ResourceLoadingService.h>
+#include <engine/scene/SceneObjectUtils.h>
+#include <algorithm>
+#include <cassert>
 
 ///------------------------------------------------------------------------------------------------
 
@@ -18,9 +21,13 @@ namespace scene
 
 Scene::Scene(const strutils::StringId& sceneName)
     : mSceneName(sceneName)
+    , mSceneObjectBlockPool(std::make_shared<memory::BlockPool>())
+    , mNextSceneObjectCreationIndex(0)
+    , mParticleRandomEngine(static_cast<std::mt19937::result_type>(math::RandomInt()))
     , mUpdateTimeSpeedFactor(1.0f)
     , mLoaded(false)
     , mHasLoadedPredefinedObjects(false)
+    , mHitTestGridEnabled(false)
 {
 }
 
@@ -28,23 +35,50 @@ Scene::Scene(const strutils::StringId& sceneName)
 
 Scene::~Scene()
 {
+    // Scene objects may outlive the scene, so make sure later renames don't reach back into it
+    for (auto& sceneObject: mSceneObjects)
+    {
+        sceneObject->mName.mIndexingScene = nullptr;
+        sceneObject->mName.mSceneObject = nullptr;
+    }
 }
 
 ///------------------------------------------------------------------------------------------------
 
 std::shared_ptr<SceneObject> Scene::CreateSceneObject(const strutils::StringId sceneObjectName /* = strutils::StringId() */)
 {
-    auto newSceneObject = std::make_shared<SceneObject>();
+    auto newSceneObject = CreateDetachedSceneObject();
     newSceneObject->mScene = this;
-    newSceneObject->mName = sceneObjectName;
+    newSceneObject->mName.mName = sceneObjectName;
+    newSceneObject->mCreationIndex = mNextSceneObjectCreationIndex++;
     mSceneObjects.push_back(newSceneObject);
+    AddToNameIndex(newSceneObject);
     return newSceneObject;
 }
 
 ///------------------------------------------------------------------------------------------------
 
+std::shared_ptr<SceneObject> Scene::CreateDetachedSceneObject()
+{
+    return std::allocate_shared<SceneObject>(memory::BlockPoolAllocator<SceneObject>(mSceneObjectBlockPool));
+}
+
+///------------------------------------------------------------------------------------------------
+
 std::shared_ptr<SceneObject> Scene::FindSceneObject(const strutils::StringId& sceneObjectName)
 {
+    auto indexIter = mSceneObjectNameIndex.find(sceneObjectName);
+    if (indexIter == mSceneObjectNameIndex.end())
+    {
+        return nullptr;
+    }
+    
+    if (indexIter->second.size() == 1)
+    {
+        return indexIter->second.front();
+    }
+    
+    // Several scene objects share this name. Keep returning the first one in scene order.
     auto findIter = std::find_if(mSceneObjects.begin(), mSceneObjects.end(), [&](const std::shared_ptr<SceneObject>& sceneObject)
     {
         return sceneObject->mName == sceneObjectName;
@@ -58,12 +92,10 @@ std::shared_ptr<SceneObject> Scene::FindSceneObject(const strutils::StringId& sc
 std::vector<std::shared_ptr<SceneObject>> Scene::FindSceneObjectsWhoseNameStartsWith(const std::string& sceneObjectNamePrefix)
 {
     std::vector<std::shared_ptr<SceneObject>> result;
-    for (auto& sceneObject: mSceneObjects)
+    for (auto nameIter = mSortedSceneObjectNames.lower_bound(sceneObjectNamePrefix); nameIter != mSortedSceneObjectNames.end() && strutils::StringStartsWith(nameIter->first, sceneObjectNamePrefix); ++nameIter)
     {
-        if (strutils::StringStartsWith(sceneObject->mName.GetString(), sceneObjectNamePrefix))
-        {
-            result.emplace_back(sceneObject);
-        }
+        const auto& sceneObjectsWithName = mSceneObjectNameIndex.at(nameIter->second);
+        result.insert(result.end(), sceneObjectsWithName.begin(), sceneObjectsWithName.end());
     }
     
     return result;
@@ -73,84 +105,13 @@ std::vector<std::shared_ptr<SceneObject>> Scene::FindSceneObjectsWhoseNameStarts
 
 void Scene::RecalculatePositionOfEdgeSnappingSceneObject(std::shared_ptr<SceneObject> sceneObject, const math::Frustum& cameraFrustum)
 {
-    static const float positionIncrements = 0.0001f;
-    
     if (sceneObject->mSnapToEdgeBehavior == SnapToEdgeBehavior::NONE)
     {
         return;
     }
     
-    auto sceneObjectMeshDimensions = CoreSystemsEngine::GetInstance().GetResourceLoadingService().GetResource<resources::MeshResource>(sceneObject->mMeshResourceId).GetDimensions();
-    sceneObjectMeshDimensions.z = 0.0f;
-    
-    int breachedSideIndex = 0;
-    
-    // Pull inside frustum
-    while (!math::IsMeshFullyInsideFrustum(sceneObject->mPosition, sceneObject->mScale, sceneObjectMeshDimensions, cameraFrustum, breachedSideIndex))
-    {
-        // Breach on left side
-        if (breachedSideIndex == 0)
-        {
-            sceneObject->mPosition.x += positionIncrements;
-        }
-        // Breach on right side
-        else if (breachedSideIndex == 1)
-        {
-            sceneObject->mPosition.x -= positionIncrements;
-        }
-        // Breach on bottom side
-        else if (breachedSideIndex == 2)
-        {
-            sceneObject->mPosition.y += positionIncrements;
-        }
-        // Breach on top side
-        else
-        {
-            sceneObject->mPosition.y -= positionIncrements;
-        }
-    }
-    
-    // Push to respective edge
-    switch (sceneObject->mSnapToEdgeBehavior)
-    {
-        case SnapToEdgeBehavior::SNAP_TO_LEFT_EDGE:
-        {
-            while (math::IsMeshFullyInsideFrustum(sceneObject->mPosition, sceneObject->mScale, sceneObjectMeshDimensions, cameraFrustum, breachedSideIndex))
-            {
-                sceneObject->mPosition.x -= positionIncrements;
-            }
-            sceneObject->mPosition.x += sceneObject->mScale.x * sceneObject->mSnapToEdgeScaleOffsetFactor;
-        } break;
-            
-        case SnapToEdgeBehavior::SNAP_TO_RIGHT_EDGE:
-        {
-            while (math::IsMeshFullyInsideFrustum(sceneObject->mPosition, sceneObject->mScale, sceneObjectMeshDimensions, cameraFrustum, breachedSideIndex))
-            {
-                sceneObject->mPosition.x += positionIncrements;
-            }
-            sceneObject->mPosition.x -= sceneObject->mScale.x * sceneObject->mSnapToEdgeScaleOffsetFactor;
-        } break;
-            
-        case SnapToEdgeBehavior::SNAP_TO_TOP_EDGE:
-        {
-            while (math::IsMeshFullyInsideFrustum(sceneObject->mPosition, sceneObject->mScale, sceneObjectMeshDimensions, cameraFrustum, breachedSideIndex))
-            {
-                sceneObject->mPosition.y += positionIncrements;
-            }
-            sceneObject->mPosition.y -= sceneObject->mScale.y * sceneObject->mSnapToEdgeScaleOffsetFactor;
-        } break;
-            
-        case SnapToEdgeBehavior::SNAP_TO_BOT_EDGE:
-        {
-            while (math::IsMeshFullyInsideFrustum(sceneObject->mPosition, sceneObject->mScale, sceneObjectMeshDimensions, cameraFrustum, breachedSideIndex))
-            {
-                sceneObject->mPosition.y -= positionIncrements;
-            }
-            sceneObject->mPosition.y += sceneObject->mScale.y * sceneObject->mSnapToEdgeScaleOffsetFactor;
-        } break;
-            
-        default: break;
-    }
+    const auto& sceneObjectMeshDimensions = CoreSystemsEngine::GetInstance().GetResourceLoadingService().GetResource<resources::MeshResource>(sceneObject->mMeshResourceId).GetDimensions();
+    sceneObject->mPosition = scene_object_utils::CalculateEdgeSnappedPosition(*sceneObject, sceneObjectMeshDimensions, cameraFrustum);
 }
 
 ///------------------------------------------------------------------------------------------------
@@ -169,34 +130,38 @@ void Scene::RecalculatePositionOfEdgeSnappingSceneObjects()
 
 void Scene::RemoveSceneObject(const strutils::StringId& sceneObjectName)
 {
-    if (mSceneObjects.empty())
+    auto sceneObject = FindSceneObject(sceneObjectName);
+    if (!sceneObject)
     {
         return;
     }
     
-    auto findIter = std::find_if(mSceneObjects.begin(), mSceneObjects.end(), [&](const std::shared_ptr<SceneObject>& sceneObject)
-    {
-        return sceneObject->mName == sceneObjectName;
-    });
-    if (findIter != mSceneObjects.end())
-    {
-        mSceneObjects.erase(findIter);
-    }
+    RemoveFromNameIndex(*sceneObject);
+    mHitTestGrid.Remove(*sceneObject);
+    mSceneObjects.erase(std::find(mSceneObjects.begin(), mSceneObjects.end(), sceneObject));
 }
 
 ///------------------------------------------------------------------------------------------------
 
 void Scene::RemoveAllSceneObjectsWithName(const strutils::StringId& sceneObjectName)
 {
-    while (true)
+    auto indexIter = mSceneObjectNameIndex.find(sceneObjectName);
+    if (indexIter == mSceneObjectNameIndex.end())
     {
-        const auto sizeBefore = GetSceneObjectCount();
-        RemoveSceneObject(sceneObjectName);
-        if (GetSceneObjectCount() == sizeBefore)
-        {
-            break;
-        }
+        return;
     }
+    
+    auto sceneObjectsToRemove = indexIter->second;
+    for (auto& sceneObject: sceneObjectsToRemove)
+    {
+        RemoveFromNameIndex(*sceneObject);
+        mHitTestGrid.Remove(*sceneObject);
+    }
+    
+    mSceneObjects.erase(std::remove_if(mSceneObjects.begin(), mSceneObjects.end(), [&](const std::shared_ptr<SceneObject>& sceneObject)
+    {
+        return std::find(sceneObjectsToRemove.begin(), sceneObjectsToRemove.end(), sceneObject) != sceneObjectsToRemove.end();
+    }), mSceneObjects.end());
 }
 
 ///------------------------------------------------------------------------------------------------
@@ -207,6 +172,8 @@ void Scene::RemoveAllSceneObjectsButTheOnesNamed(const std::unordered_set<struti
     {
         if (sceneObjectNames.count((*iter)->mName) == 0)
         {
+            RemoveFromNameIndex(**iter);
+            mHitTestGrid.Remove(**iter);
             iter = mSceneObjects.erase(iter);
         }
         else
@@ -224,6 +191,8 @@ void Scene::RemoveAllParticleEffects()
     {
         if (std::holds_alternative<scene::ParticleEmitterObjectData>((*iter)->mSceneObjectTypeData))
         {
+            RemoveFromNameIndex(**iter);
+            mHitTestGrid.Remove(**iter);
             iter = mSceneObjects.erase(iter);
         }
         else
@@ -235,6 +204,152 @@ void Scene::RemoveAllParticleEffects()
 
 ///------------------------------------------------------------------------------------------------
 
+static bool IsRenderedBefore(const std::shared_ptr<SceneObject>& lhs, const std::shared_ptr<SceneObject>& rhs)
+{
+    return lhs->mPosition.z < rhs->mPosition.z || (lhs->mPosition.z == rhs->mPosition.z && lhs->mCreationIndex < rhs->mCreationIndex);
+}
+
+///------------------------------------------------------------------------------------------------
+
+void Scene::UpdateRenderOrder()
+{
+    // Scene objects are kept sorted by the depth they had when last ordered, so the ones that
+    // still have that depth (newly created ones start with NaN) form an already sorted sequence.
+    const auto isRenderOrderDirty = [](const std::shared_ptr<SceneObject>& sceneObject){ return sceneObject->mPosition.z != sceneObject->mRenderOrderDepth; };
+    
+    auto firstDirtyIter = std::find_if(mSceneObjects.begin(), mSceneObjects.end(), isRenderOrderDirty);
+    if (firstDirtyIter == mSceneObjects.end())
+    {
+        return;
+    }
+    
+    // Compact the clean scene objects in place and pull out the dirty ones
+    auto cleanSceneObjectsEndIter = firstDirtyIter;
+    for (auto iter = firstDirtyIter; iter != mSceneObjects.end(); ++iter)
+    {
+        if (isRenderOrderDirty(*iter))
+        {
+            (*iter)->mRenderOrderDepth = (*iter)->mPosition.z;
+            mRenderOrderDirtySceneObjects.push_back(std::move(*iter));
+        }
+        else
+        {
+            *cleanSceneObjectsEndIter++ = std::move(*iter);
+        }
+    }
+    
+    // Merge the re-sorted dirty scene objects back in, back to front, so that only the
+    // slots from the first dirty scene object's new position onwards are touched.
+    std::sort(mRenderOrderDirtySceneObjects.begin(), mRenderOrderDirtySceneObjects.end(), IsRenderedBefore);
+    
+    auto cleanIndex = static_cast<size_t>(cleanSceneObjectsEndIter - mSceneObjects.begin());
+    auto dirtyIndex = mRenderOrderDirtySceneObjects.size();
+    auto writeIndex = mSceneObjects.size();
+    while (dirtyIndex > 0)
+    {
+        if (cleanIndex > 0 && IsRenderedBefore(mRenderOrderDirtySceneObjects[dirtyIndex - 1], mSceneObjects[cleanIndex - 1]))
+        {
+            mSceneObjects[--writeIndex] = std::move(mSceneObjects[--cleanIndex]);
+        }
+        else
+        {
+            mSceneObjects[--writeIndex] = std::move(mRenderOrderDirtySceneObjects[--dirtyIndex]);
+        }
+    }
+    
+    mRenderOrderDirtySceneObjects.clear();
+}
+
+///------------------------------------------------------------------------------------------------
+
+void Scene::UpdateHitTestGrid()
+{
+    if (mHitTestGridEnabled)
+    {
+        mHitTestGrid.Update(mSceneObjects);
+    }
+}
+
+///------------------------------------------------------------------------------------------------
+
+std::shared_ptr<SceneObject> Scene::FindTopMostSceneObjectAtPoint(const glm::vec2& point, const SceneHitTestGrid::PredicateType& predicate /* = nullptr */)
+{
+    // Scenes that are never hit-tested don't pay for keeping the grid up to date
+    if (!mHitTestGridEnabled)
+    {
+        mHitTestGridEnabled = true;
+        mHitTestGrid.Update(mSceneObjects);
+    }
+    
+    auto* topMostSceneObject = mHitTestGrid.FindTopMostSceneObjectAtPoint(point, predicate);
+    if (!topMostSceneObject)
+    {
+        return nullptr;
+    }
+    
+    const auto& sceneObjectsWithName = mSceneObjectNameIndex.at(topMostSceneObject->mName);
+    return *std::find_if(sceneObjectsWithName.begin(), sceneObjectsWithName.end(), [&](const std::shared_ptr<SceneObject>& sceneObject){ return sceneObject.get() == topMostSceneObject; });
+}
+
+///------------------------------------------------------------------------------------------------
+
+void Scene::CaptureSceneObjectTransforms()
+{
+    for (const auto& sceneObject: mSceneObjects)
+    {
+        sceneObject->mPreviousTransform = { sceneObject->mPosition, sceneObject->mRotation, sceneObject->mScale, true };
+    }
+}
+
+///------------------------------------------------------------------------------------------------
+
+void Scene::ApplyInterpolatedSceneObjectTransforms(const float alpha)
+{
+    assert(mInterpolatedSceneObjectLogicTransforms.empty());
+    
+    // Scene objects removed since the capture are no longer in the scene, and the ones created since have no previous transform
+    for (const auto& sceneObjectPtr: mSceneObjects)
+    {
+        auto& sceneObject = *sceneObjectPtr;
+        const auto& capturedTransform = sceneObject.mPreviousTransform;
+        if (!capturedTransform.mValid || sceneObject.mInvisible || (sceneObject.mPosition == capturedTransform.mPosition && sceneObject.mRotation == capturedTransform.mRotation && sceneObject.mScale == capturedTransform.mScale))
+        {
+            continue;
+        }
+        
+        mInterpolatedSceneObjectLogicTransforms.push_back({ &sceneObject, sceneObject.mPosition, sceneObject.mRotation, sceneObject.mScale });
+        
+        // Depth is left as is, since it is what the (logic time) render order was sorted by
+        sceneObject.mPosition.x = math::Lerp(capturedTransform.mPosition.x, sceneObject.mPosition.x, alpha);
+        sceneObject.mPosition.y = math::Lerp(capturedTransform.mPosition.y, sceneObject.mPosition.y, alpha);
+        sceneObject.mScale = math::Lerp(capturedTransform.mScale, sceneObject.mScale, alpha);
+        
+        // Rotations that wrapped around during the step snap instead of spinning the long way round
+        for (int i = 0; i < 3; ++i)
+        {
+            if (math::Abs(sceneObject.mRotation[i] - capturedTransform.mRotation[i]) < math::PI)
+            {
+                sceneObject.mRotation[i] = math::Lerp(capturedTransform.mRotation[i], sceneObject.mRotation[i], alpha);
+            }
+        }
+    }
+}
+
+///------------------------------------------------------------------------------------------------
+
+void Scene::RestoreSceneObjectTransforms()
+{
+    for (const auto& logicTransform: mInterpolatedSceneObjectLogicTransforms)
+    {
+        logicTransform.mSceneObject->mPosition = logicTransform.mPosition;
+        logicTransform.mSceneObject->mRotation = logicTransform.mRotation;
+        logicTransform.mSceneObject->mScale = logicTransform.mScale;
+    }
+    mInterpolatedSceneObjectLogicTransforms.clear();
+}
+
+///------------------------------------------------------------------------------------------------
+
 std::size_t Scene::GetSceneObjectCount() const { return mSceneObjects.size(); }
 
 ///------------------------------------------------------------------------------------------------
@@ -275,6 +390,14 @@ bool Scene::HasLoadedPredefinedObjects() const { return mHasLoadedPredefinedObje
 
 ///------------------------------------------------------------------------------------------------
 
+const memory::BlockPool& Scene::GetSceneObjectBlockPool() const { return *mSceneObjectBlockPool; }
+
+///------------------------------------------------------------------------------------------------
+
+std::mt19937& Scene::GetParticleRandomEngine() { return mParticleRandomEngine; }
+
+///------------------------------------------------------------------------------------------------
+
 void Scene::SetLoaded(const bool loaded) { mLoaded = loaded; }
 
 ///------------------------------------------------------------------------------------------------
@@ -283,6 +406,72 @@ void Scene::SetHasLoadedPredefinedObjects(const bool hasLoadedPredefinedObjects)
 
 ///------------------------------------------------------------------------------------------------
 
+void Scene::AddToNameIndex(std::shared_ptr<SceneObject> sceneObject)
+{
+    const strutils::StringId& sceneObjectName = sceneObject->mName;
+    
+    sceneObject->mName.mIndexingScene = this;
+    sceneObject->mName.mSceneObject = sceneObject.get();
+    
+    auto& sceneObjectsWithName = mSceneObjectNameIndex[sceneObjectName];
+    if (sceneObjectsWithName.empty())
+    {
+        mSortedSceneObjectNames.emplace(sceneObjectName.GetString(), sceneObjectName);
+    }
+    sceneObjectsWithName.push_back(std::move(sceneObject));
+}
+
+///------------------------------------------------------------------------------------------------
+
+std::shared_ptr<SceneObject> Scene::RemoveFromNameIndex(SceneObject& sceneObject)
+{
+    sceneObject.mName.mIndexingScene = nullptr;
+    sceneObject.mName.mSceneObject = nullptr;
+    
+    auto indexIter = mSceneObjectNameIndex.find(sceneObject.mName);
+    assert(indexIter != mSceneObjectNameIndex.end());
+    
+    auto& sceneObjectsWithName = indexIter->second;
+    auto findIter = std::find_if(sceneObjectsWithName.begin(), sceneObjectsWithName.end(), [&](const std::shared_ptr<SceneObject>& indexedSceneObject){ return indexedSceneObject.get() == &sceneObject; });
+    assert(findIter != sceneObjectsWithName.end());
+    
+    auto removedSceneObject = std::move(*findIter);
+    sceneObjectsWithName.erase(findIter);
+    
+    if (sceneObjectsWithName.empty())
+    {
+        mSortedSceneObjectNames.erase(sceneObject.mName.GetString());
+        mSceneObjectNameIndex.erase(indexIter);
+    }
+    
+    return removedSceneObject;
+}
+
+///------------------------------------------------------------------------------------------------
+
+void Scene::OnSceneObjectRenamed(SceneObject& sceneObject, const strutils::StringId& newSceneObjectName)
+{
+    auto renamedSceneObject = RemoveFromNameIndex(sceneObject);
+    sceneObject.mName.mName = newSceneObjectName;
+    AddToNameIndex(std::move(renamedSceneObject));
+}
+
+///------------------------------------------------------------------------------------------------
+
+void SceneObjectName::Set(const strutils::StringId& name)
+{
+    if (mIndexingScene && !(name == mName))
+    {
+        mIndexingScene->OnSceneObjectRenamed(*mSceneObject, name);
+    }
+    else
+    {
+        mName = name;
+    }
+}
+
+///------------------------------------------------------------------------------------------------
+
 }
 
 ///------------------------------------------------------------------------------------------------
@@ -11,9 +11,14 @@
 ///------------------------------------------------------------------------------------------------
 
 #include <engine/rendering/Camera.h>
+#include <engine/scene/SceneHitTestGrid.h>
 #include <engine/scene/SceneObject.h>
+#include <engine/utils/BlockPool.h>
 #include <engine/utils/StringUtils.h>
+#include <map>
 #include <memory>
+#include <random>
+#include <unordered_map>
 #include <unordered_set>
 #include <vector>
 
@@ -38,12 +43,20 @@ public:
 struct SceneObject;
 class Scene final
 {
+    friend class SceneObjectName;
+    
 public:
     Scene(const strutils::StringId& sceneName);
     ~Scene();
     
     [[nodiscard]] std::shared_ptr<SceneObject> CreateSceneObject(const strutils::StringId sceneObjectName = strutils::StringId());
+    
+    // Allocated from the scene's pool like CreateSceneObject's, but not added to the scene
+    // (e.g. the temporary components of a card that get collated into a single scene object)
+    [[nodiscard]] std::shared_ptr<SceneObject> CreateDetachedSceneObject();
     [[nodiscard]] std::shared_ptr<SceneObject> FindSceneObject(const strutils::StringId& sceneObjectName);
+    
+    // Results are grouped by name in lexicographical order, and by creation order within each name
     [[nodiscard]] std::vector<std::shared_ptr<SceneObject>> FindSceneObjectsWhoseNameStartsWith(const std::string& sceneObjectNamePrefix);
     
     void RecalculatePositionOfEdgeSnappingSceneObject(std::shared_ptr<SceneObject> sceneObject, const math::Frustum& cameraFrustum);
@@ -53,8 +66,32 @@ public:
     void RemoveAllSceneObjectsButTheOnesNamed(const std::unordered_set<strutils::StringId, strutils::StringIdHasher>& sceneObjectNames);
     void RemoveAllParticleEffects();
     
+    // Keeps scene objects ordered by ascending z, with ties broken by creation order. Only scene
+    // objects whose z changed since the last call (or that were created since) get re-sorted.
+    void UpdateRenderOrder();
+    
+    // Refreshes the bounding rects hit-tested by FindTopMostSceneObjectAtPoint. Only does any work
+    // once the scene has been hit-tested, and then only re-buckets scene objects that changed.
+    void UpdateHitTestGrid();
+    
+    // Visible scene object drawn on top of all others at the given world space point, optionally
+    // restricted to the ones satisfying the given predicate. Scene objects are hit-tested with their
+    // bounding rects as of the last UpdateHitTestGrid, i.e. where they were last rendered.
+    [[nodiscard]] std::shared_ptr<SceneObject> FindTopMostSceneObjectAtPoint(const glm::vec2& point, const SceneHitTestGrid::PredicateType& predicate = nullptr);
+    
+    // Fixed timestep render interpolation. Transforms are captured before each logic step. While
+    // rendering, scene objects can then be moved to where they were the given fraction of the way
+    // through the last step, and must be restored to their logic transforms once rendered.
+    // \see scene_object_utils::SnapToLogicTransform for scene objects that shouldn't be interpolated
+    void CaptureSceneObjectTransforms();
+    void ApplyInterpolatedSceneObjectTransforms(const float alpha);
+    void RestoreSceneObjectTransforms();
+    
     [[nodiscard]] std::size_t GetSceneObjectCount() const;
     [[nodiscard]] const std::vector<std::shared_ptr<SceneObject>>& GetSceneObjects() const;
+    
+    // Scene objects must be created, removed and reordered through the scene
+    // so that the name index and render order stay valid.
     [[nodiscard]] std::vector<std::shared_ptr<SceneObject>>& GetSceneObjects();
     [[nodiscard]] rendering::Camera& GetCamera();
     [[nodiscard]] const rendering::Camera& GetCamera() const;
@@ -64,16 +101,46 @@ public:
     [[nodiscard]] bool IsLoaded() const;
     [[nodiscard]] bool HasLoadedPredefinedObjects() const;
     
+    // Scene objects (together with their shared_ptr control blocks) are allocated from this pool,
+    // which is released all at once when both the scene and the last of its scene objects are gone.
+    [[nodiscard]] const memory::BlockPool& GetSceneObjectBlockPool() const;
+    
+    // Seeded from the creating thread's random engine. Particles of the scene are spawned from it, so that
+    // their sequences don't depend on which job system worker ends up updating the scene.
+    [[nodiscard]] std::mt19937& GetParticleRandomEngine();
+    
     void SetLoaded(const bool loaded);
     void SetHasLoadedPredefinedObjects(const bool hasLoadedPredefinedObjects);
     
+private:
+    struct SceneObjectTransform
+    {
+        SceneObject* mSceneObject;
+        glm::vec3 mPosition;
+        glm::vec3 mRotation;
+        glm::vec3 mScale;
+    };
+    
+    void AddToNameIndex(std::shared_ptr<SceneObject> sceneObject);
+    std::shared_ptr<SceneObject> RemoveFromNameIndex(SceneObject& sceneObject);
+    void OnSceneObjectRenamed(SceneObject& sceneObject, const strutils::StringId& newSceneObjectName);
+    
 private:
     const strutils::StringId mSceneName;
+    const std::shared_ptr<memory::BlockPool> mSceneObjectBlockPool;
     std::vector<std::shared_ptr<SceneObject>> mSceneObjects;
+    std::unordered_map<strutils::StringId, std::vector<std::shared_ptr<SceneObject>>, strutils::StringIdHasher> mSceneObjectNameIndex;
+    std::map<std::string, strutils::StringId> mSortedSceneObjectNames;
+    std::vector<std::shared_ptr<SceneObject>> mRenderOrderDirtySceneObjects;
+    std::vector<SceneObjectTransform> mInterpolatedSceneObjectLogicTransforms;
+    SceneHitTestGrid mHitTestGrid;
+    std::uint64_t mNextSceneObjectCreationIndex;
     rendering::Camera mCamera;
+    std::mt19937 mParticleRandomEngine;
     float mUpdateTimeSpeedFactor;
     bool mLoaded;
     bool mHasLoadedPredefinedObjects;
+    bool mHitTestGridEnabled;
 };
 
 ///------------------------------------------------------------------------------------------------
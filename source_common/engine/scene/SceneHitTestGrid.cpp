@@ -0,0 +1,249 @@
+///------------------------------------------------------------------------------------------------
+///  SceneHitTestGrid.cpp
+///  Predators
+///
+///  Created by Alex Koukoulas on 20/04/2024
+///------------------------------------------------------------------------------------------------
+
+#include <engine/scene/SceneHitTestGrid.h>
+#include <engine/scene/SceneObject.h>
+#include <engine/scene/SceneObjectUtils.h>
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+///------------------------------------------------------------------------------------------------
+
+namespace scene
+{
+
+///------------------------------------------------------------------------------------------------
+
+// A visible screen is roughly 0.5 x 0.5 world units, so cards and buttons span a handful of cells
+static constexpr float CELL_SIZE = 0.05f;
+
+// Keeps far away (or infinitely large) rects from overflowing the integer cell coordinates
+static constexpr float MAX_CELL_COORDINATE = 1 << 20;
+
+// Full screen backgrounds, overlays etc. would otherwise be bucketed into hundreds of cells
+static constexpr std::int64_t MAX_CELLS_PER_SCENE_OBJECT = 64;
+
+///------------------------------------------------------------------------------------------------
+
+static int ToCellCoordinate(const float worldCoordinate)
+{
+    return static_cast<int>(math::Max(-MAX_CELL_COORDINATE, math::Min(MAX_CELL_COORDINATE, std::floor(worldCoordinate/CELL_SIZE))));
+}
+
+///------------------------------------------------------------------------------------------------
+
+static std::uint64_t ToCellKey(const int cellX, const int cellY)
+{
+    return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(cellX)) << 32) | static_cast<std::uint32_t>(cellY);
+}
+
+///------------------------------------------------------------------------------------------------
+
+// Same order the renderer draws scene objects in. Scene objects not ordered yet (NaN depth)
+// fall back to their creation order.
+static bool IsRenderedBefore(const SceneObject& lhs, const SceneObject& rhs)
+{
+    if (lhs.mRenderOrderDepth < rhs.mRenderOrderDepth) return true;
+    if (rhs.mRenderOrderDepth < lhs.mRenderOrderDepth) return false;
+    return lhs.mCreationIndex < rhs.mCreationIndex;
+}
+
+///------------------------------------------------------------------------------------------------
+
+void SceneHitTestGrid::Update(const std::vector<std::shared_ptr<SceneObject>>& sceneObjects)
+{
+    for (const auto& sceneObject: sceneObjects)
+    {
+        auto& hitTestCache = sceneObject->mHitTestCache;
+        
+        if (std::holds_alternative<ParticleEmitterObjectData>(sceneObject->mSceneObjectTypeData))
+        {
+            if (hitTestCache.mIndexed)
+            {
+                Erase(*sceneObject);
+            }
+            continue;
+        }
+        
+        const auto* textData = std::get_if<TextSceneObjectData>(&sceneObject->mSceneObjectTypeData);
+        const auto position = glm::vec2(sceneObject->mPosition.x, sceneObject->mPosition.y);
+        
+        // Depth only affects the render order, which is read live at query time
+        if (hitTestCache.mIndexed &&
+            hitTestCache.mPosition == position &&
+            hitTestCache.mScale == sceneObject->mScale &&
+            hitTestCache.mBoundingRectMultiplier == sceneObject->mBoundingRectMultiplier &&
+            (!textData || (hitTestCache.mText == textData->mText && hitTestCache.mFontName == textData->mFontName)))
+        {
+            continue;
+        }
+        
+        if (hitTestCache.mIndexed)
+        {
+            Erase(*sceneObject);
+        }
+        
+        hitTestCache.mPosition = position;
+        hitTestCache.mScale = sceneObject->mScale;
+        hitTestCache.mBoundingRectMultiplier = sceneObject->mBoundingRectMultiplier;
+        hitTestCache.mText = textData ? textData->mText : std::string();
+        hitTestCache.mFontName = textData ? textData->mFontName : strutils::StringId();
+        hitTestCache.mBoundingRect = scene_object_utils::GetSceneObjectBoundingRect(*sceneObject);
+        Insert(*sceneObject);
+    }
+}
+
+///------------------------------------------------------------------------------------------------
+
+void SceneHitTestGrid::Remove(SceneObject& sceneObject)
+{
+    if (sceneObject.mHitTestCache.mIndexed)
+    {
+        Erase(sceneObject);
+    }
+}
+
+///------------------------------------------------------------------------------------------------
+
+SceneObject* SceneHitTestGrid::FindTopMostSceneObjectAtPoint(const glm::vec2& point, const PredicateType& predicate /* = nullptr */) const
+{
+    if (std::isnan(point.x) || std::isnan(point.y))
+    {
+        return nullptr;
+    }
+    
+    SceneObject* topMostSceneObject = nullptr;
+    const auto testSceneObject = [&](SceneObject* sceneObject)
+    {
+        const auto& boundingRect = sceneObject->mHitTestCache.mBoundingRect;
+        if (sceneObject->mInvisible || !math::IsPointInsideRectangle(boundingRect.bottomLeft, boundingRect.topRight, point))
+        {
+            return;
+        }
+        
+        // Predicates are only consulted for scene objects that would otherwise become the top-most one
+        if (topMostSceneObject && IsRenderedBefore(*sceneObject, *topMostSceneObject))
+        {
+            return;
+        }
+        
+        if (predicate && !predicate(*sceneObject))
+        {
+            return;
+        }
+        
+        topMostSceneObject = sceneObject;
+    };
+    
+    auto cellIter = mCells.find(ToCellKey(ToCellCoordinate(point.x), ToCellCoordinate(point.y)));
+    if (cellIter != mCells.end())
+    {
+        for (auto* sceneObject: cellIter->second)
+        {
+            testSceneObject(sceneObject);
+        }
+    }
+    
+    for (auto* sceneObject: mOversizedSceneObjects)
+    {
+        testSceneObject(sceneObject);
+    }
+    
+    return topMostSceneObject;
+}
+
+///------------------------------------------------------------------------------------------------
+
+std::size_t SceneHitTestGrid::GetIndexedSceneObjectCount() const { return mIndexedSceneObjectCount; }
+
+///------------------------------------------------------------------------------------------------
+
+void SceneHitTestGrid::Insert(SceneObject& sceneObject)
+{
+    auto& hitTestCache = sceneObject.mHitTestCache;
+    assert(!hitTestCache.mIndexed);
+    
+    hitTestCache.mIndexed = true;
+    hitTestCache.mOversized = false;
+    mIndexedSceneObjectCount++;
+    
+    // Empty (or NaN) rects can't contain any point, so they are tracked but not bucketed
+    const auto& boundingRect = hitTestCache.mBoundingRect;
+    if (!(boundingRect.bottomLeft.x < boundingRect.topRight.x && boundingRect.bottomLeft.y < boundingRect.topRight.y))
+    {
+        hitTestCache.mMinCell = glm::ivec2(0);
+        hitTestCache.mMaxCell = glm::ivec2(-1);
+        return;
+    }
+    
+    hitTestCache.mMinCell = glm::ivec2(ToCellCoordinate(boundingRect.bottomLeft.x), ToCellCoordinate(boundingRect.bottomLeft.y));
+    hitTestCache.mMaxCell = glm::ivec2(ToCellCoordinate(boundingRect.topRight.x), ToCellCoordinate(boundingRect.topRight.y));
+    
+    const auto cellCount = static_cast<std::int64_t>(hitTestCache.mMaxCell.x - hitTestCache.mMinCell.x + 1) * static_cast<std::int64_t>(hitTestCache.mMaxCell.y - hitTestCache.mMinCell.y + 1);
+    if (cellCount > MAX_CELLS_PER_SCENE_OBJECT)
+    {
+        hitTestCache.mOversized = true;
+        mOversizedSceneObjects.push_back(&sceneObject);
+        return;
+    }
+    
+    for (auto cellY = hitTestCache.mMinCell.y; cellY <= hitTestCache.mMaxCell.y; ++cellY)
+    {
+        for (auto cellX = hitTestCache.mMinCell.x; cellX <= hitTestCache.mMaxCell.x; ++cellX)
+        {
+            mCells[ToCellKey(cellX, cellY)].push_back(&sceneObject);
+        }
+    }
+}
+
+///------------------------------------------------------------------------------------------------
+
+void SceneHitTestGrid::Erase(SceneObject& sceneObject)
+{
+    auto& hitTestCache = sceneObject.mHitTestCache;
+    assert(hitTestCache.mIndexed);
+    
+    hitTestCache.mIndexed = false;
+    mIndexedSceneObjectCount--;
+    
+    // Order within a cell is irrelevant, as queries compare render order directly
+    const auto swapAndPop = [&](std::vector<SceneObject*>& sceneObjects)
+    {
+        auto findIter = std::find(sceneObjects.begin(), sceneObjects.end(), &sceneObject);
+        assert(findIter != sceneObjects.end());
+        *findIter = sceneObjects.back();
+        sceneObjects.pop_back();
+    };
+    
+    if (hitTestCache.mOversized)
+    {
+        swapAndPop(mOversizedSceneObjects);
+        return;
+    }
+    
+    for (auto cellY = hitTestCache.mMinCell.y; cellY <= hitTestCache.mMaxCell.y; ++cellY)
+    {
+        for (auto cellX = hitTestCache.mMinCell.x; cellX <= hitTestCache.mMaxCell.x; ++cellX)
+        {
+            auto cellIter = mCells.find(ToCellKey(cellX, cellY));
+            assert(cellIter != mCells.end());
+            
+            swapAndPop(cellIter->second);
+            if (cellIter->second.empty())
+            {
+                mCells.erase(cellIter);
+            }
+        }
+    }
+}
+
+///------------------------------------------------------------------------------------------------
+
+}
+
+///------------------------------------------------------------------------------------------------
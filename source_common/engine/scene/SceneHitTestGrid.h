@@ -0,0 +1,66 @@
+///------------------------------------------------------------------------------------------------
+///  SceneHitTestGrid.h
+///  Predators
+///
+///  Created by Alex Koukoulas on 20/04/2024
+///------------------------------------------------------------------------------------------------
+
+#ifndef SceneHitTestGrid_h
+#define SceneHitTestGrid_h
+
+///------------------------------------------------------------------------------------------------
+
+#include <engine/utils/MathUtils.h>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+///------------------------------------------------------------------------------------------------
+
+namespace scene
+{
+
+///------------------------------------------------------------------------------------------------
+
+struct SceneObject;
+
+///------------------------------------------------------------------------------------------------
+/// Uniform grid of the world space bounding rects of a scene's objects, used to find what lies
+/// under a point without testing every scene object. Each scene object's rect (and the range of
+/// cells it's bucketed in) is cached on it, and is only recomputed when its position, scale,
+/// bounding rect multiplier or text change. Scene objects spanning too many cells are kept in a
+/// separate list that is tested on every query instead. Particle emitters are never indexed.
+class SceneHitTestGrid final
+{
+public:
+    using PredicateType = std::function<bool(const SceneObject&)>;
+    
+public:
+    // Re-buckets the given scene objects whose bounding rects changed since they were last indexed
+    void Update(const std::vector<std::shared_ptr<SceneObject>>& sceneObjects);
+    void Remove(SceneObject& sceneObject);
+    
+    // Visible scene object rendered last (\see Scene::UpdateRenderOrder) whose indexed bounding rect
+    // contains the given point, optionally restricted to the ones satisfying the given predicate.
+    [[nodiscard]] SceneObject* FindTopMostSceneObjectAtPoint(const glm::vec2& point, const PredicateType& predicate = nullptr) const;
+    [[nodiscard]] std::size_t GetIndexedSceneObjectCount() const;
+    
+private:
+    void Insert(SceneObject& sceneObject);
+    void Erase(SceneObject& sceneObject);
+    
+private:
+    std::unordered_map<std::uint64_t, std::vector<SceneObject*>> mCells;
+    std::vector<SceneObject*> mOversizedSceneObjects;
+    std::size_t mIndexedSceneObjectCount = 0;
+};
+
+///------------------------------------------------------------------------------------------------
+
+}
+
+///------------------------------------------------------------------------------------------------
+
+#endif /* SceneHitTestGrid_h */
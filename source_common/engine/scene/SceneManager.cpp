@@ -10,6 +10,7 @@
 #include <engine/scene/Scene.h>
 #include <engine/scene/SceneManager.h>
 #include <engine/utils/BaseDataFileDeserializer.h>
+#include <engine/utils/Profiling.h>
 #include <fstream>
 #include <nlohmann/json.hpp>
 #include <engine/utils/PlatformMacros.h>
@@ -224,11 +225,10 @@ void SceneManager::LoadPredefinedObjectsFromDescriptorForScene(std::shared_ptr<S
 
 void SceneManager::SortSceneObjects(std::shared_ptr<Scene> scene)
 {
-    auto& sceneObjects = scene->GetSceneObjects();
-    std::sort(sceneObjects.begin(), sceneObjects.end(), [&](const std::shared_ptr<scene::SceneObject>& lhs, const std::shared_ptr<scene::SceneObject>& rhs)
-    {
-        return lhs->mPosition.z < rhs->mPosition.z;
-    });
+    PROFILE_SCOPE("SceneManager::SortSceneObjects");
+    
+    scene->UpdateRenderOrder();
+    scene->UpdateHitTestGrid();
 }
 
 ///------------------------------------------------------------------------------------------------
@@ -246,6 +246,8 @@ void SceneManager::RemoveScene(const strutils::StringId& sceneName)
             sceneObject->mScene = nullptr;
         }
         CollectTextureResourceIdCandidates(*findIter);
+        
+        // Also releases the scene's object pool in one go, once its last scene object is gone
         mScenes.erase(findIter);
         UnloadUnusedTextures();
     }
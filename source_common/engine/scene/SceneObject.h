@@ -12,10 +12,12 @@
 
 #include <engine/resloading/ResourceLoadingService.h>
 #include <engine/rendering/ParticleManager.h>
+#include <engine/rendering/ShaderUniformValues.h>
 #include <engine/utils/MathUtils.h>
 #include <engine/utils/StringUtils.h>
 #include <functional>
 #include <game/GameConstants.h>
+#include <limits>
 #include <unordered_map>
 #include <variant>
 
@@ -103,6 +105,94 @@ inline constexpr int EFFECT_TEXTURES_COUNT = 3;
 ///------------------------------------------------------------------------------------------------
 
 class Scene;
+struct SceneObject;
+
+///------------------------------------------------------------------------------------------------
+/// Thin wrapper around a scene object's name. It reads like a plain StringId, but lets the
+/// owning scene keep its name index in sync when the name is reassigned after creation.
+class SceneObjectName final
+{
+    friend class Scene;
+    
+public:
+    SceneObjectName() = default;
+    explicit SceneObjectName(const strutils::StringId& name) : mName(name) {}
+    
+    // Copies only carry the name. Index bookkeeping stays with the original object.
+    SceneObjectName(const SceneObjectName& other) : mName(other.mName) {}
+    SceneObjectName& operator = (const SceneObjectName& other) { Set(other.mName); return *this; }
+    SceneObjectName& operator = (const strutils::StringId& name) { Set(name); return *this; }
+    
+    operator const strutils::StringId& () const { return mName; }
+    
+    const std::string& GetString() const { return mName.GetString(); }
+    uint32_t GetStringId() const { return mName.GetStringId(); }
+    bool isEmpty() const { return mName.isEmpty(); }
+    
+private:
+    void Set(const strutils::StringId& name);
+    
+private:
+    strutils::StringId mName;
+    Scene* mIndexingScene = nullptr;
+    SceneObject* mSceneObject = nullptr;
+};
+
+///------------------------------------------------------------------------------------------------
+
+inline bool operator == (const SceneObjectName& lhs, const SceneObjectName& rhs) { return lhs.GetStringId() == rhs.GetStringId(); }
+inline bool operator == (const SceneObjectName& lhs, const strutils::StringId& rhs) { return lhs.GetStringId() == rhs.GetStringId(); }
+inline bool operator == (const strutils::StringId& lhs, const SceneObjectName& rhs) { return lhs.GetStringId() == rhs.GetStringId(); }
+inline bool operator != (const SceneObjectName& lhs, const SceneObjectName& rhs) { return !(lhs == rhs); }
+inline bool operator != (const SceneObjectName& lhs, const strutils::StringId& rhs) { return !(lhs == rhs); }
+inline bool operator != (const strutils::StringId& lhs, const SceneObjectName& rhs) { return !(lhs == rhs); }
+
+///------------------------------------------------------------------------------------------------
+/// Radius of a scene object's bounding sphere (centered at its position), cached together with
+/// the state it was computed from so that it's only recomputed when that state changes.
+/// \see scene_object_utils::IsSceneObjectOutsideOfFrustum
+struct SceneObjectBoundsCache
+{
+    glm::vec3 mScale = glm::vec3(0.0f);
+    resources::ResourceId mMeshResourceId = 0;
+    std::string mText;
+    strutils::StringId mFontName;
+    float mBoundingSphereRadius = 0.0f;
+    bool mValid = false;
+};
+
+///------------------------------------------------------------------------------------------------
+/// World space bounding rect of a scene object as last indexed by its scene's hit-test grid,
+/// together with the state it was computed from and the range of grid cells it was bucketed in.
+/// \see scene::SceneHitTestGrid
+struct SceneObjectHitTestCache
+{
+    glm::vec2 mPosition = glm::vec2(0.0f);
+    glm::vec3 mScale = glm::vec3(0.0f);
+    glm::vec3 mBoundingRectMultiplier = glm::vec3(0.0f);
+    std::string mText;
+    strutils::StringId mFontName;
+    math::Rectangle mBoundingRect = {};
+    glm::ivec2 mMinCell = glm::ivec2(0);
+    glm::ivec2 mMaxCell = glm::ivec2(-1);
+    bool mOversized = false;
+    bool mIndexed = false;
+};
+
+///------------------------------------------------------------------------------------------------
+/// Logic transform of a scene object as of the start of the last fixed timestep logic step, which
+/// renders interpolate from. Invalid for scene objects created or snapped since, which then render
+/// at their logic transform. \see scene::Scene::ApplyInterpolatedSceneObjectTransforms
+struct SceneObjectPreviousTransform
+{
+    glm::vec3 mPosition = glm::vec3(0.0f);
+    glm::vec3 mRotation = glm::vec3(0.0f);
+    glm::vec3 mScale = glm::vec3(0.0f);
+    bool mValid = false;
+};
+
+///------------------------------------------------------------------------------------------------
+
 struct SceneObject
 {
     ~SceneObject()
@@ -114,12 +204,12 @@ struct SceneObject
     }
     
     const Scene* mScene = nullptr;
-    strutils::StringId mName = strutils::StringId();
+    SceneObjectName mName;
     std::variant<DefaultSceneObjectData, TextSceneObjectData, ParticleEmitterObjectData> mSceneObjectTypeData;
-    std::unordered_map<strutils::StringId, glm::vec3, strutils::StringIdHasher> mShaderVec3UniformValues;
-    std::unordered_map<strutils::StringId, float, strutils::StringIdHasher> mShaderFloatUniformValues;
-    std::unordered_map<strutils::StringId, int, strutils::StringIdHasher> mShaderIntUniformValues;
-    std::unordered_map<strutils::StringId, bool, strutils::StringIdHasher> mShaderBoolUniformValues;
+    rendering::ShaderUniformValues<glm::vec3> mShaderVec3UniformValues;
+    rendering::ShaderUniformValues<float> mShaderFloatUniformValues;
+    rendering::ShaderUniformValues<int> mShaderIntUniformValues;
+    rendering::ShaderUniformValues<bool> mShaderBoolUniformValues;
     glm::vec3 mPosition = glm::vec3(0.0f, 0.0f, 0.0f);
     glm::vec3 mRotation = glm::vec3(0.0f, 0.0f, 0.0f);
     glm::vec3 mScale = glm::vec3(1.0f, 1.0f, 1.0f);
@@ -132,6 +222,14 @@ struct SceneObject
     float mSnapToEdgeScaleOffsetFactor = 0.0f;
     bool mInvisible = false;
     bool mDeferredRendering = false;
+    
+    // Render order bookkeeping, maintained by the owning scene (\see Scene::UpdateRenderOrder)
+    std::uint64_t mCreationIndex = 0;
+    float mRenderOrderDepth = std::numeric_limits<float>::quiet_NaN();
+    
+    SceneObjectBoundsCache mBoundsCache;
+    SceneObjectHitTestCache mHitTestCache;
+    SceneObjectPreviousTransform mPreviousTransform;
 };
 
 ///------------------------------------------------------------------------------------------------
@@ -7,9 +7,11 @@
 
 #include <engine/CoreSystemsEngine.h>
 #include <engine/rendering/Fonts.h>
+#include <engine/resloading/MeshResource.h>
 #include <engine/resloading/ResourceLoadingService.h>
 #include <engine/scene/SceneObjectUtils.h>
 #include <engine/scene/SceneObject.h>
+#include <limits>
 
 ///------------------------------------------------------------------------------------------------
 
@@ -18,6 +20,24 @@ namespace scene_object_utils
 
 ///------------------------------------------------------------------------------------------------
 
+// Directions that move a mesh back inside each of the left, right, bottom & top frustum sides
+static const glm::vec3 FRUSTUM_SIDE_INWARD_DIRECTIONS[4] =
+{
+    glm::vec3(1.0f, 0.0f, 0.0f),
+    glm::vec3(-1.0f, 0.0f, 0.0f),
+    glm::vec3(0.0f, 1.0f, 0.0f),
+    glm::vec3(0.0f, -1.0f, 0.0f)
+};
+
+///------------------------------------------------------------------------------------------------
+
+static float CalculateFrustumSideBreachDistance(const glm::vec4& frustumSide, const glm::vec3& meshPosition, const float meshBoundingRadius)
+{
+    return frustumSide.x * meshPosition.x + frustumSide.y * meshPosition.y + frustumSide.z * meshPosition.z + frustumSide.w + meshBoundingRadius;
+}
+
+///------------------------------------------------------------------------------------------------
+
 math::Rectangle GetSceneObjectBoundingRect(const scene::SceneObject& sceneObject)
 {
     math::Rectangle boundingRect;
@@ -77,4 +97,126 @@ math::Rectangle GetSceneObjectBoundingRect(const scene::SceneObject& sceneObject
 
 ///------------------------------------------------------------------------------------------------
 
+static float CalculateBoundingSphereRadius(const scene::SceneObject& sceneObject)
+{
+    if (std::holds_alternative<scene::TextSceneObjectData>(sceneObject.mSceneObjectTypeData))
+    {
+        // Text with no font can't be bounded
+        const auto& textData = std::get<scene::TextSceneObjectData>(sceneObject.mSceneObjectTypeData);
+        if (!CoreSystemsEngine::GetInstance().GetFontRepository().GetFont(textData.mFontName))
+        {
+            return std::numeric_limits<float>::max();
+        }
+        
+        // Farthest corner of the text rect from the text's origin
+        const auto boundingRect = GetSceneObjectBoundingRect(sceneObject);
+        const auto position = glm::vec2(sceneObject.mPosition.x, sceneObject.mPosition.y);
+        const auto farthestCorner = glm::max(glm::abs(boundingRect.bottomLeft - position), glm::abs(boundingRect.topRight - position));
+        return glm::length(farthestCorner);
+    }
+    
+    // The full (rather than half) diagonal of the scaled mesh, so that the
+    // sphere holds no matter where the mesh's origin lies within its extents
+    const auto& meshDimensions = CoreSystemsEngine::GetInstance().GetResourceLoadingService().GetResource<resources::MeshResource>(sceneObject.mMeshResourceId).GetDimensions();
+    return glm::length(meshDimensions * glm::abs(sceneObject.mScale));
+}
+
+///------------------------------------------------------------------------------------------------
+
+bool IsSceneObjectOutsideOfFrustum(scene::SceneObject& sceneObject, const math::Frustum& frustum)
+{
+    if (std::holds_alternative<scene::ParticleEmitterObjectData>(sceneObject.mSceneObjectTypeData))
+    {
+        return false;
+    }
+    
+    auto& boundsCache = sceneObject.mBoundsCache;
+    const auto* textData = std::get_if<scene::TextSceneObjectData>(&sceneObject.mSceneObjectTypeData);
+    
+    // The radius doesn't depend on the position, so moving scene objects keep their cached bounds
+    if (!boundsCache.mValid ||
+        boundsCache.mScale != sceneObject.mScale ||
+        boundsCache.mMeshResourceId != sceneObject.mMeshResourceId ||
+        (textData && (boundsCache.mText != textData->mText || boundsCache.mFontName != textData->mFontName)))
+    {
+        boundsCache.mScale = sceneObject.mScale;
+        boundsCache.mMeshResourceId = sceneObject.mMeshResourceId;
+        boundsCache.mText = textData ? textData->mText : std::string();
+        boundsCache.mFontName = textData ? textData->mFontName : strutils::StringId();
+        boundsCache.mBoundingSphereRadius = CalculateBoundingSphereRadius(sceneObject);
+        boundsCache.mValid = true;
+    }
+    
+    for (const auto& frustumSide: frustum)
+    {
+        if (frustumSide.x * sceneObject.mPosition.x + frustumSide.y * sceneObject.mPosition.y + frustumSide.z * sceneObject.mPosition.z + frustumSide.w > boundsCache.mBoundingSphereRadius)
+        {
+            return true;
+        }
+    }
+    
+    return false;
+}
+
+///------------------------------------------------------------------------------------------------
+
+glm::vec3 CalculateEdgeSnappedPosition(const scene::SceneObject& sceneObject, const glm::vec3& meshDimensions, const math::Frustum& frustum)
+{
+    auto snappedPosition = sceneObject.mPosition;
+    
+    glm::vec3 snapDirection;
+    float snapScaleOffset = 0.0f;
+    switch (sceneObject.mSnapToEdgeBehavior)
+    {
+        case scene::SnapToEdgeBehavior::SNAP_TO_LEFT_EDGE: snapDirection = -FRUSTUM_SIDE_INWARD_DIRECTIONS[0]; snapScaleOffset = sceneObject.mScale.x; break;
+        case scene::SnapToEdgeBehavior::SNAP_TO_RIGHT_EDGE: snapDirection = -FRUSTUM_SIDE_INWARD_DIRECTIONS[1]; snapScaleOffset = sceneObject.mScale.x; break;
+        case scene::SnapToEdgeBehavior::SNAP_TO_BOT_EDGE: snapDirection = -FRUSTUM_SIDE_INWARD_DIRECTIONS[2]; snapScaleOffset = sceneObject.mScale.y; break;
+        case scene::SnapToEdgeBehavior::SNAP_TO_TOP_EDGE: snapDirection = -FRUSTUM_SIDE_INWARD_DIRECTIONS[3]; snapScaleOffset = sceneObject.mScale.y; break;
+        default: return snappedPosition;
+    }
+
+    // Same bounding extent as the one used by math::IsMeshFullyInsideFrustum
+    const auto scaledMeshDimensions = glm::vec3(meshDimensions.x, meshDimensions.y, 0.0f) * sceneObject.mScale;
+    const auto meshBoundingRadius = math::Max(scaledMeshDimensions.x, math::Max(scaledMeshDimensions.y, scaledMeshDimensions.z)) * 0.5f;
+    
+    // Pull inside frustum
+    for (auto i = 0; i < 4; ++i)
+    {
+        const auto breachDistance = CalculateFrustumSideBreachDistance(frustum[i], snappedPosition, meshBoundingRadius);
+        const auto breachDistanceRate = glm::dot(glm::vec3(frustum[i]), FRUSTUM_SIDE_INWARD_DIRECTIONS[i]);
+        if (breachDistance > 0.0f && breachDistanceRate < 0.0f)
+        {
+            snappedPosition += FRUSTUM_SIDE_INWARD_DIRECTIONS[i] * (breachDistance/-breachDistanceRate);
+        }
+    }
+    
+    // Push to respective edge, i.e. travel along the snap direction until the first frustum side is reached
+    auto snapDistance = std::numeric_limits<float>::max();
+    for (auto i = 0U; i < math::FRUSTUM_SIDES; ++i)
+    {
+        const auto breachDistanceRate = glm::dot(glm::vec3(frustum[i]), snapDirection);
+        if (breachDistanceRate > 0.0f)
+        {
+            snapDistance = math::Min(snapDistance, math::Max(0.0f, -CalculateFrustumSideBreachDistance(frustum[i], snappedPosition, meshBoundingRadius)/breachDistanceRate));
+        }
+    }
+    
+    if (snapDistance != std::numeric_limits<float>::max())
+    {
+        snappedPosition += snapDirection * snapDistance;
+    }
+    
+    snappedPosition -= snapDirection * snapScaleOffset * sceneObject.mSnapToEdgeScaleOffsetFactor;
+    return snappedPosition;
+}
+
+///------------------------------------------------------------------------------------------------
+
+void SnapToLogicTransform(scene::SceneObject& sceneObject)
+{
+    sceneObject.mPreviousTransform.mValid = false;
+}
+
+///------------------------------------------------------------------------------------------------
+
 }
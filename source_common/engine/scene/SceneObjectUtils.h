@@ -26,6 +26,34 @@ namespace scene_object_utils
 
 math::Rectangle GetSceneObjectBoundingRect(const scene::SceneObject& sceneObject);
 
+///------------------------------------------------------------------------------------------------
+/// Conservatively checks whether the given scene object can't possibly be seen through the given
+/// frustum. Uses a world space bounding sphere around the scene object's position that holds for
+/// any rotation and pivot placement within its mesh (or text rect). The sphere is cached on the
+/// scene object and only recomputed when its scale, mesh or text change.
+/// Particle emitters are never considered outside.
+/// @param[in] sceneObject the scene object to test (its bounds cache might get refreshed).
+/// @param[in] frustum the frustum to test against.
+/// @returns whether the scene object is fully outside of the frustum.
+bool IsSceneObjectOutsideOfFrustum(scene::SceneObject& sceneObject, const math::Frustum& frustum);
+
+///------------------------------------------------------------------------------------------------
+/// Computes in closed form where the given scene object needs to be placed to honour its
+/// snap to edge behavior, i.e. pulled inside the frustum and then pushed flush against the
+/// respective frustum side (offset by its mSnapToEdgeScaleOffsetFactor).
+/// @param[in] sceneObject the scene object to snap.
+/// @param[in] meshDimensions the dimensions of the scene object's mesh.
+/// @param[in] frustum the frustum to snap against.
+/// @returns the snapped position (or the current one if the scene object doesn't snap to an edge).
+glm::vec3 CalculateEdgeSnappedPosition(const scene::SceneObject& sceneObject, const glm::vec3& meshDimensions, const math::Frustum& frustum);
+
+///------------------------------------------------------------------------------------------------
+/// Stops renders from interpolating the given scene object's transform until the next fixed
+/// timestep logic step, so that a scene object moved discontinuously (e.g. teleported) doesn't
+/// visibly slide across the jump.
+/// @param[in] sceneObject the scene object to snap to its logic transform.
+void SnapToLogicTransform(scene::SceneObject& sceneObject);
+
 ///------------------------------------------------------------------------------------------------
 
 }
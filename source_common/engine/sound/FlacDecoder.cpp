@@ -0,0 +1,566 @@
+///------------------------------------------------------------------------------------------------
+///  FlacDecoder.cpp
+///  Predators
+///
+///  Created by Alex Koukoulas on 01/05/2024
+///------------------------------------------------------------------------------------------------
+
+#include <algorithm>
+#include <engine/sound/FlacDecoder.h>
+#include <engine/utils/Logging.h>
+
+///------------------------------------------------------------------------------------------------
+
+namespace sound
+{
+
+///------------------------------------------------------------------------------------------------
+
+static constexpr std::size_t READ_BUFFER_SIZE = 64 * 1024;
+static constexpr int STREAMINFO_BLOCK_TYPE = 0;
+static constexpr int STREAMINFO_BLOCK_SIZE = 34;
+static constexpr int MAX_SUPPORTED_BITS_PER_SAMPLE = 24;
+static constexpr int MAX_LPC_ORDER = 32;
+
+///------------------------------------------------------------------------------------------------
+
+enum ChannelAssignment
+{
+    LEFT_SIDE = 8,
+    SIDE_RIGHT = 9,
+    MID_SIDE = 10
+};
+
+///------------------------------------------------------------------------------------------------
+
+bool FlacDecoder::Open(const std::string& filePath)
+{
+    mFile.close();
+    mFile.clear();
+    mFile.open(filePath, std::ios::in | std::ios::binary);
+    if (!mFile.good())
+    {
+        LOG_CATEGORY(logging::LogCategory::AUDIO, logging::LogType::ERROR, "Could not open flac file %s", filePath.c_str());
+        return false;
+    }
+    
+    char marker[4] = {};
+    mFile.read(marker, 4);
+    if (!mFile.good() || marker[0] != 'f' || marker[1] != 'L' || marker[2] != 'a' || marker[3] != 'C')
+    {
+        LOG_CATEGORY(logging::LogCategory::AUDIO, logging::LogType::ERROR, "%s is not a flac file", filePath.c_str());
+        mFile.close();
+        return false;
+    }
+    
+    // Metadata blocks are parsed straight off the file, as only the STREAMINFO block is of interest
+    auto foundStreamInfo = false;
+    auto lastMetadataBlock = false;
+    while (!lastMetadataBlock)
+    {
+        std::uint8_t blockHeader[4] = {};
+        mFile.read(reinterpret_cast<char*>(blockHeader), 4);
+        if (!mFile.good())
+        {
+            LOG_CATEGORY(logging::LogCategory::AUDIO, logging::LogType::ERROR, "Truncated metadata in flac file %s", filePath.c_str());
+            mFile.close();
+            return false;
+        }
+        
+        lastMetadataBlock = (blockHeader[0] & 0x80) != 0;
+        const auto blockType = blockHeader[0] & 0x7F;
+        const auto blockSize = (blockHeader[1] << 16) | (blockHeader[2] << 8) | blockHeader[3];
+        
+        if (blockType == STREAMINFO_BLOCK_TYPE && blockSize == STREAMINFO_BLOCK_SIZE)
+        {
+            std::uint8_t streamInfo[STREAMINFO_BLOCK_SIZE] = {};
+            mFile.read(reinterpret_cast<char*>(streamInfo), STREAMINFO_BLOCK_SIZE);
+            
+            mMaxBlockSize = (streamInfo[2] << 8) | streamInfo[3];
+            mSampleRate = (streamInfo[10] << 12) | (streamInfo[11] << 4) | (streamInfo[12] >> 4);
+            mChannelCount = ((streamInfo[12] >> 1) & 0x07) + 1;
+            mBitsPerSample = (((streamInfo[12] & 0x01) << 4) | (streamInfo[13] >> 4)) + 1;
+            mTotalFrameCount = (static_cast<std::int64_t>(streamInfo[13] & 0x0F) << 32) | (static_cast<std::int64_t>(streamInfo[14]) << 24) | (streamInfo[15] << 16) | (streamInfo[16] << 8) | streamInfo[17];
+            std::copy(streamInfo + 18, streamInfo + STREAMINFO_BLOCK_SIZE, mMd5Signature.begin());
+            foundStreamInfo = true;
+        }
+        else
+        {
+            mFile.seekg(blockSize, std::ios::cur);
+        }
+    }
+    
+    if (!foundStreamInfo || mSampleRate == 0 || mMaxBlockSize == 0 || mBitsPerSample > MAX_SUPPORTED_BITS_PER_SAMPLE)
+    {
+        LOG_CATEGORY(logging::LogCategory::AUDIO, logging::LogType::ERROR, "Unsupported stream info in flac file %s", filePath.c_str());
+        mFile.close();
+        return false;
+    }
+    
+    mFirstFrameOffset = mFile.tellg();
+    mReadBuffer.resize(READ_BUFFER_SIZE);
+    mDecodedSamples.assign(static_cast<std::size_t>(mMaxBlockSize * mChannelCount), 0);
+    Rewind();
+    return true;
+}
+
+///------------------------------------------------------------------------------------------------
+
+int FlacDecoder::Read(float* outSamples, const int frameCount)
+{
+    auto framesRead = 0;
+    while (framesRead < frameCount)
+    {
+        if (mDecodedFrameCursor == mDecodedFrameCount && !DecodeFrame())
+        {
+            break;
+        }
+        
+        const auto framesToCopy = std::min(frameCount - framesRead, mDecodedFrameCount - mDecodedFrameCursor);
+        const auto sampleScale = 1.0f/static_cast<float>(1 << (mDecodedBitsPerSample - 1));
+        for (int i = 0; i < framesToCopy; ++i)
+        {
+            for (int channelIndex = 0; channelIndex < mChannelCount; ++channelIndex)
+            {
+                *outSamples++ = static_cast<float>(mDecodedSamples[channelIndex * mMaxBlockSize + mDecodedFrameCursor + i]) * sampleScale;
+            }
+        }
+        
+        mDecodedFrameCursor += framesToCopy;
+        framesRead += framesToCopy;
+    }
+    
+    return framesRead;
+}
+
+///------------------------------------------------------------------------------------------------
+
+void FlacDecoder::Rewind()
+{
+    mFile.clear();
+    mFile.seekg(mFirstFrameOffset);
+    
+    mReadBufferPosition = 0;
+    mReadBufferSize = 0;
+    mBitCache = 0;
+    mBitCacheCount = 0;
+    mEndOfStream = false;
+    mDecodedFrameCount = 0;
+    mDecodedFrameCursor = 0;
+}
+
+///------------------------------------------------------------------------------------------------
+
+bool FlacDecoder::IsOpen() const
+{
+    return mFile.is_open();
+}
+
+///------------------------------------------------------------------------------------------------
+
+int FlacDecoder::GetSampleRate() const
+{
+    return mSampleRate;
+}
+
+///------------------------------------------------------------------------------------------------
+
+int FlacDecoder::GetChannelCount() const
+{
+    return mChannelCount;
+}
+
+///------------------------------------------------------------------------------------------------
+
+int FlacDecoder::GetBitsPerSample() const
+{
+    return mBitsPerSample;
+}
+
+///------------------------------------------------------------------------------------------------
+
+std::int64_t FlacDecoder::GetTotalFrameCount() const
+{
+    return mTotalFrameCount;
+}
+
+///------------------------------------------------------------------------------------------------
+
+const std::array<std::uint8_t, 16>& FlacDecoder::GetMd5Signature() const
+{
+    return mMd5Signature;
+}
+
+///------------------------------------------------------------------------------------------------
+
+bool FlacDecoder::DecodeFrame()
+{
+    static const int SAMPLE_SIZES[8] = { 0, 8, 12, 0, 16, 20, 24, 0 };
+    
+    mDecodedFrameCount = 0;
+    mDecodedFrameCursor = 0;
+    
+    // Frames start byte aligned, with the 14 bit sync code 0b11111111111110
+    AlignToByte();
+    auto previousByte = ReadBits(8);
+    while (!mEndOfStream)
+    {
+        const auto currentByte = ReadBits(8);
+        if (previousByte == 0xFF && (currentByte & 0xFE) == 0xF8)
+        {
+            break;
+        }
+        previousByte = currentByte;
+    }
+    
+    const auto blockSizeCode = static_cast<int>(ReadBits(4));
+    const auto sampleRateCode = static_cast<int>(ReadBits(4));
+    const auto channelAssignment = static_cast<int>(ReadBits(4));
+    const auto sampleSizeCode = static_cast<int>(ReadBits(3));
+    ReadBits(1);
+    
+    // Utf8 like coded frame or sample number, which sequential decoding has no need for
+    const auto codedNumberFirstByte = ReadBits(8);
+    for (auto mask = 0x80u; mask > 0x01u && (codedNumberFirstByte & mask) && (codedNumberFirstByte & (mask >> 1)); mask >>= 1)
+    {
+        ReadBits(8);
+    }
+    
+    auto blockSize = 0;
+    if (blockSizeCode == 1) blockSize = 192;
+    else if (blockSizeCode >= 2 && blockSizeCode <= 5) blockSize = 576 << (blockSizeCode - 2);
+    else if (blockSizeCode == 6) blockSize = static_cast<int>(ReadBits(8)) + 1;
+    else if (blockSizeCode == 7) blockSize = static_cast<int>(ReadBits(16)) + 1;
+    else if (blockSizeCode >= 8) blockSize = 256 << (blockSizeCode - 8);
+    
+    if (sampleRateCode == 12) ReadBits(8);
+    else if (sampleRateCode == 13 || sampleRateCode == 14) ReadBits(16);
+    
+    // Header CRC-8
+    ReadBits(8);
+    
+    const auto channelCount = channelAssignment < LEFT_SIDE ? channelAssignment + 1 : 2;
+    const auto bitsPerSample = sampleSizeCode == 0 ? mBitsPerSample : SAMPLE_SIZES[sampleSizeCode];
+    
+    if (mEndOfStream)
+    {
+        return false;
+    }
+    
+    if (blockSize == 0 || channelAssignment > MID_SIDE || channelCount != mChannelCount || bitsPerSample == 0 || bitsPerSample > MAX_SUPPORTED_BITS_PER_SAMPLE)
+    {
+        LOG_CATEGORY(logging::LogCategory::AUDIO, logging::LogType::ERROR, "Invalid or unsupported flac frame header");
+        mEndOfStream = true;
+        return false;
+    }
+    
+    // Only ever grows past STREAMINFO's max block size for streams lying about it
+    if (blockSize > mMaxBlockSize)
+    {
+        mMaxBlockSize = blockSize;
+        mDecodedSamples.assign(static_cast<std::size_t>(mMaxBlockSize * mChannelCount), 0);
+    }
+    
+    for (int channelIndex = 0; channelIndex < channelCount; ++channelIndex)
+    {
+        // Side channels carry an extra bit
+        const auto isSideChannel = (channelAssignment == LEFT_SIDE && channelIndex == 1) || (channelAssignment == SIDE_RIGHT && channelIndex == 0) || (channelAssignment == MID_SIDE && channelIndex == 1);
+        if (!DecodeSubframe(channelIndex, blockSize, bitsPerSample + (isSideChannel ? 1 : 0)))
+        {
+            LOG_CATEGORY(logging::LogCategory::AUDIO, logging::LogType::ERROR, "Invalid or unsupported flac subframe");
+            mEndOfStream = true;
+            return false;
+        }
+    }
+    
+    // Frame CRC-16
+    AlignToByte();
+    ReadBits(16);
+    
+    auto* left = &mDecodedSamples[0];
+    auto* right = channelCount > 1 ? &mDecodedSamples[static_cast<std::size_t>(mMaxBlockSize)] : nullptr;
+    for (int i = 0; i < blockSize && channelAssignment >= LEFT_SIDE; ++i)
+    {
+        if (channelAssignment == LEFT_SIDE)
+        {
+            right[i] = left[i] - right[i];
+        }
+        else if (channelAssignment == SIDE_RIGHT)
+        {
+            left[i] += right[i];
+        }
+        else
+        {
+            const auto side = right[i];
+            const auto mid = static_cast<std::int32_t>((static_cast<std::uint32_t>(left[i]) << 1) | (side & 1));
+            left[i] = (mid + side) >> 1;
+            right[i] = (mid - side) >> 1;
+        }
+    }
+    
+    mDecodedFrameCount = blockSize;
+    mDecodedBitsPerSample = bitsPerSample;
+    return true;
+}
+
+///------------------------------------------------------------------------------------------------
+
+bool FlacDecoder::DecodeSubframe(const int channelIndex, const int blockSize, const int bitsPerSample)
+{
+    if (ReadBits(1) != 0)
+    {
+        return false;
+    }
+    
+    const auto subframeType = static_cast<int>(ReadBits(6));
+    
+    auto wastedBitCount = 0;
+    if (ReadBits(1))
+    {
+        wastedBitCount = static_cast<int>(ReadUnary()) + 1;
+    }
+    
+    const auto sampleBitCount = bitsPerSample - wastedBitCount;
+    if (sampleBitCount <= 0)
+    {
+        return false;
+    }
+    
+    auto* samples = &mDecodedSamples[static_cast<std::size_t>(channelIndex * mMaxBlockSize)];
+    
+    // Constant
+    if (subframeType == 0)
+    {
+        std::fill(samples, samples + blockSize, ReadSignedBits(sampleBitCount));
+    }
+    // Verbatim
+    else if (subframeType == 1)
+    {
+        for (int i = 0; i < blockSize; ++i)
+        {
+            samples[i] = ReadSignedBits(sampleBitCount);
+        }
+    }
+    // Fixed predictor
+    else if (subframeType >= 8 && subframeType <= 12)
+    {
+        const auto order = subframeType - 8;
+        if (order > blockSize)
+        {
+            return false;
+        }
+        
+        for (int i = 0; i < order; ++i)
+        {
+            samples[i] = ReadSignedBits(sampleBitCount);
+        }
+        
+        if (!DecodeResidual(samples, blockSize, order))
+        {
+            return false;
+        }
+        
+        for (int i = order; i < blockSize; ++i)
+        {
+            switch (order)
+            {
+                case 1: samples[i] += samples[i - 1]; break;
+                case 2: samples[i] += 2 * samples[i - 1] - samples[i - 2]; break;
+                case 3: samples[i] += 3 * samples[i - 1] - 3 * samples[i - 2] + samples[i - 3]; break;
+                case 4: samples[i] += 4 * samples[i - 1] - 6 * samples[i - 2] + 4 * samples[i - 3] - samples[i - 4]; break;
+                default: break;
+            }
+        }
+    }
+    // Linear predictor
+    else if (subframeType >= 32)
+    {
+        const auto order = subframeType - 31;
+        if (order > blockSize)
+        {
+            return false;
+        }
+        
+        for (int i = 0; i < order; ++i)
+        {
+            samples[i] = ReadSignedBits(sampleBitCount);
+        }
+        
+        const auto coefficientPrecision = static_cast<int>(ReadBits(4)) + 1;
+        const auto shift = ReadSignedBits(5);
+        if (coefficientPrecision == 16 || shift < 0)
+        {
+            return false;
+        }
+        
+        std::int32_t coefficients[MAX_LPC_ORDER];
+        for (int i = 0; i < order; ++i)
+        {
+            coefficients[i] = ReadSignedBits(coefficientPrecision);
+        }
+        
+        if (!DecodeResidual(samples, blockSize, order))
+        {
+            return false;
+        }
+        
+        for (int i = order; i < blockSize; ++i)
+        {
+            std::int64_t prediction = 0;
+            for (int j = 0; j < order; ++j)
+            {
+                prediction += static_cast<std::int64_t>(coefficients[j]) * samples[i - 1 - j];
+            }
+            samples[i] += static_cast<std::int32_t>(prediction >> shift);
+        }
+    }
+    else
+    {
+        return false;
+    }
+    
+    if (wastedBitCount > 0)
+    {
+        for (int i = 0; i < blockSize; ++i)
+        {
+            samples[i] = static_cast<std::int32_t>(static_cast<std::uint32_t>(samples[i]) << wastedBitCount);
+        }
+    }
+    
+    return !mEndOfStream;
+}
+
+///------------------------------------------------------------------------------------------------
+
+bool FlacDecoder::DecodeResidual(std::int32_t* samples, const int blockSize, const int predictorOrder)
+{
+    const auto codingMethod = ReadBits(2);
+    if (codingMethod > 1)
+    {
+        return false;
+    }
+    
+    const auto riceParameterBitCount = codingMethod == 0 ? 4 : 5;
+    const auto escapeRiceParameter = codingMethod == 0 ? 15u : 31u;
+    const auto partitionOrder = static_cast<int>(ReadBits(4));
+    const auto partitionSampleCount = blockSize >> partitionOrder;
+    if ((partitionSampleCount << partitionOrder) != blockSize || partitionSampleCount < predictorOrder)
+    {
+        return false;
+    }
+    
+    auto sampleIndex = predictorOrder;
+    for (int partitionIndex = 0; partitionIndex < (1 << partitionOrder); ++partitionIndex)
+    {
+        const auto partitionEnd = (partitionIndex + 1) * partitionSampleCount;
+        const auto riceParameter = ReadBits(riceParameterBitCount);
+        if (riceParameter == escapeRiceParameter)
+        {
+            const auto rawBitCount = static_cast<int>(ReadBits(5));
+            for (; sampleIndex < partitionEnd; ++sampleIndex)
+            {
+                samples[sampleIndex] = rawBitCount > 0 ? ReadSignedBits(rawBitCount) : 0;
+            }
+        }
+        else
+        {
+            for (; sampleIndex < partitionEnd; ++sampleIndex)
+            {
+                const auto quotient = ReadUnary();
+                const auto value = (quotient << riceParameter) | ReadBits(static_cast<int>(riceParameter));
+                samples[sampleIndex] = static_cast<std::int32_t>(value >> 1) ^ -static_cast<std::int32_t>(value & 1);
+            }
+        }
+        
+        if (mEndOfStream)
+        {
+            return false;
+        }
+    }
+    
+    return true;
+}
+
+///------------------------------------------------------------------------------------------------
+
+bool FlacDecoder::FillBitCache(const int bitCount)
+{
+    while (mBitCacheCount < bitCount)
+    {
+        if (mReadBufferPosition == mReadBufferSize)
+        {
+            mFile.read(reinterpret_cast<char*>(mReadBuffer.data()), static_cast<std::streamsize>(mReadBuffer.size()));
+            mReadBufferSize = static_cast<std::size_t>(mFile.gcount());
+            mReadBufferPosition = 0;
+            
+            if (mReadBufferSize == 0)
+            {
+                mEndOfStream = true;
+                return false;
+            }
+        }
+        
+        mBitCache = (mBitCache << 8) | mReadBuffer[mReadBufferPosition++];
+        mBitCacheCount += 8;
+    }
+    
+    return true;
+}
+
+///------------------------------------------------------------------------------------------------
+
+std::uint32_t FlacDecoder::ReadBits(const int bitCount)
+{
+    if (bitCount == 0 || !FillBitCache(bitCount))
+    {
+        return 0;
+    }
+    
+    mBitCacheCount -= bitCount;
+    return static_cast<std::uint32_t>((mBitCache >> mBitCacheCount) & ((1ull << bitCount) - 1));
+}
+
+///------------------------------------------------------------------------------------------------
+
+std::int32_t FlacDecoder::ReadSignedBits(const int bitCount)
+{
+    // Sign extends the bitCount wide two's complement value
+    const auto value = ReadBits(bitCount);
+    const auto signBit = 1u << (bitCount - 1);
+    return static_cast<std::int32_t>((value ^ signBit) - signBit);
+}
+
+///------------------------------------------------------------------------------------------------
+
+std::uint32_t FlacDecoder::ReadUnary()
+{
+    std::uint32_t zeroCount = 0;
+    while (FillBitCache(1))
+    {
+        // Scan the cached bits for the terminating 1 without refilling per bit
+        while (mBitCacheCount > 0)
+        {
+            mBitCacheCount--;
+            if ((mBitCache >> mBitCacheCount) & 1)
+            {
+                return zeroCount;
+            }
+            zeroCount++;
+        }
+    }
+    
+    return zeroCount;
+}
+
+///------------------------------------------------------------------------------------------------
+
+void FlacDecoder::AlignToByte()
+{
+    mBitCacheCount -= mBitCacheCount % 8;
+}
+
+///------------------------------------------------------------------------------------------------
+
+}
+
+///------------------------------------------------------------------------------------------------
@@ -0,0 +1,95 @@
+///------------------------------------------------------------------------------------------------
+///  FlacDecoder.h
+///  Predators
+///
+///  Created by Alex Koukoulas on 01/05/2024
+///------------------------------------------------------------------------------------------------
+
+#ifndef FlacDecoder_h
+#define FlacDecoder_h
+
+///------------------------------------------------------------------------------------------------
+
+#include <array>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+///------------------------------------------------------------------------------------------------
+
+namespace sound
+{
+
+///------------------------------------------------------------------------------------------------
+/// Streaming FLAC decoder. Only a small read buffer and a single decoded frame are held in memory
+/// at any time, so that music can be decoded in small chunks as it plays. Supports everything
+/// reference encoders produce (fixed and LPC subframes, rice/rice2 residuals, all stereo
+/// decorrelation modes, 4 to 24 bits per sample); frame CRCs are not verified.
+class FlacDecoder final
+{
+public:
+    FlacDecoder() = default;
+    FlacDecoder(const FlacDecoder&) = delete;
+    FlacDecoder& operator = (const FlacDecoder&) = delete;
+    
+    // Parses the stream's metadata. Returns false (logging why) on unreadable or invalid files.
+    bool Open(const std::string& filePath);
+    
+    // Decodes up to frameCount (interleaved, in [-1, 1]) sample frames into outSamples. Returns
+    // the number of frames decoded, which is only less than frameCount at the end of the stream.
+    int Read(float* outSamples, const int frameCount);
+    
+    // Restarts decoding from the stream's first sample
+    void Rewind();
+    
+    [[nodiscard]] bool IsOpen() const;
+    [[nodiscard]] int GetSampleRate() const;
+    [[nodiscard]] int GetChannelCount() const;
+    [[nodiscard]] int GetBitsPerSample() const;
+    [[nodiscard]] std::int64_t GetTotalFrameCount() const;
+    
+    // MD5 of the unencoded samples as stored in STREAMINFO (all zeroes if the encoder didn't compute it)
+    [[nodiscard]] const std::array<std::uint8_t, 16>& GetMd5Signature() const;
+    
+private:
+    bool DecodeFrame();
+    bool DecodeSubframe(const int channelIndex, const int blockSize, const int bitsPerSample);
+    bool DecodeResidual(std::int32_t* samples, const int blockSize, const int predictorOrder);
+    
+    bool FillBitCache(const int bitCount);
+    std::uint32_t ReadBits(const int bitCount);
+    std::int32_t ReadSignedBits(const int bitCount);
+    std::uint32_t ReadUnary();
+    void AlignToByte();
+    
+private:
+    std::ifstream mFile;
+    std::vector<std::uint8_t> mReadBuffer;
+    std::size_t mReadBufferPosition = 0;
+    std::size_t mReadBufferSize = 0;
+    std::uint64_t mBitCache = 0;
+    int mBitCacheCount = 0;
+    bool mEndOfStream = false;
+    
+    std::streamoff mFirstFrameOffset = 0;
+    int mSampleRate = 0;
+    int mChannelCount = 0;
+    int mBitsPerSample = 0;
+    int mMaxBlockSize = 0;
+    std::int64_t mTotalFrameCount = 0;
+    std::array<std::uint8_t, 16> mMd5Signature = {};
+    
+    std::vector<std::int32_t> mDecodedSamples; // Channel planar, mMaxBlockSize samples per channel
+    int mDecodedFrameCount = 0;
+    int mDecodedFrameCursor = 0;
+    int mDecodedBitsPerSample = 0;
+};
+
+///------------------------------------------------------------------------------------------------
+
+}
+
+///------------------------------------------------------------------------------------------------
+
+#endif /* FlacDecoder_h */
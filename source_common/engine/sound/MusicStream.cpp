@@ -0,0 +1,221 @@
+///------------------------------------------------------------------------------------------------
+///  MusicStream.cpp
+///  Predators
+///
+///  Created by Alex Koukoulas on 01/05/2024
+///------------------------------------------------------------------------------------------------
+
+#include <algorithm>
+#include <cstring>
+#include <engine/sound/MusicStream.h>
+#include <engine/utils/JobSystem.h>
+
+///------------------------------------------------------------------------------------------------
+
+namespace sound
+{
+
+///------------------------------------------------------------------------------------------------
+
+static constexpr float REFILL_SECONDS = 0.25f;
+
+///------------------------------------------------------------------------------------------------
+
+MusicStream::MusicStream(const int outputSampleRate, const float bufferedSeconds /* = DEFAULT_BUFFERED_SECONDS */)
+    : mBufferFrameCapacity(std::max(1, static_cast<int>(outputSampleRate * bufferedSeconds)))
+    , mWrittenFrameCount(0)
+    , mReadFrameCount(0)
+    , mDecoding(false)
+    , mDecoderFinished(false)
+    , mSourceFrameCount(0)
+    , mSourcePosition(0.0)
+    , mSourceStep(1.0)
+    , mOutputSampleRate(outputSampleRate)
+    , mLooping(false)
+{
+    mBuffer.resize(mBufferFrameCapacity * CHANNEL_COUNT);
+}
+
+///------------------------------------------------------------------------------------------------
+
+bool MusicStream::Open(const std::string& filePath, const bool looping)
+{
+    if (!mDecoder.Open(filePath))
+    {
+        mDecoderFinished = true;
+        return false;
+    }
+    
+    mLooping = looping;
+    mSourceStep = static_cast<double>(mDecoder.GetSampleRate())/mOutputSampleRate;
+    mDecodedSamples.resize(SOURCE_CHUNK_FRAME_COUNT * mDecoder.GetChannelCount());
+    
+    // A single silent frame to interpolate the first decoded one from, positioned so that
+    // the first output frame lands exactly on the first decoded one
+    mSourceFrames.assign((SOURCE_CHUNK_FRAME_COUNT + 1) * CHANNEL_COUNT, 0.0f);
+    mSourceFrameCount = 1;
+    mSourcePosition = 1.0;
+    return true;
+}
+
+///------------------------------------------------------------------------------------------------
+
+bool MusicStream::NeedsDecoding() const
+{
+    if (mDecoderFinished.load(std::memory_order_acquire))
+    {
+        return false;
+    }
+    
+    return mBufferFrameCapacity - GetBufferedFrameCount() >= std::min(mBufferFrameCapacity, static_cast<int>(mOutputSampleRate * REFILL_SECONDS));
+}
+
+///------------------------------------------------------------------------------------------------
+
+void MusicStream::RequestDecode(jobs::JobSystem& jobSystem)
+{
+    if (mDecoding.exchange(true, std::memory_order_acq_rel))
+    {
+        return;
+    }
+    
+    jobSystem.Submit([musicStream = shared_from_this()]()
+    {
+        musicStream->Decode();
+        musicStream->mDecoding.store(false, std::memory_order_release);
+    });
+}
+
+///------------------------------------------------------------------------------------------------
+
+void MusicStream::Decode()
+{
+    if (mDecoderFinished.load(std::memory_order_relaxed))
+    {
+        return;
+    }
+    
+    const auto writtenFrameCount = mWrittenFrameCount.load(std::memory_order_relaxed);
+    const auto freeFrameCount = mBufferFrameCapacity - static_cast<int>(writtenFrameCount - mReadFrameCount.load(std::memory_order_acquire));
+    
+    auto producedFrameCount = 0;
+    while (producedFrameCount < freeFrameCount)
+    {
+        // Linear interpolation needs the source frame after the current position too
+        const auto sourceFrameIndex = static_cast<int>(mSourcePosition);
+        if (sourceFrameIndex + 1 >= mSourceFrameCount)
+        {
+            if (!DecodeSourceChunk())
+            {
+                mDecoderFinished.store(true, std::memory_order_release);
+                break;
+            }
+            continue;
+        }
+        
+        const auto fraction = static_cast<float>(mSourcePosition - sourceFrameIndex);
+        const auto* sourceFrame = &mSourceFrames[sourceFrameIndex * CHANNEL_COUNT];
+        auto* bufferFrame = &mBuffer[((writtenFrameCount + producedFrameCount) % mBufferFrameCapacity) * CHANNEL_COUNT];
+        for (int channel = 0; channel < CHANNEL_COUNT; ++channel)
+        {
+            bufferFrame[channel] = sourceFrame[channel] + (sourceFrame[channel + CHANNEL_COUNT] - sourceFrame[channel]) * fraction;
+        }
+        
+        mSourcePosition += mSourceStep;
+        producedFrameCount++;
+    }
+    
+    mWrittenFrameCount.store(writtenFrameCount + producedFrameCount, std::memory_order_release);
+}
+
+///------------------------------------------------------------------------------------------------
+
+int MusicStream::Read(float* outSamples, const int frameCount)
+{
+    const auto readFrameCount = mReadFrameCount.load(std::memory_order_relaxed);
+    const auto availableFrameCount = static_cast<int>(mWrittenFrameCount.load(std::memory_order_acquire) - readFrameCount);
+    const auto copiedFrameCount = std::min(frameCount, availableFrameCount);
+    
+    // At most two copies, either side of the ring buffer's wrap around
+    const auto startFrameIndex = static_cast<int>(readFrameCount % mBufferFrameCapacity);
+    const auto firstCopyFrameCount = std::min(copiedFrameCount, mBufferFrameCapacity - startFrameIndex);
+    std::memcpy(outSamples, &mBuffer[startFrameIndex * CHANNEL_COUNT], firstCopyFrameCount * CHANNEL_COUNT * sizeof(float));
+    std::memcpy(outSamples + firstCopyFrameCount * CHANNEL_COUNT, mBuffer.data(), (copiedFrameCount - firstCopyFrameCount) * CHANNEL_COUNT * sizeof(float));
+    
+    mReadFrameCount.store(readFrameCount + copiedFrameCount, std::memory_order_release);
+    return copiedFrameCount;
+}
+
+///------------------------------------------------------------------------------------------------
+
+bool MusicStream::IsDecoding() const
+{
+    return mDecoding.load(std::memory_order_acquire);
+}
+
+///------------------------------------------------------------------------------------------------
+
+bool MusicStream::IsFinished() const
+{
+    return mDecoderFinished.load(std::memory_order_acquire) && GetBufferedFrameCount() == 0;
+}
+
+///------------------------------------------------------------------------------------------------
+
+int MusicStream::GetBufferedFrameCount() const
+{
+    return static_cast<int>(mWrittenFrameCount.load(std::memory_order_acquire) - mReadFrameCount.load(std::memory_order_acquire));
+}
+
+///------------------------------------------------------------------------------------------------
+
+int MusicStream::GetBufferFrameCapacity() const
+{
+    return mBufferFrameCapacity;
+}
+
+///------------------------------------------------------------------------------------------------
+
+bool MusicStream::DecodeSourceChunk()
+{
+    if (!mDecoder.IsOpen())
+    {
+        return false;
+    }
+    
+    auto decodedFrameCount = mDecoder.Read(mDecodedSamples.data(), SOURCE_CHUNK_FRAME_COUNT);
+    if (decodedFrameCount == 0 && mLooping)
+    {
+        mDecoder.Rewind();
+        decodedFrameCount = mDecoder.Read(mDecodedSamples.data(), SOURCE_CHUNK_FRAME_COUNT);
+    }
+    
+    if (decodedFrameCount == 0)
+    {
+        return false;
+    }
+    
+    // Carry the last frame over, so that interpolation is seamless across chunks (and loops)
+    const auto lastSourceFrameIndex = mSourceFrameCount - 1;
+    std::copy_n(&mSourceFrames[lastSourceFrameIndex * CHANNEL_COUNT], CHANNEL_COUNT, mSourceFrames.begin());
+    mSourcePosition -= lastSourceFrameIndex;
+    
+    // Mono is played on both channels, and anything past the first two channels is dropped
+    const auto decodedChannelCount = mDecoder.GetChannelCount();
+    for (int i = 0; i < decodedFrameCount; ++i)
+    {
+        const auto* decodedFrame = &mDecodedSamples[i * decodedChannelCount];
+        auto* sourceFrame = &mSourceFrames[(i + 1) * CHANNEL_COUNT];
+        sourceFrame[0] = decodedFrame[0];
+        sourceFrame[1] = decodedFrame[decodedChannelCount > 1 ? 1 : 0];
+    }
+    
+    mSourceFrameCount = decodedFrameCount + 1;
+    return true;
+}
+
+///------------------------------------------------------------------------------------------------
+
+}
+
+///------------------------------------------------------------------------------------------------
@@ -0,0 +1,95 @@
+///------------------------------------------------------------------------------------------------
+///  MusicStream.h
+///  Predators
+///
+///  Created by Alex Koukoulas on 01/05/2024
+///------------------------------------------------------------------------------------------------
+
+#ifndef MusicStream_h
+#define MusicStream_h
+
+///------------------------------------------------------------------------------------------------
+
+#include <atomic>
+#include <cstdint>
+#include <engine/sound/FlacDecoder.h>
+#include <memory>
+#include <string>
+#include <vector>
+
+///------------------------------------------------------------------------------------------------
+
+namespace jobs { class JobSystem; }
+
+///------------------------------------------------------------------------------------------------
+
+namespace sound
+{
+
+///------------------------------------------------------------------------------------------------
+/// A music track decoded a little ahead of playback, instead of all at once. Job system workers
+/// decode it in chunks, resampled to the output rate and expanded to stereo, into a single producer
+/// single consumer ring buffer that the audio thread reads from without ever blocking.
+class MusicStream final : public std::enable_shared_from_this<MusicStream>
+{
+public:
+    static constexpr int CHANNEL_COUNT = 2;
+    static constexpr float DEFAULT_BUFFERED_SECONDS = 2.0f;
+    
+    explicit MusicStream(const int outputSampleRate, const float bufferedSeconds = DEFAULT_BUFFERED_SECONDS);
+    MusicStream(const MusicStream&) = delete;
+    MusicStream& operator = (const MusicStream&) = delete;
+    
+    // Needs to be called (once) before any of the below. Looped streams restart seamlessly at their end.
+    bool Open(const std::string& filePath, const bool looping);
+    
+    // Whether enough of the buffer has been played back for another chunk to be worth decoding
+    [[nodiscard]] bool NeedsDecoding() const;
+    
+    // Decodes on a worker, unless a decode is already in flight. The job keeps the stream alive.
+    void RequestDecode(jobs::JobSystem& jobSystem);
+    
+    // Decodes until the buffer is full (or an unlooped stream's end). Never called concurrently.
+    void Decode();
+    
+    // Audio thread only. Copies up to frameCount (interleaved stereo) sample frames to outSamples
+    // and returns how many were available.
+    int Read(float* outSamples, const int frameCount);
+    
+    [[nodiscard]] bool IsDecoding() const;
+    [[nodiscard]] bool IsFinished() const;
+    [[nodiscard]] int GetBufferedFrameCount() const;
+    [[nodiscard]] int GetBufferFrameCapacity() const;
+    
+private:
+    bool DecodeSourceChunk();
+    
+private:
+    static constexpr int SOURCE_CHUNK_FRAME_COUNT = 1024;
+    
+    FlacDecoder mDecoder;
+    
+    std::vector<float> mBuffer;
+    const int mBufferFrameCapacity;
+    std::atomic<std::uint64_t> mWrittenFrameCount;
+    std::atomic<std::uint64_t> mReadFrameCount;
+    std::atomic<bool> mDecoding;
+    std::atomic<bool> mDecoderFinished;
+    
+    // Decoding thread only
+    std::vector<float> mDecodedSamples;
+    std::vector<float> mSourceFrames; // Stereo, with the previous chunk's last frame carried over at the front
+    int mSourceFrameCount;
+    double mSourcePosition;
+    double mSourceStep;
+    const int mOutputSampleRate;
+    bool mLooping;
+};
+
+///------------------------------------------------------------------------------------------------
+
+}
+
+///------------------------------------------------------------------------------------------------
+
+#endif /* MusicStream_h */
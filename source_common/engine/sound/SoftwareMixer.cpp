@@ -0,0 +1,474 @@
+///------------------------------------------------------------------------------------------------
+///  SoftwareMixer.cpp
+///  Predators
+///
+///  Created by Alex Koukoulas on 01/05/2024
+///------------------------------------------------------------------------------------------------
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <engine/sound/MusicStream.h>
+#include <engine/sound/SoftwareMixer.h>
+#include <engine/utils/Profiling.h>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define MIXER_SIMD_SSE
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define MIXER_SIMD_NEON
+#endif
+
+///------------------------------------------------------------------------------------------------
+
+namespace sound
+{
+
+///------------------------------------------------------------------------------------------------
+/// Four lane float vectors, i.e. two stereo frames at a time.
+#if defined(MIXER_SIMD_SSE)
+using Float4 = __m128;
+static inline Float4 Load4(const float* source) { return _mm_loadu_ps(source); }
+static inline void Store4(float* destination, const Float4 value) { _mm_storeu_ps(destination, value); }
+static inline Float4 Set4(const float a, const float b, const float c, const float d) { return _mm_setr_ps(a, b, c, d); }
+static inline Float4 Splat4(const float value) { return _mm_set1_ps(value); }
+static inline Float4 Add4(const Float4 lhs, const Float4 rhs) { return _mm_add_ps(lhs, rhs); }
+static inline Float4 Sub4(const Float4 lhs, const Float4 rhs) { return _mm_sub_ps(lhs, rhs); }
+static inline Float4 Mul4(const Float4 lhs, const Float4 rhs) { return _mm_mul_ps(lhs, rhs); }
+static inline Float4 Min4(const Float4 lhs, const Float4 rhs) { return _mm_min_ps(lhs, rhs); }
+static inline Float4 Max4(const Float4 lhs, const Float4 rhs) { return _mm_max_ps(lhs, rhs); }
+#elif defined(MIXER_SIMD_NEON)
+using Float4 = float32x4_t;
+static inline Float4 Load4(const float* source) { return vld1q_f32(source); }
+static inline void Store4(float* destination, const Float4 value) { vst1q_f32(destination, value); }
+static inline Float4 Set4(const float a, const float b, const float c, const float d) { const float values[4] = { a, b, c, d }; return vld1q_f32(values); }
+static inline Float4 Splat4(const float value) { return vdupq_n_f32(value); }
+static inline Float4 Add4(const Float4 lhs, const Float4 rhs) { return vaddq_f32(lhs, rhs); }
+static inline Float4 Sub4(const Float4 lhs, const Float4 rhs) { return vsubq_f32(lhs, rhs); }
+static inline Float4 Mul4(const Float4 lhs, const Float4 rhs) { return vmulq_f32(lhs, rhs); }
+static inline Float4 Min4(const Float4 lhs, const Float4 rhs) { return vminq_f32(lhs, rhs); }
+static inline Float4 Max4(const Float4 lhs, const Float4 rhs) { return vmaxq_f32(lhs, rhs); }
+#else
+struct Float4 { float mLanes[4]; };
+static inline Float4 Load4(const float* source) { return {{ source[0], source[1], source[2], source[3] }}; }
+static inline void Store4(float* destination, const Float4 value) { std::memcpy(destination, value.mLanes, sizeof(value.mLanes)); }
+static inline Float4 Set4(const float a, const float b, const float c, const float d) { return {{ a, b, c, d }}; }
+static inline Float4 Splat4(const float value) { return {{ value, value, value, value }}; }
+static inline Float4 Add4(const Float4 lhs, const Float4 rhs) { return {{ lhs.mLanes[0] + rhs.mLanes[0], lhs.mLanes[1] + rhs.mLanes[1], lhs.mLanes[2] + rhs.mLanes[2], lhs.mLanes[3] + rhs.mLanes[3] }}; }
+static inline Float4 Sub4(const Float4 lhs, const Float4 rhs) { return {{ lhs.mLanes[0] - rhs.mLanes[0], lhs.mLanes[1] - rhs.mLanes[1], lhs.mLanes[2] - rhs.mLanes[2], lhs.mLanes[3] - rhs.mLanes[3] }}; }
+static inline Float4 Mul4(const Float4 lhs, const Float4 rhs) { return {{ lhs.mLanes[0] * rhs.mLanes[0], lhs.mLanes[1] * rhs.mLanes[1], lhs.mLanes[2] * rhs.mLanes[2], lhs.mLanes[3] * rhs.mLanes[3] }}; }
+static inline Float4 Min4(const Float4 lhs, const Float4 rhs) { return {{ std::min(lhs.mLanes[0], rhs.mLanes[0]), std::min(lhs.mLanes[1], rhs.mLanes[1]), std::min(lhs.mLanes[2], rhs.mLanes[2]), std::min(lhs.mLanes[3], rhs.mLanes[3]) }}; }
+static inline Float4 Max4(const Float4 lhs, const Float4 rhs) { return {{ std::max(lhs.mLanes[0], rhs.mLanes[0]), std::max(lhs.mLanes[1], rhs.mLanes[1]), std::max(lhs.mLanes[2], rhs.mLanes[2]), std::max(lhs.mLanes[3], rhs.mLanes[3]) }}; }
+#endif
+
+///------------------------------------------------------------------------------------------------
+
+static constexpr float MIN_PITCH = 0.01f;
+static constexpr float AVERAGE_CALLBACK_SMOOTHING = 0.05f;
+
+///------------------------------------------------------------------------------------------------
+
+static void MixSamples(float* outSamples, const float* samples, const int sampleCount, const float gain)
+{
+    const auto gain4 = Splat4(gain);
+    
+    auto i = 0;
+    for (; i + 4 <= sampleCount; i += 4)
+    {
+        Store4(outSamples + i, Add4(Load4(outSamples + i), Mul4(Load4(samples + i), gain4)));
+    }
+    
+    for (; i < sampleCount; ++i)
+    {
+        outSamples[i] += samples[i] * gain;
+    }
+}
+
+///------------------------------------------------------------------------------------------------
+
+SoftwareMixer::SoftwareMixer(const int sampleRate, const int maxFramesPerMix)
+    : mSampleRate(sampleRate)
+    , mMaxFramesPerMix(std::max(1, maxFramesPerMix))
+    , mMusicStream(nullptr)
+    , mMusicGain(1.0f)
+    , mTargetMusicGain(1.0f)
+    , mNextVoiceStartIndex(0)
+    , mSfxPaused(false)
+    , mMusicPaused(false)
+    , mCallbackCount(0)
+    , mLastCallbackMicros(0.0f)
+    , mAverageCallbackMicros(0.0f)
+    , mMaxCallbackMicros(0.0f)
+    , mCallbackOverrunCount(0)
+    , mMusicUnderrunCount(0)
+    , mDroppedCommandCount(0)
+    , mVoiceStealCount(0)
+    , mActiveVoiceCount(0)
+{
+    mMusicSamples.resize(mMaxFramesPerMix * CHANNEL_COUNT);
+}
+
+///------------------------------------------------------------------------------------------------
+
+void SoftwareMixer::PlaySfx(const SoundBuffer& soundBuffer, const float gain /* = 1.0f */, const float pitch /* = 1.0f */, const bool looping /* = false */)
+{
+    if (soundBuffer.mFrameCount == 0)
+    {
+        return;
+    }
+    
+    PushCommand({ CommandType::PLAY_SFX, &soundBuffer, nullptr, gain, std::max(MIN_PITCH, pitch), looping });
+}
+
+///------------------------------------------------------------------------------------------------
+
+void SoftwareMixer::SetMusicStream(MusicStream* musicStream)
+{
+    PushCommand({ CommandType::SET_MUSIC_STREAM, nullptr, musicStream, 0.0f, 0.0f, false });
+}
+
+///------------------------------------------------------------------------------------------------
+
+void SoftwareMixer::SetMusicGain(const float gain)
+{
+    PushCommand({ CommandType::SET_MUSIC_GAIN, nullptr, nullptr, gain, 0.0f, false });
+}
+
+///------------------------------------------------------------------------------------------------
+
+void SoftwareMixer::SetSfxPaused(const bool paused)
+{
+    PushCommand({ CommandType::SET_SFX_PAUSED, nullptr, nullptr, 0.0f, 0.0f, paused });
+}
+
+///------------------------------------------------------------------------------------------------
+
+void SoftwareMixer::SetMusicPaused(const bool paused)
+{
+    PushCommand({ CommandType::SET_MUSIC_PAUSED, nullptr, nullptr, 0.0f, 0.0f, paused });
+}
+
+///------------------------------------------------------------------------------------------------
+
+bool SoftwareMixer::TryPopRetiredMusicStream(MusicStream*& outMusicStream)
+{
+    return mRetiredMusicStreamQueue.TryPop(outMusicStream);
+}
+
+///------------------------------------------------------------------------------------------------
+
+void SoftwareMixer::Mix(float* outSamples, const int frameCount)
+{
+    const auto mixStartNanos = profiling::GetNowNanos();
+    
+    ApplyCommands();
+    
+    for (int mixedFrameCount = 0; mixedFrameCount < frameCount; mixedFrameCount += mMaxFramesPerMix)
+    {
+        MixBlock(outSamples + mixedFrameCount * CHANNEL_COUNT, std::min(mMaxFramesPerMix, frameCount - mixedFrameCount));
+    }
+    
+    auto activeVoiceCount = 0;
+    for (const auto& voice: mVoices)
+    {
+        activeVoiceCount += voice.mActive ? 1 : 0;
+    }
+    mActiveVoiceCount.store(activeVoiceCount, std::memory_order_relaxed);
+    
+    const auto callbackMicros = (profiling::GetNowNanos() - mixStartNanos)/1000.0f;
+    const auto callbackBudgetMicros = frameCount * 1000000.0f/mSampleRate;
+    if (callbackMicros > callbackBudgetMicros)
+    {
+        mCallbackOverrunCount.fetch_add(1, std::memory_order_relaxed);
+    }
+    
+    // Only ever written here, so plain loads and stores suffice
+    const auto callbackCount = mCallbackCount.load(std::memory_order_relaxed);
+    const auto averageCallbackMicros = mAverageCallbackMicros.load(std::memory_order_relaxed);
+    mAverageCallbackMicros.store(callbackCount == 0 ? callbackMicros : averageCallbackMicros + (callbackMicros - averageCallbackMicros) * AVERAGE_CALLBACK_SMOOTHING, std::memory_order_relaxed);
+    mMaxCallbackMicros.store(std::max(mMaxCallbackMicros.load(std::memory_order_relaxed), callbackMicros), std::memory_order_relaxed);
+    mLastCallbackMicros.store(callbackMicros, std::memory_order_relaxed);
+    mCallbackCount.store(callbackCount + 1, std::memory_order_relaxed);
+}
+
+///------------------------------------------------------------------------------------------------
+
+MixerStats SoftwareMixer::GetStats() const
+{
+    MixerStats stats;
+    stats.mCallbackCount = mCallbackCount.load(std::memory_order_relaxed);
+    stats.mLastCallbackMicros = mLastCallbackMicros.load(std::memory_order_relaxed);
+    stats.mAverageCallbackMicros = mAverageCallbackMicros.load(std::memory_order_relaxed);
+    stats.mMaxCallbackMicros = mMaxCallbackMicros.load(std::memory_order_relaxed);
+    stats.mCallbackBudgetMicros = mMaxFramesPerMix * 1000000.0f/mSampleRate;
+    stats.mCallbackOverrunCount = mCallbackOverrunCount.load(std::memory_order_relaxed);
+    stats.mMusicUnderrunCount = mMusicUnderrunCount.load(std::memory_order_relaxed);
+    stats.mDroppedCommandCount = mDroppedCommandCount.load(std::memory_order_relaxed);
+    stats.mVoiceStealCount = mVoiceStealCount.load(std::memory_order_relaxed);
+    stats.mActiveVoiceCount = mActiveVoiceCount.load(std::memory_order_relaxed);
+    return stats;
+}
+
+///------------------------------------------------------------------------------------------------
+
+int SoftwareMixer::GetSampleRate() const
+{
+    return mSampleRate;
+}
+
+///------------------------------------------------------------------------------------------------
+
+void SoftwareMixer::PushCommand(const Command& command)
+{
+    if (!mCommandQueue.TryPush(command))
+    {
+        mDroppedCommandCount.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+///------------------------------------------------------------------------------------------------
+
+void SoftwareMixer::ApplyCommands()
+{
+    Command command;
+    while (mCommandQueue.TryPop(command))
+    {
+        switch (command.mType)
+        {
+            case CommandType::PLAY_SFX:
+            {
+                StartVoice(command);
+            } break;
+            
+            case CommandType::SET_MUSIC_STREAM:
+            {
+                // The queue is drained every game frame and streams are swapped at most once per
+                // music fade, so it can't realistically fill up. If it ever did, the stream is
+                // leaked rather than risk it being destroyed while still in use.
+                if (mMusicStream)
+                {
+                    mRetiredMusicStreamQueue.TryPush(mMusicStream);
+                }
+                mMusicStream = command.mMusicStream;
+            } break;
+            
+            case CommandType::SET_MUSIC_GAIN:
+            {
+                mTargetMusicGain = command.mGain;
+            } break;
+            
+            case CommandType::SET_SFX_PAUSED:
+            {
+                mSfxPaused = command.mFlag;
+            } break;
+            
+            case CommandType::SET_MUSIC_PAUSED:
+            {
+                mMusicPaused = command.mFlag;
+            } break;
+        }
+    }
+}
+
+///------------------------------------------------------------------------------------------------
+
+void SoftwareMixer::StartVoice(const Command& command)
+{
+    Voice* freeVoice = nullptr;
+    Voice* oldestUnloopedVoice = nullptr;
+    Voice* oldestVoice = nullptr;
+    for (auto& voice: mVoices)
+    {
+        if (!voice.mActive)
+        {
+            freeVoice = &voice;
+            break;
+        }
+        
+        if (!voice.mLooping && (!oldestUnloopedVoice || voice.mStartIndex < oldestUnloopedVoice->mStartIndex))
+        {
+            oldestUnloopedVoice = &voice;
+        }
+        
+        if (!oldestVoice || voice.mStartIndex < oldestVoice->mStartIndex)
+        {
+            oldestVoice = &voice;
+        }
+    }
+    
+    if (!freeVoice)
+    {
+        freeVoice = oldestUnloopedVoice ? oldestUnloopedVoice : oldestVoice;
+        mVoiceStealCount.fetch_add(1, std::memory_order_relaxed);
+    }
+    
+    freeVoice->mSamples = command.mSoundBuffer->mSamples.data();
+    freeVoice->mFrameCount = command.mSoundBuffer->mFrameCount;
+    freeVoice->mPosition = 0.0;
+    freeVoice->mStep = command.mPitch;
+    freeVoice->mGain = command.mGain;
+    freeVoice->mStartIndex = mNextVoiceStartIndex++;
+    freeVoice->mLooping = command.mFlag;
+    freeVoice->mActive = true;
+}
+
+///------------------------------------------------------------------------------------------------
+
+void SoftwareMixer::MixBlock(float* outSamples, const int frameCount)
+{
+    const auto sampleCount = frameCount * CHANNEL_COUNT;
+    std::fill_n(outSamples, sampleCount, 0.0f);
+    
+    if (!mSfxPaused)
+    {
+        for (auto& voice: mVoices)
+        {
+            if (voice.mActive)
+            {
+                MixVoice(voice, outSamples, frameCount);
+            }
+        }
+    }
+    
+    if (mMusicStream && !mMusicPaused)
+    {
+        MixMusic(outSamples, frameCount);
+    }
+    
+    // Hard clip whatever the sum of voices pushed out of range
+    const auto minSample4 = Splat4(-1.0f);
+    const auto maxSample4 = Splat4(1.0f);
+    
+    auto i = 0;
+    for (; i + 4 <= sampleCount; i += 4)
+    {
+        Store4(outSamples + i, Min4(Max4(Load4(outSamples + i), minSample4), maxSample4));
+    }
+    
+    for (; i < sampleCount; ++i)
+    {
+        outSamples[i] = std::min(std::max(outSamples[i], -1.0f), 1.0f);
+    }
+}
+
+///------------------------------------------------------------------------------------------------
+
+void SoftwareMixer::MixVoice(Voice& voice, float* outSamples, const int frameCount)
+{
+    const auto* samples = voice.mSamples;
+    const auto lastFrameIndex = voice.mFrameCount - 1;
+    const auto gain4 = Splat4(voice.mGain);
+    
+    auto outFrameIndex = 0;
+    while (outFrameIndex < frameCount)
+    {
+        if (voice.mPosition >= voice.mFrameCount)
+        {
+            if (!voice.mLooping)
+            {
+                voice.mActive = false;
+                return;
+            }
+            
+            voice.mPosition = std::fmod(voice.mPosition, static_cast<double>(voice.mFrameCount));
+        }
+        
+        // Unpitched voices stay on whole frames, so they are straight (gained) copies
+        if (voice.mStep == 1.0)
+        {
+            const auto sourceFrameIndex = static_cast<int>(voice.mPosition);
+            const auto runFrameCount = std::min(frameCount - outFrameIndex, voice.mFrameCount - sourceFrameIndex);
+            MixSamples(outSamples + outFrameIndex * CHANNEL_COUNT, samples + sourceFrameIndex * CHANNEL_COUNT, runFrameCount * CHANNEL_COUNT, voice.mGain);
+            
+            voice.mPosition += runFrameCount;
+            outFrameIndex += runFrameCount;
+            continue;
+        }
+        
+        // Pitched voices are linearly interpolated two output frames at a time, for as long as
+        // both frames' interpolation pairs are within the buffer
+        const auto nextPosition = voice.mPosition + voice.mStep;
+        if (outFrameIndex + 1 < frameCount && nextPosition < lastFrameIndex)
+        {
+            const auto firstFrameIndex = static_cast<int>(voice.mPosition);
+            const auto secondFrameIndex = static_cast<int>(nextPosition);
+            const auto firstFraction = static_cast<float>(voice.mPosition - firstFrameIndex);
+            const auto secondFraction = static_cast<float>(nextPosition - secondFrameIndex);
+            
+            const auto* firstFrame = samples + firstFrameIndex * CHANNEL_COUNT;
+            const auto* secondFrame = samples + secondFrameIndex * CHANNEL_COUNT;
+            const auto from4 = Set4(firstFrame[0], firstFrame[1], secondFrame[0], secondFrame[1]);
+            const auto to4 = Set4(firstFrame[2], firstFrame[3], secondFrame[2], secondFrame[3]);
+            const auto fraction4 = Set4(firstFraction, firstFraction, secondFraction, secondFraction);
+            
+            auto* outFrame = outSamples + outFrameIndex * CHANNEL_COUNT;
+            Store4(outFrame, Add4(Load4(outFrame), Mul4(Add4(from4, Mul4(Sub4(to4, from4), fraction4)), gain4)));
+            
+            voice.mPosition = nextPosition + voice.mStep;
+            outFrameIndex += 2;
+            continue;
+        }
+        
+        // One frame at a time at the end of the block or the buffer, where the frame after the
+        // last one is either the first one (looped) or silence
+        const auto frameIndex = static_cast<int>(voice.mPosition);
+        const auto fraction = static_cast<float>(voice.mPosition - frameIndex);
+        const auto* frame = samples + frameIndex * CHANNEL_COUNT;
+        const auto* nextFrame = frameIndex < lastFrameIndex ? frame + CHANNEL_COUNT : (voice.mLooping ? samples : nullptr);
+        for (int channel = 0; channel < CHANNEL_COUNT; ++channel)
+        {
+            const auto nextSample = nextFrame ? nextFrame[channel] : 0.0f;
+            outSamples[outFrameIndex * CHANNEL_COUNT + channel] += (frame[channel] + (nextSample - frame[channel]) * fraction) * voice.mGain;
+        }
+        
+        voice.mPosition += voice.mStep;
+        outFrameIndex++;
+    }
+    
+    if (voice.mPosition >= voice.mFrameCount && !voice.mLooping)
+    {
+        voice.mActive = false;
+    }
+}
+
+///------------------------------------------------------------------------------------------------
+
+void SoftwareMixer::MixMusic(float* outSamples, const int frameCount)
+{
+    const auto readFrameCount = mMusicStream->Read(mMusicSamples.data(), frameCount);
+    if (readFrameCount < frameCount && !mMusicStream->IsFinished())
+    {
+        mMusicUnderrunCount.fetch_add(1, std::memory_order_relaxed);
+    }
+    
+    // Gain changes are ramped across the block, so that fades don't click
+    const auto gainStep = (mTargetMusicGain - mMusicGain)/frameCount;
+    auto gain4 = Set4(mMusicGain, mMusicGain, mMusicGain + gainStep, mMusicGain + gainStep);
+    const auto gainStep4 = Splat4(gainStep * 2.0f);
+    
+    auto frameIndex = 0;
+    for (; frameIndex + 2 <= readFrameCount; frameIndex += 2)
+    {
+        auto* outFrame = outSamples + frameIndex * CHANNEL_COUNT;
+        Store4(outFrame, Add4(Load4(outFrame), Mul4(Load4(mMusicSamples.data() + frameIndex * CHANNEL_COUNT), gain4)));
+        gain4 = Add4(gain4, gainStep4);
+    }
+    
+    for (; frameIndex < readFrameCount; ++frameIndex)
+    {
+        const auto gain = mMusicGain + gainStep * frameIndex;
+        for (int channel = 0; channel < CHANNEL_COUNT; ++channel)
+        {
+            outSamples[frameIndex * CHANNEL_COUNT + channel] += mMusicSamples[frameIndex * CHANNEL_COUNT + channel] * gain;
+        }
+    }
+    
+    mMusicGain = mTargetMusicGain;
+}
+
+///------------------------------------------------------------------------------------------------
+
+}
+
+///------------------------------------------------------------------------------------------------
@@ -0,0 +1,161 @@
+///------------------------------------------------------------------------------------------------
+///  SoftwareMixer.h
+///  Predators
+///
+///  Created by Alex Koukoulas on 01/05/2024
+///------------------------------------------------------------------------------------------------
+
+#ifndef SoftwareMixer_h
+#define SoftwareMixer_h
+
+///------------------------------------------------------------------------------------------------
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <engine/utils/LockFreeQueue.h>
+#include <vector>
+
+///------------------------------------------------------------------------------------------------
+
+namespace sound
+{
+
+///------------------------------------------------------------------------------------------------
+
+class MusicStream;
+
+///------------------------------------------------------------------------------------------------
+/// Fully decoded sound effect, already converted to the mixer's sample rate and (interleaved) stereo.
+struct SoundBuffer
+{
+    std::vector<float> mSamples;
+    int mFrameCount = 0;
+};
+
+///------------------------------------------------------------------------------------------------
+/// Audio thread health. A callback overrun (taking longer than the audio it mixes lasts) or a music
+/// underrun (the decoders falling behind playback) are both audible dropouts.
+struct MixerStats
+{
+    std::int64_t mCallbackCount = 0;
+    float mLastCallbackMicros = 0.0f;
+    float mAverageCallbackMicros = 0.0f;
+    float mMaxCallbackMicros = 0.0f;
+    float mCallbackBudgetMicros = 0.0f;
+    std::int64_t mCallbackOverrunCount = 0;
+    std::int64_t mMusicUnderrunCount = 0;
+    std::int64_t mDroppedCommandCount = 0;
+    std::int64_t mVoiceStealCount = 0;
+    int mActiveVoiceCount = 0;
+};
+
+///------------------------------------------------------------------------------------------------
+/// Mixes a fixed number of sfx voices and one music stream into stereo float output. Any one other
+/// thread (the game thread) controls it through a lock free command queue, applied at the start of
+/// each Mix, so the audio thread never blocks on it. Nothing is allocated past construction.
+class SoftwareMixer final
+{
+public:
+    static constexpr int CHANNEL_COUNT = 2;
+    static constexpr int VOICE_COUNT = 32;
+    
+    SoftwareMixer(const int sampleRate, const int maxFramesPerMix);
+    SoftwareMixer(const SoftwareMixer&) = delete;
+    SoftwareMixer& operator = (const SoftwareMixer&) = delete;
+    
+    // Sound buffers need to outlive the voices playing them. When all voices are busy, the oldest
+    // unlooped one is stolen (or the oldest looped one, if there are no unlooped ones).
+    void PlaySfx(const SoundBuffer& soundBuffer, const float gain = 1.0f, const float pitch = 1.0f, const bool looping = false);
+    
+    // The previous stream (if any) is handed back through TryPopRetiredMusicStream once the mixer
+    // no longer references it. A null stream stops the music.
+    void SetMusicStream(MusicStream* musicStream);
+    void SetMusicGain(const float gain);
+    void SetSfxPaused(const bool paused);
+    void SetMusicPaused(const bool paused);
+    bool TryPopRetiredMusicStream(MusicStream*& outMusicStream);
+    
+    // Audio thread only. Overwrites outSamples with frameCount interleaved stereo frames.
+    void Mix(float* outSamples, const int frameCount);
+    
+    [[nodiscard]] MixerStats GetStats() const;
+    [[nodiscard]] int GetSampleRate() const;
+    
+private:
+    enum class CommandType
+    {
+        PLAY_SFX,
+        SET_MUSIC_STREAM,
+        SET_MUSIC_GAIN,
+        SET_SFX_PAUSED,
+        SET_MUSIC_PAUSED
+    };
+    
+    struct Command
+    {
+        CommandType mType;
+        const SoundBuffer* mSoundBuffer;
+        MusicStream* mMusicStream;
+        float mGain;
+        float mPitch;
+        bool mFlag;
+    };
+    
+    struct Voice
+    {
+        const float* mSamples = nullptr;
+        int mFrameCount = 0;
+        double mPosition = 0.0;
+        double mStep = 1.0;
+        float mGain = 1.0f;
+        std::uint64_t mStartIndex = 0;
+        bool mLooping = false;
+        bool mActive = false;
+    };
+    
+    void PushCommand(const Command& command);
+    void ApplyCommands();
+    void StartVoice(const Command& command);
+    void MixBlock(float* outSamples, const int frameCount);
+    void MixVoice(Voice& voice, float* outSamples, const int frameCount);
+    void MixMusic(float* outSamples, const int frameCount);
+    
+private:
+    static constexpr std::size_t COMMAND_QUEUE_CAPACITY = 256;
+    static constexpr std::size_t RETIRED_MUSIC_STREAM_QUEUE_CAPACITY = 16;
+    
+    const int mSampleRate;
+    const int mMaxFramesPerMix;
+    
+    LockFreeQueue<Command, COMMAND_QUEUE_CAPACITY> mCommandQueue;
+    LockFreeQueue<MusicStream*, RETIRED_MUSIC_STREAM_QUEUE_CAPACITY> mRetiredMusicStreamQueue;
+    
+    // Audio thread only
+    std::array<Voice, VOICE_COUNT> mVoices;
+    std::vector<float> mMusicSamples;
+    MusicStream* mMusicStream;
+    float mMusicGain;
+    float mTargetMusicGain;
+    std::uint64_t mNextVoiceStartIndex;
+    bool mSfxPaused;
+    bool mMusicPaused;
+    
+    std::atomic<std::int64_t> mCallbackCount;
+    std::atomic<float> mLastCallbackMicros;
+    std::atomic<float> mAverageCallbackMicros;
+    std::atomic<float> mMaxCallbackMicros;
+    std::atomic<std::int64_t> mCallbackOverrunCount;
+    std::atomic<std::int64_t> mMusicUnderrunCount;
+    std::atomic<std::int64_t> mDroppedCommandCount;
+    std::atomic<std::int64_t> mVoiceStealCount;
+    std::atomic<int> mActiveVoiceCount;
+};
+
+///------------------------------------------------------------------------------------------------
+
+}
+
+///------------------------------------------------------------------------------------------------
+
+#endif /* SoftwareMixer_h */
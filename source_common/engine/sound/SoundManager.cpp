@@ -9,11 +9,11 @@
 #include <engine/utils/PlatformMacros.h>
 #if defined(MACOS) || defined(MOBILE_FLOW)
 #include <platform_utilities/AppleSoundUtils.h>
-#define PLATFORM_CALL(func) (sound_utils::func)
-#elif defined(WINDOWS)
-#include <platform_utilities/WindowsUtils.h>
-#define PLATFORM_CALL(func)
+#else
+#include <platform_utilities/SDLSoundUtils.h>
+#define SOFTWARE_MIXER_BACKEND
 #endif
+#define PLATFORM_CALL(func) (sound_utils::func)
 
 ///------------------------------------------------------------------------------------------------
 
@@ -105,6 +105,17 @@ void SoundManager::SetAudioEnabled(const bool enabled)
 
 ///------------------------------------------------------------------------------------------------
 
+MixerStats SoundManager::GetMixerStats() const
+{
+#if defined(SOFTWARE_MIXER_BACKEND)
+    return PLATFORM_CALL(GetMixerStats());
+#else
+    return MixerStats();
+#endif
+}
+
+///------------------------------------------------------------------------------------------------
+
 }
 
 ///------------------------------------------------------------------------------------------------
@@ -11,6 +11,7 @@
 ///------------------------------------------------------------------------------------------------
 
 #include <engine/CoreSystemsEngine.h>
+#include <engine/sound/SoftwareMixer.h>
 #include <engine/utils/StringUtils.h>
 
 ///------------------------------------------------------------------------------------------------
@@ -41,6 +42,9 @@ public:
     void PauseAudio();
     void SetAudioEnabled(const bool enabled);
     
+    // Only the software mixer backend (i.e. non Apple platforms) reports anything
+    [[nodiscard]] MixerStats GetMixerStats() const;
+    
 private:
     SoundManager();
 };
@@ -0,0 +1,579 @@
+///------------------------------------------------------------------------------------------------
+///  AllocationTracking.cpp
+///  Predators
+///
+///  Created by Alex Koukoulas on 02/05/2024
+///------------------------------------------------------------------------------------------------
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <engine/utils/AllocationTracking.h>
+#include <new>
+
+#if defined(ALLOCATION_TRACKING)
+#if defined(_MSC_VER)
+#include <intrin.h>
+#include <malloc.h>
+#define ALLOCATION_CALL_SITE() _ReturnAddress()
+#else
+#define ALLOCATION_CALL_SITE() __builtin_return_address(0)
+#endif
+#endif
+
+///------------------------------------------------------------------------------------------------
+
+namespace memory
+{
+
+///------------------------------------------------------------------------------------------------
+
+static constexpr int CALL_SITE_SAMPLE_CAPACITY = 4096;
+
+static const char* ALLOCATION_TAG_NAMES[ALLOCATION_TAG_COUNT] =
+{
+    "Untagged",
+    "Resources",
+    "Audio",
+    "Animation",
+    "Game Logic",
+    "Particles",
+    "Scene Sorting",
+    "Rendering",
+    "Debug Widgets"
+};
+
+///------------------------------------------------------------------------------------------------
+/// Everything below is constant initialized, as allocations can happen before (and after) any
+/// dynamic initialization of this translation unit.
+struct alignas(64) TagCounters
+{
+    std::atomic<std::int64_t> mAllocationCount{0};
+    std::atomic<std::int64_t> mAllocatedBytes{0};
+    std::atomic<std::int64_t> mDeallocationCount{0};
+};
+
+struct CallSiteSampleSlot
+{
+    std::atomic<const void*> mCallSite{nullptr};
+    std::atomic<const char*> mLabel{nullptr};
+    std::atomic<std::size_t> mSize{0};
+    std::atomic<int> mAllocationTag{0};
+};
+
+struct ThreadState
+{
+    AllocationCounters mCounters;
+    AllocationTag mAllocationTag = AllocationTag::UNTAGGED;
+    const char* mLabel = nullptr;
+    int mSamplingCountdown = 0;
+};
+
+static std::atomic<bool> sTrackingEnabled(false);
+static std::atomic<int> sCallSiteSamplingInterval(0);
+static TagCounters sTagCounters[ALLOCATION_TAG_COUNT];
+static CallSiteSampleSlot sCallSiteSampleSlots[CALL_SITE_SAMPLE_CAPACITY];
+static std::atomic<std::uint64_t> sNextCallSiteSampleIndex(0);
+static thread_local ThreadState sThreadState;
+
+// Main thread only
+static FrameAllocationStats sLastFrameAllocationStats;
+static std::array<AllocationCounters, ALLOCATION_TAG_COUNT> sFrameStartCounters;
+static std::int64_t sFrameAllocationBudget = 0;
+
+///------------------------------------------------------------------------------------------------
+
+#if defined(ALLOCATION_TRACKING)
+static void RecordAllocation(const std::size_t size, const void* callSite)
+{
+    auto& threadState = sThreadState;
+    threadState.mCounters.mAllocationCount++;
+    threadState.mCounters.mAllocatedBytes += static_cast<std::int64_t>(size);
+    
+    if (!sTrackingEnabled.load(std::memory_order_relaxed))
+    {
+        return;
+    }
+    
+    auto& tagCounters = sTagCounters[static_cast<int>(threadState.mAllocationTag)];
+    tagCounters.mAllocationCount.fetch_add(1, std::memory_order_relaxed);
+    tagCounters.mAllocatedBytes.fetch_add(static_cast<std::int64_t>(size), std::memory_order_relaxed);
+    
+    const auto callSiteSamplingInterval = sCallSiteSamplingInterval.load(std::memory_order_relaxed);
+    if (callSiteSamplingInterval > 0 && --threadState.mSamplingCountdown <= 0)
+    {
+        threadState.mSamplingCountdown = callSiteSamplingInterval;
+        
+        auto& sampleSlot = sCallSiteSampleSlots[sNextCallSiteSampleIndex.fetch_add(1, std::memory_order_relaxed) % CALL_SITE_SAMPLE_CAPACITY];
+        sampleSlot.mCallSite.store(callSite, std::memory_order_relaxed);
+        sampleSlot.mLabel.store(threadState.mLabel, std::memory_order_relaxed);
+        sampleSlot.mSize.store(size, std::memory_order_relaxed);
+        sampleSlot.mAllocationTag.store(static_cast<int>(threadState.mAllocationTag), std::memory_order_relaxed);
+    }
+}
+
+///------------------------------------------------------------------------------------------------
+
+static void RecordDeallocation(const void* block)
+{
+    if (!block)
+    {
+        return;
+    }
+    
+    auto& threadState = sThreadState;
+    threadState.mCounters.mDeallocationCount++;
+    
+    if (sTrackingEnabled.load(std::memory_order_relaxed))
+    {
+        sTagCounters[static_cast<int>(threadState.mAllocationTag)].mDeallocationCount.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+#endif
+
+///------------------------------------------------------------------------------------------------
+
+static AllocationCounters operator - (const AllocationCounters& lhs, const AllocationCounters& rhs)
+{
+    AllocationCounters result;
+    result.mAllocationCount = lhs.mAllocationCount - rhs.mAllocationCount;
+    result.mAllocatedBytes = lhs.mAllocatedBytes - rhs.mAllocatedBytes;
+    result.mDeallocationCount = lhs.mDeallocationCount - rhs.mDeallocationCount;
+    return result;
+}
+
+///------------------------------------------------------------------------------------------------
+
+const char* GetAllocationTagName(const AllocationTag allocationTag)
+{
+    return ALLOCATION_TAG_NAMES[static_cast<int>(allocationTag)];
+}
+
+///------------------------------------------------------------------------------------------------
+
+AllocationCounters GetThreadAllocationCounters()
+{
+    return sThreadState.mCounters;
+}
+
+///------------------------------------------------------------------------------------------------
+
+void SetAllocationTrackingEnabled(const bool enabled)
+{
+#if defined(ALLOCATION_TRACKING)
+    sTrackingEnabled.store(enabled, std::memory_order_relaxed);
+#else
+    (void)enabled;
+#endif
+}
+
+///------------------------------------------------------------------------------------------------
+
+bool IsAllocationTrackingEnabled()
+{
+    return sTrackingEnabled.load(std::memory_order_relaxed);
+}
+
+///------------------------------------------------------------------------------------------------
+
+AllocationCounters GetAllocationCounters()
+{
+    AllocationCounters counters;
+    for (int i = 0; i < ALLOCATION_TAG_COUNT; ++i)
+    {
+        const auto tagCounters = GetAllocationCounters(static_cast<AllocationTag>(i));
+        counters.mAllocationCount += tagCounters.mAllocationCount;
+        counters.mAllocatedBytes += tagCounters.mAllocatedBytes;
+        counters.mDeallocationCount += tagCounters.mDeallocationCount;
+    }
+    return counters;
+}
+
+///------------------------------------------------------------------------------------------------
+
+AllocationCounters GetAllocationCounters(const AllocationTag allocationTag)
+{
+    const auto& tagCounters = sTagCounters[static_cast<int>(allocationTag)];
+    
+    AllocationCounters counters;
+    counters.mAllocationCount = tagCounters.mAllocationCount.load(std::memory_order_relaxed);
+    counters.mAllocatedBytes = tagCounters.mAllocatedBytes.load(std::memory_order_relaxed);
+    counters.mDeallocationCount = tagCounters.mDeallocationCount.load(std::memory_order_relaxed);
+    return counters;
+}
+
+///------------------------------------------------------------------------------------------------
+
+#if defined(ALLOCATION_TRACKING)
+AllocationScope::AllocationScope(const AllocationTag allocationTag, const char* label /* = nullptr */)
+    : mPreviousAllocationTag(sThreadState.mAllocationTag)
+    , mPreviousLabel(sThreadState.mLabel)
+{
+    sThreadState.mAllocationTag = allocationTag;
+    sThreadState.mLabel = label;
+}
+
+///------------------------------------------------------------------------------------------------
+
+AllocationScope::AllocationScope(const char* label)
+    : AllocationScope(sThreadState.mAllocationTag, label)
+{
+}
+
+///------------------------------------------------------------------------------------------------
+
+AllocationScope::~AllocationScope()
+{
+    sThreadState.mAllocationTag = mPreviousAllocationTag;
+    sThreadState.mLabel = mPreviousLabel;
+}
+#else
+AllocationScope::AllocationScope(const AllocationTag, const char* /* = nullptr */)
+    : mPreviousAllocationTag(AllocationTag::UNTAGGED)
+    , mPreviousLabel(nullptr)
+{
+}
+
+///------------------------------------------------------------------------------------------------
+
+AllocationScope::AllocationScope(const char*)
+    : AllocationScope(AllocationTag::UNTAGGED)
+{
+}
+
+///------------------------------------------------------------------------------------------------
+
+AllocationScope::~AllocationScope()
+{
+}
+#endif
+
+///------------------------------------------------------------------------------------------------
+
+AllocationTag GetCurrentAllocationTag()
+{
+    return sThreadState.mAllocationTag;
+}
+
+///------------------------------------------------------------------------------------------------
+
+const char* GetCurrentAllocationLabel()
+{
+    return sThreadState.mLabel;
+}
+
+///------------------------------------------------------------------------------------------------
+
+void EndAllocationFrame()
+{
+    // Counters don't move while tracking is disabled, so the frame start snapshot stays valid.
+    // Never enabled in builds without ALLOCATION_TRACKING.
+    if (!IsAllocationTrackingEnabled())
+    {
+        return;
+    }
+    
+    sLastFrameAllocationStats.mTotal = AllocationCounters();
+    for (int i = 0; i < ALLOCATION_TAG_COUNT; ++i)
+    {
+        const auto tagCounters = GetAllocationCounters(static_cast<AllocationTag>(i));
+        const auto tagFrameCounters = tagCounters - sFrameStartCounters[i];
+        sFrameStartCounters[i] = tagCounters;
+        
+        sLastFrameAllocationStats.mPerTag[i] = tagFrameCounters;
+        sLastFrameAllocationStats.mTotal.mAllocationCount += tagFrameCounters.mAllocationCount;
+        sLastFrameAllocationStats.mTotal.mAllocatedBytes += tagFrameCounters.mAllocatedBytes;
+        sLastFrameAllocationStats.mTotal.mDeallocationCount += tagFrameCounters.mDeallocationCount;
+    }
+    
+    if (sFrameAllocationBudget > 0 && sLastFrameAllocationStats.mTotal.mAllocationCount > sFrameAllocationBudget)
+    {
+        sLastFrameAllocationStats.mOverBudgetFrameCount++;
+    }
+}
+
+///------------------------------------------------------------------------------------------------
+
+const FrameAllocationStats& GetLastFrameAllocationStats()
+{
+    return sLastFrameAllocationStats;
+}
+
+///------------------------------------------------------------------------------------------------
+
+void SetFrameAllocationBudget(const std::int64_t maxAllocationsPerFrame)
+{
+    sFrameAllocationBudget = maxAllocationsPerFrame;
+}
+
+///------------------------------------------------------------------------------------------------
+
+std::int64_t GetFrameAllocationBudget()
+{
+    return sFrameAllocationBudget;
+}
+
+///------------------------------------------------------------------------------------------------
+
+void SetCallSiteSamplingInterval(const int samplingInterval)
+{
+    sCallSiteSamplingInterval.store(std::max(0, samplingInterval), std::memory_order_relaxed);
+}
+
+///------------------------------------------------------------------------------------------------
+
+int GetCallSiteSamplingInterval()
+{
+    return sCallSiteSamplingInterval.load(std::memory_order_relaxed);
+}
+
+///------------------------------------------------------------------------------------------------
+
+std::vector<CallSiteSample> GetCallSiteSamples()
+{
+    const auto nextSampleIndex = sNextCallSiteSampleIndex.load(std::memory_order_relaxed);
+    const auto sampleCount = std::min<std::uint64_t>(nextSampleIndex, CALL_SITE_SAMPLE_CAPACITY);
+    
+    std::vector<CallSiteSample> callSiteSamples;
+    callSiteSamples.reserve(static_cast<std::size_t>(sampleCount));
+    for (auto sampleIndex = nextSampleIndex - sampleCount; sampleIndex < nextSampleIndex; ++sampleIndex)
+    {
+        const auto& sampleSlot = sCallSiteSampleSlots[sampleIndex % CALL_SITE_SAMPLE_CAPACITY];
+        callSiteSamples.push_back({ sampleSlot.mCallSite.load(std::memory_order_relaxed), sampleSlot.mLabel.load(std::memory_order_relaxed), sampleSlot.mSize.load(std::memory_order_relaxed), static_cast<AllocationTag>(sampleSlot.mAllocationTag.load(std::memory_order_relaxed)) });
+    }
+    return callSiteSamples;
+}
+
+///------------------------------------------------------------------------------------------------
+
+void ClearCallSiteSamples()
+{
+    sNextCallSiteSampleIndex.store(0, std::memory_order_relaxed);
+}
+
+///------------------------------------------------------------------------------------------------
+
+ThreadAllocationCounter::ThreadAllocationCounter()
+    : mStartCounters(GetThreadAllocationCounters())
+{
+}
+
+///------------------------------------------------------------------------------------------------
+
+AllocationCounters ThreadAllocationCounter::GetCounters() const
+{
+    return GetThreadAllocationCounters() - mStartCounters;
+}
+
+///------------------------------------------------------------------------------------------------
+
+#if defined(ALLOCATION_TRACKING)
+static void* AllocateBlock(std::size_t size)
+{
+    size = std::max<std::size_t>(size, 1);
+    while (true)
+    {
+        if (auto* block = std::malloc(size))
+        {
+            return block;
+        }
+        
+        auto newHandler = std::get_new_handler();
+        if (!newHandler)
+        {
+            return nullptr;
+        }
+        newHandler();
+    }
+}
+
+///------------------------------------------------------------------------------------------------
+
+static void* AllocateAlignedBlock(std::size_t size, const std::align_val_t alignment)
+{
+    size = std::max<std::size_t>(size, 1);
+    while (true)
+    {
+#if defined(_MSC_VER)
+        auto* block = _aligned_malloc(size, static_cast<std::size_t>(alignment));
+#else
+        void* block = nullptr;
+        if (posix_memalign(&block, std::max(static_cast<std::size_t>(alignment), sizeof(void*)), size) != 0)
+        {
+            block = nullptr;
+        }
+#endif
+        if (block)
+        {
+            return block;
+        }
+        
+        auto newHandler = std::get_new_handler();
+        if (!newHandler)
+        {
+            return nullptr;
+        }
+        newHandler();
+    }
+}
+
+///------------------------------------------------------------------------------------------------
+
+static void FreeAlignedBlock(void* block)
+{
+#if defined(_MSC_VER)
+    _aligned_free(block);
+#else
+    std::free(block);
+#endif
+}
+#endif
+
+///------------------------------------------------------------------------------------------------
+
+}
+
+///------------------------------------------------------------------------------------------------
+/// Global allocation function replacements, all funneling into the above. Only compiled into
+/// ALLOCATION_TRACKING builds (debug and test), release builds keep the default allocator.
+
+#if defined(ALLOCATION_TRACKING)
+
+void* operator new(std::size_t size)
+{
+    memory::RecordAllocation(size, ALLOCATION_CALL_SITE());
+    if (auto* block = memory::AllocateBlock(size))
+    {
+        return block;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size)
+{
+    memory::RecordAllocation(size, ALLOCATION_CALL_SITE());
+    if (auto* block = memory::AllocateBlock(size))
+    {
+        return block;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+    memory::RecordAllocation(size, ALLOCATION_CALL_SITE());
+    return memory::AllocateBlock(size);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept
+{
+    memory::RecordAllocation(size, ALLOCATION_CALL_SITE());
+    return memory::AllocateBlock(size);
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment)
+{
+    memory::RecordAllocation(size, ALLOCATION_CALL_SITE());
+    if (auto* block = memory::AllocateAlignedBlock(size, alignment))
+    {
+        return block;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment)
+{
+    memory::RecordAllocation(size, ALLOCATION_CALL_SITE());
+    if (auto* block = memory::AllocateAlignedBlock(size, alignment))
+    {
+        return block;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+    memory::RecordAllocation(size, ALLOCATION_CALL_SITE());
+    return memory::AllocateAlignedBlock(size, alignment);
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+    memory::RecordAllocation(size, ALLOCATION_CALL_SITE());
+    return memory::AllocateAlignedBlock(size, alignment);
+}
+
+void operator delete(void* block) noexcept
+{
+    memory::RecordDeallocation(block);
+    std::free(block);
+}
+
+void operator delete[](void* block) noexcept
+{
+    memory::RecordDeallocation(block);
+    std::free(block);
+}
+
+void operator delete(void* block, std::size_t) noexcept
+{
+    memory::RecordDeallocation(block);
+    std::free(block);
+}
+
+void operator delete[](void* block, std::size_t) noexcept
+{
+    memory::RecordDeallocation(block);
+    std::free(block);
+}
+
+void operator delete(void* block, const std::nothrow_t&) noexcept
+{
+    memory::RecordDeallocation(block);
+    std::free(block);
+}
+
+void operator delete[](void* block, const std::nothrow_t&) noexcept
+{
+    memory::RecordDeallocation(block);
+    std::free(block);
+}
+
+void operator delete(void* block, std::align_val_t) noexcept
+{
+    memory::RecordDeallocation(block);
+    memory::FreeAlignedBlock(block);
+}
+
+void operator delete[](void* block, std::align_val_t) noexcept
+{
+    memory::RecordDeallocation(block);
+    memory::FreeAlignedBlock(block);
+}
+
+void operator delete(void* block, std::size_t, std::align_val_t) noexcept
+{
+    memory::RecordDeallocation(block);
+    memory::FreeAlignedBlock(block);
+}
+
+void operator delete[](void* block, std::size_t, std::align_val_t) noexcept
+{
+    memory::RecordDeallocation(block);
+    memory::FreeAlignedBlock(block);
+}
+
+void operator delete(void* block, std::align_val_t, const std::nothrow_t&) noexcept
+{
+    memory::RecordDeallocation(block);
+    memory::FreeAlignedBlock(block);
+}
+
+void operator delete[](void* block, std::align_val_t, const std::nothrow_t&) noexcept
+{
+    memory::RecordDeallocation(block);
+    memory::FreeAlignedBlock(block);
+}
+#endif
+
+///------------------------------------------------------------------------------------------------
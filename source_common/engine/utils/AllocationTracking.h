@@ -0,0 +1,148 @@
+///------------------------------------------------------------------------------------------------
+///  AllocationTracking.h
+///  Predators
+///
+///  Created by Alex Koukoulas on 02/05/2024
+///------------------------------------------------------------------------------------------------
+
+#ifndef AllocationTracking_h
+#define AllocationTracking_h
+
+///------------------------------------------------------------------------------------------------
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+///------------------------------------------------------------------------------------------------
+
+namespace memory
+{
+
+///------------------------------------------------------------------------------------------------
+/// Subsystem that heap allocations are attributed to, i.e. that of the innermost AllocationScope
+/// of the allocating thread. Jobs inherit the scope they were submitted from.
+/// Counting relies on replacing the global operator new/delete, which is only done in builds
+/// defining ALLOCATION_TRACKING (debug and test). Elsewhere nothing is counted, tracking can't be
+/// enabled and scopes/frames are no-ops.
+enum class AllocationTag
+{
+    UNTAGGED,
+    RESOURCES,
+    AUDIO,
+    ANIMATION,
+    GAME_LOGIC,
+    PARTICLES,
+    SCENE_SORTING,
+    RENDERING,
+    DEBUG_WIDGETS,
+    COUNT
+};
+
+inline constexpr int ALLOCATION_TAG_COUNT = static_cast<int>(AllocationTag::COUNT);
+
+[[nodiscard]] const char* GetAllocationTagName(const AllocationTag allocationTag);
+
+///------------------------------------------------------------------------------------------------
+
+struct AllocationCounters
+{
+    std::int64_t mAllocationCount = 0;
+    std::int64_t mAllocatedBytes = 0;
+    std::int64_t mDeallocationCount = 0;
+};
+
+///------------------------------------------------------------------------------------------------
+/// The calling thread's allocations since it started. Always counted in ALLOCATION_TRACKING builds
+/// (in plain thread locals), whether tracking is enabled or not.
+[[nodiscard]] AllocationCounters GetThreadAllocationCounters();
+
+///------------------------------------------------------------------------------------------------
+/// Process wide, per tag tracking is off by default. While off, an allocation only costs the
+/// thread local counter increments and a single relaxed atomic load.
+void SetAllocationTrackingEnabled(const bool enabled);
+[[nodiscard]] bool IsAllocationTrackingEnabled();
+
+[[nodiscard]] AllocationCounters GetAllocationCounters();
+[[nodiscard]] AllocationCounters GetAllocationCounters(const AllocationTag allocationTag);
+
+///------------------------------------------------------------------------------------------------
+/// Attributes the calling thread's allocations to the given tag (and optional label, e.g. the
+/// function name) for the scope's lifetime.
+/// @param[in] label must outlive the tracker (string literals etc.)
+class AllocationScope final
+{
+public:
+    explicit AllocationScope(const AllocationTag allocationTag, const char* label = nullptr);
+    
+    // Keeps the current tag, only labelling the scope's allocations
+    explicit AllocationScope(const char* label);
+    ~AllocationScope();
+    
+    AllocationScope(const AllocationScope&) = delete;
+    AllocationScope& operator = (const AllocationScope&) = delete;
+    
+private:
+    const AllocationTag mPreviousAllocationTag;
+    const char* mPreviousLabel;
+};
+
+[[nodiscard]] AllocationTag GetCurrentAllocationTag();
+[[nodiscard]] const char* GetCurrentAllocationLabel();
+
+///------------------------------------------------------------------------------------------------
+/// Per frame deltas of the process wide counters, taken at each EndAllocationFrame (called once
+/// per frame by the main loop). Frames making more allocations than the budget (if any) are counted.
+struct FrameAllocationStats
+{
+    AllocationCounters mTotal;
+    std::array<AllocationCounters, ALLOCATION_TAG_COUNT> mPerTag;
+    std::int64_t mOverBudgetFrameCount = 0;
+};
+
+void EndAllocationFrame();
+[[nodiscard]] const FrameAllocationStats& GetLastFrameAllocationStats();
+
+void SetFrameAllocationBudget(const std::int64_t maxAllocationsPerFrame);
+[[nodiscard]] std::int64_t GetFrameAllocationBudget();
+
+///------------------------------------------------------------------------------------------------
+/// While tracking is enabled, every samplingInterval-th allocation of each thread records its call
+/// site (return address), size, tag and label into a fixed size ring. 0 disables sampling.
+struct CallSiteSample
+{
+    const void* mCallSite;
+    const char* mLabel;
+    std::size_t mSize;
+    AllocationTag mAllocationTag;
+};
+
+void SetCallSiteSamplingInterval(const int samplingInterval);
+[[nodiscard]] int GetCallSiteSamplingInterval();
+
+// Copies the currently held samples, oldest first. Allocates, so best kept out of measured scopes.
+[[nodiscard]] std::vector<CallSiteSample> GetCallSiteSamples();
+void ClearCallSiteSamples();
+
+///------------------------------------------------------------------------------------------------
+/// Counts the calling thread's allocations from construction on, e.g. for tests to assert that a
+/// block of code doesn't allocate.
+class ThreadAllocationCounter final
+{
+public:
+    ThreadAllocationCounter();
+    
+    [[nodiscard]] AllocationCounters GetCounters() const;
+    
+private:
+    const AllocationCounters mStartCounters;
+};
+
+///------------------------------------------------------------------------------------------------
+
+}
+
+///------------------------------------------------------------------------------------------------
+
+#endif /* AllocationTracking_h */
@@ -7,6 +7,7 @@
 
 #include <engine/resloading/ResourceLoadingService.h>
 #include <engine/utils/BaseDataFileDeserializer.h>
+#include <engine/utils/BaseDataFileSerializer.h>
 #include <engine/utils/OSMessageBox.h>
 #include <engine/utils/Logging.h>
 #include <engine/utils/PlatformMacros.h>
@@ -27,67 +28,133 @@ namespace serial
 
 ///------------------------------------------------------------------------------------------------
 
-template<class T>
-bool ValidateChecksum(T& contentsContainer)
+static bool DeserializeBinaryDataFileContents(const std::string& fileContents, const CheckSumValidationBehavior checkSumValidationBehavior, nlohmann::json& outState)
 {
-    std::string checkSumString;
+    if (fileContents.size() < BINARY_DATA_FILE_HEADER_SIZE || fileContents.compare(0, sizeof(BINARY_DATA_FILE_MAGIC), BINARY_DATA_FILE_MAGIC, sizeof(BINARY_DATA_FILE_MAGIC)) != 0)
+    {
+        return false;
+    }
+    
+    auto readPosition = sizeof(BINARY_DATA_FILE_MAGIC);
+    if (static_cast<uint8_t>(fileContents[readPosition++]) != BINARY_DATA_FILE_VERSION)
+    {
+        return false;
+    }
+    
+    uint32_t fileCrc = 0;
+    for (int i = 0; i < 4; ++i)
+    {
+        fileCrc |= static_cast<uint32_t>(static_cast<uint8_t>(fileContents[readPosition++])) << (i * 8);
+    }
+    
+    const auto* payload = reinterpret_cast<const uint8_t*>(fileContents.data()) + readPosition;
+    const auto payloadSize = fileContents.size() - readPosition;
     
-    if (!contentsContainer.empty() && contentsContainer.back() == '\n')
+    if (checkSumValidationBehavior == CheckSumValidationBehavior::VALIDATE_CHECKSUM && ComputeCrc32(payload, payloadSize) != fileCrc)
     {
-        contentsContainer.pop_back();
+        return false;
     }
     
-    while (!contentsContainer.empty())
+    outState = nlohmann::json::from_msgpack(payload, payload + payloadSize, true, false);
+    return !outState.is_discarded();
+}
+
+///------------------------------------------------------------------------------------------------
+
+static bool DeserializeJsonDataFileContents(const std::string& fileContents, const CheckSumValidationBehavior checkSumValidationBehavior, nlohmann::json& outState)
+{
+    if (checkSumValidationBehavior == CheckSumValidationBehavior::SKIP_CHECKSUM_VALIDATION)
     {
-        if (contentsContainer.back() == '&')
+        if (fileContents.size() > 1)
         {
-            break;
+            outState = nlohmann::json::parse(fileContents);
         }
-        checkSumString = char(contentsContainer.back()) + checkSumString;
-        contentsContainer.pop_back();
+        return true;
     }
     
-    if (contentsContainer.empty())
+    auto contentsEnd = fileContents.size();
+    if (contentsEnd > 0 && fileContents[contentsEnd - 1] == '\n')
+    {
+        contentsEnd--;
+    }
+    
+    auto checksumSeparatorPosition = fileContents.rfind('&', contentsEnd == 0 ? 0 : contentsEnd - 1);
+    if (checksumSeparatorPosition == std::string::npos || checksumSeparatorPosition == 0)
     {
         return false;
     }
     
-    contentsContainer.pop_back();
+    auto checksumString = fileContents.substr(checksumSeparatorPosition + 1, contentsEnd - checksumSeparatorPosition - 1);
+    auto contents = fileContents.substr(0, checksumSeparatorPosition);
     
-    if (contentsContainer.empty())
+    // Data files are written with the checksum of the exact json text preceding it, so
+    // the common case only needs hashing the raw contents and a single parse.
+    if (checksumString == std::to_string(strutils::GetStringHash(contents)))
+    {
+        if (contents.size() > 1)
+        {
+            outState = nlohmann::json::parse(contents);
+        }
+        return true;
+    }
+    
+    // Otherwise fall back to checking against the canonical formatting (e.g. for files
+    // whose whitespace has been altered in transit)
+    auto parsedContents = nlohmann::json::parse(contents, nullptr, false);
+    if (parsedContents.is_discarded() || checksumString != std::to_string(strutils::GetStringHash(parsedContents.dump(4))))
     {
         return false;
     }
     
-    if (checkSumString == std::to_string(strutils::StringId(nlohmann::json::parse(contentsContainer).dump(4)).GetStringId()))
+    outState = std::move(parsedContents);
+    return true;
+}
+
+///------------------------------------------------------------------------------------------------
+
+bool DeserializeDataFileContents(const std::string& fileContents, const DataFileFormat dataFileFormat, const CheckSumValidationBehavior checkSumValidationBehavior, nlohmann::json& outState)
+{
+    if (dataFileFormat == DataFileFormat::BINARY)
     {
-        return true;
+        return DeserializeBinaryDataFileContents(fileContents, checkSumValidationBehavior, outState);
     }
     
-    return false;
+    return DeserializeJsonDataFileContents(fileContents, checkSumValidationBehavior, outState);
 }
 
 ///------------------------------------------------------------------------------------------------
 
-BaseDataFileDeserializer::BaseDataFileDeserializer(const std::string& fileNameWithoutExtension, const DataFileType& dataFileType, const WarnOnFileNotFoundBehavior warnOnFnFBehavior, const CheckSumValidationBehavior checkSumValidationBehavior)
+BaseDataFileDeserializer::BaseDataFileDeserializer(const std::string& fileNameWithoutExtension, const DataFileType& dataFileType, const WarnOnFileNotFoundBehavior warnOnFnFBehavior, const CheckSumValidationBehavior checkSumValidationBehavior, const DataFileFormat dataFileFormat /* = DataFileFormat::JSON */)
 {
-    std::string dataFileExtension = ".json";
+    // Make sure we don't read back a data file that the background writer has not yet replaced
+    BaseDataFileSerializer::WaitForPendingWrites();
     
 #if defined(MACOS) || defined(MOBILE_FLOW)
-    auto filePath = (dataFileType == DataFileType::PERSISTENCE_FILE_TYPE ? apple_utils::GetPersistentDataDirectoryPath() : resources::ResourceLoadingService::RES_DATA_ROOT) + fileNameWithoutExtension + dataFileExtension;
+    auto filePathWithoutExtension = (dataFileType == DataFileType::PERSISTENCE_FILE_TYPE ? apple_utils::GetPersistentDataDirectoryPath() : resources::ResourceLoadingService::RES_DATA_ROOT) + fileNameWithoutExtension;
 #elif defined(WINDOWS)
-    auto filePath = (dataFileType == DataFileType::PERSISTENCE_FILE_TYPE ? windows_utils::GetPersistentDataDirectoryPath() : resources::ResourceLoadingService::RES_DATA_ROOT) + fileNameWithoutExtension + dataFileExtension;
+    auto filePathWithoutExtension = (dataFileType == DataFileType::PERSISTENCE_FILE_TYPE ? windows_utils::GetPersistentDataDirectoryPath() : resources::ResourceLoadingService::RES_DATA_ROOT) + fileNameWithoutExtension;
 #endif
     
-    std::ifstream dataFile(filePath);
+    auto fileFormat = dataFileFormat;
+    auto filePath = filePathWithoutExtension + GetDataFileExtension(fileFormat);
+    std::ifstream dataFile(filePath, fileFormat == DataFileFormat::BINARY ? std::ios::in | std::ios::binary : std::ios::in);
+    
+    if (!dataFile.is_open())
+    {
+        fileFormat = fileFormat == DataFileFormat::BINARY ? DataFileFormat::JSON : DataFileFormat::BINARY;
+        filePath = filePathWithoutExtension + GetDataFileExtension(fileFormat);
+        dataFile.open(filePath, fileFormat == DataFileFormat::BINARY ? std::ios::in | std::ios::binary : std::ios::in);
+    }
+    
     if (dataFile.is_open())
     {
         std::stringstream buffer;
         buffer << dataFile.rdbuf();
-        auto contents = buffer.str();
         
-        if (checkSumValidationBehavior == CheckSumValidationBehavior::VALIDATE_CHECKSUM && !ValidateChecksum(contents))
+        if (!DeserializeDataFileContents(buffer.str(), fileFormat, checkSumValidationBehavior, mState))
         {
+            mState = nlohmann::json();
+            
             if (warnOnFnFBehavior == WarnOnFileNotFoundBehavior::WARN)
             {
                 ospopups::ShowMessageBox(ospopups::MessageBoxType::ERROR, "Corrupted file", ("Data File " + filePath + " is corrupted.").c_str());
@@ -95,15 +162,10 @@ BaseDataFileDeserializer::BaseDataFileDeserializer(const std::string& fileNameWi
             
             return;
         }
-        
-        if (contents.size() > 1)
-        {
-            mState = nlohmann::json::parse(contents);
-        }
     }
     else if (warnOnFnFBehavior == WarnOnFileNotFoundBehavior::WARN)
     {
-        ospopups::ShowMessageBox(ospopups::MessageBoxType::ERROR, "File not found", ("Data File " + filePath + " not found.").c_str());
+        ospopups::ShowMessageBox(ospopups::MessageBoxType::ERROR, "File not found", ("Data File " + filePathWithoutExtension + GetDataFileExtension(dataFileFormat) + " not found.").c_str());
     }
             
     dataFile.close();
@@ -37,10 +37,18 @@ enum class CheckSumValidationBehavior
 
 ///------------------------------------------------------------------------------------------------
 
+// Validates (if requested) and decodes the raw bytes of a data file. Returns false
+// if the checksum does not match or the contents could not be decoded.
+bool DeserializeDataFileContents(const std::string& fileContents, const DataFileFormat dataFileFormat, const CheckSumValidationBehavior checkSumValidationBehavior, nlohmann::json& outState);
+
+///------------------------------------------------------------------------------------------------
+
 class BaseDataFileDeserializer
 {
 public:
-    BaseDataFileDeserializer(const std::string& fileNameWithoutExtension, const DataFileType& dataFileType, const WarnOnFileNotFoundBehavior warnOnFnFBehavior, const CheckSumValidationBehavior checkSumValidationBehavior);
+    // If the data file is not found in the requested format, the other format is tried
+    // before giving up (i.e. data files saved prior to a format switch still load).
+    BaseDataFileDeserializer(const std::string& fileNameWithoutExtension, const DataFileType& dataFileType, const WarnOnFileNotFoundBehavior warnOnFnFBehavior, const CheckSumValidationBehavior checkSumValidationBehavior, const DataFileFormat dataFileFormat = DataFileFormat::JSON);
     virtual ~BaseDataFileDeserializer() = default;
     
     const nlohmann::json& GetState() const;
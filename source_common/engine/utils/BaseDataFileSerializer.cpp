@@ -17,7 +17,13 @@
 #elif defined(WINDOWS)
 #include <platform_utilities/WindowsUtils.h>
 #endif
+#include <algorithm>
+#include <condition_variable>
 #include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <thread>
+#include <vector>
 
 ///------------------------------------------------------------------------------------------------
 
@@ -26,66 +32,374 @@ namespace serial
 
 ///------------------------------------------------------------------------------------------------
 
-BaseDataFileSerializer::BaseDataFileSerializer(const std::string& fileNameWithoutExtension, const DataFileType& dataFileType, const DataFileOpeningBehavior fileOpeningBehavior)
+// Top level sections of a state, as of the flush that handed them to the writer
+using StateSections = std::vector<std::pair<std::string, std::shared_ptr<const nlohmann::json>>>;
+
+///------------------------------------------------------------------------------------------------
+
+class DataFileWriterWorker
+{
+public:
+    static DataFileWriterWorker& GetInstance()
+    {
+        static DataFileWriterWorker instance;
+        return instance;
+    }
+    
+    ~DataFileWriterWorker()
+    {
+        // Normally already shut down by the engine, this only catches early exits
+        Shutdown();
+    }
+    
+    void Shutdown()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mShuttingDown = true;
+        }
+        mCondition.notify_all();
+        
+        // Pending writes are drained before the worker exits
+        if (mThread.joinable())
+        {
+            mThread.join();
+        }
+        
+        // Any write queued after this point lazily starts a new worker
+        std::lock_guard<std::mutex> lock(mMutex);
+        mShuttingDown = false;
+    }
+    
+    void QueueWrite(const std::string& filePathWithoutExtension, const DataFileFormat dataFileFormat, StateSections&& stateSections, const bool shouldSyncToCloud)
+    {
+        PendingWrite pendingWrite;
+        pendingWrite.mFilePath = filePathWithoutExtension;
+        pendingWrite.mDataFileFormat = dataFileFormat;
+        pendingWrite.mStateSections = std::move(stateSections);
+        pendingWrite.mShouldSyncToCloud = shouldSyncToCloud;
+        QueuePendingWrite(std::move(pendingWrite));
+    }
+    
+    void QueueRawWrite(const std::string& filePath, std::string&& fileContents)
+    {
+        PendingWrite pendingWrite;
+        pendingWrite.mFilePath = filePath;
+        pendingWrite.mRawFileContents = std::move(fileContents);
+        pendingWrite.mIsRawWrite = true;
+        QueuePendingWrite(std::move(pendingWrite));
+    }
+    
+    void WaitForPendingWrites()
+    {
+        std::unique_lock<std::mutex> lock(mMutex);
+        mCondition.wait(lock, [&]{ return mPendingWrites.empty() && !mIsWriting; });
+    }
+    
+    bool ConsumeCompletedCloudSyncWrites()
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        auto hasCompletedCloudSyncWrites = mHasCompletedCloudSyncWrites;
+        mHasCompletedCloudSyncWrites = false;
+        return hasCompletedCloudSyncWrites;
+    }
+
+private:
+    struct PendingWrite
+    {
+        std::string mFilePath; // Without the extension for data file writes, as that's picked by the data file format
+        DataFileFormat mDataFileFormat = DataFileFormat::JSON;
+        StateSections mStateSections;
+        std::string mRawFileContents;
+        bool mIsRawWrite = false;
+        bool mShouldSyncToCloud = false;
+    };
+    
+    void QueuePendingWrite(PendingWrite&& newPendingWrite)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            
+            if (!mThread.joinable())
+            {
+                mThread = std::thread([&]{ WorkerLoop(); });
+            }
+            
+            auto pendingWriteIter = std::find_if(mPendingWrites.begin(), mPendingWrites.end(), [&](const PendingWrite& pendingWrite){ return pendingWrite.mFilePath == newPendingWrite.mFilePath; });
+            if (pendingWriteIter != mPendingWrites.end())
+            {
+                newPendingWrite.mShouldSyncToCloud |= pendingWriteIter->mShouldSyncToCloud;
+                *pendingWriteIter = std::move(newPendingWrite);
+            }
+            else
+            {
+                mPendingWrites.push_back(std::move(newPendingWrite));
+            }
+        }
+        mCondition.notify_all();
+    }
+    
+    void WorkerLoop()
+    {
+        while (true)
+        {
+            PendingWrite pendingWrite;
+            {
+                std::unique_lock<std::mutex> lock(mMutex);
+                mCondition.wait(lock, [&]{ return !mPendingWrites.empty() || mShuttingDown; });
+                
+                if (mPendingWrites.empty())
+                {
+                    return;
+                }
+                
+                pendingWrite = std::move(mPendingWrites.front());
+                mPendingWrites.erase(mPendingWrites.begin());
+                mIsWriting = true;
+            }
+            
+            if (pendingWrite.mIsRawWrite)
+            {
+                WriteFile(pendingWrite.mFilePath, pendingWrite.mRawFileContents, true);
+            }
+            else
+            {
+                WriteDataFile(pendingWrite.mFilePath, pendingWrite.mDataFileFormat, pendingWrite.mStateSections);
+            }
+            
+            {
+                std::lock_guard<std::mutex> lock(mMutex);
+                mIsWriting = false;
+                
+                // The cloud upload itself is kicked off from the main thread
+                mHasCompletedCloudSyncWrites |= pendingWrite.mShouldSyncToCloud;
+            }
+            mCondition.notify_all();
+        }
+    }
+    
+    static void WriteDataFile(const std::string& filePathWithoutExtension, const DataFileFormat dataFileFormat, const StateSections& stateSections)
+    {
+        auto state = nlohmann::json::object();
+        for (const auto& section: stateSections)
+        {
+            state[section.first] = *section.second;
+        }
+        
+        auto fileContents = SerializeDataFileContents(state, dataFileFormat);
+        if (!WriteFile(filePathWithoutExtension + GetDataFileExtension(dataFileFormat), fileContents, dataFileFormat == DataFileFormat::BINARY))
+        {
+            return;
+        }
+        
+        // A data file left over in the other format (e.g. after switching formats) would otherwise shadow this one on load
+        std::error_code errorCode;
+        auto otherDataFileFormat = dataFileFormat == DataFileFormat::BINARY ? DataFileFormat::JSON : DataFileFormat::BINARY;
+        std::filesystem::remove(filePathWithoutExtension + GetDataFileExtension(otherDataFileFormat), errorCode);
+    }
+    
+    static bool WriteFile(const std::string& filePath, const std::string& fileContents, const bool binary)
+    {
+        // Write to a temp file first and swap it in, so that a crash mid-write
+        // never leaves a truncated file behind.
+        auto tempFilePath = filePath + ".tmp";
+        {
+            std::ofstream file(tempFilePath, binary ? std::ios::out | std::ios::binary : std::ios::out);
+            if (!file.is_open())
+            {
+                LOG(logging::LogType::ERROR, "Could not open %s for writing", tempFilePath.c_str());
+                return false;
+            }
+            
+            file.write(fileContents.data(), fileContents.size());
+            
+            if (!file.good())
+            {
+                LOG(logging::LogType::ERROR, "Failed writing %s", tempFilePath.c_str());
+                return false;
+            }
+        }
+        
+        std::error_code errorCode;
+        std::filesystem::rename(tempFilePath, filePath, errorCode);
+        if (errorCode)
+        {
+            LOG(logging::LogType::ERROR, "Could not replace %s (%s)", filePath.c_str(), errorCode.message().c_str());
+            return false;
+        }
+        
+        return true;
+    }
+
+private:
+    std::mutex mMutex;
+    std::condition_variable mCondition;
+    std::vector<PendingWrite> mPendingWrites;
+    std::thread mThread;
+    bool mIsWriting = false;
+    bool mShuttingDown = false;
+    bool mHasCompletedCloudSyncWrites = false;
+};
+
+///------------------------------------------------------------------------------------------------
+
+std::string SerializeDataFileContents(const nlohmann::json& state, const DataFileFormat dataFileFormat)
+{
+    if (dataFileFormat == DataFileFormat::BINARY)
+    {
+        auto payload = nlohmann::json::to_msgpack(state);
+        auto crc = ComputeCrc32(payload.data(), payload.size());
+        
+        std::string fileContents(BINARY_DATA_FILE_MAGIC, sizeof(BINARY_DATA_FILE_MAGIC));
+        fileContents.push_back(static_cast<char>(BINARY_DATA_FILE_VERSION));
+        for (int i = 0; i < 4; ++i)
+        {
+            fileContents.push_back(static_cast<char>((crc >> (i * 8)) & 0xFF));
+        }
+        fileContents.append(payload.begin(), payload.end());
+        return fileContents;
+    }
+    
+    auto fileContents = state.dump(4);
+    auto checksumString = "&" + std::to_string(strutils::GetStringHash(fileContents));
+    return fileContents + checksumString;
+}
+
+///------------------------------------------------------------------------------------------------
+
+BaseDataFileSerializer::BaseDataFileSerializer(const std::string& fileNameWithoutExtension, const DataFileType& dataFileType, const DataFileOpeningBehavior fileOpeningBehavior, const DataFileFormat dataFileFormat /* = DataFileFormat::JSON */)
     : mDataFileType(dataFileType)
+    , mDataFileFormat(dataFileFormat)
+    , mFileNameWithoutExtension(fileNameWithoutExtension)
+    , mIsDirty(true)
 {    
-    std::string dataFileExtension = ".json";
-    mFilename = fileNameWithoutExtension + dataFileExtension;
-    
     if (fileOpeningBehavior == DataFileOpeningBehavior::OPEN_DATA_FILE_ON_CONSTRUCTION)
     {
-        OpenDataFile();
+        ResolveDataFilePath();
+    }
+}
+
+///------------------------------------------------------------------------------------------------
+
+void BaseDataFileSerializer::WaitForPendingWrites()
+{
+    DataFileWriterWorker::GetInstance().WaitForPendingWrites();
+}
+
+///------------------------------------------------------------------------------------------------
+
+void BaseDataFileSerializer::Update()
+{
+    if (!DataFileWriterWorker::GetInstance().ConsumeCompletedCloudSyncWrites())
+    {
+        return;
     }
+    
+#if defined(MACOS) || defined(MOBILE_FLOW)
+    cloudkit_utils::SavePlayerProgress();
+#endif
+}
+
+///------------------------------------------------------------------------------------------------
+
+void BaseDataFileSerializer::Shutdown()
+{
+    DataFileWriterWorker::GetInstance().Shutdown();
+    Update();
+}
+
+///------------------------------------------------------------------------------------------------
+
+void BaseDataFileSerializer::QueueFileWrite(const std::string& filePath, std::string&& fileContents)
+{
+    DataFileWriterWorker::GetInstance().QueueRawWrite(filePath, std::move(fileContents));
 }
 
 ///------------------------------------------------------------------------------------------------
 
 void BaseDataFileSerializer::FlushStateToFile()
 {
-    OpenDataFile();
+    if (!mIsDirty)
+    {
+        return;
+    }
+    
+    ResolveDataFilePath();
     
     auto duration = std::chrono::system_clock::now().time_since_epoch();
     auto secsSinceEpoch = std::chrono::duration_cast<std::chrono::seconds>(duration).count();
     
-    mState["timestamp"] = secsSinceEpoch;
+    GetMutableStateSection("timestamp") = secsSinceEpoch;
 #if defined(MACOS) || defined(MOBILE_FLOW)
-    mState["device_id"] = apple_utils::GetDeviceId();
-    mState["device_name"] = apple_utils::GetDeviceName();
-    mState["app_version"] = apple_utils::GetAppVersion();
+    GetMutableStateSection("device_id") = apple_utils::GetDeviceId();
+    GetMutableStateSection("device_name") = apple_utils::GetDeviceName();
+    GetMutableStateSection("app_version") = apple_utils::GetAppVersion();
 #elif defined(WINDOWS)
 #endif
     
-    if (mFile.is_open())
+    // Only the sections touched since the last flush are copied here, the rest are shared
+    // with previous flushes
+    for (const auto& sectionName: mDirtySections)
     {
-        auto checksumString = "&" + std::to_string(strutils::StringId(mState.dump(4)).GetStringId());
-        
-        mFile << mState.dump(4);
-        mFile << checksumString;
-        
-        mFile.close();
+        auto sectionIter = mState.find(sectionName);
+        if (sectionIter != mState.end())
+        {
+            mSectionSnapshots[sectionName] = std::make_shared<const nlohmann::json>(*sectionIter);
+        }
+        else
+        {
+            mSectionSnapshots.erase(sectionName);
+        }
     }
     
-#if defined(MACOS) || defined(MOBILE_FLOW)
-    if (mDataFileType == DataFileType::PERSISTENCE_FILE_TYPE)
+    if (!mFilePathWithoutExtension.empty())
     {
-        cloudkit_utils::SavePlayerProgress();
+        // Serialization, checksumming and disk I/O all happen on the writer thread
+        DataFileWriterWorker::GetInstance().QueueWrite(mFilePathWithoutExtension, mDataFileFormat, StateSections(mSectionSnapshots.cbegin(), mSectionSnapshots.cend()), mDataFileType == DataFileType::PERSISTENCE_FILE_TYPE);
     }
-#elif defined(WINDOWS)
-#endif
+    
+    mDirtySections.clear();
+    mIsDirty = false;
 }
 
 ///------------------------------------------------------------------------------------------------
 
-nlohmann::json& BaseDataFileSerializer::GetState()
+const nlohmann::json& BaseDataFileSerializer::GetState() const
 {
     return mState;
 }
 
 ///------------------------------------------------------------------------------------------------
 
-void BaseDataFileSerializer::OpenDataFile()
+nlohmann::json& BaseDataFileSerializer::GetMutableStateSection(const std::string& sectionName)
+{
+    mDirtySections.insert(sectionName);
+    mIsDirty = true;
+    return mState[sectionName];
+}
+
+///------------------------------------------------------------------------------------------------
+
+void BaseDataFileSerializer::ClearState()
+{
+    mState.clear();
+    mSectionSnapshots.clear();
+    mDirtySections.clear();
+    mIsDirty = true;
+}
+
+///------------------------------------------------------------------------------------------------
+
+bool BaseDataFileSerializer::IsDirty() const
+{
+    return mIsDirty;
+}
+
+///------------------------------------------------------------------------------------------------
+
+void BaseDataFileSerializer::ResolveDataFilePath()
 {
-    if (!mFile.is_open())
+    if (mFilePathWithoutExtension.empty())
     {
         if (mDataFileType == DataFileType::PERSISTENCE_FILE_TYPE)
         {
@@ -98,11 +412,11 @@ void BaseDataFileSerializer::OpenDataFile()
     #if defined(DESKTOP_FLOW)
             std::filesystem::create_directory(directoryPath);
     #endif
-            mFile.open(directoryPath + mFilename);
+            mFilePathWithoutExtension = directoryPath + mFileNameWithoutExtension;
         }
         else if (mDataFileType == DataFileType::ASSET_FILE_TYPE)
         {
-            mFile.open(resources::ResourceLoadingService::RES_DATA_ROOT + mFilename);
+            mFilePathWithoutExtension = resources::ResourceLoadingService::RES_DATA_ROOT + mFileNameWithoutExtension;
         }
     }
 }
@@ -12,8 +12,11 @@
 
 #include <engine/utils/SerializationDefinitions.h>
 #include <fstream>
+#include <memory>
 #include <nlohmann/json.hpp>
 #include <string>
+#include <unordered_map>
+#include <unordered_set>
 
 ///------------------------------------------------------------------------------------------------
 
@@ -30,26 +33,60 @@ enum class DataFileOpeningBehavior
 
 ///------------------------------------------------------------------------------------------------
 
+// Encodes the state (and its checksum) into the exact bytes that end up in the data file
+std::string SerializeDataFileContents(const nlohmann::json& state, const DataFileFormat dataFileFormat);
+
+///------------------------------------------------------------------------------------------------
+
 class BaseDataFileSerializer
 {
 public:
-    BaseDataFileSerializer(const std::string& fileNameWithoutExtension, const DataFileType& dataFileType, const DataFileOpeningBehavior fileOpeningBehavior);
+    BaseDataFileSerializer(const std::string& fileNameWithoutExtension, const DataFileType& dataFileType, const DataFileOpeningBehavior fileOpeningBehavior, const DataFileFormat dataFileFormat = DataFileFormat::JSON);
     virtual ~BaseDataFileSerializer() = default;
     
+    // Blocks until all data file writes handed to the background writer have hit the disk
+    static void WaitForPendingWrites();
+    
+    // Called once per frame on the main thread. Kicks off the cloud upload of persistence
+    // files whose writes have landed since the last call.
+    static void Update();
+    
+    // Drains and joins the background writer. Needs to run before static destruction.
+    static void Shutdown();
+    
+    // Hands already encoded contents of a non data file (e.g. the binary battle replay) to the
+    // background writer, with the same coalescing and write ordering as data file flushes
+    static void QueueFileWrite(const std::string& filePath, std::string&& fileContents);
+    
+    // Snapshots the sections touched since the last flush and hands the state to the
+    // background writer. Consecutive flushes of the same file that the writer has not
+    // yet picked up are coalesced into the latest one.
     void FlushStateToFile();
     
-    nlohmann::json& GetState();
+    const nlohmann::json& GetState() const;
     
-protected:
-    nlohmann::json mState;
+    // Mutable access to a top level section of the state marks (only) it as dirty
+    nlohmann::json& GetMutableStateSection(const std::string& sectionName);
+    void ClearState();
+    
+    bool IsDirty() const;
     
 private:
-    void OpenDataFile();
+    void ResolveDataFilePath();
     
 private:
+    // Private so that every write goes through GetMutableStateSection() and marks its section as dirty
+    nlohmann::json mState;
+    
+    // Immutable copies of each section as of the last flush, shared with the background writer
+    // so that flushes only copy the sections that changed
+    std::unordered_map<std::string, std::shared_ptr<const nlohmann::json>> mSectionSnapshots;
+    std::unordered_set<std::string> mDirtySections;
     const DataFileType mDataFileType;
-    std::string mFilename;
-    std::ofstream mFile;
+    const DataFileFormat mDataFileFormat;
+    std::string mFileNameWithoutExtension;
+    std::string mFilePathWithoutExtension;
+    bool mIsDirty;
 };
 
 ///------------------------------------------------------------------------------------------------
@@ -0,0 +1,196 @@
+///------------------------------------------------------------------------------------------------
+///  Benchmark.cpp
+///  Predators
+///
+///  Created by Alex Koukoulas on 30/04/2024
+///------------------------------------------------------------------------------------------------
+
+#include <atomic>
+#include <cassert>
+#include <engine/utils/Benchmark.h>
+#include <engine/utils/Logging.h>
+#include <engine/utils/Profiling.h>
+#include <fstream>
+#include <nlohmann/json.hpp>
+
+///------------------------------------------------------------------------------------------------
+
+namespace benchmark
+{
+
+///------------------------------------------------------------------------------------------------
+
+static std::atomic<std::int64_t> sSyncLoadCount(0);
+static std::atomic<std::int64_t> sAsyncLoadJobCount(0);
+static std::atomic<std::int64_t> sLoadedBytes(0);
+static std::atomic<std::int64_t> sShaderCompilationCount(0);
+static std::atomic<std::int64_t> sRenderedFrameCount(0);
+
+///------------------------------------------------------------------------------------------------
+
+static Counters operator - (const Counters& lhs, const Counters& rhs)
+{
+    Counters result;
+    result.mSyncLoadCount = lhs.mSyncLoadCount - rhs.mSyncLoadCount;
+    result.mAsyncLoadJobCount = lhs.mAsyncLoadJobCount - rhs.mAsyncLoadJobCount;
+    result.mLoadedBytes = lhs.mLoadedBytes - rhs.mLoadedBytes;
+    result.mShaderCompilationCount = lhs.mShaderCompilationCount - rhs.mShaderCompilationCount;
+    result.mRenderedFrameCount = lhs.mRenderedFrameCount - rhs.mRenderedFrameCount;
+    return result;
+}
+
+///------------------------------------------------------------------------------------------------
+
+void RecordResourceLoad(const bool async)
+{
+    (async ? sAsyncLoadJobCount : sSyncLoadCount).fetch_add(1, std::memory_order_relaxed);
+}
+
+///------------------------------------------------------------------------------------------------
+
+void RecordLoadedBytes(const std::int64_t byteCount)
+{
+    sLoadedBytes.fetch_add(byteCount, std::memory_order_relaxed);
+}
+
+///------------------------------------------------------------------------------------------------
+
+void RecordShaderCompilation()
+{
+    sShaderCompilationCount.fetch_add(1, std::memory_order_relaxed);
+}
+
+///------------------------------------------------------------------------------------------------
+
+void RecordRenderedFrame()
+{
+    sRenderedFrameCount.fetch_add(1, std::memory_order_relaxed);
+}
+
+///------------------------------------------------------------------------------------------------
+
+Counters GetCounters()
+{
+    Counters counters;
+    counters.mSyncLoadCount = sSyncLoadCount.load(std::memory_order_relaxed);
+    counters.mAsyncLoadJobCount = sAsyncLoadJobCount.load(std::memory_order_relaxed);
+    counters.mLoadedBytes = sLoadedBytes.load(std::memory_order_relaxed);
+    counters.mShaderCompilationCount = sShaderCompilationCount.load(std::memory_order_relaxed);
+    counters.mRenderedFrameCount = sRenderedFrameCount.load(std::memory_order_relaxed);
+    return counters;
+}
+
+///------------------------------------------------------------------------------------------------
+
+void Report::SetMetadata(const std::string& key, const std::string& value)
+{
+    for (auto& metadataEntry: mMetadata)
+    {
+        if (metadataEntry.first == key)
+        {
+            metadataEntry.second = value;
+            return;
+        }
+    }
+    
+    mMetadata.emplace_back(key, value);
+}
+
+///------------------------------------------------------------------------------------------------
+
+void Report::BeginPhase(const std::string& phaseName)
+{
+    if (mPhaseActive)
+    {
+        EndPhase();
+    }
+    
+    mActivePhaseName = phaseName;
+    mActivePhaseStartCounters = GetCounters();
+    mActivePhaseStartNanos = profiling::GetNowNanos();
+    mPhaseActive = true;
+}
+
+///------------------------------------------------------------------------------------------------
+
+void Report::EndPhase()
+{
+    assert(mPhaseActive);
+    
+    const auto phaseDurationNanos = profiling::GetNowNanos() - mActivePhaseStartNanos;
+    mPhaseResults.push_back({mActivePhaseName, phaseDurationNanos/1000000.0, GetCounters() - mActivePhaseStartCounters});
+    mPhaseActive = false;
+    
+    const auto& phaseResult = mPhaseResults.back();
+    LOG(logging::LogType::INFO, "Benchmark phase %s: %.2fms, %d sync loads, %d async load jobs, %d bytes loaded, %d shader compilations, %d frames", phaseResult.mName.c_str(), phaseResult.mWallMillis, static_cast<int>(phaseResult.mCounters.mSyncLoadCount), static_cast<int>(phaseResult.mCounters.mAsyncLoadJobCount), static_cast<int>(phaseResult.mCounters.mLoadedBytes), static_cast<int>(phaseResult.mCounters.mShaderCompilationCount), static_cast<int>(phaseResult.mCounters.mRenderedFrameCount));
+}
+
+///------------------------------------------------------------------------------------------------
+
+bool Report::IsPhaseActive() const
+{
+    return mPhaseActive;
+}
+
+///------------------------------------------------------------------------------------------------
+
+const std::vector<PhaseResult>& Report::GetPhaseResults() const
+{
+    return mPhaseResults;
+}
+
+///------------------------------------------------------------------------------------------------
+
+std::string Report::Serialize() const
+{
+    nlohmann::json report;
+    report["version"] = REPORT_FORMAT_VERSION;
+    
+    report["metadata"] = nlohmann::json::object();
+    for (const auto& metadataEntry: mMetadata)
+    {
+        report["metadata"][metadataEntry.first] = metadataEntry.second;
+    }
+    
+    auto totalWallMillis = 0.0;
+    report["phases"] = nlohmann::json::array();
+    for (const auto& phaseResult: mPhaseResults)
+    {
+        report["phases"].push_back(
+        {
+            {"name", phaseResult.mName},
+            {"wall_millis", phaseResult.mWallMillis},
+            {"sync_loads", phaseResult.mCounters.mSyncLoadCount},
+            {"async_load_jobs", phaseResult.mCounters.mAsyncLoadJobCount},
+            {"loaded_bytes", phaseResult.mCounters.mLoadedBytes},
+            {"shader_compilations", phaseResult.mCounters.mShaderCompilationCount},
+            {"rendered_frames", phaseResult.mCounters.mRenderedFrameCount}
+        });
+        totalWallMillis += phaseResult.mWallMillis;
+    }
+    report["total_wall_millis"] = totalWallMillis;
+    
+    return report.dump(4);
+}
+
+///------------------------------------------------------------------------------------------------
+
+bool Report::WriteToFile(const std::string& filePath) const
+{
+    std::ofstream file(filePath, std::ios::out | std::ios::trunc);
+    if (!file.good())
+    {
+        LOG(logging::LogType::ERROR, "Could not open %s for writing the benchmark report", filePath.c_str());
+        return false;
+    }
+    
+    file << Serialize();
+    LOG(logging::LogType::INFO, "Wrote benchmark report to %s", filePath.c_str());
+    return true;
+}
+
+///------------------------------------------------------------------------------------------------
+
+}
+
+///------------------------------------------------------------------------------------------------
@@ -0,0 +1,86 @@
+///------------------------------------------------------------------------------------------------
+///  Benchmark.h
+///  Predators
+///
+///  Created by Alex Koukoulas on 30/04/2024
+///------------------------------------------------------------------------------------------------
+
+#ifndef Benchmark_h
+#define Benchmark_h
+
+///------------------------------------------------------------------------------------------------
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+///------------------------------------------------------------------------------------------------
+
+namespace benchmark
+{
+
+///------------------------------------------------------------------------------------------------
+/// Process wide work counters. Always on (each record is a single relaxed atomic add) and safe
+/// to record from any thread, e.g. from async loading jobs.
+struct Counters
+{
+    std::int64_t mSyncLoadCount = 0;
+    std::int64_t mAsyncLoadJobCount = 0;
+    std::int64_t mLoadedBytes = 0;
+    std::int64_t mShaderCompilationCount = 0; // Linked programs, i.e. vertex and fragment shader pairs
+    std::int64_t mRenderedFrameCount = 0;
+};
+
+void RecordResourceLoad(const bool async);
+void RecordLoadedBytes(const std::int64_t byteCount);
+void RecordShaderCompilation();
+void RecordRenderedFrame();
+
+[[nodiscard]] Counters GetCounters();
+
+///------------------------------------------------------------------------------------------------
+/// Wall time and counter deltas of a named, consecutive run of work (e.g. a scene transition).
+struct PhaseResult
+{
+    std::string mName;
+    double mWallMillis;
+    Counters mCounters;
+};
+
+///------------------------------------------------------------------------------------------------
+/// Times a sequence of non overlapping phases and serializes them, along with free form
+/// metadata (platform, context mode etc.), as a json report meant to be tracked over time.
+class Report final
+{
+public:
+    static constexpr int REPORT_FORMAT_VERSION = 1;
+    
+    void SetMetadata(const std::string& key, const std::string& value);
+    
+    // Beginning a phase ends the currently active one, if any
+    void BeginPhase(const std::string& phaseName);
+    void EndPhase();
+    
+    [[nodiscard]] bool IsPhaseActive() const;
+    [[nodiscard]] const std::vector<PhaseResult>& GetPhaseResults() const;
+    
+    [[nodiscard]] std::string Serialize() const;
+    bool WriteToFile(const std::string& filePath) const;
+    
+private:
+    std::vector<std::pair<std::string, std::string>> mMetadata;
+    std::vector<PhaseResult> mPhaseResults;
+    std::string mActivePhaseName;
+    std::int64_t mActivePhaseStartNanos = 0;
+    Counters mActivePhaseStartCounters;
+    bool mPhaseActive = false;
+};
+
+///------------------------------------------------------------------------------------------------
+
+}
+
+///------------------------------------------------------------------------------------------------
+
+#endif /* Benchmark_h */
@@ -0,0 +1,130 @@
+///------------------------------------------------------------------------------------------------
+///  BlockPool.cpp
+///  Predators
+///
+///  Created by Alex Koukoulas on 29/04/2024
+///------------------------------------------------------------------------------------------------
+
+#include <engine/utils/BlockPool.h>
+#include <algorithm>
+#include <cassert>
+#include <new>
+
+///------------------------------------------------------------------------------------------------
+
+namespace memory
+{
+
+///------------------------------------------------------------------------------------------------
+
+static std::size_t GetBlockSize(const std::size_t size)
+{
+    return (std::max<std::size_t>(size, 1) + BlockPool::BLOCK_GRANULARITY - 1)/BlockPool::BLOCK_GRANULARITY * BlockPool::BLOCK_GRANULARITY;
+}
+
+///------------------------------------------------------------------------------------------------
+
+BlockPool::BlockPool(const std::size_t chunkSize /* = DEFAULT_CHUNK_SIZE */)
+    : mChunkSize(GetBlockSize(chunkSize))
+    , mChunkCursor(nullptr)
+    , mChunkBytesLeft(0)
+    , mHeapAllocationCount(0)
+    , mLiveBlockCount(0)
+{
+    // Blocks of up to a quarter chunk are pooled, so that at most a quarter of each chunk can go unused
+    mFreeLists.resize(GetBlockSize(mChunkSize/4)/BLOCK_GRANULARITY + 1, nullptr);
+}
+
+///------------------------------------------------------------------------------------------------
+
+BlockPool::~BlockPool()
+{
+    assert(mLiveBlockCount == 0 && "Blocks still in use on pool destruction");
+}
+
+///------------------------------------------------------------------------------------------------
+
+void* BlockPool::Allocate(const std::size_t size, const std::size_t alignment)
+{
+    mLiveBlockCount++;
+    
+    if (!IsPooled(size, alignment))
+    {
+        mHeapAllocationCount++;
+        return ::operator new(size, std::align_val_t(alignment));
+    }
+    
+    const auto blockSize = GetBlockSize(size);
+    auto& freeList = mFreeLists[blockSize/BLOCK_GRANULARITY];
+    if (freeList)
+    {
+        auto* freeBlock = freeList;
+        freeList = freeBlock->mNext;
+        return freeBlock;
+    }
+    
+    // What's left of the current chunk (always less than a pooled block) is just abandoned
+    if (mChunkBytesLeft < blockSize)
+    {
+        mChunks.emplace_back(new std::byte[mChunkSize]);
+        mChunkCursor = mChunks.back().get();
+        mChunkBytesLeft = mChunkSize;
+        mHeapAllocationCount++;
+    }
+    
+    auto* block = mChunkCursor;
+    mChunkCursor += blockSize;
+    mChunkBytesLeft -= blockSize;
+    return block;
+}
+
+///------------------------------------------------------------------------------------------------
+
+void BlockPool::Deallocate(void* block, const std::size_t size, const std::size_t alignment)
+{
+    assert(mLiveBlockCount > 0);
+    mLiveBlockCount--;
+    
+    if (!IsPooled(size, alignment))
+    {
+        ::operator delete(block, std::align_val_t(alignment));
+        return;
+    }
+    
+    auto& freeList = mFreeLists[GetBlockSize(size)/BLOCK_GRANULARITY];
+    freeList = new (block) FreeBlock{freeList};
+}
+
+///------------------------------------------------------------------------------------------------
+
+std::size_t BlockPool::GetHeapAllocationCount() const
+{
+    return mHeapAllocationCount;
+}
+
+///------------------------------------------------------------------------------------------------
+
+std::size_t BlockPool::GetLiveBlockCount() const
+{
+    return mLiveBlockCount;
+}
+
+///------------------------------------------------------------------------------------------------
+
+std::size_t BlockPool::GetChunkCount() const
+{
+    return mChunks.size();
+}
+
+///------------------------------------------------------------------------------------------------
+
+bool BlockPool::IsPooled(const std::size_t size, const std::size_t alignment) const
+{
+    return alignment <= BLOCK_GRANULARITY && GetBlockSize(size)/BLOCK_GRANULARITY < mFreeLists.size();
+}
+
+///------------------------------------------------------------------------------------------------
+
+}
+
+///------------------------------------------------------------------------------------------------
@@ -0,0 +1,117 @@
+///------------------------------------------------------------------------------------------------
+///  BlockPool.h
+///  Predators
+///
+///  Created by Alex Koukoulas on 29/04/2024
+///------------------------------------------------------------------------------------------------
+
+#ifndef BlockPool_h
+#define BlockPool_h
+
+///------------------------------------------------------------------------------------------------
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+///------------------------------------------------------------------------------------------------
+
+namespace memory
+{
+
+///------------------------------------------------------------------------------------------------
+/// Pooled memory for many short lived, similarly sized blocks (e.g. a scene's objects). Blocks are
+/// carved out of large chunks and, once freed, kept in per size free lists to be reused by later
+/// allocations of the same size. Chunks are only returned to the heap, all at once, when the pool
+/// is destroyed. Blocks too large (or too aligned) to pool go straight to the heap.
+/// Not thread safe.
+class BlockPool final
+{
+public:
+    static constexpr std::size_t DEFAULT_CHUNK_SIZE = 64 * 1024;
+    static constexpr std::size_t BLOCK_GRANULARITY = alignof(std::max_align_t);
+    
+    explicit BlockPool(const std::size_t chunkSize = DEFAULT_CHUNK_SIZE);
+    ~BlockPool();
+    
+    BlockPool(const BlockPool&) = delete;
+    BlockPool& operator = (const BlockPool&) = delete;
+    
+    [[nodiscard]] void* Allocate(const std::size_t size, const std::size_t alignment);
+    void Deallocate(void* block, const std::size_t size, const std::size_t alignment);
+    
+    // Number of allocations (chunks and unpooled blocks) the pool itself has made from the heap
+    [[nodiscard]] std::size_t GetHeapAllocationCount() const;
+    [[nodiscard]] std::size_t GetLiveBlockCount() const;
+    [[nodiscard]] std::size_t GetChunkCount() const;
+    
+private:
+    struct FreeBlock
+    {
+        FreeBlock* mNext;
+    };
+    
+    [[nodiscard]] bool IsPooled(const std::size_t size, const std::size_t alignment) const;
+    
+private:
+    const std::size_t mChunkSize;
+    std::vector<std::unique_ptr<std::byte[]>> mChunks;
+    std::vector<FreeBlock*> mFreeLists; // Indexed by block size/BLOCK_GRANULARITY
+    std::byte* mChunkCursor;
+    std::size_t mChunkBytesLeft;
+    std::size_t mHeapAllocationCount;
+    std::size_t mLiveBlockCount;
+};
+
+///------------------------------------------------------------------------------------------------
+/// Standard allocator over a shared BlockPool (e.g. for std::allocate_shared). Every allocator
+/// (and so every allocate_shared control block) keeps its pool alive, so blocks that outlive
+/// the pool's original owner can still be safely returned to it.
+template<typename T>
+class BlockPoolAllocator final
+{
+public:
+    using value_type = T;
+    
+    explicit BlockPoolAllocator(std::shared_ptr<BlockPool> blockPool)
+        : mBlockPool(std::move(blockPool))
+    {
+    }
+    
+    template<typename U>
+    BlockPoolAllocator(const BlockPoolAllocator<U>& other)
+        : mBlockPool(other.GetBlockPool())
+    {
+    }
+    
+    [[nodiscard]] T* allocate(const std::size_t count)
+    {
+        return static_cast<T*>(mBlockPool->Allocate(count * sizeof(T), alignof(T)));
+    }
+    
+    void deallocate(T* block, const std::size_t count)
+    {
+        mBlockPool->Deallocate(block, count * sizeof(T), alignof(T));
+    }
+    
+    const std::shared_ptr<BlockPool>& GetBlockPool() const { return mBlockPool; }
+    
+private:
+    std::shared_ptr<BlockPool> mBlockPool;
+};
+
+///------------------------------------------------------------------------------------------------
+
+template<typename T, typename U>
+inline bool operator == (const BlockPoolAllocator<T>& lhs, const BlockPoolAllocator<U>& rhs) { return lhs.GetBlockPool() == rhs.GetBlockPool(); }
+
+template<typename T, typename U>
+inline bool operator != (const BlockPoolAllocator<T>& lhs, const BlockPoolAllocator<U>& rhs) { return !(lhs == rhs); }
+
+///------------------------------------------------------------------------------------------------
+
+}
+
+///------------------------------------------------------------------------------------------------
+
+#endif /* BlockPool_h */
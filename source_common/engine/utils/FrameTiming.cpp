@@ -0,0 +1,147 @@
+///------------------------------------------------------------------------------------------------
+///  FrameTiming.cpp
+///  Predators
+///
+///  Created by Alex Koukoulas on 27/04/2024
+///------------------------------------------------------------------------------------------------
+
+#include <engine/utils/FrameTiming.h>
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+///------------------------------------------------------------------------------------------------
+
+namespace timing
+{
+
+///------------------------------------------------------------------------------------------------
+
+FixedTimestepAccumulator::FixedTimestepAccumulator(const float stepMillis, const int maxStepsPerFrame)
+    : mStepMillis(stepMillis)
+    , mMaxStepsPerFrame(maxStepsPerFrame)
+    , mLastFrameStepCount(0)
+    , mAccumulatedMillis(0.0f)
+    , mDiscardedMillis(0.0f)
+{
+    assert(stepMillis > 0.0f && maxStepsPerFrame > 0);
+}
+
+///------------------------------------------------------------------------------------------------
+
+int FixedTimestepAccumulator::Advance(const float frameMillis)
+{
+    mAccumulatedMillis += std::max(0.0f, frameMillis);
+    
+    mLastFrameStepCount = static_cast<int>(mAccumulatedMillis/mStepMillis);
+    if (mLastFrameStepCount > mMaxStepsPerFrame)
+    {
+        // Only a partial step's worth of time is kept, so the next frame starts fresh
+        const auto keptMillis = std::fmod(mAccumulatedMillis, mStepMillis);
+        mDiscardedMillis += mAccumulatedMillis - keptMillis - mMaxStepsPerFrame * mStepMillis;
+        mAccumulatedMillis = keptMillis + mMaxStepsPerFrame * mStepMillis;
+        mLastFrameStepCount = mMaxStepsPerFrame;
+    }
+    
+    mAccumulatedMillis = std::max(0.0f, mAccumulatedMillis - mLastFrameStepCount * mStepMillis);
+    return mLastFrameStepCount;
+}
+
+///------------------------------------------------------------------------------------------------
+
+float FixedTimestepAccumulator::GetInterpolationAlpha() const
+{
+    return std::min(1.0f, mAccumulatedMillis/mStepMillis);
+}
+
+///------------------------------------------------------------------------------------------------
+
+float FixedTimestepAccumulator::GetStepMillis() const { return mStepMillis; }
+
+///------------------------------------------------------------------------------------------------
+
+int FixedTimestepAccumulator::GetMaxStepsPerFrame() const { return mMaxStepsPerFrame; }
+
+///------------------------------------------------------------------------------------------------
+
+int FixedTimestepAccumulator::GetLastFrameStepCount() const { return mLastFrameStepCount; }
+
+///------------------------------------------------------------------------------------------------
+
+float FixedTimestepAccumulator::GetDiscardedMillis() const { return mDiscardedMillis; }
+
+///------------------------------------------------------------------------------------------------
+
+void FixedTimestepAccumulator::SetMaxStepsPerFrame(const int maxStepsPerFrame)
+{
+    assert(maxStepsPerFrame > 0);
+    mMaxStepsPerFrame = maxStepsPerFrame;
+}
+
+///------------------------------------------------------------------------------------------------
+
+FramePacingStats::FramePacingStats()
+    : mVsyncMillis(1000.0f/60.0f)
+{
+    Reset();
+}
+
+///------------------------------------------------------------------------------------------------
+
+void FramePacingStats::SetVsyncMillis(const float vsyncMillis)
+{
+    assert(vsyncMillis > 0.0f);
+    mVsyncMillis = vsyncMillis;
+}
+
+///------------------------------------------------------------------------------------------------
+
+void FramePacingStats::RecordFrame(const float frameMillis)
+{
+    const auto bucketIndex = std::min(HISTOGRAM_BUCKET_COUNT - 1, static_cast<int>(std::max(0.0f, frameMillis)/HISTOGRAM_BUCKET_MILLIS));
+    mFrameTimeHistogram[bucketIndex]++;
+    
+    // A frame presented on the Nth vsync after the previous one missed the N - 1 in between
+    mMissedVsyncCount += std::max(0, static_cast<int>(std::round(frameMillis/mVsyncMillis)) - 1);
+    
+    mTotalFrameMillis += frameMillis;
+    mWorstFrameMillis = std::max(mWorstFrameMillis, frameMillis);
+    mFrameCount++;
+}
+
+///------------------------------------------------------------------------------------------------
+
+void FramePacingStats::Reset()
+{
+    mFrameTimeHistogram.fill(0);
+    mTotalFrameMillis = 0.0f;
+    mWorstFrameMillis = 0.0f;
+    mFrameCount = 0;
+    mMissedVsyncCount = 0;
+}
+
+///------------------------------------------------------------------------------------------------
+
+const std::array<int, FramePacingStats::HISTOGRAM_BUCKET_COUNT>& FramePacingStats::GetFrameTimeHistogram() const { return mFrameTimeHistogram; }
+
+///------------------------------------------------------------------------------------------------
+
+int FramePacingStats::GetFrameCount() const { return mFrameCount; }
+
+///------------------------------------------------------------------------------------------------
+
+int FramePacingStats::GetMissedVsyncCount() const { return mMissedVsyncCount; }
+
+///------------------------------------------------------------------------------------------------
+
+float FramePacingStats::GetAverageFrameMillis() const { return mFrameCount > 0 ? mTotalFrameMillis/mFrameCount : 0.0f; }
+
+///------------------------------------------------------------------------------------------------
+
+float FramePacingStats::GetWorstFrameMillis() const { return mWorstFrameMillis; }
+
+///------------------------------------------------------------------------------------------------
+
+}
+
+///------------------------------------------------------------------------------------------------
@@ -0,0 +1,86 @@
+///------------------------------------------------------------------------------------------------
+///  FrameTiming.h
+///  Predators
+///
+///  Created by Alex Koukoulas on 27/04/2024
+///------------------------------------------------------------------------------------------------
+
+#ifndef FrameTiming_h
+#define FrameTiming_h
+
+///------------------------------------------------------------------------------------------------
+
+#include <array>
+
+///------------------------------------------------------------------------------------------------
+
+namespace timing
+{
+
+///------------------------------------------------------------------------------------------------
+/// Turns variable frame times into a whole number of fixed length logic steps per frame.
+/// The time left over (less than a step) is carried to the next frame, and is what renders
+/// interpolate by (\see GetInterpolationAlpha).
+class FixedTimestepAccumulator final
+{
+public:
+    FixedTimestepAccumulator(const float stepMillis, const int maxStepsPerFrame);
+    
+    // Accumulates the frame's time and returns the number of logic steps to run for it. Frames that
+    // would need more than the max steps per frame only run that many, and the time they could not
+    // catch up on is discarded, so that one slow frame can't snowball into ever slower ones.
+    [[nodiscard]] int Advance(const float frameMillis);
+    
+    // How far (0 to 1) into the next, not yet run, logic step the accumulated time is.
+    [[nodiscard]] float GetInterpolationAlpha() const;
+    [[nodiscard]] float GetStepMillis() const;
+    [[nodiscard]] int GetMaxStepsPerFrame() const;
+    [[nodiscard]] int GetLastFrameStepCount() const;
+    [[nodiscard]] float GetDiscardedMillis() const;
+    
+    void SetMaxStepsPerFrame(const int maxStepsPerFrame);
+    
+private:
+    const float mStepMillis;
+    int mMaxStepsPerFrame;
+    int mLastFrameStepCount;
+    float mAccumulatedMillis;
+    float mDiscardedMillis;
+};
+
+///------------------------------------------------------------------------------------------------
+/// Frame time histogram and missed vsync counts, since the last Reset.
+class FramePacingStats final
+{
+public:
+    static constexpr int HISTOGRAM_BUCKET_COUNT = 25;
+    static constexpr float HISTOGRAM_BUCKET_MILLIS = 2.0f; // The last bucket also holds all longer frames
+    
+    FramePacingStats();
+    
+    void SetVsyncMillis(const float vsyncMillis);
+    void RecordFrame(const float frameMillis);
+    void Reset();
+    
+    [[nodiscard]] const std::array<int, HISTOGRAM_BUCKET_COUNT>& GetFrameTimeHistogram() const;
+    [[nodiscard]] int GetFrameCount() const;
+    [[nodiscard]] int GetMissedVsyncCount() const;
+    [[nodiscard]] float GetAverageFrameMillis() const;
+    [[nodiscard]] float GetWorstFrameMillis() const;
+    
+private:
+    std::array<int, HISTOGRAM_BUCKET_COUNT> mFrameTimeHistogram;
+    float mVsyncMillis;
+    float mTotalFrameMillis;
+    float mWorstFrameMillis;
+    int mFrameCount;
+    int mMissedVsyncCount;
+};
+
+///------------------------------------------------------------------------------------------------
+
+}
+
+///------------------------------------------------------------------------------------------------
+
+#endif /* FrameTiming_h */
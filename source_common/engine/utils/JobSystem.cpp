@@ -0,0 +1,247 @@
+///------------------------------------------------------------------------------------------------
+///  JobSystem.cpp
+///  Predators
+///
+///  Created by Alex Koukoulas on 28/04/2024
+///------------------------------------------------------------------------------------------------
+
+#include <engine/utils/JobSystem.h>
+#include <engine/utils/Profiling.h>
+#include <algorithm>
+#include <cassert>
+#include <string>
+
+///------------------------------------------------------------------------------------------------
+
+namespace jobs
+{
+
+///------------------------------------------------------------------------------------------------
+
+// Queue 0 is shared by all threads that aren't workers of the job system they submit to
+static constexpr int NON_WORKER_QUEUE_INDEX = 0;
+
+static thread_local const JobSystem* sCurrentThreadJobSystem = nullptr;
+static thread_local int sCurrentThreadQueueIndex = NON_WORKER_QUEUE_INDEX;
+
+///------------------------------------------------------------------------------------------------
+
+int JobSystem::GetDefaultWorkerThreadCount()
+{
+    return std::max(2, static_cast<int>(std::thread::hardware_concurrency()) - 1);
+}
+
+///------------------------------------------------------------------------------------------------
+
+JobSystem::JobSystem(const int workerThreadCount /* = GetDefaultWorkerThreadCount() */)
+    : mQueuedJobCount(0)
+    , mShuttingDown(false)
+{
+    assert(workerThreadCount > 0);
+    
+    for (int i = 0; i < workerThreadCount + 1; ++i)
+    {
+        mJobQueues.push_back(std::make_unique<JobQueue>());
+    }
+    
+    for (int i = 0; i < workerThreadCount; ++i)
+    {
+        mWorkerThreads.emplace_back([this, i]{ WorkerLoop(i); });
+    }
+}
+
+///------------------------------------------------------------------------------------------------
+
+JobSystem::~JobSystem()
+{
+    {
+        std::lock_guard<std::mutex> lock(mSleepMutex);
+        mShuttingDown = true;
+    }
+    mSleepConditionVariable.notify_all();
+    
+    // Jobs still queued at this point are dropped, but the ones already running are finished
+    for (auto& workerThread: mWorkerThreads)
+    {
+        workerThread.join();
+    }
+}
+
+///------------------------------------------------------------------------------------------------
+
+void JobSystem::Submit(std::function<void()> job, JobGroup* jobGroup /* = nullptr */)
+{
+    if (jobGroup)
+    {
+        jobGroup->mPendingJobCount.fetch_add(1, std::memory_order_relaxed);
+    }
+    
+    auto& jobQueue = *mJobQueues[GetCurrentThreadQueueIndex()];
+    {
+        std::lock_guard<std::mutex> lock(jobQueue.mMutex);
+        jobQueue.mJobs.push_back({ std::move(job), jobGroup, memory::GetCurrentAllocationTag(), memory::GetCurrentAllocationLabel() });
+    }
+    mQueuedJobCount.fetch_add(1, std::memory_order_release);
+    
+    // Taking the sleep lock makes sure a worker that just found no jobs is already waiting to be notified
+    {
+        std::lock_guard<std::mutex> lock(mSleepMutex);
+    }
+    mSleepConditionVariable.notify_one();
+}
+
+///------------------------------------------------------------------------------------------------
+
+void JobSystem::Wait(JobGroup& jobGroup)
+{
+    const auto queueIndex = GetCurrentThreadQueueIndex();
+    while (!jobGroup.IsDone())
+    {
+        if (!TryRunJob(queueIndex, true))
+        {
+            std::this_thread::yield();
+        }
+    }
+}
+
+///------------------------------------------------------------------------------------------------
+
+void JobSystem::ParallelFor(const int count, const std::function<void(const int index)>& body, const int batchSize /* = 1 */)
+{
+    assert(batchSize > 0);
+    
+    const auto runBatch = [&body, count, batchSize](const int batchIndex)
+    {
+        const auto batchEnd = std::min(count, (batchIndex + 1) * batchSize);
+        for (int i = batchIndex * batchSize; i < batchEnd; ++i)
+        {
+            body(i);
+        }
+    };
+    
+    const auto batchCount = (count + batchSize - 1)/batchSize;
+    if (batchCount <= 1)
+    {
+        runBatch(0);
+        return;
+    }
+    
+    JobGroup jobGroup;
+    for (int batchIndex = 1; batchIndex < batchCount; ++batchIndex)
+    {
+        Submit([&runBatch, batchIndex]{ runBatch(batchIndex); }, &jobGroup);
+    }
+    
+    runBatch(0);
+    Wait(jobGroup);
+}
+
+///------------------------------------------------------------------------------------------------
+
+int JobSystem::GetWorkerThreadCount() const
+{
+    return static_cast<int>(mWorkerThreads.size());
+}
+
+///------------------------------------------------------------------------------------------------
+
+void JobSystem::WorkerLoop(const int workerIndex)
+{
+    profiling::SetCurrentThreadName("Job Worker " + std::to_string(workerIndex + 1));
+    sCurrentThreadJobSystem = this;
+    sCurrentThreadQueueIndex = workerIndex + 1;
+    
+    while (true)
+    {
+        if (TryRunJob(sCurrentThreadQueueIndex, false))
+        {
+            continue;
+        }
+        
+        std::unique_lock<std::mutex> lock(mSleepMutex);
+        mSleepConditionVariable.wait(lock, [this]{ return mShuttingDown || mQueuedJobCount.load(std::memory_order_acquire) > 0; });
+        if (mShuttingDown)
+        {
+            return;
+        }
+    }
+}
+
+///------------------------------------------------------------------------------------------------
+
+bool JobSystem::TryRunJob(const int queueIndex, const bool groupedJobsOnly)
+{
+    Job job;
+    if (!TryPopJob(queueIndex, groupedJobsOnly, job))
+    {
+        return false;
+    }
+    
+    {
+        // Jobs' allocations are attributed to the scope they were submitted from
+        memory::AllocationScope allocationScope(job.mAllocationTag, job.mAllocationLabel);
+        job.mFunction();
+    }
+    
+    if (job.mJobGroup)
+    {
+        job.mJobGroup->mPendingJobCount.fetch_sub(1, std::memory_order_release);
+    }
+    return true;
+}
+
+///------------------------------------------------------------------------------------------------
+
+bool JobSystem::TryPopJob(const int queueIndex, const bool groupedJobsOnly, Job& outJob)
+{
+    const auto queueCount = static_cast<int>(mJobQueues.size());
+    for (int i = 0; i < queueCount; ++i)
+    {
+        // The own queue is popped from the back (most recently submitted, so most likely still in cache),
+        // the others are stolen from at the front (oldest, so most likely to split further)
+        const auto stealing = i > 0;
+        auto& jobQueue = *mJobQueues[(queueIndex + i) % queueCount];
+        
+        std::lock_guard<std::mutex> lock(jobQueue.mMutex);
+        auto& jobs = jobQueue.mJobs;
+        const auto isRunnable = [groupedJobsOnly](const Job& job){ return !groupedJobsOnly || job.mJobGroup != nullptr; };
+        
+        if (stealing)
+        {
+            auto jobIter = std::find_if(jobs.begin(), jobs.end(), isRunnable);
+            if (jobIter != jobs.end())
+            {
+                outJob = std::move(*jobIter);
+                jobs.erase(jobIter);
+                mQueuedJobCount.fetch_sub(1, std::memory_order_relaxed);
+                return true;
+            }
+        }
+        else
+        {
+            auto jobIter = std::find_if(jobs.rbegin(), jobs.rend(), isRunnable);
+            if (jobIter != jobs.rend())
+            {
+                outJob = std::move(*jobIter);
+                jobs.erase(std::next(jobIter).base());
+                mQueuedJobCount.fetch_sub(1, std::memory_order_relaxed);
+                return true;
+            }
+        }
+    }
+    
+    return false;
+}
+
+///------------------------------------------------------------------------------------------------
+
+int JobSystem::GetCurrentThreadQueueIndex() const
+{
+    return sCurrentThreadJobSystem == this ? sCurrentThreadQueueIndex : NON_WORKER_QUEUE_INDEX;
+}
+
+///------------------------------------------------------------------------------------------------
+
+}
+
+///------------------------------------------------------------------------------------------------
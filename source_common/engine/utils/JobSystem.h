@@ -0,0 +1,111 @@
+///------------------------------------------------------------------------------------------------
+///  JobSystem.h
+///  Predators
+///
+///  Created by Alex Koukoulas on 28/04/2024
+///------------------------------------------------------------------------------------------------
+
+#ifndef JobSystem_h
+#define JobSystem_h
+
+///------------------------------------------------------------------------------------------------
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <engine/utils/AllocationTracking.h>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+///------------------------------------------------------------------------------------------------
+
+namespace jobs
+{
+
+///------------------------------------------------------------------------------------------------
+/// Fork/join counter. Jobs submitted with a group can be waited on together (\see JobSystem::Wait).
+class JobGroup final
+{
+    friend class JobSystem;
+    
+public:
+    JobGroup() = default;
+    JobGroup(const JobGroup&) = delete;
+    JobGroup& operator = (const JobGroup&) = delete;
+    
+    [[nodiscard]] bool IsDone() const { return mPendingJobCount.load(std::memory_order_acquire) == 0; }
+    
+private:
+    std::atomic<int> mPendingJobCount{0};
+};
+
+///------------------------------------------------------------------------------------------------
+/// Small work stealing job system. Each worker thread pushes and pops the jobs it submits at the
+/// back of its own queue and, when that is empty, steals from the front of the others'. Threads
+/// that aren't workers (e.g. the main thread) share one more queue.
+class JobSystem final
+{
+public:
+    // Leaves a core for the main thread, but always has at least two workers so that one long
+    // running job (e.g. story map generation) can't hold back all others (e.g. async resource loads)
+    [[nodiscard]] static int GetDefaultWorkerThreadCount();
+    
+    explicit JobSystem(const int workerThreadCount = GetDefaultWorkerThreadCount());
+    ~JobSystem();
+    
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator = (const JobSystem&) = delete;
+    
+    // Jobs without a group are fire and forget, and may be long running (e.g. story map generation).
+    // They are only ever run by workers, so that waits never get stuck behind them.
+    void Submit(std::function<void()> job, JobGroup* jobGroup = nullptr);
+    
+    // Blocks until all of the group's jobs have finished, running grouped jobs (the group's or
+    // any other's) on the calling thread in the meantime.
+    void Wait(JobGroup& jobGroup);
+    
+    // Runs body(i) for every i in [0, count), in batches of the given size spread over the workers
+    // and the calling thread, and returns once all have finished.
+    void ParallelFor(const int count, const std::function<void(const int index)>& body, const int batchSize = 1);
+    
+    [[nodiscard]] int GetWorkerThreadCount() const;
+    
+private:
+    struct Job
+    {
+        std::function<void()> mFunction;
+        JobGroup* mJobGroup;
+        memory::AllocationTag mAllocationTag;
+        const char* mAllocationLabel;
+    };
+    
+    struct JobQueue
+    {
+        std::mutex mMutex;
+        std::deque<Job> mJobs;
+    };
+    
+    void WorkerLoop(const int workerIndex);
+    bool TryRunJob(const int queueIndex, const bool groupedJobsOnly);
+    bool TryPopJob(const int queueIndex, const bool groupedJobsOnly, Job& outJob);
+    int GetCurrentThreadQueueIndex() const;
+    
+private:
+    std::vector<std::unique_ptr<JobQueue>> mJobQueues;
+    std::vector<std::thread> mWorkerThreads;
+    std::atomic<int> mQueuedJobCount;
+    std::mutex mSleepMutex;
+    std::condition_variable mSleepConditionVariable;
+    bool mShuttingDown;
+};
+
+///------------------------------------------------------------------------------------------------
+
+}
+
+///------------------------------------------------------------------------------------------------
+
+#endif /* JobSystem_h */
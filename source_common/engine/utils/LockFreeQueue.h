@@ -0,0 +1,79 @@
+///------------------------------------------------------------------------------------------------
+///  LockFreeQueue.h
+///  Predators
+///
+///  Created by Alex Koukoulas on 01/05/2024
+///------------------------------------------------------------------------------------------------
+
+#ifndef LockFreeQueue_h
+#define LockFreeQueue_h
+
+///------------------------------------------------------------------------------------------------
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <type_traits>
+
+///------------------------------------------------------------------------------------------------
+/// Bounded, wait free queue for exactly one producer and one consumer thread (e.g. the game thread
+/// feeding the audio callback). Neither side ever blocks or allocates; pushing to a full queue
+/// fails instead.
+template <class T, std::size_t Capacity>
+class LockFreeQueue final
+{
+    static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "LockFreeQueue capacity needs to be a power of two");
+    static_assert(std::is_trivially_copyable<T>::value, "LockFreeQueue elements are copied between threads without synchronization of their own");
+    
+public:
+    static constexpr std::size_t CAPACITY = Capacity;
+    
+    LockFreeQueue() = default;
+    LockFreeQueue(const LockFreeQueue&) = delete;
+    LockFreeQueue& operator = (const LockFreeQueue&) = delete;
+    
+    // Producer thread only
+    bool TryPush(const T& element)
+    {
+        const auto writeIndex = mWriteIndex.load(std::memory_order_relaxed);
+        if (writeIndex - mReadIndex.load(std::memory_order_acquire) == Capacity)
+        {
+            return false;
+        }
+        
+        mElements[writeIndex & (Capacity - 1)] = element;
+        mWriteIndex.store(writeIndex + 1, std::memory_order_release);
+        return true;
+    }
+    
+    // Consumer thread only
+    bool TryPop(T& outElement)
+    {
+        const auto readIndex = mReadIndex.load(std::memory_order_relaxed);
+        if (readIndex == mWriteIndex.load(std::memory_order_acquire))
+        {
+            return false;
+        }
+        
+        outElement = mElements[readIndex & (Capacity - 1)];
+        mReadIndex.store(readIndex + 1, std::memory_order_release);
+        return true;
+    }
+    
+    // Only a snapshot when called while the other side is pushing/popping
+    [[nodiscard]] std::size_t GetSize() const
+    {
+        return mWriteIndex.load(std::memory_order_acquire) - mReadIndex.load(std::memory_order_acquire);
+    }
+    
+private:
+    std::array<T, Capacity> mElements;
+    
+    // On separate cache lines so that the two sides don't contend on every push/pop
+    alignas(64) std::atomic<std::size_t> mWriteIndex{0};
+    alignas(64) std::atomic<std::size_t> mReadIndex{0};
+};
+
+///------------------------------------------------------------------------------------------------
+
+#endif /* LockFreeQueue_h */
@@ -0,0 +1,417 @@
+///------------------------------------------------------------------------------------------------
+///  Logging.cpp
+///  Predators
+///
+///  Created by Alex Koukoulas on 26/04/2024
+///------------------------------------------------------------------------------------------------
+
+#include <engine/utils/Logging.h>
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdarg>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+///------------------------------------------------------------------------------------------------
+
+namespace logging
+{
+
+///------------------------------------------------------------------------------------------------
+
+static constexpr std::uint64_t LOG_RING_BUFFER_CAPACITY = 512;
+static constexpr int LOG_RECORD_MESSAGE_CAPACITY = 240;
+static constexpr auto LOGGING_THREAD_FLUSH_INTERVAL = std::chrono::milliseconds(5);
+static constexpr const char* LOG_TYPE_TAGS[LOG_TYPE_COUNT] = { "[INFO] ", "[WARNING] ", "[ERROR] " };
+
+///------------------------------------------------------------------------------------------------
+
+struct LogRecord
+{
+    std::uint64_t mSequence;
+    LogType mLogType;
+    LogCategory mLogCategory;
+    char mMessage[LOG_RECORD_MESSAGE_CAPACITY];
+};
+
+///------------------------------------------------------------------------------------------------
+
+// Single producer (the owning thread), single consumer (whoever holds the drain lock) ring buffer
+struct ThreadLogBuffer
+{
+    ThreadLogBuffer()
+        : mRecords(LOG_RING_BUFFER_CAPACITY)
+    {
+    }
+    
+    std::vector<LogRecord> mRecords;
+    std::atomic<std::uint64_t> mWriteCount{0};
+    std::atomic<std::uint64_t> mReadCount{0};
+    std::atomic<std::uint64_t> mDroppedCount{0};
+    
+    // Cleared when the owning thread exits, after which the buffer can be handed to a new thread
+    std::atomic<bool> mInUse{true};
+};
+
+///------------------------------------------------------------------------------------------------
+
+static thread_local ThreadLogBuffer* sCurrentThreadLogBuffer = nullptr;
+static thread_local bool sCurrentThreadLogBufferReleased = false;
+
+///------------------------------------------------------------------------------------------------
+
+// Releases the calling thread's log buffer when the thread exits. Logs made after that
+// (e.g. from other thread_local destructors) take the synchronous path instead.
+struct ThreadLogBufferLease
+{
+    ~ThreadLogBufferLease()
+    {
+        sCurrentThreadLogBufferReleased = true;
+        sCurrentThreadLogBuffer->mInUse.store(false, std::memory_order_release);
+        sCurrentThreadLogBuffer = nullptr;
+    }
+};
+
+///------------------------------------------------------------------------------------------------
+
+static void WriteToStdOut(const LogType logType, const LogCategory, const char* message)
+{
+    fputs(LOG_TYPE_TAGS[static_cast<int>(logType)], stdout);
+    fputs(message, stdout);
+    fputc('\n', stdout);
+}
+
+///------------------------------------------------------------------------------------------------
+
+class LoggingBackend final
+{
+public:
+    static LoggingBackend& GetInstance()
+    {
+        // Intentionally leaked, so that logs during static destruction (and the atexit flush) still work
+        static auto* instance = new LoggingBackend();
+        return *instance;
+    }
+    
+    // Returns nullptr once the calling thread has released its buffer on exit
+    ThreadLogBuffer* GetCurrentThreadLogBuffer()
+    {
+        if (!sCurrentThreadLogBuffer && !sCurrentThreadLogBufferReleased)
+        {
+            sCurrentThreadLogBuffer = AcquireThreadLogBuffer();
+            thread_local ThreadLogBufferLease threadLogBufferLease;
+        }
+        return sCurrentThreadLogBuffer;
+    }
+    
+    // Called by producers after publishing a record. Only the first record after a drain starts
+    // pays for the notification, while the logging thread is idle it is not woken at all.
+    void NotifyPendingRecords()
+    {
+        if (!mHasPendingRecords.load() && !mHasPendingRecords.exchange(true))
+        {
+            std::lock_guard<std::mutex> lock(mWakeMutex);
+            mWakeCondition.notify_one();
+        }
+    }
+    
+    std::uint64_t GetNextSequence()
+    {
+        return mNextSequence.fetch_add(1, std::memory_order_relaxed);
+    }
+    
+    void SetMinLogType(const LogType logType)
+    {
+        std::lock_guard<std::mutex> lock(mFilterMutex);
+        mMinLogType = logType;
+        UpdateEnabledLogMask();
+    }
+    
+    void SetCategoryEnabled(const LogCategory logCategory, const bool enabled)
+    {
+        std::lock_guard<std::mutex> lock(mFilterMutex);
+        mCategoryEnabled[static_cast<int>(logCategory)] = enabled;
+        UpdateEnabledLogMask();
+    }
+    
+    void SetSink(LogSink logSink)
+    {
+        std::lock_guard<std::mutex> lock(mDrainMutex);
+        mLogSink = logSink ? std::move(logSink) : LogSink(WriteToStdOut);
+    }
+    
+    void Flush()
+    {
+        std::lock_guard<std::mutex> lock(mDrainMutex);
+        DrainThreadLogBuffers();
+        WriteRepeatedMessageSummary();
+        fflush(stdout);
+    }
+    
+    void WriteSynchronously(const LogType logType, const LogCategory logCategory, const char* message)
+    {
+        std::lock_guard<std::mutex> lock(mDrainMutex);
+        DrainThreadLogBuffers();
+        WriteMessage(logType, logCategory, message);
+        fflush(stdout);
+    }
+    
+private:
+    LoggingBackend()
+        : mLogSink(WriteToStdOut)
+    {
+        std::fill(std::begin(mCategoryEnabled), std::end(mCategoryEnabled), true);
+        
+        std::thread loggingThread([this]
+        {
+            auto hasRepeatedMessageSummaryPending = false;
+            while (true)
+            {
+                {
+                    // Sleeps until something is logged, or (for a pending repeat summary) things go quiet
+                    std::unique_lock<std::mutex> lock(mWakeMutex);
+                    const auto hasPendingRecords = [this]{ return mHasPendingRecords.load(); };
+                    if (hasRepeatedMessageSummaryPending)
+                    {
+                        mWakeCondition.wait_for(lock, LOGGING_THREAD_FLUSH_INTERVAL, hasPendingRecords);
+                    }
+                    else
+                    {
+                        mWakeCondition.wait(lock, hasPendingRecords);
+                    }
+                }
+                
+                // Lets more messages arrive, so that they are written out in batches
+                std::this_thread::sleep_for(LOGGING_THREAD_FLUSH_INTERVAL);
+                
+                // Cleared before draining, so that a record published after the drain reads its
+                // write count always sees the flag cleared and wakes the thread again
+                mHasPendingRecords.store(false);
+                
+                std::lock_guard<std::mutex> lock(mDrainMutex);
+                if (DrainThreadLogBuffers() == 0)
+                {
+                    // A message that stopped repeating is summarised once things go quiet
+                    WriteRepeatedMessageSummary();
+                }
+                fflush(stdout);
+                hasRepeatedMessageSummaryPending = mLastMessageRepeatCount > 0;
+            }
+        });
+        loggingThread.detach();
+        
+        std::atexit([]{ LoggingBackend::GetInstance().Flush(); });
+    }
+    
+    ThreadLogBuffer* AcquireThreadLogBuffer()
+    {
+        std::lock_guard<std::mutex> lock(mRegistrationMutex);
+        for (auto& threadLogBuffer: mThreadLogBuffers)
+        {
+            // Only fully drained ones, so that the new thread gets the whole ring. The read count is
+            // only advanced under the registration lock, so it can't change underneath us here.
+            if (!threadLogBuffer->mInUse.load(std::memory_order_acquire) && threadLogBuffer->mReadCount.load(std::memory_order_relaxed) == threadLogBuffer->mWriteCount.load(std::memory_order_relaxed))
+            {
+                threadLogBuffer->mInUse.store(true, std::memory_order_relaxed);
+                return threadLogBuffer.get();
+            }
+        }
+        
+        mThreadLogBuffers.push_back(std::make_unique<ThreadLogBuffer>());
+        return mThreadLogBuffers.back().get();
+    }
+    
+    // Must be called with the filter lock held
+    void UpdateEnabledLogMask()
+    {
+        std::uint32_t enabledLogMask = 0;
+        for (int category = 0; category < static_cast<int>(LogCategory::COUNT); ++category)
+        {
+            for (int logType = static_cast<int>(mMinLogType); mCategoryEnabled[category] && logType < LOG_TYPE_COUNT; ++logType)
+            {
+                enabledLogMask |= 1U << (category * LOG_TYPE_COUNT + logType);
+            }
+        }
+        internal::sEnabledLogMask.store(enabledLogMask, std::memory_order_relaxed);
+    }
+    
+    // Must be called with the drain lock held. Returns the number of messages drained.
+    std::size_t DrainThreadLogBuffers()
+    {
+        mDrainedRecords.clear();
+        
+        std::uint64_t droppedCount = 0;
+        {
+            std::lock_guard<std::mutex> lock(mRegistrationMutex);
+            for (auto& threadLogBuffer: mThreadLogBuffers)
+            {
+                const auto readCount = threadLogBuffer->mReadCount.load(std::memory_order_relaxed);
+                // Sequentially consistent, paired with the pending records flag (see NotifyPendingRecords)
+                const auto writeCount = threadLogBuffer->mWriteCount.load();
+                for (auto recordIndex = readCount; recordIndex < writeCount; ++recordIndex)
+                {
+                    mDrainedRecords.push_back(threadLogBuffer->mRecords[recordIndex % LOG_RING_BUFFER_CAPACITY]);
+                }
+                threadLogBuffer->mReadCount.store(writeCount, std::memory_order_release);
+                droppedCount += threadLogBuffer->mDroppedCount.exchange(0, std::memory_order_relaxed);
+            }
+        }
+        
+        // Interleaves the different threads' messages in the order they were logged
+        std::sort(mDrainedRecords.begin(), mDrainedRecords.end(), [](const LogRecord& lhs, const LogRecord& rhs){ return lhs.mSequence < rhs.mSequence; });
+        for (const auto& record: mDrainedRecords)
+        {
+            WriteMessage(record.mLogType, record.mLogCategory, record.mMessage);
+        }
+        
+        if (droppedCount > 0)
+        {
+            WriteRepeatedMessageSummary();
+            std::string droppedMessage = std::to_string(droppedCount) + " log messages were dropped (log ring buffer full)";
+            mLogSink(LogType::WARNING, LogCategory::GENERAL, droppedMessage.c_str());
+        }
+        
+        return mDrainedRecords.size();
+    }
+    
+    // Must be called with the drain lock held. Consecutive identical messages are collapsed.
+    void WriteMessage(const LogType logType, const LogCategory logCategory, const char* message)
+    {
+        if (mLastMessageRepeatCount >= 0 && logType == mLastLogType && logCategory == mLastLogCategory && mLastMessage == message)
+        {
+            mLastMessageRepeatCount++;
+            return;
+        }
+        
+        WriteRepeatedMessageSummary();
+        
+        mLastLogType = logType;
+        mLastLogCategory = logCategory;
+        mLastMessage = message;
+        mLastMessageRepeatCount = 0;
+        mLogSink(logType, logCategory, message);
+    }
+    
+    void WriteRepeatedMessageSummary()
+    {
+        if (mLastMessageRepeatCount > 0)
+        {
+            const auto summaryMessage = "(last message repeated " + std::to_string(mLastMessageRepeatCount) + " more times)";
+            mLogSink(mLastLogType, mLastLogCategory, summaryMessage.c_str());
+        }
+        mLastMessageRepeatCount = -1;
+    }
+    
+private:
+    std::atomic<std::uint64_t> mNextSequence{0};
+    
+    std::mutex mRegistrationMutex;
+    std::vector<std::unique_ptr<ThreadLogBuffer>> mThreadLogBuffers;
+    
+    std::mutex mWakeMutex;
+    std::condition_variable mWakeCondition;
+    std::atomic<bool> mHasPendingRecords{false};
+    
+    std::mutex mFilterMutex;
+    LogType mMinLogType = LogType::INFO;
+    bool mCategoryEnabled[static_cast<int>(LogCategory::COUNT)];
+    
+    std::mutex mDrainMutex;
+    std::vector<LogRecord> mDrainedRecords;
+    LogSink mLogSink;
+    std::string mLastMessage;
+    LogType mLastLogType = LogType::INFO;
+    LogCategory mLastLogCategory = LogCategory::GENERAL;
+    int mLastMessageRepeatCount = -1;
+};
+
+///------------------------------------------------------------------------------------------------
+
+void SetMinLogType(const LogType logType)
+{
+    LoggingBackend::GetInstance().SetMinLogType(logType);
+}
+
+///------------------------------------------------------------------------------------------------
+
+void SetLogCategoryEnabled(const LogCategory logCategory, const bool enabled)
+{
+    LoggingBackend::GetInstance().SetCategoryEnabled(logCategory, enabled);
+}
+
+///------------------------------------------------------------------------------------------------
+
+void SetLogSink(LogSink logSink)
+{
+    LoggingBackend::GetInstance().SetSink(std::move(logSink));
+}
+
+///------------------------------------------------------------------------------------------------
+
+void Flush()
+{
+    LoggingBackend::GetInstance().Flush();
+}
+
+///------------------------------------------------------------------------------------------------
+
+void LogFormatted(const LogCategory logCategory, const LogType logType, const char* message, ...)
+{
+    auto& backend = LoggingBackend::GetInstance();
+    auto* threadLogBuffer = backend.GetCurrentThreadLogBuffer();
+    
+    va_list args;
+    va_start(args, message);
+    
+    if (threadLogBuffer && logType != LogType::ERROR)
+    {
+        const auto writeCount = threadLogBuffer->mWriteCount.load(std::memory_order_relaxed);
+        if (writeCount - threadLogBuffer->mReadCount.load(std::memory_order_acquire) == LOG_RING_BUFFER_CAPACITY)
+        {
+            threadLogBuffer->mDroppedCount.fetch_add(1, std::memory_order_relaxed);
+            va_end(args);
+            return;
+        }
+        
+        auto& record = threadLogBuffer->mRecords[writeCount % LOG_RING_BUFFER_CAPACITY];
+        
+        va_list recordArgs;
+        va_copy(recordArgs, args);
+        const auto messageLength = vsnprintf(record.mMessage, LOG_RECORD_MESSAGE_CAPACITY, message, recordArgs);
+        va_end(recordArgs);
+        
+        if (messageLength >= 0 && messageLength < LOG_RECORD_MESSAGE_CAPACITY)
+        {
+            record.mSequence = backend.GetNextSequence();
+            record.mLogType = logType;
+            record.mLogCategory = logCategory;
+            threadLogBuffer->mWriteCount.store(writeCount + 1);
+            va_end(args);
+            backend.NotifyPendingRecords();
+            return;
+        }
+    }
+    
+    // Slow path, for errors, messages that don't fit in a record & logs from exiting threads
+    va_list lengthArgs;
+    va_copy(lengthArgs, args);
+    const auto messageLength = vsnprintf(nullptr, 0, message, lengthArgs);
+    va_end(lengthArgs);
+    
+    std::string formattedMessage(static_cast<std::size_t>(std::max(messageLength, 0)), '\0');
+    vsnprintf(formattedMessage.data(), formattedMessage.size() + 1, message, args);
+    va_end(args);
+    
+    backend.WriteSynchronously(logType, logCategory, formattedMessage.c_str());
+}
+
+///------------------------------------------------------------------------------------------------
+
+}
+
+///------------------------------------------------------------------------------------------------
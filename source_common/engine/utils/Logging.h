@@ -10,8 +10,9 @@
 
 ///-----------------------------------------------------------------------------------------------
 
-#include <stdarg.h>
-#include <stdio.h>  
+#include <atomic>
+#include <cstdint>
+#include <functional>
 #include <string>
 
 ///-----------------------------------------------------------------------------------------------
@@ -23,6 +24,13 @@ namespace logging
 
 #define LOG_IN_RELEASE
 
+///-----------------------------------------------------------------------------------------------
+/// Log types below this one (as an int, INFO = 0, WARNING = 1, ERROR = 2) are compiled out
+/// entirely. Can be overriden by the build (e.g. -DLOG_MIN_COMPILED_LOG_TYPE=1 drops all INFO logs).
+#if !defined(LOG_MIN_COMPILED_LOG_TYPE)
+#define LOG_MIN_COMPILED_LOG_TYPE 0
+#endif
+
 ///-----------------------------------------------------------------------------------------------
 /// Different types of logging available
 enum class LogType
@@ -30,36 +38,93 @@ enum class LogType
     INFO, WARNING, ERROR
 };
 
+inline constexpr int LOG_TYPE_COUNT = 3;
+
 ///-----------------------------------------------------------------------------------------------
-/// Logs a message to the std out, with a custom log type tag \see LogType
-/// @param[in] logType the category of logging message 
-/// @param[in] message the message itself as a c-string
-#if !defined(NDEBUG) || defined(LOG_IN_RELEASE)
-inline void Log(const LogType logType, const char* message, ...)
+/// Subsystems logs can be filtered by at runtime
+enum class LogCategory
+{
+    GENERAL,
+    RENDERING,
+    RESOURCES,
+    GAME_ACTIONS,
+    AUDIO,
+    COUNT
+};
+
+///-----------------------------------------------------------------------------------------------
+/// Receives each log message on the logging thread, after filtering and rate limiting.
+using LogSink = std::function<void(const LogType logType, const LogCategory logCategory, const char* message)>;
+
+///-----------------------------------------------------------------------------------------------
+/// Runtime filtering. Everything (of a compiled in log type) is logged by default.
+void SetMinLogType(const LogType logType);
+void SetLogCategoryEnabled(const LogCategory logCategory, const bool enabled);
+
+///-----------------------------------------------------------------------------------------------
+/// Replaces the default sink (std out, prefixed with the log type tag). Passing nullptr restores it.
+void SetLogSink(LogSink logSink);
+
+///-----------------------------------------------------------------------------------------------
+/// Blocks until all messages logged (by any thread) before the call have reached the sink.
+void Flush();
+
+///-----------------------------------------------------------------------------------------------
+/// Formats the message into the calling thread's ring buffer, from which the logging thread
+/// writes it out. Errors and messages too long for a ring buffer slot are instead written
+/// synchronously (after flushing everything logged before them), so they are never lost.
+/// Not filtered, call sites should go through LOG/LOG_CATEGORY below instead.
+void LogFormatted(const LogCategory logCategory, const LogType logType, const char* message, ...);
+
+///-----------------------------------------------------------------------------------------------
+
+namespace internal
 {
+    // One bit per (category, log type) pair, so that a filtered out log costs a single relaxed load
+    inline std::atomic<std::uint32_t> sEnabledLogMask{0xFFFFFFFF};
+    static_assert(static_cast<int>(LogCategory::COUNT) * LOG_TYPE_COUNT <= 32, "Enabled log mask can't hold all categories");
+}
     
-    switch(logType)
+///-----------------------------------------------------------------------------------------------
+
+inline bool IsLogEnabled(const LogCategory logCategory, const LogType logType)
+{
+#if !defined(NDEBUG) || defined(LOG_IN_RELEASE)
+    if (static_cast<int>(logType) < LOG_MIN_COMPILED_LOG_TYPE)
     {
-        case LogType::INFO: printf("[INFO] "); break;
-        case LogType::WARNING: printf("[WARNING] "); break;
-        case LogType::ERROR: printf("[ERROR] "); break;
+        return false;
     }
     
-    va_list args;
-    va_start (args, message);
-    vprintf (message, args);
-    va_end (args);
-    
-    printf("\n");
-}
+    const auto logBit = 1U << (static_cast<int>(logCategory) * LOG_TYPE_COUNT + static_cast<int>(logType));
+    return (internal::sEnabledLogMask.load(std::memory_order_relaxed) & logBit) != 0;
 #else
-inline void Log(const LogType, const char*, ...) {}
+    (void)logCategory;
+    (void)logType;
+    return false;
 #endif /* not NDEBUG */
+}
 
 ///-----------------------------------------------------------------------------------------------
 
 }
 
+///-----------------------------------------------------------------------------------------------
+/// Logs a message, with a custom log type tag \see LogType. The message arguments are only evaluated
+/// if the log is enabled, so for log types below LOG_MIN_COMPILED_LOG_TYPE they are dropped entirely.
+/// @param[in] logCategory the subsystem the message comes from \see LogCategory
+/// @param[in] logType the category of logging message
+/// @param[in] ... the message itself as a printf style format c-string, followed by its arguments
+#define LOG_CATEGORY(logCategory, logType, ...)                                  \
+    do                                                                           \
+    {                                                                            \
+        if (logging::IsLogEnabled(logCategory, logType))                         \
+        {                                                                        \
+            logging::LogFormatted(logCategory, logType, __VA_ARGS__);            \
+        }                                                                        \
+    } while (false)
+
+#define LOG(logType, ...) LOG_CATEGORY(logging::LogCategory::GENERAL, logType, __VA_ARGS__)
+
 ///-----------------------------------------------------------------------------------------------
 
 #endif /* Logging_h */
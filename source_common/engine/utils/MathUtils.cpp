@@ -70,8 +70,8 @@ int ControlledIndexSelectionFromDistribution(const ProbabilityDistribution& prob
 
 std::mt19937& GetRandomEngine()
 {
-    static std::random_device rd;
-    static std::mt19937 eng(rd());
+    // One engine per thread, since jobs (e.g. story map generation) also draw from it on job system workers
+    static thread_local std::mt19937 eng(std::random_device{}());
     return eng;
 }
 
@@ -11,6 +11,7 @@
 ///-----------------------------------------------------------------------------------------------
 
 #include <array>
+#include <cassert>
 #include <cmath>                       
 #include <ctime>                       
 #include <functional>                  
@@ -350,6 +351,80 @@ inline float TweenValue(const float val, const std::function<float(const float)>
     return 0.0f;
 }
 
+///-----------------------------------------------------------------------------------------------
+/// Tweening Function Types
+///
+/// Enumerates the built-in tweening functions above, so that hot paths can select
+/// them via a switch rather than calling through a std::function. Anything else
+/// (e.g. lambdas) maps to CUSTOM.
+enum class TweeningFunctionType
+{
+    LINEAR, QUAD, CUBIC, QUART, QUINT, BACK, BOUNCE, ELASTIC, CUSTOM
+};
+
+///-----------------------------------------------------------------------------------------------
+/// Maps a tweening function to its built-in type.
+/// @param[in] tweeningFunc the tweening function to inspect.
+/// @returns the matching built-in tweening function type, or CUSTOM if there isn't one.
+inline TweeningFunctionType GetTweeningFunctionType(const std::function<float(const float)>& tweeningFunc)
+{
+    const auto* functionPointer = tweeningFunc.target<float(*)(const float)>();
+    if (!functionPointer) return TweeningFunctionType::CUSTOM;
+    
+    if (*functionPointer == LinearFunction) return TweeningFunctionType::LINEAR;
+    if (*functionPointer == QuadFunction) return TweeningFunctionType::QUAD;
+    if (*functionPointer == CubicFunction) return TweeningFunctionType::CUBIC;
+    if (*functionPointer == QuartFunction) return TweeningFunctionType::QUART;
+    if (*functionPointer == QuintFunction) return TweeningFunctionType::QUINT;
+    if (*functionPointer == BackFunction) return TweeningFunctionType::BACK;
+    if (*functionPointer == BounceFunction) return TweeningFunctionType::BOUNCE;
+    if (*functionPointer == ElasticFunction) return TweeningFunctionType::ELASTIC;
+    
+    return TweeningFunctionType::CUSTOM;
+}
+
+///-----------------------------------------------------------------------------------------------
+/// Evaluates a built-in tweening function.
+/// @param[in] tweeningFunctionType the built-in tweening function to evaluate (CUSTOM is not supported).
+/// @param[in] t the input value to the tween function.
+/// @returns the transformed t value.
+inline float EvaluateTweeningFunction(const TweeningFunctionType tweeningFunctionType, const float t)
+{
+    switch (tweeningFunctionType)
+    {
+        case TweeningFunctionType::LINEAR: return LinearFunction(t);
+        case TweeningFunctionType::QUAD: return QuadFunction(t);
+        case TweeningFunctionType::CUBIC: return CubicFunction(t);
+        case TweeningFunctionType::QUART: return QuartFunction(t);
+        case TweeningFunctionType::QUINT: return QuintFunction(t);
+        case TweeningFunctionType::BACK: return BackFunction(t);
+        case TweeningFunctionType::BOUNCE: return BounceFunction(t);
+        case TweeningFunctionType::ELASTIC: return ElasticFunction(t);
+        case TweeningFunctionType::CUSTOM: assert(false); break;
+    }
+    
+    return t;
+}
+
+///-----------------------------------------------------------------------------------------------
+/// Tweens the given value based on a built-in tweening function and the tweening mode.
+/// Produces the exact same results as the std::function overload. \see TweenValue()
+/// @param[in] val the value to be tweened in [0..1] range.
+/// @param[in] tweeningFunctionType the built-in tweening function to be used.
+/// @param[in] tweeningMode the tweening mode.
+/// @returns the tweened value.
+inline float TweenValue(const float val, const TweeningFunctionType tweeningFunctionType, const TweeningMode tweeningMode)
+{
+    switch (tweeningMode)
+    {
+        case TweeningMode::EASE_IN: return EvaluateTweeningFunction(tweeningFunctionType, val);
+        case TweeningMode::EASE_OUT: return 1.0f - EvaluateTweeningFunction(tweeningFunctionType, 1.0f - val);
+        case TweeningMode::EASE_IN_OUT: return (val < 0.5f) ? EvaluateTweeningFunction(tweeningFunctionType, val * 2.0f)/2.0f : 0.5f + ((1.0f - EvaluateTweeningFunction(tweeningFunctionType, 1.0f - (val - 0.5f) * 2.0f))/2.0f);
+    }
+    
+    return 0.0f;
+}
+
 ///-----------------------------------------------------------------------------------------------
 /// Gets the custom  seed for a controlled sequence of generated random numbers.
 /// @returns the control seed that the random generation sequence will continue with/
@@ -382,10 +457,22 @@ float ControlledRandomFloat(const float min = 0.0f, const float max = 1.0f);
 int ControlledIndexSelectionFromDistribution(const ProbabilityDistribution& probDist);
 
 ///-----------------------------------------------------------------------------------------------
-/// Returns a mersenne_twister_engine
+/// Returns the calling thread's mersenne_twister_engine
 /// @returns the rng engine
 std::mt19937& GetRandomEngine();
 
+///-----------------------------------------------------------------------------------------------
+/// Computes a random int based on the min and max inclusive values provided, drawn from the given engine.
+/// @param[in] randomEngine the rng engine to draw from.
+/// @param[in] min the minimum value (inclusive) that the function can return (defaults to 0).
+/// @param[in] max the maximum value (inclusive) that the function can return (defaults to 32767).
+/// @returns a random integer that respects the given bounds.
+inline int RandomInt(std::mt19937& randomEngine, const int min = 0, const int max = RAND_MAX)
+{
+    std::uniform_int_distribution<> distr(min, max);
+    return distr(randomEngine);
+}
+
 ///-----------------------------------------------------------------------------------------------
 /// Computes a random int based on the min and max inclusive values provided.
 /// @param[in] min the minimum value (inclusive) that the function can return (defaults to 0).
@@ -393,8 +480,18 @@ std::mt19937& GetRandomEngine();
 /// @returns a random integer that respects the given bounds.
 inline int RandomInt(const int min = 0, const int max = RAND_MAX)
 {
-    std::uniform_int_distribution<> distr(min, max);
-    return distr(GetRandomEngine());
+    return RandomInt(GetRandomEngine(), min, max);
+}
+
+///-----------------------------------------------------------------------------------------------
+/// Computes a random float based on the min and max inclusive values provided, drawn from the given engine.
+/// @param[in] randomEngine the rng engine to draw from.
+/// @param[in] min the minimum value (inclusive) that the function can return (defaults to 0.0f).
+/// @param[in] max the maximum value (inclusive) that the function can return (defaults to 1.0f).
+/// @returns a random float that respects the given bounds.
+inline float RandomFloat(std::mt19937& randomEngine, const float min = 0.0f, const float max = 1.0f)
+{
+    return min + static_cast <float> (RandomInt(randomEngine)) / (static_cast <float> (RAND_MAX / (max - min)));
 }
 
 ///-----------------------------------------------------------------------------------------------
@@ -404,7 +501,7 @@ inline int RandomInt(const int min = 0, const int max = RAND_MAX)
 /// @returns a random float that respects the given bounds.
 inline float RandomFloat(const float min = 0.0f, const float max = 1.0f)
 {
-    return min + static_cast <float> (RandomInt()) / (static_cast <float> (RAND_MAX / (max - min)));
+    return RandomFloat(GetRandomEngine(), min, max);
 }
 
 ///-----------------------------------------------------------------------------------------------
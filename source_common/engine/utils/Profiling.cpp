@@ -0,0 +1,248 @@
+///------------------------------------------------------------------------------------------------
+///  Profiling.cpp
+///  Predators
+///
+///  Created by Alex Koukoulas on 23/04/2024
+///------------------------------------------------------------------------------------------------
+
+#include <engine/utils/Logging.h>
+#include <engine/utils/Profiling.h>
+#include <nlohmann/json.hpp>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+///------------------------------------------------------------------------------------------------
+
+namespace profiling
+{
+
+///------------------------------------------------------------------------------------------------
+
+// Several seconds worth of zones per thread at the engine's usual zone count per frame
+static constexpr std::uint64_t ZONE_RING_BUFFER_CAPACITY = 1 << 14;
+
+///------------------------------------------------------------------------------------------------
+
+// Fields are atomic since exports may read a zone while its thread is overwriting it.
+// Such (potentially torn) zones are detected and dropped by the export instead.
+struct RecordedZone
+{
+    std::atomic<const char*> mZoneName{nullptr};
+    std::atomic<std::int64_t> mStartNanos{0};
+    std::atomic<std::int64_t> mDurationNanos{0};
+};
+
+///------------------------------------------------------------------------------------------------
+
+// Single producer ring buffer, only ever written to by the thread (or track recorder) owning it
+struct ThreadZoneBuffer
+{
+    explicit ThreadZoneBuffer(const int threadIndex)
+        : mZones(ZONE_RING_BUFFER_CAPACITY)
+        , mThreadIndex(threadIndex)
+    {
+    }
+    
+    std::vector<RecordedZone> mZones;
+    std::atomic<std::uint64_t> mWriteCount{0};
+    std::string mThreadName;
+    const int mThreadIndex;
+};
+
+///------------------------------------------------------------------------------------------------
+
+class ProfilingRegistry final
+{
+public:
+    static ProfilingRegistry& GetInstance()
+    {
+        // Intentionally leaked, as detached threads may still record zones during static destruction
+        static auto* instance = new ProfilingRegistry();
+        return *instance;
+    }
+    
+    ThreadZoneBuffer& GetCurrentThreadZoneBuffer()
+    {
+        // Registration is the only time a recording thread takes the lock
+        thread_local ThreadZoneBuffer* threadZoneBuffer = nullptr;
+        if (!threadZoneBuffer)
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            threadZoneBuffer = &CreateZoneBuffer();
+        }
+        return *threadZoneBuffer;
+    }
+    
+    TrackId CreateTrack(const std::string& trackName)
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        auto& trackZoneBuffer = CreateZoneBuffer();
+        trackZoneBuffer.mThreadName = trackName;
+        return trackZoneBuffer.mThreadIndex;
+    }
+    
+    ThreadZoneBuffer& GetTrackZoneBuffer(const TrackId trackId)
+    {
+        // Buffers are never removed, so a track's buffer can be used outside of the lock once found
+        std::lock_guard<std::mutex> lock(mMutex);
+        return *mThreadZoneBuffers.at(trackId);
+    }
+    
+    void SetThreadName(ThreadZoneBuffer& threadZoneBuffer, const std::string& threadName)
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        threadZoneBuffer.mThreadName = threadName;
+    }
+    
+    nlohmann::json CollectTraceEvents()
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        
+        auto traceEvents = nlohmann::json::array();
+        for (const auto& threadZoneBuffer: mThreadZoneBuffers)
+        {
+            if (!threadZoneBuffer->mThreadName.empty())
+            {
+                traceEvents.push_back({ {"name", "thread_name"}, {"ph", "M"}, {"pid", 0}, {"tid", threadZoneBuffer->mThreadIndex}, {"args", { {"name", threadZoneBuffer->mThreadName} }} });
+            }
+            
+            const auto writeCount = threadZoneBuffer->mWriteCount.load(std::memory_order_acquire);
+            const auto firstZoneIndex = writeCount > ZONE_RING_BUFFER_CAPACITY ? writeCount - ZONE_RING_BUFFER_CAPACITY : 0;
+            
+            std::vector<std::pair<std::uint64_t, nlohmann::json>> zoneEvents;
+            for (auto zoneIndex = firstZoneIndex; zoneIndex < writeCount; ++zoneIndex)
+            {
+                const auto& zone = threadZoneBuffer->mZones[zoneIndex % ZONE_RING_BUFFER_CAPACITY];
+                const auto* zoneName = zone.mZoneName.load(std::memory_order_relaxed);
+                const auto startNanos = zone.mStartNanos.load(std::memory_order_relaxed);
+                const auto durationNanos = zone.mDurationNanos.load(std::memory_order_relaxed);
+                zoneEvents.emplace_back(zoneIndex, nlohmann::json{ {"name", zoneName}, {"ph", "X"}, {"pid", 0}, {"tid", threadZoneBuffer->mThreadIndex}, {"ts", startNanos/1000.0}, {"dur", durationNanos/1000.0} });
+            }
+            
+            // Zones whose slots the owning thread started reusing while they were being read may be torn
+            std::atomic_thread_fence(std::memory_order_acquire);
+            const auto latestWriteCount = threadZoneBuffer->mWriteCount.load(std::memory_order_relaxed);
+            for (auto& zoneEvent: zoneEvents)
+            {
+                if (zoneEvent.first + ZONE_RING_BUFFER_CAPACITY > latestWriteCount)
+                {
+                    traceEvents.push_back(std::move(zoneEvent.second));
+                }
+            }
+        }
+        
+        return traceEvents;
+    }
+    
+public:
+    std::atomic<bool> mEnabled{false};
+    
+private:
+    ThreadZoneBuffer& CreateZoneBuffer()
+    {
+        mThreadZoneBuffers.push_back(std::make_unique<ThreadZoneBuffer>(static_cast<int>(mThreadZoneBuffers.size())));
+        return *mThreadZoneBuffers.back();
+    }
+    
+private:
+    std::mutex mMutex;
+    std::vector<std::unique_ptr<ThreadZoneBuffer>> mThreadZoneBuffers;
+};
+
+///------------------------------------------------------------------------------------------------
+
+void SetEnabled(const bool enabled)
+{
+    ProfilingRegistry::GetInstance().mEnabled.store(enabled, std::memory_order_relaxed);
+}
+
+///------------------------------------------------------------------------------------------------
+
+bool IsEnabled()
+{
+    return ProfilingRegistry::GetInstance().mEnabled.load(std::memory_order_relaxed);
+}
+
+///------------------------------------------------------------------------------------------------
+
+void SetCurrentThreadName(const std::string& threadName)
+{
+    auto& registry = ProfilingRegistry::GetInstance();
+    registry.SetThreadName(registry.GetCurrentThreadZoneBuffer(), threadName);
+}
+
+///------------------------------------------------------------------------------------------------
+
+std::int64_t GetNowNanos()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+///------------------------------------------------------------------------------------------------
+
+static void AppendZone(ThreadZoneBuffer& zoneBuffer, const char* zoneName, const std::int64_t startNanos, const std::int64_t durationNanos)
+{
+    const auto writeCount = zoneBuffer.mWriteCount.load(std::memory_order_relaxed);
+    auto& zone = zoneBuffer.mZones[writeCount % ZONE_RING_BUFFER_CAPACITY];
+    zone.mZoneName.store(zoneName, std::memory_order_relaxed);
+    zone.mStartNanos.store(startNanos, std::memory_order_relaxed);
+    zone.mDurationNanos.store(durationNanos, std::memory_order_relaxed);
+    zoneBuffer.mWriteCount.store(writeCount + 1, std::memory_order_release);
+}
+
+///------------------------------------------------------------------------------------------------
+
+void RecordZone(const char* zoneName, const std::int64_t startNanos, const std::int64_t durationNanos)
+{
+    AppendZone(ProfilingRegistry::GetInstance().GetCurrentThreadZoneBuffer(), zoneName, startNanos, durationNanos);
+}
+
+///------------------------------------------------------------------------------------------------
+
+TrackId CreateTrack(const std::string& trackName)
+{
+    return ProfilingRegistry::GetInstance().CreateTrack(trackName);
+}
+
+///------------------------------------------------------------------------------------------------
+
+void RecordZone(const TrackId trackId, const char* zoneName, const std::int64_t startNanos, const std::int64_t durationNanos)
+{
+    AppendZone(ProfilingRegistry::GetInstance().GetTrackZoneBuffer(trackId), zoneName, startNanos, durationNanos);
+}
+
+///------------------------------------------------------------------------------------------------
+
+std::string ExportChromeTrace()
+{
+    nlohmann::json trace;
+    trace["traceEvents"] = ProfilingRegistry::GetInstance().CollectTraceEvents();
+    trace["displayTimeUnit"] = "ms";
+    return trace.dump();
+}
+
+///------------------------------------------------------------------------------------------------
+
+bool WriteChromeTrace(const std::string& filePath)
+{
+    std::ofstream file(filePath, std::ios::out | std::ios::trunc);
+    if (!file.good())
+    {
+        LOG(logging::LogType::ERROR, "Could not open %s for writing the profiling trace", filePath.c_str());
+        return false;
+    }
+    
+    file << ExportChromeTrace();
+    LOG(logging::LogType::INFO, "Wrote profiling trace to %s", filePath.c_str());
+    return true;
+}
+
+///------------------------------------------------------------------------------------------------
+
+}
+
+///------------------------------------------------------------------------------------------------
@@ -0,0 +1,93 @@
+///------------------------------------------------------------------------------------------------
+///  Profiling.h
+///  Predators
+///
+///  Created by Alex Koukoulas on 23/04/2024
+///------------------------------------------------------------------------------------------------
+
+#ifndef Profiling_h
+#define Profiling_h
+
+///------------------------------------------------------------------------------------------------
+
+#include <cstdint>
+#include <string>
+
+///------------------------------------------------------------------------------------------------
+
+namespace profiling
+{
+
+///------------------------------------------------------------------------------------------------
+/// Zone recording is off by default. While off, a zone costs a single relaxed atomic load.
+void SetEnabled(const bool enabled);
+[[nodiscard]] bool IsEnabled();
+
+///------------------------------------------------------------------------------------------------
+/// Names the calling thread's track in exported traces.
+void SetCurrentThreadName(const std::string& threadName);
+
+///------------------------------------------------------------------------------------------------
+/// Nanoseconds on the monotonic clock all zones are timed with.
+[[nodiscard]] std::int64_t GetNowNanos();
+
+///------------------------------------------------------------------------------------------------
+/// Appends an already timed zone to the calling thread's ring buffer. Only the most recent
+/// zones of each thread are kept, so older ones are silently overwritten.
+/// @param[in] zoneName must outlive the profiler (string literals, interned StringId strings etc.)
+void RecordZone(const char* zoneName, const std::int64_t startNanos, const std::int64_t durationNanos);
+
+///------------------------------------------------------------------------------------------------
+/// Virtual tracks hold zones not timed by a CPU thread's scopes (e.g. GPU timer query results).
+/// Each track must only ever be recorded to from a single thread.
+using TrackId = int;
+
+[[nodiscard]] TrackId CreateTrack(const std::string& trackName);
+void RecordZone(const TrackId trackId, const char* zoneName, const std::int64_t startNanos, const std::int64_t durationNanos);
+
+///------------------------------------------------------------------------------------------------
+/// Serializes the zones currently held by all threads' ring buffers as a Chrome trace
+/// (loadable in about:tracing or ui.perfetto.dev).
+[[nodiscard]] std::string ExportChromeTrace();
+bool WriteChromeTrace(const std::string& filePath);
+
+///------------------------------------------------------------------------------------------------
+/// Times the enclosing scope, if profiling was enabled when the zone was entered.
+class ScopedZone final
+{
+public:
+    explicit ScopedZone(const char* zoneName)
+        : mZoneName(IsEnabled() ? zoneName : nullptr)
+        , mStartNanos(mZoneName ? GetNowNanos() : 0)
+    {
+    }
+    
+    ~ScopedZone()
+    {
+        if (mZoneName)
+        {
+            RecordZone(mZoneName, mStartNanos, GetNowNanos() - mStartNanos);
+        }
+    }
+    
+    ScopedZone(const ScopedZone&) = delete;
+    ScopedZone& operator = (const ScopedZone&) = delete;
+    
+private:
+    const char* mZoneName;
+    std::int64_t mStartNanos;
+};
+
+///------------------------------------------------------------------------------------------------
+
+#define PROFILING_CONCAT_INNER(a, b) a##b
+#define PROFILING_CONCAT(a, b) PROFILING_CONCAT_INNER(a, b)
+#define PROFILE_SCOPE(zoneName) profiling::ScopedZone PROFILING_CONCAT(profilingScopedZone, __LINE__)(zoneName)
+
+///------------------------------------------------------------------------------------------------
+
+}
+
+///------------------------------------------------------------------------------------------------
+
+#endif /* Profiling_h */
@@ -10,6 +10,13 @@
 
 ///------------------------------------------------------------------------------------------------
 
+#include <engine/utils/PlatformMacros.h>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+///------------------------------------------------------------------------------------------------
+
 namespace serial
 {
 
@@ -23,6 +30,61 @@ enum class DataFileType
 
 ///------------------------------------------------------------------------------------------------
 
+enum class DataFileFormat
+{
+    JSON,   // Pretty printed json followed by an &<string hash> checksum
+    BINARY  // Header (magic, version, CRC32 of payload) followed by a MessagePack payload
+};
+
+///------------------------------------------------------------------------------------------------
+/// Persistence files are uploaded as-is to CloudKit on Apple platforms (which expects json),
+/// so the binary format is only the default for release Windows builds.
+#if defined(WINDOWS) && !defined(_DEBUG)
+inline constexpr DataFileFormat DEFAULT_PERSISTENCE_DATA_FILE_FORMAT = DataFileFormat::BINARY;
+#else
+inline constexpr DataFileFormat DEFAULT_PERSISTENCE_DATA_FILE_FORMAT = DataFileFormat::JSON;
+#endif
+
+inline constexpr char BINARY_DATA_FILE_MAGIC[4] = { 'P', 'R', 'D', 'F' };
+inline constexpr uint8_t BINARY_DATA_FILE_VERSION = 1;
+inline constexpr size_t BINARY_DATA_FILE_HEADER_SIZE = sizeof(BINARY_DATA_FILE_MAGIC) + sizeof(BINARY_DATA_FILE_VERSION) + sizeof(uint32_t);
+
+///------------------------------------------------------------------------------------------------
+
+inline const char* GetDataFileExtension(const DataFileFormat dataFileFormat)
+{
+    return dataFileFormat == DataFileFormat::BINARY ? ".bin" : ".json";
+}
+
+///------------------------------------------------------------------------------------------------
+
+inline uint32_t ComputeCrc32(const uint8_t* data, const size_t size)
+{
+    static const auto sCrc32Table = []
+    {
+        std::array<uint32_t, 256> table = {};
+        for (uint32_t i = 0; i < table.size(); ++i)
+        {
+            auto crc = i;
+            for (int bit = 0; bit < 8; ++bit)
+            {
+                crc = (crc & 1) ? (crc >> 1) ^ 0xEDB88320u : (crc >> 1);
+            }
+            table[i] = crc;
+        }
+        return table;
+    }();
+    
+    uint32_t crc = 0xFFFFFFFFu;
+    for (size_t i = 0; i < size; ++i)
+    {
+        crc = sCrc32Table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+    }
+    return crc ^ 0xFFFFFFFFu;
+}
+
+///------------------------------------------------------------------------------------------------
+
 }
 
 ///------------------------------------------------------------------------------------------------
@@ -11,12 +11,18 @@
 ///-----------------------------------------------------------------------------------------------
 
 #include <cassert>
+#include <engine/utils/Logging.h>
 #include <algorithm>
 #include <cctype>
+#include <cstdint>
 #include <iomanip>
+#include <mutex>
 #include <regex>
+#include <shared_mutex>
 #include <sstream>
 #include <string>
+#include <string_view>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -30,10 +36,10 @@ namespace strutils
 static std::hash<std::string> hashFunction;
 
 ///-----------------------------------------------------------------------------------------------
-/// Compute a unique hash for a given string.
+/// Compute a unique hash for a given string. Usable at compile time for string literals.
 /// @param[in] s the input string.
 /// @returns the hashed input string.
-inline uint32_t GetStringHash(const std::string& s)
+inline constexpr uint32_t GetStringHash(const std::string_view s)
 {
     uint32_t result = 0;
     for (auto c: s)
@@ -245,40 +251,139 @@ inline std::string FloatToString(const float val, const int decimalPlaces)
 }
 
 ///-----------------------------------------------------------------------------------------------
-/// Provides a unique identifier for a string, aimed at optimizing string comparisons
+/// Process-wide, thread-safe table of all strings that StringIds have been created from, keyed
+/// by their hash. Entries are never removed, so references to interned strings stay valid for
+/// the lifetime of the process. Recently used entries are cached per thread, so that repeated
+/// interning and resolving of the same ids doesn't lock. Hash collisions assert in debug builds.
+class StringIdTable final
+{
+public:
+    static StringIdTable& GetInstance()
+    {
+        // Intentionally leaked so that StringIds remain resolvable during static destruction
+        static auto* instance = new StringIdTable();
+        return *instance;
+    }
+    
+    void Intern(const uint32_t stringId, const std::string_view str)
+    {
+        auto* internedString = FindInternedString(stringId);
+        if (!internedString)
+        {
+            std::unique_lock<std::shared_mutex> lock(mMutex);
+            internedString = &mInternedStrings.try_emplace(stringId, str).first->second;
+            GetThreadCacheEntry(stringId) = { stringId, internedString };
+        }
+        
+    #if !defined(NDEBUG)
+        if (*internedString != str)
+        {
+            LOG(logging::LogType::ERROR, "StringId hash collision between \"%s\" and \"%s\"", internedString->c_str(), std::string(str).c_str());
+            assert(false);
+        }
+    #endif
+    }
+    
+    const std::string& Resolve(const uint32_t stringId) const
+    {
+        auto* internedString = FindInternedString(stringId);
+        return internedString ? *internedString : *mEmptyString;
+    }
+    
+private:
+    struct ThreadCacheEntry
+    {
+        uint32_t mStringId;
+        const std::string* mString;
+    };
+    
+    static constexpr uint32_t THREAD_CACHE_SIZE = 256;
+    
+    StringIdTable()
+    {
+        mEmptyString = &mInternedStrings.try_emplace(0, "").first->second;
+    }
+    
+    static ThreadCacheEntry& GetThreadCacheEntry(const uint32_t stringId)
+    {
+        // Trivially destructible, so it stays usable during static destruction too
+        static thread_local ThreadCacheEntry threadCache[THREAD_CACHE_SIZE] = {};
+        return threadCache[stringId & (THREAD_CACHE_SIZE - 1)];
+    }
+    
+    const std::string* FindInternedString(const uint32_t stringId) const
+    {
+        auto& threadCacheEntry = GetThreadCacheEntry(stringId);
+        if (threadCacheEntry.mString && threadCacheEntry.mStringId == stringId)
+        {
+            return threadCacheEntry.mString;
+        }
+        
+        std::shared_lock<std::shared_mutex> lock(mMutex);
+        auto findIter = mInternedStrings.find(stringId);
+        if (findIter == mInternedStrings.end())
+        {
+            return nullptr;
+        }
+        
+        threadCacheEntry = { stringId, &findIter->second };
+        return threadCacheEntry.mString;
+    }
+    
+private:
+    mutable std::shared_mutex mMutex;
+    std::unordered_map<uint32_t, std::string> mInternedStrings;
+    const std::string* mEmptyString;
+};
+
+///-----------------------------------------------------------------------------------------------
+/// Provides a unique identifier for a string, aimed at optimizing string comparisons.
+/// Only the 4-byte id (the string's hash) is stored; the string itself lives in the
+/// StringIdTable and is only looked up when requested via GetString.
 class StringId final
 {
 public:
-    StringId()
-    : mString("")
-    , mStringId(0)
+    constexpr StringId()
+    : mStringId(0)
     {
     }
     
     explicit StringId(const std::string& str)
-    : mString(str)
-    , mStringId(GetStringHash(str))
+    : mStringId(GetStringHash(str))
+    {
+        StringIdTable::GetInstance().Intern(mStringId, str);
+    }
+    
+    /// Literals are hashed at compile time. StringIds created in constant expressions are not
+    /// interned though, so they only resolve via GetString once the same string has been
+    /// interned at runtime.
+    template<std::size_t N>
+    constexpr explicit StringId(const char (&literal)[N])
+    : mStringId(GetStringHash(std::string_view(literal)))
     {
+        if (!__builtin_is_constant_evaluated())
+        {
+            StringIdTable::GetInstance().Intern(mStringId, std::string_view(literal));
+        }
     }
     
     operator uint32_t () { return mStringId; }
     bool operator < (const StringId& rhs) { return mStringId < rhs.GetStringId(); }
     
     bool isEmpty() const { return mStringId == 0; }
-    const std::string& GetString() const { return mString; }
-    uint32_t GetStringId() const { return mStringId; }
+    const std::string& GetString() const { return StringIdTable::GetInstance().Resolve(mStringId); }
+    constexpr uint32_t GetStringId() const { return mStringId; }
     
+    /// Address ids are not interned, as they would pile up in the table, so they don't
+    /// resolve via GetString.
     void fromAddress(const void* address)
     {
-        std::stringstream ss;
-        ss << address;
-        mString = ss.str();
-        mStringId = GetStringHash(mString);
+        const auto addressValue = static_cast<uint64_t>(reinterpret_cast<std::uintptr_t>(address));
+        mStringId = static_cast<uint32_t>(addressValue ^ (addressValue >> 32));
     }
     
 private:
-    std::string mString;
-    uint32_t    mStringId;
+    uint32_t mStringId;
 };
 
 ///-----------------------------------------------------------------------------------------------
@@ -391,7 +391,7 @@ void AchievementManager::OnAchievementUnlockedTrigger(const events::AchievementU
     // Achievement definition not found
     if (mAchievementDefinitions.count(event.mAchievementName) == 0)
     {
-        logging::Log(logging::LogType::ERROR, "Tried to surface unknown achievement %s", event.mAchievementName.GetString().c_str());
+        LOG(logging::LogType::ERROR, "Tried to surface unknown achievement %s", event.mAchievementName.GetString().c_str());
         assert(false);
         return;
     }
@@ -10,8 +10,10 @@
 
 ///------------------------------------------------------------------------------------------------
 
+#include <cstdint>
 #include <string>
 #include <unordered_set>
+#include <utility>
 
 ///------------------------------------------------------------------------------------------------
 
@@ -39,6 +41,48 @@ namespace board_modifier_masks
     static constexpr EffectBoardModifierMask SPELL_KILL_NEXT                       = 0x1000;
 };
 
+///------------------------------------------------------------------------------------------------
+// Effect component traits, precomputed per card at load time (see ComputeEffectComponentMask)
+using EffectComponentMask = uint64_t;
+namespace effect_component_masks
+{
+    static constexpr EffectComponentMask NONE                                  = 0x0;
+    static constexpr EffectComponentMask DAMAGE                                = 0x1ULL;
+    static constexpr EffectComponentMask WEIGHT                                = 0x2ULL;
+    static constexpr EffectComponentMask FAMILY                                = 0x4ULL;
+    static constexpr EffectComponentMask ENEMY_BOARD_DEBUFF                    = 0x8ULL;
+    static constexpr EffectComponentMask DRAW                                  = 0x10ULL;
+    static constexpr EffectComponentMask GAIN_1_WEIGHT                         = 0x20ULL;
+    static constexpr EffectComponentMask GAIN_2_WEIGHT                         = 0x40ULL;
+    static constexpr EffectComponentMask CARD_TOKEN                            = 0x80ULL;
+    static constexpr EffectComponentMask KILL                                  = 0x100ULL;
+    static constexpr EffectComponentMask DEMON_KILL                            = 0x200ULL;
+    static constexpr EffectComponentMask BOARD                                 = 0x400ULL;
+    static constexpr EffectComponentMask HELD                                  = 0x800ULL;
+    static constexpr EffectComponentMask DUPLICATE_INSECT                      = 0x1000ULL;
+    static constexpr EffectComponentMask CLEAR_EFFECTS                         = 0x2000ULL;
+    static constexpr EffectComponentMask DOUBLE_NEXT_DINO_DAMAGE               = 0x4000ULL;
+    static constexpr EffectComponentMask DOUBLE_POISON_ATTACKS                 = 0x8000ULL;
+    static constexpr EffectComponentMask PERMANENT_CONTINUAL_WEIGHT_REDUCTION  = 0x10000ULL;
+    static constexpr EffectComponentMask DIG_NO_FAIL                           = 0x20000ULL;
+    static constexpr EffectComponentMask DRAW_RANDOM_SPELL                     = 0x40000ULL;
+    static constexpr EffectComponentMask ARMOR                                 = 0x80000ULL;
+    static constexpr EffectComponentMask TOXIC_BOMB                            = 0x100000ULL;
+    static constexpr EffectComponentMask DEMON_PUNCH                           = 0x200000ULL;
+    static constexpr EffectComponentMask RODENT_LIFESTEAL_ON_ATTACKS           = 0x400000ULL;
+    static constexpr EffectComponentMask HEAL_NEXT_DINO_DAMAGE                 = 0x800000ULL;
+    static constexpr EffectComponentMask INSECT_MEGASWARM                      = 0x1000000ULL;
+    static constexpr EffectComponentMask INSECT_VIRUS                          = 0x2000000ULL;
+    static constexpr EffectComponentMask HOUND_SUMMONING                       = 0x4000000ULL;
+    static constexpr EffectComponentMask METEOR                                = 0x8000000ULL;
+    static constexpr EffectComponentMask EVERY_THIRD_CARD_PLAYED_HAS_ZERO_COST = 0x10000000ULL;
+    static constexpr EffectComponentMask ADD_POISON_STACKS                     = 0x20000000ULL;
+    static constexpr EffectComponentMask RANDOM_HAND_BUFF_ATTACK               = 0x40000000ULL;
+    static constexpr EffectComponentMask TRIPPLES_LOWEST_ATTACK_ON_HAND        = 0x80000000ULL;
+    static constexpr EffectComponentMask SWAP_MIN_MAX_DAMAGE                   = 0x100000000ULL;
+    static constexpr EffectComponentMask SPELL_KILL                            = 0x200000000ULL;
+};
+
 
 // Effect components
 inline const std::string EFFECT_COMPONENT_DAMAGE                                = "DAMAGE";
@@ -114,6 +158,61 @@ inline const std::unordered_set<std::string> STATIC_EFFECT_COMPONENT_NAMES =
     EFFECT_COMPONENT_SPELL_KILL
 };
 
+///------------------------------------------------------------------------------------------------
+// A component's bit is set if its name appears anywhere in the effect string, matching the
+// substring checks this replaces (e.g. a DRAW_RANDOM_SPELL effect also carries the DRAW bit).
+inline EffectComponentMask ComputeEffectComponentMask(const std::string& effect)
+{
+    static const std::pair<std::string, EffectComponentMask> EFFECT_COMPONENT_MASK_ENTRIES[] =
+    {
+        { EFFECT_COMPONENT_DAMAGE, effect_component_masks::DAMAGE },
+        { EFFECT_COMPONENT_WEIGHT, effect_component_masks::WEIGHT },
+        { EFFECT_COMPONENT_FAMILY, effect_component_masks::FAMILY },
+        { EFFECT_COMPONENT_ENEMY_BOARD_DEBUFF, effect_component_masks::ENEMY_BOARD_DEBUFF },
+        { EFFECT_COMPONENT_DRAW, effect_component_masks::DRAW },
+        { EFFECT_COMPONENT_GAIN_1_WEIGHT, effect_component_masks::GAIN_1_WEIGHT },
+        { EFFECT_COMPONENT_GAIN_2_WEIGHT, effect_component_masks::GAIN_2_WEIGHT },
+        { EFFECT_COMPONENT_CARD_TOKEN, effect_component_masks::CARD_TOKEN },
+        { EFFECT_COMPONENT_KILL, effect_component_masks::KILL },
+        { EFFECT_COMPONENT_DEMON_KILL, effect_component_masks::DEMON_KILL },
+        { EFFECT_COMPONENT_BOARD, effect_component_masks::BOARD },
+        { EFFECT_COMPONENT_HELD, effect_component_masks::HELD },
+        { EFFECT_COMPONENT_DUPLICATE_INSECT, effect_component_masks::DUPLICATE_INSECT },
+        { EFFECT_COMPONENT_CLEAR_EFFECTS, effect_component_masks::CLEAR_EFFECTS },
+        { EFFECT_COMPONENT_DOUBLE_NEXT_DINO_DAMAGE, effect_component_masks::DOUBLE_NEXT_DINO_DAMAGE },
+        { EFFECT_COMPONENT_DOUBLE_POISON_ATTACKS, effect_component_masks::DOUBLE_POISON_ATTACKS },
+        { EFFECT_COMPONENT_PERMANENT_CONTINUAL_WEIGHT_REDUCTION, effect_component_masks::PERMANENT_CONTINUAL_WEIGHT_REDUCTION },
+        { EFFECT_COMPONENT_DIG_NO_FAIL, effect_component_masks::DIG_NO_FAIL },
+        { EFFECT_COMPONENT_DRAW_RANDOM_SPELL, effect_component_masks::DRAW_RANDOM_SPELL },
+        { EFFECT_COMPONENT_ARMOR, effect_component_masks::ARMOR },
+        { EFFECT_COMPONENT_TOXIC_BOMB, effect_component_masks::TOXIC_BOMB },
+        { EFFECT_COMPONENT_DEMON_PUNCH, effect_component_masks::DEMON_PUNCH },
+        { EFFECT_COMPONENT_RODENT_LIFESTEAL_ON_ATTACKS, effect_component_masks::RODENT_LIFESTEAL_ON_ATTACKS },
+        { EFFECT_COMPONENT_HEAL_NEXT_DINO_DAMAGE, effect_component_masks::HEAL_NEXT_DINO_DAMAGE },
+        { EFFECT_COMPONENT_INSECT_MEGASWARM, effect_component_masks::INSECT_MEGASWARM },
+        { EFFECT_COMPONENT_INSECT_VIRUS, effect_component_masks::INSECT_VIRUS },
+        { EFFECT_COMPONENT_HOUND_SUMMONING, effect_component_masks::HOUND_SUMMONING },
+        { EFFECT_COMPONENT_METEOR, effect_component_masks::METEOR },
+        { EFFECT_COMPONENT_EVERY_THIRD_CARD_PLAYED_HAS_ZERO_COST, effect_component_masks::EVERY_THIRD_CARD_PLAYED_HAS_ZERO_COST },
+        { EFFECT_COMPONENT_ADD_POISON_STACKS, effect_component_masks::ADD_POISON_STACKS },
+        { EFFECT_COMPONENT_RANDOM_HAND_BUFF_ATTACK, effect_component_masks::RANDOM_HAND_BUFF_ATTACK },
+        { EFFECT_COMPONENT_TRIPPLES_LOWEST_ATTACK_ON_HAND, effect_component_masks::TRIPPLES_LOWEST_ATTACK_ON_HAND },
+        { EFFECT_COMPONENT_SWAP_MIN_MAX_DAMAGE, effect_component_masks::SWAP_MIN_MAX_DAMAGE },
+        { EFFECT_COMPONENT_SPELL_KILL, effect_component_masks::SPELL_KILL }
+    };
+    
+    EffectComponentMask effectComponentMask = effect_component_masks::NONE;
+    for (const auto& effectComponentMaskEntry: EFFECT_COMPONENT_MASK_ENTRIES)
+    {
+        if (effect.find(effectComponentMaskEntry.first) != std::string::npos)
+        {
+            effectComponentMask |= effectComponentMaskEntry.second;
+        }
+    }
+    
+    return effectComponentMask;
+}
+
 ///------------------------------------------------------------------------------------------------
 
 }
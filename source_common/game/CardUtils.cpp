@@ -182,7 +182,7 @@ std::shared_ptr<CardSoWrapper> CreateCardSoWrapper
         cardComponents.back()->mRotation.z = math::PI;
         
         // Create portrait
-        cardComponents.push_back(std::make_shared<scene::SceneObject>());
+        cardComponents.push_back(scene.CreateDetachedSceneObject());
         cardComponents.back()->mTextureResourceId = cardData->mCardTextureResourceId;
         cardComponents.back()->mShaderResourceId = cardData->mCardShaderResourceId;
         cardComponents.back()->mScale.x = cardComponents.back()->mScale.y = game_constants::IN_GAME_CARD_PORTRAIT_SCALE;
@@ -197,7 +197,7 @@ std::shared_ptr<CardSoWrapper> CreateCardSoWrapper
         if (cardData->IsSpell())
         {
             // Create weight icon
-            cardComponents.push_back(std::make_shared<scene::SceneObject>());
+            cardComponents.push_back(scene.CreateDetachedSceneObject());
             cardComponents.back()->mTextureResourceId = resService.LoadResource(resources::ResourceLoadingService::RES_TEXTURES_ROOT + CARD_WEIGHT_ICON_TEXTURE_FILE_NAME);
             cardComponents.back()->mScale.x = cardComponents.back()->mScale.y = game_constants::IN_GAME_CARD_PROPERTY_ICON_SCALE;
             cardComponents.back()->mBoundingRectMultiplier.x = game_constants::CARD_BOUNDING_RECT_X_MULTIPLIER;
@@ -207,7 +207,7 @@ std::shared_ptr<CardSoWrapper> CreateCardSoWrapper
             cardComponents.back()->mPosition.z += 2 * game_constants::CARD_COMPONENT_Z_OFFSET;
             
             // Create weight
-            cardComponents.push_back(std::make_shared<scene::SceneObject>());
+            cardComponents.push_back(scene.CreateDetachedSceneObject());
             scene::TextSceneObjectData weightTextData;
             weightTextData.mFontName = game_constants::FONT_PLACEHOLDER_WEIGHT_NAME;
             
@@ -228,7 +228,7 @@ std::shared_ptr<CardSoWrapper> CreateCardSoWrapper
         else
         {
             // Create damage icon
-            cardComponents.push_back(std::make_shared<scene::SceneObject>());
+            cardComponents.push_back(scene.CreateDetachedSceneObject());
             cardComponents.back()->mTextureResourceId = resService.LoadResource(resources::ResourceLoadingService::RES_TEXTURES_ROOT + CARD_DAMAGE_ICON_TEXTURE_FILE_NAME);
             cardComponents.back()->mScale.x = cardComponents.back()->mScale.y = game_constants::IN_GAME_CARD_PROPERTY_ICON_SCALE;
             cardComponents.back()->mBoundingRectMultiplier.x = game_constants::CARD_BOUNDING_RECT_X_MULTIPLIER;
@@ -238,7 +238,7 @@ std::shared_ptr<CardSoWrapper> CreateCardSoWrapper
             cardComponents.back()->mPosition.z += 2 * game_constants::CARD_COMPONENT_Z_OFFSET;
             
             // Create damage
-            cardComponents.push_back(std::make_shared<scene::SceneObject>());
+            cardComponents.push_back(scene.CreateDetachedSceneObject());
             scene::TextSceneObjectData damageTextData;
             damageTextData.mFontName = game_constants::FONT_PLACEHOLDER_DAMAGE_NAME;
             
@@ -258,7 +258,7 @@ std::shared_ptr<CardSoWrapper> CreateCardSoWrapper
             // Create poison indicator
             if (cardData->mCardFamily == game_constants::INSECTS_FAMILY_NAME)
             {
-                cardComponents.push_back(std::make_shared<scene::SceneObject>());
+                cardComponents.push_back(scene.CreateDetachedSceneObject());
                 cardComponents.back()->mTextureResourceId = resService.LoadResource(resources::ResourceLoadingService::RES_TEXTURES_ROOT + POISON_CRYSTAL_TEXTURE_FILE_NAME);
                 cardComponents.back()->mScale.x = cardComponents.back()->mScale.y = game_constants::IN_GAME_CARD_PROPERTY_ICON_SCALE/2;
                 cardComponents.back()->mBoundingRectMultiplier.x = game_constants::CARD_BOUNDING_RECT_X_MULTIPLIER;
@@ -269,7 +269,7 @@ std::shared_ptr<CardSoWrapper> CreateCardSoWrapper
             // Create dig indicator
             else if (cardData->mCardFamily == game_constants::RODENTS_FAMILY_NAME)
             {
-                cardComponents.push_back(std::make_shared<scene::SceneObject>());
+                cardComponents.push_back(scene.CreateDetachedSceneObject());
                 cardComponents.back()->mTextureResourceId = resService.LoadResource(resources::ResourceLoadingService::RES_TEXTURES_ROOT + DIG_ICON_TEXTURE_FILE_NAME);
                 cardComponents.back()->mScale.x = cardComponents.back()->mScale.y = game_constants::IN_GAME_CARD_PROPERTY_ICON_SCALE/4;
                 cardComponents.back()->mBoundingRectMultiplier.x = game_constants::CARD_BOUNDING_RECT_X_MULTIPLIER;
@@ -279,7 +279,7 @@ std::shared_ptr<CardSoWrapper> CreateCardSoWrapper
             }
             
             // Create weight icon
-            cardComponents.push_back(std::make_shared<scene::SceneObject>());
+            cardComponents.push_back(scene.CreateDetachedSceneObject());
             cardComponents.back()->mTextureResourceId = resService.LoadResource(resources::ResourceLoadingService::RES_TEXTURES_ROOT + CARD_WEIGHT_ICON_TEXTURE_FILE_NAME);
             cardComponents.back()->mScale.x = cardComponents.back()->mScale.y = game_constants::IN_GAME_CARD_PROPERTY_ICON_SCALE;
             cardComponents.back()->mBoundingRectMultiplier.x = game_constants::CARD_BOUNDING_RECT_X_MULTIPLIER;
@@ -289,7 +289,7 @@ std::shared_ptr<CardSoWrapper> CreateCardSoWrapper
             cardComponents.back()->mPosition.z += 2 * game_constants::CARD_COMPONENT_Z_OFFSET;
             
             // Create weight
-            cardComponents.push_back(std::make_shared<scene::SceneObject>());
+            cardComponents.push_back(scene.CreateDetachedSceneObject());
             scene::TextSceneObjectData weightTextData;
             weightTextData.mFontName = game_constants::FONT_PLACEHOLDER_WEIGHT_NAME;
             
@@ -309,7 +309,7 @@ std::shared_ptr<CardSoWrapper> CreateCardSoWrapper
         }
         
         // Create card name
-        cardComponents.push_back(std::make_shared<scene::SceneObject>());
+        cardComponents.push_back(scene.CreateDetachedSceneObject());
         scene::TextSceneObjectData cardNameTextData;
         cardNameTextData.mFontName = game_constants::DEFAULT_FONT_NAME;
         cardNameTextData.mText = cardData->mCardName.GetString();
@@ -333,7 +333,7 @@ std::shared_ptr<CardSoWrapper> CreateCardSoWrapper
         // Single use card
         if (cardData->mIsSingleUse)
         {
-            cardComponents.push_back(std::make_shared<scene::SceneObject>());
+            cardComponents.push_back(scene.CreateDetachedSceneObject());
             cardComponents.back()->mTextureResourceId = resService.LoadResource(resources::ResourceLoadingService::RES_TEXTURES_ROOT + SINGLE_USE_CARD_TEXTURE_FILE_NAME);
             cardComponents.back()->mScale.x = cardComponents.back()->mScale.y = game_constants::IN_GAME_CARD_PROPERTY_ICON_SCALE/2;
             cardComponents.back()->mBoundingRectMultiplier.x = game_constants::CARD_BOUNDING_RECT_X_MULTIPLIER;
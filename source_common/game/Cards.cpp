@@ -10,6 +10,7 @@
 #include <engine/resloading/ResourceLoadingService.h>
 #include <engine/resloading/DataFileResource.h>
 #include <engine/resloading/TextureResource.h>
+#include <engine/utils/AllocationTracking.h>
 #include <engine/utils/BaseDataFileDeserializer.h>
 #include <engine/utils/OSMessageBox.h>
 #include <game/Cards.h>
@@ -209,6 +210,8 @@ CardData CardDataRepository::GetCardDataByCardName(const strutils::StringId& car
 
 CardData CardDataRepository::GetCardData(const int cardId, const size_t forPlayerIndex) const
 {
+    memory::AllocationScope allocationScope("GetCardData");
+    
     auto findIter = mCardDataMap.find(cardId);
     if (findIter != mCardDataMap.end())
     {
@@ -361,6 +364,7 @@ void CardDataRepository::LoadCardData(bool loadCardAssets)
         else
         {
             cardData.mCardEffect = cardObject["effect"].get<std::string>();
+            cardData.mCardEffectComponentMask = effects::ComputeEffectComponentMask(cardData.mCardEffect);
             cardData.mCardEffectTooltip = cardObject["tooltip"].get<std::string>();
             
             // preprocess effect
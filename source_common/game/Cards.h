@@ -11,6 +11,7 @@
 ///------------------------------------------------------------------------------------------------
 
 #include <engine/resloading/ResourceLoadingService.h>
+#include <game/CardEffectComponents.h>
 #include <memory>
 #include <optional>
 #include <unordered_map>
@@ -71,6 +72,7 @@ struct ExpansionData
 struct CardData
 {
     bool IsSpell() const { return !mCardEffect.empty(); }
+    bool HasEffectComponent(const effects::EffectComponentMask effectComponentMask) const { return (mCardEffectComponentMask & effectComponentMask) != 0; }
     
     bool mIsSingleUse;
     int mCardId;
@@ -81,6 +83,7 @@ struct CardData
     strutils::StringId mCardName;
     strutils::StringId mExpansion;
     std::string mCardEffect;
+    effects::EffectComponentMask mCardEffectComponentMask;
     std::string mCardEffectTooltip;
     strutils::StringId mCardFamily;
     strutils::StringId mParticleEffect;
@@ -34,7 +34,7 @@ DataRepository::DataRepository()
     
     // Persistent Account data initialization
     mUnlockedCardIds = CardDataRepository::GetInstance().GetFreshAccountUnlockedCardIds();
-    mCurrencyCoins = ValueWithDelayedDisplay<long long>(0, 0, [=](const long long& newValue) { mPersistentDataSerializer->GetState()["currency_coins"] = newValue; });
+    mCurrencyCoins = ValueWithDelayedDisplay<long long>(0, 0, [=](const long long& newValue) { mPersistentDataSerializer->GetMutableStateSection("currency_coins") = newValue; });
     mNextCardPackSeed = math::RandomInt();
     
     ResetStoryData();
@@ -48,11 +48,11 @@ DataRepository::DataRepository()
 void DataRepository::ResetStoryData()
 {
     // Stroy data initialization
-    mStoryDataSerializer->GetState().clear();
+    mStoryDataSerializer->ClearState();
     
     mStoryPlayerCardStatModifiers.clear();
     
-    mStoryCurrentHealth = ValueWithDelayedDisplay<int>(game_constants::STORY_DEFAULT_MAX_HEALTH, game_constants::STORY_DEFAULT_MAX_HEALTH, [=](const int& newValue) { mStoryDataSerializer->GetState()["current_story_health"] = newValue; });
+    mStoryCurrentHealth = ValueWithDelayedDisplay<int>(game_constants::STORY_DEFAULT_MAX_HEALTH, game_constants::STORY_DEFAULT_MAX_HEALTH, [=](const int& newValue) { mStoryDataSerializer->GetMutableStateSection("current_story_health") = newValue; });
     
     mCurrentStoryArtifacts.clear();
     mCurrentShopBoughtProductCoordinates.clear();
@@ -99,7 +99,7 @@ void DataRepository::ResetStoryData()
 void DataRepository::ReloadProgressionDataFromFile()
 {
     ResetStoryData();
-    mPersistentDataSerializer->GetState().clear();
+    mPersistentDataSerializer->ClearState();
     
     mPersistentDataDeserializer = std::make_unique<PersistentAccountDataDeserializer>(*this);
     mStoryDataDeserializer = std::make_unique<StoryDeserializer>(*this);
@@ -131,7 +131,7 @@ void DataRepository::SetStoryPlayerCardStatModifier(const CardStatType statType,
     {
         storyPlayerCardStatModifiersJson[std::to_string(static_cast<int>(cardStatModifierEntry.first))] = cardStatModifierEntry.second;
     }
-    mStoryDataSerializer->GetState()["story_player_card_stat_modifiers"] = storyPlayerCardStatModifiersJson;
+    mStoryDataSerializer->GetMutableStateSection("story_player_card_stat_modifiers") = storyPlayerCardStatModifiersJson;
 }
 
 ///------------------------------------------------------------------------------------------------
@@ -139,7 +139,7 @@ void DataRepository::SetStoryPlayerCardStatModifier(const CardStatType statType,
 void DataRepository::ClearStoryPlayerCardStatModifiers()
 {
     mStoryPlayerCardStatModifiers.clear();
-    mStoryDataSerializer->GetState()["story_player_card_stat_modifiers"].clear();
+    mStoryDataSerializer->GetMutableStateSection("story_player_card_stat_modifiers").clear();
 }
 
 ///------------------------------------------------------------------------------------------------
@@ -160,7 +160,7 @@ void DataRepository::SetGoldenCardMapEntry(const int cardId, const bool goldenCa
     {
         goldenCardIdMapJson[std::to_string(goldenCardIddMapEntry.first)] = goldenCardIddMapEntry.second;
     }
-    mPersistentDataSerializer->GetState()["golden_card_id_map"] = goldenCardIdMapJson;
+    mPersistentDataSerializer->GetMutableStateSection("golden_card_id_map") = goldenCardIdMapJson;
 }
 
 ///------------------------------------------------------------------------------------------------
@@ -168,7 +168,7 @@ void DataRepository::SetGoldenCardMapEntry(const int cardId, const bool goldenCa
 void DataRepository::ClearGoldenCardIdMap()
 {
     mGoldenCardIdMap.clear();
-    mPersistentDataSerializer->GetState()["golden_card_id_map"].clear();
+    mPersistentDataSerializer->GetMutableStateSection("golden_card_id_map").clear();
 }
 
 ///------------------------------------------------------------------------------------------------
@@ -192,16 +192,16 @@ void DataRepository::AddPendingCardPack(const CardPackType cardPackType)
             pendingCardPacksJson.push_back(std::to_string(static_cast<int>(pendingCardPack)));
         }
         
-        mPersistentDataSerializer->GetState()["pending_card_packs"] = pendingCardPacksJson;
+        mPersistentDataSerializer->GetMutableStateSection("pending_card_packs") = pendingCardPacksJson;
         
         auto duration = std::chrono::system_clock::now().time_since_epoch();
         auto secsSinceEpoch = std::chrono::duration_cast<std::chrono::seconds>(duration).count();
         mSuccessfulTransactionIds.push_back(std::to_string(secsSinceEpoch));
-        mPersistentDataSerializer->GetState()["successful_transaction_ids"] = mSuccessfulTransactionIds;
+        mPersistentDataSerializer->GetMutableStateSection("successful_transaction_ids") = mSuccessfulTransactionIds;
     }
     else
     {
-        logging::Log(logging::LogType::WARNING, "Ignoring attempted addition of NONE card pack type");
+        LOG(logging::LogType::WARNING, "Ignoring attempted addition of NONE card pack type");
     }
 }
 
@@ -220,12 +220,12 @@ CardPackType DataRepository::PopFrontPendingCardPack()
             pendingCardPacksJson.push_back(std::to_string(static_cast<int>(pendingCardPack)));
         }
         
-        mPersistentDataSerializer->GetState()["pending_card_packs"] = pendingCardPacksJson;
+        mPersistentDataSerializer->GetMutableStateSection("pending_card_packs") = pendingCardPacksJson;
         return cardPackTypeFront;
     }
     else
     {
-        logging::Log(logging::LogType::WARNING, "Attempted to pop pending card pack but vector is empty");
+        LOG(logging::LogType::WARNING, "Attempted to pop pending card pack but vector is empty");
         return CardPackType::NONE;
     }
 }
@@ -284,7 +284,7 @@ StoryMapSceneType DataRepository::GetCurrentStoryMapSceneType() const
 void DataRepository::SetCurrentStoryMapSceneType(const StoryMapSceneType currentStoryMapSceneType)
 {
     mCurrentStoryMapSceneType = currentStoryMapSceneType;
-    mStoryDataSerializer->GetState()["current_story_map_scene_type"] = static_cast<int>(currentStoryMapSceneType);
+    mStoryDataSerializer->GetMutableStateSection("current_story_map_scene_type") = static_cast<int>(currentStoryMapSceneType);
 }
 
 ///------------------------------------------------------------------------------------------------
@@ -299,7 +299,7 @@ BattleSubSceneType DataRepository::GetCurrentBattleSubSceneType() const
 void DataRepository::SetCurrentBattleSubSceneType(const BattleSubSceneType currentBattleSubSceneType)
 {
     mCurrentBattleSubSceneType = currentBattleSubSceneType;
-    mStoryDataSerializer->GetState()["current_battle_sub_scene_type"] = static_cast<int>(mCurrentBattleSubSceneType);
+    mStoryDataSerializer->GetMutableStateSection("current_battle_sub_scene_type") = static_cast<int>(mCurrentBattleSubSceneType);
 }
 
 ///------------------------------------------------------------------------------------------------
@@ -314,7 +314,7 @@ WheelOfFortuneType DataRepository::GetCurrentWheelOfFortuneType() const
 void DataRepository::SetCurrentWheelOfFortuneType(const WheelOfFortuneType currentWheelOfFortuneType)
 {
     mCurrentWheelOfFortuneType = currentWheelOfFortuneType;
-    mStoryDataSerializer->GetState()["current_wheel_of_fortune_type"] = static_cast<int>(mCurrentWheelOfFortuneType);
+    mStoryDataSerializer->GetMutableStateSection("current_wheel_of_fortune_type") = static_cast<int>(mCurrentWheelOfFortuneType);
 }
 
 ///------------------------------------------------------------------------------------------------
@@ -357,7 +357,7 @@ ShopBehaviorType DataRepository::GetCurrentShopBehaviorType() const
 void DataRepository::SetCurrentShopBehaviorType(const ShopBehaviorType currentShopBehaviorType)
 {
     mCurrentShopBehaviorType = currentShopBehaviorType;
-    mStoryDataSerializer->GetState()["current_shop_type"] = static_cast<int>(mCurrentShopBehaviorType);
+    mStoryDataSerializer->GetMutableStateSection("current_shop_type") = static_cast<int>(mCurrentShopBehaviorType);
 }
 
 ///------------------------------------------------------------------------------------------------
@@ -372,7 +372,7 @@ StoryMapType DataRepository::GetCurrentStoryMapType() const
 void DataRepository::SetCurrentStoryMapType(const StoryMapType currentStoryMapType)
 {
     mCurrentStoryMapType = currentStoryMapType;
-    mStoryDataSerializer->GetState()["current_story_map_type"] = static_cast<int>(mCurrentStoryMapType);
+    mStoryDataSerializer->GetMutableStateSection("current_story_map_type") = static_cast<int>(mCurrentStoryMapType);
 }
 
 ///------------------------------------------------------------------------------------------------
@@ -387,7 +387,7 @@ const int& DataRepository::GetGamesFinishedCount() const
 void DataRepository::SetGamesFinishedCount(const int gamesFinishedCount)
 {
     mGamesFinishedCount = gamesFinishedCount;
-    mPersistentDataSerializer->GetState()["games_finished_count"] = mGamesFinishedCount;
+    mPersistentDataSerializer->GetMutableStateSection("games_finished_count") = mGamesFinishedCount;
 }
 
 ///------------------------------------------------------------------------------------------------
@@ -402,7 +402,7 @@ const int& DataRepository::GetCurrentEventScreenIndex() const
 void DataRepository::SetCurrentEventScreenIndex(const int currentEventScreenIndex)
 {
     mCurrentEventScreenIndex = currentEventScreenIndex;
-    mStoryDataSerializer->GetState()["current_event_screen"] = currentEventScreenIndex;
+    mStoryDataSerializer->GetMutableStateSection("current_event_screen") = currentEventScreenIndex;
 }
 
 ///------------------------------------------------------------------------------------------------
@@ -417,7 +417,7 @@ const int& DataRepository::GetCurrentEventIndex() const
 void DataRepository::SetCurrentEventIndex(const int currentEventIndex)
 {
     mCurrentEventIndex = currentEventIndex;
-    mStoryDataSerializer->GetState()["current_event"] = currentEventIndex;
+    mStoryDataSerializer->GetMutableStateSection("current_event") = currentEventIndex;
 }
 
 ///------------------------------------------------------------------------------------------------
@@ -433,7 +433,7 @@ void DataRepository::SetUnlockedCardIds(const std::vector<int>& unlockedCardIds)
 {
     mUnlockedCardIds = unlockedCardIds;
     std::sort(mUnlockedCardIds.begin(), mUnlockedCardIds.end());
-    mPersistentDataSerializer->GetState()["unlocked_card_ids"] = mUnlockedCardIds;
+    mPersistentDataSerializer->GetMutableStateSection("unlocked_card_ids") = mUnlockedCardIds;
 }
 
 ///------------------------------------------------------------------------------------------------
@@ -448,7 +448,7 @@ const std::vector<int>& DataRepository::GetCurrentStoryPlayerDeck() const
 void DataRepository::SetCurrentStoryPlayerDeck(const std::vector<int>& deck)
 {
     mCurrentStoryPlayerDeck = deck;
-    mStoryDataSerializer->GetState()["current_story_player_deck"] = deck;
+    mStoryDataSerializer->GetMutableStateSection("current_story_player_deck") = deck;
 }
 
 ///------------------------------------------------------------------------------------------------
@@ -463,7 +463,7 @@ const std::vector<int>& DataRepository::GetNextTopPlayerDeck() const
 void DataRepository::SetNextTopPlayerDeck(const std::vector<int>& deck)
 {
     mNextTopPlayerDeck = deck;
-    mStoryDataSerializer->GetState()["next_top_player_deck"] = deck;
+    mStoryDataSerializer->GetMutableStateSection("next_top_player_deck") = deck;
 }
 
 ///------------------------------------------------------------------------------------------------
@@ -478,7 +478,7 @@ const std::vector<int>& DataRepository::GetNextBotPlayerDeck() const
 void DataRepository::SetNextBotPlayerDeck(const std::vector<int>& deck)
 {
     mNextBotPlayerDeck = deck;
-    mStoryDataSerializer->GetState()["next_bot_player_deck"] = deck;
+    mStoryDataSerializer->GetMutableStateSection("next_bot_player_deck") = deck;
 }
 
 ///------------------------------------------------------------------------------------------------
@@ -493,7 +493,7 @@ const std::vector<int>& DataRepository::GetNewCardIds() const
 void DataRepository::SetNewCardIds(const std::vector<int>& newCardIds)
 {
     mNewCardIds = newCardIds;
-    mPersistentDataSerializer->GetState()["new_card_ids"] = mNewCardIds;
+    mPersistentDataSerializer->GetMutableStateSection("new_card_ids") = mNewCardIds;
 }
 
 ///------------------------------------------------------------------------------------------------
@@ -508,7 +508,7 @@ const std::vector<int>& DataRepository::GetSeenOpponentSpellCardIds() const
 void DataRepository::SetSeenOpponentSpellCardIds(const std::vector<int>& seenOpponentSpellCardIds)
 {
     mSeenOpponentSpellCardIds = seenOpponentSpellCardIds;
-    mPersistentDataSerializer->GetState()["seen_opponent_spell_card_ids"] = mSeenOpponentSpellCardIds;
+    mPersistentDataSerializer->GetMutableStateSection("seen_opponent_spell_card_ids") = mSeenOpponentSpellCardIds;
 }
 
 ///------------------------------------------------------------------------------------------------
@@ -530,11 +530,11 @@ const std::vector<strutils::StringId>& DataRepository::GetSeenTutorials() const
 void DataRepository::SetSeenTutorials(const std::vector<strutils::StringId>& seenTutorials)
 {
     mSeenTutorials = seenTutorials;
-    mPersistentDataSerializer->GetState()["seen_tutorials"].clear();
+    mPersistentDataSerializer->GetMutableStateSection("seen_tutorials").clear();
     
     for (const auto& tutorialName: mSeenTutorials)
     {
-        mPersistentDataSerializer->GetState()["seen_tutorials"].push_back(tutorialName.GetString());
+        mPersistentDataSerializer->GetMutableStateSection("seen_tutorials").push_back(tutorialName.GetString());
     }
 }
 
@@ -557,11 +557,11 @@ const std::vector<strutils::StringId>& DataRepository::GetUnlockedAchievements()
 void DataRepository::SetUnlockedAchievements(const std::vector<strutils::StringId>& unlockedAchievements)
 {
     mUnlockedAchievements = unlockedAchievements;
-    mPersistentDataSerializer->GetState()["unlocked_achievements"].clear();
+    mPersistentDataSerializer->GetMutableStateSection("unlocked_achievements").clear();
     
     for (const auto& achievement: mUnlockedAchievements)
     {
-        mPersistentDataSerializer->GetState()["unlocked_achievements"].push_back(achievement.GetString());
+        mPersistentDataSerializer->GetMutableStateSection("unlocked_achievements").push_back(achievement.GetString());
     }
 }
 
@@ -577,7 +577,7 @@ const std::vector<int>& DataRepository::GetStoryDeletedCardIds() const
 void DataRepository::SetStoryDeletedCardIds(const std::vector<int>& storyDeletedCardIds)
 {
     mStoryDeletedCards = storyDeletedCardIds;
-    mStoryDataSerializer->GetState()["story_deleted_cards"] = mStoryDeletedCards;
+    mStoryDataSerializer->GetMutableStateSection("story_deleted_cards") = mStoryDeletedCards;
 }
 
 ///------------------------------------------------------------------------------------------------
@@ -619,7 +619,7 @@ void DataRepository::SetAllMutationLevelVictoryCounts(const std::vector<int>& mu
         mStoryMutationLevelVictories[i] = mutationLevelVictoryCounts[i];
     }
     
-    mPersistentDataSerializer->GetState()["mutation_level_victories"] = mStoryMutationLevelVictories;
+    mPersistentDataSerializer->GetMutableStateSection("mutation_level_victories") = mStoryMutationLevelVictories;
 }
 
 ///------------------------------------------------------------------------------------------------
@@ -628,7 +628,7 @@ void DataRepository::SetMutationLevelVictories(const int mutationLevel, const in
 {
     assert(mutationLevel >= 0 && mutationLevel <= game_constants::MAX_MUTATION_LEVEL);
     mStoryMutationLevelVictories[mutationLevel] = victoryCount;
-    mPersistentDataSerializer->GetState()["mutation_level_victories"] = mStoryMutationLevelVictories;
+    mPersistentDataSerializer->GetMutableStateSection("mutation_level_victories") = mStoryMutationLevelVictories;
 }
 
 ///------------------------------------------------------------------------------------------------
@@ -656,7 +656,7 @@ void DataRepository::SetAllMutationLevelBestTimes(const std::vector<int>& mutati
         mStoryMutationLevelBestTimes[i] = mutationLevelBestTimes[i];
     }
     
-    mPersistentDataSerializer->GetState()["mutation_level_best_times"] = mStoryMutationLevelBestTimes;
+    mPersistentDataSerializer->GetMutableStateSection("mutation_level_best_times") = mStoryMutationLevelBestTimes;
 }
 
 ///------------------------------------------------------------------------------------------------
@@ -665,7 +665,7 @@ void DataRepository::SetMutationLevelBestTime(const int mutationLevel, const int
 {
     assert(mutationLevel >= 0 && mutationLevel <= game_constants::MAX_MUTATION_LEVEL);
     mStoryMutationLevelBestTimes[mutationLevel] = bestTimeSecs;
-    mPersistentDataSerializer->GetState()["mutation_level_best_times"] = mStoryMutationLevelBestTimes;
+    mPersistentDataSerializer->GetMutableStateSection("mutation_level_best_times") = mStoryMutationLevelBestTimes;
 }
 
 ///------------------------------------------------------------------------------------------------
@@ -680,7 +680,7 @@ const std::vector<std::string>& DataRepository::GetSuccessfulTransactionIds() co
 void DataRepository::SetSuccessfulTransactionIds(const std::vector<std::string>& successfulTransactionIds)
 {
     mSuccessfulTransactionIds = successfulTransactionIds;
-    mPersistentDataSerializer->GetState()["successful_transaction_ids"] = mSuccessfulTransactionIds;
+    mPersistentDataSerializer->GetMutableStateSection("successful_transaction_ids") = mSuccessfulTransactionIds;
 }
 
 ///------------------------------------------------------------------------------------------------
@@ -695,7 +695,7 @@ const std::vector<std::string>& DataRepository::GetGiftCodesClaimed() const
 void DataRepository::SetGiftCodesClaimed(const std::vector<std::string>& giftCodesClaimed)
 {
     mGiftCodesClaimed = giftCodesClaimed;
-    mPersistentDataSerializer->GetState()["gift_codes_claimed"] = mGiftCodesClaimed;
+    mPersistentDataSerializer->GetMutableStateSection("gift_codes_claimed") = mGiftCodesClaimed;
 }
 
 ///------------------------------------------------------------------------------------------------
@@ -710,7 +710,7 @@ const int& DataRepository::GetStoryMaxHealth() const
 void DataRepository::SetStoryMaxHealth(const int storyMaxHealth)
 {
     mStoryMaxHealth = storyMaxHealth;
-    mStoryDataSerializer->GetState()["story_max_health"] = mStoryMaxHealth;
+    mStoryDataSerializer->GetMutableStateSection("story_max_health") = mStoryMaxHealth;
 }
 
 ///------------------------------------------------------------------------------------------------
@@ -725,7 +725,7 @@ const int& DataRepository::GetStoryMapGenerationSeed() const
 void DataRepository::SetStoryMapGenerationSeed(const int storyMapGenerationSeed)
 {
     mStoryMapGenerationSeed = storyMapGenerationSeed;
-    mStoryDataSerializer->GetState()["story_seed"] = storyMapGenerationSeed;
+    mStoryDataSerializer->GetMutableStateSection("story_seed") = storyMapGenerationSeed;
 }
 
 ///------------------------------------------------------------------------------------------------
@@ -740,7 +740,7 @@ const long long& DataRepository::GetStoryStartingGold() const
 void DataRepository::SetStoryStartingGold(const long long storyStartingGold)
 {
     mStoryStartingGold = storyStartingGold;
-    mStoryDataSerializer->GetState()["story_starting_gold"] = mStoryStartingGold;
+    mStoryDataSerializer->GetMutableStateSection("story_starting_gold") = mStoryStartingGold;
 }
 
 ///------------------------------------------------------------------------------------------------
@@ -755,7 +755,7 @@ const int& DataRepository::GetCurrentStoryMapNodeSeed() const
 void DataRepository::SetCurrentStoryMapNodeSeed(const int currentStoryMapNodeSeed)
 {
     mCurrentStoryMapNodeSeed = currentStoryMapNodeSeed;
-    mStoryDataSerializer->GetState()["current_story_map_node_seed"] = currentStoryMapNodeSeed;
+    mStoryDataSerializer->GetMutableStateSection("current_story_map_node_seed") = currentStoryMapNodeSeed;
 }
 
 ///------------------------------------------------------------------------------------------------
@@ -770,7 +770,7 @@ const int& DataRepository::GetNextCardPackSeed() const
 void DataRepository::SetNextCardPackSeed(const int nextCardPackSeed)
 {
     mNextCardPackSeed = nextCardPackSeed;
-    mPersistentDataSerializer->GetState()["next_card_pack_seed"] = mNextCardPackSeed;
+    mPersistentDataSerializer->GetMutableStateSection("next_card_pack_seed") = mNextCardPackSeed;
 }
 
 ///------------------------------------------------------------------------------------------------
@@ -785,7 +785,7 @@ StoryMap::NodeType DataRepository::GetCurrentStoryMapNodeType() const
 void DataRepository::SetCurrentStoryMapNodeType(const StoryMap::NodeType currentStoryMapNodeType)
 {
     mCurrentStoryMapNodeType = currentStoryMapNodeType;
-    mStoryDataSerializer->GetState()["current_story_map_node_type"] = static_cast<int>(mCurrentStoryMapNodeType);
+    mStoryDataSerializer->GetMutableStateSection("current_story_map_node_type") = static_cast<int>(mCurrentStoryMapNodeType);
 }
 
 ///------------------------------------------------------------------------------------------------
@@ -800,7 +800,7 @@ const int& DataRepository::GetNextBattleTopPlayerHealth() const
 void DataRepository::SetNextBattleTopPlayerHealth(const int nextBattleTopPlayerHealth)
 {
     mNextBattleTopPlayerHealth = nextBattleTopPlayerHealth;
-    mStoryDataSerializer->GetState()["next_battle_top_health"] = nextBattleTopPlayerHealth;
+    mStoryDataSerializer->GetMutableStateSection("next_battle_top_health") = nextBattleTopPlayerHealth;
 }
 
 ///------------------------------------------------------------------------------------------------
@@ -815,7 +815,7 @@ const int& DataRepository::GetNextBattleBotPlayerHealth() const
 void DataRepository::SetNextBattleBotPlayerHealth(const int nextBattleBotPlayerHealth)
 {
     mNextBattleBotPlayerHealth = nextBattleBotPlayerHealth;
-    mStoryDataSerializer->GetState()["next_battle_bot_health"] = nextBattleBotPlayerHealth;
+    mStoryDataSerializer->GetMutableStateSection("next_battle_bot_health") = nextBattleBotPlayerHealth;
 }
 
 ///------------------------------------------------------------------------------------------------
@@ -830,7 +830,7 @@ const int& DataRepository::GetNextBattleTopPlayerInitWeight() const
 void DataRepository::SetNextBattleTopPlayerInitWeight(const int nextBattleTopPlayerInitWeight)
 {
     mNextBattleTopPlayerInitWeight = nextBattleTopPlayerInitWeight;
-    mStoryDataSerializer->GetState()["next_battle_top_init_weight"] = nextBattleTopPlayerInitWeight;
+    mStoryDataSerializer->GetMutableStateSection("next_battle_top_init_weight") = nextBattleTopPlayerInitWeight;
 }
 
 ///------------------------------------------------------------------------------------------------
@@ -845,7 +845,7 @@ const int& DataRepository::GetNextBattleBotPlayerInitWeight() const
 void DataRepository::SetNextBattleBotPlayerInitWeight(const int nextBattleBotPlayerInitWeight)
 {
     mNextBattleBotPlayerInitWeight = nextBattleBotPlayerInitWeight;
-    mStoryDataSerializer->GetState()["next_battle_bot_init_weight"] = nextBattleBotPlayerInitWeight;
+    mStoryDataSerializer->GetMutableStateSection("next_battle_bot_init_weight") = nextBattleBotPlayerInitWeight;
 }
 
 ///------------------------------------------------------------------------------------------------
@@ -860,7 +860,7 @@ const int& DataRepository::GetNextBattleTopPlayerWeightLimit() const
 void DataRepository::SetNextBattleTopPlayerWeightLimit(const int nextBattleTopPlayerWeightLimit)
 {
     mNextBattleTopPlayerWeightLimit = nextBattleTopPlayerWeightLimit;
-    mStoryDataSerializer->GetState()["next_battle_top_weight_limit"] = nextBattleTopPlayerWeightLimit;
+    mStoryDataSerializer->GetMutableStateSection("next_battle_top_weight_limit") = nextBattleTopPlayerWeightLimit;
 }
 
 ///------------------------------------------------------------------------------------------------
@@ -875,7 +875,7 @@ const int& DataRepository::GetNextBattleBotPlayerWeightLimit() const
 void DataRepository::SetNextBattleBotPlayerWeightLimit(const int nextBattleBotPlayerWeightLimit)
 {
     mNextBattleBotPlayerWeightLimit = nextBattleBotPlayerWeightLimit;
-    mStoryDataSerializer->GetState()["next_battle_bot_weight_limit"] = nextBattleBotPlayerWeightLimit;
+    mStoryDataSerializer->GetMutableStateSection("next_battle_bot_weight_limit") = nextBattleBotPlayerWeightLimit;
 }
 
 ///------------------------------------------------------------------------------------------------
@@ -890,7 +890,7 @@ const int& DataRepository::GetNextStoryOpponentDamage() const
 void DataRepository::SetNextStoryOpponentDamage(const int nextStoryOpponentDamage)
 {
     mNextStoryOpponentDamage = nextStoryOpponentDamage;
-    mStoryDataSerializer->GetState()["next_story_opponent_damage"] = nextStoryOpponentDamage;
+    mStoryDataSerializer->GetMutableStateSection("next_story_opponent_damage") = nextStoryOpponentDamage;
 }
 
 ///------------------------------------------------------------------------------------------------
@@ -905,7 +905,7 @@ const int& DataRepository::GetCurrentStorySecondsPlayed() const
 void DataRepository::SetCurrentStorySecondPlayed(const int currentStorySecondsPlayed)
 {
     mCurrentStorySecondsPlayed = currentStorySecondsPlayed;
-    mStoryDataSerializer->GetState()["current_story_seconds_played"] = mCurrentStorySecondsPlayed;
+    mStoryDataSerializer->GetMutableStateSection("current_story_seconds_played") = mCurrentStorySecondsPlayed;
 }
 
 ///------------------------------------------------------------------------------------------------
@@ -920,7 +920,7 @@ const int& DataRepository::GetTotalSecondsPlayed() const
 void DataRepository::SetTotalSecondsPlayed(const int totalSecondsPlayed)
 {
     mTotalSecondsPlayed = totalSecondsPlayed;
-    mPersistentDataSerializer->GetState()["total_seconds_played"] = mTotalSecondsPlayed;
+    mPersistentDataSerializer->GetMutableStateSection("total_seconds_played") = mTotalSecondsPlayed;
 }
 
 ///------------------------------------------------------------------------------------------------
@@ -963,7 +963,7 @@ const int& DataRepository::GetGoldCartsIgnored() const
 void DataRepository::SetGoldCartsIgnored(const int goldCartsIgnored)
 {
     mGoldCartsIgnored = goldCartsIgnored;
-    mPersistentDataSerializer->GetState()["gold_carts_ignored"] = mGoldCartsIgnored;
+    mPersistentDataSerializer->GetMutableStateSection("gold_carts_ignored") = mGoldCartsIgnored;
 }
 
 ///------------------------------------------------------------------------------------------------
@@ -985,7 +985,7 @@ bool DataRepository::DoesCurrentStoryHaveMutation(const int storyMutationLevel)
 void DataRepository::SetCurrentStoryMutationLevel(const int storyMutationLevel)
 {
     mCurrentStoryMutationLevel = storyMutationLevel;
-    mStoryDataSerializer->GetState()["current_story_mutation_level"] = mCurrentStoryMutationLevel;
+    mStoryDataSerializer->GetMutableStateSection("current_story_mutation_level") = mCurrentStoryMutationLevel;
 }
 
 ///------------------------------------------------------------------------------------------------
@@ -1000,7 +1000,7 @@ const std::vector<std::pair<int, int>>& DataRepository::GetCurrentShopBoughtProd
 void DataRepository::ClearShopBoughtProductCoordinates()
 {
     mCurrentShopBoughtProductCoordinates.clear();
-    mStoryDataSerializer->GetState()["current_shop_bought_product_coordinates"].clear();
+    mStoryDataSerializer->GetMutableStateSection("current_shop_bought_product_coordinates").clear();
 }
 
 ///------------------------------------------------------------------------------------------------
@@ -1008,7 +1008,7 @@ void DataRepository::ClearShopBoughtProductCoordinates()
 void DataRepository::SetShopBoughtProductCoordinates(const std::vector<std::pair<int, int>>& shopBoughtProductCoordinates)
 {
     mCurrentShopBoughtProductCoordinates = shopBoughtProductCoordinates;
-    mStoryDataSerializer->GetState()["current_shop_bought_product_coordinates"] = mCurrentShopBoughtProductCoordinates;
+    mStoryDataSerializer->GetMutableStateSection("current_shop_bought_product_coordinates") = mCurrentShopBoughtProductCoordinates;
 }
 
 ///------------------------------------------------------------------------------------------------
@@ -1016,7 +1016,7 @@ void DataRepository::SetShopBoughtProductCoordinates(const std::vector<std::pair
 void DataRepository::AddShopBoughtProductCoordinates(const std::pair<int, int>& shopBoughtProductCoordinates)
 {
     mCurrentShopBoughtProductCoordinates.push_back(shopBoughtProductCoordinates);
-    mStoryDataSerializer->GetState()["current_shop_bought_product_coordinates"] = mCurrentShopBoughtProductCoordinates;
+    mStoryDataSerializer->GetMutableStateSection("current_shop_bought_product_coordinates") = mCurrentShopBoughtProductCoordinates;
 }
 
 ///------------------------------------------------------------------------------------------------
@@ -1063,7 +1063,7 @@ void DataRepository::SetStoryArtifactCount(const strutils::StringId& storyArtifa
 void DataRepository::ClearCurrentStoryArtifacts()
 {
     mCurrentStoryArtifacts.clear();
-    mStoryDataSerializer->GetState()["current_story_artifacts"].clear();
+    mStoryDataSerializer->GetMutableStateSection("current_story_artifacts").clear();
 }
 
 ///------------------------------------------------------------------------------------------------
@@ -1094,7 +1094,7 @@ void DataRepository::AddStoryArtifact(const strutils::StringId& storyArtifact)
 void DataRepository::SetCurrentStoryArtifacts(const std::vector<std::pair<strutils::StringId, int>>& storyArtifacts)
 {
     mCurrentStoryArtifacts = storyArtifacts;
-    mStoryDataSerializer->GetState()["current_story_artifacts"].clear();
+    mStoryDataSerializer->GetMutableStateSection("current_story_artifacts").clear();
     
     nlohmann::json storyArtifactsJson;
     for (const auto& artifactEntry: storyArtifacts)
@@ -1102,7 +1102,7 @@ void DataRepository::SetCurrentStoryArtifacts(const std::vector<std::pair<struti
         storyArtifactsJson[artifactEntry.first.GetString()] = artifactEntry.second;
     }
     
-    mStoryDataSerializer->GetState()["current_story_artifacts"] = storyArtifactsJson;
+    mStoryDataSerializer->GetMutableStateSection("current_story_artifacts") = storyArtifactsJson;
 }
 
 ///------------------------------------------------------------------------------------------------
@@ -1121,7 +1121,7 @@ void DataRepository::SetCurrentStoryMapNodeCoord(const glm::ivec2& currentStoryM
     nlohmann::json currentStoryMapCoordJson;
     currentStoryMapCoordJson["col"] = currentStoryMapNodeCoord.x;
     currentStoryMapCoordJson["row"] = currentStoryMapNodeCoord.y;
-    mStoryDataSerializer->GetState()["current_story_map_node_coord"] = currentStoryMapCoordJson;
+    mStoryDataSerializer->GetMutableStateSection("current_story_map_node_coord") = currentStoryMapCoordJson;
 }
 
 ///------------------------------------------------------------------------------------------------
@@ -1140,7 +1140,7 @@ void DataRepository::SetPreBossMidMapNodeCoord(const glm::ivec2& preBossMidMapNo
     nlohmann::json preBossMidMapCoordJson;
     preBossMidMapCoordJson["col"] = preBossMidMapNodeCoord.x;
     preBossMidMapCoordJson["row"] = preBossMidMapNodeCoord.y;
-    mStoryDataSerializer->GetState()["pre_boss_mid_map_node_coord"] = preBossMidMapCoordJson;
+    mStoryDataSerializer->GetMutableStateSection("pre_boss_mid_map_node_coord") = preBossMidMapCoordJson;
 }
 
 ///------------------------------------------------------------------------------------------------
@@ -1183,7 +1183,7 @@ const std::string& DataRepository::GetNextStoryOpponentTexturePath() const
 void DataRepository::SetNextStoryOpponentTexturePath(const std::string& nextStoryOpponentTexturePath)
 {
     mNextStoryOpponentTexturePath = nextStoryOpponentTexturePath;
-    mStoryDataSerializer->GetState()["next_story_opponent_path"] = nextStoryOpponentTexturePath;
+    mStoryDataSerializer->GetMutableStateSection("next_story_opponent_path") = nextStoryOpponentTexturePath;
 }
 
 ///------------------------------------------------------------------------------------------------
@@ -1226,7 +1226,7 @@ void DataRepository::SetPermaShopProductNameToPurchase(const std::string& permaS
 void DataRepository::SetNextStoryOpponentName(const std::string& nextStoryOpponentName)
 {
     mNextStoryOpponentName = nextStoryOpponentName;
-    mStoryDataSerializer->GetState()["next_story_opponent_name"] = nextStoryOpponentName;
+    mStoryDataSerializer->GetMutableStateSection("next_story_opponent_name") = nextStoryOpponentName;
 }
 
 ///------------------------------------------------------------------------------------------------
@@ -1269,7 +1269,7 @@ const bool& DataRepository::IsAudioEnabled() const
 void DataRepository::SetAudioEnabled(const bool audioEnabled)
 {
     mAudioEnabled = audioEnabled;
-    mPersistentDataSerializer->GetState()["audio_enabled"] = mAudioEnabled;
+    mPersistentDataSerializer->GetMutableStateSection("audio_enabled") = mAudioEnabled;
 }
 
 ///------------------------------------------------------------------------------------------------
@@ -1284,7 +1284,7 @@ const bool& DataRepository::AreTutorialsEnabled() const
 void DataRepository::SetTutorialsEnabled(const bool tutorialsEnabled)
 {
     mTutorialsEnabled = tutorialsEnabled;
-    mPersistentDataSerializer->GetState()["tutorials_enabled"] = mTutorialsEnabled;
+    mPersistentDataSerializer->GetMutableStateSection("tutorials_enabled") = mTutorialsEnabled;
 }
 
 ///------------------------------------------------------------------------------------------------
@@ -1299,7 +1299,7 @@ const bool& DataRepository::HasSeenMountainOfGoldEvent() const
 void DataRepository::SetHasSeenMountainOfGoldEvent(const bool hasSeenMountainOfGoldEvent)
 {
     mHasSeenMountainOfGoldEvent = hasSeenMountainOfGoldEvent;
-    mPersistentDataSerializer->GetState()["has_seen_mountain_of_gold_event"] = mHasSeenMountainOfGoldEvent;
+    mPersistentDataSerializer->GetMutableStateSection("has_seen_mountain_of_gold_event") = mHasSeenMountainOfGoldEvent;
 }
 
 ///------------------------------------------------------------------------------------------------
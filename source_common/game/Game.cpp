@@ -18,12 +18,14 @@
 #include <engine/scene/SceneObject.h>
 #include <engine/sound/SoundManager.h>
 #include <engine/utils/BaseDataFileDeserializer.h>
+#include <engine/utils/Benchmark.h>
 #include <engine/utils/Date.h>
 #include <engine/utils/Logging.h>
 #include <engine/utils/FileUtils.h>
 #include <engine/utils/MathUtils.h>
 #include <engine/utils/OSMessageBox.h>
 #include <engine/utils/PlatformMacros.h>
+#include <engine/utils/Profiling.h>
 #include <fstream>
 #include <game/AchievementManager.h>
 #include <game/BoardState.h>
@@ -83,6 +85,30 @@
 ///------------------------------------------------------------------------------------------------
 
 static const strutils::StringId MAIN_MENU_SCENE = strutils::StringId("main_menu_scene");
+static const std::string HEADLESS_ARGUMENT = "--headless";
+static const std::string HEADLESS_FRAMES_ARGUMENT_PREFIX = "--headless-frames=";
+static const std::string BENCHMARK_ARGUMENT = "--benchmark";
+static const std::string DEFAULT_BENCHMARK_REPORT_FILE_PATH = "benchmark_report.json";
+
+///------------------------------------------------------------------------------------------------
+
+struct BenchmarkSceneTransition
+{
+    const char* mPhaseName;
+    strutils::StringId mSceneName;
+    SceneChangeType mSceneChangeType;
+    PreviousSceneDestructionType mPreviousSceneDestructionType;
+    bool mPopsModalScene; // mSceneName is then the scene expected to surface below the popped modal
+};
+
+// Fixed, so that reports of different runs are comparable. Timed in order, starting from the main menu.
+static const std::vector<BenchmarkSceneTransition> BENCHMARK_SCENE_TRANSITIONS =
+{
+    { "card_library_transition", game_constants::CARD_LIBRARY_SCENE, SceneChangeType::MODAL_SCENE, PreviousSceneDestructionType::RETAIN_PREVIOUS_SCENE, false },
+    { "card_library_pop", MAIN_MENU_SCENE, SceneChangeType::MODAL_SCENE, PreviousSceneDestructionType::RETAIN_PREVIOUS_SCENE, true },
+    { "shop_transition", game_constants::SHOP_SCENE, SceneChangeType::CONCRETE_SCENE_ASYNC_LOADING, PreviousSceneDestructionType::DESTROY_PREVIOUS_SCENE, false },
+    { "main_menu_transition", MAIN_MENU_SCENE, SceneChangeType::CONCRETE_SCENE_ASYNC_LOADING, PreviousSceneDestructionType::DESTROY_PREVIOUS_SCENE, false }
+};
 
 ///------------------------------------------------------------------------------------------------
 
@@ -90,15 +116,76 @@ Game::Game(const int argc, char** argv)
 {
     if (argc > 0)
     {
-        logging::Log(logging::LogType::INFO, "Initializing from CWD : %s", argv[0]);
+        LOG(logging::LogType::INFO, "Initializing from CWD : %s", argv[0]);
+    }
+    
+    // --headless[=recorder] [--headless-frames=<count>] [--benchmark[=<report file path>]]
+    auto headlessMode = HeadlessMode::NONE;
+    auto headlessMaxFrameCount = 0;
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string argument(argv[i]);
+        if (argument == HEADLESS_ARGUMENT)
+        {
+            headlessMode = HeadlessMode::OFFSCREEN_GL;
+        }
+        else if (argument == HEADLESS_ARGUMENT + "=recorder")
+        {
+            headlessMode = HeadlessMode::COMMAND_RECORDER;
+        }
+        else if (strutils::StringStartsWith(argument, HEADLESS_FRAMES_ARGUMENT_PREFIX) && strutils::StringIsInt(argument.substr(HEADLESS_FRAMES_ARGUMENT_PREFIX.size())))
+        {
+            headlessMaxFrameCount = std::stoi(argument.substr(HEADLESS_FRAMES_ARGUMENT_PREFIX.size()));
+        }
+        else if (argument == BENCHMARK_ARGUMENT || strutils::StringStartsWith(argument, BENCHMARK_ARGUMENT + "="))
+        {
+            mBenchmarkReport = std::make_unique<benchmark::Report>();
+            mBenchmarkReportFilePath = argument == BENCHMARK_ARGUMENT ? DEFAULT_BENCHMARK_REPORT_FILE_PATH : argument.substr(BENCHMARK_ARGUMENT.size() + 1);
+        }
+    }
+    
+    if (headlessMode != HeadlessMode::NONE)
+    {
+        CoreSystemsEngine::SetHeadlessMode(headlessMode, headlessMaxFrameCount);
     }
     
 #if defined(MACOS) || defined(MOBILE_FLOW)
     apple_utils::SetAssetFolder();
 #endif
+    
+    // Cold start phases: SDL and engine systems initialization, game data loading, game initialization
+    // (particles, fonts, scene logic managers etc.) and finally the main menu's first frame (\see UpdateBenchmark)
+    if (mBenchmarkReport)
+    {
+        using namespace date;
+        std::stringstream dateNow;
+        dateNow << std::chrono::system_clock::now();
+        
+        mBenchmarkReport->SetMetadata("date", dateNow.str());
+        mBenchmarkReport->SetMetadata("context", headlessMode == HeadlessMode::NONE ? "windowed" : (headlessMode == HeadlessMode::OFFSCREEN_GL ? "offscreen" : "recorder"));
+#if defined(NDEBUG)
+        mBenchmarkReport->SetMetadata("build", "release");
+#else
+        mBenchmarkReport->SetMetadata("build", "debug");
+#endif
+        mBenchmarkReport->BeginPhase("engine_initialization");
+    }
+    
+    CoreSystemsEngine::GetInstance();
+    
+    if (mBenchmarkReport)
+    {
+        mBenchmarkReport->BeginPhase("game_data_loading");
+    }
+    
     CardDataRepository::GetInstance().LoadCardData(false);
     ProductRepository::GetInstance().LoadProductDefinitions();
     
+    if (mBenchmarkReport)
+    {
+        mBenchmarkReport->BeginPhase("game_initialization");
+    }
+    
     CoreSystemsEngine::GetInstance().Start([&](){ Init(); }, [&](const float dtMillis){ Update(dtMillis); }, [&](){ ApplicationMovedToBackground(); }, [&](){ WindowResize(); }, [&](){ CreateDebugWidgets(); }, [&](){ OnOneSecondElapsed(); });
 }
 
@@ -220,19 +307,32 @@ void Game::Init()
 #endif
 
     mGameSceneTransitionManager->ChangeToScene(MAIN_MENU_SCENE, SceneChangeType::CONCRETE_SCENE_ASYNC_LOADING, PreviousSceneDestructionType::RETAIN_PREVIOUS_SCENE);
+    
+    if (mBenchmarkReport)
+    {
+        // The scripted transitions need the same behavior types the main menu's buttons would set
+        DataRepository::GetInstance().SetCurrentCardLibraryBehaviorType(CardLibraryBehaviorType::CARD_LIBRARY);
+        DataRepository::GetInstance().SetCurrentShopBehaviorType(ShopBehaviorType::PERMA_SHOP);
+        mBenchmarkReport->BeginPhase("main_menu_first_frame");
+    }
 }
 
 ///------------------------------------------------------------------------------------------------
 
 void Game::Update(const float dtMillis)
 {
+    PROFILE_SCOPE("Game::Update");
+    
+    events::EventSystem::GetInstance().DispatchQueuedEvents();
+    
     auto& animationManager = CoreSystemsEngine::GetInstance().GetAnimationManager();
     auto& sceneManager = CoreSystemsEngine::GetInstance().GetSceneManager();
     auto cardPackRewardScene = sceneManager.FindScene(game_constants::CARD_PACK_REWARD_SCENE);
     
-    // Cloud Data Sync
+    // Cloud Data Sync (scripted benchmark runs are never interrupted by surfacing modals)
     if
     (
+        !mBenchmarkReport &&
         DataRepository::GetInstance().CanSurfaceCloudDataScene() &&
         DataRepository::GetInstance().GetForeignProgressionDataFound() != ForeignCloudDataFoundType::NONE &&
         mGameSceneTransitionManager->GetActiveSceneStack().top().mActiveSceneName == MAIN_MENU_SCENE &&
@@ -245,6 +345,7 @@ void Game::Update(const float dtMillis)
     // Pending Card Packs
     else if
     (
+        !mBenchmarkReport &&
         !DataRepository::GetInstance().GetPendingCardPacks().empty() &&
         mGameSceneTransitionManager->GetActiveSceneStack().top().mActiveSceneName == MAIN_MENU_SCENE &&
         (!cardPackRewardScene || !cardPackRewardScene->FindSceneObject(game_constants::OVERLAY_SCENE_OBJECT_NAME)) &&
@@ -258,6 +359,61 @@ void Game::Update(const float dtMillis)
     mTutorialManager->Update(dtMillis);
     AchievementManager::GetInstance().Update(dtMillis, mGameSceneTransitionManager->GetActiveSceneLogicManager()->VGetGuiObjectManager());
     mGameSceneTransitionManager->Update(dtMillis);
+    
+    if (mBenchmarkReport)
+    {
+        UpdateBenchmark();
+    }
+}
+
+///------------------------------------------------------------------------------------------------
+
+void Game::UpdateBenchmark()
+{
+    const auto& targetSceneName = mBenchmarkSceneTransitionIndex < 0 ? MAIN_MENU_SCENE : BENCHMARK_SCENE_TRANSITIONS[mBenchmarkSceneTransitionIndex].mSceneName;
+    
+    // A phase ends once its scene is on top of the stack, loaded, and has been rendered at least once since
+    if (mBenchmarkSceneReadyFrameCount < 0)
+    {
+        auto targetScene = CoreSystemsEngine::GetInstance().GetSceneManager().FindScene(targetSceneName);
+        if (mGameSceneTransitionManager->GetActiveSceneStack().top().mActiveSceneName == targetSceneName && targetScene && targetScene->IsLoaded())
+        {
+            mBenchmarkSceneReadyFrameCount = benchmark::GetCounters().mRenderedFrameCount;
+        }
+        return;
+    }
+    
+    if (benchmark::GetCounters().mRenderedFrameCount <= mBenchmarkSceneReadyFrameCount)
+    {
+        return;
+    }
+    
+    mBenchmarkReport->EndPhase();
+    mBenchmarkSceneReadyFrameCount = -1;
+    
+    if (++mBenchmarkSceneTransitionIndex < static_cast<int>(BENCHMARK_SCENE_TRANSITIONS.size()))
+    {
+        const auto& sceneTransition = BENCHMARK_SCENE_TRANSITIONS[mBenchmarkSceneTransitionIndex];
+        mBenchmarkReport->BeginPhase(sceneTransition.mPhaseName);
+        
+        if (sceneTransition.mPopsModalScene)
+        {
+            mGameSceneTransitionManager->PopModalScene();
+        }
+        else
+        {
+            mGameSceneTransitionManager->ChangeToScene(sceneTransition.mSceneName, sceneTransition.mSceneChangeType, sceneTransition.mPreviousSceneDestructionType);
+        }
+    }
+    else
+    {
+        mBenchmarkReport->WriteToFile(mBenchmarkReportFilePath);
+        mBenchmarkReport.reset();
+        
+        SDL_Event quitEvent{};
+        quitEvent.type = SDL_QUIT;
+        SDL_PushEvent(&quitEvent);
+    }
 }
 
 ///------------------------------------------------------------------------------------------------
@@ -11,10 +11,12 @@
 ///------------------------------------------------------------------------------------------------
 
 #include <memory>
+#include <string>
 #include <game/events/EventSystem.h>
 
 ///------------------------------------------------------------------------------------------------
 
+namespace benchmark { class Report; }
 class GameSceneTransitionManager;
 class TutorialManager;
 class Game final
@@ -30,6 +32,9 @@ public:
     void OnOneSecondElapsed();
     void CreateDebugWidgets();
     
+private:
+    void UpdateBenchmark();
+    
 private:
     std::unique_ptr<GameSceneTransitionManager> mGameSceneTransitionManager;
     std::unique_ptr<TutorialManager> mTutorialManager;
@@ -37,6 +42,10 @@ private:
     std::unique_ptr<events::IListener> mPopModalSceneEventListener;
     std::unique_ptr<events::IListener> mRequestReviewEventListener;
     std::unique_ptr<events::IListener> mSendPlayMessageEventListener;
+    std::unique_ptr<benchmark::Report> mBenchmarkReport;
+    std::string mBenchmarkReportFilePath;
+    int mBenchmarkSceneTransitionIndex = -1;
+    long long mBenchmarkSceneReadyFrameCount = -1;
 };
 
 ///------------------------------------------------------------------------------------------------
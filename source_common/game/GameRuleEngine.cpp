@@ -43,7 +43,7 @@ bool GameRuleEngine::CanCardBePlayed(const CardData* cardData, const size_t card
         return false;
     }
     
-    if (strutils::StringContains(cardData->mCardEffect, effects::EFFECT_COMPONENT_HOUND_SUMMONING))
+    if (cardData->HasEffectComponent(effects::effect_component_masks::HOUND_SUMMONING))
     {
         auto effectSplitBySpace = strutils::StringSplit(cardData->mCardEffect, ' ');
         auto summonCount = effectSplitBySpace[0] == effects::EFFECT_COMPONENT_HOUND_SUMMONING ? std::stoi(effectSplitBySpace[1]) : std::stoi(effectSplitBySpace[0]);
@@ -54,7 +54,7 @@ bool GameRuleEngine::CanCardBePlayed(const CardData* cardData, const size_t card
         }
     }
     
-    if (strutils::StringContains(cardData->mCardEffect, effects::EFFECT_COMPONENT_METEOR))
+    if (cardData->HasEffectComponent(effects::effect_component_masks::METEOR))
     {
         if (std::find_if(activePlayerState.mPlayerHeldCards.begin(), activePlayerState.mPlayerHeldCards.end(), [&](const int cardId)
         {
@@ -66,7 +66,7 @@ bool GameRuleEngine::CanCardBePlayed(const CardData* cardData, const size_t card
         }
     }
     
-    if (strutils::StringContains(cardData->mCardEffect, effects::EFFECT_COMPONENT_SWAP_MIN_MAX_DAMAGE))
+    if (cardData->HasEffectComponent(effects::effect_component_masks::SWAP_MIN_MAX_DAMAGE))
     {
         auto applicableCards = 0;
         for (auto i = 0; i < static_cast<int>(activePlayerState.mPlayerHeldCards.size()); ++i)
@@ -12,6 +12,7 @@
 #include <engine/scene/SceneManager.h>
 #include <engine/scene/Scene.h>
 #include <engine/utils/Logging.h>
+#include <engine/utils/Profiling.h>
 #include <game/events/EventSystem.h>
 #include <SDL.h>
 
@@ -94,6 +95,8 @@ void GameSceneTransitionManager::Update(const float dtMillis)
     
     if (activeScene->IsLoaded() && !activeTutorialExists && !activeUnlockedAchievementExists)
     {
+        // Zoned by scene name (interned, so it outlives the trace), which also tells apart scenes sharing a logic manager
+        PROFILE_SCOPE(activeScene->GetName().GetString().c_str());
         mActiveSceneStack.top().mActiveSceneLogicManager->VUpdate(dtMillis, activeScene);
     }
 }
@@ -59,7 +59,7 @@ struct MapCoordHasher
 {
     std::size_t operator()(const MapCoord& key) const
     {
-        return strutils::StringId(key.ToString()).GetStringId();
+        return std::hash<int>()(key.mCol) * 31 + std::hash<int>()(key.mRow);
     }
 };
 
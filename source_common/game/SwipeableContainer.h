@@ -18,6 +18,7 @@
 #include <engine/utils/MathUtils.h>
 #include <engine/utils/StringUtils.h>
 
+#include <algorithm>
 #include <vector>
 
 ///------------------------------------------------------------------------------------------------
@@ -240,15 +241,16 @@ public:
                 mSwipeDurationMillis = 0.0f;
                 updateResult.mInteractionType = InteractionType::INTERACTED_WITH_CONTAINER_AREA;
                 
-                for (int i = 0; i < static_cast<int>(mItems.size()); ++i)
+                const auto isItemSceneObject = [&](const scene::SceneObject& sceneObject)
                 {
-                    auto sceneObjectRect = scene_object_utils::GetSceneObjectBoundingRect(*mItems[i].mSceneObjects.front());
-                    
-                    if (math::IsPointInsideRectangle(sceneObjectRect.bottomLeft, sceneObjectRect.topRight, worldTouchPos))
-                    {
-                        updateResult.mInteractionType = InteractionType::INTERACTED_WITH_ELEMENTS;
-                        updateResult.mInteractedElementIndex = i;
-                    }
+                    return std::find_if(mItems.begin(), mItems.end(), [&](const ContainerEntryT& item){ return item.mSceneObjects.front().get() == &sceneObject; }) != mItems.end();
+                };
+                
+                auto interactedSceneObject = mScene.FindTopMostSceneObjectAtPoint(worldTouchPos, isItemSceneObject);
+                if (interactedSceneObject)
+                {
+                    updateResult.mInteractionType = InteractionType::INTERACTED_WITH_ELEMENTS;
+                    updateResult.mInteractedElementIndex = static_cast<int>(std::find_if(mItems.begin(), mItems.end(), [&](const ContainerEntryT& item){ return item.mSceneObjects.front() == interactedSceneObject; }) - mItems.begin());
                 }
             }
             else if (!touchInVisibleContainerArea || animationManager.IsAnimationPlaying(RUBBER_BANDING_ANIMATION_NAME))
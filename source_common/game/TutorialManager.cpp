@@ -370,7 +370,7 @@ void TutorialManager::OnTutorialTrigger(const events::TutorialTriggerEvent& even
     // Tutorial definition not found
     if (mTutorialDefinitions.count(event.mTutorialName) == 0)
     {
-        logging::Log(logging::LogType::ERROR, "Tried to surface unknown tutorial %s", event.mTutorialName.GetString().c_str());
+        LOG(logging::LogType::ERROR, "Tried to surface unknown tutorial %s", event.mTutorialName.GetString().c_str());
         assert(false);
         return;
     }
@@ -22,12 +22,27 @@ EventSystem& EventSystem::GetInstance()
 
 ///------------------------------------------------------------------------------------------------
 
-void EventSystem::UnregisterAllEventsForListener(const IListener* listener)
+void EventSystem::UnregisterAllEventsForListener(IListener* listener)
 {
-    for (auto& eventEntry: mEventIdToDeadListenerIds)
+    for (const auto& registration: listener->mRegistrations)
     {
-        eventEntry.second.insert(std::make_pair(listener, listener->mInstanceId));
+        registration.mEventListenerSlots->VRemoveListener(registration.mSlotHandle);
     }
+    
+    listener->mRegistrations.clear();
+}
+
+///------------------------------------------------------------------------------------------------
+
+void EventSystem::DispatchQueuedEvents()
+{
+    // Event types queued by the callbacks below are deferred to the next flush
+    std::swap(mListenerSlotsWithQueuedEvents, mListenerSlotsBeingFlushed);
+    for (auto* eventListenerSlots: mListenerSlotsBeingFlushed)
+    {
+        eventListenerSlots->VDispatchQueuedEvents();
+    }
+    mListenerSlotsBeingFlushed.clear();
 }
 
 ///------------------------------------------------------------------------------------------------
@@ -12,10 +12,11 @@
 
 #include <engine/utils/TypeTraits.h>
 #include <game/events/Events.h>
+#include <algorithm>
+#include <cstdint>
 #include <functional>
+#include <memory>
 #include <string>
-#include <unordered_map>
-#include <set>
 #include <vector>
 
 ///------------------------------------------------------------------------------------------------
@@ -25,31 +26,236 @@ namespace events
 
 ///------------------------------------------------------------------------------------------------
 
+class IEventListenerSlots;
+
+///------------------------------------------------------------------------------------------------
+/// Identifies a single listener slot of an event type. The generation is bumped whenever the
+/// slot is removed, so that a stale handle can never remove a slot that reused its index.
+struct ListenerSlotHandle
+{
+    std::uint32_t mIndex;
+    std::uint32_t mGeneration;
+};
+
+///------------------------------------------------------------------------------------------------
+
 class IListener
 {
+    friend class EventSystem;
+
 public:
     IListener();
     virtual ~IListener();
     
 public:
     const std::size_t mInstanceId;
+
+private:
+    struct Registration
+    {
+        IEventListenerSlots* mEventListenerSlots;
+        ListenerSlotHandle mSlotHandle;
+    };
+    
+    // Only holds one entry per event type the listener is registered for, so lookups here
+    // are independent of how many other listeners exist for that event type.
+    std::vector<Registration> mRegistrations;
 };
 
 ///------------------------------------------------------------------------------------------------
 
-struct DeadListenerHasher
+class IEventListenerSlots
 {
-    std::size_t operator()(const std::pair<const IListener*, std::size_t>& key) const
-    {
-        return key.second;
-    }
+public:
+    virtual ~IEventListenerSlots() = default;
+    virtual void VRemoveListener(const ListenerSlotHandle& slotHandle) = 0;
+    virtual void VDispatchQueuedEvents() = 0;
 };
 
+///------------------------------------------------------------------------------------------------
+/// Dense, per event type listener storage. Slots are kept sorted by listener instance id
+/// (i.e. dispatch happens in listener creation order). Each slot is reachable in O(1) through
+/// its generation counted handle, so removal only flags the slot as dead; dead slots are then
+/// compacted away outside of any in-flight dispatch of the same event type. Compaction keeps the
+/// dispatch order (instead of swap-removing) and repoints the handles of the slots it moves.
 template<typename EventType>
-bool operator < (const std::pair<IListener*, std::function<void(const EventType&)>>& lhs, const std::pair<IListener*, std::function<void(const EventType&)>>& rhs)
+class EventListenerSlots final: public IEventListenerSlots
 {
-    return lhs.first->mInstanceId < rhs.first->mInstanceId;
-}
+public:
+    using CallbackType = std::function<void(const EventType&)>;
+
+public:
+    ListenerSlotHandle AddListener(const IListener* listener, CallbackType callback)
+    {
+        const auto handleIndex = AllocateHandleIndex();
+        Slot slot{ listener->mInstanceId, std::move(callback), handleIndex, true };
+        
+        // Slots registered mid-dispatch are parked so that the slot vector is never
+        // reallocated underneath a running callback. They start receiving events from
+        // the next dispatch onwards.
+        if (mDispatchDepth > 0)
+        {
+            mHandleEntries[handleIndex].mSlotIndex = static_cast<std::uint32_t>(mPendingSlots.size());
+            mHandleEntries[handleIndex].mIsPending = true;
+            mPendingSlots.push_back(std::move(slot));
+        }
+        else
+        {
+            Compact();
+            InsertSlot(std::move(slot));
+        }
+        
+        return { handleIndex, mHandleEntries[handleIndex].mGeneration };
+    }
+    
+    void VRemoveListener(const ListenerSlotHandle& slotHandle) override
+    {
+        auto& handleEntry = mHandleEntries[slotHandle.mIndex];
+        if (handleEntry.mGeneration != slotHandle.mGeneration)
+        {
+            return;
+        }
+        
+        if (handleEntry.mIsPending)
+        {
+            mPendingSlots[handleEntry.mSlotIndex].mAlive = false;
+            mDeadPendingSlotCount++;
+        }
+        else
+        {
+            mSlots[handleEntry.mSlotIndex].mAlive = false;
+            mDeadSlotCount++;
+        }
+        
+        // The dead slot keeps pointing at this handle index until it is compacted away, but
+        // compaction only repoints handles of alive slots so the index can be reused right away.
+        handleEntry.mGeneration++;
+        mFreeHandleIndices.push_back(slotHandle.mIndex);
+    }
+    
+    void Dispatch(const EventType& event)
+    {
+        mDispatchDepth++;
+        
+        const auto slotCount = mSlots.size();
+        for (size_t i = 0; i < slotCount; ++i)
+        {
+            if (mSlots[i].mAlive)
+            {
+                mSlots[i].mCallback(event);
+            }
+        }
+        
+        mDispatchDepth--;
+        
+        if (mDispatchDepth == 0)
+        {
+            Compact();
+        }
+    }
+    
+    // Returns true if this is the first event queued since the last flush
+    template<class... Args>
+    bool QueueEvent(Args&&... args)
+    {
+        mQueuedEvents.emplace_back(std::forward<Args>(args)...);
+        return mQueuedEvents.size() == 1;
+    }
+    
+    void VDispatchQueuedEvents() override
+    {
+        // Events queued by the callbacks below are deferred to the next flush
+        std::swap(mQueuedEvents, mEventsBeingDispatched);
+        for (const auto& event: mEventsBeingDispatched)
+        {
+            Dispatch(event);
+        }
+        mEventsBeingDispatched.clear();
+    }
+    
+    size_t GetAliveListenerCount() const
+    {
+        return mSlots.size() - mDeadSlotCount + mPendingSlots.size() - mDeadPendingSlotCount;
+    }
+
+private:
+    struct Slot
+    {
+        std::size_t mListenerInstanceId;
+        CallbackType mCallback;
+        std::uint32_t mHandleIndex;
+        bool mAlive;
+    };
+    
+    struct HandleEntry
+    {
+        std::uint32_t mSlotIndex = 0;
+        std::uint32_t mGeneration = 0;
+        bool mIsPending = false;
+    };
+    
+    std::uint32_t AllocateHandleIndex()
+    {
+        if (!mFreeHandleIndices.empty())
+        {
+            const auto handleIndex = mFreeHandleIndices.back();
+            mFreeHandleIndices.pop_back();
+            return handleIndex;
+        }
+        
+        mHandleEntries.emplace_back();
+        return static_cast<std::uint32_t>(mHandleEntries.size() - 1);
+    }
+    
+    void RepointHandles(const size_t firstSlotIndex)
+    {
+        for (size_t i = firstSlotIndex; i < mSlots.size(); ++i)
+        {
+            auto& handleEntry = mHandleEntries[mSlots[i].mHandleIndex];
+            handleEntry.mSlotIndex = static_cast<std::uint32_t>(i);
+            handleEntry.mIsPending = false;
+        }
+    }
+    
+    void InsertSlot(Slot&& slot)
+    {
+        auto insertionIter = std::upper_bound(mSlots.begin(), mSlots.end(), slot.mListenerInstanceId, [](const std::size_t instanceId, const Slot& existingSlot){ return instanceId < existingSlot.mListenerInstanceId; });
+        const auto insertionIndex = static_cast<size_t>(std::distance(mSlots.begin(), insertionIter));
+        mSlots.insert(insertionIter, std::move(slot));
+        RepointHandles(insertionIndex);
+    }
+    
+    void Compact()
+    {
+        if (mDeadSlotCount > 0)
+        {
+            mSlots.erase(std::remove_if(mSlots.begin(), mSlots.end(), [](const Slot& slot){ return !slot.mAlive; }), mSlots.end());
+            mDeadSlotCount = 0;
+            RepointHandles(0);
+        }
+        
+        for (auto& pendingSlot: mPendingSlots)
+        {
+            if (pendingSlot.mAlive)
+            {
+                InsertSlot(std::move(pendingSlot));
+            }
+        }
+        mPendingSlots.clear();
+        mDeadPendingSlotCount = 0;
+    }
+
+private:
+    std::vector<Slot> mSlots;
+    std::vector<Slot> mPendingSlots;
+    std::vector<HandleEntry> mHandleEntries;
+    std::vector<std::uint32_t> mFreeHandleIndices;
+    std::vector<EventType> mQueuedEvents;
+    std::vector<EventType> mEventsBeingDispatched;
+    size_t mDeadSlotCount = 0;
+    size_t mDeadPendingSlotCount = 0;
+    int mDispatchDepth = 0;
+};
 
 ///------------------------------------------------------------------------------------------------
 
@@ -58,81 +264,103 @@ class EventSystem final
 public:
     static EventSystem& GetInstance();
     
+    // While any is alive, dispatched and queued events are dropped instead of reaching their
+    // listeners, e.g. for headless battle simulations running alongside the live battle.
+    class SuppressionScope final
+    {
+    public:
+        SuppressionScope() { EventSystem::GetInstance().mSuppressionScopeCount++; }
+        ~SuppressionScope() { EventSystem::GetInstance().mSuppressionScopeCount--; }
+        
+        SuppressionScope(const SuppressionScope&) = delete;
+        SuppressionScope& operator = (const SuppressionScope&) = delete;
+    };
+    
     template<typename EventType, class... Args>
     void DispatchEvent(Args&&... args)
     {
+        if (mSuppressionScopeCount > 0)
+        {
+            return;
+        }
+        
         EventType event(std::forward<Args>(args)...);
+        mEventListenerSlots<EventType>.Dispatch(event);
+    }
+    
+    // Deferred variant of DispatchEvent. Queued events are batched per event type
+    // and dispatched once per frame from DispatchQueuedEvents.
+    template<typename EventType, class... Args>
+    void QueueEvent(Args&&... args)
+    {
+        if (mSuppressionScopeCount > 0)
+        {
+            return;
+        }
         
-        CleanCallbacks<EventType>();
-        if (!mEventCallbacks<EventType>.empty())
+        if (mEventListenerSlots<EventType>.QueueEvent(std::forward<Args>(args)...))
         {
-            for (auto callbackIter = mEventCallbacks<EventType>.begin(); callbackIter != mEventCallbacks<EventType>.end();)
-            {
-                callbackIter->second(event);
-                callbackIter++;
-            }
+            mListenerSlotsWithQueuedEvents.push_back(&mEventListenerSlots<EventType>);
         }
-    };
+    }
     
     template<typename EventType, typename FunctionType>
     [[nodiscard]] std::unique_ptr<IListener> RegisterForEvent(FunctionType callback)
     {
-        CleanCallbacks<EventType>();
         auto listener = std::make_unique<IListener>();
-        mEventCallbacks<EventType>.insert(std::make_pair(listener.get(), callback));
+        const auto slotHandle = mEventListenerSlots<EventType>.AddListener(listener.get(), callback);
+        listener->mRegistrations.push_back({ &mEventListenerSlots<EventType>, slotHandle });
         return listener;
     }
     
     template<typename EventType, typename InstanceType, typename FunctionType>
     void RegisterForEvent(InstanceType* listener, FunctionType callback)
     {
-        CleanCallbacks<EventType>();
-        mEventCallbacks<EventType>.insert(std::make_pair(listener, [listener, callback](const EventType& e){ (listener->*callback)(e); }));
+        auto& registrations = static_cast<IListener*>(listener)->mRegistrations;
+        if (FindRegistration(registrations, &mEventListenerSlots<EventType>) != registrations.end())
+        {
+            return;
+        }
+        
+        const auto slotHandle = mEventListenerSlots<EventType>.AddListener(listener, [listener, callback](const EventType& e){ (listener->*callback)(e); });
+        registrations.push_back({ &mEventListenerSlots<EventType>, slotHandle });
     }
     
     template<typename EventType>
     void UnregisterForEvent(IListener* listener)
     {
-        mEventCallbacks<EventType>.erase(std::make_pair(listener, nullptr));
+        auto registrationIter = FindRegistration(listener->mRegistrations, &mEventListenerSlots<EventType>);
+        if (registrationIter != listener->mRegistrations.end())
+        {
+            mEventListenerSlots<EventType>.VRemoveListener(registrationIter->mSlotHandle);
+            *registrationIter = listener->mRegistrations.back();
+            listener->mRegistrations.pop_back();
+        }
     }
     
-    void UnregisterAllEventsForListener(const IListener* listener);
-    
-private:
     template<typename EventType>
-    void CleanCallbacks()
+    size_t GetListenerCount() const
     {
-        auto eventTypeId = GetTypeHash<EventType>();
-        mEventIdToDeadListenerIds[eventTypeId];
-        
-        for (auto callbackIter = mEventCallbacks<EventType>.begin(); callbackIter != mEventCallbacks<EventType>.end();)
-        {
-            bool foundInDeadListenerIds = false;
-            for (auto deadListenerIter = mEventIdToDeadListenerIds[eventTypeId].begin(); deadListenerIter != mEventIdToDeadListenerIds[eventTypeId].end() && !foundInDeadListenerIds;)
-            {
-                if (deadListenerIter->first == callbackIter->first)
-                {
-                    callbackIter = mEventCallbacks<EventType>.erase(callbackIter);
-                    mEventIdToDeadListenerIds[eventTypeId].erase(deadListenerIter);
-                    foundInDeadListenerIds = true;
-                    break;
-                }
-                deadListenerIter++;
-            }
-            
-            if (!foundInDeadListenerIds)
-            {
-                callbackIter++;
-            }
-        }
+        return mEventListenerSlots<EventType>.GetAliveListenerCount();
     }
     
+    void UnregisterAllEventsForListener(IListener* listener);
+    void DispatchQueuedEvents();
+    
+private:
     EventSystem() = default;
     
+    static std::vector<IListener::Registration>::iterator FindRegistration(std::vector<IListener::Registration>& registrations, const IEventListenerSlots* eventListenerSlots)
+    {
+        return std::find_if(registrations.begin(), registrations.end(), [&](const IListener::Registration& registration){ return registration.mEventListenerSlots == eventListenerSlots; });
+    }
+    
 private:
     template<typename EventType>
-    static inline std::set<std::pair<IListener*, std::function<void(const EventType&)>>> mEventCallbacks;
-    std::unordered_map<std::size_t, std::unordered_set<std::pair<const IListener*, std::size_t>, DeadListenerHasher>> mEventIdToDeadListenerIds;
+    static inline EventListenerSlots<EventType> mEventListenerSlots;
+    std::vector<IEventListenerSlots*> mListenerSlotsWithQueuedEvents;
+    std::vector<IEventListenerSlots*> mListenerSlotsBeingFlushed;
+    int mSuppressionScopeCount = 0;
 };
 
 ///------------------------------------------------------------------------------------------------
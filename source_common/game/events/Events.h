@@ -253,6 +253,13 @@ public:
     const std::unordered_map<std::string, std::string> mExtraActionParams;
 };
 
+///------------------------------------------------------------------------------------------------
+/// Dispatched right before a serializable action sets its new game state, i.e. once all actions
+/// serialized before it (and any they pushed) have been applied to the board.
+class SerializableGameActionAboutToApplyEvent final
+{
+};
+
 ///------------------------------------------------------------------------------------------------
 
 class NewBoardCardCreatedEvent final
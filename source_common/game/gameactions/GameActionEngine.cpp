@@ -7,6 +7,7 @@
 
 #include <engine/utils/Logging.h>
 #include <engine/utils/MathUtils.h>
+#include <engine/utils/Profiling.h>
 #include <game/events/EventSystem.h>
 #include <game/gameactions/GameActionEngine.h>
 #include <game/gameactions/GameActionFactory.h>
@@ -44,12 +45,14 @@ GameActionEngine::~GameActionEngine()
 
 void GameActionEngine::Update(const float dtMillis)
 {
+    PROFILE_SCOPE("GameActionEngine::Update");
+    
     if (mOperationMode == EngineOperationMode::HEADLESS)
     {
         if (GetActiveGameActionName() != IDLE_GAME_ACTION_NAME)
         {
             auto sizeBefore = mGameActions.size();
-            mGameActions.front()->VSetNewGameState();
+            SetActiveActionNewGameState();
             ReadjustActionQueue(sizeBefore);
             
             mGameActions.pop();
@@ -69,7 +72,7 @@ void GameActionEngine::Update(const float dtMillis)
                 LogActionTransition("Setting state and initializing animation of action " + mGameActions.front()->VGetName().GetString());
                 
                 auto sizeBefore = mGameActions.size();
-                mGameActions.front()->VSetNewGameState();
+                SetActiveActionNewGameState();
                 mGameActions.front()->VInitAnimation();
                 mActiveActionHasSetState = true;
                 ReadjustActionQueue(sizeBefore);
@@ -150,11 +153,23 @@ void GameActionEngine::CreateAndPushGameAction(const strutils::StringId& actionN
 
 ///------------------------------------------------------------------------------------------------
 
+void GameActionEngine::SetActiveActionNewGameState()
+{
+    if (mGameActions.front()->VShouldBeSerialized())
+    {
+        events::EventSystem::GetInstance().DispatchEvent<events::SerializableGameActionAboutToApplyEvent>();
+    }
+    
+    mGameActions.front()->VSetNewGameState();
+}
+
+///------------------------------------------------------------------------------------------------
+
 void GameActionEngine::LogActionTransition(const std::string& actionTransition)
 {
     if (mLoggingActionTransitions)
     {
-        logging::Log(logging::LogType::INFO, "%s", actionTransition.c_str());
+        LOG_CATEGORY(logging::LogCategory::GAME_ACTIONS, logging::LogType::INFO, "%s", actionTransition.c_str());
     }
 }
 
@@ -47,6 +47,7 @@ public:
     
 private:
     void CreateAndPushGameAction(const strutils::StringId& actionName, const ExtraActionParams& extraActionParams);
+    void SetActiveActionNewGameState();
     void LogActionTransition(const std::string& actionTransition);
     void ReadjustActionQueue(const size_t sizeBeforeNewState);
     
@@ -64,7 +64,7 @@ static const std::vector<std::string> sRequiredExtraParamNames =
 void GameOverGameAction::VSetNewGameState()
 {
     assert(mExtraActionParams.count(VICTORIOUS_PLAYER_INDEX_PARAM) != 0);
-    logging::Log(logging::LogType::INFO, "%s", ("Player " + mExtraActionParams.at(VICTORIOUS_PLAYER_INDEX_PARAM) + " won!").c_str());
+    LOG(logging::LogType::INFO, "%s", ("Player " + mExtraActionParams.at(VICTORIOUS_PLAYER_INDEX_PARAM) + " won!").c_str());
 }
 
 ///------------------------------------------------------------------------------------------------
@@ -21,6 +21,46 @@ static const strutils::StringId NEXT_PLAYER_GAME_ACTION_NAME = strutils::StringI
 
 ///------------------------------------------------------------------------------------------------
 
+enum class HighPriorityCondition
+{
+    ALWAYS,
+    COIN_FLIP,          // Only high priority half of the time for the OPTIMISED generation type
+    NOT_ALREADY_ACTIVE  // Only high priority if the respective board modifier is not already active (for the OPTIMISED generation type)
+};
+
+static const std::vector<std::pair<effects::EffectComponentMask, HighPriorityCondition>> HIGH_PRIORITY_SPELL_EFFECT_COMPONENTS =
+{
+    { effects::effect_component_masks::DRAW,                                  HighPriorityCondition::COIN_FLIP },
+    { effects::effect_component_masks::FAMILY,                                HighPriorityCondition::COIN_FLIP },
+    { effects::effect_component_masks::RANDOM_HAND_BUFF_ATTACK,               HighPriorityCondition::ALWAYS },
+    { effects::effect_component_masks::TRIPPLES_LOWEST_ATTACK_ON_HAND,        HighPriorityCondition::ALWAYS },
+    { effects::effect_component_masks::SWAP_MIN_MAX_DAMAGE,                   HighPriorityCondition::ALWAYS },
+    { effects::effect_component_masks::CLEAR_EFFECTS,                         HighPriorityCondition::COIN_FLIP },
+    { effects::effect_component_masks::DUPLICATE_INSECT,                      HighPriorityCondition::ALWAYS },
+    { effects::effect_component_masks::SPELL_KILL,                            HighPriorityCondition::ALWAYS },
+    { effects::effect_component_masks::ADD_POISON_STACKS,                     HighPriorityCondition::ALWAYS },
+    { effects::effect_component_masks::DOUBLE_NEXT_DINO_DAMAGE,               HighPriorityCondition::ALWAYS },
+    { effects::effect_component_masks::HEAL_NEXT_DINO_DAMAGE,                 HighPriorityCondition::ALWAYS },
+    { effects::effect_component_masks::PERMANENT_CONTINUAL_WEIGHT_REDUCTION,  HighPriorityCondition::NOT_ALREADY_ACTIVE },
+    { effects::effect_component_masks::EVERY_THIRD_CARD_PLAYED_HAS_ZERO_COST, HighPriorityCondition::ALWAYS },
+    { effects::effect_component_masks::CARD_TOKEN,                            HighPriorityCondition::ALWAYS },
+    { effects::effect_component_masks::ENEMY_BOARD_DEBUFF,                    HighPriorityCondition::COIN_FLIP },
+    { effects::effect_component_masks::DOUBLE_POISON_ATTACKS,                 HighPriorityCondition::ALWAYS },
+    { effects::effect_component_masks::DIG_NO_FAIL,                           HighPriorityCondition::ALWAYS },
+    { effects::effect_component_masks::DRAW_RANDOM_SPELL,                     HighPriorityCondition::ALWAYS },
+    { effects::effect_component_masks::ARMOR,                                 HighPriorityCondition::ALWAYS },
+    { effects::effect_component_masks::DEMON_KILL,                            HighPriorityCondition::COIN_FLIP },
+    { effects::effect_component_masks::TOXIC_BOMB,                            HighPriorityCondition::ALWAYS },
+    { effects::effect_component_masks::INSECT_MEGASWARM,                      HighPriorityCondition::ALWAYS },
+    { effects::effect_component_masks::METEOR,                                HighPriorityCondition::ALWAYS },
+    { effects::effect_component_masks::HOUND_SUMMONING,                       HighPriorityCondition::COIN_FLIP },
+    { effects::effect_component_masks::DEMON_PUNCH,                           HighPriorityCondition::COIN_FLIP },
+    { effects::effect_component_masks::INSECT_VIRUS,                          HighPriorityCondition::ALWAYS },
+    { effects::effect_component_masks::RODENT_LIFESTEAL_ON_ATTACKS,           HighPriorityCondition::ALWAYS }
+};
+
+///------------------------------------------------------------------------------------------------
+
 PlayerActionGenerationEngine::PlayerActionGenerationEngine(GameRuleEngine* gameRuleEngine, GameActionEngine* gameActionEngine, ActionGenerationType actionGenerationType)
     : mGameRuleEngine(gameRuleEngine)
     , mGameActionEngine(gameActionEngine)
@@ -137,174 +177,44 @@ void PlayerActionGenerationEngine::DecideAndPushNextActions(BoardState* currentB
 
 bool PlayerActionGenerationEngine::IsCardHighPriority(const CardData& cardData, BoardState* currentBoardState) const
 {
-    if (
-        cardData.IsSpell() &&
-        strutils::StringContains(cardData.mCardEffect, effects::EFFECT_COMPONENT_DRAW) &&
-        (math::RandomInt(0, 1) == 1 || mActionGenerationType != ActionGenerationType::OPTIMISED)
-    ) return true;
-    
-    else if
-    (
-        cardData.IsSpell() &&
-        strutils::StringContains(cardData.mCardEffect, effects::EFFECT_COMPONENT_FAMILY) &&
-        (math::RandomInt(0, 1) == 1 || mActionGenerationType != ActionGenerationType::OPTIMISED)
-    ) return true;
-    
-    else if
-    (
-        cardData.IsSpell() &&
-        strutils::StringContains(cardData.mCardEffect, effects::EFFECT_COMPONENT_RANDOM_HAND_BUFF_ATTACK)
-    ) return true;
-        
-    else if
-    (
-        cardData.IsSpell() &&
-        strutils::StringContains(cardData.mCardEffect, effects::EFFECT_COMPONENT_TRIPPLES_LOWEST_ATTACK_ON_HAND)
-    ) return true;
-    
-    else if
-    (
-        cardData.IsSpell() &&
-        strutils::StringContains(cardData.mCardEffect, effects::EFFECT_COMPONENT_SWAP_MIN_MAX_DAMAGE)
-    ) return true;
-    
-    else if
-    (
-        cardData.IsSpell() &&
-        strutils::StringContains(cardData.mCardEffect, effects::EFFECT_COMPONENT_CLEAR_EFFECTS) &&
-        (math::RandomInt(0, 1) == 1 || mActionGenerationType != ActionGenerationType::OPTIMISED)
-    ) return true;
-    
-    else if
-    (
-        cardData.IsSpell() &&
-        strutils::StringContains(cardData.mCardEffect, effects::EFFECT_COMPONENT_DUPLICATE_INSECT)
-    ) return true;
-    
-    else if
-    (
-        cardData.IsSpell() &&
-        strutils::StringContains(cardData.mCardEffect, effects::EFFECT_COMPONENT_SPELL_KILL)
-    ) return true;
-    
-    else if
-    (
-        cardData.IsSpell() &&
-        strutils::StringContains(cardData.mCardEffect, effects::EFFECT_COMPONENT_ADD_POISON_STACKS)
-    ) return true;
-    
-    else if
-    (
-        cardData.IsSpell() &&
-        strutils::StringContains(cardData.mCardEffect, effects::EFFECT_COMPONENT_DOUBLE_NEXT_DINO_DAMAGE)
-    ) return true;
-    
-    else if
-    (
-        cardData.IsSpell() &&
-        strutils::StringContains(cardData.mCardEffect, effects::EFFECT_COMPONENT_HEAL_NEXT_DINO_DAMAGE)
-    ) return true;
-    
-    else if
-    (
-        cardData.IsSpell() &&
-        strutils::StringContains(cardData.mCardEffect, effects::EFFECT_COMPONENT_PERMANENT_CONTINUAL_WEIGHT_REDUCTION) &&
-        ((currentBoardState->GetActivePlayerState().mBoardModifiers.mBoardModifierMask & effects::board_modifier_masks::PERMANENT_CONTINUAL_WEIGHT_REDUCTION) == 0 || mActionGenerationType != ActionGenerationType::OPTIMISED)
-    ) return true;
-    
-    else if
-    (
-        cardData.IsSpell() &&
-        strutils::StringContains(cardData.mCardEffect, effects::EFFECT_COMPONENT_EVERY_THIRD_CARD_PLAYED_HAS_ZERO_COST)
-    ) return true;
-    
-    else if
-    (
-        cardData.IsSpell() &&
-        strutils::StringContains(cardData.mCardEffect, effects::EFFECT_COMPONENT_CARD_TOKEN)
-    ) return true;
-    
-    else if
-    (
-        cardData.IsSpell() &&
-        strutils::StringContains(cardData.mCardEffect, effects::EFFECT_COMPONENT_ENEMY_BOARD_DEBUFF) &&
-        (math::RandomInt(0, 1) == 1 || mActionGenerationType != ActionGenerationType::OPTIMISED)
-    ) return true;
-    
-    else if
-    (
-        cardData.IsSpell() &&
-        strutils::StringContains(cardData.mCardEffect, effects::EFFECT_COMPONENT_DOUBLE_POISON_ATTACKS)
-    ) return true;
-    
-    else if
-    (
-        cardData.IsSpell() &&
-        strutils::StringContains(cardData.mCardEffect, effects::EFFECT_COMPONENT_DIG_NO_FAIL)
-    ) return true;
-    
-    else if
-    (
-        cardData.IsSpell() &&
-        strutils::StringContains(cardData.mCardEffect, effects::EFFECT_COMPONENT_DRAW_RANDOM_SPELL)
-    ) return true;
-    
-    else if
-    (
-        cardData.IsSpell() &&
-        strutils::StringContains(cardData.mCardEffect, effects::EFFECT_COMPONENT_ARMOR)
-    ) return true;
-    
-    else if
-    (
-        cardData.IsSpell() &&
-        strutils::StringContains(cardData.mCardEffect, effects::EFFECT_COMPONENT_DEMON_KILL) &&
-        (math::RandomInt(0, 1) == 1 || mActionGenerationType != ActionGenerationType::OPTIMISED)
-    ) return true;
-    
-    else if
-    (
-        cardData.IsSpell() &&
-        strutils::StringContains(cardData.mCardEffect, effects::EFFECT_COMPONENT_TOXIC_BOMB)
-    ) return true;
+    if (!cardData.IsSpell())
+    {
+        return false;
+    }
     
-    else if
-    (
-        cardData.IsSpell() &&
-        strutils::StringContains(cardData.mCardEffect, effects::EFFECT_COMPONENT_INSECT_MEGASWARM)
-    ) return true;
+    // Entries are checked in order since coin flips consume randomness, and
+    // the sequence of random draws needs to stay stable for deterministic battles
+    for (const auto& highPrioritySpellEffectEntry: HIGH_PRIORITY_SPELL_EFFECT_COMPONENTS)
+    {
+        if (!cardData.HasEffectComponent(highPrioritySpellEffectEntry.first))
+        {
+            continue;
+        }
         
-    else if
-    (
-        cardData.IsSpell() &&
-        strutils::StringContains(cardData.mCardEffect, effects::EFFECT_COMPONENT_METEOR)
-    ) return true;
-    
-    else if
-    (
-        cardData.IsSpell() &&
-        strutils::StringContains(cardData.mCardEffect, effects::EFFECT_COMPONENT_HOUND_SUMMONING) &&
-        (math::RandomInt(0, 1) == 1 || mActionGenerationType != ActionGenerationType::OPTIMISED)
-    ) return true;
-    
-    else if
-    (
-        cardData.IsSpell() &&
-        strutils::StringContains(cardData.mCardEffect, effects::EFFECT_COMPONENT_DEMON_PUNCH) &&
-        (math::RandomInt(0, 1) == 1 || mActionGenerationType != ActionGenerationType::OPTIMISED)
-    ) return true;
-    
-    else if
-    (
-        cardData.IsSpell() &&
-        strutils::StringContains(cardData.mCardEffect, effects::EFFECT_COMPONENT_INSECT_VIRUS)
-    ) return true;
-    
-    else if
-    (
-        cardData.IsSpell() &&
-        strutils::StringContains(cardData.mCardEffect, effects::EFFECT_COMPONENT_RODENT_LIFESTEAL_ON_ATTACKS)
-    ) return true;
+        switch (highPrioritySpellEffectEntry.second)
+        {
+            case HighPriorityCondition::ALWAYS:
+            {
+                return true;
+            }
+                
+            case HighPriorityCondition::COIN_FLIP:
+            {
+                if (math::RandomInt(0, 1) == 1 || mActionGenerationType != ActionGenerationType::OPTIMISED)
+                {
+                    return true;
+                }
+            } break;
+                
+            case HighPriorityCondition::NOT_ALREADY_ACTIVE:
+            {
+                if ((currentBoardState->GetActivePlayerState().mBoardModifiers.mBoardModifierMask & effects::board_modifier_masks::PERMANENT_CONTINUAL_WEIGHT_REDUCTION) == 0 || mActionGenerationType != ActionGenerationType::OPTIMISED)
+                {
+                    return true;
+                }
+            } break;
+        }
+    }
     
     return false;
 }
@@ -341,9 +341,9 @@ void BattleSceneLogicManager::InitBattleScene(std::shared_ptr<scene::Scene> scen
     mBoardState->GetPlayerStates()[game_constants::REMOTE_PLAYER_INDEX].mPlayerInitialDeckCards = mBoardState->GetPlayerStates()[game_constants::REMOTE_PLAYER_INDEX].mPlayerDeckCards;
     mBoardState->GetPlayerStates()[game_constants::LOCAL_PLAYER_INDEX].mPlayerInitialDeckCards = mBoardState->GetPlayerStates()[game_constants::LOCAL_PLAYER_INDEX].mPlayerDeckCards;
     
-    mBattleSerializer = std::make_unique<BattleSerializer>(seed, mBoardState->GetPlayerStates()[game_constants::REMOTE_PLAYER_INDEX].mPlayerDeckCards, mBoardState->GetPlayerStates()[game_constants::LOCAL_PLAYER_INDEX].mPlayerDeckCards, mBoardState->GetPlayerStates()[game_constants::REMOTE_PLAYER_INDEX].mPlayerHealth, mBoardState->GetPlayerStates()[game_constants::LOCAL_PLAYER_INDEX].mPlayerHealth);
-    
     mActionEngine = std::make_unique<GameActionEngine>(GameActionEngine::EngineOperationMode::ANIMATED, seed, mBoardState.get(), this, mRuleEngine.get());
+    
+    mBattleSerializer = std::make_unique<BattleSerializer>(seed, mBoardState->GetPlayerStates()[game_constants::REMOTE_PLAYER_INDEX].mPlayerDeckCards, mBoardState->GetPlayerStates()[game_constants::LOCAL_PLAYER_INDEX].mPlayerDeckCards, mBoardState->GetPlayerStates()[game_constants::REMOTE_PLAYER_INDEX].mPlayerHealth, mBoardState->GetPlayerStates()[game_constants::LOCAL_PLAYER_INDEX].mPlayerHealth, *mBoardState);
     mPlayerActionGenerationEngine = std::make_unique<PlayerActionGenerationEngine>(mRuleEngine.get(), mActionEngine.get(), PlayerActionGenerationEngine::ActionGenerationType::OPTIMISED);
     
     mActionEngine->AddGameAction(BATTLE_INITIAL_SETUP_AND_ANIMATION_GAME_ACTION_NAME, {{ BattleInitialSetupAndAnimationGameAction::CURRENT_BATTLE_SUBSCENE_PARAM, std::to_string(static_cast<int>(DataRepository::GetInstance().GetCurrentBattleSubSceneType())) }});
@@ -373,6 +373,7 @@ void BattleSceneLogicManager::InitBattleScene(std::shared_ptr<scene::Scene> scen
     }
     
     mBattleSerializer->FlushStateToFile();
+    mBattleSerializer->FlushReplayToFile();
     
     // Stat Containers
     // Health
@@ -684,6 +685,7 @@ void BattleSceneLogicManager::VDestroyScene(std::shared_ptr<scene::Scene> scene)
         {
             DataRepository::GetInstance().SetNextBattleControlType(BattleControlType::REPLAY);
             mBattleSerializer->FlushStateToFile();
+            mBattleSerializer->FlushReplayToFile();
         }
         
         mGuiManager = nullptr;
@@ -741,6 +743,12 @@ void BattleSceneLogicManager::HandleTouchInput(const float dtMillis)
     auto& localPlayerCards = mPlayerHeldCardSceneObjectWrappers[game_constants::LOCAL_PLAYER_INDEX];
     const auto localPlayerCardCount = static_cast<int>(localPlayerCards.size());
     
+    // Only the top-most held card (as last rendered) under the cursor counts as hovered
+    auto hoveredCardSceneObject = battleScene->FindTopMostSceneObjectAtPoint(worldTouchPos, [&](const scene::SceneObject& sceneObject)
+    {
+        return std::find_if(localPlayerCards.begin(), localPlayerCards.end(), [&](const std::shared_ptr<CardSoWrapper>& cardSoWrapper){ return cardSoWrapper->mSceneObject.get() == &sceneObject; }) != localPlayerCards.cend();
+    });
+    
     std::vector<int> candidateHighlightIndices;
     mShouldShowCardLocationIndicator = false;
     bool freeMovingCardThisFrame = false;
@@ -755,10 +763,7 @@ void BattleSceneLogicManager::HandleTouchInput(const float dtMillis)
         
         bool otherHighlightedCardExists = std::find_if(localPlayerCards.begin(), localPlayerCards.end(), [&](const std::shared_ptr<CardSoWrapper>& cardSoWrapper){ return cardSoWrapper.get() != currentCardSoWrapper.get() && cardSoWrapper->mState == CardSoState::HIGHLIGHTED; }) != localPlayerCards.cend();
         
-        auto cardBaseSceneObject = currentCardSoWrapper->mSceneObject;
-        auto sceneObjectRect = scene_object_utils::GetSceneObjectBoundingRect(*cardBaseSceneObject);
-        
-        bool cursorInSceneObject = math::IsPointInsideRectangle(sceneObjectRect.bottomLeft, sceneObjectRect.topRight, worldTouchPos);
+        bool cursorInSceneObject = currentCardSoWrapper->mSceneObject == hoveredCardSceneObject;
         
         // Check for card tooltip creation
         if (cursorInSceneObject && currentCardSoWrapper->mState == CardSoState::HIGHLIGHTED)
@@ -1168,13 +1173,16 @@ void BattleSceneLogicManager::UpdateMiscSceneObjects(const float dtMillis)
     bool freeMovingCardExists = std::find_if(localPlayerCards.begin(), localPlayerCards.end(), [&](const std::shared_ptr<CardSoWrapper>& cardSoWrapper){ return cardSoWrapper->mState == CardSoState::FREE_MOVING; }) != localPlayerCards.cend();
     if (!freeMovingCardExists)
     {
+        const auto& remotePlayerBoardCards = mPlayerBoardCardSceneObjectWrappers[game_constants::REMOTE_PLAYER_INDEX];
         auto worldTouchPos = inputStateManager.VGetPointingPosInWorldSpace(battleScene->GetCamera().GetViewMatrix(), battleScene->GetCamera().GetProjMatrix());
-        for (auto& cardSoWrapper: mPlayerBoardCardSceneObjectWrappers[game_constants::REMOTE_PLAYER_INDEX])
+        auto hoveredCardSceneObject = battleScene->FindTopMostSceneObjectAtPoint(worldTouchPos, [&](const scene::SceneObject& sceneObject)
         {
-            auto cardBaseSceneObject = cardSoWrapper->mSceneObject;
-            auto sceneObjectRect = scene_object_utils::GetSceneObjectBoundingRect(*cardBaseSceneObject);
-            
-            bool cursorInSceneObject = math::IsPointInsideRectangle(sceneObjectRect.bottomLeft, sceneObjectRect.topRight, worldTouchPos);
+            return std::find_if(remotePlayerBoardCards.begin(), remotePlayerBoardCards.end(), [&](const std::shared_ptr<CardSoWrapper>& cardSoWrapper){ return cardSoWrapper->mSceneObject.get() == &sceneObject; }) != remotePlayerBoardCards.cend();
+        });
+        
+        for (auto& cardSoWrapper: remotePlayerBoardCards)
+        {
+            bool cursorInSceneObject = cardSoWrapper->mSceneObject == hoveredCardSceneObject;
             
             if (cursorInSceneObject && inputStateManager.VButtonTapped(input::Button::MAIN_BUTTON))
             {
@@ -1421,6 +1429,7 @@ void BattleSceneLogicManager::OnApplicationMovedToBackground(const events::Appli
     {
         DataRepository::GetInstance().SetNextBattleControlType(mCurrentBattleControlType);
         mBattleSerializer->FlushStateToFile();
+        mBattleSerializer->FlushReplayToFile();
     }
 }
 
@@ -25,14 +25,13 @@
 
 class AnimatedButton;
 class AnimatedStatContainer;
+class BattleSerializer;
 class BoardState;
 class GameActionEngine;
 class GameRuleEngine;
 class GuiObjectManager;
 class PlayerActionGenerationEngine;
 
-namespace serial { class BaseDataFileSerializer; }
-
 ///------------------------------------------------------------------------------------------------
 
 struct CardSoWrapper;
@@ -119,7 +118,7 @@ private:
     std::unique_ptr<BoardState> mBoardState;
     std::unique_ptr<GameActionEngine> mActionEngine;
     std::unique_ptr<GameRuleEngine> mRuleEngine;
-    std::unique_ptr<serial::BaseDataFileSerializer> mBattleSerializer;
+    std::unique_ptr<BattleSerializer> mBattleSerializer;
     std::unique_ptr<PlayerActionGenerationEngine> mPlayerActionGenerationEngine;
     std::unique_ptr<SwipeableContainer<CardHistoryEntry>> mCardHistoryContainer;
     std::shared_ptr<GuiObjectManager> mGuiManager;
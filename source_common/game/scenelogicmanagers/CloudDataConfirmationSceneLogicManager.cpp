@@ -8,6 +8,7 @@
 #include <engine/CoreSystemsEngine.h>
 #include <engine/utils/PlatformMacros.h>
 #include <engine/rendering/AnimationManager.h>
+#include <engine/utils/BaseDataFileSerializer.h>
 #include <engine/utils/Logging.h>
 #include <engine/utils/PlatformMacros.h>
 #include <engine/scene/SceneManager.h>
@@ -19,6 +20,7 @@
 #include <game/events/EventSystem.h>
 #include <game/DataRepository.h>
 #include <game/scenelogicmanagers/CloudDataConfirmationSceneLogicManager.h>
+#include <game/utils/BattleReplay.h>
 #include <SDL_events.h>
 #if defined(MACOS) || defined(MOBILE_FLOW)
 #include <platform_utilities/AppleUtils.h>
@@ -193,6 +195,9 @@ std::shared_ptr<GuiObjectManager> CloudDataConfirmationSceneLogicManager::VGetGu
 void CloudDataConfirmationSceneLogicManager::OnUseCloudDataButtonPressed()
 {
 #if defined(MACOS) || defined(MOBILE_FLOW)
+    // An in-flight local save must not land on top of the cloud data copied below
+    serial::BaseDataFileSerializer::WaitForPendingWrites();
+    
     auto checkAndReplacePersistentDataFile = [](const std::string& dataFileNameWithoutExtension)
     {
         std::string dataFileExtension = ".json";
@@ -220,6 +225,17 @@ void CloudDataConfirmationSceneLogicManager::OnUseCloudDataButtonPressed()
     checkAndReplacePersistentDataFile("story");
     checkAndReplacePersistentDataFile("last_battle");
     
+    // The battle replay is binary and goes along with the last_battle data file
+    auto cloudReplayFilePath = apple_utils::GetPersistentDataDirectoryPath() + "cloud_" + BattleReplay::REPLAY_FILE_NAME;
+    std::ifstream cloudReplayFile(cloudReplayFilePath, std::ios::binary);
+    if (cloudReplayFile.is_open())
+    {
+        std::ofstream replayFile(apple_utils::GetPersistentDataDirectoryPath() + BattleReplay::REPLAY_FILE_NAME, std::ios::binary);
+        replayFile << cloudReplayFile.rdbuf();
+    }
+    cloudReplayFile.close();
+    std::remove(cloudReplayFilePath.c_str());
+    
     DataRepository::GetInstance().ReloadProgressionDataFromFile();
     CoreSystemsEngine::GetInstance().GetSoundManager().SetAudioEnabled(DataRepository::GetInstance().IsAudioEnabled());
     DataRepository::GetInstance().FlushStateToFile();
@@ -891,7 +891,7 @@ void EventSceneLogicManager::SelectRandomStoryEvent(const bool debugDeterministi
     
     for (auto i = 0; i < static_cast<int>(mRegisteredStoryEvents.size()); ++i)
     {
-        logging::Log(logging::LogType::INFO, "Event %d %s applicable=%s", i, mRegisteredStoryEvents[i].mEventName.GetString().c_str(), mRegisteredStoryEvents[i].mApplicabilityFunction() ? "true" : "false");
+        LOG(logging::LogType::INFO, "Event %d %s applicable=%s", i, mRegisteredStoryEvents[i].mEventName.GetString().c_str(), mRegisteredStoryEvents[i].mApplicabilityFunction() ? "true" : "false");
     }
     
     auto eventIndexSelectionRandInt = math::ControlledRandomInt(0, static_cast<int>(mRegisteredStoryEvents.size()) - 1);
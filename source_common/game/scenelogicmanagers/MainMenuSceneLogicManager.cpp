@@ -24,6 +24,7 @@
 #include <game/IAPProductIds.h>
 #include <game/ProductRepository.h>
 #include <game/TutorialManager.h>
+#include <game/utils/BattleReplay.h>
 #include <game/utils/GiftingUtils.h>
 #include <SDL_events.h>
 #if defined(MACOS) || defined(MOBILE_FLOW)
@@ -247,7 +248,7 @@ static const std::unordered_map<StoryMapSceneType, strutils::StringId> STORY_MAP
 static bool sEmptyProgression = false;
 void CheckForEmptyProgression()
 {
-    serial::BaseDataFileDeserializer persistentDataFileChecker("persistent", serial::DataFileType::PERSISTENCE_FILE_TYPE, serial::WarnOnFileNotFoundBehavior::DO_NOT_WARN, serial::CheckSumValidationBehavior::VALIDATE_CHECKSUM);
+    serial::BaseDataFileDeserializer persistentDataFileChecker("persistent", serial::DataFileType::PERSISTENCE_FILE_TYPE, serial::WarnOnFileNotFoundBehavior::DO_NOT_WARN, serial::CheckSumValidationBehavior::VALIDATE_CHECKSUM, serial::DEFAULT_PERSISTENCE_DATA_FILE_FORMAT);
     sEmptyProgression = persistentDataFileChecker.GetState().empty();
 }
 
@@ -336,6 +337,15 @@ void OnCloudQueryCompleted(cloudkit_utils::QueryResultData resultData)
     writeDataStringToTempFile("cloud_story", resultData.mStoryProgressRawString);
     writeDataStringToTempFile("cloud_last_battle", resultData.mLastBattleRawString);
     
+    // The battle replay is binary and goes along with the last_battle data file
+    auto cloudReplayFilePath = apple_utils::GetPersistentDataDirectoryPath() + "cloud_" + BattleReplay::REPLAY_FILE_NAME;
+    std::remove(cloudReplayFilePath.c_str());
+    if (!resultData.mLastBattleReplayBytes.empty())
+    {
+        std::ofstream cloudReplayFile(cloudReplayFilePath, std::ios::binary);
+        cloudReplayFile.write(resultData.mLastBattleReplayBytes.data(), resultData.mLastBattleReplayBytes.size());
+    }
+    
     checkForDeviceIdInconsistency("persistent", serial::BaseDataFileDeserializer("cloud_persistent", serial::DataFileType::PERSISTENCE_FILE_TYPE, serial::WarnOnFileNotFoundBehavior::DO_NOT_WARN, serial::CheckSumValidationBehavior::VALIDATE_CHECKSUM));
     checkForDeviceIdInconsistency("story", serial::BaseDataFileDeserializer("cloud_story", serial::DataFileType::PERSISTENCE_FILE_TYPE, serial::WarnOnFileNotFoundBehavior::DO_NOT_WARN, serial::CheckSumValidationBehavior::VALIDATE_CHECKSUM));
     checkForDeviceIdInconsistency("last_battle", serial::BaseDataFileDeserializer("cloud_last_battle", serial::DataFileType::PERSISTENCE_FILE_TYPE, serial::WarnOnFileNotFoundBehavior::DO_NOT_WARN, serial::CheckSumValidationBehavior::VALIDATE_CHECKSUM));
@@ -11,7 +11,6 @@
 #include <engine/rendering/ParticleManager.h>
 #include <engine/resloading/ResourceLoadingService.h>
 #include <engine/resloading/DataFileResource.h>
-#include <engine/scene/SceneObjectUtils.h>
 #include <engine/utils/Logging.h>
 #include <engine/utils/PlatformMacros.h>
 #include <engine/utils/BaseDataFileDeserializer.h>
@@ -308,6 +307,21 @@ void ShopSceneLogicManager::VUpdate(const float dtMillis, std::shared_ptr<scene:
             
             auto& inputStateManager = CoreSystemsEngine::GetInstance().GetInputStateManager();
             auto worldTouchPos = inputStateManager.VGetPointingPosInWorldSpace(mScene->GetCamera().GetViewMatrix(), mScene->GetCamera().GetProjMatrix());
+            auto hoveredProductSceneObject = mScene->FindTopMostSceneObjectAtPoint(worldTouchPos, [&](const scene::SceneObject& sceneObject)
+            {
+                for (const auto& shelfProducts: mProducts)
+                {
+                    for (const auto& product: shelfProducts)
+                    {
+                        if (product != nullptr && !product->mSceneObjects.empty() && product->mSceneObjects.front().get() == &sceneObject)
+                        {
+                            return true;
+                        }
+                    }
+                }
+                
+                return false;
+            });
             
             for (auto shelfIndex = 0U; shelfIndex < mProducts.size(); ++shelfIndex)
             {
@@ -325,9 +339,7 @@ void ShopSceneLogicManager::VUpdate(const float dtMillis, std::shared_ptr<scene:
                         continue;
                     }
                     
-                    auto sceneObjectRect = scene_object_utils::GetSceneObjectBoundingRect(*product->mSceneObjects.front());
-                    
-                    bool cursorInSceneObject = math::IsPointInsideRectangle(sceneObjectRect.bottomLeft, sceneObjectRect.topRight, worldTouchPos);
+                    bool cursorInSceneObject = product->mSceneObjects.front() == hoveredProductSceneObject;
                     if (cursorInSceneObject && inputStateManager.VButtonTapped(input::Button::MAIN_BUTTON) && mItemsFinishedFadingIn)
                     {
                         // Product highlighting
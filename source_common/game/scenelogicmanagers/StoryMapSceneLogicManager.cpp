@@ -12,6 +12,7 @@
 #include <engine/scene/SceneManager.h>
 #include <engine/scene/SceneObjectUtils.h>
 #include <engine/sound/SoundManager.h>
+#include <engine/utils/JobSystem.h>
 #include <engine/utils/Logging.h>
 #include <engine/utils/PlatformMacros.h>
 #include <game/AnimatedButton.h>
@@ -22,7 +23,6 @@
 #include <game/DataRepository.h>
 #include <game/scenelogicmanagers/StoryMapSceneLogicManager.h>
 #include <game/TutorialManager.h>
-#include <thread>
 
 ///------------------------------------------------------------------------------------------------
 
@@ -138,7 +138,7 @@ void StoryMapSceneLogicManager::VInitScene(std::shared_ptr<scene::Scene> scene)
     }
     
     const auto& currentMapCoord = DataRepository::GetInstance().GetCurrentStoryMapNodeCoord();
-    std::thread mapGenerationThread = std::thread([=]
+    CoreSystemsEngine::GetInstance().GetJobSystem().Submit([=]
     {
         auto storyNodeMapDimensions = game_constants::STORY_NODE_MAP_DIMENSIONS;
         if (DataRepository::GetInstance().GetCurrentStoryMapType() == StoryMapType::TUTORIAL_MAP)
@@ -149,7 +149,6 @@ void StoryMapSceneLogicManager::VInitScene(std::shared_ptr<scene::Scene> scene)
         mStoryMap = std::make_unique<StoryMap>(scene, storyNodeMapDimensions, MapCoord(currentMapCoord.x, currentMapCoord.y));
         mStoryMap->GenerateMapNodes();
     });
-    mapGenerationThread.detach();
     
     RegisterForEvents();
     
@@ -196,12 +195,12 @@ void StoryMapSceneLogicManager::VUpdate(const float dtMillis, std::shared_ptr<sc
     if (!mStoryMap->HasCreatedSceneObjects())
     {
         const auto& mapGenerationInfo = mStoryMap->GetMapGenerationInfo();
-        logging::Log(logging::LogType::INFO, "Finished Map Generation after %d attempts", mapGenerationInfo.mMapGenerationAttempts);
-        logging::Log(logging::LogType::INFO, "Close To Start Node Errors %d", mapGenerationInfo.mCloseToStartingNodeErrors);
-        logging::Log(logging::LogType::INFO, "Close To Boss Node Errors %d", mapGenerationInfo.mCloseToBossNodeErrors);
-        logging::Log(logging::LogType::INFO, "Close To North Edge Errors %d", mapGenerationInfo.mCloseToNorthEdgeErrors);
-        logging::Log(logging::LogType::INFO, "Close To South Edge Errors %d", mapGenerationInfo.mCloseToSouthEdgeErrors);
-        logging::Log(logging::LogType::INFO, "Close To Other Nodes Errors %d", mapGenerationInfo.mCloseToOtherNodesErrors);
+        LOG(logging::LogType::INFO, "Finished Map Generation after %d attempts", mapGenerationInfo.mMapGenerationAttempts);
+        LOG(logging::LogType::INFO, "Close To Start Node Errors %d", mapGenerationInfo.mCloseToStartingNodeErrors);
+        LOG(logging::LogType::INFO, "Close To Boss Node Errors %d", mapGenerationInfo.mCloseToBossNodeErrors);
+        LOG(logging::LogType::INFO, "Close To North Edge Errors %d", mapGenerationInfo.mCloseToNorthEdgeErrors);
+        LOG(logging::LogType::INFO, "Close To South Edge Errors %d", mapGenerationInfo.mCloseToSouthEdgeErrors);
+        LOG(logging::LogType::INFO, "Close To Other Nodes Errors %d", mapGenerationInfo.mCloseToOtherNodesErrors);
         mStoryMap->CreateMapSceneObjects();
         
         for (const auto& sceneObject: scene->GetSceneObjects())
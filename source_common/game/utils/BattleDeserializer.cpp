@@ -5,15 +5,17 @@
 ///  Created by Alex Koukoulas on 27/10/2023                                                       
 ///------------------------------------------------------------------------------------------------
 
+#include <engine/utils/Logging.h>
 #include <fstream>
 #include <game/utils/BattleDeserializer.h>
+#include <game/utils/BattleReplay.h>
 #include <game/gameactions/GameActionEngine.h>
 #include <vector>
 
 ///------------------------------------------------------------------------------------------------
 
 BattleDeserializer::BattleDeserializer()
-    : serial::BaseDataFileDeserializer("last_battle", serial::DataFileType::PERSISTENCE_FILE_TYPE, serial::WarnOnFileNotFoundBehavior::WARN, serial::CheckSumValidationBehavior::VALIDATE_CHECKSUM)
+    : serial::BaseDataFileDeserializer("last_battle", serial::DataFileType::PERSISTENCE_FILE_TYPE, serial::WarnOnFileNotFoundBehavior::WARN, serial::CheckSumValidationBehavior::VALIDATE_CHECKSUM, serial::DEFAULT_PERSISTENCE_DATA_FILE_FORMAT)
 {
     mGameFileSeed = mState["seed"].get<int>();
     mTopPlayerDeck = mState["top_deck"].get<std::vector<int>>();
@@ -61,18 +63,55 @@ const std::vector<int>& BattleDeserializer::GetBotPlayerDeck() const
 
 void BattleDeserializer::ReplayActions(GameActionEngine* gameActionEngine)
 {
-    for (const auto& actionEntry: mState["actions"])
+    // Last battles saved before the binary replay kept their actions in the data file itself
+    if (mState.count("actions"))
     {
-        std::unordered_map<std::string, std::string> extraActionParams;
-        if (actionEntry.count("extraActionParams") != 0)
+        for (const auto& actionEntry: mState["actions"])
         {
-            auto extraActionParamsJson = actionEntry["extraActionParams"];
-            for(auto it = extraActionParamsJson.begin(); it != extraActionParamsJson.end(); ++it)
+            std::unordered_map<std::string, std::string> extraActionParams;
+            if (actionEntry.count("extraActionParams") != 0)
             {
-                extraActionParams[it.key()] = it.value();
+                auto extraActionParamsJson = actionEntry["extraActionParams"];
+                for(auto it = extraActionParamsJson.begin(); it != extraActionParamsJson.end(); ++it)
+                {
+                    extraActionParams[it.key()] = it.value();
+                }
             }
+            gameActionEngine->AddGameAction(strutils::StringId(actionEntry["name"]), extraActionParams);
         }
-        gameActionEngine->AddGameAction(strutils::StringId(actionEntry["name"]), extraActionParams);
+        return;
     }
+    
+    BattleReplay replay;
+    if (!BattleReplay::LoadFromFile(replay) || !IsReplayOfThisBattle(replay))
+    {
+        LOG(logging::LogType::WARNING, "No replay found for the last battle, starting it over");
+        return;
+    }
+    
+    // Fast forwarding between the replay's keyframes verifies that it still plays out the same
+    // way on this build (e.g. after card changes) before it is replayed on screen
+    if (!replay.VerifyDeterminism())
+    {
+        LOG(logging::LogType::WARNING, "Last battle replay no longer matches its keyframes");
+    }
+    
+    for (const auto& action: replay.GetActions())
+    {
+        gameActionEngine->AddGameAction(action.mActionName, action.mExtraActionParams);
+    }
+}
+
+///------------------------------------------------------------------------------------------------
+
+bool BattleDeserializer::IsReplayOfThisBattle(const BattleReplay& replay) const
+{
+    // The data file and the replay are written (and cloud synced) separately, so they could be
+    // from different battles
+    return replay.GetGameSeed() == mGameFileSeed &&
+           replay.GetTopPlayerDeck() == mTopPlayerDeck &&
+           replay.GetBotPlayerDeck() == mBotPlayerDeck &&
+           replay.GetTopPlayerStartingHealth() == mTopPlayerStartingHealth &&
+           replay.GetBotPlayerStartingHealth() == mBotPlayerStartingHealth;
 }
 
@@ -15,6 +15,7 @@
 
 ///------------------------------------------------------------------------------------------------
 
+class BattleReplay;
 class GameActionEngine;
 class BattleDeserializer final: public serial::BaseDataFileDeserializer
 {
@@ -28,8 +29,12 @@ public:
     const std::vector<int>& GetTopPlayerDeck() const;
     const std::vector<int>& GetBotPlayerDeck() const;
     
+    // Pushes the actions of the last battle's replay, if it is one of this battle
     void ReplayActions(GameActionEngine* gameActionEngine);
     
+private:
+    bool IsReplayOfThisBattle(const BattleReplay& replay) const;
+    
 private:
     int mGameFileSeed;
     std::vector<int> mTopPlayerDeck;
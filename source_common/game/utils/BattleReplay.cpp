@@ -0,0 +1,669 @@
+///------------------------------------------------------------------------------------------------
+///  BattleReplay.cpp
+///  Predators
+///
+///  Created by Alex Koukoulas on 10/04/2024
+///------------------------------------------------------------------------------------------------
+
+#include <engine/utils/BaseDataFileSerializer.h>
+#include <engine/utils/Logging.h>
+#include <engine/utils/MathUtils.h>
+#include <engine/utils/PlatformMacros.h>
+#include <game/GameRuleEngine.h>
+#include <game/events/EventSystem.h>
+#include <game/gameactions/GameActionEngine.h>
+#include <game/utils/BattleReplay.h>
+#if defined(MACOS) || defined(MOBILE_FLOW)
+#include <platform_utilities/AppleUtils.h>
+#elif defined(WINDOWS)
+#include <platform_utilities/WindowsUtils.h>
+#endif
+#include <algorithm>
+#include <cassert>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <map>
+
+///------------------------------------------------------------------------------------------------
+
+const std::string BattleReplay::REPLAY_FILE_NAME = "last_battle_replay.bin";
+
+///------------------------------------------------------------------------------------------------
+
+static const strutils::StringId IDLE_GAME_ACTION_NAME = strutils::StringId("IdleGameAction");
+static const strutils::StringId GAME_OVER_GAME_ACTION_NAME = strutils::StringId("GameOverGameAction");
+
+static const uint8_t REPLAY_MAGIC[4] = { 'P', 'R', 'P', 'L' };
+static const uint32_t REPLAY_FORMAT_VERSION = 1;
+
+static const uint8_t PARAM_TYPE_INT = 0;
+static const uint8_t PARAM_TYPE_STRING = 1;
+
+///------------------------------------------------------------------------------------------------
+
+static void WriteVarUInt(std::vector<uint8_t>& bytes, uint64_t value)
+{
+    while (value >= 0x80)
+    {
+        bytes.push_back(static_cast<uint8_t>(value | 0x80));
+        value >>= 7;
+    }
+    bytes.push_back(static_cast<uint8_t>(value));
+}
+
+///------------------------------------------------------------------------------------------------
+
+static void WriteVarInt(std::vector<uint8_t>& bytes, const int value)
+{
+    // Zigzag encoding so that small negative values stay small
+    auto wideValue = static_cast<int64_t>(value);
+    WriteVarUInt(bytes, (static_cast<uint64_t>(wideValue) << 1) ^ static_cast<uint64_t>(wideValue >> 63));
+}
+
+///------------------------------------------------------------------------------------------------
+
+static void WriteString(std::vector<uint8_t>& bytes, const std::string& value)
+{
+    WriteVarUInt(bytes, value.size());
+    bytes.insert(bytes.end(), value.begin(), value.end());
+}
+
+///------------------------------------------------------------------------------------------------
+
+static void WriteIntVector(std::vector<uint8_t>& bytes, const std::vector<int>& values)
+{
+    WriteVarUInt(bytes, values.size());
+    for (auto value: values)
+    {
+        WriteVarInt(bytes, value);
+    }
+}
+
+///------------------------------------------------------------------------------------------------
+
+static void WriteIntSet(std::vector<uint8_t>& bytes, const std::unordered_set<int>& values)
+{
+    // Sorted so that equal sets always produce identical bytes
+    std::vector<int> sortedValues(values.begin(), values.end());
+    std::sort(sortedValues.begin(), sortedValues.end());
+    WriteIntVector(bytes, sortedValues);
+}
+
+///------------------------------------------------------------------------------------------------
+
+static void WriteCardStatOverrides(std::vector<uint8_t>& bytes, const CardStatOverrides& statOverrides)
+{
+    std::map<int, int> sortedOverrides;
+    for (const auto& statOverride: statOverrides)
+    {
+        sortedOverrides[static_cast<int>(statOverride.first)] = statOverride.second;
+    }
+    
+    WriteVarUInt(bytes, sortedOverrides.size());
+    for (const auto& statOverride: sortedOverrides)
+    {
+        WriteVarUInt(bytes, static_cast<uint64_t>(statOverride.first));
+        WriteVarInt(bytes, statOverride.second);
+    }
+}
+
+///------------------------------------------------------------------------------------------------
+
+static void WriteCardStatOverridesVector(std::vector<uint8_t>& bytes, const std::vector<CardStatOverrides>& statOverridesVector)
+{
+    WriteVarUInt(bytes, statOverridesVector.size());
+    for (const auto& statOverrides: statOverridesVector)
+    {
+        WriteCardStatOverrides(bytes, statOverrides);
+    }
+}
+
+///------------------------------------------------------------------------------------------------
+
+static void WriteBoardState(std::vector<uint8_t>& bytes, const BoardState& boardState)
+{
+    WriteVarInt(bytes, boardState.GetActivePlayerIndex());
+    WriteVarInt(bytes, boardState.GetTurnCounter());
+    WriteVarUInt(bytes, boardState.GetPlayerCount());
+    
+    for (const auto& playerState: boardState.GetPlayerStates())
+    {
+        WriteIntVector(bytes, playerState.mPlayerDeckCards);
+        WriteIntVector(bytes, playerState.mPlayerHeldCards);
+        WriteIntVector(bytes, playerState.mPlayerBoardCards);
+        WriteIntVector(bytes, playerState.mPlayerInitialDeckCards);
+        WriteIntVector(bytes, playerState.mGoldenCardIds);
+        WriteIntSet(bytes, playerState.mHeldCardIndicesToDestroy);
+        WriteIntSet(bytes, playerState.mBoardCardIndicesToDestroy);
+        WriteCardStatOverridesVector(bytes, playerState.mPlayerBoardCardStatOverrides);
+        WriteCardStatOverridesVector(bytes, playerState.mPlayerHeldCardStatOverrides);
+        WriteVarUInt(bytes, playerState.mBoardModifiers.mBoardModifierMask);
+        WriteCardStatOverrides(bytes, playerState.mBoardModifiers.mGlobalCardStatModifiers);
+        WriteVarInt(bytes, playerState.mPlayerHealth);
+        WriteVarInt(bytes, playerState.mPlayerCurrentArmor);
+        WriteVarInt(bytes, playerState.mPlayerArmorRecharge);
+        WriteVarInt(bytes, playerState.mPlayerPoisonStack);
+        WriteVarInt(bytes, playerState.mPlayerTotalWeightAmmo);
+        WriteVarInt(bytes, playerState.mPlayerCurrentWeightAmmo);
+        WriteVarInt(bytes, playerState.mPlayerWeightAmmoLimit);
+        WriteVarInt(bytes, playerState.mPlayedCardComboThisTurn);
+        WriteVarInt(bytes, playerState.mCardsDrawnThisTurn);
+        
+        uint8_t flags = 0;
+        flags |= playerState.mZeroCostTime ? 0x1 : 0x0;
+        flags |= playerState.mHasHeroCard ? 0x2 : 0x0;
+        flags |= playerState.mHasResurrectionActive ? 0x4 : 0x0;
+        bytes.push_back(flags);
+    }
+}
+
+///------------------------------------------------------------------------------------------------
+
+class ReplayByteReader final
+{
+public:
+    ReplayByteReader(const std::vector<uint8_t>& bytes, const size_t startCursor)
+        : mBytes(bytes)
+        , mCursor(startCursor)
+        , mFailed(false)
+    {
+    }
+    
+    bool Failed() const { return mFailed; }
+    bool AtEnd() const { return mCursor == mBytes.size(); }
+    
+    uint8_t ReadByte()
+    {
+        if (mCursor >= mBytes.size())
+        {
+            mFailed = true;
+            return 0;
+        }
+        return mBytes[mCursor++];
+    }
+    
+    uint64_t ReadVarUInt()
+    {
+        uint64_t result = 0;
+        for (int shift = 0; shift < 64 && !mFailed; shift += 7)
+        {
+            auto byte = ReadByte();
+            result |= static_cast<uint64_t>(byte & 0x7F) << shift;
+            if ((byte & 0x80) == 0)
+            {
+                return result;
+            }
+        }
+        
+        mFailed = true;
+        return 0;
+    }
+    
+    int ReadVarInt()
+    {
+        auto zigzagValue = ReadVarUInt();
+        return static_cast<int>(static_cast<int64_t>(zigzagValue >> 1) ^ -static_cast<int64_t>(zigzagValue & 1));
+    }
+    
+    size_t ReadCount()
+    {
+        // Every encoded element occupies at least one byte, so anything larger is corrupt
+        auto count = ReadVarUInt();
+        if (count > mBytes.size() - mCursor)
+        {
+            mFailed = true;
+            return 0;
+        }
+        return static_cast<size_t>(count);
+    }
+    
+    std::string ReadString()
+    {
+        auto length = ReadCount();
+        if (mFailed) return std::string();
+        
+        std::string result(reinterpret_cast<const char*>(mBytes.data()) + mCursor, length);
+        mCursor += length;
+        return result;
+    }
+    
+    std::vector<int> ReadIntVector()
+    {
+        std::vector<int> result(ReadCount());
+        for (auto& value: result)
+        {
+            value = ReadVarInt();
+        }
+        return result;
+    }
+    
+    std::unordered_set<int> ReadIntSet()
+    {
+        auto values = ReadIntVector();
+        return std::unordered_set<int>(values.begin(), values.end());
+    }
+    
+    CardStatOverrides ReadCardStatOverrides()
+    {
+        CardStatOverrides result;
+        auto count = ReadCount();
+        for (size_t i = 0; i < count && !mFailed; ++i)
+        {
+            auto statType = static_cast<CardStatType>(ReadVarUInt());
+            result[statType] = ReadVarInt();
+        }
+        return result;
+    }
+    
+    std::vector<CardStatOverrides> ReadCardStatOverridesVector()
+    {
+        std::vector<CardStatOverrides> result(ReadCount());
+        for (auto& statOverrides: result)
+        {
+            statOverrides = ReadCardStatOverrides();
+        }
+        return result;
+    }
+    
+    void ReadBoardState(BoardState& boardState)
+    {
+        boardState.GetActivePlayerIndex() = ReadVarInt();
+        boardState.GetTurnCounter() = ReadVarInt();
+        boardState.GetPlayerStates().resize(ReadCount());
+        
+        for (auto& playerState: boardState.GetPlayerStates())
+        {
+            playerState.mPlayerDeckCards = ReadIntVector();
+            playerState.mPlayerHeldCards = ReadIntVector();
+            playerState.mPlayerBoardCards = ReadIntVector();
+            playerState.mPlayerInitialDeckCards = ReadIntVector();
+            playerState.mGoldenCardIds = ReadIntVector();
+            playerState.mHeldCardIndicesToDestroy = ReadIntSet();
+            playerState.mBoardCardIndicesToDestroy = ReadIntSet();
+            playerState.mPlayerBoardCardStatOverrides = ReadCardStatOverridesVector();
+            playerState.mPlayerHeldCardStatOverrides = ReadCardStatOverridesVector();
+            playerState.mBoardModifiers.mBoardModifierMask = static_cast<effects::EffectBoardModifierMask>(ReadVarUInt());
+            playerState.mBoardModifiers.mGlobalCardStatModifiers = ReadCardStatOverrides();
+            playerState.mPlayerHealth = ReadVarInt();
+            playerState.mPlayerCurrentArmor = ReadVarInt();
+            playerState.mPlayerArmorRecharge = ReadVarInt();
+            playerState.mPlayerPoisonStack = ReadVarInt();
+            playerState.mPlayerTotalWeightAmmo = ReadVarInt();
+            playerState.mPlayerCurrentWeightAmmo = ReadVarInt();
+            playerState.mPlayerWeightAmmoLimit = ReadVarInt();
+            playerState.mPlayedCardComboThisTurn = ReadVarInt();
+            playerState.mCardsDrawnThisTurn = ReadVarInt();
+            
+            auto flags = ReadByte();
+            playerState.mZeroCostTime = (flags & 0x1) != 0;
+            playerState.mHasHeroCard = (flags & 0x2) != 0;
+            playerState.mHasResurrectionActive = (flags & 0x4) != 0;
+            
+            if (mFailed) return;
+        }
+    }
+
+private:
+    const std::vector<uint8_t>& mBytes;
+    size_t mCursor;
+    bool mFailed;
+};
+
+///------------------------------------------------------------------------------------------------
+
+static bool IsCanonicalIntString(const std::string& value)
+{
+    if (value.empty() || value.size() > 10) return false;
+    
+    auto digitsStartIndex = value[0] == '-' ? 1U : 0U;
+    if (!strutils::StringIsInt(value.substr(digitsStartIndex))) return false;
+    
+    // Reject leading zeros (and "-0") so that decoding reproduces the exact same string
+    if (value.size() - digitsStartIndex > 1 && value[digitsStartIndex] == '0') return false;
+    if (digitsStartIndex == 1 && value == "-0") return false;
+    
+    auto wideValue = std::stoll(value);
+    return wideValue >= std::numeric_limits<int>::min() && wideValue <= std::numeric_limits<int>::max();
+}
+
+///------------------------------------------------------------------------------------------------
+
+static std::map<std::string, std::string> GetSortedExtraActionParams(const BattleReplay::ExtraActionParams& extraActionParams)
+{
+    // Sorted so that serializing the same replay twice always produces identical bytes
+    return std::map<std::string, std::string>(extraActionParams.begin(), extraActionParams.end());
+}
+
+///------------------------------------------------------------------------------------------------
+
+static std::string GetReplayFilePath()
+{
+#if defined(MACOS) || defined(MOBILE_FLOW)
+    return apple_utils::GetPersistentDataDirectoryPath() + BattleReplay::REPLAY_FILE_NAME;
+#elif defined(WINDOWS)
+    return windows_utils::GetPersistentDataDirectoryPath() + BattleReplay::REPLAY_FILE_NAME;
+#endif
+}
+
+///------------------------------------------------------------------------------------------------
+
+BattleReplay::BattleReplay(const int gameSeed /* = 0 */, const std::vector<int>& topPlayerDeck /* = {} */, const std::vector<int>& botPlayerDeck /* = {} */, const int topPlayerStartingHealth /* = 0 */, const int botPlayerStartingHealth /* = 0 */)
+    : mGameSeed(gameSeed)
+    , mTopPlayerDeck(topPlayerDeck)
+    , mBotPlayerDeck(botPlayerDeck)
+    , mTopPlayerStartingHealth(topPlayerStartingHealth)
+    , mBotPlayerStartingHealth(botPlayerStartingHealth)
+{
+}
+
+///------------------------------------------------------------------------------------------------
+
+bool BattleReplay::Deserialize(const std::vector<uint8_t>& bytes, BattleReplay& outReplay)
+{
+    if (bytes.size() < sizeof(REPLAY_MAGIC) || !std::equal(std::begin(REPLAY_MAGIC), std::end(REPLAY_MAGIC), bytes.begin()))
+    {
+        return false;
+    }
+    
+    ReplayByteReader reader(bytes, sizeof(REPLAY_MAGIC));
+    
+    if (reader.ReadVarUInt() != REPLAY_FORMAT_VERSION)
+    {
+        return false;
+    }
+    
+    BattleReplay replay;
+    replay.mGameSeed = reader.ReadVarInt();
+    replay.mTopPlayerDeck = reader.ReadIntVector();
+    replay.mBotPlayerDeck = reader.ReadIntVector();
+    replay.mTopPlayerStartingHealth = reader.ReadVarInt();
+    replay.mBotPlayerStartingHealth = reader.ReadVarInt();
+    
+    std::vector<strutils::StringId> actionNameTable(reader.ReadCount());
+    for (auto& actionName: actionNameTable)
+    {
+        actionName = strutils::StringId(reader.ReadString());
+    }
+    
+    std::vector<std::string> paramNameTable(reader.ReadCount());
+    for (auto& paramName: paramNameTable)
+    {
+        paramName = reader.ReadString();
+    }
+    
+    replay.mActions.resize(reader.ReadCount());
+    for (auto& action: replay.mActions)
+    {
+        auto actionNameIndex = reader.ReadVarUInt();
+        if (reader.Failed() || actionNameIndex >= actionNameTable.size()) return false;
+        action.mActionName = actionNameTable[actionNameIndex];
+        
+        auto paramCount = reader.ReadCount();
+        for (size_t i = 0; i < paramCount; ++i)
+        {
+            auto paramNameIndex = reader.ReadVarUInt();
+            if (reader.Failed() || paramNameIndex >= paramNameTable.size()) return false;
+            
+            auto paramType = reader.ReadByte();
+            if (paramType == PARAM_TYPE_INT)
+            {
+                action.mExtraActionParams[paramNameTable[paramNameIndex]] = std::to_string(reader.ReadVarInt());
+            }
+            else if (paramType == PARAM_TYPE_STRING)
+            {
+                action.mExtraActionParams[paramNameTable[paramNameIndex]] = reader.ReadString();
+            }
+            else
+            {
+                return false;
+            }
+        }
+    }
+    
+    replay.mKeyframes.resize(reader.ReadCount());
+    for (auto& keyframe: replay.mKeyframes)
+    {
+        keyframe.mActionIndex = static_cast<size_t>(reader.ReadVarUInt());
+        keyframe.mControlSeed = reader.ReadVarInt();
+        reader.ReadBoardState(keyframe.mBoardState);
+        
+        if (reader.Failed() || keyframe.mActionIndex > replay.mActions.size()) return false;
+    }
+    
+    if (reader.Failed() || !reader.AtEnd())
+    {
+        return false;
+    }
+    
+    outReplay = std::move(replay);
+    return true;
+}
+
+///------------------------------------------------------------------------------------------------
+
+bool BattleReplay::LoadFromFile(BattleReplay& outReplay)
+{
+    // A replay save may still be queued on the background writer
+    serial::BaseDataFileSerializer::WaitForPendingWrites();
+    
+    std::ifstream replayFile(GetReplayFilePath(), std::ios::binary);
+    if (!replayFile.is_open())
+    {
+        return false;
+    }
+    
+    std::vector<uint8_t> bytes((std::istreambuf_iterator<char>(replayFile)), std::istreambuf_iterator<char>());
+    return Deserialize(bytes, outReplay);
+}
+
+///------------------------------------------------------------------------------------------------
+
+std::vector<uint8_t> BattleReplay::SerializeBoardState(const BoardState& boardState)
+{
+    std::vector<uint8_t> bytes;
+    WriteBoardState(bytes, boardState);
+    return bytes;
+}
+
+///------------------------------------------------------------------------------------------------
+
+std::vector<uint8_t> BattleReplay::Serialize() const
+{
+    std::vector<uint8_t> bytes(std::begin(REPLAY_MAGIC), std::end(REPLAY_MAGIC));
+    WriteVarUInt(bytes, REPLAY_FORMAT_VERSION);
+    
+    WriteVarInt(bytes, mGameSeed);
+    WriteIntVector(bytes, mTopPlayerDeck);
+    WriteIntVector(bytes, mBotPlayerDeck);
+    WriteVarInt(bytes, mTopPlayerStartingHealth);
+    WriteVarInt(bytes, mBotPlayerStartingHealth);
+    
+    // Name tables so that each action and param name is stored once
+    std::vector<std::string> actionNameTable;
+    std::vector<std::string> paramNameTable;
+    std::unordered_map<std::string, size_t> actionNameIndices;
+    std::unordered_map<std::string, size_t> paramNameIndices;
+    
+    for (const auto& action: mActions)
+    {
+        if (actionNameIndices.emplace(action.mActionName.GetString(), actionNameTable.size()).second)
+        {
+            actionNameTable.push_back(action.mActionName.GetString());
+        }
+        
+        for (const auto& extraActionParam: GetSortedExtraActionParams(action.mExtraActionParams))
+        {
+            if (paramNameIndices.emplace(extraActionParam.first, paramNameTable.size()).second)
+            {
+                paramNameTable.push_back(extraActionParam.first);
+            }
+        }
+    }
+    
+    WriteVarUInt(bytes, actionNameTable.size());
+    for (const auto& actionName: actionNameTable)
+    {
+        WriteString(bytes, actionName);
+    }
+    
+    WriteVarUInt(bytes, paramNameTable.size());
+    for (const auto& paramName: paramNameTable)
+    {
+        WriteString(bytes, paramName);
+    }
+    
+    WriteVarUInt(bytes, mActions.size());
+    for (const auto& action: mActions)
+    {
+        WriteVarUInt(bytes, actionNameIndices.at(action.mActionName.GetString()));
+        WriteVarUInt(bytes, action.mExtraActionParams.size());
+        
+        for (const auto& extraActionParam: GetSortedExtraActionParams(action.mExtraActionParams))
+        {
+            WriteVarUInt(bytes, paramNameIndices.at(extraActionParam.first));
+            if (IsCanonicalIntString(extraActionParam.second))
+            {
+                bytes.push_back(PARAM_TYPE_INT);
+                WriteVarInt(bytes, std::stoi(extraActionParam.second));
+            }
+            else
+            {
+                bytes.push_back(PARAM_TYPE_STRING);
+                WriteString(bytes, extraActionParam.second);
+            }
+        }
+    }
+    
+    WriteVarUInt(bytes, mKeyframes.size());
+    for (const auto& keyframe: mKeyframes)
+    {
+        WriteVarUInt(bytes, keyframe.mActionIndex);
+        WriteVarInt(bytes, keyframe.mControlSeed);
+        WriteBoardState(bytes, keyframe.mBoardState);
+    }
+    
+    return bytes;
+}
+
+///------------------------------------------------------------------------------------------------
+
+void BattleReplay::SaveToFile() const
+{
+    auto filePath = GetReplayFilePath();
+#if defined(DESKTOP_FLOW)
+    std::filesystem::create_directory(std::filesystem::path(filePath).parent_path());
+#endif
+
+    // Only the (in memory) encoding happens here, the disk write is left to the background writer
+    auto bytes = Serialize();
+    serial::BaseDataFileSerializer::QueueFileWrite(filePath, std::string(bytes.begin(), bytes.end()));
+}
+
+///------------------------------------------------------------------------------------------------
+
+void BattleReplay::RecordAction(const strutils::StringId& actionName, const ExtraActionParams& extraActionParams)
+{
+    mActions.push_back({ actionName, extraActionParams });
+}
+
+///------------------------------------------------------------------------------------------------
+
+void BattleReplay::RecordKeyframe(const size_t actionIndex, const BoardState& boardState, const int controlSeed)
+{
+    assert(mKeyframes.empty() || mKeyframes.back().mActionIndex < actionIndex);
+    
+    Keyframe keyframe;
+    keyframe.mActionIndex = actionIndex;
+    keyframe.mControlSeed = controlSeed;
+    keyframe.mBoardState = boardState;
+    mKeyframes.push_back(std::move(keyframe));
+}
+
+///------------------------------------------------------------------------------------------------
+
+bool BattleReplay::FastForward(const size_t targetActionIndex, BoardState& outBoardState, int& outControlSeed) const
+{
+    const auto* keyframe = FindNearestKeyframe(targetActionIndex);
+    if (!keyframe)
+    {
+        return false;
+    }
+    
+    return FastForwardFromKeyframe(*keyframe, targetActionIndex, outBoardState, outControlSeed);
+}
+
+///------------------------------------------------------------------------------------------------
+
+bool BattleReplay::VerifyDeterminism() const
+{
+    for (size_t i = 1; i < mKeyframes.size(); ++i)
+    {
+        BoardState boardState;
+        int controlSeed = 0;
+        
+        if (!FastForwardFromKeyframe(mKeyframes[i - 1], mKeyframes[i].mActionIndex, boardState, controlSeed))
+        {
+            return false;
+        }
+        
+        if (controlSeed != mKeyframes[i].mControlSeed || SerializeBoardState(boardState) != SerializeBoardState(mKeyframes[i].mBoardState))
+        {
+            LOG(logging::LogType::ERROR, "Replay diverged between keyframes %d and %d (action %d)", static_cast<int>(i - 1), static_cast<int>(i), static_cast<int>(mKeyframes[i].mActionIndex));
+            return false;
+        }
+    }
+    
+    return true;
+}
+
+///------------------------------------------------------------------------------------------------
+
+const BattleReplay::Keyframe* BattleReplay::FindNearestKeyframe(const size_t actionIndex) const
+{
+    auto keyframeIter = std::upper_bound(mKeyframes.cbegin(), mKeyframes.cend(), actionIndex, [](const size_t index, const Keyframe& keyframe){ return index < keyframe.mActionIndex; });
+    
+    if (keyframeIter == mKeyframes.cbegin())
+    {
+        return nullptr;
+    }
+    
+    return &(*std::prev(keyframeIter));
+}
+
+///------------------------------------------------------------------------------------------------
+
+bool BattleReplay::FastForwardFromKeyframe(const Keyframe& keyframe, const size_t targetActionIndex, BoardState& outBoardState, int& outControlSeed) const
+{
+    if (targetActionIndex < keyframe.mActionIndex || targetActionIndex > mActions.size())
+    {
+        return false;
+    }
+    
+    outBoardState = keyframe.mBoardState;
+    
+    // Headless actions still dispatch events, which must not reach the listeners of a live battle
+    events::EventSystem::SuppressionScope eventSuppressionScope;
+    const auto liveControlSeed = math::GetControlSeed();
+    
+    GameRuleEngine ruleEngine(&outBoardState);
+    GameActionEngine actionEngine(GameActionEngine::EngineOperationMode::HEADLESS, mGameSeed, &outBoardState, nullptr, &ruleEngine);
+    math::SetControlSeed(keyframe.mControlSeed);
+    
+    for (auto i = keyframe.mActionIndex; i < targetActionIndex; ++i)
+    {
+        actionEngine.AddGameAction(mActions[i].mActionName, mActions[i].mExtraActionParams);
+    }
+    
+    while (actionEngine.GetActiveGameActionName() != IDLE_GAME_ACTION_NAME && actionEngine.GetActiveGameActionName() != GAME_OVER_GAME_ACTION_NAME)
+    {
+        actionEngine.Update(0);
+    }
+    
+    outControlSeed = math::GetControlSeed();
+    math::SetControlSeed(liveControlSeed);
+    return true;
+}
+
+///------------------------------------------------------------------------------------------------
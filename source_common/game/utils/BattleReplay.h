@@ -0,0 +1,99 @@
+///------------------------------------------------------------------------------------------------
+///  BattleReplay.h
+///  Predators
+///
+///  Created by Alex Koukoulas on 10/04/2024
+///------------------------------------------------------------------------------------------------
+
+#ifndef BattleReplay_h
+#define BattleReplay_h
+
+///------------------------------------------------------------------------------------------------
+
+#include <engine/utils/StringUtils.h>
+#include <game/BoardState.h>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+///------------------------------------------------------------------------------------------------
+
+/// Compact binary battle log. Serialized actions are stored with varint ids into
+/// a name table and typed extra params, and periodic BoardState keyframes allow
+/// a replay to be resumed (or verified) from the middle of a battle.
+class BattleReplay final
+{
+public:
+    using ExtraActionParams = std::unordered_map<std::string, std::string>;
+    
+    struct Action
+    {
+        strutils::StringId mActionName;
+        ExtraActionParams mExtraActionParams;
+    };
+    
+    struct Keyframe
+    {
+        size_t mActionIndex = 0;  // Board state prior to the action with this index being applied
+        int mControlSeed = 0;
+        BoardState mBoardState;
+    };
+
+public:
+    static const std::string REPLAY_FILE_NAME;
+
+public:
+    static bool Deserialize(const std::vector<uint8_t>& bytes, BattleReplay& outReplay);
+    static bool LoadFromFile(BattleReplay& outReplay);
+    static std::vector<uint8_t> SerializeBoardState(const BoardState& boardState);
+
+public:
+    BattleReplay(const int gameSeed = 0, const std::vector<int>& topPlayerDeck = {}, const std::vector<int>& botPlayerDeck = {}, const int topPlayerStartingHealth = 0, const int botPlayerStartingHealth = 0);
+    
+    std::vector<uint8_t> Serialize() const;
+    
+    // Queues the encoded replay on the background data file writer
+    void SaveToFile() const;
+    
+    void RecordAction(const strutils::StringId& actionName, const ExtraActionParams& extraActionParams);
+    // Board state (and control seed) prior to the action with the given index being applied.
+    // Keyframes need to be recorded in increasing action index order.
+    void RecordKeyframe(const size_t actionIndex, const BoardState& boardState, const int controlSeed);
+    
+    // Restores the nearest keyframe at or before the target action index and headlessly
+    // runs the remaining actions. Returns false if there is no keyframe to start from.
+    // Neither the global control seed nor any event listeners are affected, so it is safe
+    // to call while a battle is live.
+    bool FastForward(const size_t targetActionIndex, BoardState& outBoardState, int& outControlSeed) const;
+    
+    // Fast forwards from each keyframe to the next one and compares the resulting
+    // board state and control seed with the recorded ones.
+    bool VerifyDeterminism() const;
+    
+    const Keyframe* FindNearestKeyframe(const size_t actionIndex) const;
+    
+    int GetGameSeed() const { return mGameSeed; }
+    int GetTopPlayerStartingHealth() const { return mTopPlayerStartingHealth; }
+    int GetBotPlayerStartingHealth() const { return mBotPlayerStartingHealth; }
+    const std::vector<int>& GetTopPlayerDeck() const { return mTopPlayerDeck; }
+    const std::vector<int>& GetBotPlayerDeck() const { return mBotPlayerDeck; }
+    const std::vector<Action>& GetActions() const { return mActions; }
+    const std::vector<Keyframe>& GetKeyframes() const { return mKeyframes; }
+
+private:
+    bool FastForwardFromKeyframe(const Keyframe& keyframe, const size_t targetActionIndex, BoardState& outBoardState, int& outControlSeed) const;
+
+private:
+    int mGameSeed;
+    std::vector<int> mTopPlayerDeck;
+    std::vector<int> mBotPlayerDeck;
+    int mTopPlayerStartingHealth;
+    int mBotPlayerStartingHealth;
+    std::vector<Action> mActions;
+    std::vector<Keyframe> mKeyframes;
+};
+
+///------------------------------------------------------------------------------------------------
+
+#endif /* BattleReplay_h */
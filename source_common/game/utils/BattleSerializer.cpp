@@ -6,41 +6,61 @@
 ///------------------------------------------------------------------------------------------------
 
 #include <engine/utils/Logging.h>
+#include <engine/utils/MathUtils.h>
 #include <fstream>
 #include <game/utils/BattleSerializer.h>
 
 ///------------------------------------------------------------------------------------------------
 
-BattleSerializer::BattleSerializer(const int gameSeed, const std::vector<int>& topPlayerDeck, const std::vector<int>& botPlayerDeck, int topPlayerStartingHealth, int botPlayerStartingHealth)
-    : serial::BaseDataFileSerializer("last_battle", serial::DataFileType::PERSISTENCE_FILE_TYPE, serial::DataFileOpeningBehavior::DELAY_DATA_FILE_OPENING_TILL_FLUSH)
+BattleSerializer::BattleSerializer(const int gameSeed, const std::vector<int>& topPlayerDeck, const std::vector<int>& botPlayerDeck, int topPlayerStartingHealth, int botPlayerStartingHealth, const BoardState& boardState)
+    : serial::BaseDataFileSerializer("last_battle", serial::DataFileType::PERSISTENCE_FILE_TYPE, serial::DataFileOpeningBehavior::DELAY_DATA_FILE_OPENING_TILL_FLUSH, serial::DEFAULT_PERSISTENCE_DATA_FILE_FORMAT)
+    , mBoardState(boardState)
+    , mReplay(gameSeed, topPlayerDeck, botPlayerDeck, topPlayerStartingHealth, botPlayerStartingHealth)
+    , mAppliedActionCount(0)
 {
-    mState["seed"] = gameSeed;
-    mState["top_deck"] = topPlayerDeck;
-    mState["bot_deck"] = botPlayerDeck;
-    mState["top_player_starting_health"] = topPlayerStartingHealth;
-    mState["bot_player_starting_health"] = botPlayerStartingHealth;
+    GetMutableStateSection("seed") = gameSeed;
+    GetMutableStateSection("top_deck") = topPlayerDeck;
+    GetMutableStateSection("bot_deck") = botPlayerDeck;
+    GetMutableStateSection("top_player_starting_health") = topPlayerStartingHealth;
+    GetMutableStateSection("bot_player_starting_health") = botPlayerStartingHealth;
     
     events::EventSystem::GetInstance().RegisterForEvent<events::SerializableGameActionEvent>(this, &BattleSerializer::OnSerializableGameActionEvent);
+    events::EventSystem::GetInstance().RegisterForEvent<events::SerializableGameActionAboutToApplyEvent>(this, &BattleSerializer::OnSerializableGameActionAboutToApplyEvent);
 }
 
 ///------------------------------------------------------------------------------------------------
 
 void BattleSerializer::OnSerializableGameActionEvent(const events::SerializableGameActionEvent& event)
 {
-    nlohmann::json actionJson;
-    actionJson["name"] = event.mActionName.GetString();
-    nlohmann::json actionExtraParamsJson;
-    for (const auto& extraActionParam: event.mExtraActionParams)
-    {
-        actionExtraParamsJson[extraActionParam.first] = extraActionParam.second;
-    }
-    
-    if (!actionExtraParamsJson.empty())
+    mReplay.RecordAction(event.mActionName, event.mExtraActionParams);
+}
+
+///------------------------------------------------------------------------------------------------
+
+void BattleSerializer::OnSerializableGameActionAboutToApplyEvent(const events::SerializableGameActionAboutToApplyEvent&)
+{
+    // Serializable actions are applied in the order they were recorded, so at this point the
+    // board reflects exactly the first mAppliedActionCount recorded actions.
+    if (mAppliedActionCount % REPLAY_KEYFRAME_ACTION_INTERVAL == 0)
     {
-        actionJson["extraActionParams"] = std::move(actionExtraParamsJson);
+        mReplay.RecordKeyframe(mAppliedActionCount, mBoardState, math::GetControlSeed());
     }
     
-    mState["actions"].push_back(std::move(actionJson));
+    mAppliedActionCount++;
+}
+
+///------------------------------------------------------------------------------------------------
+
+void BattleSerializer::FlushReplayToFile()
+{
+    mReplay.SaveToFile();
+}
+
+///------------------------------------------------------------------------------------------------
+
+const BattleReplay& BattleSerializer::GetReplay() const
+{
+    return mReplay;
 }
 
 ///------------------------------------------------------------------------------------------------
@@ -13,17 +13,32 @@
 #include <engine/utils/BaseDataFileSerializer.h>
 #include <game/events/EventSystem.h>
 #include <engine/utils/StringUtils.h>
+#include <game/utils/BattleReplay.h>
 #include <vector>
 
 ///------------------------------------------------------------------------------------------------
 
+/// The last_battle data file only holds the battle's setup (synced and validated like the rest of
+/// the persistence files), whereas its actions and keyframes live in the binary BattleReplay.
 class BattleSerializer final: public serial::BaseDataFileSerializer, public events::IListener
 {
 public:
-    BattleSerializer(const int gameSeed, const std::vector<int>& topPlayerDeck, const std::vector<int>& botPlayerDeck, int topPlayerStartingHealth, int botPlayerStartingHealth);
+    static constexpr size_t REPLAY_KEYFRAME_ACTION_INTERVAL = 8;
+    
+public:
+    BattleSerializer(const int gameSeed, const std::vector<int>& topPlayerDeck, const std::vector<int>& botPlayerDeck, int topPlayerStartingHealth, int botPlayerStartingHealth, const BoardState& boardState);
+    
+    void FlushReplayToFile();
+    const BattleReplay& GetReplay() const;
 
 private:
     void OnSerializableGameActionEvent(const events::SerializableGameActionEvent& event);
+    void OnSerializableGameActionAboutToApplyEvent(const events::SerializableGameActionAboutToApplyEvent&);
+    
+private:
+    const BoardState& mBoardState;
+    BattleReplay mReplay;
+    size_t mAppliedActionCount;
 };
 
 ///------------------------------------------------------------------------------------------------
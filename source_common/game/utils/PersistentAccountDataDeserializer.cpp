@@ -14,7 +14,7 @@
 ///------------------------------------------------------------------------------------------------
 
 PersistentAccountDataDeserializer::PersistentAccountDataDeserializer(DataRepository& dataRepository)
-    : serial::BaseDataFileDeserializer("persistent", serial::DataFileType::PERSISTENCE_FILE_TYPE, serial::WarnOnFileNotFoundBehavior::DO_NOT_WARN, serial::CheckSumValidationBehavior::VALIDATE_CHECKSUM)
+    : serial::BaseDataFileDeserializer("persistent", serial::DataFileType::PERSISTENCE_FILE_TYPE, serial::WarnOnFileNotFoundBehavior::DO_NOT_WARN, serial::CheckSumValidationBehavior::VALIDATE_CHECKSUM, serial::DEFAULT_PERSISTENCE_DATA_FILE_FORMAT)
 {
     const auto& persistentDataJson = GetState();
     
@@ -10,7 +10,7 @@
 ///------------------------------------------------------------------------------------------------
 
 PersistentAccountDataSerializer::PersistentAccountDataSerializer()
-    : serial::BaseDataFileSerializer("persistent", serial::DataFileType::PERSISTENCE_FILE_TYPE, serial::DataFileOpeningBehavior::DELAY_DATA_FILE_OPENING_TILL_FLUSH)
+    : serial::BaseDataFileSerializer("persistent", serial::DataFileType::PERSISTENCE_FILE_TYPE, serial::DataFileOpeningBehavior::DELAY_DATA_FILE_OPENING_TILL_FLUSH, serial::DEFAULT_PERSISTENCE_DATA_FILE_FORMAT)
 {
 }
 
@@ -10,7 +10,7 @@
 ///------------------------------------------------------------------------------------------------
 
 StorySerializer::StorySerializer()
-    : serial::BaseDataFileSerializer("story", serial::DataFileType::PERSISTENCE_FILE_TYPE, serial::DataFileOpeningBehavior::DELAY_DATA_FILE_OPENING_TILL_FLUSH)
+    : serial::BaseDataFileSerializer("story", serial::DataFileType::PERSISTENCE_FILE_TYPE, serial::DataFileOpeningBehavior::DELAY_DATA_FILE_OPENING_TILL_FLUSH, serial::DEFAULT_PERSISTENCE_DATA_FILE_FORMAT)
 {
 }
 
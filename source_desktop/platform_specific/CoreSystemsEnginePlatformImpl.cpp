@@ -5,9 +5,9 @@
 ///  Created by Alex Koukoulas on 03/10/2023
 ///------------------------------------------------------------------------------------------------
 
-#include <chrono>
 #include <engine/CoreSystemsEngine.h>
 #include <engine/rendering/AnimationManager.h>
+#include <engine/rendering/CommandRecordingRenderer.h>
 #include <engine/rendering/Fonts.h>
 #include <engine/rendering/OpenGL.h>
 #include <engine/rendering/ParticleManager.h>
@@ -16,19 +16,33 @@
 #include <engine/scene/SceneManager.h>
 #include <engine/scene/Scene.h>
 #include <engine/sound/SoundManager.h>
+#include <engine/utils/AllocationTracking.h>
 #include <engine/utils/BaseDataFileDeserializer.h>
 #include <engine/utils/BaseDataFileSerializer.h>
+#include <engine/utils/Benchmark.h>
 #include <engine/utils/FileUtils.h>
+#include <engine/utils/FrameTiming.h>
+#include <engine/utils/JobSystem.h>
 #include <engine/utils/Logging.h>
 #include <engine/utils/OSMessageBox.h>
+#include <engine/utils/PlatformMacros.h>
+#include <engine/utils/Profiling.h>
 #include <imgui/imgui.h>
 #include <imgui/backends/imgui_impl_sdl2.h>
 #include <imgui/backends/imgui_impl_opengl3.h>
 #include <platform_specific/RendererPlatformImpl.h>
 #include <platform_specific/InputStateManagerPlatformImpl.h>
 #include <SDL.h>
+#include <algorithm>
+#include <map>
 #include <thread>
 
+#if defined(MACOS)
+#include <platform_utilities/AppleUtils.h>
+#elif defined(WINDOWS)
+#include <platform_utilities/WindowsUtils.h>
+#endif
+
 ///------------------------------------------------------------------------------------------------
 
 static constexpr int DEFAULT_WINDOW_WIDTH  = 1688;
@@ -37,6 +51,7 @@ static constexpr int MIN_WINDOW_WIDTH      = 1000;
 static constexpr int MIN_WINDOW_HEIGHT     = 780;
 
 static const float DEFAULT_FRAME_MILLIS = 1000.0f/60.0f;
+static constexpr int DEFAULT_MAX_LOGIC_STEPS_PER_FRAME = 4;
 
 ///------------------------------------------------------------------------------------------------
 
@@ -46,13 +61,19 @@ bool CoreSystemsEngine::mInitialized = false;
 
 static float sGameSpeed = 1.0f;
 static float sLastGameLogicDtMillis = 0.0f;
+static bool sFixedTimestep = false;
+static timing::FixedTimestepAccumulator sFixedTimestepAccumulator(DEFAULT_FRAME_MILLIS, DEFAULT_MAX_LOGIC_STEPS_PER_FRAME);
+static timing::FramePacingStats sFramePacingStats;
 static bool sPrintFPS = false;
 static bool sShuttingDown = false;
+static HeadlessMode sHeadlessMode = HeadlessMode::NONE;
+static int sHeadlessMaxFrameCount = 0;
 
 #if (!defined(NDEBUG)) || defined(IMGUI_IN_RELEASE)
 static const int PROFILLING_SAMPLE_COUNT = 300;
 static float sUpdateLogicMillisSamples[PROFILLING_SAMPLE_COUNT];
 static float sRenderingMillisSamples[PROFILLING_SAMPLE_COUNT];
+static float sFrameAllocationCountSamples[PROFILLING_SAMPLE_COUNT];
 static void CreateEngineDebugWidgets();
 #endif
 
@@ -62,12 +83,16 @@ struct CoreSystemsEngine::SystemsImpl
 {
     rendering::AnimationManager mAnimationManager;
     rendering::RendererPlatformImpl mRenderer;
+    rendering::CommandRecordingRenderer mCommandRecordingRenderer;
     rendering::ParticleManager mParticleManager;
     rendering::FontRepository mFontRepository;
     input::InputStateManagerPlatformImpl mInputStateManager;
     scene::SceneManager mSceneManager;
     resources::ResourceLoadingService mResourceLoadingService;
     sound::SoundManager mSoundManager;
+    
+    // Last, so that its workers are joined before any of the systems their jobs use are destroyed
+    jobs::JobSystem mJobSystem;
 };
 
 ///------------------------------------------------------------------------------------------------
@@ -81,6 +106,16 @@ CoreSystemsEngine& CoreSystemsEngine::GetInstance()
 
 ///------------------------------------------------------------------------------------------------
 
+void CoreSystemsEngine::SetHeadlessMode(const HeadlessMode headlessMode, const int maxFrameCount)
+{
+    assert(!mInitialized);
+    sHeadlessMode = headlessMode;
+    sHeadlessMaxFrameCount = maxFrameCount;
+    sPrintFPS = sPrintFPS || headlessMode != HeadlessMode::NONE;
+}
+
+///------------------------------------------------------------------------------------------------
+
 CoreSystemsEngine::~CoreSystemsEngine()
 {
     sShuttingDown = true;
@@ -90,6 +125,12 @@ CoreSystemsEngine::~CoreSystemsEngine()
 
 void CoreSystemsEngine::Initialize()
 {
+    // The offscreen driver creates its contexts through EGL, so it needs neither a display nor a GPU
+    if (sHeadlessMode != HeadlessMode::NONE)
+    {
+        SDL_SetHint(SDL_HINT_VIDEODRIVER, "offscreen");
+    }
+    
     // Initialize SDL
     if (SDL_Init(SDL_INIT_VIDEO) < 0)
     {
@@ -98,7 +139,7 @@ void CoreSystemsEngine::Initialize()
     }
 
     // Create window
-    mWindow = SDL_CreateWindow("Realm of Beasts", SDL_WINDOWPOS_CENTERED, SDL_WINDOWPOS_CENTERED, DEFAULT_WINDOW_WIDTH, DEFAULT_WINDOW_HEIGHT, SDL_WINDOW_SHOWN | SDL_WINDOW_OPENGL | SDL_WINDOW_INPUT_FOCUS | SDL_WINDOW_RESIZABLE | SDL_WINDOW_ALLOW_HIGHDPI);
+    mWindow = SDL_CreateWindow("Realm of Beasts", SDL_WINDOWPOS_CENTERED, SDL_WINDOWPOS_CENTERED, DEFAULT_WINDOW_WIDTH, DEFAULT_WINDOW_HEIGHT, (sHeadlessMode == HeadlessMode::NONE ? SDL_WINDOW_SHOWN : SDL_WINDOW_HIDDEN) | SDL_WINDOW_OPENGL | SDL_WINDOW_INPUT_FOCUS | SDL_WINDOW_RESIZABLE | SDL_WINDOW_ALLOW_HIGHDPI);
 
     // Set minimum window size
     SDL_SetWindowMinimumSize(mWindow, MIN_WINDOW_WIDTH, MIN_WINDOW_HEIGHT);
@@ -135,12 +176,12 @@ void CoreSystemsEngine::Initialize()
     }
 #endif
     
-    // Vsync
-    SDL_GL_SetSwapInterval(1);
+    // Vsync (headless runs are benchmarks, so they shouldn't be capped)
+    SDL_GL_SetSwapInterval(sHeadlessMode == HeadlessMode::NONE ? 1 : 0);
 
     // Systems Initialization
     mSystems = std::make_unique<SystemsImpl>();
-    mSystems->mResourceLoadingService.Initialize();
+    mSystems->mResourceLoadingService.Initialize(mSystems->mJobSystem);
     mSystems->mSoundManager.Initialize();
     
     // Enable texture blending
@@ -154,11 +195,11 @@ void CoreSystemsEngine::Initialize()
     int maxTextureSize;
     GL_CALL(glGetIntegerv(GL_MAX_TEXTURE_SIZE, &maxTextureSize));
     
-    logging::Log(logging::LogType::INFO, "Vendor       : %s", GL_NO_CHECK_CALL(glGetString(GL_VENDOR)));
-    logging::Log(logging::LogType::INFO, "Renderer     : %s", GL_NO_CHECK_CALL(glGetString(GL_RENDERER)));
-    logging::Log(logging::LogType::INFO, "Version      : %s", GL_NO_CHECK_CALL(glGetString(GL_VERSION)));
-    logging::Log(logging::LogType::INFO, "Version      : %s", GL_NO_CHECK_CALL(glGetString(GL_SHADING_LANGUAGE_VERSION)));
-    logging::Log(logging::LogType::INFO, "Max Tex Size : %d", maxTextureSize);
+    LOG(logging::LogType::INFO, "Vendor       : %s", GL_NO_CHECK_CALL(glGetString(GL_VENDOR)));
+    LOG(logging::LogType::INFO, "Renderer     : %s", GL_NO_CHECK_CALL(glGetString(GL_RENDERER)));
+    LOG(logging::LogType::INFO, "Version      : %s", GL_NO_CHECK_CALL(glGetString(GL_VERSION)));
+    LOG(logging::LogType::INFO, "Version      : %s", GL_NO_CHECK_CALL(glGetString(GL_SHADING_LANGUAGE_VERSION)));
+    LOG(logging::LogType::INFO, "Max Tex Size : %d", maxTextureSize);
 
 #if (!defined(NDEBUG)) || defined(IMGUI_IN_RELEASE)
     // Setup Dear ImGui context
@@ -180,32 +221,42 @@ void CoreSystemsEngine::Initialize()
 
 void CoreSystemsEngine::Start(std::function<void()> clientInitFunction, std::function<void(const float)> clientUpdateFunction, std::function<void()> clientApplicationMovingToBackgroundFunction, std::function<void()> clientApplicationWindowResizeFunction, std::function<void()> clientCreateDebugWidgetsFunction, std::function<void()> clientOnOneSecondElapsedFunction)
 {
+    profiling::SetCurrentThreadName("Main");
+    
     mSystems->mParticleManager.LoadParticleData();
     clientInitFunction();
     
     //While application is running
     SDL_Event event;
-    auto lastFrameMillisSinceInit = 0.0f;
+    auto lastFrameNanos           = profiling::GetNowNanos();
     auto secsAccumulator          = 0.0f;
     auto framesAccumulator        = 0LL;
+    auto totalFrameCount          = 0;
+    
+    auto& renderer = GetRenderer();
+    const auto createDebugWidgets = sHeadlessMode != HeadlessMode::COMMAND_RECORDER;
     
     bool shouldQuit = false;
     bool freezeGame = false;
     
     const int refreshRate = rendering::GetDisplayRefreshRate();
     const float targetFpsMillis = 1000.0f / refreshRate;
+    sFramePacingStats.SetVsyncMillis(targetFpsMillis);
     
     while(!shouldQuit)
     {
+        PROFILE_SCOPE("Frame");
+        
         bool windowSizeChanged = false;
         bool applicationMovingToBackground = false;
         bool applicationMovingToForeground = false;
         
-        // Calculate frame delta
-        const auto currentMillisSinceInit = static_cast<float>(SDL_GetTicks());  // the number of milliseconds since the SDL library initialized
-        const auto dtMillis = currentMillisSinceInit - lastFrameMillisSinceInit; // millis diff between current and last frame
+        // Calculate frame delta (SDL_GetTicks' whole millis would make the fixed timestep jitter between 0 and 2 steps a frame)
+        const auto currentFrameNanos = profiling::GetNowNanos();
+        const auto dtMillis = (currentFrameNanos - lastFrameNanos)/1000000.0f; // millis diff between current and last frame
         
-        lastFrameMillisSinceInit = currentMillisSinceInit;
+        lastFrameNanos = currentFrameNanos;
+        sFramePacingStats.RecordFrame(dtMillis);
         framesAccumulator++;
         secsAccumulator += dtMillis * 0.001f; // dt in seconds;
         
@@ -256,83 +307,158 @@ void CoreSystemsEngine::Start(std::function<void()> clientInitFunction, std::fun
         {
             if (sPrintFPS)
             {
-                logging::Log(logging::LogType::INFO, "FPS: %d", framesAccumulator);
+                LOG(logging::LogType::INFO, "FPS: %d", framesAccumulator);
+            }
+            
+            if (sHeadlessMode == HeadlessMode::COMMAND_RECORDER)
+            {
+                const auto frameStats = mSystems->mCommandRecordingRenderer.GetFrameStats();
+                LOG(logging::LogType::INFO, "Draw Calls: %d, State Changes: %d, Uploaded Bytes: %d", frameStats.mDrawCalls, frameStats.mStateChanges, static_cast<int>(frameStats.mUploadedBytes));
             }
             
             framesAccumulator = 0;
             secsAccumulator -= 1.0f;
             
-            mSystems->mResourceLoadingService.ReloadMarkedResourcesFromDisk();
-            mSystems->mFontRepository.ReloadMarkedFontsFromDisk();
-            mSystems->mParticleManager.ReloadParticlesFromDisk();
+            {
+                memory::AllocationScope allocationScope(memory::AllocationTag::RESOURCES);
+                mSystems->mResourceLoadingService.ReloadMarkedResourcesFromDisk();
+                mSystems->mFontRepository.ReloadMarkedFontsFromDisk();
+                mSystems->mParticleManager.ReloadParticlesFromDisk();
+            }
             
             clientOnOneSecondElapsedFunction();
         }
         
-        mSystems->mResourceLoadingService.Update();
-        mSystems->mSoundManager.Update(dtMillis);
+        {
+            memory::AllocationScope allocationScope(memory::AllocationTag::RESOURCES);
+            mSystems->mResourceLoadingService.Update();
+        }
         
-        float gameLogicMillis = math::Max(16.0f, math::Min(32.0f, dtMillis)) * sGameSpeed * targetFpsMillis/DEFAULT_FRAME_MILLIS;
+        {
+            memory::AllocationScope allocationScope(memory::AllocationTag::AUDIO);
+            mSystems->mSoundManager.Update(dtMillis);
+        }
+        
+        serial::BaseDataFileSerializer::Update();
+        
+        // In fixed timestep mode logic runs in whole steps of (game speed scaled) fixed length, as many as the frame's time
+        // accounts for, and renders interpolate transforms between the last two steps. Otherwise each frame runs a single,
+        // clamped, variable length step.
+        auto logicStepCount = 1;
+        auto gameLogicMillis = math::Max(16.0f, math::Min(32.0f, dtMillis)) * sGameSpeed * targetFpsMillis/DEFAULT_FRAME_MILLIS;
+        if (sFixedTimestep)
+        {
+            logicStepCount = sFixedTimestepAccumulator.Advance(dtMillis);
+            gameLogicMillis = sFixedTimestepAccumulator.GetStepMillis() * sGameSpeed;
+        }
+        const auto interpolateTransforms = sFixedTimestep && !freezeGame;
 
         // Update logic
+        const auto logicUpdateStartNanos = profiling::GetNowNanos();
 #if (!defined(NDEBUG)) || defined(IMGUI_IN_RELEASE)
         sLastGameLogicDtMillis = gameLogicMillis;
-        const auto logicUpdateTimeStart = std::chrono::system_clock::now();
 #else
         (void)sLastGameLogicDtMillis;
 #endif
         
-        if (!freezeGame)
+        if (freezeGame)
         {
-            mSystems->mAnimationManager.Update(gameLogicMillis);
-            clientUpdateFunction(gameLogicMillis);
+            mSystems->mInputStateManager.VUpdate();
         }
         
-        mSystems->mInputStateManager.VUpdate();
-        
-        if (!freezeGame)
+        for (int i = 0; i < logicStepCount && !freezeGame; ++i)
         {
+            if (interpolateTransforms)
+            {
+                for (auto& scene: mSystems->mSceneManager.GetScenes())
+                {
+                    scene->CaptureSceneObjectTransforms();
+                }
+            }
+            
+            {
+                memory::AllocationScope allocationScope(memory::AllocationTag::ANIMATION);
+                mSystems->mAnimationManager.Update(gameLogicMillis);
+            }
+            
+            {
+                memory::AllocationScope allocationScope(memory::AllocationTag::GAME_LOGIC);
+                clientUpdateFunction(gameLogicMillis);
+            }
+            
+            // Only the first step of a frame sees its taps (and frames without steps keep them for the next one)
+            mSystems->mInputStateManager.VUpdate();
+        
             for (auto& scene: mSystems->mSceneManager.GetScenes())
             {
-                if (scene->IsLoaded())
+                if (scene->IsLoaded() && scene->GetUpdateTimeSpeedFactor() >= 1.0f)
                 {
-                    if (scene->GetUpdateTimeSpeedFactor() >= 1.0f)
-                    {
-                        scene->GetCamera().Update(gameLogicMillis * scene->GetUpdateTimeSpeedFactor());
-                    }
-                    
-                    mSystems->mParticleManager.UpdateSceneParticles(gameLogicMillis * scene->GetUpdateTimeSpeedFactor(), *scene);
-                    mSystems->mSceneManager.SortSceneObjects(scene);
+                    scene->GetCamera().Update(gameLogicMillis * scene->GetUpdateTimeSpeedFactor());
                 }
             }
+        
+            memory::AllocationScope allocationScope(memory::AllocationTag::PARTICLES);
+            mSystems->mParticleManager.UpdateScenesParticles(gameLogicMillis, mSystems->mSceneManager.GetScenes(), mSystems->mJobSystem);
         }
         
+        // Scenes are sorted in parallel, and all of them are done before any is rendered
+        if (!freezeGame)
+        {
+            memory::AllocationScope allocationScope(memory::AllocationTag::SCENE_SORTING);
+            const auto& scenes = mSystems->mSceneManager.GetScenes();
+            mSystems->mJobSystem.ParallelFor(static_cast<int>(scenes.size()), [&](const int sceneIndex)
+            {
+                if (scenes[sceneIndex]->IsLoaded())
+                {
+                    mSystems->mSceneManager.SortSceneObjects(scenes[sceneIndex]);
+                }
+            });
+        }
+        
+        const auto logicUpdateDurationNanos = profiling::GetNowNanos() - logicUpdateStartNanos;
+        if (profiling::IsEnabled())
+        {
+            profiling::RecordZone("UpdateLogic", logicUpdateStartNanos, logicUpdateDurationNanos);
+        }
 #if (!defined(NDEBUG)) || defined(IMGUI_IN_RELEASE)
-        const auto logicUpdateTimeEnd = std::chrono::system_clock::now();
-        sUpdateLogicMillisSamples[PROFILLING_SAMPLE_COUNT - 1] = std::chrono::duration_cast<std::chrono::milliseconds>(logicUpdateTimeEnd - logicUpdateTimeStart).count();
+        sUpdateLogicMillisSamples[PROFILLING_SAMPLE_COUNT - 1] = logicUpdateDurationNanos/1000000.0f;
 #endif
         
         // Rendering Logic
-        mSystems->mRenderer.VBeginRenderPass();
+        renderer.VBeginRenderPass();
         
 #if (!defined(NDEBUG)) || defined(IMGUI_IN_RELEASE)
-        clientCreateDebugWidgetsFunction();
-        CreateEngineDebugWidgets();
-        
-        const auto renderingTimeStart = std::chrono::system_clock::now();
+        if (createDebugWidgets)
+        {
+            memory::AllocationScope allocationScope(memory::AllocationTag::DEBUG_WIDGETS);
+            clientCreateDebugWidgetsFunction();
+            CreateEngineDebugWidgets();
+        }
 #endif
         
+        const auto renderingStartNanos = profiling::GetNowNanos();
         for (auto& scene: mSystems->mSceneManager.GetScenes())
         {
             if (scene->IsLoaded())
             {
-                mSystems->mRenderer.VRenderScene(*scene);
+                if (interpolateTransforms)
+                {
+                    scene->ApplyInterpolatedSceneObjectTransforms(sFixedTimestepAccumulator.GetInterpolationAlpha());
+                }
+                
+                memory::AllocationScope allocationScope(memory::AllocationTag::RENDERING);
+                renderer.VRenderScene(*scene);
             }
         }
         
+        const auto renderingDurationNanos = profiling::GetNowNanos() - renderingStartNanos;
+        if (profiling::IsEnabled())
+        {
+            profiling::RecordZone("RenderScenes", renderingStartNanos, renderingDurationNanos);
+        }
+        
 #if (!defined(NDEBUG)) || defined(IMGUI_IN_RELEASE)
-        const auto renderingTimeEnd = std::chrono::system_clock::now();
-        sRenderingMillisSamples[PROFILLING_SAMPLE_COUNT - 1] = std::chrono::duration_cast<std::chrono::milliseconds>(renderingTimeEnd - renderingTimeStart).count();
+        sRenderingMillisSamples[PROFILLING_SAMPLE_COUNT - 1] = renderingDurationNanos/1000000.0f;
         
         for (int i = 0; i < PROFILLING_SAMPLE_COUNT - 1; ++i)
         {
@@ -345,12 +471,33 @@ void CoreSystemsEngine::Start(std::function<void()> clientInitFunction, std::fun
         }
 #else
         (void)clientCreateDebugWidgetsFunction;
+        (void)createDebugWidgets;
 #endif
         
-        mSystems->mRenderer.VEndRenderPass();
+        {
+            PROFILE_SCOPE("EndRenderPass");
+            memory::AllocationScope allocationScope(memory::AllocationTag::RENDERING);
+            renderer.VEndRenderPass();
+        }
+        
+        benchmark::RecordRenderedFrame();
+        memory::EndAllocationFrame();
+        
+        for (auto& scene: mSystems->mSceneManager.GetScenes())
+        {
+            scene->RestoreSceneObjectTransforms();
+        }
+        
+        if (sHeadlessMaxFrameCount > 0 && ++totalFrameCount == sHeadlessMaxFrameCount)
+        {
+            shouldQuit = true;
+        }
     }
     
     clientApplicationMovingToBackgroundFunction();
+    
+    // Lands the writes of the flushes above
+    serial::BaseDataFileSerializer::Shutdown();
 }
 
 ///------------------------------------------------------------------------------------------------
@@ -371,6 +518,10 @@ rendering::AnimationManager& CoreSystemsEngine::GetAnimationManager()
 
 rendering::IRenderer& CoreSystemsEngine::GetRenderer()
 {
+    if (sHeadlessMode == HeadlessMode::COMMAND_RECORDER)
+    {
+        return mSystems->mCommandRecordingRenderer;
+    }
     return mSystems->mRenderer;
 }
 
@@ -418,6 +569,13 @@ sound::SoundManager& CoreSystemsEngine::GetSoundManager()
 
 ///------------------------------------------------------------------------------------------------
 
+jobs::JobSystem& CoreSystemsEngine::GetJobSystem()
+{
+    return mSystems->mJobSystem;
+}
+
+///------------------------------------------------------------------------------------------------
+
 float CoreSystemsEngine::GetDefaultAspectRatio() const
 {
     return static_cast<float>(DEFAULT_WINDOW_WIDTH)/DEFAULT_WINDOW_HEIGHT;
@@ -496,6 +654,14 @@ void CreateEngineDebugWidgets()
         CoreSystemsEngine::GetInstance().GetSoundManager().PreloadSfx(availableSfx[sfxIndex]);
         CoreSystemsEngine::GetInstance().GetSoundManager().PlaySound(availableSfx[sfxIndex], false, gain, pitch);
     }
+    const auto mixerStats = CoreSystemsEngine::GetInstance().GetSoundManager().GetMixerStats();
+    if (mixerStats.mCallbackCount > 0)
+    {
+        ImGui::SeparatorText("Mixer");
+        ImGui::Text("Callback Avg %.1fus, Max %.1fus, Budget %.1fus", mixerStats.mAverageCallbackMicros, mixerStats.mMaxCallbackMicros, mixerStats.mCallbackBudgetMicros);
+        ImGui::Text("Overruns %d, Music Underruns %d", static_cast<int>(mixerStats.mCallbackOverrunCount), static_cast<int>(mixerStats.mMusicUnderrunCount));
+        ImGui::Text("Voices %d, Steals %d, Dropped Commands %d", mixerStats.mActiveVoiceCount, static_cast<int>(mixerStats.mVoiceStealCount), static_cast<int>(mixerStats.mDroppedCommandCount));
+    }
     ImGui::End();
     
     // Create runtime configs
@@ -509,9 +675,104 @@ void CreateEngineDebugWidgets()
     {
         sGameSpeed = 1.0f;
     }
+    ImGui::SeparatorText("Frame Pacing");
+    ImGui::Checkbox("Fixed Timestep", &sFixedTimestep);
+    int maxLogicStepsPerFrame = sFixedTimestepAccumulator.GetMaxStepsPerFrame();
+    if (ImGui::SliderInt("Max Steps Per Frame", &maxLogicStepsPerFrame, 1, 10))
+    {
+        sFixedTimestepAccumulator.SetMaxStepsPerFrame(maxLogicStepsPerFrame);
+    }
+    ImGui::Text("Steps %d, Alpha %.2f, Discarded %.1fms", sFixedTimestepAccumulator.GetLastFrameStepCount(), sFixedTimestepAccumulator.GetInterpolationAlpha(), sFixedTimestepAccumulator.GetDiscardedMillis());
+    ImGui::PlotHistogram("Frame Times", [](void* data, int index){ return static_cast<float>(static_cast<const int*>(data)[index]); }, const_cast<int*>(sFramePacingStats.GetFrameTimeHistogram().data()), timing::FramePacingStats::HISTOGRAM_BUCKET_COUNT, 0, "0 to 50ms", 0.0f, FLT_MAX, ImVec2(0.0f, 60.0f));
+    ImGui::Text("Frames %d, Avg %.2fms, Worst %.2fms", sFramePacingStats.GetFrameCount(), sFramePacingStats.GetAverageFrameMillis(), sFramePacingStats.GetWorstFrameMillis());
+    ImGui::Text("Missed Vsyncs %d", sFramePacingStats.GetMissedVsyncCount());
+    ImGui::SameLine();
+    if (ImGui::Button("Reset Stats"))
+    {
+        sFramePacingStats.Reset();
+    }
     ImGui::SeparatorText("Profilling");
     ImGui::PlotLines("Update Logic Samples", sUpdateLogicMillisSamples, PROFILLING_SAMPLE_COUNT);
     ImGui::PlotLines("Rendering Samples", sRenderingMillisSamples, PROFILLING_SAMPLE_COUNT);
+    bool recordProfilingZones = profiling::IsEnabled();
+    if (ImGui::Checkbox("Record Zones", &recordProfilingZones))
+    {
+        profiling::SetEnabled(recordProfilingZones);
+    }
+    ImGui::SameLine();
+    if (ImGui::Button("Export Trace"))
+    {
+#if defined(MACOS)
+        const auto directoryPath = apple_utils::GetPersistentDataDirectoryPath();
+#elif defined(WINDOWS)
+        const auto directoryPath = windows_utils::GetPersistentDataDirectoryPath();
+#endif
+        profiling::WriteChromeTrace(directoryPath + "profiling_trace.json");
+    }
+    ImGui::SeparatorText("Allocations");
+    bool trackAllocations = memory::IsAllocationTrackingEnabled();
+    if (ImGui::Checkbox("Track Allocations", &trackAllocations))
+    {
+        memory::SetAllocationTrackingEnabled(trackAllocations);
+    }
+    if (trackAllocations)
+    {
+        // Stats are of the previous frame, as the current one ends after the widgets are created
+        const auto& frameAllocationStats = memory::GetLastFrameAllocationStats();
+        for (int i = 0; i < PROFILLING_SAMPLE_COUNT - 1; ++i)
+        {
+            sFrameAllocationCountSamples[i] = sFrameAllocationCountSamples[i + 1];
+        }
+        sFrameAllocationCountSamples[PROFILLING_SAMPLE_COUNT - 1] = static_cast<float>(frameAllocationStats.mTotal.mAllocationCount);
+        
+        ImGui::PlotLines("Allocations Per Frame", sFrameAllocationCountSamples, PROFILLING_SAMPLE_COUNT);
+        ImGui::Text("Last Frame %d allocs (%.1fKB), %d frees", static_cast<int>(frameAllocationStats.mTotal.mAllocationCount), frameAllocationStats.mTotal.mAllocatedBytes/1024.0f, static_cast<int>(frameAllocationStats.mTotal.mDeallocationCount));
+        for (int i = 0; i < memory::ALLOCATION_TAG_COUNT; ++i)
+        {
+            const auto& tagCounters = frameAllocationStats.mPerTag[i];
+            if (tagCounters.mAllocationCount > 0)
+            {
+                ImGui::BulletText("%s: %d allocs (%.1fKB)", memory::GetAllocationTagName(static_cast<memory::AllocationTag>(i)), static_cast<int>(tagCounters.mAllocationCount), tagCounters.mAllocatedBytes/1024.0f);
+            }
+        }
+        
+        int frameAllocationBudget = static_cast<int>(memory::GetFrameAllocationBudget());
+        if (ImGui::SliderInt("Frame Budget", &frameAllocationBudget, 0, 1000))
+        {
+            memory::SetFrameAllocationBudget(frameAllocationBudget);
+        }
+        ImGui::Text("Over Budget Frames %d", static_cast<int>(frameAllocationStats.mOverBudgetFrameCount));
+        
+        int callSiteSamplingInterval = memory::GetCallSiteSamplingInterval();
+        if (ImGui::SliderInt("Sample Every", &callSiteSamplingInterval, 0, 100))
+        {
+            memory::SetCallSiteSamplingInterval(callSiteSamplingInterval);
+        }
+        ImGui::SameLine();
+        if (ImGui::Button("Clear Samples"))
+        {
+            memory::ClearCallSiteSamples();
+        }
+        
+        // Heaviest sampled call sites, grouped by label and return address
+        std::map<std::pair<const char*, const void*>, std::pair<int, std::size_t>> callSiteTotals;
+        std::map<std::pair<const char*, const void*>, memory::AllocationTag> callSiteTags;
+        for (const auto& callSiteSample: memory::GetCallSiteSamples())
+        {
+            const auto callSiteKey = std::make_pair(callSiteSample.mLabel, callSiteSample.mCallSite);
+            callSiteTotals[callSiteKey].first++;
+            callSiteTotals[callSiteKey].second += callSiteSample.mSize;
+            callSiteTags[callSiteKey] = callSiteSample.mAllocationTag;
+        }
+        
+        std::vector<std::pair<std::pair<const char*, const void*>, std::pair<int, std::size_t>>> sortedCallSiteTotals(callSiteTotals.begin(), callSiteTotals.end());
+        std::sort(sortedCallSiteTotals.begin(), sortedCallSiteTotals.end(), [](const auto& lhs, const auto& rhs){ return lhs.second.first > rhs.second.first; });
+        for (size_t i = 0; i < sortedCallSiteTotals.size() && i < 10; ++i)
+        {
+            const auto& [callSiteKey, callSiteTotal] = sortedCallSiteTotals[i];
+            ImGui::BulletText("%s %p [%s]: %d samples (%.1fKB)", callSiteKey.first ? callSiteKey.first : "-", callSiteKey.second, memory::GetAllocationTagName(callSiteTags[callSiteKey]), callSiteTotal.first, callSiteTotal.second/1024.0f);
+        }
+    }
     ImGui::SeparatorText("Input");
     const auto& cursorPos = CoreSystemsEngine::GetInstance().GetInputStateManager().VGetPointingPos();
     ImGui::Text("Cursor %.3f,%.3f",cursorPos.x, cursorPos.y);
@@ -9,13 +9,16 @@
 #include <engine/input/IInputStateManager.h>
 #include <engine/rendering/AnimationManager.h>
 #include <engine/rendering/Fonts.h>
+#include <engine/rendering/GpuProfiler.h>
 #include <engine/rendering/OpenGL.h>
+#include <engine/rendering/ShaderUniformBlocks.h>
 #include <engine/resloading/MeshResource.h>
 #include <engine/resloading/ResourceLoadingService.h>
 #include <engine/resloading/ShaderResource.h>
 #include <engine/resloading/TextureResource.h>
 #include <engine/scene/Scene.h>
 #include <engine/scene/SceneObject.h>
+#include <engine/scene/SceneObjectUtils.h>
 #include <engine/utils/Logging.h>
 #include <engine/utils/StringUtils.h>
 #include <imgui/backends/imgui_impl_sdl2.h>
@@ -32,8 +35,6 @@ namespace rendering
 ///------------------------------------------------------------------------------------------------
 
 static const strutils::StringId WORLD_MATRIX_UNIFORM_NAME = strutils::StringId("world");
-static const strutils::StringId VIEW_MATRIX_UNIFORM_NAME  = strutils::StringId("view");
-static const strutils::StringId PROJ_MATRIX_UNIFORM_NAME  = strutils::StringId("proj");
 static const strutils::StringId ROT_MATRIX_UNIFORM_NAME  = strutils::StringId("rot");
 static const strutils::StringId MIN_U_UNIFORM_NAME = strutils::StringId("min_u");
 static const strutils::StringId MIN_V_UNIFORM_NAME = strutils::StringId("min_v");
@@ -48,6 +49,17 @@ static const strutils::StringId IS_TEXTURE_SHEET_UNIFORM_NAME = strutils::String
 static const strutils::StringId CUSTOM_ALPHA_UNIFORM_NAME = strutils::StringId("custom_alpha");
 static const strutils::StringId IS_AFFECTED_BY_LIGHT_UNIFORM_NAME = strutils::StringId("affected_by_light");
 
+// Resolved once, so that the per draw uniform uploads below never look up uniform names
+static const ShaderUniformIndex WORLD_MATRIX_UNIFORM_INDEX = GetShaderUniformIndex(WORLD_MATRIX_UNIFORM_NAME);
+static const ShaderUniformIndex ROT_MATRIX_UNIFORM_INDEX = GetShaderUniformIndex(ROT_MATRIX_UNIFORM_NAME);
+static const ShaderUniformIndex MIN_U_UNIFORM_INDEX = GetShaderUniformIndex(MIN_U_UNIFORM_NAME);
+static const ShaderUniformIndex MIN_V_UNIFORM_INDEX = GetShaderUniformIndex(MIN_V_UNIFORM_NAME);
+static const ShaderUniformIndex MAX_U_UNIFORM_INDEX = GetShaderUniformIndex(MAX_U_UNIFORM_NAME);
+static const ShaderUniformIndex MAX_V_UNIFORM_INDEX = GetShaderUniformIndex(MAX_V_UNIFORM_NAME);
+static const ShaderUniformIndex IS_TEXTURE_SHEET_UNIFORM_INDEX = GetShaderUniformIndex(IS_TEXTURE_SHEET_UNIFORM_NAME);
+static const ShaderUniformIndex CUSTOM_ALPHA_UNIFORM_INDEX = GetShaderUniformIndex(CUSTOM_ALPHA_UNIFORM_NAME);
+static const ShaderUniformIndex IS_AFFECTED_BY_LIGHT_UNIFORM_INDEX = GetShaderUniformIndex(IS_AFFECTED_BY_LIGHT_UNIFORM_NAME);
+
 static const glm::ivec4 RENDER_TO_TEXTURE_VIEWPORT = {-1536, -1024, 4096, 4096};
 static const glm::vec4 RENDER_TO_TEXTURE_CLEAR_COLOR = {1.0f, 1.0f, 1.0f, 0.0f};
 
@@ -56,15 +68,16 @@ static const glm::vec4 RENDER_TO_TEXTURE_CLEAR_COLOR = {1.0f, 1.0f, 1.0f, 0.0f};
 
 static int sDrawCallCounter = 0;
 static int sParticleCounter = 0;
+static int sDrawnSceneObjectCounter = 0;
+static int sCulledSceneObjectCounter = 0;
 
 ///------------------------------------------------------------------------------------------------
 
 class SceneObjectTypeRendererVisitor
 {
 public:
-    SceneObjectTypeRendererVisitor(const scene::SceneObject& sceneObject, const Camera& camera)
+    SceneObjectTypeRendererVisitor(const scene::SceneObject& sceneObject)
     : mSceneObject(sceneObject)
-    , mCamera(camera)
     {
     }
     
@@ -75,10 +88,7 @@ public:
         auto* currentShader = &(resService.GetResource<resources::ShaderResource>(mSceneObject.mShaderResourceId));
         GL_CALL(glUseProgram(currentShader->GetProgramId()));
         
-        for (size_t i = 0; i < currentShader->GetUniformSamplerNames().size(); ++i)
-        {
-            currentShader->SetInt(currentShader->GetUniformSamplerNames().at(i), static_cast<int>(i));
-        }
+        currentShader->SetUniformSamplerTextureUnits();
         
         auto* currentMesh = &(resService.GetResource<resources::MeshResource>(mSceneObject.mMeshResourceId));
         GL_CALL(glBindVertexArray(currentMesh->GetVertexArrayObject()));
@@ -107,18 +117,16 @@ public:
         world *= rot;
         world = glm::scale(world, mSceneObject.mScale);
         
-        currentShader->SetFloat(CUSTOM_ALPHA_UNIFORM_NAME, 1.0f);
-        currentShader->SetBool(IS_AFFECTED_BY_LIGHT_UNIFORM_NAME, mSceneObject.mShaderBoolUniformValues.count(IS_AFFECTED_BY_LIGHT_UNIFORM_NAME) ? mSceneObject.mShaderBoolUniformValues.at(IS_AFFECTED_BY_LIGHT_UNIFORM_NAME) : false);
-        currentShader->SetBool(IS_TEXTURE_SHEET_UNIFORM_NAME, false);
-        currentShader->SetMatrix4fv(WORLD_MATRIX_UNIFORM_NAME, world);
-        currentShader->SetMatrix4fv(VIEW_MATRIX_UNIFORM_NAME, mCamera.GetViewMatrix());
-        currentShader->SetMatrix4fv(PROJ_MATRIX_UNIFORM_NAME, mCamera.GetProjMatrix());
-        currentShader->SetMatrix4fv(ROT_MATRIX_UNIFORM_NAME, rot);
+        currentShader->SetFloat(CUSTOM_ALPHA_UNIFORM_INDEX, 1.0f);
+        currentShader->SetBool(IS_AFFECTED_BY_LIGHT_UNIFORM_INDEX, mSceneObject.mShaderBoolUniformValues.count(IS_AFFECTED_BY_LIGHT_UNIFORM_NAME) ? mSceneObject.mShaderBoolUniformValues.at(IS_AFFECTED_BY_LIGHT_UNIFORM_NAME) : false);
+        currentShader->SetBool(IS_TEXTURE_SHEET_UNIFORM_INDEX, false);
+        currentShader->SetMatrix4fv(WORLD_MATRIX_UNIFORM_INDEX, world);
+        currentShader->SetMatrix4fv(ROT_MATRIX_UNIFORM_INDEX, rot);
         
-        for (const auto& vec3Entry: mSceneObject.mShaderVec3UniformValues) currentShader->SetFloatVec3(vec3Entry.first, vec3Entry.second);
-        for (const auto& floatEntry: mSceneObject.mShaderFloatUniformValues) currentShader->SetFloat(floatEntry.first, floatEntry.second);
-        for (const auto& intEntry: mSceneObject.mShaderIntUniformValues) currentShader->SetInt(intEntry.first, intEntry.second);
-        for (const auto& boolEntry: mSceneObject.mShaderBoolUniformValues) currentShader->SetBool(boolEntry.first, boolEntry.second);
+        currentShader->SetUniformValues(mSceneObject.mShaderVec3UniformValues);
+        currentShader->SetUniformValues(mSceneObject.mShaderFloatUniformValues);
+        currentShader->SetUniformValues(mSceneObject.mShaderIntUniformValues);
+        currentShader->SetUniformValues(mSceneObject.mShaderBoolUniformValues);
         
         GL_CALL(glDrawElements(GL_TRIANGLES, currentMesh->GetElementCount(), GL_UNSIGNED_SHORT, (void*)0));
         sDrawCallCounter++;
@@ -131,10 +139,7 @@ public:
         auto* currentShader = &(resService.GetResource<resources::ShaderResource>(mSceneObject.mShaderResourceId));
         GL_CALL(glUseProgram(currentShader->GetProgramId()));
         
-        for (size_t i = 0; i < currentShader->GetUniformSamplerNames().size(); ++i)
-        {
-            currentShader->SetInt(currentShader->GetUniformSamplerNames().at(i), static_cast<int>(i));
-        }
+        currentShader->SetUniformSamplerTextureUnits();
         
         auto* currentMesh = &(resService.GetResource<resources::MeshResource>(mSceneObject.mMeshResourceId));
         GL_CALL(glBindVertexArray(currentMesh->GetVertexArrayObject()));
@@ -171,20 +176,18 @@ public:
             world = glm::translate(world, glm::vec3(targetX, targetY, mSceneObject.mPosition.z));
             world = glm::scale(world, glm::vec3(glyph.mWidthPixels * mSceneObject.mScale.x, glyph.mHeightPixels * mSceneObject.mScale.y, 1.0f));
             
-            currentShader->SetFloat(CUSTOM_ALPHA_UNIFORM_NAME, 1.0f);
-            currentShader->SetBool(IS_TEXTURE_SHEET_UNIFORM_NAME, true);
-            currentShader->SetFloat(MIN_U_UNIFORM_NAME, glyph.minU);
-            currentShader->SetFloat(MIN_V_UNIFORM_NAME, glyph.minV);
-            currentShader->SetFloat(MAX_U_UNIFORM_NAME, glyph.maxU);
-            currentShader->SetFloat(MAX_V_UNIFORM_NAME, glyph.maxV);
-            currentShader->SetMatrix4fv(WORLD_MATRIX_UNIFORM_NAME, world);
-            currentShader->SetMatrix4fv(VIEW_MATRIX_UNIFORM_NAME, mCamera.GetViewMatrix());
-            currentShader->SetMatrix4fv(PROJ_MATRIX_UNIFORM_NAME, mCamera.GetProjMatrix());
+            currentShader->SetFloat(CUSTOM_ALPHA_UNIFORM_INDEX, 1.0f);
+            currentShader->SetBool(IS_TEXTURE_SHEET_UNIFORM_INDEX, true);
+            currentShader->SetFloat(MIN_U_UNIFORM_INDEX, glyph.minU);
+            currentShader->SetFloat(MIN_V_UNIFORM_INDEX, glyph.minV);
+            currentShader->SetFloat(MAX_U_UNIFORM_INDEX, glyph.maxU);
+            currentShader->SetFloat(MAX_V_UNIFORM_INDEX, glyph.maxV);
+            currentShader->SetMatrix4fv(WORLD_MATRIX_UNIFORM_INDEX, world);
             
-            for (const auto& vec3Entry: mSceneObject.mShaderVec3UniformValues) currentShader->SetFloatVec3(vec3Entry.first, vec3Entry.second);
-            for (const auto& floatEntry: mSceneObject.mShaderFloatUniformValues) currentShader->SetFloat(floatEntry.first, floatEntry.second);
-            for (const auto& intEntry: mSceneObject.mShaderIntUniformValues) currentShader->SetInt(intEntry.first, intEntry.second);
-            for (const auto& boolEntry: mSceneObject.mShaderBoolUniformValues) currentShader->SetBool(boolEntry.first, boolEntry.second);
+            currentShader->SetUniformValues(mSceneObject.mShaderVec3UniformValues);
+            currentShader->SetUniformValues(mSceneObject.mShaderFloatUniformValues);
+            currentShader->SetUniformValues(mSceneObject.mShaderIntUniformValues);
+            currentShader->SetUniformValues(mSceneObject.mShaderBoolUniformValues);
             
             GL_CALL(glDrawElements(GL_TRIANGLES, currentMesh->GetElementCount(), GL_UNSIGNED_SHORT, (void*)0));
             sDrawCallCounter++;
@@ -207,10 +210,7 @@ public:
         auto* currentShader = &(resService.GetResource<resources::ShaderResource>(mSceneObject.mShaderResourceId));
         GL_CALL(glUseProgram(currentShader->GetProgramId()));
         
-        for (size_t i = 0; i < currentShader->GetUniformSamplerNames().size(); ++i)
-        {
-            currentShader->SetInt(currentShader->GetUniformSamplerNames().at(i), static_cast<int>(i));
-        }
+        currentShader->SetUniformSamplerTextureUnits();
         
         auto* currentTexture = &(resService.GetResource<resources::TextureResource>(mSceneObject.mTextureResourceId));
         GL_CALL(glActiveTexture(GL_TEXTURE0));
@@ -226,14 +226,12 @@ public:
             }
         }
         
-        currentShader->SetFloat(CUSTOM_ALPHA_UNIFORM_NAME, 1.0f);
-        currentShader->SetMatrix4fv(VIEW_MATRIX_UNIFORM_NAME, mCamera.GetViewMatrix());
-        currentShader->SetMatrix4fv(PROJ_MATRIX_UNIFORM_NAME, mCamera.GetProjMatrix());
+        currentShader->SetFloat(CUSTOM_ALPHA_UNIFORM_INDEX, 1.0f);
         
-        for (const auto& vec3Entry: mSceneObject.mShaderVec3UniformValues) currentShader->SetFloatVec3(vec3Entry.first, vec3Entry.second);
-        for (const auto& floatEntry: mSceneObject.mShaderFloatUniformValues) currentShader->SetFloat(floatEntry.first, floatEntry.second);
-        for (const auto& intEntry: mSceneObject.mShaderIntUniformValues) currentShader->SetInt(intEntry.first, intEntry.second);
-        for (const auto& boolEntry: mSceneObject.mShaderBoolUniformValues) currentShader->SetBool(boolEntry.first, boolEntry.second);
+        currentShader->SetUniformValues(mSceneObject.mShaderVec3UniformValues);
+        currentShader->SetUniformValues(mSceneObject.mShaderFloatUniformValues);
+        currentShader->SetUniformValues(mSceneObject.mShaderIntUniformValues);
+        currentShader->SetUniformValues(mSceneObject.mShaderBoolUniformValues);
         
         GL_CALL(glBindVertexArray(particleEmitterData.mParticleVertexArrayObject));
         
@@ -306,7 +304,6 @@ public:
 
 private:
     const scene::SceneObject& mSceneObject;
-    const Camera& mCamera;
 };
 
 ///------------------------------------------------------------------------------------------------
@@ -315,7 +312,12 @@ void RendererPlatformImpl::VBeginRenderPass()
 {
     sDrawCallCounter = 0;
     sParticleCounter = 0;
+    sDrawnSceneObjectCounter = 0;
+    sCulledSceneObjectCounter = 0;
+    resources::ShaderResource::ResetUniformUploadCount();
+    mShaderUniformBlocks.ResetUploadCount();
     mSceneObjectsWithDeferredRendering.clear();
+    mGpuProfiler.BeginFrame();
     
     // Set View Port
     int w, h;
@@ -347,22 +349,38 @@ void RendererPlatformImpl::VRenderScene(scene::Scene& scene)
 {
     mCachedScenes.push_back(scene);
     
+    mGpuProfiler.BeginStage(scene.GetName().GetString().c_str());
+    
+    const auto frustum = scene.GetCamera().CalculateFrustum();
+    mShaderUniformBlocks.UpdatePerSceneData(scene.GetCamera());
+    
     for (const auto& sceneObject: scene.GetSceneObjects())
     {
         if (sceneObject->mInvisible) continue;
+        if (scene_object_utils::IsSceneObjectOutsideOfFrustum(*sceneObject, frustum))
+        {
+            sCulledSceneObjectCounter++;
+            continue;
+        }
+        
+        sDrawnSceneObjectCounter++;
         if (sceneObject->mDeferredRendering)
         {
             mSceneObjectsWithDeferredRendering.push_back(std::make_pair(&scene.GetCamera(), sceneObject));
             continue;
         }
-        std::visit(SceneObjectTypeRendererVisitor(*sceneObject, scene.GetCamera()), sceneObject->mSceneObjectTypeData);
+        std::visit(SceneObjectTypeRendererVisitor(*sceneObject), sceneObject->mSceneObjectTypeData);
     }
+    
+    mGpuProfiler.EndStage();
 }
 
 ///------------------------------------------------------------------------------------------------
 
 void RendererPlatformImpl::VRenderSceneObjectsToTexture(const std::vector<std::shared_ptr<scene::SceneObject>>& sceneObjects, const rendering::Camera& camera)
 {
+    mGpuProfiler.BeginStage("CardBaking");
+    
     int w, h;
     SDL_GL_GetDrawableSize(&CoreSystemsEngine::GetInstance().GetContextWindow(), &w, &h);
     const auto currentAspectToDefaultAspect = (static_cast<float>(w)/h)/CoreSystemsEngine::GetInstance().GetDefaultAspectRatio();
@@ -389,23 +407,30 @@ void RendererPlatformImpl::VRenderSceneObjectsToTexture(const std::vector<std::s
     
     GL_CALL(glDisable(GL_CULL_FACE));
     
+    mShaderUniformBlocks.UpdatePerSceneData(camera);
+    
     for (auto sceneObject: sceneObjects)
     {
-        std::visit(SceneObjectTypeRendererVisitor(*sceneObject, camera), sceneObject->mSceneObjectTypeData);
+        std::visit(SceneObjectTypeRendererVisitor(*sceneObject), sceneObject->mSceneObjectTypeData);
     }
     
     const_cast<rendering::Camera&>(camera).SetPosition(originalPosition);
     const_cast<rendering::Camera&>(camera).SetZoomFactor(originalZoomFactor);
+    
+    mGpuProfiler.EndStage();
 }
 
 ///------------------------------------------------------------------------------------------------
 
 void RendererPlatformImpl::VEndRenderPass()
 {
+    mGpuProfiler.BeginStage("DeferredSceneObjects");
     for (const auto& sceneObjectEntry: mSceneObjectsWithDeferredRendering)
     {
-        std::visit(SceneObjectTypeRendererVisitor(*sceneObjectEntry.second, *sceneObjectEntry.first), sceneObjectEntry.second->mSceneObjectTypeData);
+        mShaderUniformBlocks.UpdatePerSceneData(*sceneObjectEntry.first);
+        std::visit(SceneObjectTypeRendererVisitor(*sceneObjectEntry.second), sceneObjectEntry.second->mSceneObjectTypeData);
     }
+    mGpuProfiler.EndStage();
     
 #if (!defined(NDEBUG)) || defined(IMGUI_IN_RELEASE)
     // Create all custom GUIs
@@ -415,7 +440,9 @@ void RendererPlatformImpl::VEndRenderPass()
     // Imgui end-of-frame calls
     ImGui::EndFrame();
     ImGui::Render();
+    mGpuProfiler.BeginStage("ImGui");
     ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+    mGpuProfiler.EndStage();
 #endif
     
     // Swap window buffers
@@ -456,7 +483,25 @@ void RendererPlatformImpl::CreateIMGuiWidgets()
     ImGui::Begin("Rendering", nullptr, GLOBAL_IMGUI_WINDOW_FLAGS);
     ImGui::Text("Draw Calls %d", sDrawCallCounter);
     ImGui::Text("Particle Count %d", sParticleCounter);
+    ImGui::Text("SOs Drawn %d / Culled %d", sDrawnSceneObjectCounter, sCulledSceneObjectCounter);
+    // Every draw used to upload the view & proj matrices itself, before they moved to a uniform block
+    const auto uniformUploadCount = static_cast<int>(resources::ShaderResource::GetUniformUploadCount());
+    ImGui::Text("Uniform Uploads %d (%d without UBOs)", uniformUploadCount, uniformUploadCount + 2 * sDrawCallCounter);
+    ImGui::Text("UBO Uploads %d", static_cast<int>(mShaderUniformBlocks.GetUploadCount()));
     ImGui::Text("Anims Live %d", CoreSystemsEngine::GetInstance().GetAnimationManager().GetAnimationsPlayingCount());
+    ImGui::SeparatorText("GPU Timers");
+    bool gpuTimersEnabled = mGpuProfiler.IsEnabled();
+    if (ImGui::Checkbox("Enabled", &gpuTimersEnabled))
+    {
+        mGpuProfiler.SetEnabled(gpuTimersEnabled);
+    }
+    auto totalGpuMillis = 0.0f;
+    for (const auto& stageTiming: mGpuProfiler.GetStageTimings())
+    {
+        ImGui::Text("%s %.3fms (avg %.3fms)", stageTiming.mStageName, stageTiming.mLastMillis, stageTiming.mAverageMillis);
+        totalGpuMillis += stageTiming.mAverageMillis;
+    }
+    ImGui::Text("Total %.3fms", totalGpuMillis);
     ImGui::End();
     
     // Create scene data viewer
@@ -548,43 +593,43 @@ void RendererPlatformImpl::CreateIMGuiWidgets()
                 ImGui::SeparatorText("Uniforms (floats)");
                 for (auto& uniformFloatEntry: sceneObject->mShaderFloatUniformValues)
                 {
-                    if (sUniformMinMaxValues.count(uniformFloatEntry.first) == 0)
+                    if (sUniformMinMaxValues.count(uniformFloatEntry.mName) == 0)
                     {
-                        if (uniformFloatEntry.second == 0.0f)
+                        if (uniformFloatEntry.mValue == 0.0f)
                         {
-                            sUniformMinMaxValues[uniformFloatEntry.first] = glm::vec2(-1.0f, 1.0f);
+                            sUniformMinMaxValues[uniformFloatEntry.mName] = glm::vec2(-1.0f, 1.0f);
                         }
                         else
                         {
-                            sUniformMinMaxValues[uniformFloatEntry.first] = glm::vec2(uniformFloatEntry.second/100.0f, uniformFloatEntry.second*10.0f);
+                            sUniformMinMaxValues[uniformFloatEntry.mName] = glm::vec2(uniformFloatEntry.mValue/100.0f, uniformFloatEntry.mValue*10.0f);
                         }
                     }
                     
-                    auto uniformMinMaxValues = sUniformMinMaxValues.at(uniformFloatEntry.first);
-                    ImGui::SliderFloat(uniformFloatEntry.first.GetString().c_str(), &uniformFloatEntry.second, uniformMinMaxValues.x, uniformMinMaxValues.y);
+                    auto uniformMinMaxValues = sUniformMinMaxValues.at(uniformFloatEntry.mName);
+                    ImGui::SliderFloat(uniformFloatEntry.mName.GetString().c_str(), &uniformFloatEntry.mValue, uniformMinMaxValues.x, uniformMinMaxValues.y);
                 }
                 ImGui::SeparatorText("Uniforms (ints)");
                 for (auto& uniformIntEntry: sceneObject->mShaderIntUniformValues)
                 {
-                    if (sUniformMinMaxValues.count(uniformIntEntry.first) == 0)
+                    if (sUniformMinMaxValues.count(uniformIntEntry.mName) == 0)
                     {
-                        sUniformMinMaxValues[uniformIntEntry.first] = glm::vec2(uniformIntEntry.second - 10, uniformIntEntry.second + 10);
+                        sUniformMinMaxValues[uniformIntEntry.mName] = glm::vec2(uniformIntEntry.mValue - 10, uniformIntEntry.mValue + 10);
                     }
                     
-                    auto uniformMinMaxValues = sUniformMinMaxValues.at(uniformIntEntry.first);
-                    ImGui::SliderInt(uniformIntEntry.first.GetString().c_str(), &uniformIntEntry.second, uniformMinMaxValues.x, uniformMinMaxValues.y);
+                    auto uniformMinMaxValues = sUniformMinMaxValues.at(uniformIntEntry.mName);
+                    ImGui::SliderInt(uniformIntEntry.mName.GetString().c_str(), &uniformIntEntry.mValue, uniformMinMaxValues.x, uniformMinMaxValues.y);
                 }
                 ImGui::SeparatorText("Uniforms (bools)");
                 for (auto& uniformBoolEntry: sceneObject->mShaderBoolUniformValues)
                 {
-                    ImGui::Checkbox(uniformBoolEntry.first.GetString().c_str(), &uniformBoolEntry.second);
+                    ImGui::Checkbox(uniformBoolEntry.mName.GetString().c_str(), &uniformBoolEntry.mValue);
                 }
                 ImGui::SeparatorText("Uniforms (vec3)");
                 for (auto& uniformVec3Entry: sceneObject->mShaderVec3UniformValues)
                 {
-                    ImGui::SliderFloat((uniformVec3Entry.first.GetString() + ".x").c_str(), &uniformVec3Entry.second.x, -1.0f, 1.0f);
-                    ImGui::SliderFloat((uniformVec3Entry.first.GetString() + ".y").c_str(), &uniformVec3Entry.second.y, -1.0f, 1.0f);
-                    ImGui::SliderFloat((uniformVec3Entry.first.GetString() + ".z").c_str(), &uniformVec3Entry.second.z, -1.0f, 1.0f);
+                    ImGui::SliderFloat((uniformVec3Entry.mName.GetString() + ".x").c_str(), &uniformVec3Entry.mValue.x, -1.0f, 1.0f);
+                    ImGui::SliderFloat((uniformVec3Entry.mName.GetString() + ".y").c_str(), &uniformVec3Entry.mValue.y, -1.0f, 1.0f);
+                    ImGui::SliderFloat((uniformVec3Entry.mName.GetString() + ".z").c_str(), &uniformVec3Entry.mValue.z, -1.0f, 1.0f);
                 }
                 ImGui::PopID();
             }
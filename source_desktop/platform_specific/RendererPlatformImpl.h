@@ -10,7 +10,9 @@
 
 ///------------------------------------------------------------------------------------------------
 
+#include <engine/rendering/GpuProfiler.h>
 #include <engine/rendering/IRenderer.h>
+#include <engine/rendering/ShaderUniformBlocks.h>
 #include <engine/CoreSystemsEngine.h>
 #include <functional>
 #include <memory>
@@ -39,6 +41,8 @@ private:
     
 private:
     std::vector<std::pair<rendering::Camera*, std::shared_ptr<scene::SceneObject>>> mSceneObjectsWithDeferredRendering;
+    ShaderUniformBlocks mShaderUniformBlocks;
+    GpuProfiler mGpuProfiler;
     std::vector<std::reference_wrapper<scene::Scene>> mCachedScenes;
 };
 
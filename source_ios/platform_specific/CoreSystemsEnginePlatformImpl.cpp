@@ -15,8 +15,13 @@
 #include <engine/sound/SoundManager.h>
 #include <engine/scene/SceneManager.h>
 #include <engine/scene/Scene.h>
+#include <engine/utils/BaseDataFileSerializer.h>
+#include <engine/utils/Benchmark.h>
+#include <engine/utils/FrameTiming.h>
+#include <engine/utils/JobSystem.h>
 #include <engine/utils/Logging.h>
 #include <engine/utils/OSMessageBox.h>
+#include <engine/utils/Profiling.h>
 #include <platform_specific/InputStateManagerPlatformImpl.h>
 #include <platform_specific/IOSUtils.h>
 #include <platform_specific/RendererPlatformImpl.h>
@@ -30,6 +35,8 @@ static constexpr int DEFAULT_WINDOW_HEIGHT = 780;
 static constexpr int MIN_WINDOW_WIDTH      = 844;
 static constexpr int MIN_WINDOW_HEIGHT     = 390;
 static constexpr int TARGET_GAME_LOGIC_FPS = 60;
+static constexpr int MAX_LOGIC_STEPS_PER_FRAME = 4;
+static constexpr bool FIXED_TIMESTEP = false;
 
 ///------------------------------------------------------------------------------------------------
 
@@ -48,6 +55,9 @@ struct CoreSystemsEngine::SystemsImpl
     scene::SceneManager mSceneManager;
     resources::ResourceLoadingService mResourceLoadingService;
     sound::SoundManager mSoundManager;
+    
+    // Last, so that its workers are joined before any of the systems their jobs use are destroyed
+    jobs::JobSystem mJobSystem;
 };
 
 ///------------------------------------------------------------------------------------------------
@@ -108,7 +118,7 @@ void CoreSystemsEngine::Initialize()
 
     // Systems Initialization
     mSystems = std::make_unique<SystemsImpl>();
-    mSystems->mResourceLoadingService.Initialize();
+    mSystems->mResourceLoadingService.Initialize(mSystems->mJobSystem);
     mSystems->mSoundManager.Initialize();
     
     // Enable texture blending
@@ -122,10 +132,10 @@ void CoreSystemsEngine::Initialize()
     int maxTextureSize;
     GL_CALL(glGetIntegerv(GL_MAX_TEXTURE_SIZE, &maxTextureSize));
     
-    logging::Log(logging::LogType::INFO, "Vendor       : %s", GL_NO_CHECK_CALL(glGetString(GL_VENDOR)));
-    logging::Log(logging::LogType::INFO, "Renderer     : %s", GL_NO_CHECK_CALL(glGetString(GL_RENDERER)));
-    logging::Log(logging::LogType::INFO, "Version      : %s", GL_NO_CHECK_CALL(glGetString(GL_VERSION)));
-    logging::Log(logging::LogType::INFO, "Max Tex Size : %d", maxTextureSize);
+    LOG(logging::LogType::INFO, "Vendor       : %s", GL_NO_CHECK_CALL(glGetString(GL_VENDOR)));
+    LOG(logging::LogType::INFO, "Renderer     : %s", GL_NO_CHECK_CALL(glGetString(GL_RENDERER)));
+    LOG(logging::LogType::INFO, "Version      : %s", GL_NO_CHECK_CALL(glGetString(GL_VERSION)));
+    LOG(logging::LogType::INFO, "Max Tex Size : %d", maxTextureSize);
     
     mInitialized = true;
 }
@@ -140,7 +150,7 @@ void CoreSystemsEngine::Start(std::function<void()> clientInitFunction, std::fun
     
     //While application is running
     SDL_Event event;
-    auto lastFrameMillisSinceInit = 0.0f;
+    auto lastFrameNanos           = profiling::GetNowNanos();
     auto secsAccumulator          = 0.0f;
     auto framesAccumulator        = 0LL;
     
@@ -150,6 +160,8 @@ void CoreSystemsEngine::Start(std::function<void()> clientInitFunction, std::fun
     const int refreshRate = rendering::GetDisplayRefreshRate();
     const float targetFpsMillis = 1000.0f / refreshRate;
     
+    timing::FixedTimestepAccumulator fixedTimestepAccumulator(1000.0f/TARGET_GAME_LOGIC_FPS, MAX_LOGIC_STEPS_PER_FRAME);
+    
     while(!shouldQuit)
     {
         bool windowSizeChanged = false;
@@ -158,9 +170,10 @@ void CoreSystemsEngine::Start(std::function<void()> clientInitFunction, std::fun
         
         // Calculate frame delta
         const auto currentMillisSinceInit = static_cast<float>(SDL_GetTicks());  // the number of milliseconds since the SDL library
-        const auto dtMillis = currentMillisSinceInit - lastFrameMillisSinceInit; // millis diff between current and last frame
+        const auto currentFrameNanos = profiling::GetNowNanos();
+        const auto dtMillis = (currentFrameNanos - lastFrameNanos)/1000000.0f;   // millis diff between current and last frame
         
-        lastFrameMillisSinceInit = currentMillisSinceInit;
+        lastFrameNanos = currentFrameNanos;
         framesAccumulator++;
         secsAccumulator += dtMillis * 0.001f; // dt in seconds;
         
@@ -172,6 +185,11 @@ void CoreSystemsEngine::Start(std::function<void()> clientInitFunction, std::fun
             if (applicationMovedToBackground)
             {
                 clientApplicationMovedToBackgroundFunction();
+                
+                // The app can be suspended any time from here on, and the frame loop (which uploads landed writes) is paused
+                serial::BaseDataFileSerializer::WaitForPendingWrites();
+                serial::BaseDataFileSerializer::Update();
+                
                 pausedExecution = true;
                 mSystems->mSoundManager.PauseAudio();
             }
@@ -197,11 +215,21 @@ void CoreSystemsEngine::Start(std::function<void()> clientInitFunction, std::fun
         
         mSystems->mResourceLoadingService.Update();
         mSystems->mSoundManager.Update(dtMillis);
+        serial::BaseDataFileSerializer::Update();
         
-        float gameLogicMillis = math::Max(16.0f, math::Min(32.0f, dtMillis)) * (TARGET_GAME_LOGIC_FPS/static_cast<float>(refreshRate));
+        // In fixed timestep mode logic runs in whole fixed length steps, as many as the frame's time accounts for,
+        // and renders interpolate transforms between the last two steps. Otherwise each frame runs a single,
+        // clamped, variable length step.
+        auto logicStepCount = 1;
+        auto gameLogicMillis = math::Max(16.0f, math::Min(32.0f, dtMillis)) * (TARGET_GAME_LOGIC_FPS/static_cast<float>(refreshRate));
+        if (FIXED_TIMESTEP)
+        {
+            logicStepCount = fixedTimestepAccumulator.Advance(dtMillis);
+            gameLogicMillis = fixedTimestepAccumulator.GetStepMillis();
+        }
         if (secsAccumulator > 1.0f)
         {
-            logging::Log(logging::LogType::INFO, "FPS: %d", framesAccumulator);
+            LOG(logging::LogType::INFO, "FPS: %d", framesAccumulator);
             framesAccumulator = 0;
             secsAccumulator -= 1.0f;
             
@@ -210,35 +238,66 @@ void CoreSystemsEngine::Start(std::function<void()> clientInitFunction, std::fun
             
             clientOnOneSecondElapsedFunction();
         }
-  
-        mSystems->mAnimationManager.Update(gameLogicMillis);
-        clientUpdateFunction(gameLogicMillis);
-        mSystems->mInputStateManager.VUpdate();
         
-        for (auto& scene: mSystems->mSceneManager.GetScenes())
+        for (int i = 0; i < logicStepCount; ++i)
         {
-            if (scene->IsLoaded())
+            if (FIXED_TIMESTEP)
+            {
+                for (auto& scene: mSystems->mSceneManager.GetScenes())
+                {
+                    scene->CaptureSceneObjectTransforms();
+                }
+            }
+            
+            mSystems->mAnimationManager.Update(gameLogicMillis);
+            clientUpdateFunction(gameLogicMillis);
+            
+            // Only the first step of a frame sees its taps (and frames without steps keep them for the next one)
+            mSystems->mInputStateManager.VUpdate();
+        
+            for (auto& scene: mSystems->mSceneManager.GetScenes())
             {
-                if (scene->GetUpdateTimeSpeedFactor() >= 1.0f)
+                if (scene->IsLoaded() && scene->GetUpdateTimeSpeedFactor() >= 1.0f)
                 {
                     scene->GetCamera().Update(gameLogicMillis * scene->GetUpdateTimeSpeedFactor());
                 }
-                mSystems->mParticleManager.UpdateSceneParticles(gameLogicMillis * scene->GetUpdateTimeSpeedFactor(), *scene);
-                mSystems->mSceneManager.SortSceneObjects(scene);
             }
+        
+            mSystems->mParticleManager.UpdateScenesParticles(gameLogicMillis, mSystems->mSceneManager.GetScenes(), mSystems->mJobSystem);
         }
         
+        // Scenes are sorted in parallel, and all of them are done before any is rendered
+        const auto& scenes = mSystems->mSceneManager.GetScenes();
+        mSystems->mJobSystem.ParallelFor(static_cast<int>(scenes.size()), [&](const int sceneIndex)
+        {
+            if (scenes[sceneIndex]->IsLoaded())
+            {
+                mSystems->mSceneManager.SortSceneObjects(scenes[sceneIndex]);
+            }
+        });
+        
         mSystems->mRenderer.VBeginRenderPass();
         
         for (auto& scene: mSystems->mSceneManager.GetScenes())
         {
             if (scene->IsLoaded())
             {
+                if (FIXED_TIMESTEP)
+                {
+                    scene->ApplyInterpolatedSceneObjectTransforms(fixedTimestepAccumulator.GetInterpolationAlpha());
+                }
+                
                 mSystems->mRenderer.VRenderScene(*scene);
             }
         }
         
         mSystems->mRenderer.VEndRenderPass();
+        benchmark::RecordRenderedFrame();
+        
+        for (auto& scene: mSystems->mSceneManager.GetScenes())
+        {
+            scene->RestoreSceneObjectTransforms();
+        }
         
         auto frameEndMillisDiff = static_cast<float>(SDL_GetTicks()) - currentMillisSinceInit;
         if (frameEndMillisDiff < targetFpsMillis)
@@ -246,6 +305,18 @@ void CoreSystemsEngine::Start(std::function<void()> clientInitFunction, std::fun
             SDL_Delay(targetFpsMillis - frameEndMillisDiff);
         }
     }
+    
+    serial::BaseDataFileSerializer::Shutdown();
+}
+
+///------------------------------------------------------------------------------------------------
+
+void CoreSystemsEngine::SetHeadlessMode(const HeadlessMode headlessMode, const int)
+{
+    if (headlessMode != HeadlessMode::NONE)
+    {
+        LOG(logging::LogType::WARNING, "Headless mode is not supported on iOS");
+    }
 }
 
 ///------------------------------------------------------------------------------------------------
@@ -313,6 +384,13 @@ sound::SoundManager& CoreSystemsEngine::GetSoundManager()
 
 ///------------------------------------------------------------------------------------------------
 
+jobs::JobSystem& CoreSystemsEngine::GetJobSystem()
+{
+    return mSystems->mJobSystem;
+}
+
+///------------------------------------------------------------------------------------------------
+
 float CoreSystemsEngine::GetDefaultAspectRatio() const
 {
     return static_cast<float>(DEFAULT_WINDOW_WIDTH)/DEFAULT_WINDOW_HEIGHT;
@@ -8,12 +8,14 @@
 #include <engine/CoreSystemsEngine.h>
 #include <engine/rendering/Fonts.h>
 #include <engine/rendering/OpenGL.h>
+#include <engine/rendering/ShaderUniformBlocks.h>
 #include <engine/resloading/MeshResource.h>
 #include <engine/resloading/ResourceLoadingService.h>
 #include <engine/resloading/ShaderResource.h>
 #include <engine/resloading/TextureResource.h>
 #include <engine/scene/Scene.h>
 #include <engine/scene/SceneObject.h>
+#include <engine/scene/SceneObjectUtils.h>
 #include <engine/utils/Logging.h>
 #include <engine/utils/StringUtils.h>
 #include <imgui/backends/imgui_impl_sdl2.h>
@@ -32,8 +34,6 @@ namespace rendering
 ///------------------------------------------------------------------------------------------------
 
 static const strutils::StringId WORLD_MATRIX_UNIFORM_NAME = strutils::StringId("world");
-static const strutils::StringId VIEW_MATRIX_UNIFORM_NAME  = strutils::StringId("view");
-static const strutils::StringId PROJ_MATRIX_UNIFORM_NAME  = strutils::StringId("proj");
 static const strutils::StringId MIN_U_UNIFORM_NAME = strutils::StringId("min_u");
 static const strutils::StringId MIN_V_UNIFORM_NAME = strutils::StringId("min_v");
 static const strutils::StringId MAX_U_UNIFORM_NAME = strutils::StringId("max_u");
@@ -48,6 +48,17 @@ static const strutils::StringId CUSTOM_ALPHA_UNIFORM_NAME = strutils::StringId("
 static const strutils::StringId ROT_MATRIX_UNIFORM_NAME  = strutils::StringId("rot");
 static const strutils::StringId IS_AFFECTED_BY_LIGHT_UNIFORM_NAME = strutils::StringId("affected_by_light");
 
+// Resolved once, so that the per draw uniform uploads below never look up uniform names
+static const ShaderUniformIndex WORLD_MATRIX_UNIFORM_INDEX = GetShaderUniformIndex(WORLD_MATRIX_UNIFORM_NAME);
+static const ShaderUniformIndex ROT_MATRIX_UNIFORM_INDEX = GetShaderUniformIndex(ROT_MATRIX_UNIFORM_NAME);
+static const ShaderUniformIndex MIN_U_UNIFORM_INDEX = GetShaderUniformIndex(MIN_U_UNIFORM_NAME);
+static const ShaderUniformIndex MIN_V_UNIFORM_INDEX = GetShaderUniformIndex(MIN_V_UNIFORM_NAME);
+static const ShaderUniformIndex MAX_U_UNIFORM_INDEX = GetShaderUniformIndex(MAX_U_UNIFORM_NAME);
+static const ShaderUniformIndex MAX_V_UNIFORM_INDEX = GetShaderUniformIndex(MAX_V_UNIFORM_NAME);
+static const ShaderUniformIndex IS_TEXTURE_SHEET_UNIFORM_INDEX = GetShaderUniformIndex(IS_TEXTURE_SHEET_UNIFORM_NAME);
+static const ShaderUniformIndex CUSTOM_ALPHA_UNIFORM_INDEX = GetShaderUniformIndex(CUSTOM_ALPHA_UNIFORM_NAME);
+static const ShaderUniformIndex IS_AFFECTED_BY_LIGHT_UNIFORM_INDEX = GetShaderUniformIndex(IS_AFFECTED_BY_LIGHT_UNIFORM_NAME);
+
 static const glm::ivec4 RENDER_TO_TEXTURE_VIEWPORT = {-1536, -1024, 4096, 4096};
 static const glm::vec4 RENDER_TO_TEXTURE_CLEAR_COLOR = {1.0f, 1.0f, 1.0f, 0.0f};
 
@@ -56,9 +67,8 @@ static const glm::vec4 RENDER_TO_TEXTURE_CLEAR_COLOR = {1.0f, 1.0f, 1.0f, 0.0f};
 class SceneObjectTypeRendererVisitor
 {
 public:
-    SceneObjectTypeRendererVisitor(const scene::SceneObject& sceneObject, const Camera& camera)
+    SceneObjectTypeRendererVisitor(const scene::SceneObject& sceneObject)
     : mSceneObject(sceneObject)
-    , mCamera(camera)
     {
     }
     
@@ -69,10 +79,7 @@ public:
         auto* currentShader = &(resService.GetResource<resources::ShaderResource>(mSceneObject.mShaderResourceId));
         GL_CALL(glUseProgram(currentShader->GetProgramId()));
         
-        for (size_t i = 0; i < currentShader->GetUniformSamplerNames().size(); ++i)
-        {
-            currentShader->SetInt(currentShader->GetUniformSamplerNames().at(i), static_cast<int>(i));
-        }
+        currentShader->SetUniformSamplerTextureUnits();
         
         auto* currentMesh = &(resService.GetResource<resources::MeshResource>(mSceneObject.mMeshResourceId));
         GL_CALL(glBindVertexArray(currentMesh->GetVertexArrayObject()));
@@ -100,18 +107,16 @@ public:
         world *= rot;
         world = glm::scale(world, mSceneObject.mScale);
         
-        currentShader->SetFloat(CUSTOM_ALPHA_UNIFORM_NAME, 1.0f);
-        currentShader->SetBool(IS_AFFECTED_BY_LIGHT_UNIFORM_NAME, mSceneObject.mShaderBoolUniformValues.count(IS_AFFECTED_BY_LIGHT_UNIFORM_NAME) ? mSceneObject.mShaderBoolUniformValues.at(IS_AFFECTED_BY_LIGHT_UNIFORM_NAME) : false);
-        currentShader->SetBool(IS_TEXTURE_SHEET_UNIFORM_NAME, false);
-        currentShader->SetMatrix4fv(WORLD_MATRIX_UNIFORM_NAME, world);
-        currentShader->SetMatrix4fv(VIEW_MATRIX_UNIFORM_NAME, mCamera.GetViewMatrix());
-        currentShader->SetMatrix4fv(PROJ_MATRIX_UNIFORM_NAME, mCamera.GetProjMatrix());
-        currentShader->SetMatrix4fv(ROT_MATRIX_UNIFORM_NAME, rot);
+        currentShader->SetFloat(CUSTOM_ALPHA_UNIFORM_INDEX, 1.0f);
+        currentShader->SetBool(IS_AFFECTED_BY_LIGHT_UNIFORM_INDEX, mSceneObject.mShaderBoolUniformValues.count(IS_AFFECTED_BY_LIGHT_UNIFORM_NAME) ? mSceneObject.mShaderBoolUniformValues.at(IS_AFFECTED_BY_LIGHT_UNIFORM_NAME) : false);
+        currentShader->SetBool(IS_TEXTURE_SHEET_UNIFORM_INDEX, false);
+        currentShader->SetMatrix4fv(WORLD_MATRIX_UNIFORM_INDEX, world);
+        currentShader->SetMatrix4fv(ROT_MATRIX_UNIFORM_INDEX, rot);
         
-        for (const auto& vec3Entry: mSceneObject.mShaderVec3UniformValues) currentShader->SetFloatVec3(vec3Entry.first, vec3Entry.second);
-        for (const auto& floatEntry: mSceneObject.mShaderFloatUniformValues) currentShader->SetFloat(floatEntry.first, floatEntry.second);
-        for (const auto& intEntry: mSceneObject.mShaderIntUniformValues) currentShader->SetInt(intEntry.first, intEntry.second);
-        for (const auto& boolEntry: mSceneObject.mShaderBoolUniformValues) currentShader->SetBool(boolEntry.first, boolEntry.second);
+        currentShader->SetUniformValues(mSceneObject.mShaderVec3UniformValues);
+        currentShader->SetUniformValues(mSceneObject.mShaderFloatUniformValues);
+        currentShader->SetUniformValues(mSceneObject.mShaderIntUniformValues);
+        currentShader->SetUniformValues(mSceneObject.mShaderBoolUniformValues);
         
         GL_CALL(glDrawElements(GL_TRIANGLES, currentMesh->GetElementCount(), GL_UNSIGNED_SHORT, (void*)0));
         GL_CALL(glBindVertexArray(0));
@@ -124,10 +129,7 @@ public:
         auto* currentShader = &(resService.GetResource<resources::ShaderResource>(mSceneObject.mShaderResourceId));
         GL_CALL(glUseProgram(currentShader->GetProgramId()));
         
-        for (size_t i = 0; i < currentShader->GetUniformSamplerNames().size(); ++i)
-        {
-            currentShader->SetInt(currentShader->GetUniformSamplerNames().at(i), static_cast<int>(i));
-        }
+        currentShader->SetUniformSamplerTextureUnits();
         
         auto* currentMesh = &(resService.GetResource<resources::MeshResource>(mSceneObject.mMeshResourceId));
         GL_CALL(glBindVertexArray(currentMesh->GetVertexArrayObject()));
@@ -162,20 +164,18 @@ public:
             world = glm::translate(world, glm::vec3(targetX, targetY, mSceneObject.mPosition.z));
             world = glm::scale(world, glm::vec3(glyph.mWidthPixels * mSceneObject.mScale.x, glyph.mHeightPixels * mSceneObject.mScale.y, 1.0f));
             
-            currentShader->SetFloat(CUSTOM_ALPHA_UNIFORM_NAME, 1.0f);
-            currentShader->SetBool(IS_TEXTURE_SHEET_UNIFORM_NAME, true);
-            currentShader->SetFloat(MIN_U_UNIFORM_NAME, glyph.minU);
-            currentShader->SetFloat(MIN_V_UNIFORM_NAME, glyph.minV);
-            currentShader->SetFloat(MAX_U_UNIFORM_NAME, glyph.maxU);
-            currentShader->SetFloat(MAX_V_UNIFORM_NAME, glyph.maxV);
-            currentShader->SetMatrix4fv(WORLD_MATRIX_UNIFORM_NAME, world);
-            currentShader->SetMatrix4fv(VIEW_MATRIX_UNIFORM_NAME, mCamera.GetViewMatrix());
-            currentShader->SetMatrix4fv(PROJ_MATRIX_UNIFORM_NAME, mCamera.GetProjMatrix());
+            currentShader->SetFloat(CUSTOM_ALPHA_UNIFORM_INDEX, 1.0f);
+            currentShader->SetBool(IS_TEXTURE_SHEET_UNIFORM_INDEX, true);
+            currentShader->SetFloat(MIN_U_UNIFORM_INDEX, glyph.minU);
+            currentShader->SetFloat(MIN_V_UNIFORM_INDEX, glyph.minV);
+            currentShader->SetFloat(MAX_U_UNIFORM_INDEX, glyph.maxU);
+            currentShader->SetFloat(MAX_V_UNIFORM_INDEX, glyph.maxV);
+            currentShader->SetMatrix4fv(WORLD_MATRIX_UNIFORM_INDEX, world);
             
-            for (const auto& vec3Entry: mSceneObject.mShaderVec3UniformValues) currentShader->SetFloatVec3(vec3Entry.first, vec3Entry.second);
-            for (const auto& floatEntry: mSceneObject.mShaderFloatUniformValues) currentShader->SetFloat(floatEntry.first, floatEntry.second);
-            for (const auto& intEntry: mSceneObject.mShaderIntUniformValues) currentShader->SetInt(intEntry.first, intEntry.second);
-            for (const auto& boolEntry: mSceneObject.mShaderBoolUniformValues) currentShader->SetBool(boolEntry.first, boolEntry.second);
+            currentShader->SetUniformValues(mSceneObject.mShaderVec3UniformValues);
+            currentShader->SetUniformValues(mSceneObject.mShaderFloatUniformValues);
+            currentShader->SetUniformValues(mSceneObject.mShaderIntUniformValues);
+            currentShader->SetUniformValues(mSceneObject.mShaderBoolUniformValues);
             
             GL_CALL(glDrawElements(GL_TRIANGLES, currentMesh->GetElementCount(), GL_UNSIGNED_SHORT, (void*)0));
             
@@ -199,10 +199,7 @@ public:
         auto* currentShader = &(resService.GetResource<resources::ShaderResource>(mSceneObject.mShaderResourceId));
         GL_CALL(glUseProgram(currentShader->GetProgramId()));
         
-        for (size_t i = 0; i < currentShader->GetUniformSamplerNames().size(); ++i)
-        {
-            currentShader->SetInt(currentShader->GetUniformSamplerNames().at(i), static_cast<int>(i));
-        }
+        currentShader->SetUniformSamplerTextureUnits();
         
         auto* currentTexture = &(resService.GetResource<resources::TextureResource>(mSceneObject.mTextureResourceId));
         GL_CALL(glActiveTexture(GL_TEXTURE0));
@@ -218,14 +215,12 @@ public:
             }
         }
         
-        currentShader->SetFloat(CUSTOM_ALPHA_UNIFORM_NAME, 1.0f);
-        currentShader->SetMatrix4fv(VIEW_MATRIX_UNIFORM_NAME, mCamera.GetViewMatrix());
-        currentShader->SetMatrix4fv(PROJ_MATRIX_UNIFORM_NAME, mCamera.GetProjMatrix());
+        currentShader->SetFloat(CUSTOM_ALPHA_UNIFORM_INDEX, 1.0f);
         
-        for (const auto& vec3Entry: mSceneObject.mShaderVec3UniformValues) currentShader->SetFloatVec3(vec3Entry.first, vec3Entry.second);
-        for (const auto& floatEntry: mSceneObject.mShaderFloatUniformValues) currentShader->SetFloat(floatEntry.first, floatEntry.second);
-        for (const auto& intEntry: mSceneObject.mShaderIntUniformValues) currentShader->SetInt(intEntry.first, intEntry.second);
-        for (const auto& boolEntry: mSceneObject.mShaderBoolUniformValues) currentShader->SetBool(boolEntry.first, boolEntry.second);
+        currentShader->SetUniformValues(mSceneObject.mShaderVec3UniformValues);
+        currentShader->SetUniformValues(mSceneObject.mShaderFloatUniformValues);
+        currentShader->SetUniformValues(mSceneObject.mShaderIntUniformValues);
+        currentShader->SetUniformValues(mSceneObject.mShaderBoolUniformValues);
         
         GL_CALL(glBindVertexArray(particleEmitterData.mParticleVertexArrayObject));
         
@@ -294,7 +289,6 @@ public:
     
 private:
     const scene::SceneObject& mSceneObject;
-    const Camera& mCamera;
 };
 
 ///------------------------------------------------------------------------------------------------
@@ -324,15 +318,19 @@ void RendererPlatformImpl::VBeginRenderPass()
 
 void RendererPlatformImpl::VRenderScene(scene::Scene& scene)
 {
+    const auto frustum = scene.GetCamera().CalculateFrustum();
+    mShaderUniformBlocks.UpdatePerSceneData(scene.GetCamera());
+    
     for (const auto& sceneObject: scene.GetSceneObjects())
     {
         if (sceneObject->mInvisible) continue;
+        if (scene_object_utils::IsSceneObjectOutsideOfFrustum(*sceneObject, frustum)) continue;
         if (sceneObject->mDeferredRendering)
         {
             mSceneObjectsWithDeferredRendering.push_back(std::make_pair(&scene.GetCamera(), sceneObject));
             continue;
         }
-        std::visit(SceneObjectTypeRendererVisitor(*sceneObject, scene.GetCamera()), sceneObject->mSceneObjectTypeData);
+        std::visit(SceneObjectTypeRendererVisitor(*sceneObject), sceneObject->mSceneObjectTypeData);
     }
 }
 
@@ -366,9 +364,11 @@ void RendererPlatformImpl::VRenderSceneObjectsToTexture(const std::vector<std::s
     
     GL_CALL(glDisable(GL_CULL_FACE));
     
+    mShaderUniformBlocks.UpdatePerSceneData(camera);
+    
     for (auto sceneObject: sceneObjects)
     {
-        std::visit(SceneObjectTypeRendererVisitor(*sceneObject, camera), sceneObject->mSceneObjectTypeData);
+        std::visit(SceneObjectTypeRendererVisitor(*sceneObject), sceneObject->mSceneObjectTypeData);
     }
     
     const_cast<rendering::Camera&>(camera).SetPosition(originalPosition);
@@ -381,7 +381,8 @@ void RendererPlatformImpl::VEndRenderPass()
 {
     for (const auto& sceneObjectEntry: mSceneObjectsWithDeferredRendering)
     {
-        std::visit(SceneObjectTypeRendererVisitor(*sceneObjectEntry.second, *sceneObjectEntry.first), sceneObjectEntry.second->mSceneObjectTypeData);
+        mShaderUniformBlocks.UpdatePerSceneData(*sceneObjectEntry.first);
+        std::visit(SceneObjectTypeRendererVisitor(*sceneObjectEntry.second), sceneObjectEntry.second->mSceneObjectTypeData);
     }
     
     // Swap window buffers
@@ -11,6 +11,7 @@
 ///------------------------------------------------------------------------------------------------
 
 #include <engine/rendering/IRenderer.h>
+#include <engine/rendering/ShaderUniformBlocks.h>
 #include <engine/CoreSystemsEngine.h>
 #include <functional>
 #include <memory>
@@ -37,6 +38,7 @@ private:
     
 private:
     std::vector<std::pair<rendering::Camera*, std::shared_ptr<scene::SceneObject>>> mSceneObjectsWithDeferredRendering;
+    ShaderUniformBlocks mShaderUniformBlocks;
 };
 
 ///------------------------------------------------------------------------------------------------
@@ -0,0 +1,259 @@
+///------------------------------------------------------------------------------------------------
+///  AnimationManagerTest.cpp
+///  Predators
+///
+///  Created by Alex Koukoulas on 18/04/2024
+///------------------------------------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+#include <engine/rendering/AnimationManager.h>
+#include <engine/scene/SceneObject.h>
+#include <engine/utils/Logging.h>
+#include <game/GameConstants.h>
+#include <chrono>
+#include <memory>
+#include <vector>
+
+///------------------------------------------------------------------------------------------------
+
+static const strutils::StringId TEST_ANIMATION_NAME = strutils::StringId("test_animation");
+static const strutils::StringId OTHER_ANIMATION_NAME = strutils::StringId("other_animation");
+
+static constexpr int BENCHMARK_ANIMATION_COUNT = 500;
+static constexpr int BENCHMARK_ITERATIONS = 100;
+static constexpr int BENCHMARK_TWEEN_UPDATE_COUNT = 60;
+
+///------------------------------------------------------------------------------------------------
+
+TEST(AnimationManagerTests, TestHandlesAreInvalidatedOnStopAndFinish)
+{
+    rendering::AnimationManager animationManager;
+
+    auto stoppedHandle = animationManager.StartAnimation(std::make_unique<rendering::TimeDelayAnimation>(1.0f), [](){});
+    auto finishedHandle = animationManager.StartAnimation(std::make_unique<rendering::TimeDelayAnimation>(0.1f), [](){});
+    EXPECT_TRUE(animationManager.IsAnimationPlaying(stoppedHandle));
+    EXPECT_TRUE(animationManager.IsAnimationPlaying(finishedHandle));
+
+    animationManager.StopAnimation(stoppedHandle);
+    EXPECT_FALSE(animationManager.IsAnimationPlaying(stoppedHandle));
+    EXPECT_EQ(animationManager.GetAnimationsPlayingCount(), 1);
+
+    animationManager.Update(200.0f);
+    EXPECT_FALSE(animationManager.IsAnimationPlaying(finishedHandle));
+    EXPECT_EQ(animationManager.GetAnimationsPlayingCount(), 0);
+
+    // Recycled slots must not revive stale handles
+    auto newHandle = animationManager.StartAnimation(std::make_unique<rendering::TimeDelayAnimation>(1.0f), [](){});
+    EXPECT_TRUE(animationManager.IsAnimationPlaying(newHandle));
+    EXPECT_FALSE(animationManager.IsAnimationPlaying(stoppedHandle));
+    EXPECT_FALSE(animationManager.IsAnimationPlaying(finishedHandle));
+
+    animationManager.StopAnimation(stoppedHandle);
+    EXPECT_TRUE(animationManager.IsAnimationPlaying(newHandle));
+}
+
+TEST(AnimationManagerTests, TestStopByNameStopsFirstStartedAnimation)
+{
+    rendering::AnimationManager animationManager;
+
+    float firstValue = 0.0f;
+    float secondValue = 0.0f;
+    auto firstHandle = animationManager.StartAnimation(std::make_unique<rendering::TweenValueAnimation>(firstValue, 1.0f, 1.0f), [](){}, TEST_ANIMATION_NAME);
+    auto secondHandle = animationManager.StartAnimation(std::make_unique<rendering::TweenValueAnimation>(secondValue, 1.0f, 1.0f), [](){}, TEST_ANIMATION_NAME);
+    animationManager.StartAnimation(std::make_unique<rendering::TimeDelayAnimation>(1.0f), [](){}, OTHER_ANIMATION_NAME);
+
+    EXPECT_EQ(animationManager.GetAnimationCountPlayingWithName(TEST_ANIMATION_NAME), 2);
+
+    animationManager.StopAnimation(TEST_ANIMATION_NAME);
+    EXPECT_FALSE(animationManager.IsAnimationPlaying(firstHandle));
+    EXPECT_TRUE(animationManager.IsAnimationPlaying(secondHandle));
+    EXPECT_TRUE(animationManager.IsAnimationPlaying(TEST_ANIMATION_NAME));
+    EXPECT_EQ(animationManager.GetAnimationCountPlayingWithName(TEST_ANIMATION_NAME), 1);
+
+    animationManager.Update(500.0f);
+    EXPECT_FLOAT_EQ(firstValue, 0.0f);
+    EXPECT_FLOAT_EQ(secondValue, 0.5f);
+
+    animationManager.StopAnimation(TEST_ANIMATION_NAME);
+    EXPECT_FALSE(animationManager.IsAnimationPlaying(TEST_ANIMATION_NAME));
+    EXPECT_TRUE(animationManager.IsAnimationPlaying(OTHER_ANIMATION_NAME));
+}
+
+TEST(AnimationManagerTests, TestCompletionCallbacksFireInStartOrder)
+{
+    rendering::AnimationManager animationManager;
+    std::vector<int> completionOrder;
+
+    for (int i = 0; i < 10; ++i)
+    {
+        animationManager.StartAnimation(std::make_unique<rendering::TimeDelayAnimation>(0.1f), [&, i](){ completionOrder.push_back(i); });
+
+        // Punch holes in the slot storage to exercise slot reuse
+        if (i % 3 == 0)
+        {
+            animationManager.StopAnimation(animationManager.StartAnimation(std::make_unique<rendering::TimeDelayAnimation>(0.1f), [&](){ completionOrder.push_back(-1); }));
+        }
+    }
+
+    animationManager.Update(200.0f);
+    EXPECT_EQ(completionOrder, std::vector<int>({0, 1, 2, 3, 4, 5, 6, 7, 8, 9}));
+}
+
+TEST(AnimationManagerTests, TestAnimationsStartedFromCallbacksBeginOnNextUpdate)
+{
+    rendering::AnimationManager animationManager;
+
+    float value = 0.0f;
+    rendering::AnimationHandle chainedHandle;
+    animationManager.StartAnimation(std::make_unique<rendering::TimeDelayAnimation>(0.1f), [&]()
+    {
+        chainedHandle = animationManager.StartAnimation(std::make_unique<rendering::TweenValueAnimation>(value, 1.0f, 1.0f), [](){}, TEST_ANIMATION_NAME);
+    });
+
+    animationManager.Update(200.0f);
+    EXPECT_TRUE(animationManager.IsAnimationPlaying(chainedHandle));
+    EXPECT_TRUE(animationManager.IsAnimationPlaying(TEST_ANIMATION_NAME));
+    EXPECT_EQ(animationManager.GetAnimationsPlayingCount(), 1);
+    EXPECT_FLOAT_EQ(value, 0.0f);
+
+    animationManager.Update(250.0f);
+    EXPECT_FLOAT_EQ(value, 0.25f);
+}
+
+TEST(AnimationManagerTests, TestStopAllAnimationsFromCallback)
+{
+    rendering::AnimationManager animationManager;
+
+    int completedCount = 0;
+    animationManager.StartAnimation(std::make_unique<rendering::TimeDelayAnimation>(0.1f), [&](){ completedCount++; animationManager.StopAllAnimations(); });
+    animationManager.StartAnimation(std::make_unique<rendering::TimeDelayAnimation>(0.1f), [&](){ completedCount++; });
+
+    animationManager.Update(200.0f);
+    EXPECT_EQ(completedCount, 1);
+    EXPECT_EQ(animationManager.GetAnimationsPlayingCount(), 0);
+
+    animationManager.StartAnimation(std::make_unique<rendering::TimeDelayAnimation>(1.0f), [](){});
+    animationManager.StopAllAnimations();
+    EXPECT_EQ(animationManager.GetAnimationsPlayingCount(), 0);
+}
+
+TEST(AnimationManagerTests, TestBatchedTweensMatchUnbatchedTweens)
+{
+    // Wrapping a built-in tweening function in a lambda keeps the tween on the unbatched (VUpdate) path
+    const std::vector<std::pair<std::function<float(const float)>, std::function<float(const float)>>> tweeningFunctions =
+    {
+        { math::LinearFunction, [](const float t){ return math::LinearFunction(t); } },
+        { math::QuadFunction, [](const float t){ return math::QuadFunction(t); } },
+        { math::BackFunction, [](const float t){ return math::BackFunction(t); } },
+        { math::BounceFunction, [](const float t){ return math::BounceFunction(t); } },
+        { math::ElasticFunction, [](const float t){ return math::ElasticFunction(t); } }
+    };
+    
+    for (const auto& tweeningFunctionPair: tweeningFunctions)
+    {
+        for (const auto tweeningMode: { math::TweeningMode::EASE_IN, math::TweeningMode::EASE_OUT, math::TweeningMode::EASE_IN_OUT })
+        {
+            rendering::AnimationManager animationManager;
+            std::shared_ptr<scene::SceneObject> sceneObjects[2] = { std::make_shared<scene::SceneObject>(), std::make_shared<scene::SceneObject>() };
+            float values[2] = { 1.0f, 1.0f };
+            int completedCount[2] = { 0, 0 };
+            
+            for (int i = 0; i < 2; ++i)
+            {
+                const auto& tweeningFunc = i == 0 ? tweeningFunctionPair.first : tweeningFunctionPair.second;
+                sceneObjects[i]->mPosition = glm::vec3(-1.0f, 2.0f, 0.5f);
+                sceneObjects[i]->mShaderFloatUniformValues[game_constants::CUSTOM_ALPHA_UNIFORM_NAME] = 0.0f;
+                
+                animationManager.StartAnimation(std::make_unique<rendering::TweenPositionScaleAnimation>(sceneObjects[i], glm::vec3(3.0f, -2.0f, 4.0f), glm::vec3(2.0f), 0.5f, animation_flags::IGNORE_Z_COMPONENT, 0.1f, tweeningFunc, tweeningMode), [&, i](){ completedCount[i]++; });
+                animationManager.StartAnimation(std::make_unique<rendering::TweenRotationAnimation>(sceneObjects[i], glm::vec3(0.0f, 0.0f, math::PI), 0.3f, animation_flags::NONE, 0.0f, tweeningFunc, tweeningMode), [&, i](){ completedCount[i]++; });
+                animationManager.StartAnimation(std::make_unique<rendering::TweenAlphaAnimation>(sceneObjects[i], 1.0f, 0.4f, animation_flags::NONE, 0.0f, tweeningFunc, tweeningMode), [&, i](){ completedCount[i]++; });
+                animationManager.StartAnimation(std::make_unique<rendering::TweenValueAnimation>(values[i], 5.0f, 0.2f, animation_flags::NONE, 0.05f, tweeningFunc, tweeningMode), [&, i](){ completedCount[i]++; });
+            }
+            
+            for (int update = 0; update < 40; ++update)
+            {
+                animationManager.Update(16.0f);
+                
+                for (int component = 0; component < 3; ++component)
+                {
+                    EXPECT_FLOAT_EQ(sceneObjects[0]->mPosition[component], sceneObjects[1]->mPosition[component]);
+                    EXPECT_FLOAT_EQ(sceneObjects[0]->mScale[component], sceneObjects[1]->mScale[component]);
+                    EXPECT_FLOAT_EQ(sceneObjects[0]->mRotation[component], sceneObjects[1]->mRotation[component]);
+                }
+                EXPECT_FLOAT_EQ(sceneObjects[0]->mShaderFloatUniformValues[game_constants::CUSTOM_ALPHA_UNIFORM_NAME], sceneObjects[1]->mShaderFloatUniformValues[game_constants::CUSTOM_ALPHA_UNIFORM_NAME]);
+                EXPECT_FLOAT_EQ(values[0], values[1]);
+                EXPECT_EQ(completedCount[0], completedCount[1]);
+            }
+            
+            EXPECT_EQ(completedCount[0], 4);
+            EXPECT_FLOAT_EQ(sceneObjects[0]->mPosition.z, 0.5f);
+            EXPECT_FLOAT_EQ(values[0], 5.0f);
+        }
+    }
+}
+
+// Benchmark only, run with --gtest_also_run_disabled_tests
+TEST(AnimationManagerTests, DISABLED_TestBatchedAndUnbatchedTweenUpdateTimes)
+{
+    const std::function<float(const float)> customQuadFunction = [](const float t){ return math::QuadFunction(t); };
+    
+    for (const auto& tweeningFunc: { std::function<float(const float)>(math::QuadFunction), customQuadFunction })
+    {
+        rendering::AnimationManager animationManager;
+        std::vector<std::shared_ptr<scene::SceneObject>> sceneObjects;
+        
+        for (int i = 0; i < BENCHMARK_ANIMATION_COUNT; ++i)
+        {
+            sceneObjects.push_back(std::make_shared<scene::SceneObject>());
+            animationManager.StartAnimation(std::make_unique<rendering::TweenPositionScaleAnimation>(sceneObjects.back(), glm::vec3(1.0f), glm::vec3(2.0f), 1000.0f, animation_flags::NONE, 0.0f, tweeningFunc), [](){});
+        }
+        
+        auto start = std::chrono::high_resolution_clock::now();
+        for (int i = 0; i < BENCHMARK_TWEEN_UPDATE_COUNT; ++i)
+        {
+            animationManager.Update(16.0f);
+        }
+        auto micros = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::high_resolution_clock::now() - start).count()/static_cast<float>(BENCHMARK_TWEEN_UPDATE_COUNT);
+        
+        LOG(logging::LogType::INFO, "Updated %d %s position/scale tweens in %.1fus", BENCHMARK_ANIMATION_COUNT, tweeningFunc.target<float(*)(const float)>() ? "batched" : "unbatched", micros);
+    }
+}
+
+// Benchmark only, run with --gtest_also_run_disabled_tests
+TEST(AnimationManagerTests, DISABLED_TestStartAndStopTimesForManyTweens)
+{
+    rendering::AnimationManager animationManager;
+    std::vector<float> values(BENCHMARK_ANIMATION_COUNT);
+    std::vector<rendering::AnimationHandle> handles(BENCHMARK_ANIMATION_COUNT);
+
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int iteration = 0; iteration < BENCHMARK_ITERATIONS; ++iteration)
+    {
+        for (int i = 0; i < BENCHMARK_ANIMATION_COUNT; ++i)
+        {
+            handles[i] = animationManager.StartAnimation(std::make_unique<rendering::TweenValueAnimation>(values[i], 1.0f, 1.0f), [](){}, i % 2 == 0 ? TEST_ANIMATION_NAME : OTHER_ANIMATION_NAME);
+        }
+
+        animationManager.Update(16.0f);
+
+        for (int i = 0; i < BENCHMARK_ANIMATION_COUNT; ++i)
+        {
+            if (i % 2 == 0)
+            {
+                animationManager.StopAnimation(TEST_ANIMATION_NAME);
+            }
+            else
+            {
+                animationManager.StopAnimation(handles[i]);
+            }
+        }
+
+        animationManager.Update(16.0f);
+        EXPECT_EQ(animationManager.GetAnimationsPlayingCount(), 0);
+    }
+    auto micros = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::high_resolution_clock::now() - start).count()/static_cast<float>(BENCHMARK_ITERATIONS);
+
+    LOG(logging::LogType::INFO, "Started, updated and stopped %d tweens in %.1fus", BENCHMARK_ANIMATION_COUNT, micros);
+}
+
+///------------------------------------------------------------------------------------------------
@@ -0,0 +1,164 @@
+///------------------------------------------------------------------------------------------------
+///  CommandRecordingRendererTest.cpp
+///  Predators
+///
+///  Created by Alex Koukoulas on 25/04/2024
+///------------------------------------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+#include <engine/rendering/CommandRecordingRenderer.h>
+#include <engine/scene/Scene.h>
+#include <engine/scene/SceneObject.h>
+
+///------------------------------------------------------------------------------------------------
+
+static const strutils::StringId TEST_SCENE_NAME = strutils::StringId("command_recording_test_scene");
+static const strutils::StringId UNLOADED_FONT_NAME = strutils::StringId("command_recording_test_font");
+
+static constexpr resources::ResourceId TEST_SHADER_RESOURCE_ID = 1001;
+static constexpr resources::ResourceId TEST_TEXTURE_RESOURCE_IDS[] = { 2001, 2002 };
+
+///------------------------------------------------------------------------------------------------
+
+// Per frame budgets for a board-like scene (\see CreateBoardLikeScene). Raising them should be a conscious decision.
+static constexpr int BOARD_SCENE_DRAW_CALL_BUDGET = 64;
+static constexpr int BOARD_SCENE_STATE_CHANGE_BUDGET = 8;
+
+///------------------------------------------------------------------------------------------------
+
+static std::shared_ptr<scene::SceneObject> CreateTestSceneObject(scene::Scene& scene, const resources::ResourceId textureResourceId)
+{
+    auto sceneObject = scene.CreateSceneObject();
+    sceneObject->mShaderResourceId = TEST_SHADER_RESOURCE_ID;
+    sceneObject->mTextureResourceId = textureResourceId;
+    sceneObject->mPosition = glm::vec3(0.0f, 0.0f, 0.0f);
+    sceneObject->mScale = glm::vec3(0.01f, 0.01f, 0.01f);
+    return sceneObject;
+}
+
+///------------------------------------------------------------------------------------------------
+
+// A few dozen card-like scene objects, grouped by texture, plus a label
+static void CreateBoardLikeScene(scene::Scene& scene)
+{
+    for (const auto textureResourceId: TEST_TEXTURE_RESOURCE_IDS)
+    {
+        for (int i = 0; i < 24; ++i)
+        {
+            CreateTestSceneObject(scene, textureResourceId);
+        }
+    }
+    
+    auto labelSceneObject = CreateTestSceneObject(scene, 0);
+    labelSceneObject->mSceneObjectTypeData = scene::TextSceneObjectData{ "Turn 1", UNLOADED_FONT_NAME };
+}
+
+///------------------------------------------------------------------------------------------------
+
+TEST(CommandRecordingRendererTests, TestSceneObjectsSharingResourcesOnlyChangeStateOnce)
+{
+    scene::Scene scene(TEST_SCENE_NAME);
+    for (int i = 0; i < 10; ++i)
+    {
+        CreateTestSceneObject(scene, TEST_TEXTURE_RESOURCE_IDS[0]);
+    }
+    
+    rendering::CommandRecordingRenderer renderer;
+    renderer.VBeginRenderPass();
+    renderer.VRenderScene(scene);
+    renderer.VEndRenderPass();
+    
+    const auto* sceneStats = renderer.GetSceneStats(TEST_SCENE_NAME);
+    ASSERT_NE(sceneStats, nullptr);
+    EXPECT_EQ(sceneStats->mDrawCalls, 10);
+    EXPECT_EQ(sceneStats->mSceneObjectsDrawn, 10);
+    
+    // Shader, mesh & texture are bound once
+    EXPECT_EQ(sceneStats->mStateChanges, 3);
+}
+
+TEST(CommandRecordingRendererTests, TestInvisibleAndCulledSceneObjectsAreNotDrawn)
+{
+    scene::Scene scene(TEST_SCENE_NAME);
+    CreateTestSceneObject(scene, TEST_TEXTURE_RESOURCE_IDS[0]);
+    CreateTestSceneObject(scene, TEST_TEXTURE_RESOURCE_IDS[0])->mInvisible = true;
+    CreateTestSceneObject(scene, TEST_TEXTURE_RESOURCE_IDS[0])->mPosition = glm::vec3(100.0f, 100.0f, 0.0f);
+    
+    rendering::CommandRecordingRenderer renderer;
+    renderer.VBeginRenderPass();
+    renderer.VRenderScene(scene);
+    renderer.VEndRenderPass();
+    
+    const auto* sceneStats = renderer.GetSceneStats(TEST_SCENE_NAME);
+    ASSERT_NE(sceneStats, nullptr);
+    EXPECT_EQ(sceneStats->mDrawCalls, 1);
+    EXPECT_EQ(sceneStats->mSceneObjectsDrawn, 1);
+    EXPECT_EQ(sceneStats->mSceneObjectsCulled, 1);
+}
+
+TEST(CommandRecordingRendererTests, TestDeferredSceneObjectsAreDrawnAtTheEndOfTheRenderPass)
+{
+    scene::Scene scene(TEST_SCENE_NAME);
+    CreateTestSceneObject(scene, TEST_TEXTURE_RESOURCE_IDS[0])->mDeferredRendering = true;
+    CreateTestSceneObject(scene, TEST_TEXTURE_RESOURCE_IDS[0]);
+    
+    rendering::CommandRecordingRenderer renderer;
+    renderer.VBeginRenderPass();
+    renderer.VRenderScene(scene);
+    EXPECT_EQ(renderer.GetSceneStats(TEST_SCENE_NAME)->mDrawCalls, 1);
+    
+    renderer.VEndRenderPass();
+    EXPECT_EQ(renderer.GetSceneStats(TEST_SCENE_NAME)->mDrawCalls, 2);
+}
+
+TEST(CommandRecordingRendererTests, TestTextIsDrawnOneGlyphAtATime)
+{
+    scene::Scene scene(TEST_SCENE_NAME);
+    CreateTestSceneObject(scene, 0)->mSceneObjectTypeData = scene::TextSceneObjectData{ "Hello", UNLOADED_FONT_NAME };
+    
+    rendering::CommandRecordingRenderer renderer;
+    renderer.VBeginRenderPass();
+    renderer.VRenderScene(scene);
+    renderer.VEndRenderPass();
+    
+    EXPECT_EQ(renderer.GetSceneStats(TEST_SCENE_NAME)->mDrawCalls, 5);
+}
+
+TEST(CommandRecordingRendererTests, TestStatsAreResetEveryRenderPass)
+{
+    scene::Scene scene(TEST_SCENE_NAME);
+    CreateTestSceneObject(scene, TEST_TEXTURE_RESOURCE_IDS[0]);
+    
+    rendering::CommandRecordingRenderer renderer;
+    for (int i = 0; i < 3; ++i)
+    {
+        renderer.VBeginRenderPass();
+        renderer.VRenderScene(scene);
+        renderer.VEndRenderPass();
+    }
+    
+    EXPECT_EQ(renderer.GetFrameStats().mDrawCalls, 1);
+    EXPECT_GT(renderer.GetFrameStats().mUploadedBytes, 0U);
+    
+    renderer.VBeginRenderPass();
+    EXPECT_EQ(renderer.GetSceneStats(TEST_SCENE_NAME), nullptr);
+    EXPECT_EQ(renderer.GetFrameStats().mDrawCalls, 0);
+}
+
+TEST(CommandRecordingRendererTests, TestBoardLikeSceneStaysWithinItsBudgets)
+{
+    scene::Scene scene(TEST_SCENE_NAME);
+    CreateBoardLikeScene(scene);
+    
+    rendering::CommandRecordingRenderer renderer;
+    renderer.VBeginRenderPass();
+    renderer.VRenderScene(scene);
+    renderer.VEndRenderPass();
+    
+    const auto* sceneStats = renderer.GetSceneStats(TEST_SCENE_NAME);
+    ASSERT_NE(sceneStats, nullptr);
+    EXPECT_LE(sceneStats->mDrawCalls, BOARD_SCENE_DRAW_CALL_BUDGET);
+    EXPECT_LE(sceneStats->mStateChanges, BOARD_SCENE_STATE_CHANGE_BUDGET);
+}
+
+///------------------------------------------------------------------------------------------------
@@ -0,0 +1,156 @@
+///------------------------------------------------------------------------------------------------
+///  ShaderUniformValuesTest.cpp
+///  Predators
+///
+///  Created by Alex Koukoulas on 21/04/2024
+///------------------------------------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+#include <engine/rendering/ShaderUniformValues.h>
+#include <engine/utils/Logging.h>
+#include <chrono>
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
+
+///------------------------------------------------------------------------------------------------
+
+static constexpr int BENCHMARK_UNIFORM_COUNT = 6;
+static constexpr int BENCHMARK_ITERATIONS = 100000;
+
+///------------------------------------------------------------------------------------------------
+
+static std::vector<strutils::StringId> CreateUniformNames(const int count)
+{
+    std::vector<strutils::StringId> uniformNames;
+    for (int i = 0; i < count; ++i)
+    {
+        uniformNames.emplace_back("test_uniform_" + std::to_string(i));
+    }
+    return uniformNames;
+}
+
+///------------------------------------------------------------------------------------------------
+
+TEST(ShaderUniformValuesTests, TestBasicInsertionAndRetrieval)
+{
+    rendering::ShaderUniformValues<float> uniformValues;
+    const strutils::StringId alphaUniformName("custom_alpha");
+    
+    EXPECT_TRUE(uniformValues.empty());
+    EXPECT_EQ(uniformValues.count(alphaUniformName), 0U);
+    EXPECT_THROW((void)uniformValues.at(alphaUniformName), std::out_of_range);
+    
+    // Like std::unordered_map, new entries are value initialized
+    EXPECT_EQ(uniformValues[alphaUniformName], 0.0f);
+    
+    uniformValues[alphaUniformName] = 0.5f;
+    EXPECT_EQ(uniformValues.size(), 1U);
+    EXPECT_EQ(uniformValues.count(alphaUniformName), 1U);
+    EXPECT_EQ(uniformValues.at(alphaUniformName), 0.5f);
+    EXPECT_EQ(uniformValues.begin()->mUniformIndex, rendering::GetShaderUniformIndex(alphaUniformName));
+}
+
+TEST(ShaderUniformValuesTests, TestValueReferencesSurviveLaterInsertions)
+{
+    rendering::ShaderUniformValues<float> uniformValues;
+    const auto uniformNames = CreateUniformNames(50);
+    
+    // Tween animations keep references to uniform values around
+    std::vector<float*> uniformValuePointers;
+    for (size_t i = 0; i < uniformNames.size(); ++i)
+    {
+        uniformValuePointers.push_back(&uniformValues[uniformNames[i]]);
+        *uniformValuePointers.back() = static_cast<float>(i);
+    }
+    
+    for (size_t i = 0; i < uniformNames.size(); ++i)
+    {
+        EXPECT_EQ(&uniformValues[uniformNames[i]], uniformValuePointers[i]);
+        EXPECT_EQ(uniformValues.at(uniformNames[i]), static_cast<float>(i));
+    }
+    
+    // Iteration follows insertion order
+    size_t entryIndex = 0;
+    for (const auto& entry: uniformValues)
+    {
+        EXPECT_EQ(entry.mName, uniformNames[entryIndex]);
+        EXPECT_EQ(entry.mValue, static_cast<float>(entryIndex));
+        entryIndex++;
+    }
+    EXPECT_EQ(entryIndex, uniformNames.size());
+    
+    auto uniformValuesCopy = uniformValues;
+    EXPECT_EQ(uniformValuesCopy.size(), uniformValues.size());
+    EXPECT_EQ(uniformValuesCopy.at(uniformNames.back()), uniformValues.at(uniformNames.back()));
+    EXPECT_NE(&uniformValuesCopy.at(uniformNames.back()), &uniformValues.at(uniformNames.back()));
+}
+
+TEST(ShaderUniformValuesTests, TestUniformIndicesAreDenseAndStable)
+{
+    const auto uniformNames = CreateUniformNames(10);
+    
+    std::vector<rendering::ShaderUniformIndex> uniformIndices;
+    for (const auto& uniformName: uniformNames)
+    {
+        uniformIndices.push_back(rendering::GetShaderUniformIndex(uniformName));
+    }
+    
+    for (size_t i = 0; i < uniformNames.size(); ++i)
+    {
+        EXPECT_EQ(rendering::GetShaderUniformIndex(uniformNames[i]), uniformIndices[i]);
+        EXPECT_EQ(rendering::GetShaderUniformName(uniformIndices[i]), uniformNames[i]);
+    }
+}
+
+// Benchmark only, run with --gtest_also_run_disabled_tests
+TEST(ShaderUniformValuesTests, DISABLED_TestUploadPassTimesAgainstHashedUniforms)
+{
+    const auto uniformNames = CreateUniformNames(BENCHMARK_UNIFORM_COUNT);
+    
+    rendering::ShaderUniformValues<float> packedUniformValues;
+    std::unordered_map<strutils::StringId, float, strutils::StringIdHasher> hashedUniformValues;
+    std::vector<int> locationsByIndex;
+    std::unordered_map<strutils::StringId, int, strutils::StringIdHasher> locationsByName;
+    for (size_t i = 0; i < uniformNames.size(); ++i)
+    {
+        packedUniformValues[uniformNames[i]] = static_cast<float>(i);
+        hashedUniformValues[uniformNames[i]] = static_cast<float>(i);
+        
+        const auto uniformIndex = rendering::GetShaderUniformIndex(uniformNames[i]);
+        if (uniformIndex >= locationsByIndex.size())
+        {
+            locationsByIndex.resize(uniformIndex + 1, -1);
+        }
+        locationsByIndex[uniformIndex] = static_cast<int>(i);
+        locationsByName[uniformNames[i]] = static_cast<int>(i);
+    }
+    
+    // Mimics a draw's uniform upload pass, with the GL call replaced by a checksum
+    float packedChecksum = 0.0f;
+    auto packedStart = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < BENCHMARK_ITERATIONS; ++i)
+    {
+        for (const auto& entry: packedUniformValues)
+        {
+            packedChecksum += entry.mValue * locationsByIndex[entry.mUniformIndex];
+        }
+    }
+    auto packedNanos = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::high_resolution_clock::now() - packedStart).count()/static_cast<float>(BENCHMARK_ITERATIONS);
+    
+    float hashedChecksum = 0.0f;
+    auto hashedStart = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < BENCHMARK_ITERATIONS; ++i)
+    {
+        for (const auto& entry: hashedUniformValues)
+        {
+            hashedChecksum += entry.second * locationsByName.at(entry.first);
+        }
+    }
+    auto hashedNanos = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::high_resolution_clock::now() - hashedStart).count()/static_cast<float>(BENCHMARK_ITERATIONS);
+    
+    EXPECT_EQ(packedChecksum, hashedChecksum);
+    LOG(logging::LogType::INFO, "Uniform upload pass (%d floats): packed %.1fns, hashed %.1fns", BENCHMARK_UNIFORM_COUNT, packedNanos, hashedNanos);
+}
+
+///------------------------------------------------------------------------------------------------
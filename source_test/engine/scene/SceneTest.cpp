@@ -8,6 +8,103 @@
 #include <gtest/gtest.h>
 #include <engine/scene/Scene.h>
 #include <engine/scene/SceneObject.h>
+#include <engine/scene/SceneObjectUtils.h>
+#include <engine/utils/Logging.h>
+#include <algorithm>
+#include <chrono>
+#include <functional>
+
+///------------------------------------------------------------------------------------------------
+
+static const glm::vec3 SNAP_TEST_MESH_DIMENSIONS = glm::vec3(1.0f, 1.0f, 0.0f);
+static const float SNAP_TEST_ASPECT_RATIOS[] = { 0.46f, 0.75f, 1.0f, 1.333f, 1.777f, 2.2f };
+
+///------------------------------------------------------------------------------------------------
+
+// Frustum of the default (orthographic) game camera for the given window aspect ratio
+static math::Frustum CalculateSnapTestFrustum(const float aspectRatio)
+{
+    const auto halfWidth = 0.115f * aspectRatio/0.46f;
+    const auto halfHeight = 0.25f;
+    const auto viewProjectionMatrix = glm::ortho(-halfWidth, halfWidth, -halfHeight, halfHeight, -50.0f, 50.0f) * glm::lookAt(glm::vec3(0.0f, -0.0087f, -5.0f), glm::vec3(0.0f, -0.0087f, -6.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+    
+    const auto rowX = glm::row(viewProjectionMatrix, 0);
+    const auto rowY = glm::row(viewProjectionMatrix, 1);
+    const auto rowZ = glm::row(viewProjectionMatrix, 2);
+    const auto rowW = glm::row(viewProjectionMatrix, 3);
+    
+    math::Frustum frustum = { rowW + rowX, rowW - rowX, rowW + rowY, rowW - rowY, rowW + rowZ, rowW - rowZ };
+    for (auto& frustumSide: frustum)
+    {
+        frustumSide = -frustumSide/glm::length(glm::vec3(frustumSide));
+    }
+    
+    return frustum;
+}
+
+///------------------------------------------------------------------------------------------------
+
+// The iterative nudging that CalculateEdgeSnappedPosition replaced, kept as a reference
+static glm::vec3 CalculateEdgeSnappedPositionIteratively(const scene::SceneObject& sceneObject, const math::Frustum& frustum)
+{
+    static const float positionIncrements = 0.0001f;
+    
+    auto position = sceneObject.mPosition;
+    int breachedSideIndex = 0;
+    
+    while (!math::IsMeshFullyInsideFrustum(position, sceneObject.mScale, SNAP_TEST_MESH_DIMENSIONS, frustum, breachedSideIndex))
+    {
+        if (breachedSideIndex == 0) position.x += positionIncrements;
+        else if (breachedSideIndex == 1) position.x -= positionIncrements;
+        else if (breachedSideIndex == 2) position.y += positionIncrements;
+        else position.y -= positionIncrements;
+    }
+    
+    switch (sceneObject.mSnapToEdgeBehavior)
+    {
+        case scene::SnapToEdgeBehavior::SNAP_TO_LEFT_EDGE:
+        {
+            while (math::IsMeshFullyInsideFrustum(position, sceneObject.mScale, SNAP_TEST_MESH_DIMENSIONS, frustum, breachedSideIndex)) position.x -= positionIncrements;
+            position.x += sceneObject.mScale.x * sceneObject.mSnapToEdgeScaleOffsetFactor;
+        } break;
+        case scene::SnapToEdgeBehavior::SNAP_TO_RIGHT_EDGE:
+        {
+            while (math::IsMeshFullyInsideFrustum(position, sceneObject.mScale, SNAP_TEST_MESH_DIMENSIONS, frustum, breachedSideIndex)) position.x += positionIncrements;
+            position.x -= sceneObject.mScale.x * sceneObject.mSnapToEdgeScaleOffsetFactor;
+        } break;
+        case scene::SnapToEdgeBehavior::SNAP_TO_TOP_EDGE:
+        {
+            while (math::IsMeshFullyInsideFrustum(position, sceneObject.mScale, SNAP_TEST_MESH_DIMENSIONS, frustum, breachedSideIndex)) position.y += positionIncrements;
+            position.y -= sceneObject.mScale.y * sceneObject.mSnapToEdgeScaleOffsetFactor;
+        } break;
+        case scene::SnapToEdgeBehavior::SNAP_TO_BOT_EDGE:
+        {
+            while (math::IsMeshFullyInsideFrustum(position, sceneObject.mScale, SNAP_TEST_MESH_DIMENSIONS, frustum, breachedSideIndex)) position.y -= positionIncrements;
+            position.y += sceneObject.mScale.y * sceneObject.mSnapToEdgeScaleOffsetFactor;
+        } break;
+        default: break;
+    }
+    
+    return position;
+}
+
+///------------------------------------------------------------------------------------------------
+
+static void CreateEdgeSnappingSceneObjects(scene::Scene& scene, const int count)
+{
+    static const scene::SnapToEdgeBehavior SNAP_TO_EDGE_BEHAVIORS[] = { scene::SnapToEdgeBehavior::SNAP_TO_LEFT_EDGE, scene::SnapToEdgeBehavior::SNAP_TO_RIGHT_EDGE, scene::SnapToEdgeBehavior::SNAP_TO_TOP_EDGE, scene::SnapToEdgeBehavior::SNAP_TO_BOT_EDGE };
+    
+    for (int i = 0; i < count; ++i)
+    {
+        auto sceneObject = scene.CreateSceneObject();
+        sceneObject->mSnapToEdgeBehavior = SNAP_TO_EDGE_BEHAVIORS[i % 4];
+        sceneObject->mSnapToEdgeScaleOffsetFactor = (i % 5) * 0.25f;
+        sceneObject->mScale = glm::vec3(0.01f + (i % 7) * 0.005f, 0.01f + (i % 3) * 0.01f, 1.0f);
+        sceneObject->mPosition = glm::vec3(-0.4f + (i % 17) * 0.05f, -0.4f + (i % 13) * 0.0667f, 0.1f);
+    }
+}
+
+///------------------------------------------------------------------------------------------------
 
 TEST(SceneOperationTests, TestBasicInsertionAndRetrieval)
 {
@@ -110,3 +207,604 @@ TEST(SceneOperationTests, TestRemovalOfEmptyName)
     
     EXPECT_EQ(testScene.GetSceneObjectCount(), 1);
 }
+
+TEST(SceneOperationTests, TestRenamedSceneObjectsAreReindexed)
+{
+    const strutils::StringId NAME("ABCD");
+    const strutils::StringId NEW_NAME("EFGH");
+    
+    scene::Scene testScene(strutils::StringId("test"));
+    
+    auto testSceneObject = testScene.CreateSceneObject(NAME);
+    testSceneObject->mName = NEW_NAME;
+    
+    EXPECT_EQ(testScene.FindSceneObject(NAME), nullptr);
+    EXPECT_EQ(testScene.FindSceneObject(NEW_NAME), testSceneObject);
+    
+    testScene.RemoveSceneObject(NEW_NAME);
+    
+    EXPECT_EQ(testScene.GetSceneObjectCount(), 0);
+    EXPECT_EQ(testScene.FindSceneObject(NEW_NAME), nullptr);
+    
+    // Renaming a scene object that is no longer part of the scene must not resurrect it
+    testSceneObject->mName = NAME;
+    
+    EXPECT_EQ(testScene.FindSceneObject(NAME), nullptr);
+}
+
+TEST(SceneOperationTests, TestDuplicateNamesResolveToFirstSceneObjectInSceneOrder)
+{
+    const strutils::StringId NAME("ABCD");
+    
+    scene::Scene testScene(strutils::StringId("test"));
+    
+    auto firstSceneObject = testScene.CreateSceneObject(NAME);
+    auto secondSceneObject = testScene.CreateSceneObject(NAME);
+    (void)testScene.CreateSceneObject(NAME);
+    
+    EXPECT_EQ(testScene.FindSceneObject(NAME), firstSceneObject);
+    
+    testScene.RemoveSceneObject(NAME);
+    
+    EXPECT_EQ(testScene.FindSceneObject(NAME), secondSceneObject);
+    
+    testScene.RemoveAllSceneObjectsWithName(NAME);
+    
+    EXPECT_EQ(testScene.GetSceneObjectCount(), 0);
+    EXPECT_EQ(testScene.FindSceneObject(NAME), nullptr);
+}
+
+TEST(SceneOperationTests, TestPrefixQueries)
+{
+    scene::Scene testScene(strutils::StringId("test"));
+    
+    auto cardSceneObject = testScene.CreateSceneObject(strutils::StringId("card_0"));
+    (void)testScene.CreateSceneObject(strutils::StringId("card_1"));
+    (void)testScene.CreateSceneObject(strutils::StringId("card_1"));
+    (void)testScene.CreateSceneObject(strutils::StringId("card"));
+    (void)testScene.CreateSceneObject(strutils::StringId("cards_label"));
+    (void)testScene.CreateSceneObject(strutils::StringId("board"));
+    
+    EXPECT_EQ(testScene.FindSceneObjectsWhoseNameStartsWith("card_").size(), 3);
+    EXPECT_EQ(testScene.FindSceneObjectsWhoseNameStartsWith("card").size(), 5);
+    EXPECT_EQ(testScene.FindSceneObjectsWhoseNameStartsWith("cards_label_").size(), 0);
+    EXPECT_EQ(testScene.FindSceneObjectsWhoseNameStartsWith("").size(), 6);
+    
+    cardSceneObject->mName = strutils::StringId("board_card");
+    
+    EXPECT_EQ(testScene.FindSceneObjectsWhoseNameStartsWith("card_").size(), 2);
+    EXPECT_EQ(testScene.FindSceneObjectsWhoseNameStartsWith("board").size(), 2);
+    
+    testScene.RemoveAllSceneObjectsWithName(strutils::StringId("card_1"));
+    
+    EXPECT_EQ(testScene.FindSceneObjectsWhoseNameStartsWith("card_").size(), 0);
+    EXPECT_EQ(testScene.FindSceneObjectsWhoseNameStartsWith("card").size(), 2);
+}
+
+// Benchmark only, run with --gtest_also_run_disabled_tests
+TEST(SceneOperationTests, DISABLED_TestNameLookupTimesOnLargeScene)
+{
+    const int SCENE_OBJECT_COUNT = 2000;
+    const int LOOKUP_ITERATIONS = 10;
+    
+    scene::Scene testScene(strutils::StringId("test"));
+    
+    std::vector<strutils::StringId> sceneObjectNames;
+    for (int i = 0; i < SCENE_OBJECT_COUNT; ++i)
+    {
+        sceneObjectNames.emplace_back("scene_object_" + std::to_string(i));
+        (void)testScene.CreateSceneObject(sceneObjectNames.back());
+    }
+    
+    size_t foundCount = 0;
+    auto indexedLookupStart = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < LOOKUP_ITERATIONS; ++i)
+    {
+        for (const auto& sceneObjectName: sceneObjectNames)
+        {
+            foundCount += testScene.FindSceneObject(sceneObjectName) != nullptr;
+        }
+    }
+    auto indexedLookupNanos = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::high_resolution_clock::now() - indexedLookupStart).count()/static_cast<float>(LOOKUP_ITERATIONS * SCENE_OBJECT_COUNT);
+    
+    auto linearLookupStart = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < LOOKUP_ITERATIONS; ++i)
+    {
+        for (const auto& sceneObjectName: sceneObjectNames)
+        {
+            const auto& sceneObjects = testScene.GetSceneObjects();
+            foundCount += std::find_if(sceneObjects.begin(), sceneObjects.end(), [&](const std::shared_ptr<scene::SceneObject>& sceneObject){ return sceneObject->mName == sceneObjectName; }) != sceneObjects.end();
+        }
+    }
+    auto linearLookupNanos = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::high_resolution_clock::now() - linearLookupStart).count()/static_cast<float>(LOOKUP_ITERATIONS * SCENE_OBJECT_COUNT);
+    
+    EXPECT_EQ(foundCount, 2U * LOOKUP_ITERATIONS * SCENE_OBJECT_COUNT);
+    EXPECT_EQ(testScene.FindSceneObjectsWhoseNameStartsWith("scene_object_19").size(), 111);
+    
+    LOG(logging::LogType::INFO, "Scene object lookup (%d objects): indexed %.1fns, linear scan %.1fns", SCENE_OBJECT_COUNT, indexedLookupNanos, linearLookupNanos);
+}
+
+TEST(SceneOperationTests, TestEdgeSnappedPositionsMatchIterativeSnapping)
+{
+    scene::Scene testScene(strutils::StringId("test"));
+    CreateEdgeSnappingSceneObjects(testScene, 200);
+    
+    for (const auto aspectRatio: SNAP_TEST_ASPECT_RATIOS)
+    {
+        const auto frustum = CalculateSnapTestFrustum(aspectRatio);
+        for (const auto& sceneObject: testScene.GetSceneObjects())
+        {
+            const auto expectedPosition = CalculateEdgeSnappedPositionIteratively(*sceneObject, frustum);
+            const auto snappedPosition = scene_object_utils::CalculateEdgeSnappedPosition(*sceneObject, SNAP_TEST_MESH_DIMENSIONS, frustum);
+            
+            // The iterative version overshoots the frustum side by up to one nudge
+            EXPECT_NEAR(snappedPosition.x, expectedPosition.x, 0.0002f);
+            EXPECT_NEAR(snappedPosition.y, expectedPosition.y, 0.0002f);
+            EXPECT_EQ(snappedPosition.z, expectedPosition.z);
+        }
+    }
+}
+
+// Benchmark only, run with --gtest_also_run_disabled_tests
+TEST(SceneOperationTests, DISABLED_TestEdgeSnappingTimesOnResize)
+{
+    const int SNAPPING_SCENE_OBJECT_COUNT = 500;
+    
+    scene::Scene testScene(strutils::StringId("test"));
+    CreateEdgeSnappingSceneObjects(testScene, SNAPPING_SCENE_OBJECT_COUNT);
+    
+    float checksum = 0.0f;
+    
+    auto analyticStart = std::chrono::high_resolution_clock::now();
+    for (const auto aspectRatio: SNAP_TEST_ASPECT_RATIOS)
+    {
+        const auto frustum = CalculateSnapTestFrustum(aspectRatio);
+        for (const auto& sceneObject: testScene.GetSceneObjects())
+        {
+            checksum += scene_object_utils::CalculateEdgeSnappedPosition(*sceneObject, SNAP_TEST_MESH_DIMENSIONS, frustum).x;
+        }
+    }
+    auto analyticMicros = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::high_resolution_clock::now() - analyticStart).count()/static_cast<float>(std::size(SNAP_TEST_ASPECT_RATIOS));
+    
+    auto iterativeStart = std::chrono::high_resolution_clock::now();
+    for (const auto aspectRatio: SNAP_TEST_ASPECT_RATIOS)
+    {
+        const auto frustum = CalculateSnapTestFrustum(aspectRatio);
+        for (const auto& sceneObject: testScene.GetSceneObjects())
+        {
+            checksum -= CalculateEdgeSnappedPositionIteratively(*sceneObject, frustum).x;
+        }
+    }
+    auto iterativeMicros = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::high_resolution_clock::now() - iterativeStart).count()/static_cast<float>(std::size(SNAP_TEST_ASPECT_RATIOS));
+    
+    EXPECT_NEAR(checksum, 0.0f, SNAPPING_SCENE_OBJECT_COUNT * std::size(SNAP_TEST_ASPECT_RATIOS) * 0.0002f);
+    
+    LOG(logging::LogType::INFO, "Edge snapping %d scene objects per resize: closed form %.1fus, iterative %.1fus", SNAPPING_SCENE_OBJECT_COUNT, analyticMicros, iterativeMicros);
+}
+
+TEST(SceneOperationTests, TestRenderOrderIsStableForEqualDepths)
+{
+    scene::Scene testScene(strutils::StringId("test"));
+    
+    std::vector<std::shared_ptr<scene::SceneObject>> sceneObjects;
+    for (int i = 0; i < 10; ++i)
+    {
+        sceneObjects.push_back(testScene.CreateSceneObject());
+        sceneObjects.back()->mPosition.z = (i % 2 == 0) ? 1.0f : 0.0f;
+    }
+    
+    testScene.UpdateRenderOrder();
+    
+    std::vector<std::shared_ptr<scene::SceneObject>> expectedOrder = { sceneObjects[1], sceneObjects[3], sceneObjects[5], sceneObjects[7], sceneObjects[9], sceneObjects[0], sceneObjects[2], sceneObjects[4], sceneObjects[6], sceneObjects[8] };
+    EXPECT_EQ(testScene.GetSceneObjects(), expectedOrder);
+    
+    // Moving an object away and back again restores its original place among equal depths
+    sceneObjects[4]->mPosition.z = -1.0f;
+    testScene.UpdateRenderOrder();
+    EXPECT_EQ(testScene.GetSceneObjects().front(), sceneObjects[4]);
+    
+    sceneObjects[4]->mPosition.z = 1.0f;
+    testScene.UpdateRenderOrder();
+    EXPECT_EQ(testScene.GetSceneObjects(), expectedOrder);
+}
+
+TEST(SceneOperationTests, TestIncrementalRenderOrderMatchesFullSort)
+{
+    scene::Scene testScene(strutils::StringId("test"));
+    
+    std::vector<std::shared_ptr<scene::SceneObject>> sceneObjects;
+    for (int i = 0; i < 300; ++i)
+    {
+        sceneObjects.push_back(testScene.CreateSceneObject(strutils::StringId(std::to_string(i))));
+        sceneObjects.back()->mPosition.z = static_cast<float>(math::RandomInt(0, 20));
+    }
+    
+    for (int frame = 0; frame < 200; ++frame)
+    {
+        for (int i = 0; i < 5; ++i)
+        {
+            sceneObjects[math::RandomInt(0, static_cast<int>(sceneObjects.size()) - 1)]->mPosition.z = static_cast<float>(math::RandomInt(0, 20));
+        }
+        
+        if (frame % 10 == 0)
+        {
+            testScene.RemoveSceneObject(strutils::StringId(std::to_string(frame)));
+            sceneObjects.erase(std::find_if(sceneObjects.begin(), sceneObjects.end(), [&](const std::shared_ptr<scene::SceneObject>& sceneObject){ return sceneObject->mName == strutils::StringId(std::to_string(frame)); }));
+            
+            sceneObjects.push_back(testScene.CreateSceneObject());
+            sceneObjects.back()->mPosition.z = static_cast<float>(math::RandomInt(0, 20));
+        }
+        
+        testScene.UpdateRenderOrder();
+        
+        // sceneObjects is in creation order, so a stable sort yields the expected render order
+        auto expectedOrder = sceneObjects;
+        std::stable_sort(expectedOrder.begin(), expectedOrder.end(), [](const std::shared_ptr<scene::SceneObject>& lhs, const std::shared_ptr<scene::SceneObject>& rhs){ return lhs->mPosition.z < rhs->mPosition.z; });
+        
+        ASSERT_EQ(testScene.GetSceneObjects(), expectedOrder);
+    }
+}
+
+// Benchmark only, run with --gtest_also_run_disabled_tests
+TEST(SceneOperationTests, DISABLED_TestRenderOrderUpdateTimesForMostlyStaticScene)
+{
+    const int SCENE_OBJECT_COUNT = 2000;
+    const int FRAME_COUNT = 200;
+    const int MOVING_SCENE_OBJECTS_PER_FRAME = 10;
+    
+    scene::Scene testScene(strutils::StringId("test"));
+    for (int i = 0; i < SCENE_OBJECT_COUNT; ++i)
+    {
+        testScene.CreateSceneObject()->mPosition.z = static_cast<float>(math::RandomInt(0, 50)) * 0.1f;
+    }
+    testScene.UpdateRenderOrder();
+    
+    auto incrementalStart = std::chrono::high_resolution_clock::now();
+    for (int frame = 0; frame < FRAME_COUNT; ++frame)
+    {
+        for (int i = 0; i < MOVING_SCENE_OBJECTS_PER_FRAME; ++i)
+        {
+            testScene.GetSceneObjects()[math::RandomInt(0, SCENE_OBJECT_COUNT - 1)]->mPosition.z += 0.01f;
+        }
+        testScene.UpdateRenderOrder();
+    }
+    auto incrementalMicros = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::high_resolution_clock::now() - incrementalStart).count()/static_cast<float>(FRAME_COUNT);
+    
+    auto sceneObjectsCopy = testScene.GetSceneObjects();
+    auto fullSortStart = std::chrono::high_resolution_clock::now();
+    for (int frame = 0; frame < FRAME_COUNT; ++frame)
+    {
+        for (int i = 0; i < MOVING_SCENE_OBJECTS_PER_FRAME; ++i)
+        {
+            sceneObjectsCopy[math::RandomInt(0, SCENE_OBJECT_COUNT - 1)]->mPosition.z += 0.01f;
+        }
+        std::sort(sceneObjectsCopy.begin(), sceneObjectsCopy.end(), [](const std::shared_ptr<scene::SceneObject>& lhs, const std::shared_ptr<scene::SceneObject>& rhs){ return lhs->mPosition.z < rhs->mPosition.z; });
+    }
+    auto fullSortMicros = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::high_resolution_clock::now() - fullSortStart).count()/static_cast<float>(FRAME_COUNT);
+    
+    LOG(logging::LogType::INFO, "Render order update (%d objects, %d moving per frame): incremental %.1fus, full sort %.1fus", SCENE_OBJECT_COUNT, MOVING_SCENE_OBJECTS_PER_FRAME, incrementalMicros, fullSortMicros);
+}
+
+TEST(SceneOperationTests, TestSceneObjectsOutsideOfFrustumAreCulled)
+{
+    const auto frustum = CalculateSnapTestFrustum(1.0f);
+    
+    scene::SceneObject sceneObject;
+    sceneObject.mScale = glm::vec3(0.01f);
+    EXPECT_FALSE(scene_object_utils::IsSceneObjectOutsideOfFrustum(sceneObject, frustum));
+    
+    for (const auto& offscreenPosition: { glm::vec3(-10.0f, 0.0f, 0.0f), glm::vec3(10.0f, 0.0f, 0.0f), glm::vec3(0.0f, -10.0f, 0.0f), glm::vec3(0.0f, 10.0f, 0.0f) })
+    {
+        sceneObject.mPosition = offscreenPosition;
+        EXPECT_TRUE(scene_object_utils::IsSceneObjectOutsideOfFrustum(sceneObject, frustum));
+    }
+    
+    // Cached bounds must follow the scene object back on screen
+    sceneObject.mPosition = glm::vec3(0.0f, 0.1f, 0.0f);
+    EXPECT_FALSE(scene_object_utils::IsSceneObjectOutsideOfFrustum(sceneObject, frustum));
+    
+    scene::SceneObject particleEmitterSceneObject;
+    particleEmitterSceneObject.mSceneObjectTypeData = scene::ParticleEmitterObjectData();
+    particleEmitterSceneObject.mPosition = glm::vec3(10.0f, 0.0f, 0.0f);
+    EXPECT_FALSE(scene_object_utils::IsSceneObjectOutsideOfFrustum(particleEmitterSceneObject, frustum));
+}
+
+// Benchmark only, run with --gtest_also_run_disabled_tests
+TEST(SceneOperationTests, DISABLED_TestCullingTimesForScrolledOffscreenSceneObjects)
+{
+    static const int SCENE_OBJECT_COUNT = 500;
+    static const int FRAME_COUNT = 100;
+    
+    const auto frustum = CalculateSnapTestFrustum(1.0f);
+    
+    std::vector<std::unique_ptr<scene::SceneObject>> sceneObjects;
+    for (int i = 0; i < SCENE_OBJECT_COUNT; ++i)
+    {
+        // A long horizontal strip of cards, like the ones in swipeable card containers
+        sceneObjects.push_back(std::make_unique<scene::SceneObject>());
+        sceneObjects.back()->mScale = glm::vec3(0.1f);
+        sceneObjects.back()->mPosition.x = i * 0.11f;
+    }
+    
+    int culledCount = 0;
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int frame = 0; frame < FRAME_COUNT; ++frame)
+    {
+        culledCount = 0;
+        for (auto& sceneObject: sceneObjects)
+        {
+            sceneObject->mPosition.x -= 0.01f;
+            culledCount += scene_object_utils::IsSceneObjectOutsideOfFrustum(*sceneObject, frustum) ? 1 : 0;
+        }
+    }
+    auto micros = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::high_resolution_clock::now() - start).count()/static_cast<float>(FRAME_COUNT);
+    
+    EXPECT_GT(culledCount, SCENE_OBJECT_COUNT/2);
+    LOG(logging::LogType::INFO, "Culled %d/%d scene objects in %.1fus", culledCount, SCENE_OBJECT_COUNT, micros);
+}
+
+static std::shared_ptr<scene::SceneObject> FindTopMostSceneObjectAtPointLinearly(scene::Scene& scene, const glm::vec2& point)
+{
+    // Render order is ascending, so the last hit is the top-most one
+    std::shared_ptr<scene::SceneObject> topMostSceneObject;
+    for (auto& sceneObject: scene.GetSceneObjects())
+    {
+        auto boundingRect = scene_object_utils::GetSceneObjectBoundingRect(*sceneObject);
+        if (!sceneObject->mInvisible && math::IsPointInsideRectangle(boundingRect.bottomLeft, boundingRect.topRight, point))
+        {
+            topMostSceneObject = sceneObject;
+        }
+    }
+    return topMostSceneObject;
+}
+
+TEST(SceneOperationTests, TestHitTestingMatchesLinearScan)
+{
+    scene::Scene testScene(strutils::StringId("test"));
+    
+    auto background = testScene.CreateSceneObject(strutils::StringId("background"));
+    background->mScale = glm::vec3(2.0f);
+    
+    for (int i = 0; i < 200; ++i)
+    {
+        auto sceneObject = testScene.CreateSceneObject(strutils::StringId(std::to_string(i)));
+        sceneObject->mPosition = glm::vec3(math::RandomFloat(-0.3f, 0.3f), math::RandomFloat(-0.3f, 0.3f), static_cast<float>(math::RandomInt(0, 5)));
+        sceneObject->mScale = glm::vec3(math::RandomFloat(0.02f, 0.15f));
+    }
+    
+    for (int frame = 0; frame < 100; ++frame)
+    {
+        for (int i = 0; i < 10; ++i)
+        {
+            auto& sceneObject = testScene.GetSceneObjects()[math::RandomInt(0, static_cast<int>(testScene.GetSceneObjectCount()) - 1)];
+            sceneObject->mPosition += glm::vec3(math::RandomFloat(-0.05f, 0.05f), math::RandomFloat(-0.05f, 0.05f), static_cast<float>(math::RandomInt(-1, 1)));
+            sceneObject->mScale *= math::RandomFloat(0.8f, 1.2f);
+            sceneObject->mInvisible = math::RandomInt(0, 4) == 0;
+        }
+        
+        if (frame % 10 == 0)
+        {
+            testScene.RemoveSceneObject(strutils::StringId(std::to_string(frame)));
+        }
+        
+        testScene.UpdateRenderOrder();
+        testScene.UpdateHitTestGrid();
+        
+        for (int i = 0; i < 50; ++i)
+        {
+            const auto point = glm::vec2(math::RandomFloat(-0.4f, 0.4f), math::RandomFloat(-0.4f, 0.4f));
+            ASSERT_EQ(testScene.FindTopMostSceneObjectAtPoint(point), FindTopMostSceneObjectAtPointLinearly(testScene, point));
+        }
+    }
+    
+    // Predicates skip over scene objects on top without hiding the ones below them. The background
+    // may have been hidden or moved above, so put it back first.
+    background->mPosition = glm::vec3(0.0f);
+    background->mScale = glm::vec3(2.0f);
+    background->mInvisible = false;
+    testScene.UpdateRenderOrder();
+    testScene.UpdateHitTestGrid();
+    
+    const auto point = glm::vec2(0.0f);
+    EXPECT_EQ(testScene.FindTopMostSceneObjectAtPoint(point, [](const scene::SceneObject& sceneObject){ return sceneObject.mName == strutils::StringId("background"); }), background);
+}
+
+TEST(SceneOperationTests, TestHitTestingUsesLastRenderedState)
+{
+    scene::Scene testScene(strutils::StringId("test"));
+    
+    auto bottomSceneObject = testScene.CreateSceneObject(strutils::StringId("bottom"));
+    bottomSceneObject->mScale = glm::vec3(0.1f);
+    
+    auto topSceneObject = testScene.CreateSceneObject(strutils::StringId("top"));
+    topSceneObject->mScale = glm::vec3(0.1f);
+    
+    // Equal depths resolve to the later created scene object, as it's rendered last
+    testScene.UpdateRenderOrder();
+    EXPECT_EQ(testScene.FindTopMostSceneObjectAtPoint(glm::vec2(0.0f)), topSceneObject);
+    
+    bottomSceneObject->mPosition.z = 1.0f;
+    testScene.UpdateRenderOrder();
+    testScene.UpdateHitTestGrid();
+    EXPECT_EQ(testScene.FindTopMostSceneObjectAtPoint(glm::vec2(0.0f)), bottomSceneObject);
+    
+    // Moves are only picked up by the next grid update
+    bottomSceneObject->mPosition.x = 1.0f;
+    EXPECT_EQ(testScene.FindTopMostSceneObjectAtPoint(glm::vec2(0.0f)), bottomSceneObject);
+    testScene.UpdateHitTestGrid();
+    EXPECT_EQ(testScene.FindTopMostSceneObjectAtPoint(glm::vec2(0.0f)), topSceneObject);
+    EXPECT_EQ(testScene.FindTopMostSceneObjectAtPoint(glm::vec2(1.0f, 0.0f)), bottomSceneObject);
+    
+    // Removed scene objects can't be hit, even before the next grid update
+    testScene.RemoveSceneObject(strutils::StringId("top"));
+    EXPECT_EQ(testScene.FindTopMostSceneObjectAtPoint(glm::vec2(0.0f)), nullptr);
+}
+
+// Benchmark only, run with --gtest_also_run_disabled_tests
+TEST(SceneOperationTests, DISABLED_TestHitTestingTimesOnLargeScene)
+{
+    static const int SCENE_OBJECT_COUNT = 2000;
+    static const int QUERY_COUNT = 1000;
+    
+    scene::Scene testScene(strutils::StringId("test"));
+    for (int i = 0; i < SCENE_OBJECT_COUNT; ++i)
+    {
+        auto sceneObject = testScene.CreateSceneObject(strutils::StringId(std::to_string(i)));
+        sceneObject->mPosition = glm::vec3(math::RandomFloat(-1.0f, 1.0f), math::RandomFloat(-1.0f, 1.0f), static_cast<float>(math::RandomInt(0, 5)));
+        sceneObject->mScale = glm::vec3(0.1f, 0.15f, 1.0f);
+    }
+    testScene.UpdateRenderOrder();
+    testScene.UpdateHitTestGrid();
+    
+    std::vector<glm::vec2> points;
+    for (int i = 0; i < QUERY_COUNT; ++i)
+    {
+        points.push_back(glm::vec2(math::RandomFloat(-1.0f, 1.0f), math::RandomFloat(-1.0f, 1.0f)));
+    }
+    
+    int gridHitCount = 0;
+    auto gridStart = std::chrono::high_resolution_clock::now();
+    for (const auto& point: points)
+    {
+        gridHitCount += testScene.FindTopMostSceneObjectAtPoint(point) ? 1 : 0;
+    }
+    auto gridMicros = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::high_resolution_clock::now() - gridStart).count()/static_cast<float>(QUERY_COUNT);
+    
+    int linearHitCount = 0;
+    auto linearStart = std::chrono::high_resolution_clock::now();
+    for (const auto& point: points)
+    {
+        linearHitCount += FindTopMostSceneObjectAtPointLinearly(testScene, point) ? 1 : 0;
+    }
+    auto linearMicros = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::high_resolution_clock::now() - linearStart).count()/static_cast<float>(QUERY_COUNT);
+    
+    EXPECT_EQ(gridHitCount, linearHitCount);
+    LOG(logging::LogType::INFO, "Hit-test (%d objects): grid %.2fus, linear scan %.2fus", SCENE_OBJECT_COUNT, gridMicros, linearMicros);
+}
+
+TEST(SceneOperationTests, TestInterpolatedTransformsAreRestoredToLogicTransforms)
+{
+    scene::Scene testScene(strutils::StringId("test_scene"));
+    auto movingSceneObject = testScene.CreateSceneObject();
+    auto staticSceneObject = testScene.CreateSceneObject();
+    movingSceneObject->mPosition = glm::vec3(0.0f, 0.0f, 1.0f);
+    staticSceneObject->mPosition = glm::vec3(0.5f, 0.5f, 1.0f);
+    
+    testScene.CaptureSceneObjectTransforms();
+    movingSceneObject->mPosition = glm::vec3(1.0f, -1.0f, 2.0f);
+    movingSceneObject->mRotation.z = 1.0f;
+    
+    testScene.ApplyInterpolatedSceneObjectTransforms(0.25f);
+    EXPECT_FLOAT_EQ(movingSceneObject->mPosition.x, 0.25f);
+    EXPECT_FLOAT_EQ(movingSceneObject->mPosition.y, -0.25f);
+    EXPECT_FLOAT_EQ(movingSceneObject->mPosition.z, 2.0f);
+    EXPECT_FLOAT_EQ(movingSceneObject->mRotation.z, 0.25f);
+    EXPECT_EQ(staticSceneObject->mPosition, glm::vec3(0.5f, 0.5f, 1.0f));
+    
+    testScene.RestoreSceneObjectTransforms();
+    EXPECT_EQ(movingSceneObject->mPosition, glm::vec3(1.0f, -1.0f, 2.0f));
+    EXPECT_FLOAT_EQ(movingSceneObject->mRotation.z, 1.0f);
+}
+
+TEST(SceneOperationTests, TestSnappedAndNewlyCreatedSceneObjectsAreNotInterpolated)
+{
+    scene::Scene testScene(strutils::StringId("test_scene"));
+    auto teleportedSceneObject = testScene.CreateSceneObject();
+    auto removedSceneObject = testScene.CreateSceneObject(strutils::StringId("removed"));
+    
+    testScene.CaptureSceneObjectTransforms();
+    teleportedSceneObject->mPosition = glm::vec3(1.0f, 1.0f, 0.0f);
+    scene_object_utils::SnapToLogicTransform(*teleportedSceneObject);
+    removedSceneObject->mPosition = glm::vec3(1.0f, 1.0f, 0.0f);
+    testScene.RemoveSceneObject(strutils::StringId("removed"));
+    auto createdSceneObject = testScene.CreateSceneObject();
+    createdSceneObject->mPosition = glm::vec3(1.0f, 1.0f, 0.0f);
+    
+    testScene.ApplyInterpolatedSceneObjectTransforms(0.5f);
+    EXPECT_EQ(teleportedSceneObject->mPosition, glm::vec3(1.0f, 1.0f, 0.0f));
+    EXPECT_EQ(removedSceneObject->mPosition, glm::vec3(1.0f, 1.0f, 0.0f));
+    EXPECT_EQ(createdSceneObject->mPosition, glm::vec3(1.0f, 1.0f, 0.0f));
+    testScene.RestoreSceneObjectTransforms();
+    
+    // Interpolated again from the next step on
+    testScene.CaptureSceneObjectTransforms();
+    teleportedSceneObject->mPosition = glm::vec3(0.0f, 0.0f, 0.0f);
+    testScene.ApplyInterpolatedSceneObjectTransforms(0.5f);
+    EXPECT_EQ(teleportedSceneObject->mPosition, glm::vec3(0.5f, 0.5f, 0.0f));
+    testScene.RestoreSceneObjectTransforms();
+}
+
+TEST(SceneOperationTests, TestSceneObjectsOutlivingTheirSceneKeepItsPoolAlive)
+{
+    std::shared_ptr<scene::SceneObject> survivingSceneObject;
+    {
+        scene::Scene testScene(strutils::StringId("test_scene"));
+        for (int i = 0; i < 100; ++i)
+        {
+            (void)testScene.CreateSceneObject(strutils::StringId(std::to_string(i)));
+            (void)testScene.CreateDetachedSceneObject();
+        }
+        
+        // Detached scene objects are returned to the pool (and reused) as soon as they are dropped
+        EXPECT_EQ(testScene.GetSceneObjectBlockPool().GetLiveBlockCount(), 100);
+        survivingSceneObject = testScene.FindSceneObject(strutils::StringId("42"));
+    }
+    
+    survivingSceneObject->mName = strutils::StringId("renamed");
+    survivingSceneObject->mPosition.x = 1.0f;
+    EXPECT_EQ(survivingSceneObject->mName, strutils::StringId("renamed"));
+}
+
+// Benchmark only, run with --gtest_also_run_disabled_tests
+TEST(SceneOperationTests, DISABLED_TestCardLibrarySceneRecreationTimes)
+{
+    // Roughly what recreating the Card Library does: every card is a card base in the scene with
+    // ~8 detached components collated into it, on top of the scene's own gui scene objects
+    static constexpr int RECREATION_COUNT = 20;
+    static constexpr int CARD_COUNT = 60;
+    static constexpr int CARD_COMPONENT_COUNT = 8;
+    static constexpr int GUI_SCENE_OBJECT_COUNT = 40;
+    
+    const auto createCardLibraryScene = [](scene::Scene& scene, const std::function<std::shared_ptr<scene::SceneObject>()>& createCardComponent)
+    {
+        for (int i = 0; i < GUI_SCENE_OBJECT_COUNT; ++i)
+        {
+            (void)scene.CreateSceneObject(strutils::StringId("gui_" + std::to_string(i)));
+        }
+        
+        for (int i = 0; i < CARD_COUNT; ++i)
+        {
+            std::vector<std::shared_ptr<scene::SceneObject>> cardComponents;
+            cardComponents.push_back(scene.CreateSceneObject(strutils::StringId("card_" + std::to_string(i))));
+            for (int j = 0; j < CARD_COMPONENT_COUNT; ++j)
+            {
+                cardComponents.push_back(createCardComponent());
+                cardComponents.back()->mSceneObjectTypeData = scene::TextSceneObjectData{ std::to_string(j), strutils::StringId("font") };
+            }
+        }
+    };
+    
+    std::size_t pooledSceneObjectCount = 0;
+    std::size_t pooledHeapAllocationCount = 0;
+    auto pooledStart = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < RECREATION_COUNT; ++i)
+    {
+        scene::Scene cardLibraryScene(strutils::StringId("card_library"));
+        createCardLibraryScene(cardLibraryScene, [&](){ return cardLibraryScene.CreateDetachedSceneObject(); });
+        pooledSceneObjectCount = cardLibraryScene.GetSceneObjectCount() + CARD_COUNT * CARD_COMPONENT_COUNT;
+        pooledHeapAllocationCount = cardLibraryScene.GetSceneObjectBlockPool().GetHeapAllocationCount();
+    }
+    auto pooledMicros = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::high_resolution_clock::now() - pooledStart).count()/static_cast<float>(RECREATION_COUNT);
+    
+    // Same scene, but with card components individually allocated from the heap like scene objects used to be
+    auto heapStart = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < RECREATION_COUNT; ++i)
+    {
+        scene::Scene cardLibraryScene(strutils::StringId("card_library"));
+        createCardLibraryScene(cardLibraryScene, [](){ return std::make_shared<scene::SceneObject>(); });
+    }
+    auto heapMicros = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::high_resolution_clock::now() - heapStart).count()/static_cast<float>(RECREATION_COUNT);
+    
+    EXPECT_LT(pooledHeapAllocationCount * 10, pooledSceneObjectCount);
+    LOG(logging::LogType::INFO, "Card Library recreation: %d scene objects from %d pool heap allocations in %.2fus, card components from the heap %.2fus", static_cast<int>(pooledSceneObjectCount), static_cast<int>(pooledHeapAllocationCount), pooledMicros, heapMicros);
+}
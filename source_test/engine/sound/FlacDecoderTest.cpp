@@ -0,0 +1,495 @@
+///------------------------------------------------------------------------------------------------
+///  FlacDecoderTest.cpp
+///  Predators
+///
+///  Created by Alex Koukoulas on 01/05/2024
+///------------------------------------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+#include <engine/resloading/ResourceLoadingService.h>
+#include <engine/sound/FlacDecoder.h>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <vector>
+
+///------------------------------------------------------------------------------------------------
+
+static constexpr int FIXTURE_SAMPLE_RATE = 44100;
+static constexpr int FIXTURE_BITS_PER_SAMPLE = 16;
+static constexpr int FIXTURE_BLOCK_SIZE = 128;
+static constexpr int FIXTURE_CHANNEL_COUNT = 2;
+
+///------------------------------------------------------------------------------------------------
+/// Minimal MD5 (RFC 1321), only used to verify decoded samples against the STREAMINFO signature.
+class Md5 final
+{
+public:
+    void Update(const std::uint8_t* data, const std::size_t size)
+    {
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            mBlock[mMessageSize++ % 64] = data[i];
+            if (mMessageSize % 64 == 0)
+            {
+                ProcessBlock();
+            }
+        }
+    }
+    
+    std::array<std::uint8_t, 16> Finalize()
+    {
+        const auto messageBitCount = static_cast<std::uint64_t>(mMessageSize) * 8;
+        
+        const std::uint8_t padding = 0x80;
+        Update(&padding, 1);
+        
+        const std::uint8_t zero = 0;
+        while (mMessageSize % 64 != 56)
+        {
+            Update(&zero, 1);
+        }
+        
+        for (int i = 0; i < 8; ++i)
+        {
+            const auto lengthByte = static_cast<std::uint8_t>(messageBitCount >> (i * 8));
+            Update(&lengthByte, 1);
+        }
+        
+        std::array<std::uint8_t, 16> digest = {};
+        for (int i = 0; i < 16; ++i)
+        {
+            digest[i] = static_cast<std::uint8_t>(mState[i / 4] >> ((i % 4) * 8));
+        }
+        return digest;
+    }
+    
+private:
+    void ProcessBlock()
+    {
+        static const std::uint32_t SHIFTS[64] =
+        {
+            7, 12, 17, 22, 7, 12, 17, 22, 7, 12, 17, 22, 7, 12, 17, 22,
+            5,  9, 14, 20, 5,  9, 14, 20, 5,  9, 14, 20, 5,  9, 14, 20,
+            4, 11, 16, 23, 4, 11, 16, 23, 4, 11, 16, 23, 4, 11, 16, 23,
+            6, 10, 15, 21, 6, 10, 15, 21, 6, 10, 15, 21, 6, 10, 15, 21
+        };
+        
+        std::uint32_t words[16];
+        for (int i = 0; i < 16; ++i)
+        {
+            words[i] = mBlock[i * 4] | (mBlock[i * 4 + 1] << 8) | (mBlock[i * 4 + 2] << 16) | (static_cast<std::uint32_t>(mBlock[i * 4 + 3]) << 24);
+        }
+        
+        auto a = mState[0], b = mState[1], c = mState[2], d = mState[3];
+        for (std::uint32_t i = 0; i < 64; ++i)
+        {
+            std::uint32_t f = 0, wordIndex = 0;
+            if (i < 16) { f = (b & c) | (~b & d); wordIndex = i; }
+            else if (i < 32) { f = (d & b) | (~d & c); wordIndex = (5 * i + 1) % 16; }
+            else if (i < 48) { f = b ^ c ^ d; wordIndex = (3 * i + 5) % 16; }
+            else { f = c ^ (b | ~d); wordIndex = (7 * i) % 16; }
+            
+            const auto constant = static_cast<std::uint32_t>(std::floor(std::fabs(std::sin(static_cast<double>(i + 1))) * 4294967296.0));
+            const auto rotated = a + f + constant + words[wordIndex];
+            a = d;
+            d = c;
+            c = b;
+            b += (rotated << SHIFTS[i]) | (rotated >> (32 - SHIFTS[i]));
+        }
+        
+        mState[0] += a; mState[1] += b; mState[2] += c; mState[3] += d;
+    }
+    
+private:
+    std::uint32_t mState[4] = { 0x67452301, 0xefcdab89, 0x98badcfe, 0x10325476 };
+    std::uint8_t mBlock[64] = {};
+    std::size_t mMessageSize = 0;
+};
+
+///------------------------------------------------------------------------------------------------
+/// FLAC hashes the interleaved samples as little endian signed integers of the stream's byte width.
+static void UpdateSampleMd5(Md5& md5, const std::int32_t sample, const int bitsPerSample)
+{
+    for (int byteIndex = 0; byteIndex < (bitsPerSample + 7)/8; ++byteIndex)
+    {
+        const auto sampleByte = static_cast<std::uint8_t>(static_cast<std::uint32_t>(sample) >> (byteIndex * 8));
+        md5.Update(&sampleByte, 1);
+    }
+}
+
+///------------------------------------------------------------------------------------------------
+/// Decodes the whole stream, converting the decoder's float output back to the (exactly
+/// representable) integer samples, and returns their MD5.
+static std::array<std::uint8_t, 16> DecodeAndHashSamples(sound::FlacDecoder& decoder, std::vector<std::int32_t>* outSamples = nullptr)
+{
+    Md5 md5;
+    const auto sampleScale = static_cast<float>(1 << (decoder.GetBitsPerSample() - 1));
+    std::vector<float> samples(4096 * decoder.GetChannelCount());
+    
+    int framesRead = 0;
+    while ((framesRead = decoder.Read(samples.data(), 4096)) > 0)
+    {
+        for (int i = 0; i < framesRead * decoder.GetChannelCount(); ++i)
+        {
+            const auto sample = static_cast<std::int32_t>(std::lround(samples[i] * sampleScale));
+            UpdateSampleMd5(md5, sample, decoder.GetBitsPerSample());
+            if (outSamples)
+            {
+                outSamples->push_back(sample);
+            }
+        }
+    }
+    
+    return md5.Finalize();
+}
+
+///------------------------------------------------------------------------------------------------
+
+class FlacBitWriter final
+{
+public:
+    void WriteBits(const std::uint32_t value, const int bitCount)
+    {
+        for (int i = bitCount - 1; i >= 0; --i)
+        {
+            if (mBitCount % 8 == 0)
+            {
+                mBytes.push_back(0);
+            }
+            mBytes.back() |= static_cast<std::uint8_t>(((value >> i) & 1) << (7 - mBitCount % 8));
+            mBitCount++;
+        }
+    }
+    
+    void WriteSignedBits(const std::int32_t value, const int bitCount)
+    {
+        WriteBits(static_cast<std::uint32_t>(value) & static_cast<std::uint32_t>((1ull << bitCount) - 1), bitCount);
+    }
+    
+    void WriteUnary(const std::uint32_t zeroCount)
+    {
+        for (std::uint32_t i = 0; i < zeroCount; ++i)
+        {
+            WriteBits(0, 1);
+        }
+        WriteBits(1, 1);
+    }
+    
+    void AlignToByte()
+    {
+        mBitCount += (8 - mBitCount % 8) % 8;
+    }
+    
+    const std::vector<std::uint8_t>& GetBytes() const { return mBytes; }
+    
+private:
+    std::vector<std::uint8_t> mBytes;
+    std::size_t mBitCount = 0;
+};
+
+///------------------------------------------------------------------------------------------------
+
+enum class ResidualPartitionCoding
+{
+    RICE,
+    RICE2,
+    ESCAPED
+};
+
+///------------------------------------------------------------------------------------------------
+/// Writes the residual with partition order 2, coding each partition as requested (escaped
+/// partitions are written in the rice coding method's escape code).
+static void WriteResidual(FlacBitWriter& bitWriter, const std::vector<std::int32_t>& residual, const int predictorOrder, const bool useRice2, const std::array<ResidualPartitionCoding, 4>& partitionCodings)
+{
+    static constexpr int PARTITION_ORDER = 2;
+    const auto partitionSampleCount = FIXTURE_BLOCK_SIZE >> PARTITION_ORDER;
+    
+    bitWriter.WriteBits(useRice2 ? 1 : 0, 2);
+    bitWriter.WriteBits(PARTITION_ORDER, 4);
+    
+    auto sampleIndex = predictorOrder;
+    for (int partitionIndex = 0; partitionIndex < (1 << PARTITION_ORDER); ++partitionIndex)
+    {
+        const auto partitionStart = sampleIndex;
+        const auto partitionEnd = (partitionIndex + 1) * partitionSampleCount;
+        
+        if (partitionCodings[partitionIndex] == ResidualPartitionCoding::ESCAPED)
+        {
+            std::int32_t maxMagnitude = 0;
+            for (int i = partitionStart; i < partitionEnd; ++i)
+            {
+                maxMagnitude = std::max(maxMagnitude, std::abs(residual[i]));
+            }
+            
+            auto rawBitCount = 1;
+            while ((1 << (rawBitCount - 1)) <= maxMagnitude)
+            {
+                rawBitCount++;
+            }
+            
+            bitWriter.WriteBits(useRice2 ? 31 : 15, useRice2 ? 5 : 4);
+            bitWriter.WriteBits(static_cast<std::uint32_t>(rawBitCount), 5);
+            for (; sampleIndex < partitionEnd; ++sampleIndex)
+            {
+                bitWriter.WriteSignedBits(residual[sampleIndex], rawBitCount);
+            }
+            continue;
+        }
+        
+        // Picks the cheapest rice parameter for the partition; rice2 partitions are forced to use
+        // a parameter that the 4 bit rice coding can't express
+        const auto zigZag = [](const std::int32_t value){ return (static_cast<std::uint32_t>(value) << 1) ^ static_cast<std::uint32_t>(value >> 31); };
+        std::uint32_t bestRiceParameter = 0;
+        std::uint64_t bestBitCount = UINT64_MAX;
+        for (std::uint32_t riceParameter = 0; riceParameter < 15; ++riceParameter)
+        {
+            std::uint64_t bitCount = 0;
+            for (int i = partitionStart; i < partitionEnd; ++i)
+            {
+                bitCount += (zigZag(residual[i]) >> riceParameter) + 1 + riceParameter;
+            }
+            if (bitCount < bestBitCount)
+            {
+                bestBitCount = bitCount;
+                bestRiceParameter = riceParameter;
+            }
+        }
+        
+        const auto riceParameter = partitionCodings[partitionIndex] == ResidualPartitionCoding::RICE2 ? 16u : bestRiceParameter;
+        bitWriter.WriteBits(riceParameter, useRice2 ? 5 : 4);
+        for (; sampleIndex < partitionEnd; ++sampleIndex)
+        {
+            const auto value = zigZag(residual[sampleIndex]);
+            bitWriter.WriteUnary(value >> riceParameter);
+            bitWriter.WriteBits(value & ((1u << riceParameter) - 1), static_cast<int>(riceParameter));
+        }
+    }
+}
+
+///------------------------------------------------------------------------------------------------
+
+static void WriteFixedSubframe(FlacBitWriter& bitWriter, const std::vector<std::int32_t>& samples, const int bitsPerSample, const std::array<ResidualPartitionCoding, 4>& partitionCodings)
+{
+    static constexpr int ORDER = 2;
+    
+    bitWriter.WriteBits(0, 1);
+    bitWriter.WriteBits(8 + ORDER, 6);
+    bitWriter.WriteBits(0, 1);
+    
+    std::vector<std::int32_t> residual(samples.size());
+    for (int i = 0; i < ORDER; ++i)
+    {
+        bitWriter.WriteSignedBits(samples[i], bitsPerSample);
+    }
+    for (std::size_t i = ORDER; i < samples.size(); ++i)
+    {
+        residual[i] = samples[i] - (2 * samples[i - 1] - samples[i - 2]);
+    }
+    
+    WriteResidual(bitWriter, residual, ORDER, false, partitionCodings);
+}
+
+///------------------------------------------------------------------------------------------------
+
+static void WriteLpcSubframe(FlacBitWriter& bitWriter, const std::vector<std::int32_t>& samples, const int bitsPerSample, const bool useRice2, const std::array<ResidualPartitionCoding, 4>& partitionCodings)
+{
+    static constexpr int COEFFICIENT_PRECISION = 12;
+    static constexpr int SHIFT = 10;
+    static constexpr std::int32_t COEFFICIENTS[] = { 1843, -1126, 245 };
+    static constexpr int ORDER = static_cast<int>(std::size(COEFFICIENTS));
+    
+    bitWriter.WriteBits(0, 1);
+    bitWriter.WriteBits(32 + ORDER - 1, 6);
+    bitWriter.WriteBits(0, 1);
+    
+    for (int i = 0; i < ORDER; ++i)
+    {
+        bitWriter.WriteSignedBits(samples[i], bitsPerSample);
+    }
+    
+    bitWriter.WriteBits(COEFFICIENT_PRECISION - 1, 4);
+    bitWriter.WriteSignedBits(SHIFT, 5);
+    for (const auto coefficient: COEFFICIENTS)
+    {
+        bitWriter.WriteSignedBits(coefficient, COEFFICIENT_PRECISION);
+    }
+    
+    std::vector<std::int32_t> residual(samples.size());
+    for (std::size_t i = ORDER; i < samples.size(); ++i)
+    {
+        std::int64_t prediction = 0;
+        for (int j = 0; j < ORDER; ++j)
+        {
+            prediction += static_cast<std::int64_t>(COEFFICIENTS[j]) * samples[i - 1 - j];
+        }
+        residual[i] = samples[i] - static_cast<std::int32_t>(prediction >> SHIFT);
+    }
+    
+    WriteResidual(bitWriter, residual, ORDER, useRice2, partitionCodings);
+}
+
+///------------------------------------------------------------------------------------------------
+/// Writes a 16 bit stereo flac file made only of fixed and LPC subframes, covering rice, rice2
+/// and escaped residual partitions as well as independent and mid/side coded frames. Returns the
+/// file path, and the encoded (interleaved) samples through outSamples.
+static std::string WritePredictedFlacFile(const int blockCount, std::vector<std::int32_t>& outSamples)
+{
+    // Two detuned tones with a little deterministic noise, so that residuals aren't trivially small
+    std::uint32_t noiseSeed = 1234;
+    const auto nextNoise = [&](){ noiseSeed = noiseSeed * 1664525u + 1013904223u; return static_cast<std::int32_t>(noiseSeed >> 24) - 128; };
+    
+    outSamples.clear();
+    for (int i = 0; i < blockCount * FIXTURE_BLOCK_SIZE; ++i)
+    {
+        outSamples.push_back(static_cast<std::int32_t>(12000.0 * std::sin(i * 0.05)) + nextNoise());
+        outSamples.push_back(static_cast<std::int32_t>(9000.0 * std::sin(i * 0.031 + 1.0)) + nextNoise());
+    }
+    
+    Md5 md5;
+    for (const auto sample: outSamples)
+    {
+        UpdateSampleMd5(md5, sample, FIXTURE_BITS_PER_SAMPLE);
+    }
+    const auto md5Signature = md5.Finalize();
+    
+    FlacBitWriter bitWriter;
+    for (const auto marker: { 'f', 'L', 'a', 'C' })
+    {
+        bitWriter.WriteBits(static_cast<std::uint32_t>(marker), 8);
+    }
+    
+    // Last metadata block, STREAMINFO
+    bitWriter.WriteBits(1, 1);
+    bitWriter.WriteBits(0, 7);
+    bitWriter.WriteBits(34, 24);
+    bitWriter.WriteBits(FIXTURE_BLOCK_SIZE, 16);
+    bitWriter.WriteBits(FIXTURE_BLOCK_SIZE, 16);
+    bitWriter.WriteBits(0, 24);
+    bitWriter.WriteBits(0, 24);
+    bitWriter.WriteBits(FIXTURE_SAMPLE_RATE, 20);
+    bitWriter.WriteBits(FIXTURE_CHANNEL_COUNT - 1, 3);
+    bitWriter.WriteBits(FIXTURE_BITS_PER_SAMPLE - 1, 5);
+    bitWriter.WriteBits(0, 4);
+    bitWriter.WriteBits(static_cast<std::uint32_t>(blockCount * FIXTURE_BLOCK_SIZE), 32);
+    for (const auto md5Byte: md5Signature)
+    {
+        bitWriter.WriteBits(md5Byte, 8);
+    }
+    
+    using Coding = ResidualPartitionCoding;
+    for (int blockIndex = 0; blockIndex < blockCount; ++blockIndex)
+    {
+        std::vector<std::int32_t> left, right;
+        for (int i = 0; i < FIXTURE_BLOCK_SIZE; ++i)
+        {
+            left.push_back(outSamples[(blockIndex * FIXTURE_BLOCK_SIZE + i) * 2]);
+            right.push_back(outSamples[(blockIndex * FIXTURE_BLOCK_SIZE + i) * 2 + 1]);
+        }
+        
+        // Odd blocks are mid/side coded
+        const auto isMidSide = blockIndex % 2 == 1;
+        
+        // Sync code, 8 bit (block size - 1) at the header's end, sample rate and sample size from
+        // the stream info, frame number, block size - 1, header crc
+        bitWriter.WriteBits(0xFFF8, 16);
+        bitWriter.WriteBits(6, 4);
+        bitWriter.WriteBits(0, 4);
+        bitWriter.WriteBits(isMidSide ? 10 : 1, 4);
+        bitWriter.WriteBits(0, 3);
+        bitWriter.WriteBits(0, 1);
+        bitWriter.WriteBits(static_cast<std::uint32_t>(blockIndex), 8);
+        bitWriter.WriteBits(FIXTURE_BLOCK_SIZE - 1, 8);
+        bitWriter.WriteBits(0, 8);
+        
+        if (isMidSide)
+        {
+            std::vector<std::int32_t> mid, side;
+            for (int i = 0; i < FIXTURE_BLOCK_SIZE; ++i)
+            {
+                mid.push_back((left[i] + right[i]) >> 1);
+                side.push_back(left[i] - right[i]);
+            }
+            
+            // The side channel carries an extra bit
+            WriteLpcSubframe(bitWriter, mid, FIXTURE_BITS_PER_SAMPLE, true, { Coding::RICE, Coding::RICE2, Coding::ESCAPED, Coding::RICE });
+            WriteFixedSubframe(bitWriter, side, FIXTURE_BITS_PER_SAMPLE + 1, { Coding::ESCAPED, Coding::RICE, Coding::RICE, Coding::ESCAPED });
+        }
+        else
+        {
+            WriteFixedSubframe(bitWriter, left, FIXTURE_BITS_PER_SAMPLE, { Coding::RICE, Coding::RICE, Coding::ESCAPED, Coding::RICE });
+            WriteLpcSubframe(bitWriter, right, FIXTURE_BITS_PER_SAMPLE, false, { Coding::RICE, Coding::ESCAPED, Coding::RICE, Coding::RICE });
+        }
+        
+        // Frame crc
+        bitWriter.AlignToByte();
+        bitWriter.WriteBits(0, 16);
+    }
+    
+    const auto filePath = (std::filesystem::temp_directory_path() / "flac_decoder_test.flac").string();
+    std::ofstream file(filePath, std::ios::out | std::ios::binary | std::ios::trunc);
+    file.write(reinterpret_cast<const char*>(bitWriter.GetBytes().data()), static_cast<std::streamsize>(bitWriter.GetBytes().size()));
+    return filePath;
+}
+
+///------------------------------------------------------------------------------------------------
+
+TEST(FlacDecoderTests, TestMd5MatchesReferenceDigests)
+{
+    const auto hashString = [](const std::string& message)
+    {
+        Md5 md5;
+        md5.Update(reinterpret_cast<const std::uint8_t*>(message.data()), message.size());
+        return md5.Finalize();
+    };
+    
+    EXPECT_EQ(hashString(""), (std::array<std::uint8_t, 16>{ 0xd4, 0x1d, 0x8c, 0xd9, 0x8f, 0x00, 0xb2, 0x04, 0xe9, 0x80, 0x09, 0x98, 0xec, 0xf8, 0x42, 0x7e }));
+    EXPECT_EQ(hashString("The quick brown fox jumps over the lazy dog"), (std::array<std::uint8_t, 16>{ 0x9e, 0x10, 0x7d, 0x9d, 0x37, 0x2b, 0xb6, 0x82, 0x6b, 0xd8, 0x1d, 0x35, 0x42, 0xa4, 0x19, 0xd6 }));
+}
+
+TEST(FlacDecoderTests, TestFixedAndLpcSubframesDecodeBitExactly)
+{
+    static constexpr int BLOCK_COUNT = 6;
+    
+    std::vector<std::int32_t> encodedSamples;
+    sound::FlacDecoder decoder;
+    ASSERT_TRUE(decoder.Open(WritePredictedFlacFile(BLOCK_COUNT, encodedSamples)));
+    EXPECT_EQ(decoder.GetSampleRate(), FIXTURE_SAMPLE_RATE);
+    EXPECT_EQ(decoder.GetChannelCount(), FIXTURE_CHANNEL_COUNT);
+    EXPECT_EQ(decoder.GetBitsPerSample(), FIXTURE_BITS_PER_SAMPLE);
+    EXPECT_EQ(decoder.GetTotalFrameCount(), BLOCK_COUNT * FIXTURE_BLOCK_SIZE);
+    
+    std::vector<std::int32_t> decodedSamples;
+    EXPECT_EQ(DecodeAndHashSamples(decoder, &decodedSamples), decoder.GetMd5Signature());
+    EXPECT_EQ(decodedSamples, encodedSamples);
+    
+    // Decoding again after a rewind yields the same samples
+    decoder.Rewind();
+    EXPECT_EQ(DecodeAndHashSamples(decoder), decoder.GetMd5Signature());
+}
+
+TEST(FlacDecoderTests, TestShippedMusicDecodesToItsStreamInfoMd5)
+{
+    auto trackCount = 0;
+    for (const auto& entry: std::filesystem::directory_iterator(resources::ResourceLoadingService::RES_MUSIC_ROOT))
+    {
+        if (entry.path().extension() != ".flac")
+        {
+            continue;
+        }
+        
+        sound::FlacDecoder decoder;
+        ASSERT_TRUE(decoder.Open(entry.path().string()));
+        EXPECT_EQ(DecodeAndHashSamples(decoder), decoder.GetMd5Signature()) << entry.path().string();
+        trackCount++;
+    }
+    
+    EXPECT_GT(trackCount, 0);
+}
+
+///------------------------------------------------------------------------------------------------
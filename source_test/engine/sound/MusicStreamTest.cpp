@@ -0,0 +1,124 @@
+///------------------------------------------------------------------------------------------------
+///  MusicStreamTest.cpp
+///  Predators
+///
+///  Created by Alex Koukoulas on 01/05/2024
+///------------------------------------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+#include <engine/sound/MusicStream.h>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+///------------------------------------------------------------------------------------------------
+
+static constexpr int SOURCE_SAMPLE_RATE = 24000;
+static constexpr int SOURCE_BLOCK_SIZE = 64;
+static constexpr int SOURCE_FRAME_COUNT = 256;
+static constexpr int SOURCE_SAMPLE_STEP = 100;
+
+///------------------------------------------------------------------------------------------------
+/// Writes a mono, 16 bit flac file of verbatim (i.e. uncompressed) blocks of a ramp, whose sample
+/// i is i * SOURCE_SAMPLE_STEP. Checksums are left zeroed, as the decoder doesn't verify them.
+static std::string WriteRampFlacFile()
+{
+    std::vector<std::uint8_t> bytes = { 'f', 'L', 'a', 'C', 0x80, 0x00, 0x00, 34 };
+    
+    std::vector<std::uint8_t> streamInfo(34, 0);
+    streamInfo[0] = 0; streamInfo[1] = SOURCE_BLOCK_SIZE;
+    streamInfo[2] = 0; streamInfo[3] = SOURCE_BLOCK_SIZE;
+    streamInfo[10] = (SOURCE_SAMPLE_RATE >> 12) & 0xFF;
+    streamInfo[11] = (SOURCE_SAMPLE_RATE >> 4) & 0xFF;
+    streamInfo[12] = ((SOURCE_SAMPLE_RATE & 0x0F) << 4) | (0 << 1) | ((16 - 1) >> 4);
+    streamInfo[13] = (((16 - 1) & 0x0F) << 4);
+    streamInfo[17] = SOURCE_FRAME_COUNT & 0xFF;
+    streamInfo[16] = (SOURCE_FRAME_COUNT >> 8) & 0xFF;
+    bytes.insert(bytes.end(), streamInfo.begin(), streamInfo.end());
+    
+    for (int blockIndex = 0; blockIndex < SOURCE_FRAME_COUNT/SOURCE_BLOCK_SIZE; ++blockIndex)
+    {
+        // Sync code, 8 bit (block size - 1) at the header's end, sample rate from the stream info,
+        // mono, 16 bit, frame number, block size - 1, header crc
+        bytes.insert(bytes.end(), { 0xFF, 0xF8, 0x60, 0x08, static_cast<std::uint8_t>(blockIndex), SOURCE_BLOCK_SIZE - 1, 0x00 });
+        
+        // Verbatim subframe
+        bytes.push_back(0x02);
+        for (int i = 0; i < SOURCE_BLOCK_SIZE; ++i)
+        {
+            const auto sample = static_cast<std::uint16_t>((blockIndex * SOURCE_BLOCK_SIZE + i) * SOURCE_SAMPLE_STEP);
+            bytes.push_back(sample >> 8);
+            bytes.push_back(sample & 0xFF);
+        }
+        
+        // Frame crc
+        bytes.insert(bytes.end(), { 0x00, 0x00 });
+    }
+    
+    const auto filePath = (std::filesystem::temp_directory_path() / "music_stream_test.flac").string();
+    std::ofstream file(filePath, std::ios::out | std::ios::binary | std::ios::trunc);
+    file.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+    return filePath;
+}
+
+///------------------------------------------------------------------------------------------------
+
+static float GetRampSample(const double position)
+{
+    return static_cast<float>(position * SOURCE_SAMPLE_STEP/32768.0);
+}
+
+///------------------------------------------------------------------------------------------------
+
+TEST(MusicStreamTests, TestMonoStreamIsResampledToStereoAndFinishes)
+{
+    sound::MusicStream musicStream(SOURCE_SAMPLE_RATE * 2, 1.0f);
+    ASSERT_TRUE(musicStream.Open(WriteRampFlacFile(), false));
+    EXPECT_TRUE(musicStream.NeedsDecoding());
+    
+    musicStream.Decode();
+    EXPECT_FALSE(musicStream.NeedsDecoding());
+    EXPECT_FALSE(musicStream.IsFinished());
+    
+    // Every other output frame lands halfway between two source ones, up to the last source frame
+    const auto expectedFrameCount = (SOURCE_FRAME_COUNT - 1) * 2;
+    ASSERT_EQ(musicStream.GetBufferedFrameCount(), expectedFrameCount);
+    
+    std::vector<float> samples(expectedFrameCount * sound::MusicStream::CHANNEL_COUNT);
+    EXPECT_EQ(musicStream.Read(samples.data(), expectedFrameCount + 10), expectedFrameCount);
+    for (int i = 0; i < expectedFrameCount; ++i)
+    {
+        EXPECT_NEAR(samples[i * 2], GetRampSample(i * 0.5), 1e-5f);
+        EXPECT_EQ(samples[i * 2], samples[i * 2 + 1]);
+    }
+    
+    EXPECT_TRUE(musicStream.IsFinished());
+}
+
+TEST(MusicStreamTests, TestLoopedStreamWrapsAroundAcrossPartialReads)
+{
+    static constexpr int BUFFER_FRAME_CAPACITY = 100;
+    
+    sound::MusicStream musicStream(SOURCE_SAMPLE_RATE, static_cast<float>(BUFFER_FRAME_CAPACITY)/SOURCE_SAMPLE_RATE);
+    ASSERT_TRUE(musicStream.Open(WriteRampFlacFile(), true));
+    ASSERT_EQ(musicStream.GetBufferFrameCapacity(), BUFFER_FRAME_CAPACITY);
+    
+    // Reads in odd sized chunks, so that they straddle both the ring buffer's and the track's end
+    std::vector<float> samples(37 * sound::MusicStream::CHANNEL_COUNT);
+    for (int readFrameCount = 0; readFrameCount < SOURCE_FRAME_COUNT * 3; readFrameCount += 37)
+    {
+        musicStream.Decode();
+        EXPECT_EQ(musicStream.GetBufferedFrameCount(), BUFFER_FRAME_CAPACITY);
+        
+        ASSERT_EQ(musicStream.Read(samples.data(), 37), 37);
+        for (int i = 0; i < 37; ++i)
+        {
+            EXPECT_NEAR(samples[i * 2], GetRampSample((readFrameCount + i) % SOURCE_FRAME_COUNT), 1e-5f);
+        }
+    }
+    
+    EXPECT_FALSE(musicStream.IsFinished());
+}
+
+///------------------------------------------------------------------------------------------------
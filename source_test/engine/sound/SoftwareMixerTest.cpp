@@ -0,0 +1,201 @@
+///------------------------------------------------------------------------------------------------
+///  SoftwareMixerTest.cpp
+///  Predators
+///
+///  Created by Alex Koukoulas on 01/05/2024
+///------------------------------------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+#include <engine/sound/SoftwareMixer.h>
+#include "../utils/AllocationAssertions.h"
+#include <cmath>
+#include <vector>
+
+///------------------------------------------------------------------------------------------------
+
+static constexpr int SAMPLE_RATE = 48000;
+static constexpr int MAX_FRAMES_PER_MIX = 64;
+
+///------------------------------------------------------------------------------------------------
+
+static sound::SoundBuffer CreateRampSoundBuffer(const int frameCount)
+{
+    sound::SoundBuffer soundBuffer;
+    soundBuffer.mFrameCount = frameCount;
+    for (int i = 0; i < frameCount; ++i)
+    {
+        soundBuffer.mSamples.push_back(i * 0.001f);
+        soundBuffer.mSamples.push_back(-i * 0.002f);
+    }
+    return soundBuffer;
+}
+
+///------------------------------------------------------------------------------------------------
+
+static std::vector<float> MixFrames(sound::SoftwareMixer& mixer, const std::vector<int>& callbackFrameCounts)
+{
+    std::vector<float> mixedSamples;
+    for (const auto callbackFrameCount: callbackFrameCounts)
+    {
+        std::vector<float> callbackSamples(callbackFrameCount * sound::SoftwareMixer::CHANNEL_COUNT, 123.0f);
+        mixer.Mix(callbackSamples.data(), callbackFrameCount);
+        mixedSamples.insert(mixedSamples.end(), callbackSamples.begin(), callbackSamples.end());
+    }
+    return mixedSamples;
+}
+
+///------------------------------------------------------------------------------------------------
+
+TEST(SoftwareMixerTests, TestUnpitchedVoicesAreGainedAndSummed)
+{
+    sound::SoftwareMixer mixer(SAMPLE_RATE, MAX_FRAMES_PER_MIX);
+    const auto soundBuffer = CreateRampSoundBuffer(100);
+    
+    mixer.PlaySfx(soundBuffer, 0.5f);
+    mixer.PlaySfx(soundBuffer, 0.25f);
+    
+    // Odd callback sizes, larger than a mix block, to exercise the non SIMD tails
+    const auto mixedSamples = MixFrames(mixer, { 37, 150 });
+    for (int i = 0; i < 187; ++i)
+    {
+        const auto expectedLeft = i < 100 ? soundBuffer.mSamples[i * 2] * 0.75f : 0.0f;
+        const auto expectedRight = i < 100 ? soundBuffer.mSamples[i * 2 + 1] * 0.75f : 0.0f;
+        EXPECT_NEAR(mixedSamples[i * 2], expectedLeft, 1e-6f);
+        EXPECT_NEAR(mixedSamples[i * 2 + 1], expectedRight, 1e-6f);
+    }
+    
+    EXPECT_EQ(mixer.GetStats().mActiveVoiceCount, 0);
+    EXPECT_EQ(mixer.GetStats().mCallbackCount, 2);
+}
+
+TEST(SoftwareMixerTests, TestPitchedVoicesMatchScalarLinearInterpolation)
+{
+    for (const auto pitch: { 0.7f, 1.5f, 2.25f })
+    {
+        sound::SoftwareMixer mixer(SAMPLE_RATE, MAX_FRAMES_PER_MIX);
+        const auto soundBuffer = CreateRampSoundBuffer(91);
+        
+        mixer.PlaySfx(soundBuffer, 0.8f, pitch);
+        const auto mixedSamples = MixFrames(mixer, { 33, 64, 65 });
+        
+        for (int i = 0; i < 162; ++i)
+        {
+            const auto position = static_cast<double>(i) * pitch;
+            const auto frameIndex = static_cast<int>(position);
+            const auto fraction = static_cast<float>(position - frameIndex);
+            for (int channel = 0; channel < sound::SoftwareMixer::CHANNEL_COUNT; ++channel)
+            {
+                auto expectedSample = 0.0f;
+                if (frameIndex < soundBuffer.mFrameCount)
+                {
+                    const auto sample = soundBuffer.mSamples[frameIndex * 2 + channel];
+                    const auto nextSample = frameIndex + 1 < soundBuffer.mFrameCount ? soundBuffer.mSamples[(frameIndex + 1) * 2 + channel] : 0.0f;
+                    expectedSample = (sample + (nextSample - sample) * fraction) * 0.8f;
+                }
+                
+                EXPECT_NEAR(mixedSamples[i * 2 + channel], expectedSample, 1e-5f) << "pitch " << pitch << ", frame " << i;
+            }
+        }
+    }
+}
+
+TEST(SoftwareMixerTests, TestLoopedVoicesWrapAround)
+{
+    sound::SoftwareMixer mixer(SAMPLE_RATE, MAX_FRAMES_PER_MIX);
+    const auto soundBuffer = CreateRampSoundBuffer(10);
+    
+    mixer.PlaySfx(soundBuffer, 1.0f, 1.0f, true);
+    const auto mixedSamples = MixFrames(mixer, { 25 });
+    for (int i = 0; i < 25; ++i)
+    {
+        EXPECT_FLOAT_EQ(mixedSamples[i * 2], soundBuffer.mSamples[(i % 10) * 2]);
+    }
+    EXPECT_EQ(mixer.GetStats().mActiveVoiceCount, 1);
+}
+
+TEST(SoftwareMixerTests, TestOldestUnloopedVoiceIsStolenWhenAllAreBusy)
+{
+    sound::SoftwareMixer mixer(SAMPLE_RATE, MAX_FRAMES_PER_MIX);
+    const auto loopedSoundBuffer = CreateRampSoundBuffer(1000);
+    const auto unloopedSoundBuffer = CreateRampSoundBuffer(1000);
+    const auto lastSoundBuffer = CreateRampSoundBuffer(1);
+    
+    // The first voice is looped, so it's the second (and oldest unlooped) one that's stolen
+    mixer.PlaySfx(loopedSoundBuffer, 1.0f, 1.0f, true);
+    for (int i = 1; i < sound::SoftwareMixer::VOICE_COUNT; ++i)
+    {
+        mixer.PlaySfx(unloopedSoundBuffer, 0.0f);
+    }
+    mixer.PlaySfx(lastSoundBuffer, 0.0f);
+    MixFrames(mixer, { 1 });
+    
+    EXPECT_EQ(mixer.GetStats().mVoiceStealCount, 1);
+    EXPECT_EQ(mixer.GetStats().mActiveVoiceCount, sound::SoftwareMixer::VOICE_COUNT - 1);
+    
+    // Only the looped voice is left playing
+    const auto mixedSamples = MixFrames(mixer, { 1000 });
+    EXPECT_EQ(mixer.GetStats().mActiveVoiceCount, 1);
+    EXPECT_FLOAT_EQ(mixedSamples[2], loopedSoundBuffer.mSamples[2 * 2]);
+}
+
+TEST(SoftwareMixerTests, TestPausedSfxDontAdvanceAndMixIsClipped)
+{
+    sound::SoftwareMixer mixer(SAMPLE_RATE, MAX_FRAMES_PER_MIX);
+    sound::SoundBuffer loudSoundBuffer;
+    loudSoundBuffer.mFrameCount = 4;
+    loudSoundBuffer.mSamples = { 0.9f, -0.9f, 0.9f, -0.9f, 0.9f, -0.9f, 0.9f, -0.9f };
+    
+    mixer.SetSfxPaused(true);
+    mixer.PlaySfx(loudSoundBuffer);
+    mixer.PlaySfx(loudSoundBuffer);
+    auto mixedSamples = MixFrames(mixer, { 4 });
+    for (const auto sample: mixedSamples)
+    {
+        EXPECT_EQ(sample, 0.0f);
+    }
+    
+    mixer.SetSfxPaused(false);
+    mixedSamples = MixFrames(mixer, { 4 });
+    for (int i = 0; i < 4; ++i)
+    {
+        EXPECT_EQ(mixedSamples[i * 2], 1.0f);
+        EXPECT_EQ(mixedSamples[i * 2 + 1], -1.0f);
+    }
+}
+
+TEST(SoftwareMixerTests, TestCommandsPastTheQueueCapacityAreDroppedAndCounted)
+{
+    sound::SoftwareMixer mixer(SAMPLE_RATE, MAX_FRAMES_PER_MIX);
+    
+    for (int i = 0; i < 300; ++i)
+    {
+        mixer.SetMusicGain(1.0f);
+    }
+    EXPECT_EQ(mixer.GetStats().mDroppedCommandCount, 300 - 256);
+    
+    // Draining the queue makes room again
+    MixFrames(mixer, { 1 });
+    mixer.SetMusicGain(1.0f);
+    EXPECT_EQ(mixer.GetStats().mDroppedCommandCount, 300 - 256);
+}
+
+TEST(SoftwareMixerTests, TestCommandsAndMixingDontAllocate)
+{
+    sound::SoftwareMixer mixer(SAMPLE_RATE, MAX_FRAMES_PER_MIX);
+    const auto soundBuffer = CreateRampSoundBuffer(1000);
+    std::vector<float> callbackSamples(MAX_FRAMES_PER_MIX * 3 * sound::SoftwareMixer::CHANNEL_COUNT);
+    
+    EXPECT_NO_ALLOCATIONS(
+    {
+        for (int i = 0; i < sound::SoftwareMixer::VOICE_COUNT + 4; ++i)
+        {
+            mixer.PlaySfx(soundBuffer, 0.5f, 1.0f + i * 0.1f, i % 2 == 0);
+        }
+        mixer.SetMusicGain(0.5f);
+        mixer.SetSfxPaused(false);
+        mixer.Mix(callbackSamples.data(), MAX_FRAMES_PER_MIX * 3);
+    });
+    EXPECT_EQ(mixer.GetStats().mActiveVoiceCount, sound::SoftwareMixer::VOICE_COUNT);
+}
+
+///------------------------------------------------------------------------------------------------
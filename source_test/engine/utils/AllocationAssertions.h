@@ -0,0 +1,36 @@
+///------------------------------------------------------------------------------------------------
+///  AllocationAssertions.h
+///  Predators
+///
+///  Created by Alex Koukoulas on 02/05/2024
+///------------------------------------------------------------------------------------------------
+
+#ifndef AllocationAssertions_h
+#define AllocationAssertions_h
+
+///------------------------------------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+#include <engine/utils/AllocationTracking.h>
+
+///------------------------------------------------------------------------------------------------
+/// Fails the test if the given statement (or block) heap allocates on the calling thread, e.g.
+/// EXPECT_NO_ALLOCATIONS(mixer.Mix(samples.data(), frameCount));
+/// Only runs the statement in builds without ALLOCATION_TRACKING, where nothing is counted.
+#if defined(ALLOCATION_TRACKING)
+#define EXPECT_NO_ALLOCATIONS(...)                                                                     \
+    do                                                                                                 \
+    {                                                                                                  \
+        const memory::ThreadAllocationCounter threadAllocationCounter;                                 \
+        __VA_ARGS__;                                                                                   \
+        const auto allocationCounters = threadAllocationCounter.GetCounters();                         \
+        EXPECT_EQ(allocationCounters.mAllocationCount, 0) << #__VA_ARGS__ << " allocated "             \
+            << allocationCounters.mAllocatedBytes << " bytes";                                         \
+    } while (false)
+#else
+#define EXPECT_NO_ALLOCATIONS(...) do { __VA_ARGS__; } while (false)
+#endif
+
+///------------------------------------------------------------------------------------------------
+
+#endif /* AllocationAssertions_h */
@@ -0,0 +1,170 @@
+///------------------------------------------------------------------------------------------------
+///  AllocationTrackingTest.cpp
+///  Predators
+///
+///  Created by Alex Koukoulas on 02/05/2024
+///------------------------------------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+#include <engine/utils/AllocationTracking.h>
+#include <engine/utils/JobSystem.h>
+#include <memory>
+#include <vector>
+
+///------------------------------------------------------------------------------------------------
+
+#if defined(ALLOCATION_TRACKING)
+
+///------------------------------------------------------------------------------------------------
+
+// Kept out of line and volatile so that the allocations aren't optimized away
+static void AllocateAndFree(const std::size_t size, const int count)
+{
+    for (int i = 0; i < count; ++i)
+    {
+        auto* volatile block = new char[size];
+        delete[] block;
+    }
+}
+
+///------------------------------------------------------------------------------------------------
+
+TEST(AllocationTrackingTests, TestThreadCountersCountAllocationsWhileTrackingIsDisabled)
+{
+    ASSERT_FALSE(memory::IsAllocationTrackingEnabled());
+    
+    const memory::ThreadAllocationCounter threadAllocationCounter;
+    AllocateAndFree(100, 3);
+    
+    const auto allocationCounters = threadAllocationCounter.GetCounters();
+    EXPECT_EQ(allocationCounters.mAllocationCount, 3);
+    EXPECT_EQ(allocationCounters.mAllocatedBytes, 300);
+    EXPECT_EQ(allocationCounters.mDeallocationCount, 3);
+}
+
+TEST(AllocationTrackingTests, TestAllocationsAreAttributedToTheInnermostScope)
+{
+    const auto startResourcesCounters = memory::GetAllocationCounters(memory::AllocationTag::RESOURCES);
+    const auto startAudioCounters = memory::GetAllocationCounters(memory::AllocationTag::AUDIO);
+    
+    // Not attributed while tracking is disabled
+    {
+        memory::AllocationScope allocationScope(memory::AllocationTag::RESOURCES);
+        AllocateAndFree(10, 5);
+    }
+    EXPECT_EQ(memory::GetAllocationCounters(memory::AllocationTag::RESOURCES).mAllocationCount, startResourcesCounters.mAllocationCount);
+    
+    memory::SetAllocationTrackingEnabled(true);
+    {
+        memory::AllocationScope allocationScope(memory::AllocationTag::RESOURCES, "Outer");
+        AllocateAndFree(10, 2);
+        {
+            memory::AllocationScope innerAllocationScope(memory::AllocationTag::AUDIO);
+            AllocateAndFree(20, 3);
+        }
+        
+        EXPECT_EQ(memory::GetCurrentAllocationTag(), memory::AllocationTag::RESOURCES);
+        EXPECT_STREQ(memory::GetCurrentAllocationLabel(), "Outer");
+        {
+            memory::AllocationScope labelOnlyAllocationScope("Inner");
+            EXPECT_EQ(memory::GetCurrentAllocationTag(), memory::AllocationTag::RESOURCES);
+            AllocateAndFree(10, 1);
+        }
+    }
+    memory::SetAllocationTrackingEnabled(false);
+    
+    EXPECT_EQ(memory::GetCurrentAllocationTag(), memory::AllocationTag::UNTAGGED);
+    EXPECT_EQ(memory::GetCurrentAllocationLabel(), nullptr);
+    
+    const auto resourcesCounters = memory::GetAllocationCounters(memory::AllocationTag::RESOURCES);
+    EXPECT_EQ(resourcesCounters.mAllocationCount - startResourcesCounters.mAllocationCount, 3);
+    EXPECT_EQ(resourcesCounters.mAllocatedBytes - startResourcesCounters.mAllocatedBytes, 30);
+    EXPECT_EQ(resourcesCounters.mDeallocationCount - startResourcesCounters.mDeallocationCount, 3);
+    
+    const auto audioCounters = memory::GetAllocationCounters(memory::AllocationTag::AUDIO);
+    EXPECT_EQ(audioCounters.mAllocationCount - startAudioCounters.mAllocationCount, 3);
+    EXPECT_EQ(audioCounters.mAllocatedBytes - startAudioCounters.mAllocatedBytes, 60);
+}
+
+TEST(AllocationTrackingTests, TestJobsInheritTheScopeTheyWereSubmittedFrom)
+{
+    jobs::JobSystem jobSystem(2);
+    
+    memory::AllocationScope allocationScope(memory::AllocationTag::PARTICLES, "Particles");
+    std::vector<memory::AllocationTag> jobAllocationTags(8);
+    std::vector<const char*> jobAllocationLabels(8);
+    jobSystem.ParallelFor(8, [&](const int index)
+    {
+        jobAllocationTags[index] = memory::GetCurrentAllocationTag();
+        jobAllocationLabels[index] = memory::GetCurrentAllocationLabel();
+    });
+    
+    for (int i = 0; i < 8; ++i)
+    {
+        EXPECT_EQ(jobAllocationTags[i], memory::AllocationTag::PARTICLES);
+        EXPECT_STREQ(jobAllocationLabels[i], "Particles");
+    }
+}
+
+TEST(AllocationTrackingTests, TestCallSitesAreSampledAtTheGivenInterval)
+{
+    memory::ClearCallSiteSamples();
+    memory::SetCallSiteSamplingInterval(2);
+    memory::SetAllocationTrackingEnabled(true);
+    {
+        memory::AllocationScope allocationScope(memory::AllocationTag::GAME_LOGIC, "Sampled");
+        AllocateAndFree(48, 10);
+    }
+    memory::SetAllocationTrackingEnabled(false);
+    memory::SetCallSiteSamplingInterval(0);
+    
+    const auto callSiteSamples = memory::GetCallSiteSamples();
+    ASSERT_EQ(callSiteSamples.size(), 5u);
+    for (const auto& callSiteSample: callSiteSamples)
+    {
+        EXPECT_NE(callSiteSample.mCallSite, nullptr);
+        EXPECT_STREQ(callSiteSample.mLabel, "Sampled");
+        EXPECT_EQ(callSiteSample.mSize, 48u);
+        EXPECT_EQ(callSiteSample.mAllocationTag, memory::AllocationTag::GAME_LOGIC);
+    }
+    
+    memory::ClearCallSiteSamples();
+    EXPECT_TRUE(memory::GetCallSiteSamples().empty());
+}
+
+TEST(AllocationTrackingTests, TestFrameStatsAreDeltasAndOverBudgetFramesAreCounted)
+{
+    memory::SetFrameAllocationBudget(5);
+    memory::SetAllocationTrackingEnabled(true);
+    memory::EndAllocationFrame();
+    const auto startOverBudgetFrameCount = memory::GetLastFrameAllocationStats().mOverBudgetFrameCount;
+    
+    {
+        memory::AllocationScope allocationScope(memory::AllocationTag::RENDERING);
+        AllocateAndFree(16, 4);
+    }
+    memory::EndAllocationFrame();
+    
+    const auto& frameAllocationStats = memory::GetLastFrameAllocationStats();
+    EXPECT_EQ(frameAllocationStats.mPerTag[static_cast<int>(memory::AllocationTag::RENDERING)].mAllocationCount, 4);
+    EXPECT_EQ(frameAllocationStats.mPerTag[static_cast<int>(memory::AllocationTag::RENDERING)].mAllocatedBytes, 64);
+    EXPECT_EQ(frameAllocationStats.mTotal.mAllocationCount, 4);
+    EXPECT_EQ(frameAllocationStats.mOverBudgetFrameCount, startOverBudgetFrameCount);
+    
+    {
+        memory::AllocationScope allocationScope(memory::AllocationTag::RENDERING);
+        AllocateAndFree(16, 6);
+    }
+    memory::EndAllocationFrame();
+    memory::SetAllocationTrackingEnabled(false);
+    memory::SetFrameAllocationBudget(0);
+    
+    EXPECT_EQ(frameAllocationStats.mTotal.mAllocationCount, 6);
+    EXPECT_EQ(frameAllocationStats.mOverBudgetFrameCount, startOverBudgetFrameCount + 1);
+}
+
+///------------------------------------------------------------------------------------------------
+
+#endif
+
+///------------------------------------------------------------------------------------------------
@@ -0,0 +1,107 @@
+///------------------------------------------------------------------------------------------------
+///  BenchmarkTest.cpp
+///  Predators
+///
+///  Created by Alex Koukoulas on 30/04/2024
+///------------------------------------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+#include <engine/utils/Benchmark.h>
+#include <chrono>
+#include <nlohmann/json.hpp>
+#include <thread>
+#include <vector>
+
+///------------------------------------------------------------------------------------------------
+
+TEST(BenchmarkTests, TestPhasesOnlyAccountForCountersRecordedWhileActive)
+{
+    benchmark::Report report;
+    
+    benchmark::RecordResourceLoad(false);
+    
+    report.BeginPhase("loading");
+    benchmark::RecordResourceLoad(false);
+    benchmark::RecordResourceLoad(true);
+    benchmark::RecordResourceLoad(true);
+    benchmark::RecordLoadedBytes(1024);
+    benchmark::RecordShaderCompilation();
+    
+    // Beginning the next phase ends this one
+    report.BeginPhase("rendering");
+    benchmark::RecordRenderedFrame();
+    benchmark::RecordRenderedFrame();
+    report.EndPhase();
+    
+    benchmark::RecordRenderedFrame();
+    EXPECT_FALSE(report.IsPhaseActive());
+    
+    const auto& phaseResults = report.GetPhaseResults();
+    ASSERT_EQ(phaseResults.size(), 2);
+    
+    EXPECT_EQ(phaseResults[0].mName, "loading");
+    EXPECT_EQ(phaseResults[0].mCounters.mSyncLoadCount, 1);
+    EXPECT_EQ(phaseResults[0].mCounters.mAsyncLoadJobCount, 2);
+    EXPECT_EQ(phaseResults[0].mCounters.mLoadedBytes, 1024);
+    EXPECT_EQ(phaseResults[0].mCounters.mShaderCompilationCount, 1);
+    EXPECT_EQ(phaseResults[0].mCounters.mRenderedFrameCount, 0);
+    
+    EXPECT_EQ(phaseResults[1].mName, "rendering");
+    EXPECT_EQ(phaseResults[1].mCounters.mSyncLoadCount, 0);
+    EXPECT_EQ(phaseResults[1].mCounters.mRenderedFrameCount, 2);
+}
+
+TEST(BenchmarkTests, TestCountersRecordedFromOtherThreadsAreNotLost)
+{
+    static constexpr int THREAD_COUNT = 4;
+    static constexpr int LOADS_PER_THREAD = 10000;
+    
+    const auto countersBefore = benchmark::GetCounters();
+    
+    std::vector<std::thread> threads;
+    for (int i = 0; i < THREAD_COUNT; ++i)
+    {
+        threads.emplace_back([]
+        {
+            for (int j = 0; j < LOADS_PER_THREAD; ++j)
+            {
+                benchmark::RecordResourceLoad(true);
+                benchmark::RecordLoadedBytes(3);
+            }
+        });
+    }
+    
+    for (auto& thread: threads)
+    {
+        thread.join();
+    }
+    
+    const auto countersAfter = benchmark::GetCounters();
+    EXPECT_EQ(countersAfter.mAsyncLoadJobCount - countersBefore.mAsyncLoadJobCount, THREAD_COUNT * LOADS_PER_THREAD);
+    EXPECT_EQ(countersAfter.mLoadedBytes - countersBefore.mLoadedBytes, THREAD_COUNT * LOADS_PER_THREAD * 3);
+}
+
+TEST(BenchmarkTests, TestSerializedReportContainsMetadataAndPhases)
+{
+    benchmark::Report report;
+    report.SetMetadata("context", "windowed");
+    report.SetMetadata("context", "offscreen");
+    
+    report.BeginPhase("main_menu_first_frame");
+    benchmark::RecordLoadedBytes(64);
+    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    report.EndPhase();
+    
+    const auto reportJson = nlohmann::json::parse(report.Serialize());
+    EXPECT_EQ(reportJson["version"].get<int>(), benchmark::Report::REPORT_FORMAT_VERSION);
+    EXPECT_EQ(reportJson["metadata"].size(), 1);
+    EXPECT_EQ(reportJson["metadata"]["context"].get<std::string>(), "offscreen");
+    
+    ASSERT_EQ(reportJson["phases"].size(), 1);
+    EXPECT_EQ(reportJson["phases"][0]["name"].get<std::string>(), "main_menu_first_frame");
+    EXPECT_EQ(reportJson["phases"][0]["loaded_bytes"].get<long long>(), 64);
+    EXPECT_GE(reportJson["phases"][0]["wall_millis"].get<double>(), 2.0);
+    EXPECT_EQ(reportJson["total_wall_millis"].get<double>(), reportJson["phases"][0]["wall_millis"].get<double>());
+}
+
+///------------------------------------------------------------------------------------------------
@@ -0,0 +1,108 @@
+///------------------------------------------------------------------------------------------------
+///  BlockPoolTest.cpp
+///  Predators
+///
+///  Created by Alex Koukoulas on 29/04/2024
+///------------------------------------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+#include <engine/utils/BlockPool.h>
+#include "AllocationAssertions.h"
+#include <cstdint>
+#include <vector>
+
+///------------------------------------------------------------------------------------------------
+
+TEST(BlockPoolTests, TestFreedBlocksAreReusedBySameSizeAllocations)
+{
+    memory::BlockPool blockPool;
+    
+    auto* firstBlock = blockPool.Allocate(100, alignof(std::max_align_t));
+    auto* secondBlock = blockPool.Allocate(100, alignof(std::max_align_t));
+    EXPECT_NE(firstBlock, secondBlock);
+    EXPECT_EQ(blockPool.GetLiveBlockCount(), 2);
+    
+    blockPool.Deallocate(firstBlock, 100, alignof(std::max_align_t));
+    EXPECT_EQ(blockPool.Allocate(100, alignof(std::max_align_t)), firstBlock);
+    
+    auto* largerBlock = blockPool.Allocate(200, alignof(std::max_align_t));
+    EXPECT_NE(largerBlock, firstBlock);
+    EXPECT_NE(largerBlock, secondBlock);
+    EXPECT_EQ(blockPool.GetHeapAllocationCount(), 1);
+    
+    blockPool.Deallocate(firstBlock, 100, alignof(std::max_align_t));
+    blockPool.Deallocate(secondBlock, 100, alignof(std::max_align_t));
+    blockPool.Deallocate(largerBlock, 200, alignof(std::max_align_t));
+    EXPECT_EQ(blockPool.GetLiveBlockCount(), 0);
+}
+
+TEST(BlockPoolTests, TestBlocksAreAlignedAndChunksOnlyAllocatedWhenFull)
+{
+    static constexpr std::size_t BLOCK_SIZE = 40;
+    static constexpr std::size_t BLOCK_COUNT = 1000;
+    
+    memory::BlockPool blockPool(4096);
+    std::vector<void*> blocks;
+    for (std::size_t i = 0; i < BLOCK_COUNT; ++i)
+    {
+        blocks.push_back(blockPool.Allocate(BLOCK_SIZE, alignof(std::max_align_t)));
+        EXPECT_EQ(reinterpret_cast<std::uintptr_t>(blocks.back()) % alignof(std::max_align_t), 0);
+    }
+    
+    const auto blocksPerChunk = 4096/((BLOCK_SIZE + memory::BlockPool::BLOCK_GRANULARITY - 1)/memory::BlockPool::BLOCK_GRANULARITY * memory::BlockPool::BLOCK_GRANULARITY);
+    EXPECT_EQ(blockPool.GetChunkCount(), (BLOCK_COUNT + blocksPerChunk - 1)/blocksPerChunk);
+    
+    for (auto* block: blocks)
+    {
+        blockPool.Deallocate(block, BLOCK_SIZE, alignof(std::max_align_t));
+    }
+}
+
+TEST(BlockPoolTests, TestLargeAndOveralignedBlocksGoToTheHeap)
+{
+    memory::BlockPool blockPool(4096);
+    
+    auto* largeBlock = blockPool.Allocate(4096, alignof(std::max_align_t));
+    auto* overalignedBlock = blockPool.Allocate(64, 256);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(overalignedBlock) % 256, 0);
+    EXPECT_EQ(blockPool.GetChunkCount(), 0);
+    EXPECT_EQ(blockPool.GetHeapAllocationCount(), 2);
+    
+    blockPool.Deallocate(largeBlock, 4096, alignof(std::max_align_t));
+    blockPool.Deallocate(overalignedBlock, 64, 256);
+    EXPECT_EQ(blockPool.GetLiveBlockCount(), 0);
+}
+
+TEST(BlockPoolTests, TestSharedObjectsKeepTheirPoolAlive)
+{
+    std::shared_ptr<std::vector<int>> pooledVector;
+    std::weak_ptr<memory::BlockPool> weakBlockPool;
+    {
+        auto blockPool = std::make_shared<memory::BlockPool>();
+        weakBlockPool = blockPool;
+        pooledVector = std::allocate_shared<std::vector<int>>(memory::BlockPoolAllocator<std::vector<int>>(blockPool), 16, 1);
+    }
+    
+    EXPECT_FALSE(weakBlockPool.expired());
+    EXPECT_EQ(weakBlockPool.lock()->GetLiveBlockCount(), 1);
+    
+    pooledVector.reset();
+    EXPECT_TRUE(weakBlockPool.expired());
+}
+
+TEST(BlockPoolTests, TestAllocationsFromExistingChunksDontHitTheHeap)
+{
+    memory::BlockPool blockPool(4096);
+    blockPool.Deallocate(blockPool.Allocate(64, alignof(std::max_align_t)), 64, alignof(std::max_align_t));
+    
+    EXPECT_NO_ALLOCATIONS(
+    {
+        for (int i = 0; i < 10; ++i)
+        {
+            auto* block = blockPool.Allocate(64, alignof(std::max_align_t));
+            blockPool.Deallocate(block, 64, alignof(std::max_align_t));
+        }
+    });
+}
+
+///------------------------------------------------------------------------------------------------
@@ -0,0 +1,209 @@
+///------------------------------------------------------------------------------------------------
+///  DataFileSerializationTest.cpp
+///  Predators
+///
+///  Created by Alex Koukoulas on 12/04/2024
+///------------------------------------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+#include <engine/utils/BaseDataFileDeserializer.h>
+#include <engine/utils/BaseDataFileSerializer.h>
+#include <engine/utils/Logging.h>
+#include <chrono>
+
+///------------------------------------------------------------------------------------------------
+
+static constexpr int BENCHMARK_ITERATIONS = 100;
+
+///------------------------------------------------------------------------------------------------
+
+static nlohmann::json CreateLateGameStoryState()
+{
+    nlohmann::json storyState;
+    
+    for (int i = 0; i < 60; ++i)
+    {
+        storyState["current_story_player_deck"].push_back(i % 45);
+        storyState["next_top_player_deck"].push_back(i % 45);
+        storyState["next_bot_player_deck"].push_back((i * 7) % 45);
+    }
+    
+    for (int i = 0; i < 12; ++i)
+    {
+        storyState["current_story_artifacts"].push_back({{ "artifact_name", "artifact_" + std::to_string(i) }, { "stack_size", i % 3 + 1 }});
+        storyState["story_deleted_cards"].push_back(i * 3);
+    }
+    
+    for (int i = 0; i < 4; ++i)
+    {
+        storyState["story_player_card_stat_modifiers"][std::to_string(i)] = i - 2;
+    }
+    
+    storyState["current_story_health"] = 43;
+    storyState["story_max_health"] = 60;
+    storyState["story_seed"] = 1234567;
+    storyState["current_story_map_node_coord"] = {{ "col", 11 }, { "row", 2 }};
+    storyState["pre_boss_mid_map_node_coord"] = {{ "col", 12 }, { "row", 2 }};
+    storyState["current_story_map_node_seed"] = 7654321;
+    storyState["current_story_map_type"] = 1;
+    storyState["current_story_mutation_level"] = 7;
+    storyState["current_story_seconds_played"] = 5230;
+    storyState["next_story_opponent_name"] = "Tyrannosaurus Rex";
+    storyState["next_story_opponent_path"] = "story_cards/dinosaurs/t_rex.png";
+    storyState["timestamp"] = 1712900000;
+    
+    return storyState;
+}
+
+///------------------------------------------------------------------------------------------------
+
+static nlohmann::json CreateLateGamePersistentState()
+{
+    nlohmann::json persistentState;
+    
+    for (int i = 0; i < 220; ++i)
+    {
+        persistentState["unlocked_card_ids"].push_back(i);
+        persistentState["seen_opponent_spell_card_ids"].push_back(i * 2);
+        persistentState["golden_card_id_map"][std::to_string(i)] = i % 5 == 0;
+    }
+    
+    for (int i = 0; i < 40; ++i)
+    {
+        persistentState["successful_transaction_ids"].push_back("transaction_" + std::to_string(1000000 + i));
+        persistentState["unlocked_achievements"].push_back("achievement_" + std::to_string(i));
+        persistentState["seen_tutorials"].push_back("tutorial_" + std::to_string(i));
+    }
+    
+    for (int i = 0; i <= 10; ++i)
+    {
+        persistentState["mutation_level_victories"].push_back(i * 2);
+        persistentState["mutation_level_best_times"].push_back(1500 + i * 100);
+    }
+    
+    persistentState["currency_coins"] = 123456789LL;
+    persistentState["games_finished_count"] = 312;
+    persistentState["total_seconds_played"] = 965432;
+    persistentState["next_card_pack_seed"] = 998877;
+    persistentState["audio_enabled"] = true;
+    persistentState["tutorials_enabled"] = false;
+    persistentState["timestamp"] = 1712900000;
+    
+    return persistentState;
+}
+
+///------------------------------------------------------------------------------------------------
+
+static void BenchmarkDataFileFormat(const std::string& stateName, const nlohmann::json& state, const serial::DataFileFormat dataFileFormat)
+{
+    std::string fileContents;
+    nlohmann::json deserializedState;
+    
+    auto saveStart = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < BENCHMARK_ITERATIONS; ++i)
+    {
+        fileContents = serial::SerializeDataFileContents(state, dataFileFormat);
+    }
+    auto saveMicros = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::high_resolution_clock::now() - saveStart).count()/static_cast<float>(BENCHMARK_ITERATIONS);
+    
+    auto loadStart = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < BENCHMARK_ITERATIONS; ++i)
+    {
+        EXPECT_TRUE(serial::DeserializeDataFileContents(fileContents, dataFileFormat, serial::CheckSumValidationBehavior::VALIDATE_CHECKSUM, deserializedState));
+    }
+    auto loadMicros = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::high_resolution_clock::now() - loadStart).count()/static_cast<float>(BENCHMARK_ITERATIONS);
+    
+    EXPECT_EQ(deserializedState, state);
+    LOG(logging::LogType::INFO, "%s (%s): %d bytes, save %.1fus, load %.1fus", stateName.c_str(), serial::GetDataFileExtension(dataFileFormat), static_cast<int>(fileContents.size()), saveMicros, loadMicros);
+}
+
+///------------------------------------------------------------------------------------------------
+
+TEST(DataFileSerializationTests, TestJsonAndBinaryFormatsRoundTrip)
+{
+    auto storyState = CreateLateGameStoryState();
+    
+    for (auto dataFileFormat: { serial::DataFileFormat::JSON, serial::DataFileFormat::BINARY })
+    {
+        nlohmann::json deserializedState;
+        EXPECT_TRUE(serial::DeserializeDataFileContents(serial::SerializeDataFileContents(storyState, dataFileFormat), dataFileFormat, serial::CheckSumValidationBehavior::VALIDATE_CHECKSUM, deserializedState));
+        EXPECT_EQ(deserializedState, storyState);
+    }
+}
+
+TEST(DataFileSerializationTests, TestJsonChecksumStillValidatesAfterTrailingNewline)
+{
+    auto storyState = CreateLateGameStoryState();
+    
+    nlohmann::json deserializedState;
+    EXPECT_TRUE(serial::DeserializeDataFileContents(serial::SerializeDataFileContents(storyState, serial::DataFileFormat::JSON) + "\n", serial::DataFileFormat::JSON, serial::CheckSumValidationBehavior::VALIDATE_CHECKSUM, deserializedState));
+    EXPECT_EQ(deserializedState, storyState);
+}
+
+TEST(DataFileSerializationTests, TestCorruptedDataFilesAreRejected)
+{
+    auto persistentState = CreateLateGamePersistentState();
+    
+    for (auto dataFileFormat: { serial::DataFileFormat::JSON, serial::DataFileFormat::BINARY })
+    {
+        auto fileContents = serial::SerializeDataFileContents(persistentState, dataFileFormat);
+        
+        auto corruptedFileContents = fileContents;
+        corruptedFileContents[fileContents.size()/2] ^= 0x1;
+        
+        nlohmann::json deserializedState;
+        EXPECT_FALSE(serial::DeserializeDataFileContents(corruptedFileContents, dataFileFormat, serial::CheckSumValidationBehavior::VALIDATE_CHECKSUM, deserializedState));
+        EXPECT_FALSE(serial::DeserializeDataFileContents(fileContents.substr(0, fileContents.size() - 1), dataFileFormat, serial::CheckSumValidationBehavior::VALIDATE_CHECKSUM, deserializedState));
+    }
+    
+    nlohmann::json deserializedState;
+    EXPECT_FALSE(serial::DeserializeDataFileContents("", serial::DataFileFormat::BINARY, serial::CheckSumValidationBehavior::VALIDATE_CHECKSUM, deserializedState));
+    EXPECT_FALSE(serial::DeserializeDataFileContents("", serial::DataFileFormat::JSON, serial::CheckSumValidationBehavior::VALIDATE_CHECKSUM, deserializedState));
+}
+
+TEST(DataFileSerializationTests, TestOnlyMutatedSectionsAreRewrittenOnFlush)
+{
+    serial::BaseDataFileSerializer serializer("data_file_serialization_test", serial::DataFileType::PERSISTENCE_FILE_TYPE, serial::DataFileOpeningBehavior::DELAY_DATA_FILE_OPENING_TILL_FLUSH);
+    serializer.GetMutableStateSection("currency_coins") = 10;
+    serializer.GetMutableStateSection("unlocked_card_ids") = std::vector<int>({1, 2});
+    serializer.FlushStateToFile();
+    EXPECT_FALSE(serializer.IsDirty());
+    
+    EXPECT_EQ(serializer.GetState().at("currency_coins"), 10);
+    EXPECT_FALSE(serializer.IsDirty());
+    
+    serializer.GetMutableStateSection("currency_coins") = 20;
+    EXPECT_TRUE(serializer.IsDirty());
+    serializer.FlushStateToFile();
+    
+    {
+        serial::BaseDataFileDeserializer deserializer("data_file_serialization_test", serial::DataFileType::PERSISTENCE_FILE_TYPE, serial::WarnOnFileNotFoundBehavior::WARN, serial::CheckSumValidationBehavior::VALIDATE_CHECKSUM);
+        EXPECT_EQ(deserializer.GetState().at("currency_coins"), 20);
+        EXPECT_EQ(deserializer.GetState().at("unlocked_card_ids"), std::vector<int>({1, 2}));
+    }
+    
+    serializer.ClearState();
+    serializer.GetMutableStateSection("unlocked_card_ids") = std::vector<int>({3});
+    serializer.FlushStateToFile();
+    
+    {
+        serial::BaseDataFileDeserializer deserializer("data_file_serialization_test", serial::DataFileType::PERSISTENCE_FILE_TYPE, serial::WarnOnFileNotFoundBehavior::WARN, serial::CheckSumValidationBehavior::VALIDATE_CHECKSUM);
+        EXPECT_EQ(deserializer.GetState().count("currency_coins"), 0U);
+        EXPECT_EQ(deserializer.GetState().at("unlocked_card_ids"), std::vector<int>({3}));
+    }
+}
+
+// Benchmark only, run with --gtest_also_run_disabled_tests
+TEST(DataFileSerializationTests, DISABLED_TestSaveAndLoadTimesForLateGameProfile)
+{
+    auto storyState = CreateLateGameStoryState();
+    auto persistentState = CreateLateGamePersistentState();
+    
+    for (auto dataFileFormat: { serial::DataFileFormat::JSON, serial::DataFileFormat::BINARY })
+    {
+        BenchmarkDataFileFormat("story", storyState, dataFileFormat);
+        BenchmarkDataFileFormat("persistent", persistentState, dataFileFormat);
+    }
+}
+
+///------------------------------------------------------------------------------------------------
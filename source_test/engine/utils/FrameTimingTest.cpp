@@ -0,0 +1,108 @@
+///------------------------------------------------------------------------------------------------
+///  FrameTimingTest.cpp
+///  Predators
+///
+///  Created by Alex Koukoulas on 27/04/2024
+///------------------------------------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+#include <engine/utils/FrameTiming.h>
+
+///------------------------------------------------------------------------------------------------
+
+static constexpr float TEST_STEP_MILLIS = 1000.0f/60.0f;
+static constexpr int TEST_MAX_STEPS_PER_FRAME = 4;
+
+///------------------------------------------------------------------------------------------------
+
+TEST(FrameTimingTests, TestFixedTimestepRunsOneStepPerFrameAtTheStepRate)
+{
+    timing::FixedTimestepAccumulator fixedTimestepAccumulator(TEST_STEP_MILLIS, TEST_MAX_STEPS_PER_FRAME);
+    
+    auto totalStepCount = 0;
+    for (int i = 0; i < 600; ++i)
+    {
+        totalStepCount += fixedTimestepAccumulator.Advance(TEST_STEP_MILLIS);
+    }
+    
+    EXPECT_NEAR(totalStepCount, 600, 1);
+}
+
+TEST(FrameTimingTests, TestFixedTimestepIsIndependentOfRefreshRate)
+{
+    timing::FixedTimestepAccumulator accumulatorAt60Hz(TEST_STEP_MILLIS, TEST_MAX_STEPS_PER_FRAME);
+    timing::FixedTimestepAccumulator accumulatorAt120Hz(TEST_STEP_MILLIS, TEST_MAX_STEPS_PER_FRAME);
+    
+    auto stepCountAt60Hz = 0;
+    auto stepCountAt120Hz = 0;
+    auto framesWithoutStepsAt120Hz = 0;
+    for (int i = 0; i < 60; ++i)
+    {
+        stepCountAt60Hz += accumulatorAt60Hz.Advance(1000.0f/60.0f);
+    }
+    for (int i = 0; i < 120; ++i)
+    {
+        const auto stepCount = accumulatorAt120Hz.Advance(1000.0f/120.0f);
+        stepCountAt120Hz += stepCount;
+        framesWithoutStepsAt120Hz += stepCount == 0 ? 1 : 0;
+        EXPECT_LE(stepCount, 1);
+    }
+    
+    // One second of game time in both cases, with every other 120Hz frame only interpolating
+    EXPECT_NEAR(stepCountAt60Hz, 60, 1);
+    EXPECT_NEAR(stepCountAt120Hz, 60, 1);
+    EXPECT_NEAR(framesWithoutStepsAt120Hz, 60, 1);
+}
+
+TEST(FrameTimingTests, TestFixedTimestepInterpolationAlphaTracksLeftoverTime)
+{
+    timing::FixedTimestepAccumulator fixedTimestepAccumulator(TEST_STEP_MILLIS, TEST_MAX_STEPS_PER_FRAME);
+    
+    EXPECT_EQ(fixedTimestepAccumulator.Advance(TEST_STEP_MILLIS * 0.25f), 0);
+    EXPECT_NEAR(fixedTimestepAccumulator.GetInterpolationAlpha(), 0.25f, 1e-4f);
+    
+    EXPECT_EQ(fixedTimestepAccumulator.Advance(TEST_STEP_MILLIS * 1.5f), 1);
+    EXPECT_NEAR(fixedTimestepAccumulator.GetInterpolationAlpha(), 0.75f, 1e-4f);
+}
+
+TEST(FrameTimingTests, TestFixedTimestepSlowFramesAreCappedAtMaxSteps)
+{
+    timing::FixedTimestepAccumulator fixedTimestepAccumulator(TEST_STEP_MILLIS, TEST_MAX_STEPS_PER_FRAME);
+    
+    // A one second hitch only catches up on max steps, and doesn't cause catch up steps in the frames after it
+    EXPECT_EQ(fixedTimestepAccumulator.Advance(1000.0f), TEST_MAX_STEPS_PER_FRAME);
+    EXPECT_GT(fixedTimestepAccumulator.GetDiscardedMillis(), 1000.0f - (TEST_MAX_STEPS_PER_FRAME + 1) * TEST_STEP_MILLIS);
+    EXPECT_LE(fixedTimestepAccumulator.Advance(TEST_STEP_MILLIS), 2);
+    EXPECT_EQ(fixedTimestepAccumulator.Advance(TEST_STEP_MILLIS), 1);
+    
+    fixedTimestepAccumulator.SetMaxStepsPerFrame(1);
+    EXPECT_EQ(fixedTimestepAccumulator.Advance(1000.0f), 1);
+}
+
+TEST(FrameTimingTests, TestFramePacingStatsCountMissedVsyncs)
+{
+    timing::FramePacingStats framePacingStats;
+    framePacingStats.SetVsyncMillis(1000.0f/60.0f);
+    
+    framePacingStats.RecordFrame(16.6f);
+    framePacingStats.RecordFrame(16.8f);
+    framePacingStats.RecordFrame(33.3f);
+    framePacingStats.RecordFrame(50.0f);
+    framePacingStats.RecordFrame(500.0f);
+    
+    EXPECT_EQ(framePacingStats.GetFrameCount(), 5);
+    EXPECT_EQ(framePacingStats.GetMissedVsyncCount(), 0 + 0 + 1 + 2 + 29);
+    EXPECT_FLOAT_EQ(framePacingStats.GetWorstFrameMillis(), 500.0f);
+    
+    const auto& frameTimeHistogram = framePacingStats.GetFrameTimeHistogram();
+    EXPECT_EQ(frameTimeHistogram[8], 2);
+    EXPECT_EQ(frameTimeHistogram[16], 1);
+    EXPECT_EQ(frameTimeHistogram[timing::FramePacingStats::HISTOGRAM_BUCKET_COUNT - 1], 2);
+    
+    framePacingStats.Reset();
+    EXPECT_EQ(framePacingStats.GetFrameCount(), 0);
+    EXPECT_EQ(framePacingStats.GetMissedVsyncCount(), 0);
+    EXPECT_EQ(framePacingStats.GetAverageFrameMillis(), 0.0f);
+}
+
+///------------------------------------------------------------------------------------------------
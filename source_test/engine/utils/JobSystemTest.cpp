@@ -0,0 +1,135 @@
+///------------------------------------------------------------------------------------------------
+///  JobSystemTest.cpp
+///  Predators
+///
+///  Created by Alex Koukoulas on 28/04/2024
+///------------------------------------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+#include <engine/utils/JobSystem.h>
+#include <engine/utils/Logging.h>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <thread>
+#include <vector>
+
+///------------------------------------------------------------------------------------------------
+
+// Roughly the per scene cost of updating a particle heavy scene
+static float SimulateSceneUpdate(const int sceneIndex)
+{
+    auto result = 0.0f;
+    for (int i = 0; i < 200000; ++i)
+    {
+        result += std::sin(static_cast<float>(i + sceneIndex));
+    }
+    return result;
+}
+
+///------------------------------------------------------------------------------------------------
+
+TEST(JobSystemTests, TestParallelForRunsEveryIndexExactlyOnce)
+{
+    jobs::JobSystem jobSystem(3);
+    
+    for (const auto batchSize: { 1, 7, 1000 })
+    {
+        std::vector<std::atomic<int>> runCounts(1000);
+        jobSystem.ParallelFor(static_cast<int>(runCounts.size()), [&](const int index){ runCounts[index]++; }, batchSize);
+        
+        for (const auto& runCount: runCounts)
+        {
+            EXPECT_EQ(runCount.load(), 1);
+        }
+    }
+    
+    jobSystem.ParallelFor(0, [](const int){ FAIL(); });
+}
+
+TEST(JobSystemTests, TestWaitReturnsOnceAllGroupJobsHaveFinished)
+{
+    jobs::JobSystem jobSystem(2);
+    
+    std::atomic<int> finishedJobCount(0);
+    jobs::JobGroup jobGroup;
+    for (int i = 0; i < 64; ++i)
+    {
+        jobSystem.Submit([&]
+        {
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+            finishedJobCount++;
+        }, &jobGroup);
+    }
+    
+    jobSystem.Wait(jobGroup);
+    EXPECT_TRUE(jobGroup.IsDone());
+    EXPECT_EQ(finishedJobCount.load(), 64);
+}
+
+TEST(JobSystemTests, TestNestedForkJoinCompletesWithASingleWorker)
+{
+    jobs::JobSystem jobSystem(1);
+    
+    std::atomic<int> innerRunCount(0);
+    jobSystem.ParallelFor(8, [&](const int)
+    {
+        jobSystem.ParallelFor(8, [&](const int){ innerRunCount++; });
+    });
+    
+    EXPECT_EQ(innerRunCount.load(), 64);
+}
+
+TEST(JobSystemTests, TestWaitsAreNotStuckBehindLongRunningJobs)
+{
+    jobs::JobSystem jobSystem(1);
+    
+    // Occupies the only worker until released
+    std::atomic<bool> releaseLongRunningJob(false);
+    std::atomic<bool> longRunningJobFinished(false);
+    jobSystem.Submit([&]
+    {
+        while (!releaseLongRunningJob)
+        {
+            std::this_thread::yield();
+        }
+        longRunningJobFinished = true;
+    });
+    
+    std::atomic<int> runCount(0);
+    jobSystem.ParallelFor(16, [&](const int){ runCount++; });
+    EXPECT_EQ(runCount.load(), 16);
+    
+    releaseLongRunningJob = true;
+    while (!longRunningJobFinished)
+    {
+        std::this_thread::yield();
+    }
+}
+
+// Benchmark only, run with --gtest_also_run_disabled_tests
+TEST(JobSystemTests, DISABLED_TestParallelSceneUpdateTimes)
+{
+    static constexpr int SCENE_COUNT = 8;
+    
+    jobs::JobSystem jobSystem;
+    std::vector<float> results(SCENE_COUNT);
+    
+    auto serialStart = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < SCENE_COUNT; ++i)
+    {
+        results[i] = SimulateSceneUpdate(i);
+    }
+    auto serialMicros = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::high_resolution_clock::now() - serialStart).count();
+    
+    const auto serialResults = results;
+    
+    auto parallelStart = std::chrono::high_resolution_clock::now();
+    jobSystem.ParallelFor(SCENE_COUNT, [&](const int index){ results[index] = SimulateSceneUpdate(index); });
+    auto parallelMicros = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::high_resolution_clock::now() - parallelStart).count();
+    
+    EXPECT_EQ(results, serialResults);
+    LOG(logging::LogType::INFO, "%d scene updates: serial %dus, parallel on %d workers %dus", SCENE_COUNT, static_cast<int>(serialMicros), jobSystem.GetWorkerThreadCount(), static_cast<int>(parallelMicros));
+}
+
+///------------------------------------------------------------------------------------------------
@@ -0,0 +1,268 @@
+///------------------------------------------------------------------------------------------------
+///  LoggingTest.cpp
+///  Predators
+///
+///  Created by Alex Koukoulas on 26/04/2024
+///------------------------------------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+#include <engine/utils/Logging.h>
+#include <chrono>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+///------------------------------------------------------------------------------------------------
+
+static constexpr int BENCHMARK_ITERATIONS = 100000;
+
+///------------------------------------------------------------------------------------------------
+
+struct CapturedMessage
+{
+    logging::LogType mLogType;
+    logging::LogCategory mLogCategory;
+    std::string mMessage;
+};
+
+///------------------------------------------------------------------------------------------------
+
+class LoggingTests : public testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        logging::Flush();
+        logging::SetLogSink([this](const logging::LogType logType, const logging::LogCategory logCategory, const char* message)
+        {
+            std::lock_guard<std::mutex> lock(mCapturedMessagesMutex);
+            mCapturedMessages.push_back({ logType, logCategory, message });
+        });
+    }
+    
+    void TearDown() override
+    {
+        logging::Flush();
+        logging::SetLogSink(nullptr);
+        logging::SetMinLogType(logging::LogType::INFO);
+        for (int i = 0; i < static_cast<int>(logging::LogCategory::COUNT); ++i)
+        {
+            logging::SetLogCategoryEnabled(static_cast<logging::LogCategory>(i), true);
+        }
+    }
+    
+    std::vector<CapturedMessage> FlushAndGetCapturedMessages()
+    {
+        logging::Flush();
+        std::lock_guard<std::mutex> lock(mCapturedMessagesMutex);
+        return mCapturedMessages;
+    }
+    
+protected:
+    std::mutex mCapturedMessagesMutex;
+    std::vector<CapturedMessage> mCapturedMessages;
+};
+
+///------------------------------------------------------------------------------------------------
+
+TEST_F(LoggingTests, TestMessagesAreFormattedAndDeliveredInOrder)
+{
+    LOG(logging::LogType::INFO, "Loaded %d assets in %.1fs", 12, 1.5f);
+    LOG_CATEGORY(logging::LogCategory::RESOURCES, logging::LogType::WARNING, "Missing %s", "card_42.png");
+    
+    const auto capturedMessages = FlushAndGetCapturedMessages();
+    ASSERT_EQ(capturedMessages.size(), 2U);
+    EXPECT_EQ(capturedMessages[0].mMessage, "Loaded 12 assets in 1.5s");
+    EXPECT_EQ(capturedMessages[0].mLogCategory, logging::LogCategory::GENERAL);
+    EXPECT_EQ(capturedMessages[1].mMessage, "Missing card_42.png");
+    EXPECT_EQ(capturedMessages[1].mLogType, logging::LogType::WARNING);
+    EXPECT_EQ(capturedMessages[1].mLogCategory, logging::LogCategory::RESOURCES);
+}
+
+TEST_F(LoggingTests, TestMessagesBelowMinLogTypeAreFilteredOut)
+{
+    logging::SetMinLogType(logging::LogType::WARNING);
+    EXPECT_FALSE(logging::IsLogEnabled(logging::LogCategory::GENERAL, logging::LogType::INFO));
+    
+    LOG(logging::LogType::INFO, "Filtered out");
+    LOG(logging::LogType::WARNING, "Kept");
+    
+    const auto capturedMessages = FlushAndGetCapturedMessages();
+    ASSERT_EQ(capturedMessages.size(), 1U);
+    EXPECT_EQ(capturedMessages[0].mMessage, "Kept");
+}
+
+TEST_F(LoggingTests, TestDisabledCategoriesAreFilteredOut)
+{
+    logging::SetLogCategoryEnabled(logging::LogCategory::GAME_ACTIONS, false);
+    
+    LOG_CATEGORY(logging::LogCategory::GAME_ACTIONS, logging::LogType::INFO, "Filtered out");
+    LOG_CATEGORY(logging::LogCategory::GAME_ACTIONS, logging::LogType::ERROR, "Filtered out");
+    LOG_CATEGORY(logging::LogCategory::RENDERING, logging::LogType::INFO, "Kept");
+    
+    const auto capturedMessages = FlushAndGetCapturedMessages();
+    ASSERT_EQ(capturedMessages.size(), 1U);
+    EXPECT_EQ(capturedMessages[0].mMessage, "Kept");
+}
+
+TEST_F(LoggingTests, TestRepeatedMessagesAreCollapsed)
+{
+    for (int i = 0; i < 100; ++i)
+    {
+        LOG(logging::LogType::WARNING, "Uniform array size exceeded");
+    }
+    LOG(logging::LogType::INFO, "Done");
+    
+    const auto capturedMessages = FlushAndGetCapturedMessages();
+    ASSERT_EQ(capturedMessages.size(), 3U);
+    EXPECT_EQ(capturedMessages[0].mMessage, "Uniform array size exceeded");
+    EXPECT_EQ(capturedMessages[1].mMessage, "(last message repeated 99 more times)");
+    EXPECT_EQ(capturedMessages[1].mLogType, logging::LogType::WARNING);
+    EXPECT_EQ(capturedMessages[2].mMessage, "Done");
+}
+
+TEST_F(LoggingTests, TestErrorsAndLongMessagesAreWrittenAfterEarlierMessages)
+{
+    const std::string longMessage(1000, 'x');
+    
+    LOG(logging::LogType::INFO, "First");
+    LOG(logging::LogType::INFO, "%s", longMessage.c_str());
+    LOG(logging::LogType::ERROR, "Error %d", 3);
+    
+    // No Flush, errors are written synchronously
+    std::lock_guard<std::mutex> lock(mCapturedMessagesMutex);
+    ASSERT_EQ(mCapturedMessages.size(), 3U);
+    EXPECT_EQ(mCapturedMessages[0].mMessage, "First");
+    EXPECT_EQ(mCapturedMessages[1].mMessage, longMessage);
+    EXPECT_EQ(mCapturedMessages[2].mMessage, "Error 3");
+}
+
+TEST_F(LoggingTests, TestMessagesFromMultipleThreadsAreAllDelivered)
+{
+    static constexpr int THREAD_COUNT = 4;
+    static constexpr int MESSAGES_PER_THREAD = 200;
+    
+    std::vector<std::thread> threads;
+    for (int threadIndex = 0; threadIndex < THREAD_COUNT; ++threadIndex)
+    {
+        threads.emplace_back([=]
+        {
+            for (int i = 0; i < MESSAGES_PER_THREAD; ++i)
+            {
+                LOG(logging::LogType::INFO, "Thread %d message %d", threadIndex, i);
+            }
+        });
+    }
+    
+    for (auto& thread: threads)
+    {
+        thread.join();
+    }
+    
+    const auto capturedMessages = FlushAndGetCapturedMessages();
+    ASSERT_EQ(capturedMessages.size(), static_cast<std::size_t>(THREAD_COUNT * MESSAGES_PER_THREAD));
+    
+    // Each thread's messages keep their relative order
+    std::vector<int> nextMessageIndices(THREAD_COUNT, 0);
+    for (const auto& capturedMessage: capturedMessages)
+    {
+        int threadIndex = -1, messageIndex = -1;
+        ASSERT_EQ(sscanf(capturedMessage.mMessage.c_str(), "Thread %d message %d", &threadIndex, &messageIndex), 2);
+        EXPECT_EQ(messageIndex, nextMessageIndices[threadIndex]++);
+    }
+}
+
+TEST_F(LoggingTests, TestFilteredOutLogsDoNotEvaluateTheirArguments)
+{
+    logging::SetMinLogType(logging::LogType::WARNING);
+    
+    auto evaluationCount = 0;
+    const auto countEvaluation = [&]{ return ++evaluationCount; };
+    LOG(logging::LogType::INFO, "Filtered out %d", countEvaluation());
+    LOG(logging::LogType::WARNING, "Kept %d", countEvaluation());
+    
+    EXPECT_EQ(evaluationCount, 1);
+    const auto capturedMessages = FlushAndGetCapturedMessages();
+    ASSERT_EQ(capturedMessages.size(), 1U);
+    EXPECT_EQ(capturedMessages[0].mMessage, "Kept 1");
+}
+
+TEST_F(LoggingTests, TestMessagesAreWrittenWithoutFlushing)
+{
+    LOG(logging::LogType::INFO, "Written by the logging thread");
+    
+    // The logging thread is woken up by the message, rather than polling
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (std::chrono::steady_clock::now() < deadline)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mCapturedMessagesMutex);
+            if (!mCapturedMessages.empty())
+            {
+                break;
+            }
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    
+    std::lock_guard<std::mutex> lock(mCapturedMessagesMutex);
+    ASSERT_EQ(mCapturedMessages.size(), 1U);
+    EXPECT_EQ(mCapturedMessages[0].mMessage, "Written by the logging thread");
+}
+
+TEST_F(LoggingTests, TestMessagesFromExitedThreadsAreDeliveredAfterTheirBuffersAreReused)
+{
+    static constexpr int THREAD_COUNT = 64;
+    
+    // Each thread exits (and has its buffer drained) before the next one starts, so they all share the first one's buffer
+    for (int threadIndex = 0; threadIndex < THREAD_COUNT; ++threadIndex)
+    {
+        std::thread([=]
+        {
+            LOG(logging::LogType::INFO, "Thread %d", threadIndex);
+        }).join();
+        logging::Flush();
+    }
+    
+    const auto capturedMessages = FlushAndGetCapturedMessages();
+    ASSERT_EQ(capturedMessages.size(), static_cast<std::size_t>(THREAD_COUNT));
+    for (int threadIndex = 0; threadIndex < THREAD_COUNT; ++threadIndex)
+    {
+        EXPECT_EQ(capturedMessages[threadIndex].mMessage, "Thread " + std::to_string(threadIndex));
+    }
+}
+
+// Benchmark only, run with --gtest_also_run_disabled_tests
+TEST_F(LoggingTests, DISABLED_TestFilteredOutLogOverhead)
+{
+    logging::SetLogSink([](const logging::LogType, const logging::LogCategory, const char*){});
+    logging::SetLogCategoryEnabled(logging::LogCategory::RENDERING, false);
+    
+    auto filteredOutStart = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < BENCHMARK_ITERATIONS; ++i)
+    {
+        LOG_CATEGORY(logging::LogCategory::RENDERING, logging::LogType::INFO, "Frame %d took %.3fms", i, 16.6f);
+    }
+    auto filteredOutNanos = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::high_resolution_clock::now() - filteredOutStart).count()/static_cast<float>(BENCHMARK_ITERATIONS);
+    
+    // Flushed periodically so that the ring buffer never fills up and drops messages
+    auto enabledStart = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < BENCHMARK_ITERATIONS; ++i)
+    {
+        LOG_CATEGORY(logging::LogCategory::GENERAL, logging::LogType::INFO, "Frame %d took %.3fms", i, 16.6f);
+        if (i % 256 == 255)
+        {
+            logging::Flush();
+        }
+    }
+    logging::Flush();
+    auto enabledNanos = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::high_resolution_clock::now() - enabledStart).count()/static_cast<float>(BENCHMARK_ITERATIONS);
+    
+    logging::SetLogSink(nullptr);
+    LOG(logging::LogType::INFO, "Log cost: filtered out %.2fns, enabled %.2fns (%.0f messages/s)", filteredOutNanos, enabledNanos, 1e9f/enabledNanos);
+    EXPECT_LT(filteredOutNanos, enabledNanos);
+}
+
+///------------------------------------------------------------------------------------------------
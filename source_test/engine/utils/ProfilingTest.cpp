@@ -0,0 +1,192 @@
+///------------------------------------------------------------------------------------------------
+///  ProfilingTest.cpp
+///  Predators
+///
+///  Created by Alex Koukoulas on 23/04/2024
+///------------------------------------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+#include <engine/utils/Logging.h>
+#include <engine/utils/Profiling.h>
+#include <nlohmann/json.hpp>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+///------------------------------------------------------------------------------------------------
+
+static constexpr int BENCHMARK_ITERATIONS = 1000000;
+
+///------------------------------------------------------------------------------------------------
+
+static std::vector<nlohmann::json> FindZoneEvents(const std::string& zoneName)
+{
+    const auto trace = nlohmann::json::parse(profiling::ExportChromeTrace());
+    
+    std::vector<nlohmann::json> zoneEvents;
+    for (const auto& traceEvent: trace["traceEvents"])
+    {
+        if (traceEvent["ph"] == "X" && traceEvent["name"] == zoneName)
+        {
+            zoneEvents.push_back(traceEvent);
+        }
+    }
+    return zoneEvents;
+}
+
+///------------------------------------------------------------------------------------------------
+
+TEST(ProfilingTests, TestZonesAreOnlyRecordedWhileEnabled)
+{
+    profiling::SetEnabled(false);
+    {
+        PROFILE_SCOPE("ProfilingTests::DisabledZone");
+    }
+    
+    profiling::SetEnabled(true);
+    {
+        PROFILE_SCOPE("ProfilingTests::EnabledZone");
+    }
+    profiling::SetEnabled(false);
+    
+    EXPECT_TRUE(FindZoneEvents("ProfilingTests::DisabledZone").empty());
+    EXPECT_EQ(FindZoneEvents("ProfilingTests::EnabledZone").size(), 1U);
+}
+
+TEST(ProfilingTests, TestNestedZonesAreContainedInTheirParents)
+{
+    profiling::SetEnabled(true);
+    {
+        PROFILE_SCOPE("ProfilingTests::ParentZone");
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        {
+            PROFILE_SCOPE("ProfilingTests::ChildZone");
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        }
+    }
+    profiling::SetEnabled(false);
+    
+    const auto parentZones = FindZoneEvents("ProfilingTests::ParentZone");
+    const auto childZones = FindZoneEvents("ProfilingTests::ChildZone");
+    ASSERT_EQ(parentZones.size(), 1U);
+    ASSERT_EQ(childZones.size(), 1U);
+    
+    const auto& parentZone = parentZones.front();
+    const auto& childZone = childZones.front();
+    EXPECT_EQ(parentZone["tid"], childZone["tid"]);
+    EXPECT_GE(childZone["dur"].get<double>(), 2000.0);
+    EXPECT_GE(childZone["ts"].get<double>(), parentZone["ts"].get<double>());
+    EXPECT_LE(childZone["ts"].get<double>() + childZone["dur"].get<double>(), parentZone["ts"].get<double>() + parentZone["dur"].get<double>());
+}
+
+TEST(ProfilingTests, TestEachThreadGetsItsOwnNamedTrack)
+{
+    profiling::SetEnabled(true);
+    std::thread workerThread([]
+    {
+        profiling::SetCurrentThreadName("ProfilingTests Worker");
+        PROFILE_SCOPE("ProfilingTests::WorkerZone");
+    });
+    workerThread.join();
+    {
+        PROFILE_SCOPE("ProfilingTests::CallerZone");
+    }
+    profiling::SetEnabled(false);
+    
+    const auto workerZones = FindZoneEvents("ProfilingTests::WorkerZone");
+    const auto callerZones = FindZoneEvents("ProfilingTests::CallerZone");
+    ASSERT_EQ(workerZones.size(), 1U);
+    ASSERT_EQ(callerZones.size(), 1U);
+    EXPECT_NE(workerZones.front()["tid"], callerZones.front()["tid"]);
+    
+    const auto trace = nlohmann::json::parse(profiling::ExportChromeTrace());
+    
+    bool foundWorkerThreadName = false;
+    for (const auto& traceEvent: trace["traceEvents"])
+    {
+        if (traceEvent["ph"] == "M" && traceEvent["tid"] == workerZones.front()["tid"])
+        {
+            foundWorkerThreadName = traceEvent["args"]["name"] == "ProfilingTests Worker";
+        }
+    }
+    EXPECT_TRUE(foundWorkerThreadName);
+}
+
+TEST(ProfilingTests, TestTrackZonesAreExportedOnTheirOwnNamedTrack)
+{
+    const auto trackId = profiling::CreateTrack("ProfilingTests Track");
+    profiling::RecordZone(trackId, "ProfilingTests::TrackZone", 1000, 2000);
+    {
+        profiling::SetEnabled(true);
+        PROFILE_SCOPE("ProfilingTests::ThreadZone");
+        profiling::SetEnabled(false);
+    }
+    
+    const auto trackZones = FindZoneEvents("ProfilingTests::TrackZone");
+    const auto threadZones = FindZoneEvents("ProfilingTests::ThreadZone");
+    ASSERT_EQ(trackZones.size(), 1U);
+    ASSERT_EQ(threadZones.size(), 1U);
+    EXPECT_EQ(trackZones.front()["tid"], trackId);
+    EXPECT_NE(trackZones.front()["tid"], threadZones.front()["tid"]);
+    EXPECT_EQ(trackZones.front()["ts"].get<double>(), 1.0);
+    EXPECT_EQ(trackZones.front()["dur"].get<double>(), 2.0);
+    
+    const auto trace = nlohmann::json::parse(profiling::ExportChromeTrace());
+    
+    bool foundTrackName = false;
+    for (const auto& traceEvent: trace["traceEvents"])
+    {
+        if (traceEvent["ph"] == "M" && traceEvent["tid"] == trackId)
+        {
+            foundTrackName = traceEvent["args"]["name"] == "ProfilingTests Track";
+        }
+    }
+    EXPECT_TRUE(foundTrackName);
+}
+
+TEST(ProfilingTests, TestRingBufferKeepsMostRecentZones)
+{
+    profiling::SetEnabled(true);
+    std::thread workerThread([]
+    {
+        for (int i = 0; i < 100000; ++i)
+        {
+            profiling::RecordZone("ProfilingTests::RingBufferZone", i, 1);
+        }
+    });
+    workerThread.join();
+    profiling::SetEnabled(false);
+    
+    const auto ringBufferZones = FindZoneEvents("ProfilingTests::RingBufferZone");
+    ASSERT_FALSE(ringBufferZones.empty());
+    EXPECT_LT(ringBufferZones.size(), 100000U);
+    EXPECT_EQ(ringBufferZones.back()["ts"].get<double>(), 99999/1000.0);
+}
+
+// Benchmark only, run with --gtest_also_run_disabled_tests
+TEST(ProfilingTests, DISABLED_TestDisabledZoneOverhead)
+{
+    profiling::SetEnabled(false);
+    
+    auto disabledStart = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < BENCHMARK_ITERATIONS; ++i)
+    {
+        PROFILE_SCOPE("ProfilingTests::OverheadZone");
+    }
+    auto disabledNanos = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::high_resolution_clock::now() - disabledStart).count()/static_cast<float>(BENCHMARK_ITERATIONS);
+    
+    profiling::SetEnabled(true);
+    auto enabledStart = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < BENCHMARK_ITERATIONS; ++i)
+    {
+        PROFILE_SCOPE("ProfilingTests::OverheadZone");
+    }
+    auto enabledNanos = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::high_resolution_clock::now() - enabledStart).count()/static_cast<float>(BENCHMARK_ITERATIONS);
+    profiling::SetEnabled(false);
+    
+    EXPECT_LT(disabledNanos, enabledNanos);
+    LOG(logging::LogType::INFO, "Zone cost: disabled %.2fns, enabled %.2fns", disabledNanos, enabledNanos);
+}
+
+///------------------------------------------------------------------------------------------------
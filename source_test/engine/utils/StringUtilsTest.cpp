@@ -8,6 +8,7 @@
 #include <gtest/gtest.h>
 #include <engine/utils/MathUtils.h>
 #include <engine/utils/StringUtils.h>
+#include <thread>
 
 TEST(StringIsIntTests, TestCharactersAreNotInts)
 {
@@ -147,3 +148,67 @@ TEST(FloatToStringTests, TestCastingsWithDifferentPrecisions)
     EXPECT_EQ(strutils::FloatToString(1.33333f, 2), "1.33");
     EXPECT_EQ(strutils::FloatToString(1.33333f, 3), "1.333");
 }
+
+TEST(StringIdTests, TestStringIdsOnlyStoreTheirId)
+{
+    static_assert(sizeof(strutils::StringId) == sizeof(uint32_t));
+    static_assert(strutils::GetStringHash("") == 0);
+    static_assert(strutils::GetStringHash("ABCD") == 2001986);
+    
+    const std::string string = "ABCD";
+    strutils::StringId stringId(string);
+    
+    EXPECT_EQ(stringId.GetStringId(), strutils::GetStringHash("ABCD"));
+    EXPECT_EQ(stringId.GetString(), string);
+    EXPECT_EQ(&stringId.GetString(), &strutils::StringId(string).GetString());
+    EXPECT_EQ(strutils::StringId().GetString(), "");
+    EXPECT_TRUE(strutils::StringId().isEmpty());
+}
+
+TEST(StringIdTests, TestConcurrentInterning)
+{
+    const int THREAD_COUNT = 4;
+    const int STRING_COUNT = 1000;
+    
+    std::vector<std::thread> threads;
+    for (int i = 0; i < THREAD_COUNT; ++i)
+    {
+        threads.emplace_back([=]()
+        {
+            for (int j = 0; j < STRING_COUNT; ++j)
+            {
+                const auto string = "concurrent_string_" + std::to_string((i + j) % STRING_COUNT);
+                EXPECT_EQ(strutils::StringId(string).GetString(), string);
+            }
+        });
+    }
+    
+    for (auto& thread: threads)
+    {
+        thread.join();
+    }
+    
+    for (int j = 0; j < STRING_COUNT; ++j)
+    {
+        EXPECT_EQ(strutils::StringId("concurrent_string_" + std::to_string(j)).GetString(), "concurrent_string_" + std::to_string(j));
+    }
+}
+
+TEST(StringIdTests, TestLiteralStringIdsAreHashedAtCompileTime)
+{
+    constexpr strutils::StringId literalStringId("ABCD");
+    static_assert(literalStringId.GetStringId() == strutils::GetStringHash("ABCD"));
+    
+    // Interned at runtime, so resolvable regardless of which constructor was used
+    EXPECT_EQ(strutils::StringId("literal_string").GetString(), "literal_string");
+    EXPECT_EQ(strutils::StringId("literal_string"), strutils::StringId(std::string("literal_string")));
+    EXPECT_EQ(strutils::StringId("ABCD").GetString(), "ABCD");
+}
+
+TEST(StringIdTests, TestStringIdsAreTheirStringHashRegardlessOfInterningOrder)
+{
+    for (const auto& string: { std::string("interning_order_b"), std::string("interning_order_a"), std::string("interning_order_b") })
+    {
+        EXPECT_EQ(strutils::StringId(string).GetStringId(), strutils::GetStringHash(string));
+    }
+}
@@ -6,7 +6,10 @@
 ///------------------------------------------------------------------------------------------------
 
 #include <gtest/gtest.h>
+#include <engine/utils/Logging.h>
 #include <game/events/EventSystem.h>
+#include <chrono>
+#include <memory>
 
 ///------------------------------------------------------------------------------------------------
 
@@ -345,3 +348,157 @@ TEST(EventSystemTests, TestDoubleListenerRegistrationUnregistrationRegistration)
 }
 
 ///------------------------------------------------------------------------------------------------
+
+TEST(EventSystemTests, TestQueuedEventsAreOnlyDeliveredOnFlush)
+{
+    TestEventListener listener;
+    events::EventSystem::GetInstance().RegisterForEvent<TestEvent>(&listener, &TestEventListener::OnTestEvent);
+    
+    events::EventSystem::GetInstance().QueueEvent<TestEvent>(1);
+    events::EventSystem::GetInstance().QueueEvent<TestEvent>(2);
+    EXPECT_EQ(listener.GetVal(), 0);
+    
+    events::EventSystem::GetInstance().DispatchQueuedEvents();
+    EXPECT_EQ(listener.GetVal(), 2);
+    
+    events::EventSystem::GetInstance().DispatchQueuedEvents();
+    EXPECT_EQ(listener.GetVal(), 2);
+}
+
+///------------------------------------------------------------------------------------------------
+
+TEST(EventSystemTests, TestListenerDestroyedMidDispatchIsNotCalled)
+{
+    class MidDispatchDestructionEvent {};
+    
+    class MidDispatchDestructionListener final: public events::IListener
+    {
+    public:
+        void OnTestEvent(const MidDispatchDestructionEvent&)
+        {
+            mEventsListenedTo++;
+        }
+        
+        int mEventsListenedTo = 0;
+    };
+    
+    std::unique_ptr<MidDispatchDestructionListener> victimListener;
+    auto destroyerListener = events::EventSystem::GetInstance().RegisterForEvent<MidDispatchDestructionEvent>([&](const MidDispatchDestructionEvent&){ victimListener.reset(); });
+    
+    // Created after the destroyer, hence dispatched to after it
+    victimListener = std::make_unique<MidDispatchDestructionListener>();
+    events::EventSystem::GetInstance().RegisterForEvent<MidDispatchDestructionEvent>(victimListener.get(), &MidDispatchDestructionListener::OnTestEvent);
+    
+    // The victim would be dereferenced after deletion (caught by ASan) if it were still called
+    events::EventSystem::GetInstance().DispatchEvent<MidDispatchDestructionEvent>();
+    EXPECT_EQ(victimListener, nullptr);
+    EXPECT_EQ(events::EventSystem::GetInstance().GetListenerCount<MidDispatchDestructionEvent>(), 1U);
+}
+
+///------------------------------------------------------------------------------------------------
+
+TEST(EventSystemTests, TestListenerRegisteredMidDispatchReceivesSubsequentDispatches)
+{
+    class MidDispatchRegistrationEvent {};
+    
+    int lateListenerEventsListenedTo = 0;
+    std::unique_ptr<events::IListener> lateListener;
+    auto registeringListener = events::EventSystem::GetInstance().RegisterForEvent<MidDispatchRegistrationEvent>([&](const MidDispatchRegistrationEvent&)
+    {
+        if (!lateListener)
+        {
+            lateListener = events::EventSystem::GetInstance().RegisterForEvent<MidDispatchRegistrationEvent>([&](const MidDispatchRegistrationEvent&){ lateListenerEventsListenedTo++; });
+        }
+    });
+    
+    events::EventSystem::GetInstance().DispatchEvent<MidDispatchRegistrationEvent>();
+    EXPECT_EQ(lateListenerEventsListenedTo, 0);
+    
+    events::EventSystem::GetInstance().DispatchEvent<MidDispatchRegistrationEvent>();
+    EXPECT_EQ(lateListenerEventsListenedTo, 1);
+}
+
+///------------------------------------------------------------------------------------------------
+
+TEST(EventSystemTests, TestRemovedSlotReusedByAnotherListenerIsNotAffectedByTheOriginalListener)
+{
+    class SlotReuseEvent {};
+    
+    int eventsListenedToByListenerB = 0;
+    int eventsListenedToByListenerC = 0;
+    auto listenerA = events::EventSystem::GetInstance().RegisterForEvent<SlotReuseEvent>([](const SlotReuseEvent&){});
+    auto listenerB = events::EventSystem::GetInstance().RegisterForEvent<SlotReuseEvent>([&](const SlotReuseEvent&){ eventsListenedToByListenerB++; });
+    
+    events::EventSystem::GetInstance().UnregisterForEvent<SlotReuseEvent>(listenerA.get());
+    auto listenerC = events::EventSystem::GetInstance().RegisterForEvent<SlotReuseEvent>([&](const SlotReuseEvent&){ eventsListenedToByListenerC++; });
+    
+    // Neither a repeated unregistration nor the destruction of the original listener may remove the reused slot
+    events::EventSystem::GetInstance().UnregisterForEvent<SlotReuseEvent>(listenerA.get());
+    listenerA.reset();
+    
+    events::EventSystem::GetInstance().DispatchEvent<SlotReuseEvent>();
+    EXPECT_EQ(eventsListenedToByListenerB, 1);
+    EXPECT_EQ(eventsListenedToByListenerC, 1);
+    EXPECT_EQ(events::EventSystem::GetInstance().GetListenerCount<SlotReuseEvent>(), 2U);
+    
+    listenerB.reset();
+    events::EventSystem::GetInstance().DispatchEvent<SlotReuseEvent>();
+    EXPECT_EQ(eventsListenedToByListenerB, 1);
+    EXPECT_EQ(eventsListenedToByListenerC, 2);
+}
+
+///------------------------------------------------------------------------------------------------
+
+TEST(EventSystemTests, TestEventsAreDroppedWhileSuppressed)
+{
+    TestEventListener listener;
+    events::EventSystem::GetInstance().RegisterForEvent<TestEvent>(&listener, &TestEventListener::OnTestEvent);
+    
+    {
+        events::EventSystem::SuppressionScope suppressionScope;
+        {
+            events::EventSystem::SuppressionScope nestedSuppressionScope;
+        }
+        
+        events::EventSystem::GetInstance().DispatchEvent<TestEvent>(1);
+        events::EventSystem::GetInstance().QueueEvent<TestEvent>(2);
+        events::EventSystem::GetInstance().DispatchQueuedEvents();
+        EXPECT_EQ(listener.GetVal(), 0);
+    }
+    
+    events::EventSystem::GetInstance().DispatchQueuedEvents();
+    EXPECT_EQ(listener.GetVal(), 0);
+    
+    events::EventSystem::GetInstance().DispatchEvent<TestEvent>(3);
+    EXPECT_EQ(listener.GetVal(), 3);
+}
+
+///------------------------------------------------------------------------------------------------
+
+// Benchmark only, run with --gtest_also_run_disabled_tests
+TEST(EventSystemTests, DISABLED_TestDispatchCostPerListener)
+{
+    static constexpr int LISTENER_COUNT = 1000;
+    static constexpr int DISPATCH_COUNT = 1000;
+    
+    class BenchmarkEvent {};
+    
+    int eventsListenedTo = 0;
+    std::vector<std::unique_ptr<events::IListener>> listeners;
+    for (int i = 0; i < LISTENER_COUNT; ++i)
+    {
+        listeners.emplace_back(events::EventSystem::GetInstance().RegisterForEvent<BenchmarkEvent>([&](const BenchmarkEvent&){ eventsListenedTo++; }));
+    }
+    
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < DISPATCH_COUNT; ++i)
+    {
+        events::EventSystem::GetInstance().DispatchEvent<BenchmarkEvent>();
+    }
+    auto durationNanos = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::high_resolution_clock::now() - start).count();
+    
+    EXPECT_EQ(eventsListenedTo, LISTENER_COUNT * DISPATCH_COUNT);
+    LOG(logging::LogType::INFO, "Event dispatch cost: %.2fns per listener per dispatch (%d listeners)", durationNanos/static_cast<float>(LISTENER_COUNT * DISPATCH_COUNT), LISTENER_COUNT);
+}
+
+///------------------------------------------------------------------------------------------------
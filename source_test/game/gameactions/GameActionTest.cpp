@@ -1019,6 +1019,27 @@ TEST_F(GameActionTests, TestBuffedDugOutRodentsHaveCorrectModifiersPostClearingN
 }
 
 
+TEST_F(GameActionTests, TestPrecomputedEffectComponentMasksMatchEffectStrings)
+{
+    for (const auto cardId: CardDataRepository::GetInstance().GetAllCardIds())
+    {
+        const auto& cardData = CardDataRepository::GetInstance().GetCardData(cardId, 0);
+        
+        EXPECT_EQ(cardData.HasEffectComponent(effects::effect_component_masks::DRAW), strutils::StringContains(cardData.mCardEffect, effects::EFFECT_COMPONENT_DRAW));
+        EXPECT_EQ(cardData.HasEffectComponent(effects::effect_component_masks::KILL), strutils::StringContains(cardData.mCardEffect, effects::EFFECT_COMPONENT_KILL));
+        EXPECT_EQ(cardData.HasEffectComponent(effects::effect_component_masks::FAMILY), strutils::StringContains(cardData.mCardEffect, effects::EFFECT_COMPONENT_FAMILY));
+        EXPECT_EQ(cardData.HasEffectComponent(effects::effect_component_masks::CARD_TOKEN), strutils::StringContains(cardData.mCardEffect, effects::EFFECT_COMPONENT_CARD_TOKEN));
+        EXPECT_EQ(cardData.HasEffectComponent(effects::effect_component_masks::HOUND_SUMMONING), strutils::StringContains(cardData.mCardEffect, effects::EFFECT_COMPONENT_HOUND_SUMMONING));
+        EXPECT_EQ(cardData.HasEffectComponent(effects::effect_component_masks::SPELL_KILL), strutils::StringContains(cardData.mCardEffect, effects::EFFECT_COMPONENT_SPELL_KILL));
+        
+        if (!cardData.IsSpell())
+        {
+            EXPECT_EQ(cardData.mCardEffectComponentMask, effects::effect_component_masks::NONE);
+        }
+    }
+}
+
+
 int BATTLE_SIMULATION_ITERATIONS = 1000;
 //#define SIMULATE_BATTLES
 #if defined(SIMULATE_BATTLES)
@@ -1159,7 +1180,7 @@ void GameActionTests::SimulateBattle(strutils::StringId topDeckFamilyName /*= st
         statistics << "Games won: Top=" << 100.0f * gamesTopPlayerWonCounter/static_cast<float>(BATTLE_SIMULATION_ITERATIONS) << "%  Bot=" << 100.0f * (BATTLE_SIMULATION_ITERATIONS - gamesTopPlayerWonCounter)/static_cast<float>(BATTLE_SIMULATION_ITERATIONS) << "%\n";
         statistics << "Average weight ammo per game on victory: " << weightAmmoCounter/static_cast<float>(BATTLE_SIMULATION_ITERATIONS) << "\n";
         statistics << "Average turns per game: " << turnCounter/static_cast<float>(BATTLE_SIMULATION_ITERATIONS) << "\n";
-        logging::Log(logging::LogType::INFO, "Card Family battle: %s vs %s:\n%s", topDeckFamilyName.GetString().c_str(), botDeckFamilyName.GetString().c_str(), statistics.str().c_str());
+        LOG(logging::LogType::INFO, "Card Family battle: %s vs %s:\n%s", topDeckFamilyName.GetString().c_str(), botDeckFamilyName.GetString().c_str(), statistics.str().c_str());
     }
     else
     {
@@ -1231,7 +1252,7 @@ void GameActionTests::SimulateBattle(strutils::StringId topDeckFamilyName /*= st
             statistics << row.str();
         }
         
-        logging::Log(logging::LogType::INFO, "Game Stats: \n%s", statistics.str().c_str());
+        LOG(logging::LogType::INFO, "Game Stats: \n%s", statistics.str().c_str());
     }
 }
 
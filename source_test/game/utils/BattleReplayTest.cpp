@@ -0,0 +1,250 @@
+///------------------------------------------------------------------------------------------------
+///  BattleReplayTest.cpp
+///  Predators
+///
+///  Created by Alex Koukoulas on 10/04/2024
+///------------------------------------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+#include <engine/utils/BaseDataFileDeserializer.h>
+#include <engine/utils/MathUtils.h>
+#include <game/events/EventSystem.h>
+#include <game/BoardState.h>
+#include <game/Cards.h>
+#include <game/DataRepository.h>
+#include <game/GameConstants.h>
+#include <game/GameRuleEngine.h>
+#include <game/gameactions/GameActionEngine.h>
+#include <game/gameactions/PlayCardGameAction.h>
+#include <game/gameactions/PlayerActionGenerationEngine.h>
+#include <game/utils/BattleReplay.h>
+#include <game/utils/BattleSerializer.h>
+#include <memory>
+
+///------------------------------------------------------------------------------------------------
+
+static const strutils::StringId IDLE_GAME_ACTION_NAME = strutils::StringId("IdleGameAction");
+static const strutils::StringId NEXT_PLAYER_GAME_ACTION_NAME = strutils::StringId("NextPlayerGameAction");
+static const strutils::StringId PLAY_CARD_GAME_ACTION_NAME = strutils::StringId("PlayCardGameAction");
+static const strutils::StringId GAME_OVER_GAME_ACTION_NAME = strutils::StringId("GameOverGameAction");
+
+static constexpr int REPLAY_VERIFICATION_BATTLE_COUNT = 10;
+
+///------------------------------------------------------------------------------------------------
+
+class BattleReplayTests : public testing::Test
+{
+protected:
+    BattleReplayTests()
+    {
+        DataRepository::GetInstance().ResetStoryData();
+        CardDataRepository::GetInstance().LoadCardData(false);
+    }
+    
+    void TearDown() override
+    {
+        CardDataRepository::GetInstance().ClearCardData();
+    }
+    
+    struct RecordedBattle
+    {
+        BattleReplay mReplay;
+        BoardState mFinalBoardState;
+        int mFinalControlSeed = 0;
+    };
+    
+    RecordedBattle SimulateRecordedBattle()
+    {
+        auto seed = math::RandomInt();
+        BoardState boardState;
+        GameRuleEngine ruleEngine(&boardState);
+        GameActionEngine actionEngine(GameActionEngine::EngineOperationMode::HEADLESS, seed, &boardState, nullptr, &ruleEngine);
+        PlayerActionGenerationEngine playerActionGenerationEngine(&ruleEngine, &actionEngine, PlayerActionGenerationEngine::ActionGenerationType::OPTIMISED);
+        
+        for (int i = 0; i < 2; ++i)
+        {
+            boardState.GetPlayerStates().emplace_back();
+            boardState.GetPlayerStates().back().mPlayerDeckCards = CardDataRepository::GetInstance().GetAllCardIds();
+            boardState.GetPlayerStates().back().mPlayerInitialDeckCards = boardState.GetPlayerStates().back().mPlayerDeckCards;
+            boardState.GetPlayerStates().back().mPlayerHealth = game_constants::TOP_PLAYER_DEFAULT_HEALTH;
+            boardState.GetPlayerStates().back().mPlayerWeightAmmoLimit = game_constants::TOP_PLAYER_DEFAULT_WEIGHT_LIMIT;
+        }
+        
+        BattleSerializer battleSerializer(seed, boardState.GetPlayerStates()[0].mPlayerDeckCards, boardState.GetPlayerStates()[1].mPlayerDeckCards, boardState.GetPlayerStates()[0].mPlayerHealth, boardState.GetPlayerStates()[1].mPlayerHealth, boardState);
+        
+        actionEngine.AddGameAction(NEXT_PLAYER_GAME_ACTION_NAME);
+        while (actionEngine.GetActiveGameActionName() != GAME_OVER_GAME_ACTION_NAME)
+        {
+            if (actionEngine.GetActiveGameActionName() == IDLE_GAME_ACTION_NAME)
+            {
+                playerActionGenerationEngine.DecideAndPushNextActions(&boardState);
+            }
+            actionEngine.Update(0);
+        }
+        
+        return { battleSerializer.GetReplay(), boardState, math::GetControlSeed() };
+    }
+};
+
+///------------------------------------------------------------------------------------------------
+
+TEST_F(BattleReplayTests, TestSerializationRoundTripPreservesActionsAndKeyframes)
+{
+    BattleReplay replay(1234, {1, 2, 3}, {4, 5}, 30, 25);
+    
+    BoardState boardState;
+    boardState.GetPlayerStates().emplace_back();
+    boardState.GetPlayerStates().emplace_back();
+    boardState.GetActivePlayerIndex() = 1;
+    boardState.GetTurnCounter() = 7;
+    boardState.GetPlayerStates()[0].mPlayerHeldCards = {3, 1};
+    boardState.GetPlayerStates()[0].mPlayerHealth = -2;
+    boardState.GetPlayerStates()[1].mPlayerBoardCards = {5};
+    boardState.GetPlayerStates()[1].mPlayerBoardCardStatOverrides = {{{CardStatType::DAMAGE, -1}, {CardStatType::WEIGHT, 2}}};
+    boardState.GetPlayerStates()[1].mBoardCardIndicesToDestroy = {0};
+    boardState.GetPlayerStates()[1].mBoardModifiers.mBoardModifierMask = effects::board_modifier_masks::KILL_NEXT;
+    boardState.GetPlayerStates()[1].mHasHeroCard = true;
+    
+    replay.RecordAction(NEXT_PLAYER_GAME_ACTION_NAME, {});
+    replay.RecordKeyframe(1, boardState, 42);
+    replay.RecordAction(PLAY_CARD_GAME_ACTION_NAME, {{ PlayCardGameAction::LAST_PLAYED_CARD_INDEX_PARAM, "2" }});
+    replay.RecordAction(PLAY_CARD_GAME_ACTION_NAME, {{ "textParam", "007" }, { "negativeParam", "-15" }});
+    
+    auto bytes = replay.Serialize();
+    
+    BattleReplay deserializedReplay;
+    ASSERT_TRUE(BattleReplay::Deserialize(bytes, deserializedReplay));
+    
+    EXPECT_EQ(deserializedReplay.GetGameSeed(), 1234);
+    EXPECT_EQ(deserializedReplay.GetTopPlayerDeck(), std::vector<int>({1, 2, 3}));
+    EXPECT_EQ(deserializedReplay.GetBotPlayerDeck(), std::vector<int>({4, 5}));
+    EXPECT_EQ(deserializedReplay.GetTopPlayerStartingHealth(), 30);
+    EXPECT_EQ(deserializedReplay.GetBotPlayerStartingHealth(), 25);
+    
+    ASSERT_EQ(deserializedReplay.GetActions().size(), 3U);
+    EXPECT_EQ(deserializedReplay.GetActions()[0].mActionName, NEXT_PLAYER_GAME_ACTION_NAME);
+    EXPECT_TRUE(deserializedReplay.GetActions()[0].mExtraActionParams.empty());
+    EXPECT_EQ(deserializedReplay.GetActions()[1].mExtraActionParams.at(PlayCardGameAction::LAST_PLAYED_CARD_INDEX_PARAM), "2");
+    EXPECT_EQ(deserializedReplay.GetActions()[2].mExtraActionParams.at("textParam"), "007");
+    EXPECT_EQ(deserializedReplay.GetActions()[2].mExtraActionParams.at("negativeParam"), "-15");
+    
+    ASSERT_EQ(deserializedReplay.GetKeyframes().size(), 1U);
+    EXPECT_EQ(deserializedReplay.GetKeyframes()[0].mActionIndex, 1U);
+    EXPECT_EQ(deserializedReplay.GetKeyframes()[0].mControlSeed, 42);
+    EXPECT_EQ(BattleReplay::SerializeBoardState(deserializedReplay.GetKeyframes()[0].mBoardState), BattleReplay::SerializeBoardState(boardState));
+    
+    EXPECT_EQ(deserializedReplay.Serialize(), bytes);
+}
+
+TEST_F(BattleReplayTests, TestTruncatedOrCorruptedReplayIsRejected)
+{
+    BattleReplay replay(1, {1}, {2}, 30, 30);
+    replay.RecordAction(NEXT_PLAYER_GAME_ACTION_NAME, {});
+    auto bytes = replay.Serialize();
+    
+    BattleReplay deserializedReplay;
+    for (auto i = 0U; i < bytes.size(); ++i)
+    {
+        EXPECT_FALSE(BattleReplay::Deserialize(std::vector<uint8_t>(bytes.begin(), bytes.begin() + i), deserializedReplay));
+    }
+    
+    auto corruptedBytes = bytes;
+    corruptedBytes[0] = 'X';
+    EXPECT_FALSE(BattleReplay::Deserialize(corruptedBytes, deserializedReplay));
+}
+
+TEST_F(BattleReplayTests, TestNearestKeyframeLookup)
+{
+    BattleReplay replay;
+    BoardState boardState;
+    
+    EXPECT_EQ(replay.FindNearestKeyframe(0), nullptr);
+    
+    replay.RecordKeyframe(0, boardState, 0);
+    for (int i = 0; i < 5; ++i) replay.RecordAction(PLAY_CARD_GAME_ACTION_NAME, {});
+    replay.RecordKeyframe(5, boardState, 0);
+    for (int i = 0; i < 5; ++i) replay.RecordAction(PLAY_CARD_GAME_ACTION_NAME, {});
+    
+    EXPECT_EQ(replay.FindNearestKeyframe(0)->mActionIndex, 0U);
+    EXPECT_EQ(replay.FindNearestKeyframe(4)->mActionIndex, 0U);
+    EXPECT_EQ(replay.FindNearestKeyframe(5)->mActionIndex, 5U);
+    EXPECT_EQ(replay.FindNearestKeyframe(9)->mActionIndex, 5U);
+}
+
+TEST_F(BattleReplayTests, TestRecordedBattlesReplayDeterministicallyFromEveryKeyframe)
+{
+    for (int i = 0; i < REPLAY_VERIFICATION_BATTLE_COUNT; ++i)
+    {
+        auto recordedBattle = SimulateRecordedBattle();
+        
+        BattleReplay replay;
+        ASSERT_TRUE(BattleReplay::Deserialize(recordedBattle.mReplay.Serialize(), replay));
+        
+        // A keyframe prior to every interval-th action, so seeking never replays more than an interval's worth of actions
+        ASSERT_FALSE(replay.GetKeyframes().empty());
+        for (auto j = 0U; j < replay.GetKeyframes().size(); ++j)
+        {
+            EXPECT_EQ(replay.GetKeyframes()[j].mActionIndex, j * BattleSerializer::REPLAY_KEYFRAME_ACTION_INTERVAL);
+        }
+        EXPECT_LT(replay.GetActions().size() - replay.GetKeyframes().back().mActionIndex, BattleSerializer::REPLAY_KEYFRAME_ACTION_INTERVAL + 1);
+        
+        EXPECT_TRUE(replay.VerifyDeterminism());
+        
+        BoardState fastForwardedBoardState;
+        int fastForwardedControlSeed = 0;
+        ASSERT_TRUE(replay.FastForward(replay.GetActions().size(), fastForwardedBoardState, fastForwardedControlSeed));
+        EXPECT_EQ(BattleReplay::SerializeBoardState(fastForwardedBoardState), BattleReplay::SerializeBoardState(recordedBattle.mFinalBoardState));
+        EXPECT_EQ(fastForwardedControlSeed, recordedBattle.mFinalControlSeed);
+    }
+}
+
+TEST_F(BattleReplayTests, TestFastForwardDoesNotAffectTheLiveBattle)
+{
+    auto recordedBattle = SimulateRecordedBattle();
+    
+    int serializableActionsListenedTo = 0;
+    auto listener = events::EventSystem::GetInstance().RegisterForEvent<events::SerializableGameActionEvent>([&](const events::SerializableGameActionEvent&){ serializableActionsListenedTo++; });
+    
+    math::SetControlSeed(1234);
+    
+    BoardState fastForwardedBoardState;
+    int fastForwardedControlSeed = 0;
+    ASSERT_TRUE(recordedBattle.mReplay.FastForward(recordedBattle.mReplay.GetActions().size(), fastForwardedBoardState, fastForwardedControlSeed));
+    EXPECT_TRUE(recordedBattle.mReplay.VerifyDeterminism());
+    
+    EXPECT_EQ(math::GetControlSeed(), 1234);
+    EXPECT_EQ(serializableActionsListenedTo, 0);
+}
+
+TEST_F(BattleReplayTests, TestActionsRecordedAfterAFlushAreWrittenByTheNextFlush)
+{
+    BoardState boardState;
+    
+    BattleSerializer battleSerializer(0, {1, 2}, {3, 4}, 30, 30, boardState);
+    battleSerializer.FlushStateToFile();
+    battleSerializer.FlushReplayToFile();
+    
+    events::EventSystem::GetInstance().DispatchEvent<events::SerializableGameActionEvent>(NEXT_PLAYER_GAME_ACTION_NAME, std::unordered_map<std::string, std::string>());
+    battleSerializer.FlushStateToFile();
+    battleSerializer.FlushReplayToFile();
+    
+    events::EventSystem::GetInstance().DispatchEvent<events::SerializableGameActionEvent>(PLAY_CARD_GAME_ACTION_NAME, std::unordered_map<std::string, std::string>({{ PlayCardGameAction::LAST_PLAYED_CARD_INDEX_PARAM, "1" }}));
+    battleSerializer.FlushStateToFile();
+    battleSerializer.FlushReplayToFile();
+    
+    // The data file only holds the battle setup, the actions are read back from the replay
+    serial::BaseDataFileDeserializer battleDeserializer("last_battle", serial::DataFileType::PERSISTENCE_FILE_TYPE, serial::WarnOnFileNotFoundBehavior::WARN, serial::CheckSumValidationBehavior::VALIDATE_CHECKSUM, serial::DEFAULT_PERSISTENCE_DATA_FILE_FORMAT);
+    const auto& battleState = battleDeserializer.GetState();
+    EXPECT_EQ(battleState.at("top_deck").get<std::vector<int>>(), std::vector<int>({1, 2}));
+    EXPECT_EQ(battleState.count("actions"), 0U);
+    
+    BattleReplay replay;
+    ASSERT_TRUE(BattleReplay::LoadFromFile(replay));
+    EXPECT_EQ(replay.GetTopPlayerDeck(), std::vector<int>({1, 2}));
+    ASSERT_EQ(replay.GetActions().size(), 2U);
+    EXPECT_EQ(replay.GetActions()[0].mActionName, NEXT_PLAYER_GAME_ACTION_NAME);
+    EXPECT_EQ(replay.GetActions()[1].mActionName, PLAY_CARD_GAME_ACTION_NAME);
+    EXPECT_EQ(replay.GetActions()[1].mExtraActionParams.at(PlayCardGameAction::LAST_PLAYED_CARD_INDEX_PARAM), "1");
+}
+
+///------------------------------------------------------------------------------------------------
@@ -0,0 +1,392 @@
+///------------------------------------------------------------------------------------------------
+///  SDLSoundUtils.cpp
+///  Predators
+///
+///  Created by Alex Koukoulas on 01/05/2024
+///-----------------------------------------------------------------------------------------------
+
+#include <algorithm>
+#include <cstring>
+#include <engine/CoreSystemsEngine.h>
+#include <engine/resloading/ResourceLoadingService.h>
+#include <engine/sound/MusicStream.h>
+#include <engine/utils/JobSystem.h>
+#include <engine/utils/Logging.h>
+#include <engine/utils/StringUtils.h>
+#include <memory>
+#include <platform_utilities/SDLSoundUtils.h>
+#include <SDL.h>
+#include <unordered_map>
+#include <vector>
+
+///-----------------------------------------------------------------------------------------------
+
+namespace sound_utils
+{
+
+///-----------------------------------------------------------------------------------------------
+
+static constexpr int PREFERRED_SAMPLE_RATE = 48000;
+static constexpr int PREFERRED_BUFFER_FRAME_COUNT = 512;
+static constexpr float MAX_SFX_VOLUME = 0.5f;
+static constexpr float ENABLED_AUDIO_MUSIC_VOLUME = 1.0f;
+static constexpr float DISABLED_AUDIO_MUSIC_VOLUME = 0.0f;
+static constexpr float FADE_SPEED = 0.00125f;
+static constexpr float DROPOUT_CHECK_INTERVAL_MILLIS = 1000.0f;
+
+///-----------------------------------------------------------------------------------------------
+
+struct AudioBackend
+{
+    ~AudioBackend()
+    {
+        // Stops the audio thread before the mixer (and everything it references) is destroyed
+        if (mAudioDevice != 0)
+        {
+            SDL_CloseAudioDevice(mAudioDevice);
+        }
+    }
+    
+    SDL_AudioDeviceID mAudioDevice = 0;
+    std::unique_ptr<sound::SoftwareMixer> mMixer;
+    std::unordered_map<std::string, std::unique_ptr<sound::SoundBuffer>> mSfxBuffers;
+    
+    // Streams are shared with their in flight decode jobs, and kept alive here for as long as
+    // the mixer may still be reading from them
+    std::shared_ptr<sound::MusicStream> mCurrentMusicStream;
+    std::shared_ptr<sound::MusicStream> mPendingMusicStream;
+    std::vector<std::shared_ptr<sound::MusicStream>> mRetiringMusicStreams;
+    
+    std::string mCurrentMusicPath;
+    std::string mPendingMusicPath;
+    std::string mQueuedMusicPath;
+    bool mQueuedMusicUnlooped = false;
+    float mMusicGain = 0.0f;
+    float mMixerMusicGain = -1.0f;
+    float mTargetMusicGain = ENABLED_AUDIO_MUSIC_VOLUME;
+    bool mAudioEnabled = true;
+    
+    float mMillisSinceDropoutCheck = 0.0f;
+    std::int64_t mReportedDropoutCount = 0;
+};
+
+static AudioBackend sAudioBackend;
+
+///-----------------------------------------------------------------------------------------------
+
+static void AudioCallback(void* userData, Uint8* stream, int byteCount)
+{
+    auto& mixer = *static_cast<AudioBackend*>(userData)->mMixer;
+    mixer.Mix(reinterpret_cast<float*>(stream), byteCount/static_cast<int>(sizeof(float) * sound::SoftwareMixer::CHANNEL_COUNT));
+}
+
+///-----------------------------------------------------------------------------------------------
+
+static const sound::SoundBuffer* LoadSfx(const std::string& sfxResPath)
+{
+    auto sfxBufferIter = sAudioBackend.mSfxBuffers.find(sfxResPath);
+    if (sfxBufferIter != sAudioBackend.mSfxBuffers.end())
+    {
+        return sfxBufferIter->second.get();
+    }
+    
+    const auto filePath = resources::ResourceLoadingService::RES_MUSIC_ROOT + sfxResPath + ".wav";
+    
+    SDL_AudioSpec wavSpec;
+    Uint8* wavData = nullptr;
+    Uint32 wavByteCount = 0;
+    if (!SDL_LoadWAV(filePath.c_str(), &wavSpec, &wavData, &wavByteCount))
+    {
+        logging::Log(logging::LogCategory::AUDIO, logging::LogType::ERROR, "Could not load sfx %s: %s", filePath.c_str(), SDL_GetError());
+        return nullptr;
+    }
+    
+    // Converted once, here, so that the mixer never has to
+    SDL_AudioCVT audioConversion;
+    if (SDL_BuildAudioCVT(&audioConversion, wavSpec.format, wavSpec.channels, wavSpec.freq, AUDIO_F32SYS, sound::SoftwareMixer::CHANNEL_COUNT, sAudioBackend.mMixer->GetSampleRate()) < 0)
+    {
+        logging::Log(logging::LogCategory::AUDIO, logging::LogType::ERROR, "Could not convert sfx %s: %s", filePath.c_str(), SDL_GetError());
+        SDL_FreeWAV(wavData);
+        return nullptr;
+    }
+    
+    std::vector<Uint8> conversionBuffer(static_cast<std::size_t>(wavByteCount) * std::max(1, audioConversion.len_mult));
+    std::memcpy(conversionBuffer.data(), wavData, wavByteCount);
+    SDL_FreeWAV(wavData);
+    
+    audioConversion.buf = conversionBuffer.data();
+    audioConversion.len = static_cast<int>(wavByteCount);
+    if (audioConversion.needed && SDL_ConvertAudio(&audioConversion) < 0)
+    {
+        logging::Log(logging::LogCategory::AUDIO, logging::LogType::ERROR, "Could not convert sfx %s: %s", filePath.c_str(), SDL_GetError());
+        return nullptr;
+    }
+    
+    const auto convertedByteCount = audioConversion.needed ? audioConversion.len_cvt : audioConversion.len;
+    
+    auto soundBuffer = std::make_unique<sound::SoundBuffer>();
+    soundBuffer->mFrameCount = convertedByteCount/static_cast<int>(sizeof(float) * sound::SoftwareMixer::CHANNEL_COUNT);
+    soundBuffer->mSamples.resize(soundBuffer->mFrameCount * sound::SoftwareMixer::CHANNEL_COUNT);
+    std::memcpy(soundBuffer->mSamples.data(), conversionBuffer.data(), soundBuffer->mSamples.size() * sizeof(float));
+    
+    return sAudioBackend.mSfxBuffers.emplace(sfxResPath, std::move(soundBuffer)).first->second.get();
+}
+
+///-----------------------------------------------------------------------------------------------
+
+static void SwitchToPendingMusicStream()
+{
+    if (sAudioBackend.mCurrentMusicStream)
+    {
+        sAudioBackend.mRetiringMusicStreams.push_back(std::move(sAudioBackend.mCurrentMusicStream));
+    }
+    
+    sAudioBackend.mCurrentMusicStream = std::move(sAudioBackend.mPendingMusicStream);
+    sAudioBackend.mCurrentMusicPath = sAudioBackend.mPendingMusicPath;
+    sAudioBackend.mPendingMusicPath.clear();
+    sAudioBackend.mMixer->SetMusicStream(sAudioBackend.mCurrentMusicStream.get());
+}
+
+///-----------------------------------------------------------------------------------------------
+
+static void UpdateMusic(const float dtMillis)
+{
+    auto& jobSystem = CoreSystemsEngine::GetInstance().GetJobSystem();
+    
+    if (sAudioBackend.mAudioEnabled && sAudioBackend.mQueuedMusicPath != sAudioBackend.mCurrentMusicPath)
+    {
+        // Fade out the current track, then wait for the first chunk of the next one to be decoded
+        if (sAudioBackend.mCurrentMusicStream && sAudioBackend.mMusicGain > 0.0f)
+        {
+            sAudioBackend.mMusicGain = std::max(0.0f, sAudioBackend.mMusicGain - dtMillis * FADE_SPEED);
+        }
+        else if (!sAudioBackend.mPendingMusicStream || sAudioBackend.mPendingMusicPath != sAudioBackend.mQueuedMusicPath)
+        {
+            auto musicStream = std::make_shared<sound::MusicStream>(sAudioBackend.mMixer->GetSampleRate());
+            sAudioBackend.mPendingMusicPath = sAudioBackend.mQueuedMusicPath;
+            if (musicStream->Open(sAudioBackend.mQueuedMusicPath, !sAudioBackend.mQueuedMusicUnlooped))
+            {
+                sAudioBackend.mPendingMusicStream = musicStream;
+                musicStream->RequestDecode(jobSystem);
+            }
+            else
+            {
+                // Stops the music, rather than retrying every update
+                sAudioBackend.mPendingMusicStream.reset();
+                SwitchToPendingMusicStream();
+            }
+        }
+        else if (!sAudioBackend.mPendingMusicStream->IsDecoding())
+        {
+            SwitchToPendingMusicStream();
+            sAudioBackend.mMusicGain = 0.0f;
+        }
+    }
+    else if (sAudioBackend.mMusicGain < sAudioBackend.mTargetMusicGain)
+    {
+        sAudioBackend.mMusicGain = std::min(sAudioBackend.mTargetMusicGain, sAudioBackend.mMusicGain + dtMillis * FADE_SPEED);
+    }
+    
+    if (sAudioBackend.mMusicGain != sAudioBackend.mMixerMusicGain)
+    {
+        sAudioBackend.mMixer->SetMusicGain(sAudioBackend.mMusicGain);
+        sAudioBackend.mMixerMusicGain = sAudioBackend.mMusicGain;
+    }
+    
+    if (sAudioBackend.mCurrentMusicStream && sAudioBackend.mCurrentMusicStream->NeedsDecoding())
+    {
+        sAudioBackend.mCurrentMusicStream->RequestDecode(jobSystem);
+    }
+    
+    sound::MusicStream* retiredMusicStream = nullptr;
+    while (sAudioBackend.mMixer->TryPopRetiredMusicStream(retiredMusicStream))
+    {
+        auto& retiringMusicStreams = sAudioBackend.mRetiringMusicStreams;
+        retiringMusicStreams.erase(std::remove_if(retiringMusicStreams.begin(), retiringMusicStreams.end(), [=](const std::shared_ptr<sound::MusicStream>& musicStream){ return musicStream.get() == retiredMusicStream; }), retiringMusicStreams.end());
+    }
+}
+
+///-----------------------------------------------------------------------------------------------
+
+static void ReportDropouts(const float dtMillis)
+{
+    sAudioBackend.mMillisSinceDropoutCheck += dtMillis;
+    if (sAudioBackend.mMillisSinceDropoutCheck < DROPOUT_CHECK_INTERVAL_MILLIS)
+    {
+        return;
+    }
+    sAudioBackend.mMillisSinceDropoutCheck = 0.0f;
+    
+    const auto mixerStats = sAudioBackend.mMixer->GetStats();
+    const auto dropoutCount = mixerStats.mCallbackOverrunCount + mixerStats.mMusicUnderrunCount;
+    if (dropoutCount > sAudioBackend.mReportedDropoutCount)
+    {
+        logging::Log(logging::LogCategory::AUDIO, logging::LogType::WARNING, "Audio dropouts: %d callback overruns, %d music underruns (callback avg %.1fus, max %.1fus, budget %.1fus)", static_cast<int>(mixerStats.mCallbackOverrunCount), static_cast<int>(mixerStats.mMusicUnderrunCount), mixerStats.mAverageCallbackMicros, mixerStats.mMaxCallbackMicros, mixerStats.mCallbackBudgetMicros);
+        sAudioBackend.mReportedDropoutCount = dropoutCount;
+    }
+}
+
+///-----------------------------------------------------------------------------------------------
+
+void Vibrate()
+{
+}
+
+///-----------------------------------------------------------------------------------------------
+
+void PreloadSfx(const std::string& sfxResPath)
+{
+    if (sAudioBackend.mMixer && sAudioBackend.mAudioEnabled)
+    {
+        LoadSfx(sfxResPath);
+    }
+}
+
+///------------------------------------------------------------------------------------------------
+
+void PlaySound(const std::string& soundResPath, const bool loopedSfxOrUnloopedMusic /* = false */, const float gain /* = 1.0f */, const float pitch /* = 1.0f */)
+{
+    if (!sAudioBackend.mMixer)
+    {
+        return;
+    }
+    
+    if (strutils::StringStartsWith(soundResPath, "sfx_"))
+    {
+        if (!sAudioBackend.mAudioEnabled)
+        {
+            return;
+        }
+        
+        if (const auto* soundBuffer = LoadSfx(soundResPath))
+        {
+            sAudioBackend.mMixer->PlaySfx(*soundBuffer, MAX_SFX_VOLUME * gain, pitch, loopedSfxOrUnloopedMusic);
+        }
+    }
+    else
+    {
+        // Picked up (after fading out the current track) on the next update
+        sAudioBackend.mQueuedMusicPath = resources::ResourceLoadingService::RES_MUSIC_ROOT + soundResPath + ".flac";
+        sAudioBackend.mQueuedMusicUnlooped = loopedSfxOrUnloopedMusic;
+    }
+}
+
+///------------------------------------------------------------------------------------------------
+
+void InitAudio()
+{
+    if (sAudioBackend.mMixer)
+    {
+        return;
+    }
+    
+    if (SDL_InitSubSystem(SDL_INIT_AUDIO) != 0)
+    {
+        logging::Log(logging::LogCategory::AUDIO, logging::LogType::WARNING, "Could not initialize SDL audio (%s), audio will be disabled", SDL_GetError());
+        return;
+    }
+    
+    SDL_AudioSpec desiredSpec;
+    SDL_zero(desiredSpec);
+    desiredSpec.freq = PREFERRED_SAMPLE_RATE;
+    desiredSpec.format = AUDIO_F32SYS;
+    desiredSpec.channels = sound::SoftwareMixer::CHANNEL_COUNT;
+    desiredSpec.samples = PREFERRED_BUFFER_FRAME_COUNT;
+    desiredSpec.callback = AudioCallback;
+    desiredSpec.userdata = &sAudioBackend;
+    
+    // Only the rate and buffer size may differ, as the mixer only outputs stereo floats
+    SDL_AudioSpec obtainedSpec;
+    sAudioBackend.mAudioDevice = SDL_OpenAudioDevice(nullptr, 0, &desiredSpec, &obtainedSpec, SDL_AUDIO_ALLOW_FREQUENCY_CHANGE | SDL_AUDIO_ALLOW_SAMPLES_CHANGE);
+    if (sAudioBackend.mAudioDevice == 0)
+    {
+        logging::Log(logging::LogCategory::AUDIO, logging::LogType::WARNING, "Could not open an audio device (%s), audio will be disabled", SDL_GetError());
+        return;
+    }
+    
+    // Devices open paused, so the callback can't run before the mixer exists
+    sAudioBackend.mMixer = std::make_unique<sound::SoftwareMixer>(obtainedSpec.freq, obtainedSpec.samples);
+    SDL_PauseAudioDevice(sAudioBackend.mAudioDevice, 0);
+    
+    logging::Log(logging::LogCategory::AUDIO, logging::LogType::INFO, "Opened %s audio device at %dHz, %d frame buffers", SDL_GetCurrentAudioDriver(), obtainedSpec.freq, obtainedSpec.samples);
+}
+
+///------------------------------------------------------------------------------------------------
+
+void ResumeAudio()
+{
+    if (sAudioBackend.mMixer && sAudioBackend.mAudioEnabled)
+    {
+        sAudioBackend.mMixer->SetMusicPaused(false);
+        sAudioBackend.mMixer->SetSfxPaused(false);
+    }
+}
+
+///------------------------------------------------------------------------------------------------
+
+void PauseMusicOnly()
+{
+    if (sAudioBackend.mMixer)
+    {
+        sAudioBackend.mMixer->SetMusicPaused(true);
+    }
+}
+
+///------------------------------------------------------------------------------------------------
+
+void PauseSfxOnly()
+{
+    if (sAudioBackend.mMixer)
+    {
+        sAudioBackend.mMixer->SetSfxPaused(true);
+    }
+}
+
+///------------------------------------------------------------------------------------------------
+
+void PauseAudio()
+{
+    PauseMusicOnly();
+    PauseSfxOnly();
+}
+
+///------------------------------------------------------------------------------------------------
+
+void UpdateAudio(const float dtMillis)
+{
+    if (sAudioBackend.mMixer)
+    {
+        UpdateMusic(dtMillis);
+        ReportDropouts(dtMillis);
+    }
+}
+
+///------------------------------------------------------------------------------------------------
+
+void SetAudioEnabled(const bool audioEnabled)
+{
+    sAudioBackend.mAudioEnabled = audioEnabled;
+    sAudioBackend.mTargetMusicGain = audioEnabled ? ENABLED_AUDIO_MUSIC_VOLUME : DISABLED_AUDIO_MUSIC_VOLUME;
+    sAudioBackend.mMusicGain = sAudioBackend.mTargetMusicGain;
+    
+    if (sAudioBackend.mMixer)
+    {
+        sAudioBackend.mMixer->SetMusicGain(sAudioBackend.mMusicGain);
+        sAudioBackend.mMixerMusicGain = sAudioBackend.mMusicGain;
+        sAudioBackend.mMixer->SetMusicPaused(!audioEnabled);
+        sAudioBackend.mMixer->SetSfxPaused(!audioEnabled);
+    }
+}
+
+///------------------------------------------------------------------------------------------------
+
+sound::MixerStats GetMixerStats()
+{
+    return sAudioBackend.mMixer ? sAudioBackend.mMixer->GetStats() : sound::MixerStats();
+}
+
+///------------------------------------------------------------------------------------------------
+
+}
+
+///-----------------------------------------------------------------------------------------------
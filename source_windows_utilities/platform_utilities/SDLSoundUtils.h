@@ -0,0 +1,42 @@
+///------------------------------------------------------------------------------------------------
+///  SDLSoundUtils.h
+///  Predators
+///
+///  Created by Alex Koukoulas on 01/05/2024
+///-----------------------------------------------------------------------------------------------
+
+#ifndef SDLSoundUtils_h
+#define SDLSoundUtils_h
+
+///-----------------------------------------------------------------------------------------------
+
+#include <engine/sound/SoftwareMixer.h>
+#include <string>
+
+///-----------------------------------------------------------------------------------------------
+/// SDL audio device backed implementation of the sound utilities, mixing everything in software
+/// (\see sound::SoftwareMixer). Music is streamed from disk instead of being decoded up front.
+namespace sound_utils
+{
+
+///-----------------------------------------------------------------------------------------------
+
+void Vibrate();
+void PreloadSfx(const std::string& sfxResPath);
+void PlaySound(const std::string& soundResPath, const bool loopedSfxOrUnloopedMusic = false, const float gain = 1.0f, const float pitch = 1.0f);
+void InitAudio();
+void ResumeAudio();
+void PauseMusicOnly();
+void PauseSfxOnly();
+void PauseAudio();
+void UpdateAudio(const float dtMillis);
+void SetAudioEnabled(const bool audioEnabled);
+sound::MixerStats GetMixerStats();
+
+///-----------------------------------------------------------------------------------------------
+
+}
+
+///-----------------------------------------------------------------------------------------------
+
+#endif /* SDLSoundUtils_h */